@@ -21,6 +21,27 @@
 //--------------------------------------------------------------------------------------------------
 #define LOG_BUFFER_LEN 255
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of bytes per line of a data dump
+ */
+//--------------------------------------------------------------------------------------------------
+#define DUMP_BYTES_PER_LINE 16
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Length of a data dump line: offset, hexadecimal bytes, ASCII characters and end of line
+ */
+//--------------------------------------------------------------------------------------------------
+#define DUMP_LINE_LEN (12 + (3 * DUMP_BYTES_PER_LINE) + 2 + DUMP_BYTES_PER_LINE + 2)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hexadecimal digits
+ */
+//--------------------------------------------------------------------------------------------------
+static const char HexDigits[] = "0123456789abcdef";
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Add timestamp in log
@@ -65,8 +86,6 @@ void lwm2m_printf(const char * format, ...)
         fprintf(stdout, "%s ", timebuf);
     }
 
-    memset(strBuffer, 0, LOG_BUFFER_LEN);
-
     va_start(ap, format);
     vsnprintf(strBuffer, LOG_BUFFER_LEN, format, ap);
     va_end(ap);
@@ -112,9 +131,12 @@ void lwm2mcore_DataDump
     int len                         ///< [IN] Data length
 )
 {
+    // Offset, 16 hexadecimal bytes and their ASCII characters
+    char line[DUMP_LINE_LEN];
+    const unsigned char* pc = (const unsigned char*)addrPtr;
     int i;
-    unsigned char buff[17];
-    unsigned char *pc = (unsigned char*)addrPtr;
+    int j;
+    int pos;
 
     // Output description if given.
     if (descPtr != NULL)
@@ -133,43 +155,45 @@ void lwm2mcore_DataDump
         return;
     }
 
-    // Process every byte in the data.
-    for (i = 0; i < len; i++)
+    // Format each line of 16 bytes before printing it: one output call per line
+    for (i = 0; i < len; i += DUMP_BYTES_PER_LINE)
     {
-        // Multiple of 16 means new line (with line offset).
+        pos = snprintf(line, sizeof(line), "  %04x ", i);
 
-        if ((i % 16) == 0)
+        for (j = 0; j < DUMP_BYTES_PER_LINE; j++)
         {
-            // Just don't print ASCII for the zeroth line.
-            if (i != 0)
-                printf("  %s\n", buff);
-
-            // Output the offset.
-            printf("  %04x ", i);
+            if ((i + j) < len)
+            {
+                line[pos++] = ' ';
+                line[pos++] = HexDigits[pc[i + j] >> 4];
+                line[pos++] = HexDigits[pc[i + j] & 0x0F];
+            }
+            else
+            {
+                // Pad out last line if not exactly 16 characters.
+                memset(&line[pos], ' ', 3);
+                pos += 3;
+            }
         }
 
-        // Now the hex code for the specific character.
-        printf(" %02x", pc[i]);
+        line[pos++] = ' ';
+        line[pos++] = ' ';
 
-        // And store a printable ASCII character for later.
-        if ((pc[i] < 0x20) || (pc[i] > 0x7e))
+        // And store a printable ASCII character for each byte.
+        for (j = 0; (j < DUMP_BYTES_PER_LINE) && ((i + j) < len); j++)
         {
-            buff[i % 16] = '.';
+            if ((pc[i + j] < 0x20) || (pc[i + j] > 0x7e))
+            {
+                line[pos++] = '.';
+            }
+            else
+            {
+                line[pos++] = (char)pc[i + j];
+            }
         }
-        else
-        {
-            buff[i % 16] = pc[i];
-        }
-        buff[(i % 16) + 1] = '\0';
-    }
 
-    // Pad out last line if not exactly 16 characters.
-    while ((i % 16) != 0)
-    {
-        printf("   ");
-        i++;
+        line[pos++] = '\n';
+        line[pos] = '\0';
+        fputs(line, stdout);
     }
-
-    // And print the final ASCII bit.
-    printf("  %s\n", buff);
 }
@@ -0,0 +1,358 @@
+/**
+ * @file eventLoop.c
+ *
+ * Event loop of the Linux client based on epoll and timerfd
+ *
+ * All the LwM2MCore timers are multiplexed on a single timerfd armed on the absolute time of the
+ * next deadline, instead of one POSIX timer and one signal per timer. This requires LwM2MCore to
+ * be built with LWM2MCORE_TIMER_EVENT_LOOP.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <lwm2mcore/lwm2mcore.h>
+#include <lwm2mcore/timer.h>
+#include "eventLoop.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Watched file descriptor
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    int                     fd;             ///< File descriptor, -1 if the entry is free
+    eventLoop_FdHandler_t   handler;        ///< Handler called when the file descriptor is readable
+    void*                   contextPtr;     ///< Context given to the handler
+}
+EventLoopWatch_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Watched file descriptors
+ */
+//--------------------------------------------------------------------------------------------------
+static EventLoopWatch_t Watches[EVENT_LOOP_MAX_FDS];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * epoll file descriptor
+ */
+//--------------------------------------------------------------------------------------------------
+static int EpollFd = -1;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * timerfd driving the LwM2MCore timers
+ */
+//--------------------------------------------------------------------------------------------------
+static int TimerFd = -1;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Absolute time on which the timerfd is armed, UINT64_MAX if it is disarmed
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t ArmedDeadlineMs = UINT64_MAX;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Arm the timerfd on the next LwM2MCore timer deadline, or disarm it if no timer is running
+ */
+//--------------------------------------------------------------------------------------------------
+static void ArmTimerFd
+(
+    void
+)
+{
+    struct itimerspec its;
+    uint32_t delayMs = lwm2mcore_GetNextDeadline();
+    uint64_t deadlineMs = UINT64_MAX;
+
+    if (UINT32_MAX != delayMs)
+    {
+        deadlineMs = lwm2mcore_TimerGetTimeMs() + delayMs;
+    }
+
+    if (deadlineMs == ArmedDeadlineMs)
+    {
+        return;
+    }
+
+    // The timerfd and lwm2mcore_TimerGetTimeMs() both use CLOCK_MONOTONIC, a zero it_value
+    // disarms the timerfd
+    memset(&its, 0, sizeof(its));
+    if (UINT64_MAX != deadlineMs)
+    {
+        its.it_value.tv_sec = (time_t)(deadlineMs / 1000);
+        its.it_value.tv_nsec = (long)(deadlineMs % 1000) * 1000000;
+    }
+
+    if (-1 == timerfd_settime(TimerFd, TFD_TIMER_ABSTIME, &its, NULL))
+    {
+        printf("Error in timerfd_settime(): %d %s\n", errno, strerror(errno));
+        return;
+    }
+    ArmedDeadlineMs = deadlineMs;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Treat the timerfd expiry
+ */
+//--------------------------------------------------------------------------------------------------
+static void TimerFdHandler
+(
+    void
+)
+{
+    uint64_t expirations;
+
+    if (sizeof(expirations) != read(TimerFd, &expirations, sizeof(expirations)))
+    {
+        // Spurious wake-up: the timerfd was re-armed before being read
+        return;
+    }
+
+    ArmedDeadlineMs = UINT64_MAX;
+    lwm2mcore_ProcessTimers();
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create the epoll instance and the timerfd driving the LwM2MCore timers
+ *
+ * @return
+ *  - true  on success
+ *  - false on failure
+ */
+//--------------------------------------------------------------------------------------------------
+bool eventLoop_Init
+(
+    void
+)
+{
+    struct epoll_event event;
+    int i;
+
+    for (i = 0; i < EVENT_LOOP_MAX_FDS; i++)
+    {
+        Watches[i].fd = -1;
+    }
+
+    EpollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (-1 == EpollFd)
+    {
+        printf("Error in epoll_create1(): %d %s\n", errno, strerror(errno));
+        return false;
+    }
+
+    TimerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (-1 == TimerFd)
+    {
+        printf("Error in timerfd_create(): %d %s\n", errno, strerror(errno));
+        eventLoop_Free();
+        return false;
+    }
+    ArmedDeadlineMs = UINT64_MAX;
+
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = TimerFd;
+    if (-1 == epoll_ctl(EpollFd, EPOLL_CTL_ADD, TimerFd, &event))
+    {
+        printf("Error in epoll_ctl(): %d %s\n", errno, strerror(errno));
+        eventLoop_Free();
+        return false;
+    }
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release the epoll instance and the timerfd
+ */
+//--------------------------------------------------------------------------------------------------
+void eventLoop_Free
+(
+    void
+)
+{
+    int i;
+
+    for (i = 0; i < EVENT_LOOP_MAX_FDS; i++)
+    {
+        Watches[i].fd = -1;
+    }
+
+    if (-1 != TimerFd)
+    {
+        close(TimerFd);
+        TimerFd = -1;
+    }
+    if (-1 != EpollFd)
+    {
+        close(EpollFd);
+        EpollFd = -1;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Watch a file descriptor for reading
+ *
+ * @return
+ *  - true  on success
+ *  - false on failure
+ */
+//--------------------------------------------------------------------------------------------------
+bool eventLoop_WatchFd
+(
+    int fd,                         ///< [IN] File descriptor
+    eventLoop_FdHandler_t handler,  ///< [IN] Handler called when the file descriptor is readable
+    void* contextPtr                ///< [IN] Context given to the handler
+)
+{
+    struct epoll_event event;
+    int i;
+
+    if ((-1 == EpollFd) || (0 > fd) || (NULL == handler))
+    {
+        return false;
+    }
+
+    for (i = 0; i < EVENT_LOOP_MAX_FDS; i++)
+    {
+        if (-1 == Watches[i].fd)
+        {
+            break;
+        }
+    }
+    if (EVENT_LOOP_MAX_FDS == i)
+    {
+        printf("Too many file descriptors in the event loop\n");
+        return false;
+    }
+
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    if (-1 == epoll_ctl(EpollFd, EPOLL_CTL_ADD, fd, &event))
+    {
+        printf("Error in epoll_ctl(): %d %s\n", errno, strerror(errno));
+        return false;
+    }
+
+    Watches[i].fd = fd;
+    Watches[i].handler = handler;
+    Watches[i].contextPtr = contextPtr;
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stop watching a file descriptor
+ */
+//--------------------------------------------------------------------------------------------------
+void eventLoop_UnwatchFd
+(
+    int fd                          ///< [IN] File descriptor
+)
+{
+    int i;
+
+    for (i = 0; i < EVENT_LOOP_MAX_FDS; i++)
+    {
+        if ((0 <= fd) && (fd == Watches[i].fd))
+        {
+            // The file descriptor may already be closed, which removed it from the epoll set
+            epoll_ctl(EpollFd, EPOLL_CTL_DEL, fd, NULL);
+            Watches[i].fd = -1;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the epoll file descriptor
+ *
+ * @return
+ *  - epoll file descriptor
+ *  - -1 if the event loop is not initialized
+ */
+//--------------------------------------------------------------------------------------------------
+int eventLoop_GetFd
+(
+    void
+)
+{
+    return EpollFd;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Wait for the readable file descriptors or the next LwM2MCore timer expiry and treat them
+ *
+ * @return
+ *  - Number of treated events
+ *  - -1 on failure
+ */
+//--------------------------------------------------------------------------------------------------
+int eventLoop_RunOnce
+(
+    int timeoutMs                   ///< [IN] Maximum wait in ms, -1 to wait for an event
+)
+{
+    struct epoll_event events[EVENT_LOOP_MAX_FDS + 1];
+    int count;
+    int i;
+
+    if (-1 == EpollFd)
+    {
+        return -1;
+    }
+
+    ArmTimerFd();
+
+    count = epoll_wait(EpollFd, events, EVENT_LOOP_MAX_FDS + 1, timeoutMs);
+    if (0 > count)
+    {
+        if (EINTR == errno)
+        {
+            return 0;
+        }
+        printf("Error in epoll_wait(): %d %s\n", errno, strerror(errno));
+        return -1;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        int j;
+
+        if (events[i].data.fd == TimerFd)
+        {
+            TimerFdHandler();
+            continue;
+        }
+
+        // A previous handler may have unwatched this file descriptor
+        for (j = 0; j < EVENT_LOOP_MAX_FDS; j++)
+        {
+            if (events[i].data.fd == Watches[j].fd)
+            {
+                Watches[j].handler(Watches[j].fd, Watches[j].contextPtr);
+                break;
+            }
+        }
+    }
+    return count;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file eventLoop.h
+ *
+ * Event loop of the Linux client based on epoll and timerfd
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+#ifndef _LINUX_CLIENT_EVENT_LOOP_H_
+#define _LINUX_CLIENT_EVENT_LOOP_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of file descriptors watched by the event loop
+ */
+//--------------------------------------------------------------------------------------------------
+#define EVENT_LOOP_MAX_FDS  8
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler called when a watched file descriptor is readable
+ */
+//--------------------------------------------------------------------------------------------------
+typedef void (*eventLoop_FdHandler_t)
+(
+    int fd,                 ///< [IN] Readable file descriptor
+    void* contextPtr        ///< [IN] Context given to eventLoop_WatchFd
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create the epoll instance and the timerfd driving the LwM2MCore timers
+ *
+ * @return
+ *  - true  on success
+ *  - false on failure
+ */
+//--------------------------------------------------------------------------------------------------
+bool eventLoop_Init
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release the epoll instance and the timerfd
+ */
+//--------------------------------------------------------------------------------------------------
+void eventLoop_Free
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Watch a file descriptor for reading
+ *
+ * @return
+ *  - true  on success
+ *  - false on failure
+ */
+//--------------------------------------------------------------------------------------------------
+bool eventLoop_WatchFd
+(
+    int fd,                         ///< [IN] File descriptor
+    eventLoop_FdHandler_t handler,  ///< [IN] Handler called when the file descriptor is readable
+    void* contextPtr                ///< [IN] Context given to the handler
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stop watching a file descriptor
+ */
+//--------------------------------------------------------------------------------------------------
+void eventLoop_UnwatchFd
+(
+    int fd                          ///< [IN] File descriptor
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the epoll file descriptor, so that the event loop can be nested in another one: when it is
+ * readable, eventLoop_RunOnce(0) has to be called.
+ *
+ * @return
+ *  - epoll file descriptor
+ *  - -1 if the event loop is not initialized
+ */
+//--------------------------------------------------------------------------------------------------
+int eventLoop_GetFd
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Wait for the readable file descriptors or the next LwM2MCore timer expiry and treat them
+ *
+ * The timerfd is armed on lwm2mcore_GetNextDeadline() before waiting: the process does not wake
+ * up while no LwM2MCore timer is running.
+ *
+ * @return
+ *  - Number of treated events
+ *  - -1 on failure
+ */
+//--------------------------------------------------------------------------------------------------
+int eventLoop_RunOnce
+(
+    int timeoutMs                   ///< [IN] Maximum wait in ms, -1 to wait for an event
+);
+
+#endif /* _LINUX_CLIENT_EVENT_LOOP_H_ */
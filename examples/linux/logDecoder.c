@@ -0,0 +1,400 @@
+/**
+ * @file logDecoder.c
+ *
+ * Offline decoder of the LwM2MCore binary logs
+ *
+ * The binary records are read from the LwM2MCore log ring buffer (see lwm2mcore_ReadLogRing) and
+ * stored in a file by the client. The call site strings are extracted from the client image:
+ * @code
+ * objcopy -O binary --only-section=lwm2mcore_log lwm2mcoreclient lwm2mcore_log.sites
+ * lwm2mcoreLogDecoder lwm2mcore_log.sites lwm2mcore_log.bin
+ * @endcode
+ *
+ * The decoder must run on a host with the same byte order as the device.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <lwm2mcore/log.h>
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum length of a conversion specification
+ */
+//--------------------------------------------------------------------------------------------------
+#define SPEC_MAX_LEN            64
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum length of a string argument
+ */
+//--------------------------------------------------------------------------------------------------
+#define STRING_MAX_LEN          256
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Log level names
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* LevelNames[] = { "-", "E", "I", "D" };
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a whole file
+ *
+ * @return
+ *  - File content (to be freed)
+ *  - NULL on failure
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t* ReadFile
+(
+    const char* pathPtr,                ///< [IN] File path
+    size_t* lenPtr                      ///< [OUT] File length
+)
+{
+    FILE* filePtr = fopen(pathPtr, "rb");
+    uint8_t* dataPtr;
+    long len;
+
+    if (!filePtr)
+    {
+        fprintf(stderr, "Unable to open %s\n", pathPtr);
+        return NULL;
+    }
+
+    fseek(filePtr, 0, SEEK_END);
+    len = ftell(filePtr);
+    fseek(filePtr, 0, SEEK_SET);
+
+    // One more byte: the call site strings are null-terminated, even if the file is truncated
+    dataPtr = (uint8_t*)calloc(1, (size_t)len + 1);
+    if ((!dataPtr) || ((size_t)len != fread(dataPtr, 1, (size_t)len, filePtr)))
+    {
+        fprintf(stderr, "Unable to read %s\n", pathPtr);
+        free(dataPtr);
+        fclose(filePtr);
+        return NULL;
+    }
+
+    fclose(filePtr);
+    *lenPtr = (size_t)len;
+    return dataPtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Take a value from the record payload
+ *
+ * @return
+ *  - true on success
+ *  - false if the payload is too short
+ */
+//--------------------------------------------------------------------------------------------------
+static bool TakeValue
+(
+    const uint8_t** payloadPtr,         ///< [INOUT] Payload
+    const uint8_t* endPtr,              ///< [IN] End of the payload
+    void* valuePtr,                     ///< [OUT] Value
+    size_t len                          ///< [IN] Value length
+)
+{
+    if ((size_t)(endPtr - *payloadPtr) < len)
+    {
+        return false;
+    }
+    memcpy(valuePtr, *payloadPtr, len);
+    *payloadPtr += len;
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Print a message record, replaying the format with the stored arguments
+ */
+//--------------------------------------------------------------------------------------------------
+static void PrintMessage
+(
+    const char* formatPtr,              ///< [IN] Format
+    const uint8_t* payloadPtr,          ///< [IN] Record payload
+    const uint8_t* endPtr               ///< [IN] End of the record payload
+)
+{
+    const char* fPtr = formatPtr;
+
+    while (*fPtr)
+    {
+        char spec[SPEC_MAX_LEN];
+        size_t specLen = 0;
+        bool isSized = false;
+        int32_t value32;
+        int64_t value64;
+        double valueDouble;
+        uint8_t stringLen;
+        char string[STRING_MAX_LEN];
+
+        if ('%' != *fPtr)
+        {
+            putchar(*fPtr++);
+            continue;
+        }
+
+        spec[specLen++] = *fPtr++;
+
+        // Flags, width and precision: the '*' values are stored in the record
+        while ((*fPtr) && (NULL != strchr("-+ #0'.123456789*", *fPtr))
+            && (specLen < (SPEC_MAX_LEN - 16)))
+        {
+            if ('*' == *fPtr)
+            {
+                if (!TakeValue(&payloadPtr, endPtr, &value32, sizeof(value32)))
+                {
+                    printf("<truncated>");
+                    return;
+                }
+                specLen += (size_t)snprintf(&spec[specLen], SPEC_MAX_LEN - specLen, "%d",
+                                            (int)value32);
+            }
+            else
+            {
+                spec[specLen++] = *fPtr;
+            }
+            fPtr++;
+        }
+
+        // Length modifiers: 'h' is kept, the other ones are replaced by "ll"
+        while ((*fPtr) && (NULL != strchr("hlLjztq", *fPtr)))
+        {
+            if ('h' == *fPtr)
+            {
+                spec[specLen++] = 'h';
+            }
+            else
+            {
+                isSized = true;
+            }
+            fPtr++;
+        }
+
+        if (!*fPtr)
+        {
+            break;
+        }
+
+        switch (*fPtr)
+        {
+            case 'd':
+            case 'i':
+            case 'u':
+            case 'o':
+            case 'x':
+            case 'X':
+            case 'c':
+                if (isSized)
+                {
+                    spec[specLen++] = 'l';
+                    spec[specLen++] = 'l';
+                }
+                spec[specLen++] = *fPtr;
+                spec[specLen] = '\0';
+                if (isSized)
+                {
+                    if (!TakeValue(&payloadPtr, endPtr, &value64, sizeof(value64)))
+                    {
+                        printf("<truncated>");
+                        return;
+                    }
+                    printf(spec, (long long)value64);
+                }
+                else
+                {
+                    if (!TakeValue(&payloadPtr, endPtr, &value32, sizeof(value32)))
+                    {
+                        printf("<truncated>");
+                        return;
+                    }
+                    printf(spec, (int)value32);
+                }
+                break;
+
+            case 'p':
+                if (!TakeValue(&payloadPtr, endPtr, &value64, sizeof(value64)))
+                {
+                    printf("<truncated>");
+                    return;
+                }
+                printf("0x%llx", (unsigned long long)value64);
+                break;
+
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A':
+                spec[specLen++] = *fPtr;
+                spec[specLen] = '\0';
+                if (!TakeValue(&payloadPtr, endPtr, &valueDouble, sizeof(valueDouble)))
+                {
+                    printf("<truncated>");
+                    return;
+                }
+                printf(spec, valueDouble);
+                break;
+
+            case 's':
+                spec[specLen++] = 's';
+                spec[specLen] = '\0';
+                if ((!TakeValue(&payloadPtr, endPtr, &stringLen, sizeof(stringLen)))
+                 || (!TakeValue(&payloadPtr, endPtr, string, stringLen)))
+                {
+                    printf("<truncated>");
+                    return;
+                }
+                string[stringLen] = '\0';
+                printf(spec, string);
+                break;
+
+            case 'n':
+                break;
+
+            default:
+                putchar(*fPtr);
+                break;
+        }
+        fPtr++;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Print a dump record
+ */
+//--------------------------------------------------------------------------------------------------
+static void PrintDump
+(
+    const uint8_t* payloadPtr,          ///< [IN] Record payload
+    const uint8_t* endPtr               ///< [IN] End of the record payload
+)
+{
+    size_t len = (size_t)(endPtr - payloadPtr);
+    size_t i;
+
+    printf(" (%zu bytes)", len);
+    for (i = 0; i < len; i++)
+    {
+        if (0 == (i % 16))
+        {
+            printf("\n  %04zx ", i);
+        }
+        printf(" %02x", payloadPtr[i]);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode the binary log records
+ *
+ * @return
+ *  - EXIT_SUCCESS on success
+ *  - EXIT_FAILURE on failure
+ */
+//--------------------------------------------------------------------------------------------------
+int main
+(
+    int argc,                           ///< [IN] Number of arguments
+    char* argvPtr[]                     ///< [IN] Call site strings file, binary records file
+)
+{
+    uint8_t* sitesPtr;
+    uint8_t* recordsPtr;
+    size_t sitesLen;
+    size_t recordsLen;
+    size_t offset = 0;
+
+    if (3 != argc)
+    {
+        printf("Usage: %s <call site strings file> <binary records file>\n", argvPtr[0]);
+        return EXIT_FAILURE;
+    }
+
+    sitesPtr = ReadFile(argvPtr[1], &sitesLen);
+    recordsPtr = ReadFile(argvPtr[2], &recordsLen);
+    if ((!sitesPtr) || (!recordsPtr))
+    {
+        free(sitesPtr);
+        free(recordsPtr);
+        return EXIT_FAILURE;
+    }
+
+    while ((offset + sizeof(lwm2mcore_LogRecordHeader_t)) <= recordsLen)
+    {
+        lwm2mcore_LogRecordHeader_t header;
+        const uint8_t* payloadPtr;
+        const uint8_t* endPtr;
+        const char* locationPtr;
+        const char* textPtr;
+        uint32_t suppressedCount;
+
+        memcpy(&header, recordsPtr + offset, sizeof(header));
+        if ((header.len < sizeof(header)) || ((offset + header.len) > recordsLen)
+         || (header.siteId >= sitesLen))
+        {
+            fprintf(stderr, "Invalid record at offset %zu\n", offset);
+            break;
+        }
+
+        payloadPtr = recordsPtr + offset + sizeof(header);
+        endPtr = recordsPtr + offset + header.len;
+        locationPtr = (const char*)sitesPtr + header.siteId;
+        textPtr = locationPtr + strlen(locationPtr) + 1;
+        if ((const uint8_t*)textPtr >= (sitesPtr + sitesLen))
+        {
+            textPtr = "";
+        }
+
+        printf("%10u %s [%s] ", header.timeMs,
+               LevelNames[header.level < 4 ? header.level : 0], locationPtr);
+
+        switch (header.type & (uint8_t)~LWM2MCORE_LOG_RECORD_TRUNCATED)
+        {
+            case LWM2MCORE_LOG_RECORD_MESSAGE:
+                PrintMessage(textPtr, payloadPtr, endPtr);
+                break;
+
+            case LWM2MCORE_LOG_RECORD_DUMP:
+                printf("%s:", textPtr);
+                PrintDump(payloadPtr, endPtr);
+                break;
+
+            case LWM2MCORE_LOG_RECORD_SUPPRESSED:
+                suppressedCount = 0;
+                TakeValue(&payloadPtr, endPtr, &suppressedCount, sizeof(suppressedCount));
+                printf("%u logs suppressed", suppressedCount);
+                break;
+
+            default:
+                printf("unknown record type %u", header.type);
+                break;
+        }
+
+        if (header.type & LWM2MCORE_LOG_RECORD_TRUNCATED)
+        {
+            printf(" <truncated>");
+        }
+        printf("\n");
+        offset += header.len;
+    }
+
+    free(sitesPtr);
+    free(recordsPtr);
+    return EXIT_SUCCESS;
+}
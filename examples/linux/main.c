@@ -9,9 +9,11 @@
  *
  */
 
+#define _GNU_SOURCE
 #include <stdio.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 #include <sys/types.h>
 #include "ctype.h"
 
@@ -20,6 +22,7 @@
 #include <lwm2mcore/udp.h>
 #include <lwm2mcore/lwm2mcorePackageDownloader.h>
 #include <lwm2mcore/update.h>
+#include <lwm2mcore/log.h>
 #include "dtls_debug.h"
 #include "dtlsConnection.h"
 
@@ -33,6 +36,9 @@
 #include <signal.h>
 #include "clientConfig.h"
 #include "update.h"
+#ifdef LWM2MCORE_TIMER_EVENT_LOOP
+#include "eventLoop.h"
+#endif
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -41,6 +47,20 @@
 //--------------------------------------------------------------------------------------------------
 #define MAX_PACKET_SIZE 1024
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of datagrams read by a single recvmmsg() call
+ */
+//--------------------------------------------------------------------------------------------------
+#define RECV_BATCH_SIZE 16
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * File storing the LwM2MCore binary logs (see logDecoder.c)
+ */
+//--------------------------------------------------------------------------------------------------
+#define BINARY_LOG_FILE "lwm2mcore_log.bin"
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Socket configuration set in udp.c
@@ -83,6 +103,13 @@ static char Endpoint[LWM2MCORE_ENDPOINT_LEN] = {0};
 //--------------------------------------------------------------------------------------------------
 static log_t LogLevel = DTLS_LOG_INFO;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * LwM2MCore logs stored as binary records in BINARY_LOG_FILE
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsBinaryLog = false;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Client configuration
@@ -119,6 +146,38 @@ typedef struct
 }
 CommandDesc_t;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append the binary records of the LwM2MCore log ring buffer to BINARY_LOG_FILE
+ */
+//--------------------------------------------------------------------------------------------------
+static void FlushBinaryLog
+(
+    void
+)
+{
+    uint8_t records[1024];
+    size_t len;
+    FILE* filePtr;
+
+    if (!IsBinaryLog)
+    {
+        return;
+    }
+
+    filePtr = fopen(BINARY_LOG_FILE, "ab");
+    if (!filePtr)
+    {
+        return;
+    }
+
+    while (0 != (len = lwm2mcore_ReadLogRing(records, sizeof(records))))
+    {
+        fwrite(records, 1, len, filePtr);
+    }
+    fclose(filePtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Function to stop the connection
@@ -289,7 +348,8 @@ static void PrintUsage
     printf("Usage: LWM2MCore client [OPTION]\r\n");
     printf("Launch a LWM2M client.\r\n");
     printf("Options:\r\n");
-    printf("  -d\t\tSet DTLS debug logs\r\n");
+    printf("  -d\t\tSet DTLS debug logs and dump the received datagrams\r\n");
+    printf("  -b\t\tStore LwM2MCore logs as binary records in %s\r\n", BINARY_LOG_FILE);
     printf("\r\n");
 }
 
@@ -488,6 +548,162 @@ static void HandleCommand
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Treat a command typed on the standard input
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReadStdin
+(
+    int fd,                 ///< [IN] Standard input file descriptor
+    void* contextPtr        ///< [IN] Reception buffer of MAX_PACKET_SIZE bytes
+)
+{
+    uint8_t* buffer = (uint8_t*)contextPtr;
+    int numBytes;
+
+    numBytes = read(fd, buffer, MAX_PACKET_SIZE - 1);
+
+    if (numBytes > 1)
+    {
+        buffer[numBytes] = 0;
+        // We call the corresponding callback of the typed command passing it the buffer
+        // for further arguments
+        HandleCommand(Commands, buffer);
+    }
+
+    if (0 == Quit)
+    {
+        printf("\r\n> ");
+        fflush(stdout);
+    }
+    else
+    {
+        ClientConfigFree();
+        printf("\r\n");
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Datagrams read by a single recvmmsg() call
+ */
+//--------------------------------------------------------------------------------------------------
+static lwm2mcore_UdpDatagram_t RecvDatagrams[RECV_BATCH_SIZE];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reception buffers of the datagrams read by a single recvmmsg() call
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t RecvBuffers[RECV_BATCH_SIZE][LWM2MCORE_UDP_MAX_PACKET_SIZE];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Print a datagram received on the LwM2M socket, only with the debug logs: the reception path does
+ * not print nor dump every datagram
+ */
+//--------------------------------------------------------------------------------------------------
+static void PrintDatagram
+(
+    const lwm2mcore_UdpDatagram_t* datagramPtr  ///< [IN] Received datagram
+)
+{
+    char s[INET6_ADDRSTRLEN];
+    in_port_t port = 0;
+
+    if (DTLS_LOG_DEBUG > LogLevel)
+    {
+        return;
+    }
+
+    s[0] = 0;
+
+    if (AF_INET == datagramPtr->addr.ss_family)
+    {
+        const struct sockaddr_in *saddr = (const struct sockaddr_in *)&(datagramPtr->addr);
+        inet_ntop(saddr->sin_family, &saddr->sin_addr, s, INET6_ADDRSTRLEN);
+        port = saddr->sin_port;
+    }
+    else if (AF_INET6 == datagramPtr->addr.ss_family)
+    {
+        const struct sockaddr_in6 *saddr = (const struct sockaddr_in6 *)&(datagramPtr->addr);
+        inet_ntop(saddr->sin6_family, &saddr->sin6_addr, s, INET6_ADDRSTRLEN);
+        port = saddr->sin6_port;
+    }
+    fprintf(stderr, "%u bytes received from [%s]:%hu\n", datagramPtr->len, s, ntohs(port));
+    lwm2mcore_DataDump("Received data", datagramPtr->bufferPtr, datagramPtr->len);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Treat the datagrams received on the LwM2M socket: all the datagrams already queued on the
+ * socket are read by a single recvmmsg() call and given together to LwM2MCore
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReadSocket
+(
+    int fd,                 ///< [IN] LwM2M socket
+    void* contextPtr        ///< [IN] Unused
+)
+{
+    struct mmsghdr msgs[RECV_BATCH_SIZE];
+    struct iovec iovs[RECV_BATCH_SIZE];
+    size_t received = 0;
+    int count;
+    int i;
+
+    (void)contextPtr;
+
+    memset(msgs, 0, sizeof(msgs));
+    for (i = 0; i < RECV_BATCH_SIZE; i++)
+    {
+        iovs[i].iov_base = RecvBuffers[i];
+        iovs[i].iov_len = LWM2MCORE_UDP_MAX_PACKET_SIZE;
+        msgs[i].msg_hdr.msg_iov = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        msgs[i].msg_hdr.msg_name = &(RecvDatagrams[i].addr);
+        msgs[i].msg_hdr.msg_namelen = sizeof(RecvDatagrams[i].addr);
+    }
+
+    // The socket is readable: do not wait for more datagrams than the queued ones
+    count = recvmmsg(fd, msgs, RECV_BATCH_SIZE, MSG_DONTWAIT, NULL);
+    if (0 > count)
+    {
+        if ((EAGAIN == errno) || (EWOULDBLOCK == errno) || (EINTR == errno))
+        {
+            return;
+        }
+        printf("Error in recvmmsg(): %d %s\r\n", errno, strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+
+    // Empty datagrams are ignored
+    for (i = 0; i < count; i++)
+    {
+        if (0 == msgs[i].msg_len)
+        {
+            continue;
+        }
+        if ((size_t)i != received)
+        {
+            memcpy(&(RecvDatagrams[received].addr), &(RecvDatagrams[i].addr),
+                   sizeof(RecvDatagrams[i].addr));
+        }
+        RecvDatagrams[received].bufferPtr = RecvBuffers[i];
+        RecvDatagrams[received].len = msgs[i].msg_len;
+        RecvDatagrams[received].addrLen = msgs[i].msg_hdr.msg_namelen;
+        PrintDatagram(&RecvDatagrams[received]);
+        received++;
+    }
+
+    if (0 < received)
+    {
+        lwm2mcore_UdpReceiveBatchCb(RecvDatagrams, received, LinuxSocketConfig);
+        FlushBinaryLog();
+    }
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * LWM2MCore main
@@ -504,7 +720,9 @@ int main
 )
 {
     int opt;
+#ifndef LWM2MCORE_TIMER_EVENT_LOOP
     int result;
+#endif
     uint8_t buffer[MAX_PACKET_SIZE];
     struct sigaction psa;
 
@@ -534,6 +752,16 @@ int main
                 LogLevel = DTLS_LOG_DEBUG;
                 break;
 
+            case 'b':
+                if (LWM2MCORE_ERR_COMPLETED_OK != lwm2mcore_SetLogSink(LWM2MCORE_LOG_SINK_BINARY))
+                {
+                    printf("Binary logs are not supported\n");
+                    return 0;
+                }
+                printf("Store LwM2MCore logs in %s\n", BINARY_LOG_FILE);
+                IsBinaryLog = true;
+                break;
+
             default:
                 PrintUsage();
                 return 0;
@@ -558,9 +786,45 @@ int main
     psa.sa_handler = Interrupt;
     sigaction(SIGTSTP, &psa, NULL);
 
+#ifdef LWM2MCORE_TIMER_EVENT_LOOP
+    if (!eventLoop_Init() || !eventLoop_WatchFd(STDIN_FILENO, ReadStdin, buffer))
+    {
+        exit(EXIT_FAILURE);
+    }
+#endif
+
     // Automatically launch a connection
     TreatCmd(START_CNX);
 
+#ifdef LWM2MCORE_TIMER_EVENT_LOOP
+    {
+        int watchedSock = 0;
+
+        while (0 == Quit)
+        {
+            // The LwM2M socket is opened and closed by the session
+            if (LinuxSocketConfig.sock != watchedSock)
+            {
+                if (0 < watchedSock)
+                {
+                    eventLoop_UnwatchFd(watchedSock);
+                }
+                watchedSock = LinuxSocketConfig.sock;
+                if ((0 < watchedSock) && (!eventLoop_WatchFd(watchedSock, ReadSocket, NULL)))
+                {
+                    exit(EXIT_FAILURE);
+                }
+            }
+
+            // The LwM2MCore timers are handled by the event loop: no periodic wake-up is needed
+            if (0 > eventLoop_RunOnce(-1))
+            {
+                exit(EXIT_FAILURE);
+            }
+        }
+        eventLoop_Free();
+    }
+#else
     while (0 == Quit)
     {
         struct timeval tv;
@@ -585,74 +849,19 @@ int main
         }
         else if (result > 0)
         {
-            int numBytes;
-
             // If the event happened on the SDTIN
             if (FD_ISSET(STDIN_FILENO, &Fd))
             {
-                numBytes = read(STDIN_FILENO, buffer, MAX_PACKET_SIZE - 1);
-
-                if (numBytes > 1)
-                {
-                    buffer[numBytes] = 0;
-                    // We call the corresponding callback of the typed command passing it the buffer
-                    // for further arguments
-                    HandleCommand(Commands, buffer);
-                }
-
-                if (0 == Quit)
-                {
-                    printf("\r\n> ");
-                    fflush(stdout);
-                }
-                else
-                {
-                    ClientConfigFree();
-                    printf("\r\n");
-                }
+                ReadStdin(STDIN_FILENO, buffer);
             }
             // If an event happens on the socket
             else if (FD_ISSET(LinuxSocketConfig.sock, &Fd))
             {
-                struct sockaddr_storage addr;
-                socklen_t addrLen = sizeof(addr);
-
-                // We retrieve the data received
-                numBytes = recvfrom(LinuxSocketConfig.sock,
-                                    buffer,
-                                    MAX_PACKET_SIZE,
-                                    0,
-                                    (struct sockaddr *)&addr,
-                                    &addrLen);
-
-                if (0 > numBytes)
-                {
-                    printf("Error in recvfrom(): %d %s\r\n", errno, strerror(errno));
-                    exit(EXIT_FAILURE);
-                }
-                else if (0 < numBytes)
-                {
-                    char s[INET6_ADDRSTRLEN];
-                    in_port_t port;
-
-                    if (AF_INET == addr.ss_family)
-                    {
-                        struct sockaddr_in *saddr = (struct sockaddr_in *)&addr;
-                        inet_ntop(saddr->sin_family, &saddr->sin_addr, s, INET6_ADDRSTRLEN);
-                        port = saddr->sin_port;
-                    }
-                    else if (AF_INET6 == addr.ss_family)
-                    {
-                        struct sockaddr_in6 *saddr = (struct sockaddr_in6 *)&addr;
-                        inet_ntop(saddr->sin6_family, &saddr->sin6_addr, s, INET6_ADDRSTRLEN);
-                        port = saddr->sin6_port;
-                    }
-                    fprintf(stderr, "%d bytes received from [%s]:%hu\n", numBytes, s, ntohs(port));
-                    lwm2mcore_DataDump("Received data", buffer, numBytes);
-                    lwm2mcore_UdpReceiveCb(buffer, numBytes, &addr, addrLen, LinuxSocketConfig);
-                }
+                ReadSocket(LinuxSocketConfig.sock, NULL);
             }
         }
     }
+#endif
+    FlushBinaryLog();
     exit(EXIT_SUCCESS);
 }
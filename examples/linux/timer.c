@@ -17,12 +17,14 @@
 #include <sys/time.h>
 #include <signal.h>
 #include <time.h>
+#include <string.h>
 
 #include <lwm2mcore/lwm2mcore.h>
 #include <lwm2mcore/timer.h>
 #include "internals.h"
 
 
+#ifndef LWM2MCORE_TIMER_EVENT_LOOP
 //--------------------------------------------------------------------------------------------------
 /**
  * Structure for timers
@@ -69,24 +71,23 @@ static void TimerSigHandler
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Adaptation function for timer launch
+ * Launch a timer
  *
  * @return
  *  - true  on success
  *  - false on failure
  */
 //--------------------------------------------------------------------------------------------------
-bool lwm2mcore_TimerSet
+static bool StartTimer
 (
     lwm2mcore_TimerType_t       timerType,  ///< [IN] Timer Id
-    uint32_t                    time,       ///< [IN] Timer value in seconds
+    const struct itimerspec*    itsPtr,     ///< [IN] Timer value
     lwm2mcore_TimerCallback_t   cb          ///< [IN] Timer callback
 )
 {
     bool result = false;
     struct sigevent sev;
     struct sigaction sa;
-    printf("lwm2mcore_TimerSet time %d\n", time);
 
     if(lwm2mcore_TimerIsRunning(timerType))
     {
@@ -126,25 +127,10 @@ bool lwm2mcore_TimerSet
         }
         else
         {
-            struct itimerspec its;
             TimerTable[timerType].timerId = timerId;
-            printf("set timer %d\n", time);
-
-            if (!time)
-            {
-                its.it_value.tv_sec = 1;
-                its.it_value.tv_nsec = 0;
-            }
-            else
-            {
-                its.it_value.tv_sec = time;
-                its.it_value.tv_nsec = 0;
-            }
-            its.it_interval.tv_sec = 0;
-            its.it_interval.tv_nsec = 0;
 
-            LOG_ARG("timer sec %d", its.it_value.tv_sec);
-            if (timer_settime(timerId, 0, &its, NULL) < 0)
+            LOG_ARG("timer sec %d nsec %d", itsPtr->it_value.tv_sec, itsPtr->it_value.tv_nsec);
+            if (timer_settime(timerId, 0, itsPtr, NULL) < 0)
             {
                 printf("failed to set timer\n");
             }
@@ -158,6 +144,70 @@ bool lwm2mcore_TimerSet
     return result;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adaptation function for timer launch
+ *
+ * @return
+ *  - true  on success
+ *  - false on failure
+ */
+//--------------------------------------------------------------------------------------------------
+bool lwm2mcore_TimerSet
+(
+    lwm2mcore_TimerType_t       timerType,  ///< [IN] Timer Id
+    uint32_t                    time,       ///< [IN] Timer value in seconds
+    lwm2mcore_TimerCallback_t   cb          ///< [IN] Timer callback
+)
+{
+    struct itimerspec its;
+    printf("lwm2mcore_TimerSet time %d\n", time);
+
+    memset(&its, 0, sizeof(its));
+    if (!time)
+    {
+        its.it_value.tv_sec = 1;
+    }
+    else
+    {
+        its.it_value.tv_sec = time;
+    }
+
+    return StartTimer(timerType, &its, cb);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adaptation function for timer launch with a ms resolution
+ *
+ * @return
+ *  - true  on success
+ *  - false on failure
+ */
+//--------------------------------------------------------------------------------------------------
+bool lwm2mcore_TimerSetMs
+(
+    lwm2mcore_TimerType_t       timerType,  ///< [IN] Timer Id
+    uint32_t                    timeMs,     ///< [IN] Timer value in ms
+    lwm2mcore_TimerCallback_t   cb          ///< [IN] Timer callback
+)
+{
+    struct itimerspec its;
+    printf("lwm2mcore_TimerSetMs time %d\n", timeMs);
+
+    // A null value disarms a POSIX timer: expire as soon as possible instead
+    if (!timeMs)
+    {
+        timeMs = 1;
+    }
+
+    memset(&its, 0, sizeof(its));
+    its.it_value.tv_sec = timeMs / 1000;
+    its.it_value.tv_nsec = (long)(timeMs % 1000) * 1000000;
+
+    return StartTimer(timerType, &its, cb);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Adaptation function for timer stop
@@ -201,3 +251,27 @@ bool lwm2mcore_TimerIsRunning
     }
     return true;
 }
+
+#endif /* !LWM2MCORE_TIMER_EVENT_LOOP */
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adaptation function to get a monotonic time in milliseconds
+ *
+ * @return
+ *  - Monotonic time in milliseconds
+ */
+//--------------------------------------------------------------------------------------------------
+uint64_t lwm2mcore_TimerGetTimeMs
+(
+    void
+)
+{
+    struct timespec ts;
+
+    if (clock_gettime(CLOCK_MONOTONIC, &ts))
+    {
+        return 0;
+    }
+    return ((uint64_t)ts.tv_sec * 1000) + ((uint64_t)ts.tv_nsec / 1000000);
+}
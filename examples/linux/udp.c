@@ -8,6 +8,7 @@
  *
  */
 
+#define _GNU_SOURCE
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -26,6 +27,13 @@
 //--------------------------------------------------------------------------------------------------
 const char* localPortPtr = "56830";
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of datagrams sent by a single sendmmsg() call
+ */
+//--------------------------------------------------------------------------------------------------
+#define UDP_SEND_BATCH_SIZE 16
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Socket configuration
@@ -192,8 +200,6 @@ ssize_t lwm2mcore_UdpSend
     ssize_t sentSize = 0;
     size_t offset = 0;
 
-    printf ("enter sockfd %d, length %zu\n", sockfd, length);
-    lwm2mcore_DataDump( "send data", (void*)bufferPtr, length);
     while (offset != length)
     {
         sentSize = sendto(sockfd,
@@ -213,10 +219,64 @@ ssize_t lwm2mcore_UdpSend
         }
         offset += sentSize;
     }
-    printf("lwm2mcore_UdpSend sentSize %zu\n", sentSize);
     return sentSize;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send several datagrams on a socket
+ * This function is called by the LwM2MCore when LWM2MCORE_UDP_BATCH is set
+ * The datagrams are sent by a single sendmmsg() call
+ *
+ * @return
+ *  - Number of sent datagrams
+ *  - -1 on error
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+int lwm2mcore_UdpSendBatch
+(
+    int sockfd,
+    const lwm2mcore_UdpDatagram_t* datagramsPtr,
+    size_t count
+)
+{
+    struct mmsghdr msgs[UDP_SEND_BATCH_SIZE];
+    struct iovec iovs[UDP_SEND_BATCH_SIZE];
+    size_t i;
+    int sentCount;
+
+    if (UDP_SEND_BATCH_SIZE < count)
+    {
+        count = UDP_SEND_BATCH_SIZE;
+    }
+
+    memset(msgs, 0, sizeof(msgs));
+    for (i = 0; i < count; i++)
+    {
+        iovs[i].iov_base = datagramsPtr[i].bufferPtr;
+        iovs[i].iov_len = datagramsPtr[i].len;
+        msgs[i].msg_hdr.msg_iov = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        msgs[i].msg_hdr.msg_name = (void*)&(datagramsPtr[i].addr);
+        msgs[i].msg_hdr.msg_namelen = datagramsPtr[i].addrLen;
+    }
+
+    do
+    {
+        sentCount = sendmmsg(sockfd, msgs, (unsigned int)count, 0);
+    }
+    while ((-1 == sentCount) && (EINTR == errno));
+
+    if (-1 == sentCount)
+    {
+        perror("socket");
+        printf("Error sending: %i\n",errno);
+        printf("%s\n", strerror(errno));
+    }
+    return sentCount;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Connect a socket
@@ -62,7 +62,12 @@ typedef struct
     uint8_t* payloadPtr;                            ///< [IN] Payload pointer
     size_t payloadLength;                           ///< [IN] Payload length
     lwm2mcore_StreamStatus_t  streamStatus;         ///< [IN] Status of the transmit stream
-    uint16_t blockSize;                             ///< [IN] Block size
+    uint16_t blockSize;                             ///< [IN] Block size, 0 for the block size
+                                                    ///< selected on the connection (see
+                                                    ///< lwm2mcore_GetBlockSize()). 0 was
+                                                    ///< previously passed as is to the CoAP
+                                                    ///< layer, which then used its default
+                                                    ///< block size of 1024 bytes
 }
 lwm2mcore_CoapResponse_t;
 
@@ -345,6 +350,28 @@ uint16_t lwm2mcore_GetBlock1Size
     lwm2mcore_CoapRequest_t* requestRef    ///< [IN] CoAP request reference
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Function to get the block size selected on the connection to the server.
+ *
+ * The block size is measured on the full blocks (Block1 option of a request, Block2 option of a
+ * response, with more blocks to follow) of the confirmable messages sent on the connection,
+ * whatever the block-wise transfer carrying them. It starts from @c LWM2MCORE_BLOCK_SIZE_MAX, is
+ * halved when a block has to be retransmitted and doubled again after a series of blocks
+ * acknowledged without retransmission.
+ * The client should use it to split the payload of its block-wise responses and notifications.
+ *
+ * @remark Public function which can be called by the client.
+ *
+ * @return
+ *  - block size: power of 2 from 16 to 1024
+ */
+//--------------------------------------------------------------------------------------------------
+uint16_t lwm2mcore_GetBlockSize
+(
+    lwm2mcore_Ref_t instanceRef             ///< [IN] instance reference
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * @brief Function to send an asynchronous response to server.
@@ -0,0 +1,127 @@
+/**
+ * @file log.h
+ *
+ * Header file for the log sinks of LwM2MCore
+ *
+ * The LwM2MCore logs are formatted as text lines and given to lwm2m_printf() by default. When
+ * LwM2MCore is compiled with @c LWM2MCORE_BINARY_LOGS, the logs can be stored as binary records in
+ * a ring buffer instead: the format strings are not processed on the device, the records are
+ * decoded offline with the LwM2MCore image.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+#ifndef __LWM2MCORE_LOG_H__
+#define __LWM2MCORE_LOG_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <lwm2mcore/lwm2mcore.h>
+
+/**
+  * @addtogroup lwm2mcore_logSink_IFS
+  * @{
+  */
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Log sinks
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    LWM2MCORE_LOG_SINK_TEXT,            ///< Text lines given to lwm2m_printf() (default)
+    LWM2MCORE_LOG_SINK_BINARY,          ///< Binary records stored in the log ring buffer
+    LWM2MCORE_LOG_SINK_NONE             ///< Logs are discarded
+}lwm2mcore_LogSink_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Binary log record types
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    LWM2MCORE_LOG_RECORD_MESSAGE,       ///< Arguments of the format string of the call site
+    LWM2MCORE_LOG_RECORD_DUMP,          ///< Dumped data, described by the call site string
+    LWM2MCORE_LOG_RECORD_SUPPRESSED     ///< Number of logs suppressed on the call site (uint32_t)
+}lwm2mcore_LogRecordType_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Flag set in the record type when the arguments or the dumped data are truncated
+ */
+//--------------------------------------------------------------------------------------------------
+#define LWM2MCORE_LOG_RECORD_TRUNCATED  0x80
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Header of a binary log record, in the native byte order
+ *
+ * The header is followed by the record payload:
+ * - @ref LWM2MCORE_LOG_RECORD_MESSAGE: one field per conversion of the format string. Integers
+ *   without length modifier and @c * widths or precisions use 4 bytes, integers with a length
+ *   modifier (l, ll, j, z, t), pointers and floating point values (double) use 8 bytes, strings
+ *   use 1 length byte followed by the characters (without terminating null character).
+ * - @ref LWM2MCORE_LOG_RECORD_DUMP: the dumped bytes.
+ * - @ref LWM2MCORE_LOG_RECORD_SUPPRESSED: the number of suppressed logs (4 bytes).
+ *
+ * The site identifier is the offset of the call site string in the @c lwm2mcore_log section of
+ * the LwM2MCore image. The call site string is the source file name and line, a colon-separated
+ * pair, followed by a null character and by the format string (or the dump description).
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct __attribute__((packed))
+{
+    uint16_t len;                       ///< Record length, including the header
+    uint8_t  type;                      ///< Record type (lwm2mcore_LogRecordType_t), and
+                                        ///< LWM2MCORE_LOG_RECORD_TRUNCATED
+    uint8_t  level;                     ///< Log level
+    uint32_t siteId;                    ///< Call site identifier
+    uint32_t timeMs;                    ///< Time of the log (lwm2mcore_TimerGetTimeMs, 32 LSB)
+}lwm2mcore_LogRecordHeader_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Select the log sink
+ *
+ * @remark Public function which can be called by the client.
+ *
+ * @return
+ *  - @ref LWM2MCORE_ERR_COMPLETED_OK on success
+ *  - @ref LWM2MCORE_ERR_INVALID_ARG if the sink is unknown
+ *  - @ref LWM2MCORE_ERR_OP_NOT_SUPPORTED if LwM2MCore is compiled without
+ *    @c LWM2MCORE_BINARY_LOGS and the binary sink is selected
+ */
+//--------------------------------------------------------------------------------------------------
+lwm2mcore_Sid_t lwm2mcore_SetLogSink
+(
+    lwm2mcore_LogSink_t sink            ///< [IN] Log sink
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Read and remove the oldest records of the log ring buffer
+ *
+ * Only complete records are copied. When the ring buffer is full, the oldest records are
+ * overwritten by the new ones. The records can be written from several threads, e.g. by the package
+ * downloader.
+ *
+ * @remark Public function which can be called by the client.
+ *
+ * @return
+ *  - Number of bytes copied in the buffer
+ */
+//--------------------------------------------------------------------------------------------------
+size_t lwm2mcore_ReadLogRing
+(
+    uint8_t* bufferPtr,                 ///< [OUT] Buffer
+    size_t len                          ///< [IN] Buffer length
+);
+
+/**
+  * @}
+  */
+
+#endif /* __LWM2MCORE_LOG_H__ */
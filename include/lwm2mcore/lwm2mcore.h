@@ -222,8 +222,11 @@ typedef enum
     LWM2MCORE_EVENT_LWM2M_SESSION_INACTIVE         = 24,    ///< LWM2M Event to know if the session is inactive for 20 sec
     LWM2MCORE_EVENT_PACKAGE_SIZE_ERROR             = 25,    ///< An error occured during the package size retrieval
     LWM2MCORE_EVENT_REG_UPDATE_DONE                = 26,    ///< A register update was successfully sent
+    LWM2MCORE_EVENT_NAT_TIMEOUT                    = 27,    ///< The learned NAT timeout changed
+    LWM2MCORE_EVENT_COAP_RTT                       = 28,    ///< The CoAP retransmission timeout
+                                                            ///< of a server changed
     /* NEW EVENT TO BE ADDED BEFORE THIS COMMENT */
-    LWM2MCORE_EVENT_LAST                           = 27     ///< Internal usage
+    LWM2MCORE_EVENT_LAST                           = 29     ///< Internal usage
 }lwm2mcore_StatusType_t;
 /**
   * @}
@@ -364,7 +367,9 @@ typedef enum
     LWM2MCORE_ACK_TIMEOUT,          ///< Transaction time out
     LWM2MCORE_ACK_FAILURE,          ///< Data is not correctly transferred
     LWM2MCORE_ACK_REJECTED,         ///< Data is rejected by the server, need a bootstrap
-    LWM2MCORE_ACK_EXPIRED           ///< Data is rejected by the server
+    LWM2MCORE_ACK_EXPIRED,          ///< Data is rejected by the server
+    LWM2MCORE_ACK_DROPPED           ///< Queued data is dropped before being sent, see
+                                    ///< lwm2mcore_SetPushQueue()
 } lwm2mcore_AckResult_t;
 
 //--------------------------------------------------------------------------------------------------
@@ -376,9 +381,22 @@ typedef enum
 {
     LWM2MCORE_PUSH_INITIATED = 0,    ///< Push successfully initiated.
     LWM2MCORE_PUSH_BUSY,             ///< Busy doing a block transfer.
-    LWM2MCORE_PUSH_FAILED            ///< Failed to initiate push.
+    LWM2MCORE_PUSH_FAILED,           ///< Failed to initiate push.
+    LWM2MCORE_PUSH_QUEUED            ///< Push queued until the previous ones are acknowledged.
 } lwm2mcore_PushResult_t;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Enum for LwM2M push queue policy, applied when a push exceeds the queue memory budget
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    LWM2MCORE_PUSH_QUEUE_DROP_NEW = 0,  ///< The new push is rejected (LWM2MCORE_PUSH_BUSY).
+    LWM2MCORE_PUSH_QUEUE_DROP_OLDEST,   ///< The oldest queued pushes are dropped.
+    LWM2MCORE_PUSH_QUEUE_OVERWRITE      ///< The newest queued push is replaced by the new one.
+} lwm2mcore_PushQueuePolicy_t;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * @brief Enum for LwM2M push content type
@@ -432,6 +450,37 @@ typedef void (*lwm2mcore_PushAckCallback_t)
     lwm2mcore_AckResult_t result,       ///< [IN] result of the transaction
     uint16_t midPtr                     ///< [IN] message id
 );
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Part of a scattered push payload, see lwm2mcore_PushIovec()
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const uint8_t* basePtr;             ///< Start of the part
+    size_t len;                         ///< Length of the part
+} lwm2mcore_PushIovec_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Function pointer of push payload reader, see lwm2mcore_PushStream().
+ *
+ * The reader copies the next bytes of the payload in the buffer. It is called each time a block
+ * of the payload is sent, possibly several times per block.
+ *
+ * @return
+ *  - @ref LWM2MCORE_ERR_COMPLETED_OK on success. The number of copied bytes is set to 0 at the end
+ *    of the payload.
+ *  - any other value aborts the push
+ */
+//--------------------------------------------------------------------------------------------------
+typedef lwm2mcore_Sid_t (*lwm2mcore_PushReader_t)
+(
+    void* contextPtr,                   ///< [IN] context given to lwm2mcore_PushStream()
+    uint8_t* bufferPtr,                 ///< [OUT] buffer
+    size_t* lenPtr                      ///< [INOUT] buffer length, number of copied bytes
+);
 /**
   * @}
   */
@@ -510,6 +559,34 @@ typedef struct
                                             ///< @ref LWM2MCORE_EVENT_LWM2M_SESSION_TYPE_START event
 }lwm2mcore_SessionStatus_t;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Structure for NAT timeout event
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t timeout;                       ///< Learned NAT timeout in seconds for
+                                            ///< @ref LWM2MCORE_EVENT_NAT_TIMEOUT event
+}lwm2mcore_NatStatus_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Structure for CoAP round-trip time event
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t rtoMs;                         ///< Retransmission timeout in ms for
+                                            ///< @ref LWM2MCORE_EVENT_COAP_RTT event
+    uint32_t strongRttMs;                   ///< Smoothed round-trip time of the messages
+                                            ///< acknowledged after one transmission in ms, 0 if
+                                            ///< not measured yet
+    uint32_t weakRttMs;                     ///< Smoothed round-trip time of the messages
+                                            ///< acknowledged after a retransmission in ms, 0 if
+                                            ///< not measured yet
+}lwm2mcore_RttStatus_t;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * @brief Structure for events (session and package download)
@@ -522,6 +599,8 @@ typedef struct
     {
         lwm2mcore_SessionStatus_t   session;    ///< Session information
         lwm2mcore_PkgDwlStatus_t    pkgStatus;  ///< Package download status
+        lwm2mcore_NatStatus_t       nat;        ///< NAT timeout
+        lwm2mcore_RttStatus_t       rtt;        ///< CoAP round-trip time
     }u;                                         ///< Union
 }lwm2mcore_Status_t;
 /**
@@ -604,6 +683,130 @@ typedef int (*lwm2mcore_ExecuteCallback_t)
     size_t len                          ///< [IN] length of buffer
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Enumeration for the kind of value carried by @ref lwm2mcore_Value_t
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    LWM2MCORE_VALUE_NONE,               ///< No value (no data / no more resource instance)
+    LWM2MCORE_VALUE_INT,                ///< Integer value, see lwm2mcore_Value_t.value.asInt
+    LWM2MCORE_VALUE_FLOAT,              ///< Float value, see lwm2mcore_Value_t.value.asFloat
+    LWM2MCORE_VALUE_BOOL,               ///< Boolean value, see lwm2mcore_Value_t.value.asBool
+    LWM2MCORE_VALUE_BUFFER              ///< String or opaque data, see
+                                        ///< lwm2mcore_Value_t.value.asBuffer
+}lwm2mcore_ValueType_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Typed resource value exchanged with the typed READ/WRITE handlers
+ *
+ * For a READ operation, the value is initialized to @ref LWM2MCORE_VALUE_NONE and
+ * value.asBuffer describes a scratch buffer owned by LwM2MCore (bufferPtr/len give its address
+ * and capacity). A handler returning a buffer can either fill this scratch buffer or make
+ * bufferPtr point to its own storage, which needs to stay valid until the handler returns to
+ * LwM2MCore. In both cases, len has to be set to the length of the returned data.
+ *
+ * For a WRITE operation, value.asBuffer is a view on the received data and is only valid during
+ * the handler call.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    lwm2mcore_ValueType_t type;         ///< Value type
+    union
+    {
+        int64_t asInt;                  ///< Integer value
+        double  asFloat;                ///< Float value
+        bool    asBool;                 ///< Boolean value
+        struct
+        {
+            char*   bufferPtr;          ///< Buffer address
+            size_t  len;                ///< Buffer length
+        }asBuffer;                      ///< String or opaque data
+    }value;                             ///< Union
+}lwm2mcore_Value_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Function pointer of typed resource READ function.
+ *
+ * Unlike @ref lwm2mcore_ReadCallback_t, the value is not serialized in a byte buffer but directly
+ * provided in a @ref lwm2mcore_Value_t which is encoded by LwM2MCore in the LwM2M payload.
+ * Setting the value type to @ref LWM2MCORE_VALUE_NONE indicates that no data is available (for a
+ * multiple instance resource: no more resource instance).
+ *
+ * @return
+ *  - @c 0 on success
+ *  - negative value on failure
+ */
+//--------------------------------------------------------------------------------------------------
+typedef int (*lwm2mcore_ReadValueCallback_t)
+(
+    lwm2mcore_Uri_t* uriPtr,            ///< [IN] uri represents the requested operation and
+                                        ///< object/resource.
+    lwm2mcore_Value_t* valuePtr         ///< [INOUT] read value
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Function pointer of typed resource WRITE function.
+ *
+ * Unlike @ref lwm2mcore_WriteCallback_t, the received data is decoded by LwM2MCore according to
+ * the resource type and provided in a @ref lwm2mcore_Value_t.
+ *
+ * @return
+ *  - @c 0 on success
+ *  - negative value on failure
+ */
+//--------------------------------------------------------------------------------------------------
+typedef int (*lwm2mcore_WriteValueCallback_t)
+(
+    lwm2mcore_Uri_t* uriPtr,            ///< [IN] uri represents the requested operation and
+                                        ///< object/resource.
+    const lwm2mcore_Value_t* valuePtr   ///< [IN] value to write
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Function pointer of chunked resource READ function.
+ *
+ * Used for string and opaque resources whose value can exceed the LwM2MCore read buffer. The
+ * handler is called with increasing offsets and copies the part of the value starting at the
+ * given offset in the provided buffer. A chunk shorter than the provided buffer length indicates
+ * the end of the value.
+ *
+ * @return
+ *  - @c 0 on success
+ *  - negative value on failure
+ */
+//--------------------------------------------------------------------------------------------------
+typedef int (*lwm2mcore_ReadChunkCallback_t)
+(
+    lwm2mcore_Uri_t* uriPtr,            ///< [IN] uri represents the requested operation and
+                                        ///< object/resource.
+    size_t offset,                      ///< [IN] offset of the chunk in the resource value
+    char* bufferPtr,                    ///< [OUT] chunk buffer
+    size_t* lenPtr                      ///< [INOUT] length of chunk buffer and length of the
+                                        ///< returned chunk
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Resource cache policy: the read value is never cached
+ */
+//--------------------------------------------------------------------------------------------------
+#define LWM2MCORE_CACHE_NEVER   0
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Resource cache policy: the read value is cached until it is invalidated by
+ * lwm2mcore_NotifyResourceChange()
+ */
+//--------------------------------------------------------------------------------------------------
+#define LWM2MCORE_CACHE_STATIC  UINT32_MAX
+
 //--------------------------------------------------------------------------------------------------
 /**
  * @brief Structure for an object resource
@@ -617,8 +820,37 @@ typedef struct
     lwm2mcore_ReadCallback_t read;      ///< operation handler: READ handler
     lwm2mcore_WriteCallback_t write;    ///< operation handler: WRITE handler
     lwm2mcore_ExecuteCallback_t exec;   ///< operation handler: EXECUTE handler
+    lwm2mcore_ReadValueCallback_t readValue;    ///< operation handler: typed READ handler,
+                                                ///< used instead of read when both are set
+    lwm2mcore_WriteValueCallback_t writeValue;  ///< operation handler: typed WRITE handler,
+                                                ///< used instead of write when both are set
+    lwm2mcore_ReadChunkCallback_t readChunk;    ///< operation handler: chunked READ handler,
+                                                ///< used when read and readValue are NULL
+    uint32_t cacheTtl;                  ///< cache policy of the read value: @ref LWM2MCORE_CACHE_NEVER,
+                                        ///< @ref LWM2MCORE_CACHE_STATIC or validity in ms
 }lwm2mcore_Resource_t;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Function pointer of object instance snapshot function.
+ *
+ * Called when all the resources of an object instance are read in one request: once with
+ * isStart set to true before the resource READ handlers are called, and once with isStart set
+ * to false after they were called. This allows the object to retrieve all its resource values
+ * at once from the platform and to serve the resource READ handlers from this consistent
+ * snapshot.
+ *
+ * @return
+ *  - @c 0 on success
+ *  - negative value on failure (the resources are then read individually)
+ */
+//--------------------------------------------------------------------------------------------------
+typedef int (*lwm2mcore_SnapshotCallback_t)
+(
+    lwm2mcore_Uri_t* uriPtr,            ///< [IN] uri represents the object instance
+    bool isStart                        ///< [IN] true to take the snapshot, false to release it
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * @brief Structure for an object
@@ -630,6 +862,8 @@ typedef struct
     uint16_t maxObjInstCnt;                 ///< maximum number of object instance count. 1 means single instance.
     uint16_t resCnt;                        ///< number of resource count under this object
     lwm2mcore_Resource_t* resources;        ///< pointer to the list of resource under this object
+    lwm2mcore_SnapshotCallback_t snapshot;  ///< optional snapshot handler for full object instance
+                                            ///< read
 }lwm2mcore_Object_t;
 
 //--------------------------------------------------------------------------------------------------
@@ -710,6 +944,18 @@ bool lwm2mcore_SetEventHandler
 /**
  * @brief LwM2MCore init function
  *
+ * @note Several client instances can be initialized in the same process. The functions with an
+ * instance reference work on this instance and select it. The functions without instance reference
+ * (e.g. @ref lwm2mcore_ResourceRead, @ref lwm2mcore_IsEdmEnabled, @ref lwm2mcore_GetNatTimeout)
+ * work on the selected instance: the one given to the last function with an instance reference,
+ * or the last initialized one. They are not meant to be called while another instance is used,
+ * e.g. from another thread.
+ *
+ * @note The event handler of the events which are not linked to an instance (the one of the last
+ * @ref lwm2mcore_Init or @ref lwm2mcore_SetEventHandler call), the push callback, the bootstrap
+ * and ACL configurations (freed with the last instance), the package downloader, the metrics and
+ * the logs are shared by all the instances of the process.
+ *
  * @return
  *  - instance reference
  *  - @c NULL in case of error
@@ -790,6 +1036,9 @@ void lwm2mcore_SkipDeregister
 /**
  * @brief Free LwM2MCore
  *
+ * @note The instance which was selected before the call stays selected, unless it is the freed
+ * one: no instance is selected then (see @ref lwm2mcore_Init).
+ *
  * @remark Public function which can be called by the client.
  */
 //--------------------------------------------------------------------------------------------------
@@ -891,6 +1140,14 @@ bool lwm2mcore_ResourceRead
 /**
  * @brief Function to notify change on an observed resource.
  *
+ * The change is evaluated against the observe attributes written by the server (pmin, pmax, gt,
+ * lt, st): a change on a resource which is not observed, an unchanged value or a value which does
+ * not reach a threshold/step is not notified. A change occurring before the minimum period is
+ * notified when this period elapses. Each observation is evaluated against the attributes of its
+ * own server: the change is notified as soon as one observation needs it.
+ *
+ * The changes are batched: see lwm2mcore_SetNotificationWindow().
+ *
  * @remark Public function which can be called by the client.
  *
  * @return
@@ -906,6 +1163,26 @@ bool lwm2mcore_NotifyResourceChange
     uint16_t resourceId                ///< [IN] resource identifier
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Function to set the batching window of resource change notifications.
+ *
+ * Resource changes reported by lwm2mcore_NotifyResourceChange() during this window are flushed
+ * to the observers in a single step. A window of 0 flushes them on the next step.
+ *
+ * @remark Public function which can be called by the client.
+ *
+ * @return
+ *      - @c true if the window was set
+ *      - else @c false
+ */
+//--------------------------------------------------------------------------------------------------
+bool lwm2mcore_SetNotificationWindow
+(
+    lwm2mcore_Ref_t instanceRef,       ///< [IN] instance reference
+    uint32_t windowMs                  ///< [IN] batching window in ms
+);
+
 /**
   * @}
   */
@@ -1018,9 +1295,15 @@ bool lwm2mcore_ConnectionGetType
  *
  * @remark Public function which can be called by the client.
  *
+ * When the push queue is enabled (see lwm2mcore_SetPushQueue()), a push initiated while another
+ * one is in flight is copied in the queue and sent when the previous ones are acknowledged. The
+ * payload buffer can then be reused as soon as the function returns.
+ *
  * @return
  *  - @ref LWM2MCORE_PUSH_INITIATED if data push transaction is initiated
- *  - @ref LWM2MCORE_PUSH_BUSY if state machine is busy doing a block transfer
+ *  - @ref LWM2MCORE_PUSH_QUEUED if the push is queued, the message id is then set to 0
+ *  - @ref LWM2MCORE_PUSH_BUSY if state machine is busy doing a block transfer and the push is
+ *    not queued
  *  - @ref LWM2MCORE_PUSH_FAILED if data push transaction failed
  */
 //--------------------------------------------------------------------------------------------------
@@ -1034,9 +1317,63 @@ lwm2mcore_PushResult_t lwm2mcore_Push
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Function to push data read from a callback.
+ *
+ * The payload is sent block-wise (CoAP Block1), the reader being called for each block: only one
+ * block of the payload is in memory at a time. The reader and its context have to remain valid
+ * until the push callback is called with the message id of the first block.
+ *
+ * Only one streamed push is handled at a time. It is not queued (see lwm2mcore_SetPushQueue()).
+ *
+ * @remark Public function which can be called by the client.
+ *
+ * @return
+ *  - @ref LWM2MCORE_PUSH_INITIATED if the first block is sent
+ *  - @ref LWM2MCORE_PUSH_BUSY if a streamed push is in progress
+ *  - @ref LWM2MCORE_PUSH_FAILED if data push transaction failed
+ */
+//--------------------------------------------------------------------------------------------------
+lwm2mcore_PushResult_t lwm2mcore_PushStream
+(
+    lwm2mcore_Ref_t instanceRef,            ///< [IN] instance reference
+    lwm2mcore_PushReader_t readerCb,        ///< [IN] payload reader
+    void* contextPtr,                       ///< [IN] context given to the reader
+    lwm2mcore_PushContent_t content,        ///< [IN] content type
+    uint16_t* midPtr                        ///< [OUT] message id of the first block
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Function to push data scattered in several buffers.
+ *
+ * The parts are sent block-wise (CoAP Block1) without being gathered in a single buffer: see
+ * lwm2mcore_PushStream(). The parts and their description have to remain valid until the push
+ * callback is called with the message id of the first block.
+ *
+ * @remark Public function which can be called by the client.
+ *
+ * @return
+ *  - @ref LWM2MCORE_PUSH_INITIATED if the first block is sent
+ *  - @ref LWM2MCORE_PUSH_BUSY if a streamed push is in progress
+ *  - @ref LWM2MCORE_PUSH_FAILED if data push transaction failed
+ */
+//--------------------------------------------------------------------------------------------------
+lwm2mcore_PushResult_t lwm2mcore_PushIovec
+(
+    lwm2mcore_Ref_t instanceRef,            ///< [IN] instance reference
+    const lwm2mcore_PushIovec_t* iovPtr,    ///< [IN] payload parts
+    size_t iovCount,                        ///< [IN] number of payload parts
+    lwm2mcore_PushContent_t content,        ///< [IN] content type
+    uint16_t* midPtr                        ///< [OUT] message id of the first block
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * @brief Function to set the push callback handler
+ *
+ * @note The push callback is shared by all the client instances of the process.
  */
 //--------------------------------------------------------------------------------------------------
 void lwm2mcore_SetPushCallback
@@ -1044,6 +1381,37 @@ void lwm2mcore_SetPushCallback
     lwm2mcore_PushAckCallback_t callbackP  ///< [IN] push callback pointer
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Function to configure the queue of the pushes initiated while another one is in flight.
+ *
+ * The queued payloads are copied within the memory budget, which includes a small overhead per
+ * push. When a push exceeds the budget, the policy selects the dropped push. The pushes are sent
+ * and acknowledged in order: the push callback is called once per push, with
+ * @ref LWM2MCORE_ACK_DROPPED and a message id of 0 for a dropped push.
+ *
+ * When the aggregation is enabled, the uncompressed CBOR payloads waiting in the queue are sent
+ * in a single message, as a CBOR array of these payloads. The push callback is then called for
+ * each aggregated push with the message id of the aggregated message.
+ *
+ * The queue is disabled by default, unless LwM2MCore is compiled with
+ * @c LWM2MCORE_PUSH_QUEUE_BUDGET.
+ *
+ * @remark Public function which can be called by the client.
+ *
+ * @return
+ *      - @c true if the queue was configured
+ *      - else @c false
+ */
+//--------------------------------------------------------------------------------------------------
+bool lwm2mcore_SetPushQueue
+(
+    lwm2mcore_Ref_t instanceRef,            ///< [IN] instance reference
+    size_t budget,                          ///< [IN] memory budget in bytes, 0 to disable the queue
+    lwm2mcore_PushQueuePolicy_t policy,     ///< [IN] policy when the budget is exceeded
+    bool isAggregated                       ///< [IN] aggregate the queued CBOR payloads
+);
+
 /**
   * @}
   */
@@ -1441,6 +1809,38 @@ void lwm2mcore_SetNatTimeout
     uint32_t        timeout        ///< [IN] Timeout
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Enable or disable the learning of the NAT timeout.
+ *
+ * When enabled, the NAT timeout set by lwm2mcore_SetNatTimeout() is the initial value. It is
+ * increased when the server can still reach the device after a longer inactivity, and decreased
+ * when a longer inactivity lost the NAT binding. Each change is reported by the
+ * @ref LWM2MCORE_EVENT_NAT_TIMEOUT event, so that the client can adapt the period of its
+ * registration updates or keepalive messages.
+ *
+ * @note Storage: volatile memory
+ */
+//--------------------------------------------------------------------------------------------------
+void lwm2mcore_SetAdaptiveNatTimeout
+(
+    bool            isAdaptive     ///< [IN] Learn the NAT timeout
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Get the NAT timeout in use by the selected client instance, learned or configured
+ *
+ * @return
+ *  - NAT timeout in seconds
+ *  - 0 if no client instance is selected
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t lwm2mcore_GetNatTimeout
+(
+    void
+);
+
 /**
   * @}
   */
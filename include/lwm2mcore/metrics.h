@@ -0,0 +1,151 @@
+/**
+ * @file metrics.h
+ *
+ * Header file for the performance metrics of LwM2MCore
+ *
+ * LwM2MCore measures the latency of its main operations (log-scale histograms) and counts the
+ * network traffic. The metrics are shared by all the client instances and are updated with atomic
+ * operations: they can be read from any thread, without lock.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+#ifndef __LWM2MCORE_METRICS_H__
+#define __LWM2MCORE_METRICS_H__
+
+#include <stdint.h>
+#include <lwm2mcore/lwm2mcore.h>
+
+/**
+  * @addtogroup lwm2mcore_metrics_IFS
+  * @{
+  */
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Number of buckets of a latency histogram
+ *
+ * Bucket 0 counts the operations which took less than 1 ms. Bucket i (i > 0) counts the operations
+ * which took between 2^(i-1) ms and 2^i ms (excluded). The last bucket also counts all the longer
+ * operations (more than 2^18 ms, about 4 minutes).
+ */
+//--------------------------------------------------------------------------------------------------
+#define LWM2MCORE_METRIC_BUCKETS    20
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Operations whose latency is measured
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    LWM2MCORE_METRIC_READ,              ///< Treatment of a READ request
+    LWM2MCORE_METRIC_WRITE,             ///< Treatment of a WRITE request
+    LWM2MCORE_METRIC_EXECUTE,           ///< Treatment of an EXECUTE request
+    LWM2MCORE_METRIC_DISCOVER,          ///< Treatment of a DISCOVER request
+    LWM2MCORE_METRIC_DTLS_HANDSHAKE,    ///< DTLS full handshake, including rehandshakes
+    LWM2MCORE_METRIC_DTLS_RESUME,       ///< DTLS session resumption
+    LWM2MCORE_METRIC_REGISTRATION,      ///< Registration round trip
+    LWM2MCORE_METRIC_REG_UPDATE,        ///< Registration update round trip
+    LWM2MCORE_METRIC_MAX                ///< Internal usage
+}lwm2mcore_Metric_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Event counters
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    LWM2MCORE_COUNTER_COAP_RETRANSMISSIONS, ///< Confirmable CoAP messages sent again
+    LWM2MCORE_COUNTER_UDP_TX_BYTES,         ///< Bytes sent on the UDP socket
+    LWM2MCORE_COUNTER_UDP_TX_DATAGRAMS,     ///< Datagrams sent on the UDP socket
+    LWM2MCORE_COUNTER_UDP_RX_BYTES,         ///< Bytes received on the UDP socket
+    LWM2MCORE_COUNTER_UDP_RX_DATAGRAMS,     ///< Datagrams received on the UDP socket
+    LWM2MCORE_COUNTER_DOWNLOAD_BYTES,       ///< Package bytes given to the package downloader
+    LWM2MCORE_COUNTER_DOWNLOAD_TIME_MS,     ///< Time spent to receive the package bytes in ms
+                                            ///< (throughput = DOWNLOAD_BYTES / DOWNLOAD_TIME_MS)
+    LWM2MCORE_COUNTER_DTLS_RESUMES_AVOIDED, ///< DTLS resumes not needed after an inactivity
+                                            ///< thanks to the DTLS Connection ID
+    LWM2MCORE_COUNTER_DTLS_RECORDS_COALESCED, ///< DTLS records sent in the datagram of previous
+                                            ///< records (LWM2MCORE_DTLS_COALESCE)
+    LWM2MCORE_COUNTER_MAX                   ///< Internal usage
+}lwm2mcore_Counter_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Latency histogram of an operation
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint64_t count;                             ///< Number of measured operations
+    uint64_t errorCount;                        ///< Number of operations which failed
+    uint64_t totalMs;                           ///< Cumulated duration of the operations in ms
+    uint64_t maxMs;                             ///< Longest operation in ms
+    uint64_t buckets[LWM2MCORE_METRIC_BUCKETS]; ///< Operations per duration range (log2 ms)
+}lwm2mcore_Histogram_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Get the latency histogram of an operation
+ *
+ * @note The fields are read one by one: an operation measured during the call can be partially
+ * reflected in the histogram.
+ *
+ * @return
+ *  - @ref LWM2MCORE_ERR_COMPLETED_OK on success
+ *  - @ref LWM2MCORE_ERR_INVALID_ARG if a parameter is invalid
+ */
+//--------------------------------------------------------------------------------------------------
+lwm2mcore_Sid_t lwm2mcore_GetHistogram
+(
+    lwm2mcore_Metric_t metric,              ///< [IN] Measured operation
+    lwm2mcore_Histogram_t* histogramPtr     ///< [OUT] Latency histogram
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Get the value of a counter
+ *
+ * @return
+ *  - @ref LWM2MCORE_ERR_COMPLETED_OK on success
+ *  - @ref LWM2MCORE_ERR_INVALID_ARG if a parameter is invalid
+ */
+//--------------------------------------------------------------------------------------------------
+lwm2mcore_Sid_t lwm2mcore_GetCounter
+(
+    lwm2mcore_Counter_t counter,            ///< [IN] Counter
+    uint64_t* valuePtr                      ///< [OUT] Counter value
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Get the name of a measured operation (used in logs and by the diagnostics object)
+ *
+ * @return
+ *  - Operation name
+ *  - @c NULL if the operation is unknown
+ */
+//--------------------------------------------------------------------------------------------------
+const char* lwm2mcore_GetMetricName
+(
+    lwm2mcore_Metric_t metric               ///< [IN] Measured operation
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Reset all the histograms and counters
+ */
+//--------------------------------------------------------------------------------------------------
+void lwm2mcore_ResetMetrics
+(
+    void
+);
+
+/**
+  * @}
+  */
+
+#endif /* __LWM2MCORE_METRICS_H__ */
@@ -28,6 +28,7 @@ typedef enum
     LWM2MCORE_TIMER_STEP,           ///< Timer step
     LWM2MCORE_TIMER_INACTIVITY,     ///< Inactivity timer
     LWM2MCORE_TIMER_DOWNLOAD,       ///< Timer for package download
+    LWM2MCORE_TIMER_WHEEL,          ///< Timer driving the internal timer wheel
     LWM2MCORE_TIMER_MAX             ///< Maximum timer value (internal use)
 }lwm2mcore_TimerType_t;
 
@@ -61,6 +62,26 @@ bool lwm2mcore_TimerSet
     lwm2mcore_TimerCallback_t cb    ///< [IN] Timer callback
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Adaptation function for timer start with a ms resolution
+ *
+ * @remark Platform adaptor function which needs to be defined on client side.
+ *
+ * @note A value of 0 makes the timer expire as soon as possible.
+ *
+ * @return
+ *  - @c true  on success
+ *  - @c false on failure
+ */
+//--------------------------------------------------------------------------------------------------
+bool lwm2mcore_TimerSetMs
+(
+    lwm2mcore_TimerType_t timer,    ///< [IN] Timer Id
+    uint32_t timeMs,                ///< [IN] Timer value in ms
+    lwm2mcore_TimerCallback_t cb    ///< [IN] Timer callback
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * @brief Adaptation function for timer stop
@@ -97,6 +118,56 @@ bool lwm2mcore_TimerIsRunning
     lwm2mcore_TimerType_t timer    ///< [IN] Timer Id
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Adaptation function to get a monotonic time in milliseconds
+ *
+ * @remark Platform adaptor function which needs to be defined on client side.
+ *
+ * @return
+ *  - Monotonic time in milliseconds (not affected by system time changes)
+ */
+//--------------------------------------------------------------------------------------------------
+uint64_t lwm2mcore_TimerGetTimeMs
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Function to get the delay until the next LwM2MCore timer expiry.
+ *
+ * When LwM2MCore is built with @c LWM2MCORE_TIMER_EVENT_LOOP, the timer adaptor functions above
+ * are provided by LwM2MCore itself and no platform timer is used: the client event loop waits
+ * at most this delay and then calls lwm2mcore_ProcessTimers().
+ *
+ * @remark Public function which can be called by the client.
+ *
+ * @return
+ *  - Delay in ms (0 if a timer already expired)
+ *  - UINT32_MAX if no timer is running
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t lwm2mcore_GetNextDeadline
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Function to treat the expired LwM2MCore timers.
+ *
+ * @remark Public function which can be called by the client.
+ *
+ * @warning To be called from the client event loop only, not concurrently with any other
+ * LwM2MCore function.
+ */
+//--------------------------------------------------------------------------------------------------
+void lwm2mcore_ProcessTimers
+(
+    void
+);
+
 /**
   * @}
   */
@@ -42,6 +42,20 @@
 #define LWM2MCORE_UDP_RECV_ERR          0x04    ///< UDP error codes: Error occured during UDP receive
 #define LWM2MCORE_UDP_CONNECT_ERR       0x05    ///< UDP error codes: UDP connection failure
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief UDP datagram of a batch
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint8_t*                bufferPtr;      ///< Datagram data
+    uint32_t                len;            ///< Datagram length
+    struct sockaddr_storage addr;           ///< Source address (received datagram) or destination
+                                            ///< address (sent datagram)
+    socklen_t               addrLen;        ///< addr parameter length
+}lwm2mcore_UdpDatagram_t;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * @brief Callback for data receipt
@@ -72,6 +86,21 @@ void lwm2mcore_UdpReceiveCb
     lwm2mcore_SocketConfig_t config         ///< [IN] Socket config
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Callback for the receipt of several datagrams, e.g. read by a single recvmmsg() call
+ *
+ * @details The datagrams are handled in order. The datagrams sent by LwM2MCore while they are
+ * handled are sent together with lwm2mcore_UdpSendBatch() when @c LWM2MCORE_UDP_BATCH is set.
+ */
+//--------------------------------------------------------------------------------------------------
+void lwm2mcore_UdpReceiveBatchCb
+(
+    lwm2mcore_UdpDatagram_t* datagramsPtr,  ///< [IN] Received datagrams
+    size_t count,                           ///< [IN] Number of received datagrams
+    lwm2mcore_SocketConfig_t config         ///< [IN] Socket config
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * @brief Open a socket to the server
@@ -176,6 +205,29 @@ ssize_t lwm2mcore_UdpSend
     socklen_t addrLen                      ///< [IN] destAddrPtr parameter length
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Send several datagrams on a socket
+ *
+ * @details The aim of this function is to send the datagrams produced by one LwM2MCore step with
+ * as few system calls as possible, e.g. with sendmmsg(). The datagrams are sent in order.
+ *
+ * @remark Platform adaptor function which needs to be defined on client side when
+ * @c LWM2MCORE_UDP_BATCH is set.
+ *
+ * @return
+ *  - Number of sent datagrams, which can be lower than @c count
+ *  - @c -1 on error
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+int lwm2mcore_UdpSendBatch
+(
+    int sockfd,                                 ///< [IN] Socket Id
+    const lwm2mcore_UdpDatagram_t* datagramsPtr,///< [IN] Datagrams to be sent
+    size_t count                                ///< [IN] Number of datagrams
+);
+
 /**
   * @}
   */
@@ -35,8 +35,17 @@ set(LWM2MCORE_SOURCES
     ${LWM2MCORE_SOURCES_DIR}/packageDownloader/fileTransfer.c
     ${LWM2MCORE_SOURCES_DIR}/packageDownloader/update.c
     ${LWM2MCORE_SOURCES_DIR}/packageDownloader/workspace.c
+    ${LWM2MCORE_SOURCES_DIR}/sessionManager/coreLog.c
     ${LWM2MCORE_SOURCES_DIR}/sessionManager/dtlsConnection.c
-    ${LWM2MCORE_SOURCES_DIR}/sessionManager/lwm2mcoreSession.c)
+    ${LWM2MCORE_SOURCES_DIR}/sessionManager/lwm2mcoreSession.c
+    ${LWM2MCORE_SOURCES_DIR}/sessionManager/perfMetrics.c
+    ${LWM2MCORE_SOURCES_DIR}/sessionManager/pushQueue.c
+    ${LWM2MCORE_SOURCES_DIR}/sessionManager/pushStream.c
+    ${LWM2MCORE_SOURCES_DIR}/sessionManager/natTimeout.c
+    ${LWM2MCORE_SOURCES_DIR}/sessionManager/udpBatch.c
+    ${LWM2MCORE_SOURCES_DIR}/sessionManager/coapRtt.c
+    ${LWM2MCORE_SOURCES_DIR}/sessionManager/blockSize.c
+    ${LWM2MCORE_SOURCES_DIR}/sessionManager/timerWheel.c)
 
 add_definitions(-g
                 -Wall
@@ -62,4 +71,24 @@ add_definitions(-g
 
 if ($ENV{LE_CONFIG_AVC_FEATURE_FILETRANSFER} MATCHES "y")
     add_definitions(-DLWM2M_OBJECT_33406)
-endif()
\ No newline at end of file
+endif()
+# The performance metrics use 64-bit atomic operations: some 32-bit targets implement them in
+# libatomic instead of inline instructions
+include(CheckCSourceCompiles)
+set(LWM2MCORE_ATOMIC_TEST_SOURCE
+    "#include <stdint.h>
+     static uint64_t Value;
+     int main(void)
+     {
+         return (int)__atomic_fetch_add(&Value, 1, __ATOMIC_RELAXED);
+     }")
+check_c_source_compiles("${LWM2MCORE_ATOMIC_TEST_SOURCE}" LWM2MCORE_HAS_INLINE_ATOMIC64)
+if(NOT LWM2MCORE_HAS_INLINE_ATOMIC64)
+    set(CMAKE_REQUIRED_LIBRARIES atomic)
+    check_c_source_compiles("${LWM2MCORE_ATOMIC_TEST_SOURCE}" LWM2MCORE_HAS_LIBATOMIC)
+    unset(CMAKE_REQUIRED_LIBRARIES)
+    if(NOT LWM2MCORE_HAS_LIBATOMIC)
+        message(FATAL_ERROR "64-bit atomic operations are not available")
+    endif()
+    link_libraries(atomic)
+endif()
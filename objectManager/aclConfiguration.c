@@ -19,6 +19,9 @@
 #include "aclConfiguration.h"
 #include "liblwm2m.h"
 
+#define LOG_MODULE_LEVEL LWM2MCORE_LOG_OBJECTS
+#include "coreLog.h"
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Structure for ACL configuration: list of received ACLs
@@ -207,7 +210,7 @@ static bool StoreAclConfiguration
         aclObjectInstancePtr = aclObjectInstancePtr->nextPtr;
     }
 
-    lwm2mcore_DataDump("ACL config data", dataPtr, lenToStore);
+    LOG_DUMP("ACL config data", dataPtr, lenToStore);
 
     if ( (LWM2MCORE_ERR_COMPLETED_OK == lwm2mcore_SetParam(LWM2MCORE_ACCESS_RIGHTS_SIZE_PARAM,
                                                            (uint8_t*)&lenToStore,
@@ -247,6 +250,9 @@ static bool LoadAclConfiguration
     AclObjectInstance_t* aclObjectInstanceListPtr;
     uint8_t* rawData;
 
+    /* Free the configuration: it is reloaded by each registered client instance */
+    FreeAclConfiguration(aclConfigPtr);
+
     /* Get the ACL configuration file size */
     sid = lwm2mcore_GetParam(LWM2MCORE_ACCESS_RIGHTS_SIZE_PARAM, (uint8_t*)&fileSize, &len);
     LOG_ARG("Get ACL configuration size: %d result %d, len %d", fileSize, sid, len);
@@ -20,6 +20,9 @@
 #include "bootstrapConfiguration.h"
 #include "liblwm2m.h"
 
+#define LOG_MODULE_LEVEL LWM2MCORE_LOG_OBJECTS
+#include "coreLog.h"
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Structure for bootstrap configuration: list of received bootstrap information
@@ -453,7 +456,7 @@ bool omanager_StoreBootstrapConfiguration
         serverPtr = serverPtr->nextPtr;
         loop--;
     }
-    lwm2mcore_DataDump("BS config data", dataPtr, lenToStore);
+    LOG_DUMP("BS config data", dataPtr, lenToStore);
     dataLenPtr = (uint8_t*)&lenToStore;
 
     if ( (LWM2MCORE_ERR_COMPLETED_OK == lwm2mcore_SetParam(LWM2MCORE_BOOTSTRAP_INFO_SIZE_PARAM,
@@ -26,6 +26,7 @@
 #include <lwm2mcore/location.h>
 #include <lwm2mcore/cellular.h>
 #include <lwm2mcore/lwm2mcorePackageDownloader.h>
+#include <lwm2mcore/metrics.h>
 #include "downloader.h"
 #include <lwm2mcore/timer.h>
 #include "handlers.h"
@@ -40,6 +41,9 @@
 #include "updateAgent.h"
 #include "clockTimeConfiguration.h"
 
+#define LOG_MODULE_LEVEL LWM2MCORE_LOG_OBJECTS
+#include "coreLog.h"
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Maximum number of bytes in the Universal Geographical Area Description of velocity
@@ -172,7 +176,7 @@ static lwm2mcore_Sid_t BuildVelocity
 
         sID = LWM2MCORE_ERR_COMPLETED_OK;
     }
-    lwm2mcore_DataDump("Velocity buffer", gadVelocity, gadVelocityLen);
+    LOG_DUMP("Velocity buffer", gadVelocity, gadVelocityLen);
 
     /* Copy the velocity to the output buffer */
     if (*lenPtr < gadVelocityLen)
@@ -370,7 +374,7 @@ int omanager_WriteSecurityObj
         /* Resource 1: Bootstrap server (true or false) */
         case LWM2MCORE_SECURITY_BOOTSTRAP_SERVER_RID:
 #ifdef CREDENTIALS_DEBUG
-            lwm2mcore_DataDump("server addr write", bufferPtr, len);
+            LOG_DUMP("server addr write", bufferPtr, len);
 #endif
             securityInformationPtr->data.isBootstrapServer =
                                             (bool)omanager_BytesToInt((const char*)bufferPtr, len);
@@ -393,7 +397,7 @@ int omanager_WriteSecurityObj
             else
             {
 #ifdef CREDENTIALS_DEBUG
-                lwm2mcore_DataDump("PSK ID write", bufferPtr, len);
+                LOG_DUMP("PSK ID write", bufferPtr, len);
 #endif
                 memset(securityInformationPtr->devicePKID, 0, DTLS_PSK_MAX_CLIENT_IDENTITY_LEN);
                 memcpy(securityInformationPtr->devicePKID, bufferPtr, len);
@@ -416,7 +420,7 @@ int omanager_WriteSecurityObj
             else
             {
 #ifdef CREDENTIALS_DEBUG
-                lwm2mcore_DataDump("PSK secret write", bufferPtr, len);
+                LOG_DUMP("PSK secret write", bufferPtr, len);
 #endif
                 memcpy(securityInformationPtr->secretKey, bufferPtr, len);
                 securityInformationPtr->pskLen = (uint16_t)len;
@@ -585,7 +589,7 @@ int omanager_ReadSecurityObj
                                               lenPtr);
             }
 #ifdef CREDENTIALS_DEBUG
-            lwm2mcore_DataDump("PSK ID read", bufferPtr, *lenPtr);
+            LOG_DUMP("PSK ID read", bufferPtr, *lenPtr);
 #endif
             break;
 
@@ -613,7 +617,7 @@ int omanager_ReadSecurityObj
                                               lenPtr);
             }
 #ifdef CREDENTIALS_DEBUG
-            lwm2mcore_DataDump("PSK secret read", bufferPtr, *lenPtr);
+            LOG_DUMP("PSK secret read", bufferPtr, *lenPtr);
 #endif
             break;
 
@@ -1973,9 +1977,9 @@ int omanager_ExecDeviceObj
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Function to read a resource of object 4
+ * Function to read a multiple instance resource of object 4
  * Object: 4 - Connectivity monitoring
- * Resource: All
+ * Resource: 1, 4, 5, 7
  *
  * @return
  *      - LWM2MCORE_ERR_COMPLETED_OK if the treatment succeeds
@@ -2022,21 +2026,6 @@ int omanager_ReadConnectivityMonitoringObj
 
     switch (uriPtr->rid)
     {
-        /* Resource 0: Network bearer */
-        case LWM2MCORE_CONN_MONITOR_NETWORK_BEARER_RID:
-        {
-            lwm2mcore_networkBearer_enum_t networkBearer;
-            sID = lwm2mcore_GetNetworkBearer(&networkBearer);
-            if (LWM2MCORE_ERR_COMPLETED_OK == sID)
-            {
-                *lenPtr = omanager_FormatValueToBytes((uint8_t*)bufferPtr,
-                                                      &networkBearer,
-                                                      sizeof(networkBearer),
-                                                      false);
-            }
-        }
-        break;
-
         /* Resource 1: Available network bearer */
         case LWM2MCORE_CONN_MONITOR_AVAIL_NETWORK_BEARER_RID:
             /* Check that the resource instance Id is in the correct range */
@@ -2081,36 +2070,6 @@ int omanager_ReadConnectivityMonitoringObj
             }
             break;
 
-        /* Resource 2: Radio signal strength */
-        case LWM2MCORE_CONN_MONITOR_RADIO_SIGNAL_STRENGTH_RID:
-        {
-            int32_t signalStrength;
-            sID = lwm2mcore_GetSignalStrength(&signalStrength);
-            if (LWM2MCORE_ERR_COMPLETED_OK == sID)
-            {
-                *lenPtr = omanager_FormatValueToBytes((uint8_t*)bufferPtr,
-                                                      &signalStrength,
-                                                      sizeof(signalStrength),
-                                                      true);
-            }
-        }
-        break;
-
-        /* Resource 3: Link quality */
-        case LWM2MCORE_CONN_MONITOR_LINK_QUALITY_RID:
-        {
-            int linkQuality;
-            sID = lwm2mcore_GetLinkQuality(&linkQuality);
-            if (LWM2MCORE_ERR_COMPLETED_OK == sID)
-            {
-                *lenPtr = omanager_FormatValueToBytes((uint8_t*)bufferPtr,
-                                                      &linkQuality,
-                                                      sizeof(linkQuality),
-                                                      true);
-            }
-        }
-        break;
-
         /* Resource 4: IP addresses */
         case LWM2MCORE_CONN_MONITOR_IP_ADDRESSES_RID:
             /* Check that the resource instance Id is in the correct range */
@@ -2199,21 +2158,6 @@ int omanager_ReadConnectivityMonitoringObj
             }
             break;
 
-        /* Resource 6: Link utilization */
-        case LWM2MCORE_CONN_MONITOR_LINK_UTILIZATION_RID:
-        {
-            uint8_t linkUtilization;
-            sID = lwm2mcore_GetLinkUtilization(&linkUtilization);
-            if (LWM2MCORE_ERR_COMPLETED_OK == sID)
-            {
-                *lenPtr = omanager_FormatValueToBytes((uint8_t*)bufferPtr,
-                                                      &linkUtilization,
-                                                      sizeof(linkUtilization),
-                                                      false);
-            }
-        }
-        break;
-
         /* Resource 7: Access Point Name */
         case LWM2MCORE_CONN_MONITOR_APN_RID:
             /* Check that the resource instance Id is in the correct range */
@@ -2257,18 +2201,89 @@ int omanager_ReadConnectivityMonitoringObj
             }
             break;
 
+        default:
+            sID = LWM2MCORE_ERR_INCORRECT_RANGE;
+            break;
+    }
+
+    return sID;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Snapshot of the single value resources of object 4, indexed by resource Id
+ */
+//--------------------------------------------------------------------------------------------------
+static struct
+{
+    bool            isValid;                                    ///< Snapshot is taken
+    bool            isSet[LWM2MCORE_CONN_MONITOR_SMCC_RID + 1]; ///< Resource is in the snapshot
+    lwm2mcore_Sid_t sid[LWM2MCORE_CONN_MONITOR_SMCC_RID + 1];   ///< Platform status
+    int64_t         value[LWM2MCORE_CONN_MONITOR_SMCC_RID + 1]; ///< Resource value
+}ConnMonitorSnapshot;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function to retrieve a single value resource of object 4 from the platform
+ *
+ * @return
+ *      - LWM2MCORE_ERR_COMPLETED_OK if the treatment succeeds
+ *      - LWM2MCORE_ERR_INCORRECT_RANGE if the resource is not a single value resource
+ *      - other platform error
+ */
+//--------------------------------------------------------------------------------------------------
+static lwm2mcore_Sid_t GetConnectivityMonitoringValue
+(
+    uint16_t rid,                       ///< [IN] Resource Id
+    int64_t* valuePtr                   ///< [OUT] Resource value
+)
+{
+    lwm2mcore_Sid_t sID;
+
+    switch (rid)
+    {
+        /* Resource 0: Network bearer */
+        case LWM2MCORE_CONN_MONITOR_NETWORK_BEARER_RID:
+        {
+            lwm2mcore_networkBearer_enum_t networkBearer;
+            sID = lwm2mcore_GetNetworkBearer(&networkBearer);
+            *valuePtr = networkBearer;
+        }
+        break;
+
+        /* Resource 2: Radio signal strength */
+        case LWM2MCORE_CONN_MONITOR_RADIO_SIGNAL_STRENGTH_RID:
+        {
+            int32_t signalStrength;
+            sID = lwm2mcore_GetSignalStrength(&signalStrength);
+            *valuePtr = signalStrength;
+        }
+        break;
+
+        /* Resource 3: Link quality */
+        case LWM2MCORE_CONN_MONITOR_LINK_QUALITY_RID:
+        {
+            int linkQuality;
+            sID = lwm2mcore_GetLinkQuality(&linkQuality);
+            *valuePtr = linkQuality;
+        }
+        break;
+
+        /* Resource 6: Link utilization */
+        case LWM2MCORE_CONN_MONITOR_LINK_UTILIZATION_RID:
+        {
+            uint8_t linkUtilization;
+            sID = lwm2mcore_GetLinkUtilization(&linkUtilization);
+            *valuePtr = linkUtilization;
+        }
+        break;
+
         /* Resource 8: Cell ID */
         case LWM2MCORE_CONN_MONITOR_CELL_ID_RID:
         {
             uint32_t cellId;
             sID = lwm2mcore_GetCellId(&cellId);
-            if (LWM2MCORE_ERR_COMPLETED_OK == sID)
-            {
-                *lenPtr = omanager_FormatValueToBytes((uint8_t*)bufferPtr,
-                                                      &cellId,
-                                                      sizeof(cellId),
-                                                      false);
-            }
+            *valuePtr = cellId;
         }
         break;
 
@@ -2277,13 +2292,7 @@ int omanager_ReadConnectivityMonitoringObj
         {
             uint16_t mnc;
             sID = lwm2mcore_GetMncMcc(&mnc, NULL);
-            if (LWM2MCORE_ERR_COMPLETED_OK == sID)
-            {
-                *lenPtr = omanager_FormatValueToBytes((uint8_t*)bufferPtr,
-                                                      &mnc,
-                                                      sizeof(mnc),
-                                                      false);
-            }
+            *valuePtr = mnc;
         }
         break;
 
@@ -2292,13 +2301,7 @@ int omanager_ReadConnectivityMonitoringObj
         {
             uint16_t mcc;
             sID = lwm2mcore_GetMncMcc(NULL, &mcc);
-            if (LWM2MCORE_ERR_COMPLETED_OK == sID)
-            {
-                *lenPtr = omanager_FormatValueToBytes((uint8_t*)bufferPtr,
-                                                      &mcc,
-                                                      sizeof(mcc),
-                                                      false);
-            }
+            *valuePtr = mcc;
         }
         break;
 
@@ -2310,6 +2313,134 @@ int omanager_ReadConnectivityMonitoringObj
     return sID;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function to read a single value resource of object 4
+ * Object: 4 - Connectivity monitoring
+ * Resource: 0, 2, 3, 6, 8, 9, 10
+ *
+ * @return
+ *      - LWM2MCORE_ERR_COMPLETED_OK if the treatment succeeds
+ *      - LWM2MCORE_ERR_GENERAL_ERROR if the treatment fails
+ *      - LWM2MCORE_ERR_INCORRECT_RANGE if the provided parameters (WRITE operation) is incorrect
+ *      - LWM2MCORE_ERR_NOT_YET_IMPLEMENTED if the resource is not yet implemented
+ *      - LWM2MCORE_ERR_OP_NOT_SUPPORTED  if the resource is not supported
+ *      - LWM2MCORE_ERR_INVALID_ARG if a parameter is invalid in resource handler
+ *      - LWM2MCORE_ERR_INVALID_STATE in case of invalid state to treat the resource handler
+ */
+//--------------------------------------------------------------------------------------------------
+int omanager_ReadConnectivityMonitoringValue
+(
+    lwm2mcore_Uri_t* uriPtr,            ///< [IN] uri represents the requested operation and
+                                        ///< object/resource
+    lwm2mcore_Value_t* valuePtr         ///< [INOUT] read value
+)
+{
+    lwm2mcore_Sid_t sID;
+    int64_t value = 0;
+
+    if ((!uriPtr) || (!valuePtr))
+    {
+        return LWM2MCORE_ERR_INVALID_ARG;
+    }
+
+    /* Check that the object instance Id is in the correct range (only one object instance) */
+    if (0 < uriPtr->oiid)
+    {
+        return LWM2MCORE_ERR_INCORRECT_RANGE;
+    }
+
+    /* Check that the operation is coherent */
+    if (0 == (uriPtr->op & LWM2MCORE_OP_READ))
+    {
+        return LWM2MCORE_ERR_OP_NOT_SUPPORTED;
+    }
+
+    if (   (ConnMonitorSnapshot.isValid)
+        && (LWM2MCORE_CONN_MONITOR_SMCC_RID >= uriPtr->rid)
+        && (ConnMonitorSnapshot.isSet[uriPtr->rid]))
+    {
+        /* Full object read: use the snapshot */
+        sID = ConnMonitorSnapshot.sid[uriPtr->rid];
+        value = ConnMonitorSnapshot.value[uriPtr->rid];
+    }
+    else
+    {
+        sID = GetConnectivityMonitoringValue(uriPtr->rid, &value);
+    }
+
+    if (LWM2MCORE_ERR_COMPLETED_OK == sID)
+    {
+        valuePtr->type = LWM2MCORE_VALUE_INT;
+        valuePtr->value.asInt = value;
+    }
+
+    return sID;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function to take or release a snapshot of the single value resources of object 4
+ * Object: 4 - Connectivity monitoring
+ *
+ * @return
+ *      - LWM2MCORE_ERR_COMPLETED_OK if the treatment succeeds
+ *      - LWM2MCORE_ERR_INCORRECT_RANGE if the object instance is not supported
+ *      - LWM2MCORE_ERR_INVALID_ARG if a parameter is invalid in resource handler
+ */
+//--------------------------------------------------------------------------------------------------
+int omanager_SnapshotConnectivityMonitoringObj
+(
+    lwm2mcore_Uri_t* uriPtr,            ///< [IN] uri represents the object instance
+    bool isStart                        ///< [IN] true to take the snapshot, false to release it
+)
+{
+    uint16_t rid;
+    uint16_t mnc;
+    uint16_t mcc;
+    lwm2mcore_Sid_t sID;
+
+    if (!uriPtr)
+    {
+        return LWM2MCORE_ERR_INVALID_ARG;
+    }
+
+    /* Check that the object instance Id is in the correct range (only one object instance) */
+    if (0 < uriPtr->oiid)
+    {
+        return LWM2MCORE_ERR_INCORRECT_RANGE;
+    }
+
+    memset(&ConnMonitorSnapshot, 0, sizeof(ConnMonitorSnapshot));
+    if (!isStart)
+    {
+        return LWM2MCORE_ERR_COMPLETED_OK;
+    }
+
+    for (rid = 0; rid < LWM2MCORE_CONN_MONITOR_SMNC_RID; rid++)
+    {
+        sID = GetConnectivityMonitoringValue(rid, &ConnMonitorSnapshot.value[rid]);
+        if (LWM2MCORE_ERR_INCORRECT_RANGE != sID)
+        {
+            /* Single value resource */
+            ConnMonitorSnapshot.sid[rid] = sID;
+            ConnMonitorSnapshot.isSet[rid] = true;
+        }
+    }
+
+    /* MNC and MCC are retrieved with a single platform request */
+    sID = lwm2mcore_GetMncMcc(&mnc, &mcc);
+    ConnMonitorSnapshot.sid[LWM2MCORE_CONN_MONITOR_SMNC_RID] = sID;
+    ConnMonitorSnapshot.value[LWM2MCORE_CONN_MONITOR_SMNC_RID] = mnc;
+    ConnMonitorSnapshot.isSet[LWM2MCORE_CONN_MONITOR_SMNC_RID] = true;
+    ConnMonitorSnapshot.sid[LWM2MCORE_CONN_MONITOR_SMCC_RID] = sID;
+    ConnMonitorSnapshot.value[LWM2MCORE_CONN_MONITOR_SMCC_RID] = mcc;
+    ConnMonitorSnapshot.isSet[LWM2MCORE_CONN_MONITOR_SMCC_RID] = true;
+
+    ConnMonitorSnapshot.isValid = true;
+    return LWM2MCORE_ERR_COMPLETED_OK;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  *                                  OBJECT 5: FIRMWARE UPDATE
@@ -5041,3 +5172,220 @@ int omanager_ExecSimApduConfigObj
 
     return sID;
 }
+
+#ifdef LWM2M_OBJECT_33409
+//--------------------------------------------------------------------------------------------------
+/**
+ *                              OBJECT 33409: Performance metrics
+ */
+//--------------------------------------------------------------------------------------------------
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the value of a resource instance of object 33409
+ *
+ * @return
+ *      - true if the resource instance exists
+ *      - false otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+static bool GetPerfMetricsValue
+(
+    uint16_t rid,                       ///< [IN] Resource Id
+    uint16_t riid,                      ///< [IN] Resource instance Id
+    uint64_t* valuePtr                  ///< [OUT] Value
+)
+{
+    lwm2mcore_Histogram_t histogram;
+
+    if (LWM2MCORE_PERF_METRICS_COUNTERS_RID == rid)
+    {
+        return (LWM2MCORE_ERR_COMPLETED_OK == lwm2mcore_GetCounter((lwm2mcore_Counter_t)riid,
+                                                                   valuePtr));
+    }
+
+    if (LWM2MCORE_PERF_METRICS_HISTOGRAM_RID == rid)
+    {
+        if (LWM2MCORE_ERR_COMPLETED_OK != lwm2mcore_GetHistogram(
+                                        (lwm2mcore_Metric_t)(riid / LWM2MCORE_METRIC_BUCKETS),
+                                        &histogram))
+        {
+            return false;
+        }
+        *valuePtr = histogram.buckets[riid % LWM2MCORE_METRIC_BUCKETS];
+        return true;
+    }
+
+    if (LWM2MCORE_ERR_COMPLETED_OK != lwm2mcore_GetHistogram((lwm2mcore_Metric_t)riid,
+                                                             &histogram))
+    {
+        return false;
+    }
+
+    switch (rid)
+    {
+        case LWM2MCORE_PERF_METRICS_COUNT_RID:
+            *valuePtr = histogram.count;
+            return true;
+
+        case LWM2MCORE_PERF_METRICS_ERROR_COUNT_RID:
+            *valuePtr = histogram.errorCount;
+            return true;
+
+        case LWM2MCORE_PERF_METRICS_TOTAL_TIME_RID:
+            *valuePtr = histogram.totalMs;
+            return true;
+
+        case LWM2MCORE_PERF_METRICS_MAX_TIME_RID:
+            *valuePtr = histogram.maxMs;
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function to read a resource of object 33409
+ * Object: Performance metrics
+ * Resource: All
+ *
+ * @return
+ *      - LWM2MCORE_ERR_COMPLETED_OK if the read succeeds
+ *      - LWM2MCORE_ERR_INCORRECT_RANGE if the provided parameters are not in correct range
+ *      - LWM2MCORE_ERR_INVALID_ARG if a parameter is invalid
+ *      - LWM2MCORE_ERR_OP_NOT_SUPPORTED  if the operation is not supported
+ *      - LWM2MCORE_ERR_OVERFLOW if the buffer is too small
+ */
+//--------------------------------------------------------------------------------------------------
+int omanager_ReadPerfMetricsObj
+(
+    lwm2mcore_Uri_t* uriPtr,            ///< [IN] uri represents the requested operation and
+                                        ///< object/resource
+    char* bufferPtr,                    ///< [INOUT] data buffer for information
+    size_t* lenPtr,                     ///< [INOUT] length of input buffer and length of the
+                                        ///< returned data
+    valueChangedCallback_t changedCb    ///< [IN] callback for notification
+)
+{
+    uint64_t value;
+
+    (void)changedCb;
+
+    if (!uriPtr || !bufferPtr || !lenPtr || (*lenPtr == 0))
+    {
+        return LWM2MCORE_ERR_INVALID_ARG;
+    }
+
+    /* Check that the object instance Id is in the correct range (only one object instance) */
+    if (0 < uriPtr->oiid)
+    {
+        return LWM2MCORE_ERR_INCORRECT_RANGE;
+    }
+
+    /* Check that the operation is coherent */
+    if (0 == (uriPtr->op & LWM2MCORE_OP_READ))
+    {
+        return LWM2MCORE_ERR_OP_NOT_SUPPORTED;
+    }
+
+    /* Resource 0: operation names */
+    if (LWM2MCORE_PERF_METRICS_NAME_RID == uriPtr->rid)
+    {
+        const char* namePtr = lwm2mcore_GetMetricName((lwm2mcore_Metric_t)uriPtr->riid);
+        size_t nameLen;
+
+        if (!namePtr)
+        {
+            /* No more resource instance */
+            *lenPtr = 0;
+            return LWM2MCORE_ERR_COMPLETED_OK;
+        }
+
+        nameLen = strlen(namePtr);
+        if (nameLen > *lenPtr)
+        {
+            return LWM2MCORE_ERR_OVERFLOW;
+        }
+        memcpy(bufferPtr, namePtr, nameLen);
+        *lenPtr = nameLen;
+        return LWM2MCORE_ERR_COMPLETED_OK;
+    }
+
+    /* Resources 1 to 6: values */
+    if ((LWM2MCORE_PERF_METRICS_COUNT_RID > uriPtr->rid)
+     || (LWM2MCORE_PERF_METRICS_COUNTERS_RID < uriPtr->rid))
+    {
+        LOG_ARG("Invalid resource ID %d for reading", uriPtr->rid);
+        return LWM2MCORE_ERR_INCORRECT_RANGE;
+    }
+
+    if (!GetPerfMetricsValue(uriPtr->rid, uriPtr->riid, &value))
+    {
+        /* No more resource instance */
+        *lenPtr = 0;
+        return LWM2MCORE_ERR_COMPLETED_OK;
+    }
+
+    if (sizeof(value) + 1 > *lenPtr)
+    {
+        return LWM2MCORE_ERR_OVERFLOW;
+    }
+    *lenPtr = omanager_FormatValueToBytes((uint8_t*)bufferPtr, &value, sizeof(value), false);
+    return LWM2MCORE_ERR_COMPLETED_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function to execute a resource of object 33409
+ * Object: Performance metrics
+ * Resource: All
+ *
+ * @return
+ *      - LWM2MCORE_ERR_COMPLETED_OK if the treatment succeeds
+ *      - LWM2MCORE_ERR_INVALID_ARG if a parameter is invalid
+ *      - LWM2MCORE_ERR_INCORRECT_RANGE if the provided parameters are not in correct range
+ *      - LWM2MCORE_ERR_OP_NOT_SUPPORTED  if the resource is not supported
+ */
+//--------------------------------------------------------------------------------------------------
+int omanager_ExecPerfMetricsObj
+(
+    lwm2mcore_Uri_t* uriPtr,            ///< [IN] uri represents the requested operation and
+                                        ///< object/resource
+    char* bufferPtr,                    ///< [INOUT] data buffer for information
+    size_t len                          ///< [IN] length of input buffer
+)
+{
+    (void)bufferPtr;
+    (void)len;
+
+    if (!uriPtr)
+    {
+        return LWM2MCORE_ERR_INVALID_ARG;
+    }
+
+    /* Check that the object instance Id is in the correct range (only one object instance) */
+    if (0 < uriPtr->oiid)
+    {
+        return LWM2MCORE_ERR_INCORRECT_RANGE;
+    }
+
+    /* Check that the operation is coherent */
+    if (0 == (uriPtr->op & LWM2MCORE_OP_EXECUTE))
+    {
+        return LWM2MCORE_ERR_OP_NOT_SUPPORTED;
+    }
+
+    switch (uriPtr->rid)
+    {
+        /* Resource 7: reset the metrics */
+        case LWM2MCORE_PERF_METRICS_RESET_RID:
+            lwm2mcore_ResetMetrics();
+            return LWM2MCORE_ERR_COMPLETED_OK;
+
+        default:
+            LOG_ARG("Invalid resource ID %d for executing", uriPtr->rid);
+            return LWM2MCORE_ERR_INCORRECT_RANGE;
+    }
+}
+#endif
@@ -442,10 +442,10 @@ int omanager_ExecDeviceObj
 
 //--------------------------------------------------------------------------------------------------
 /**
- * @brief Function to read a resource of object 4
+ * @brief Function to read a multiple instance resource of object 4
  *
  * Object: 4 - Connectivity monitoring
- * Resource: All
+ * Resource: 1, 4, 5, 7
  *
  * @return
  *  - @ref LWM2MCORE_ERR_COMPLETED_OK if the treatment succeeds
@@ -469,6 +469,48 @@ int omanager_ReadConnectivityMonitoringObj
     valueChangedCallback_t changedCb    ///< [IN] callback for notification
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Function to read a single value resource of object 4
+ *
+ * Object: 4 - Connectivity monitoring
+ * Resource: 0, 2, 3, 6, 8, 9, 10
+ *
+ * @return
+ *  - @ref LWM2MCORE_ERR_COMPLETED_OK if the treatment succeeds
+ *  - @ref LWM2MCORE_ERR_GENERAL_ERROR if the treatment fails
+ *  - @ref LWM2MCORE_ERR_INCORRECT_RANGE if the provided parameters (WRITE operation) is incorrect
+ *  - @ref LWM2MCORE_ERR_NOT_YET_IMPLEMENTED if the resource is not yet implemented
+ *  - @ref LWM2MCORE_ERR_OP_NOT_SUPPORTED  if the resource is not supported
+ *  - @ref LWM2MCORE_ERR_INVALID_ARG if a parameter is invalid in resource handler
+ *  - @ref LWM2MCORE_ERR_INVALID_STATE in case of invalid state to treat the resource handler
+ */
+//--------------------------------------------------------------------------------------------------
+int omanager_ReadConnectivityMonitoringValue
+(
+    lwm2mcore_Uri_t* uriPtr,            ///< [IN] uri represents the requested operation and
+                                        ///< object/resource
+    lwm2mcore_Value_t* valuePtr         ///< [INOUT] read value
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Function to take or release a snapshot of the single value resources of object 4
+ *
+ * Object: 4 - Connectivity monitoring
+ *
+ * @return
+ *  - @ref LWM2MCORE_ERR_COMPLETED_OK if the treatment succeeds
+ *  - @ref LWM2MCORE_ERR_INCORRECT_RANGE if the object instance is not supported
+ *  - @ref LWM2MCORE_ERR_INVALID_ARG if a parameter is invalid in resource handler
+ */
+//--------------------------------------------------------------------------------------------------
+int omanager_SnapshotConnectivityMonitoringObj
+(
+    lwm2mcore_Uri_t* uriPtr,            ///< [IN] uri represents the object instance
+    bool isStart                        ///< [IN] true to take the snapshot, false to release it
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  *                                  OBJECT 5: FIRMWARE UPDATE
@@ -1166,6 +1208,59 @@ int omanager_ExecSimApduConfigObj
     size_t len                          ///< [IN] length of input buffer
 );
 
+#ifdef LWM2M_OBJECT_33409
+//--------------------------------------------------------------------------------------------------
+/**
+ *                              OBJECT 33409: Performance metrics
+ */
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function to read a resource of object 33409
+ * Object: Performance metrics
+ * Resource: All
+ *
+ * @return
+ *      - LWM2MCORE_ERR_COMPLETED_OK if the read succeeds
+ *      - LWM2MCORE_ERR_INCORRECT_RANGE if the provided parameters are not in correct range
+ *      - LWM2MCORE_ERR_INVALID_ARG if a parameter is invalid
+ *      - LWM2MCORE_ERR_OP_NOT_SUPPORTED  if the operation is not supported
+ *      - LWM2MCORE_ERR_OVERFLOW if the buffer is too small
+ */
+//--------------------------------------------------------------------------------------------------
+int omanager_ReadPerfMetricsObj
+(
+    lwm2mcore_Uri_t* uriPtr,            ///< [IN] uri represents the requested operation and
+                                        ///<      object/resource
+    char* bufferPtr,                    ///< [INOUT] data buffer for information
+    size_t* lenPtr,                     ///< [INOUT] length of input buffer and length of the
+                                        ///< returned data
+    valueChangedCallback_t changedCb    ///< [IN] callback for notification
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function to execute a resource of object 33409
+ * Object: Performance metrics
+ * Resource: All
+ *
+ * @return
+ *      - LWM2MCORE_ERR_COMPLETED_OK if the treatment succeeds
+ *      - LWM2MCORE_ERR_INVALID_ARG if a parameter is invalid
+ *      - LWM2MCORE_ERR_INCORRECT_RANGE if the provided parameters are not in correct range
+ *      - LWM2MCORE_ERR_OP_NOT_SUPPORTED  if the resource is not supported
+ */
+//--------------------------------------------------------------------------------------------------
+int omanager_ExecPerfMetricsObj
+(
+    lwm2mcore_Uri_t* uriPtr,            ///< [IN] uri represents the requested operation and
+                                        ///<      object/resource
+    char* bufferPtr,                    ///< [INOUT] data buffer for information
+    size_t len                          ///< [IN] length of input buffer
+);
+#endif
+
 //--------------------------------------------------------------------------------------------------
 /**
  *                              Not registered objects
@@ -21,6 +21,9 @@
 #include "internalCoapHandler.h"
 #include "sessionManager.h"
 
+#define LOG_MODULE_LEVEL LWM2MCORE_LOG_OBJECTS
+#include "coreLog.h"
+
 //--------------------------------------------------------------------------------------------------
 /*
  * Only one external event handler is allowed to be registered at a time.
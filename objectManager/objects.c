@@ -12,6 +12,7 @@
 #include <lwm2mcore/update.h>
 #include <lwm2mcore/security.h>
 #include <lwm2mcore/paramStorage.h>
+#include <lwm2mcore/timer.h>
 #include "liblwm2m.h"
 #include "objects.h"
 #include "sessionManager.h"
@@ -25,16 +26,8 @@
 #include <lwm2mcore/fileTransfer.h>
 #endif
 
-//--------------------------------------------------------------------------------------------------
-/**
- * Maximum number of objects which can be registered in Wakaama
- */
-//--------------------------------------------------------------------------------------------------
-#ifdef LWM2M_OBJECT_33406
-#define OBJ_COUNT 17
-#else
-#define OBJ_COUNT 15
-#endif
+#define LOG_MODULE_LEVEL LWM2MCORE_LOG_OBJECTS
+#include "coreLog.h"
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -53,22 +46,21 @@
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Objects number which are registered in Wakaama
+ * Size of the arena used for temporary allocations while a CoAP request is treated
  */
 //--------------------------------------------------------------------------------------------------
-uint16_t RegisteredObjNb = 0;
+#define REQUEST_ARENA_SIZE 2048
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Object array to be registered in Wakamaa including the generic handlers to access to these
- * objects
+ * Alignment of the allocations in the request arena
  */
 //--------------------------------------------------------------------------------------------------
-static lwm2m_object_t* ObjectArray[OBJ_COUNT];
+#define REQUEST_ARENA_ALIGN sizeof(uint64_t)
 
 //--------------------------------------------------------------------------------------------------
 /**
- * LWM2M core context
+ * LWM2M core context of the active client instance (see smanager_SelectInstance)
  */
 //--------------------------------------------------------------------------------------------------
 extern lwm2mcore_context_t* Lwm2mcoreCtxPtr;
@@ -125,12 +117,84 @@ static ObjectInstanceList_t* SwApplicationListPtr;
 static ObjectInstanceList_t* FileTransferListPtr;
 #endif
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Arena for the temporary allocations done while a CoAP request or a notification is treated.
+ * Allocations are bumped from a static buffer and released all together by
+ * omanager_ReleaseRequestMemory() before the next request or notification is treated.
+ *
+ * Only the data which never leave lwm2mcore are allocated in the arena: the instances of a resource
+ * read before being copied to Wakaama, and the resources of a full object WRITE. The data handed to
+ * Wakaama stay on the heap as Wakaama frees them.
+ */
+//--------------------------------------------------------------------------------------------------
+static struct
+{
+    uint64_t buffer[REQUEST_ARENA_SIZE / sizeof(uint64_t)];    ///< Arena memory
+    size_t   used;                                              ///< Used bytes
+}RequestArena;
+
 //--------------------------------------------------------------------------------------------------
 /**
  *                      PRIVATE FUNCTIONS
  */
 //--------------------------------------------------------------------------------------------------
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allocate zeroed memory for the CoAP request being treated.
+ * The request arena is used when possible, the heap otherwise.
+ *
+ * @return
+ *      - pointer on allocated memory
+ *      - NULL on failure
+ */
+//--------------------------------------------------------------------------------------------------
+static void* RequestAlloc
+(
+    size_t size     ///< [IN] Size to allocate
+)
+{
+    void* memPtr;
+    size_t alignedSize = (size + REQUEST_ARENA_ALIGN - 1) & ~(REQUEST_ARENA_ALIGN - 1);
+
+    if ((!alignedSize) || (alignedSize > (sizeof(RequestArena.buffer) - RequestArena.used)))
+    {
+        memPtr = lwm2m_malloc(size);
+        if (memPtr)
+        {
+            memset(memPtr, 0, size);
+        }
+        return memPtr;
+    }
+
+    memPtr = (uint8_t*)RequestArena.buffer + RequestArena.used;
+    RequestArena.used += alignedSize;
+    memset(memPtr, 0, size);
+    return memPtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Free memory allocated by RequestAlloc.
+ * Only heap allocations are actually freed, arena allocations are released by
+ * omanager_ReleaseRequestMemory().
+ */
+//--------------------------------------------------------------------------------------------------
+static void RequestFree
+(
+    void* memPtr    ///< [IN] Memory to free
+)
+{
+    if (   ((uint8_t*)memPtr >= (uint8_t*)RequestArena.buffer)
+        && ((uint8_t*)memPtr < ((uint8_t*)RequestArena.buffer + sizeof(RequestArena.buffer))))
+    {
+        return;
+    }
+
+    lwm2m_free(memPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Function to translate a resource handler status to a CoAP error
@@ -199,6 +263,273 @@ static uint8_t SetCoapError
     return result;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compare the object Id of two entries of the object lookup index (bsearch callback)
+ *
+ * @return
+ *      - negative value, 0 or positive value as required by bsearch
+ */
+//--------------------------------------------------------------------------------------------------
+static int CompareObjectIndexId
+(
+    const void* aPtr,                       ///< [IN] First entry
+    const void* bPtr                        ///< [IN] Second entry
+)
+{
+    const lwm2mcore_objectIndex_t* aEntryPtr = (const lwm2mcore_objectIndex_t*)aPtr;
+    const lwm2mcore_objectIndex_t* bEntryPtr = (const lwm2mcore_objectIndex_t*)bPtr;
+
+    if (aEntryPtr->oid != bEntryPtr->oid)
+    {
+        return (aEntryPtr->oid < bEntryPtr->oid) ? -1 : 1;
+    }
+    return 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compare two entries of the object lookup index, keeping the object list order for identical
+ * object Ids (qsort callback)
+ *
+ * @return
+ *      - negative value, 0 or positive value as required by qsort
+ */
+//--------------------------------------------------------------------------------------------------
+static int CompareObjectIndex
+(
+    const void* aPtr,                       ///< [IN] First entry
+    const void* bPtr                        ///< [IN] Second entry
+)
+{
+    const lwm2mcore_objectIndex_t* aEntryPtr = (const lwm2mcore_objectIndex_t*)aPtr;
+    const lwm2mcore_objectIndex_t* bEntryPtr = (const lwm2mcore_objectIndex_t*)bPtr;
+    int result = CompareObjectIndexId(aPtr, bPtr);
+
+    if (result)
+    {
+        return result;
+    }
+    if (aEntryPtr->order != bEntryPtr->order)
+    {
+        return (aEntryPtr->order < bEntryPtr->order) ? -1 : 1;
+    }
+    return 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compare the key of two entries of the resource lookup index (bsearch callback)
+ *
+ * @return
+ *      - negative value, 0 or positive value as required by bsearch
+ */
+//--------------------------------------------------------------------------------------------------
+static int CompareResourceIndexKey
+(
+    const void* aPtr,                       ///< [IN] First entry
+    const void* bPtr                        ///< [IN] Second entry
+)
+{
+    const lwm2mcore_resourceIndex_t* aEntryPtr = (const lwm2mcore_resourceIndex_t*)aPtr;
+    const lwm2mcore_resourceIndex_t* bEntryPtr = (const lwm2mcore_resourceIndex_t*)bPtr;
+
+    if (aEntryPtr->key != bEntryPtr->key)
+    {
+        return (aEntryPtr->key < bEntryPtr->key) ? -1 : 1;
+    }
+    return 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compare two entries of the resource lookup index, keeping the resource list order for identical
+ * keys (qsort callback)
+ *
+ * @return
+ *      - negative value, 0 or positive value as required by qsort
+ */
+//--------------------------------------------------------------------------------------------------
+static int CompareResourceIndex
+(
+    const void* aPtr,                       ///< [IN] First entry
+    const void* bPtr                        ///< [IN] Second entry
+)
+{
+    const lwm2mcore_resourceIndex_t* aEntryPtr = (const lwm2mcore_resourceIndex_t*)aPtr;
+    const lwm2mcore_resourceIndex_t* bEntryPtr = (const lwm2mcore_resourceIndex_t*)bPtr;
+    int result = CompareResourceIndexKey(aPtr, bPtr);
+
+    if (result)
+    {
+        return result;
+    }
+    if (aEntryPtr->order != bEntryPtr->order)
+    {
+        return (aEntryPtr->order < bEntryPtr->order) ? -1 : 1;
+    }
+    return 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Free the object and resource lookup index
+ */
+//--------------------------------------------------------------------------------------------------
+static void FreeObjectsIndex
+(
+    lwm2mcore_context_t* ctxPtr             ///< [IN] LWM2M core context
+)
+{
+    if (NULL == ctxPtr)
+    {
+        return;
+    }
+
+    if (ctxPtr->objects_index.objectsPtr)
+    {
+        lwm2m_free(ctxPtr->objects_index.objectsPtr);
+    }
+    if (ctxPtr->objects_index.resourcesPtr)
+    {
+        lwm2m_free(ctxPtr->objects_index.resourcesPtr);
+    }
+    memset(&(ctxPtr->objects_index), 0, sizeof(lwm2mcore_objectsIndex_t));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Build the object and resource lookup index from the object list.
+ *
+ * Both tables are sorted arrays searched with bsearch(). When several objects share the same object
+ * Id (one entry per object instance), only the first one of the list is indexed, which is the one
+ * the linked list walk used to return.
+ *
+ * @return
+ *      - true on success
+ *      - false on memory allocation failure (the index is then left empty)
+ */
+//--------------------------------------------------------------------------------------------------
+static bool BuildObjectsIndex
+(
+    lwm2mcore_context_t* ctxPtr             ///< [IN] LWM2M core context
+)
+{
+    lwm2mcore_internalObject_t* objPtr;
+    lwm2mcore_internalResource_t* resourcePtr;
+    lwm2mcore_objectIndex_t* objectsPtr;
+    lwm2mcore_resourceIndex_t* resourcesPtr;
+    uint32_t objectCount = 0;
+    uint32_t resourceCount = 0;
+    uint32_t i;
+    uint32_t j;
+
+    if (NULL == ctxPtr)
+    {
+        return false;
+    }
+
+    FreeObjectsIndex(ctxPtr);
+
+    for (objPtr = DLIST_FIRST(&(ctxPtr->objects_list)); objPtr; objPtr = DLIST_NEXT(objPtr, list))
+    {
+        objectCount++;
+    }
+
+    if (!objectCount)
+    {
+        return true;
+    }
+
+    objectsPtr = (lwm2mcore_objectIndex_t*)lwm2m_malloc(objectCount
+                                                        * sizeof(lwm2mcore_objectIndex_t));
+    if (NULL == objectsPtr)
+    {
+        LOG("Unable to allocate the object index");
+        return false;
+    }
+
+    i = 0;
+    for (objPtr = DLIST_FIRST(&(ctxPtr->objects_list)); objPtr; objPtr = DLIST_NEXT(objPtr, list))
+    {
+        objectsPtr[i].oid = objPtr->id;
+        objectsPtr[i].order = i;
+        objectsPtr[i].objPtr = objPtr;
+        i++;
+    }
+    qsort(objectsPtr, objectCount, sizeof(lwm2mcore_objectIndex_t), CompareObjectIndex);
+
+    /* Only keep the first object of the list for each object Id */
+    j = 0;
+    for (i = 0; i < objectCount; i++)
+    {
+        if ((0 == j) || (objectsPtr[j - 1].oid != objectsPtr[i].oid))
+        {
+            objectsPtr[j++] = objectsPtr[i];
+        }
+    }
+    objectCount = j;
+
+    for (i = 0; i < objectCount; i++)
+    {
+        for (resourcePtr = DLIST_FIRST(&(objectsPtr[i].objPtr->resource_list));
+             resourcePtr;
+             resourcePtr = DLIST_NEXT(resourcePtr, list))
+        {
+            resourceCount++;
+        }
+    }
+
+    resourcesPtr = NULL;
+    if (resourceCount)
+    {
+        resourcesPtr = (lwm2mcore_resourceIndex_t*)lwm2m_malloc(resourceCount
+                                                            * sizeof(lwm2mcore_resourceIndex_t));
+        if (NULL == resourcesPtr)
+        {
+            LOG("Unable to allocate the resource index");
+            lwm2m_free(objectsPtr);
+            return false;
+        }
+
+        j = 0;
+        for (i = 0; i < objectCount; i++)
+        {
+            for (resourcePtr = DLIST_FIRST(&(objectsPtr[i].objPtr->resource_list));
+                 resourcePtr;
+                 resourcePtr = DLIST_NEXT(resourcePtr, list))
+            {
+                resourcesPtr[j].key = ((uint32_t)objectsPtr[i].oid << 16) | resourcePtr->id;
+                resourcesPtr[j].order = j;
+                resourcesPtr[j].objPtr = objectsPtr[i].objPtr;
+                resourcesPtr[j].resourcePtr = resourcePtr;
+                j++;
+            }
+        }
+        qsort(resourcesPtr, resourceCount, sizeof(lwm2mcore_resourceIndex_t),
+              CompareResourceIndex);
+
+        /* Only keep the first resource of the list for each resource Id */
+        j = 0;
+        for (i = 0; i < resourceCount; i++)
+        {
+            if ((0 == j) || (resourcesPtr[j - 1].key != resourcesPtr[i].key))
+            {
+                resourcesPtr[j++] = resourcesPtr[i];
+            }
+        }
+        resourceCount = j;
+    }
+
+    ctxPtr->objects_index.objectsPtr = objectsPtr;
+    ctxPtr->objects_index.objectCount = (uint16_t)objectCount;
+    ctxPtr->objects_index.resourcesPtr = resourcesPtr;
+    ctxPtr->objects_index.resourceCount = resourceCount;
+
+    LOG_ARG("Objects index: %d objects, %d resources", objectCount, resourceCount);
+    return true;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Function which returns a registered object
@@ -215,12 +546,26 @@ static lwm2mcore_internalObject_t* FindObject
 )
 {
     lwm2mcore_internalObject_t* objPtr = NULL;
+    lwm2mcore_objectIndex_t* entryPtr;
+    lwm2mcore_objectIndex_t key;
 
     if (NULL == ctxPtr)
     {
         return NULL;
     }
 
+    if (NULL != ctxPtr->objects_index.objectsPtr)
+    {
+        /* Index entries are unique per object Id: the order field is not relevant for the search */
+        key.oid = oid;
+        entryPtr = (lwm2mcore_objectIndex_t*)bsearch(&key,
+                                                      ctxPtr->objects_index.objectsPtr,
+                                                      ctxPtr->objects_index.objectCount,
+                                                      sizeof(lwm2mcore_objectIndex_t),
+                                                      CompareObjectIndexId);
+        return (entryPtr ? entryPtr->objPtr : NULL);
+    }
+
     for (objPtr = DLIST_FIRST(&(ctxPtr->objects_list)); objPtr; objPtr = DLIST_NEXT(objPtr, list))
     {
         if (objPtr->id == oid)
@@ -243,14 +588,37 @@ static lwm2mcore_internalObject_t* FindObject
 //--------------------------------------------------------------------------------------------------
 static lwm2mcore_internalResource_t* FindResource
 (
+    lwm2mcore_context_t* ctxPtr,            ///< [IN] LWM2M core context
     lwm2mcore_internalObject_t* objPtr,     ///< [IN] Object pointer
     uint16_t rid                            ///< [IN] resource ID
 )
 {
     lwm2mcore_internalResource_t* resourcePtr = NULL;
+    lwm2mcore_resourceIndex_t* entryPtr;
+    lwm2mcore_resourceIndex_t key;
 
     LWM2MCORE_ASSERT(objPtr);
 
+    if ((NULL != ctxPtr) && (NULL != ctxPtr->objects_index.resourcesPtr))
+    {
+        key.key = ((uint32_t)objPtr->id << 16) | rid;
+        entryPtr = (lwm2mcore_resourceIndex_t*)bsearch(&key,
+                                                        ctxPtr->objects_index.resourcesPtr,
+                                                        ctxPtr->objects_index.resourceCount,
+                                                        sizeof(lwm2mcore_resourceIndex_t),
+                                                        CompareResourceIndexKey);
+        if (NULL == entryPtr)
+        {
+            return NULL;
+        }
+
+        /* The index only references the first object of each object Id */
+        if (entryPtr->objPtr == objPtr)
+        {
+            return entryPtr->resourcePtr;
+        }
+    }
+
     for (resourcePtr = DLIST_FIRST(&(objPtr->resource_list));
          resourcePtr;
          resourcePtr = DLIST_NEXT(resourcePtr, list))
@@ -321,114 +689,55 @@ static uint8_t EncodeData
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Read resources with multiple instances in an object
+ * Encode a typed value as a LWM2M data
  *
  * @return
- *      - COAP_205_CONTENT if the request is well treated
- *      - COAP_404_NOT_FOUND if no instance is present
+ *      - COAP_205_CONTENT if the value is correctly encoded
  *      - COAP_500_INTERNAL_SERVER_ERROR in case of error
- *      - COAP_501_NOT_IMPLEMENTED if the read callback is not implemented
  */
 //--------------------------------------------------------------------------------------------------
-static uint8_t ReadResourceInstances
+static uint8_t EncodeValue
 (
-    lwm2mcore_Uri_t* uriPtr,                    ///< [IN] Requested operation and object/resource
-    lwm2mcore_internalResource_t* resourcePtr,  ///< [IN] LWM2M resource
-    lwm2m_data_t* dataPtr,                      ///< [INOUT] Encoded LWM2M data
-    char* bufPtr,                               ///< [IN] Read buffer
-    size_t bufSize                              ///< [IN] Read Buffer size
+    lwm2mcore_ResourceType_t type,      ///< [IN] LWM2M resource type
+    const lwm2mcore_Value_t* valuePtr,  ///< [IN] Value to encode
+    lwm2m_data_t* dataPtr               ///< [INOUT] Encoded LWM2M data
 )
 {
-    int sid = 0;
-    uint16_t i = 0;
-    uint16_t instanceNumber;
-    uint8_t result = COAP_404_NOT_FOUND;
-    lwm2m_data_t* instancesPtr;
+    uint8_t result = COAP_205_CONTENT;
 
-    /* Check for object 2 (ACL
-     * For this object, the resource instance Id are not incremented but correspond
-     * to a server Id.
-     * This means that, for example, 2 resource instances can exist with
-     * 1st resource instance Id = 1 (server Id = 1)
-     * 2nd resource instance Id = 123 (server Id = 123)
-     * So the number of resource instances can not be linked to riid in this case
-     */
-    if (LWM2MCORE_ACL_OID == uriPtr->oid)
-    {
-        instanceNumber = omanager_GetAclInstanceNumber(uriPtr->oiid);
-    }
-    else
+    switch (valuePtr->type)
     {
-        instanceNumber = resourcePtr->maxInstCount;
-    }
+        case LWM2MCORE_VALUE_INT:
+            lwm2m_data_encode_int(valuePtr->value.asInt, dataPtr);
+            break;
 
-    instancesPtr = lwm2m_data_new(instanceNumber);
-    if (!instancesPtr)
-    {
-        return COAP_500_INTERNAL_SERVER_ERROR;
-    }
+        case LWM2MCORE_VALUE_FLOAT:
+            lwm2m_data_encode_float(valuePtr->value.asFloat, dataPtr);
+            break;
 
-    do
-    {
-        size_t readSize = bufSize;
+        case LWM2MCORE_VALUE_BOOL:
+            lwm2m_data_encode_bool(valuePtr->value.asBool, dataPtr);
+            break;
 
-        memset(bufPtr, 0, bufSize);
-        uriPtr->riid = i;
+        case LWM2MCORE_VALUE_BUFFER:
+            if (LWM2MCORE_RESOURCE_TYPE_STRING == type)
+            {
+                lwm2m_data_encode_nstring(valuePtr->value.asBuffer.bufferPtr,
+                                          valuePtr->value.asBuffer.len,
+                                          dataPtr);
+            }
+            else
+            {
+                lwm2m_data_encode_opaque((uint8_t*)valuePtr->value.asBuffer.bufferPtr,
+                                         valuePtr->value.asBuffer.len,
+                                         dataPtr);
+            }
+            break;
 
-        /* Read the instance of the resource */
-        sid  = resourcePtr->read(uriPtr, bufPtr, &readSize, NULL);
-        LOG_ARG("Result of reading instance %d: %d", uriPtr->oiid, sid);
-
-        /* Define the CoAP result */
-        result = SetCoapError(sid, LWM2MCORE_OP_READ);
-
-        if (COAP_205_CONTENT == result)
-        {
-            /* Check if some data was returned */
-            if (readSize)
-            {
-                /* Set resource id and encode as LWM2M data */
-                (instancesPtr + i)->id = uriPtr->riid;
-                result = EncodeData(resourcePtr->type,
-                                    bufPtr,
-                                    readSize,
-                                    instancesPtr + i);
-            }
-            else
-            {
-                if (0 == uriPtr->riid)
-                {
-                    /* No instance, return an error */
-                    result = COAP_404_NOT_FOUND;
-                }
-                else
-                {
-                    /* No more instance, stop processing without throwing an error */
-                    i = resourcePtr->maxInstCount;
-                }
-            }
-        }
-        i++;
-    }
-    while ((i < instanceNumber) && (COAP_205_CONTENT == result));
-
-    if (COAP_205_CONTENT == result)
-    {
-        /* No error, encode the resources in a single LWM2M data */
-        if (LWM2MCORE_ACL_OID == uriPtr->oid)
-        {
-            lwm2m_data_encode_instances(instancesPtr, instanceNumber, dataPtr);
-        }
-        else
-        {
-            lwm2m_data_encode_instances(instancesPtr, uriPtr->riid, dataPtr);
-        }
-        result = COAP_205_CONTENT;
-    }
-    else
-    {
-        /* Error, free allocated memory */
-        lwm2m_free(instancesPtr);
+        case LWM2MCORE_VALUE_NONE:
+        default:
+            result = COAP_500_INTERNAL_SERVER_ERROR;
+            break;
     }
 
     return result;
@@ -436,1258 +745,2682 @@ static uint8_t ReadResourceInstances
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Validate the operational state to see if it's allowed to proceed with the given object instance.
- * So far all objects are allowed to proceed, except object 33405 when it's in the process of and
- * not done with a system time update. Then this function will return false to advise the caller
- * to not proceed.
+ * Number of bytes of a read buffer which may have been written by a READ handler: the returned data
+ * and its terminating null character. Only these bytes are cleared before the next READ handler.
  *
  * @return
- *      - true if it's good to proceed; false otherwise.
+ *      - Number of bytes to clear
  */
 //--------------------------------------------------------------------------------------------------
-static bool ValidStateForOperation
+static size_t ReadBufferUsed
 (
-    lwm2mcore_Uri_t* uri
+    size_t len,             ///< [IN] Length returned by the READ handler
+    size_t bufSize          ///< [IN] Read buffer size
 )
 {
-    if (!uri)
-    {
-        return false;
-    }
-
-    if (LWM2MCORE_CLOCK_TIME_CONFIG_OID != uri->oid)
-    {
-        return true;
-    }
-
-    // Check if the current state of Clock Service allows this operation
-    if (lwm2mcore_UpdateSystemClockInProgress())
-    {
-        LOG("Operation disallowed when system clock time update is in progress");
-        return false;
-    }
-    return true;
+    return (len < bufSize) ? (len + 1) : bufSize;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Generic function when a READ command is treated for a specific object (Wakaama)
+ * Read a resource through its typed READ handler and encode the value as a LWM2M data
  *
  * @return
- *      - COAP_404_NOT_FOUND if the object instance or read callback is not registered
- *      - COAP_500_INTERNAL_SERVER_ERROR in case of error
- *      - COAP_205_CONTENT if the request is well treated
+ *      - COAP_205_CONTENT if the value is read and encoded
+ *      - COAP_404_NOT_FOUND if the handler did not return any value
+ *      - other CoAP error code returned by the handler
  */
 //--------------------------------------------------------------------------------------------------
-static uint8_t ReadCb
+static uint8_t ReadValue
 (
-    uint16_t instanceId,            ///< [IN] Object ID
-    int* numDataPtr,                ///< [IN] Number of resources to be read
-    lwm2m_data_t** dataArrayPtr,    ///< [IN] Array of requested resources to be read
-    lwm2m_object_t* objectPtr       ///< [IN] Pointer on object
+    lwm2mcore_Uri_t* uriPtr,                    ///< [IN] Requested operation and object/resource
+    lwm2mcore_internalResource_t* resourcePtr,  ///< [IN] LWM2M resource
+    char* bufPtr,                               ///< [IN] Scratch buffer for string/opaque values
+    size_t bufSize,                             ///< [IN] Scratch buffer size
+    lwm2m_data_t* dataPtr,                      ///< [INOUT] Encoded LWM2M data
+    bool* isEmptyPtr,                           ///< [OUT] Set if no value was returned
+    lwm2mcore_Value_t* valuePtr                 ///< [OUT] Read value (optional)
 )
 {
+    int sid;
     uint8_t result;
-    int i = 0;
-    int sid = 0;
-    lwm2mcore_Uri_t uri;
-    lwm2mcore_internalObject_t* objPtr;
-    lwm2mcore_internalResource_t* resourcePtr = NULL;
-    char asyncBuf[LWM2MCORE_BUFFER_MAX_LEN];
-    size_t asyncBufLen = LWM2MCORE_BUFFER_MAX_LEN;
+    lwm2mcore_Value_t value;
 
-    if ((NULL == objectPtr) || (NULL == dataArrayPtr))
-    {
-        return COAP_500_INTERNAL_SERVER_ERROR;
-    }
+    memset(&value, 0, sizeof(value));
+    value.type = LWM2MCORE_VALUE_NONE;
+    value.value.asBuffer.bufferPtr = bufPtr;
+    value.value.asBuffer.len = bufSize;
+    *isEmptyPtr = false;
 
-    LOG_ARG("ReadCb oid %d oiid %d", objectPtr->objID, instanceId);
+    sid = resourcePtr->readValue(uriPtr, &value);
+    LOG_ARG("Result of reading /%d/%d/%d/%d: %d",
+            uriPtr->oid, uriPtr->oiid, uriPtr->rid, uriPtr->riid, sid);
 
-    /* Search if the object was registered */
-    if (!LWM2M_LIST_FIND(objectPtr->instanceList, instanceId))
+    /* Define the CoAP result */
+    result = SetCoapError(sid, LWM2MCORE_OP_READ);
+    if (COAP_205_CONTENT != result)
     {
-        LOG_ARG("Object %d not found", objectPtr->objID);
-        return COAP_404_NOT_FOUND;
+        return result;
     }
-    LOG("object instance Id was registered");
 
-    objPtr = FindObject(Lwm2mcoreCtxPtr, objectPtr->objID);
-    if (NULL == objPtr)
+    if (LWM2MCORE_VALUE_NONE == value.type)
     {
-        LOG_ARG("Object %d is NOT registered", objectPtr->objID);
+        *isEmptyPtr = true;
         return COAP_404_NOT_FOUND;
     }
 
-    memset(&uri, 0, sizeof(uri));
-    uri.op = LWM2MCORE_OP_READ;
-    uri.oid = objectPtr->objID;
-    uri.oiid = instanceId;
-
-    // Validate the operational state early here, as the code to follow may block
-    if (!ValidStateForOperation(&uri))
-    {
-        LOG("Operation disallowed due to the present state");
-        return COAP_500_INTERNAL_SERVER_ERROR;
-    }
-
-    LOG_ARG("numDataP %d", *numDataPtr);
-
-    /* *numDataPtr set to 0 means that the server is asking for the full object.
-     * Otherwise *numDataPtr is set to 1 to read only one resource,
-     * dataArrayPtr is already allocated by Wakaama
-     * and its id is set to the resource to read. */
-    if (0 == *numDataPtr)
+    if (NULL != valuePtr)
     {
-        uint16_t resList[50];
-        int nbRes = 0;
-
-        /* Search the supported resources for the required object */
-        i = 0;
-        for (resourcePtr = DLIST_FIRST(&(objPtr->resource_list));
-             resourcePtr;
-             resourcePtr = DLIST_NEXT(resourcePtr, list))
-        {
-            if (NULL != resourcePtr->read)
-            {
-                resList[ i ] = resourcePtr->id;
-                LOG_ARG("resList[ %d ] %d", i, resList[ i ]);
-                i++;
-            }
-        }
-
-        nbRes = i;
-        LOG_ARG("nbRes %d", nbRes);
-
-        *dataArrayPtr = lwm2m_data_new(nbRes);
-        if (NULL == *dataArrayPtr)
-        {
-            return COAP_500_INTERNAL_SERVER_ERROR;
-        }
-        *numDataPtr = nbRes;
-        for (i = 0 ; i < nbRes ; i++)
-        {
-            (*dataArrayPtr)[i].id = resList[i];
-        }
+        *valuePtr = value;
     }
 
-    i = 0;
-    do
-    {
-        uri.rid = (*dataArrayPtr)[i].id;
-
-        /* Search the resource handler */
-        resourcePtr = FindResource(objPtr, uri.rid);
-        if (NULL != resourcePtr)
-        {
-            if (NULL != resourcePtr->read)
-            {
-                LOG_ARG("READ /%d/%d/%d", uri.oid, uri.oiid, uri.rid);
-                asyncBufLen = LWM2MCORE_BUFFER_MAX_LEN;
-                memset(asyncBuf, 0, asyncBufLen);
-
-                if (1 < resourcePtr->maxInstCount)
-                {
-                    result = ReadResourceInstances(&uri,
-                                                   resourcePtr,
-                                                   (*dataArrayPtr) + i,
-                                                   asyncBuf,
-                                                   asyncBufLen);
-                    LOG_ARG("Result of reading object: %d", objectPtr->objID, result);
-                }
-                else
-                {
-                    sid = resourcePtr->read(&uri, asyncBuf, &asyncBufLen, NULL);
-                    LOG_ARG("Result of reading instance %d: %d", instanceId, sid);
-
-                    /* Define the CoAP result */
-                    result = SetCoapError(sid, LWM2MCORE_OP_READ);
-
-                    if (COAP_205_CONTENT == result)
-                    {
-                        result = EncodeData(resourcePtr->type,
-                                            asyncBuf,
-                                            asyncBufLen,
-                                            (*dataArrayPtr) + i);
-                    }
-                }
-
-                if (COAP_404_NOT_FOUND == result)
-                {
-                    /* Read resource is not implemented, check the number of resources */
-                    if (1 == *numDataPtr)
-                    {
-                        /* This was the only resource to read, return an error.
-                         * No need to free the memory as it will be done by
-                         * the calling function. */
-                        result = COAP_404_NOT_FOUND;
-                        i++;
-                    }
-                    else
-                    {
-                        /* Remove the corresponding data */
-                        lwm2m_data_t* newDataArrayPtr;
-
-                        /* Allocate a new buffer */
-                        newDataArrayPtr = lwm2m_data_new((*numDataPtr)-1);
-                        if (NULL == newDataArrayPtr)
-                        {
-                            return COAP_500_INTERNAL_SERVER_ERROR;
-                        }
-                        /* Copy the previous data, except for the "not implemented" one */
-                        memcpy(newDataArrayPtr, *dataArrayPtr, i * sizeof(lwm2m_data_t));
-                        memcpy(newDataArrayPtr + i,
-                               (*dataArrayPtr) + (i+1),
-                               ((*numDataPtr)-(i+1)) * sizeof(lwm2m_data_t));
-                        /* Free the previous buffer */
-                        lwm2m_free(*dataArrayPtr);
-                        /* Update the output data */
-                        *dataArrayPtr = newDataArrayPtr;
-                        (*numDataPtr)--;
-                        result = COAP_205_CONTENT;
-                    }
-                }
-                else
-                {
-                    i++;
-                }
-            }
-            else
-            {
-                LOG("READ callback NULL");
-                result = COAP_405_METHOD_NOT_ALLOWED;
-                i++;
-            }
-        }
-        else
-        {
-            LOG("resource NULL");
-            result = COAP_404_NOT_FOUND;
-            i++;
-        }
-    } while (   (i < *numDataPtr)
-             && (   (COAP_205_CONTENT == result)
-                 || (COAP_NO_ERROR == result)
-                )
-            );
-
-    LOG_ARG("ReadCb result %d", result);
-    return result;
+    return EncodeValue(resourcePtr->type, &value, dataPtr);
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Revert a character from base 64
+ * Get the state of a resource for an object instance
  *
  * @return
- *      - character value
- *      - 0 on error
+ *      - resource state
+ *      - NULL if the state does not exist and is not created, or on allocation failure
  */
 //--------------------------------------------------------------------------------------------------
-static uint8_t prv_b64Revert
+static lwm2mcore_resourceState_t* GetResourceState
 (
-    uint8_t value       ///< [IN] Character to decode
+    lwm2mcore_internalResource_t* resourcePtr,  ///< [IN] LWM2M resource
+    uint16_t oiid,                              ///< [IN] Object instance Id
+    bool isCreated                              ///< [IN] Create the state if it does not exist
 )
 {
-    if (value >= 'A' && value <= 'Z')
-    {
-        return (value - 'A');
-    }
+    lwm2mcore_resourceState_t* statePtr;
 
-    if (value >= 'a' && value <= 'z')
+    for (statePtr = resourcePtr->statePtr; statePtr; statePtr = statePtr->nextPtr)
     {
-        return (26 + value - 'a');
+        if (oiid == statePtr->oiid)
+        {
+            return statePtr;
+        }
     }
 
-    if (value >= '0' && value <= '9')
+    if (!isCreated)
     {
-        return (52 + value - '0');
+        return NULL;
     }
 
-    switch (value)
+    statePtr = (lwm2mcore_resourceState_t*)lwm2m_malloc(sizeof(lwm2mcore_resourceState_t));
+    if (NULL == statePtr)
     {
-        case '+':
-            return 62;
-        case '/':
-            return 63;
-        default:
-            return 0;
+        return NULL;
     }
+    memset(statePtr, 0, sizeof(lwm2mcore_resourceState_t));
+    statePtr->oiid = oiid;
+    statePtr->nextPtr = resourcePtr->statePtr;
+    resourcePtr->statePtr = statePtr;
+    return statePtr;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Decode a 4-bit base 64 encoded block
+ * Clear the cached read value of a resource state and release its storage
  */
 //--------------------------------------------------------------------------------------------------
-static void prv_decodeBlock
+static void ClearCache
 (
-    uint8_t input[4],       ///< [IN] Base 64 encoded bloc
-    uint8_t output[3]       ///< [OUT] Decoded block
+    lwm2mcore_resourceState_t* statePtr         ///< [IN] Resource state
 )
 {
-    uint8_t tmp[4];
-    int i;
+    if (NULL != statePtr->cache)
+    {
+        lwm2m_free(statePtr->cache);
+        statePtr->cache = NULL;
+    }
+    memset(&statePtr->cacheValue, 0, sizeof(statePtr->cacheValue));
+    statePtr->isCacheValid = false;
+}
 
-    memset(output, 0, 3);
+//--------------------------------------------------------------------------------------------------
+/**
+ * Invalidate the cached read value of a resource for an object instance
+ */
+//--------------------------------------------------------------------------------------------------
+static void InvalidateCache
+(
+    lwm2mcore_internalResource_t* resourcePtr,  ///< [IN] LWM2M resource
+    uint16_t oiid                               ///< [IN] Object instance Id
+)
+{
+    lwm2mcore_resourceState_t* statePtr = GetResourceState(resourcePtr, oiid, false);
 
-    for (i = 0; i < 4; i++)
+    if (NULL != statePtr)
     {
-        tmp[i] = prv_b64Revert(input[i]);
+        ClearCache(statePtr);
     }
-
-    output[0] = (tmp[0] << 2) | (tmp[1] >> 4);
-    output[1] = (tmp[1] << 4) | (tmp[2] >> 2);
-    output[2] = (tmp[2] << 6) | tmp[3];
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Decode a base 64 string
- *
- * @return
- *      - decoded string length
- *      - 0 on error
+ * Release the states of a resource for all the object instances
  */
 //--------------------------------------------------------------------------------------------------
-size_t base64_decode
+static void FreeResourceStates
 (
-    uint8_t * dataP,    ///< [IN] Base 64 string
-    size_t    dataLen,  ///< [IN] Base 64 string length
-    uint8_t * bufferP   ///< [OUT] Buffer for decoded string
+    lwm2mcore_internalResource_t* resourcePtr   ///< [IN] LWM2M resource
 )
 {
-    size_t data_index;
-    size_t result_index;
-    size_t result_len;
+    lwm2mcore_resourceState_t* statePtr;
+    lwm2mcore_notifyState_t* notifyPtr;
 
-    // Check if the number of bytes is a multiple of 4
-    if (dataLen % 4)
+    while (NULL != (statePtr = resourcePtr->statePtr))
     {
-        return 0;
+        resourcePtr->statePtr = statePtr->nextPtr;
+        ClearCache(statePtr);
+        while (NULL != (notifyPtr = statePtr->notifyPtr))
+        {
+            statePtr->notifyPtr = notifyPtr->nextPtr;
+            lwm2m_free(notifyPtr);
+        }
+        lwm2m_free(statePtr);
     }
+}
 
-    result_len = (dataLen >> 2) * 3;
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the cached read value of a resource for an object instance
+ *
+ * @return
+ *      - resource state holding a valid cached value
+ *      - NULL if no cached value is valid
+ */
+//--------------------------------------------------------------------------------------------------
+static lwm2mcore_resourceState_t* GetValidCache
+(
+    lwm2mcore_internalResource_t* resourcePtr,  ///< [IN] LWM2M resource
+    uint16_t oiid                               ///< [IN] Object instance Id
+)
+{
+    lwm2mcore_resourceState_t* statePtr;
 
-    // remove padding
-    while (dataP[dataLen - 1] == B64_PADDING)
+    if (LWM2MCORE_CACHE_NEVER == resourcePtr->cacheTtl)
     {
-        dataLen--;
+        return NULL;
     }
 
-    data_index = 0;
-    result_index = 0;
-    while (data_index < dataLen)
+    statePtr = GetResourceState(resourcePtr, oiid, false);
+    if ((NULL == statePtr) || (!statePtr->isCacheValid))
     {
-        prv_decodeBlock(dataP + data_index, bufferP + result_index);
-        data_index += 4;
-        result_index += 3;
+        return NULL;
     }
 
-    switch (data_index - dataLen)
+    if (   (LWM2MCORE_CACHE_STATIC != resourcePtr->cacheTtl)
+        && ((lwm2mcore_TimerGetTimeMs() - statePtr->cacheTimeMs) >= resourcePtr->cacheTtl))
     {
-        case 0:
-            break;
+        return NULL;
+    }
 
-        case 2:
-        {
-            uint8_t tmp[2];
+    return statePtr;
+}
 
-            tmp[0] = prv_b64Revert(dataP[dataLen - 2]);
-            tmp[1] = prv_b64Revert(dataP[dataLen - 1]);
+//--------------------------------------------------------------------------------------------------
+/**
+ * Store a read value in the resource cache of an object instance, according to the resource cache
+ * policy. String/opaque values are copied in a dedicated storage.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StoreCache
+(
+    lwm2mcore_internalResource_t* resourcePtr,  ///< [IN] LWM2M resource
+    uint16_t oiid,                              ///< [IN] Object instance Id
+    const lwm2mcore_Value_t* valuePtr           ///< [IN] Read value
+)
+{
+    lwm2mcore_resourceState_t* statePtr;
 
-            bufferP[result_index - 3] = (tmp[0] << 2) | (tmp[1] >> 4);
-            bufferP[result_index - 2] = (tmp[1] << 4);
-            result_len -= 2;
-        }
-        break;
+    if (LWM2MCORE_CACHE_NEVER == resourcePtr->cacheTtl)
+    {
+        return;
+    }
 
-        case 3:
-        {
-            uint8_t tmp[3];
+    statePtr = GetResourceState(resourcePtr, oiid, true);
+    if (NULL == statePtr)
+    {
+        return;
+    }
 
-            tmp[0] = prv_b64Revert(dataP[dataLen - 3]);
-            tmp[1] = prv_b64Revert(dataP[dataLen - 2]);
-            tmp[2] = prv_b64Revert(dataP[dataLen - 1]);
+    ClearCache(statePtr);
+    statePtr->cacheValue = *valuePtr;
 
-            bufferP[result_index - 3] = (tmp[0] << 2) | (tmp[1] >> 4);
-            bufferP[result_index - 2] = (tmp[1] << 4) | (tmp[2] >> 2);
-            bufferP[result_index - 1] = (tmp[2] << 6);
-            result_len -= 1;
+    if (LWM2MCORE_VALUE_BUFFER == valuePtr->type)
+    {
+        /* Keep a null-terminated copy: float values read as text are decoded with atof */
+        statePtr->cache = (char*)lwm2m_malloc(valuePtr->value.asBuffer.len + 1);
+        if (NULL == statePtr->cache)
+        {
+            memset(&statePtr->cacheValue, 0, sizeof(statePtr->cacheValue));
+            return;
         }
-        break;
-
-        default:
-            bufferP = NULL;
-            result_len = 0;
-            break;
+        memcpy(statePtr->cache, valuePtr->value.asBuffer.bufferPtr, valuePtr->value.asBuffer.len);
+        statePtr->cache[valuePtr->value.asBuffer.len] = '\0';
+        statePtr->cacheValue.value.asBuffer.bufferPtr = statePtr->cache;
     }
 
-    return result_len;
+    statePtr->cacheTimeMs = lwm2mcore_TimerGetTimeMs();
+    statePtr->isCacheValid = true;
 }
 
-
 //--------------------------------------------------------------------------------------------------
 /**
- * Generic function when a WRITE/EXECUTE command is treated to format the received data
+ * Encode the cached read value of a resource as a LWM2M data
  *
  * @return
- *      - true on success
- *      - false else
+ *      - COAP_205_CONTENT if the value is correctly encoded
+ *      - COAP_500_INTERNAL_SERVER_ERROR in case of error
  */
 //--------------------------------------------------------------------------------------------------
-static bool FormatDataWriteExecute
+static uint8_t EncodeCache
 (
-    lwm2mcore_ResourceType_t    resourceFormatType,     ///< [IN] Resource format type
-    lwm2m_data_t                dataArray,              ///< [IN] Array of requested resources to be
-                                                        ///< written
-    char*                       bufferPtr,              ///< [IN] Output buffer
-    size_t*                     bufferLenPtr            ///< [IN] Output buffer length
+    lwm2mcore_internalResource_t* resourcePtr,  ///< [IN] LWM2M resource
+    lwm2mcore_resourceState_t* statePtr,        ///< [IN] Resource state holding the cached value
+    lwm2m_data_t* dataPtr                       ///< [INOUT] Encoded LWM2M data
 )
 {
-    bool result = false;
-
-    if ( (NULL == bufferPtr) || (NULL == bufferLenPtr))
+    /* Values cached from a legacy READ handler keep their raw representation */
+    if (NULL == resourcePtr->readValue)
     {
-        return false;
+        return EncodeData(resourcePtr->type,
+                          statePtr->cacheValue.value.asBuffer.bufferPtr,
+                          statePtr->cacheValue.value.asBuffer.len,
+                          dataPtr);
     }
 
-    // This indicates in which format the server sent a data
-    // According to Wakaama source code (see lwm2m_data_parse API)):
-    // - when a WRITE/EXECUTE command is received on a specific resoure in TEXT format, the type is
-    //   set to LWM2M_TYPE_STRING
-    // - when a WRITE/EXECUTE command is received on a specific resoure in TLV format, the type is
-    //   set to LWM2M_TYPE_OPAQUE
-    // - when a WRITE command is received on a specific object in TLV format, the type is set to
-    //   LWM2M_TYPE_OPAQUE
-    switch (dataArray.type)
-    {
-        case LWM2M_TYPE_STRING:
-        {
-            if (dataArray.value.asBuffer.length <= (*bufferLenPtr))
-            {
-                // Check the resource format
-                switch (resourceFormatType)
-                {
-                    case LWM2MCORE_RESOURCE_TYPE_INT:
-                    case LWM2MCORE_RESOURCE_TYPE_BOOL:
-                    case LWM2MCORE_RESOURCE_TYPE_TIME:
-                    {
-                        // The received data is the integer/boolean value in text
-                        // Time is also a type represented in integer rather than string form
-                        // Example: value 123 is sent like 0x31 32 33
-                        // Change the string in value
-                        int64_t value = 0;
+    return EncodeValue(resourcePtr->type, &statePtr->cacheValue, dataPtr);
+}
 
-                        // If the length is 0, immediately return the right length value
-                        // else Wakaama utils_textToInt will return an error
-                        if(!(dataArray.value.asBuffer.length))
-                        {
-                            *bufferLenPtr = 0;
-                            return true;
-                        }
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a string or opaque resource through its chunked READ handler and encode it as a LWM2M
+ * data. The value is read chunk by chunk in a heap buffer which is handed over to the LWM2M data,
+ * so its length is not limited by LWM2MCORE_BUFFER_MAX_LEN.
+ *
+ * @return
+ *      - COAP_205_CONTENT if the value is read and encoded
+ *      - COAP_413_ENTITY_TOO_LARGE if the value exceeds LWM2MCORE_READ_CHUNK_MAX_TOTAL_LEN
+ *      - COAP_500_INTERNAL_SERVER_ERROR in case of error
+ *      - other CoAP error code returned by the handler
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t ReadChunks
+(
+    lwm2mcore_Uri_t* uriPtr,                    ///< [IN] Requested operation and object/resource
+    lwm2mcore_internalResource_t* resourcePtr,  ///< [IN] LWM2M resource
+    lwm2m_data_t* dataPtr,                      ///< [INOUT] Encoded LWM2M data
+    bool* isEmptyPtr                            ///< [OUT] Set if the value is empty
+)
+{
+    int sid;
+    uint8_t result;
+    uint8_t* valuePtr = NULL;
+    size_t valueSize = 0;
+    size_t offset = 0;
+    size_t chunkLen;
 
-                        if (utils_textToInt(dataArray.value.asBuffer.buffer,
-                                            dataArray.value.asBuffer.length,
-                                            &value))
-                        {
-                            // Treat it in buffer for generic handlers treament
-                            *bufferLenPtr = omanager_FormatValueToBytes((uint8_t*) bufferPtr,
-                                                                        &value,
-                                                                        sizeof(value),
-                                                                        false);
-                            result = true;
-                        }
-                    }
-                    break;
+    *isEmptyPtr = false;
 
-                    case LWM2MCORE_RESOURCE_TYPE_OPAQUE:
-                    {
-                        size_t len = 0;
-                        // decode b64
-                        len = base64_decode(dataArray.value.asBuffer.buffer,
-                                            dataArray.value.asBuffer.length,
-                                            (uint8_t*)bufferPtr);
-                        *bufferLenPtr = len;
-                        result = true;
-                    }
-                    break;
+    do
+    {
+        /* Make sure a full chunk can be stored */
+        if ((valueSize - offset) < LWM2MCORE_READ_CHUNK_LEN)
+        {
+            uint8_t* newValuePtr;
+            size_t newSize = valueSize ? (2 * valueSize) : LWM2MCORE_READ_CHUNK_LEN;
 
-                    case LWM2MCORE_RESOURCE_TYPE_FLOAT:
-                    case LWM2MCORE_RESOURCE_TYPE_UNKNOWN:
-                    default:
-                        memcpy(bufferPtr,
-                               dataArray.value.asBuffer.buffer,
-                               dataArray.value.asBuffer.length);
-                        *bufferLenPtr = dataArray.value.asBuffer.length;
-                        result = true;
-                    break;
-                }
+            if (LWM2MCORE_READ_CHUNK_MAX_TOTAL_LEN < newSize)
+            {
+                LOG_ARG("Resource /%d/%d/%d is too large", uriPtr->oid, uriPtr->oiid, uriPtr->rid);
+                lwm2m_free(valuePtr);
+                return COAP_413_ENTITY_TOO_LARGE;
             }
-        }
-        break;
 
-        case LWM2M_TYPE_OPAQUE:
-        {
-            if (dataArray.value.asBuffer.length <= (*bufferLenPtr))
+            newValuePtr = (uint8_t*)lwm2m_malloc(newSize);
+            if (!newValuePtr)
             {
-                memcpy(bufferPtr, dataArray.value.asBuffer.buffer, dataArray.value.asBuffer.length);
-                *bufferLenPtr = dataArray.value.asBuffer.length;
-                result = true;
+                lwm2m_free(valuePtr);
+                return COAP_500_INTERNAL_SERVER_ERROR;
+            }
+            if (valuePtr)
+            {
+                memcpy(newValuePtr, valuePtr, offset);
+                lwm2m_free(valuePtr);
             }
+            valuePtr = newValuePtr;
+            valueSize = newSize;
         }
-        break;
 
-        case LWM2M_TYPE_INTEGER:
-            *bufferLenPtr = omanager_FormatValueToBytes((uint8_t*) bufferPtr,
-                                                        &(dataArray.value.asInteger),
-                                                        sizeof(dataArray.value.asInteger),
-                                                        false);
-            result = true;
-        break;
+        chunkLen = LWM2MCORE_READ_CHUNK_LEN;
+        sid = resourcePtr->readChunk(uriPtr, offset, (char*)(valuePtr + offset), &chunkLen);
 
-        case LWM2M_TYPE_FLOAT:
-        case LWM2M_TYPE_BOOLEAN:
-        default:
-            LOG_ARG("Unmanaged type format for WRITE/EXECUTE %d", dataArray.type);
-            *bufferLenPtr = 0;
-        break;
+        /* Define the CoAP result */
+        result = SetCoapError(sid, LWM2MCORE_OP_READ);
+        if ((COAP_205_CONTENT != result) || (LWM2MCORE_READ_CHUNK_LEN < chunkLen))
+        {
+            LOG_ARG("Chunk read error at offset %zu: %d", offset, sid);
+            lwm2m_free(valuePtr);
+            return (COAP_205_CONTENT == result) ? COAP_500_INTERNAL_SERVER_ERROR : result;
+        }
+        offset += chunkLen;
     }
+    while (LWM2MCORE_READ_CHUNK_LEN == chunkLen);
 
-    return result;
+    LOG_ARG("Read /%d/%d/%d: %zu bytes", uriPtr->oid, uriPtr->oiid, uriPtr->rid, offset);
+
+    if (!offset)
+    {
+        lwm2m_free(valuePtr);
+        valuePtr = NULL;
+        *isEmptyPtr = true;
+    }
+
+    /* Hand the buffer over to the LWM2M data, it is freed with it */
+    dataPtr->type = (LWM2MCORE_RESOURCE_TYPE_STRING == resourcePtr->type) ?
+                    LWM2M_TYPE_STRING : LWM2M_TYPE_OPAQUE;
+    dataPtr->value.asBuffer.buffer = valuePtr;
+    dataPtr->value.asBuffer.length = offset;
+
+    return COAP_205_CONTENT;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Generic function when a WRITE command is treated for a specific object (Wakaama)
- *
- * @return
- *      - COAP_404_NOT_FOUND if the object instance or write callback is not registered
- *      - COAP_500_INTERNAL_SERVER_ERROR in case of error
- *      - COAP_204_CHANGED if the request is well treated
+ * Free the LWM2M data encoded in an array allocated by RequestAlloc. The array itself is released
+ * by RequestFree.
  */
 //--------------------------------------------------------------------------------------------------
-static uint8_t WriteCb
+static void FreeRequestData
 (
-    uint16_t instanceId,            ///< [IN] Object ID
-    int numData,                    ///< [IN] Number of resources to be written
-    lwm2m_data_t* dataArrayPtr,     ///< [IN] Array of requested resources to be written
-    lwm2m_object_t* objectPtr       ///< [IN] Pointer on object
+    lwm2m_data_t* dataArrayPtr,     ///< [IN] Array of LWM2M data
+    size_t count                    ///< [IN] Number of LWM2M data in the array
 )
 {
-    uint8_t result = COAP_400_BAD_REQUEST;
-    int i;
-    bool isMalloc = false;
-    int sid = 0;
-    lwm2mcore_Uri_t uri;
-    lwm2mcore_internalResource_t* resourcePtr = NULL;
-    lwm2mcore_internalObject_t* objPtr;
-    char asyncBuf[LWM2MCORE_BUFFER_MAX_LEN];
-    size_t asyncBufLen = LWM2MCORE_BUFFER_MAX_LEN;
+    size_t i;
 
-    if ((NULL == objectPtr) || (NULL == dataArrayPtr))
+    for (i = 0; i < count; i++)
     {
-        return COAP_500_INTERNAL_SERVER_ERROR;
-    }
+        switch (dataArrayPtr[i].type)
+        {
+            case LWM2M_TYPE_STRING:
+            case LWM2M_TYPE_OPAQUE:
+                if (NULL != dataArrayPtr[i].value.asBuffer.buffer)
+                {
+                    lwm2m_free(dataArrayPtr[i].value.asBuffer.buffer);
+                }
+                break;
 
-    LOG_ARG("WriteCb oid %d oiid %d", objectPtr->objID, instanceId);
+            case LWM2M_TYPE_MULTIPLE_RESOURCE:
+            case LWM2M_TYPE_OBJECT_INSTANCE:
+            case LWM2M_TYPE_OBJECT:
+                lwm2m_data_free((int)dataArrayPtr[i].value.asChildren.count,
+                                dataArrayPtr[i].value.asChildren.array);
+                break;
 
-    /* Search if the object was registered */
-    if (!LWM2M_LIST_FIND(objectPtr->instanceList, instanceId))
-    {
-        LOG_ARG("Object %d not found", objectPtr->objID);
-        return COAP_404_NOT_FOUND;
+            default:
+                break;
+        }
     }
+}
 
-    LOG("object instance Id was registered");
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read resources with multiple instances in an object
+ *
+ * The instances are read in a request arena array sized for the maximum instance number. Only the
+ * instances which are present are then copied in the heap array handed to Wakaama.
+ *
+ * @return
+ *      - COAP_205_CONTENT if the request is well treated
+ *      - COAP_404_NOT_FOUND if no instance is present
+ *      - COAP_500_INTERNAL_SERVER_ERROR in case of error
+ *      - COAP_501_NOT_IMPLEMENTED if the read callback is not implemented
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t ReadResourceInstances
+(
+    lwm2mcore_Uri_t* uriPtr,                    ///< [IN] Requested operation and object/resource
+    lwm2mcore_internalResource_t* resourcePtr,  ///< [IN] LWM2M resource
+    lwm2m_data_t* dataPtr,                      ///< [INOUT] Encoded LWM2M data
+    char* bufPtr,                               ///< [IN] Read buffer
+    size_t bufSize,                             ///< [IN] Read Buffer size
+    size_t* bufUsedPtr                          ///< [INOUT] Bytes of the read buffer which may be
+                                                ///< non-zero
+)
+{
+    int sid = 0;
+    uint16_t i = 0;
+    uint16_t instanceNumber;
+    uint16_t count = 0;
+    uint8_t result = COAP_404_NOT_FOUND;
+    lwm2m_data_t* instancesPtr;
+    lwm2m_data_t* encodedPtr;
 
-    objPtr = FindObject(Lwm2mcoreCtxPtr, objectPtr->objID);
-    if (!objPtr)
+    /* Check for object 2 (ACL
+     * For this object, the resource instance Id are not incremented but correspond
+     * to a server Id.
+     * This means that, for example, 2 resource instances can exist with
+     * 1st resource instance Id = 1 (server Id = 1)
+     * 2nd resource instance Id = 123 (server Id = 123)
+     * So the number of resource instances can not be linked to riid in this case
+     */
+    if (LWM2MCORE_ACL_OID == uriPtr->oid)
     {
-        LOG_ARG("Object %d is NOT registered", objectPtr->objID);
-        return COAP_404_NOT_FOUND;
+        instanceNumber = omanager_GetAclInstanceNumber(uriPtr->oiid);
+    }
+    else
+    {
+        instanceNumber = resourcePtr->maxInstCount;
     }
 
-    memset(&uri, 0, sizeof (lwm2mcore_Uri_t));
-    uri.op = LWM2MCORE_OP_WRITE;
-    uri.oid = objectPtr->objID;
-    uri.oiid = instanceId;
-
-    // Validate the operational state early here, as the code to follow may block
-    if (!ValidStateForOperation(&uri))
+    if (!instanceNumber)
     {
-        LOG("Operation disallowed due to the present state");
         return COAP_500_INTERNAL_SERVER_ERROR;
     }
 
-    LOG_ARG("numData %d", numData);
-    // is the server asking for the full object ?
-    if (0 == numData)
+    instancesPtr = (lwm2m_data_t*)RequestAlloc(instanceNumber * sizeof(lwm2m_data_t));
+    if (!instancesPtr)
     {
-        uint16_t resList[50];
-        int nbRes = 0;
-        isMalloc = true;
-        /* Search the supported resources for the required object */
-        i = 0;
-        for (resourcePtr = DLIST_FIRST(&(objPtr->resource_list));
-             resourcePtr;
-             resourcePtr = DLIST_NEXT(resourcePtr, list))
-        {
-            resList[ i++ ] = resourcePtr->id;
-        }
-
-        nbRes = i;
-
-        dataArrayPtr = lwm2m_data_new(nbRes);
-        if (NULL == dataArrayPtr)
-        {
-            return COAP_500_INTERNAL_SERVER_ERROR;
-        }
-        numData = nbRes;
-        for (i = 0 ; i < nbRes ; i++)
-        {
-            dataArrayPtr[i].id = resList[i];
-        }
+        return COAP_500_INTERNAL_SERVER_ERROR;
     }
 
-    i = 0;
     do
     {
-        uri.rid = dataArrayPtr[i].id;
-        memset(asyncBuf, 0, LWM2MCORE_BUFFER_MAX_LEN);
-        asyncBufLen = LWM2MCORE_BUFFER_MAX_LEN;
+        size_t readSize = bufSize;
 
-        /* Search the resource handler */
-        resourcePtr = FindResource(objPtr, uri.rid);
-        if (!resourcePtr)
+        memset(bufPtr, 0, *bufUsedPtr);
+        *bufUsedPtr = bufSize;
+        uriPtr->riid = i;
+
+        if (   (NULL != resourcePtr->readValue)
+            || ((NULL != resourcePtr->readChunk) && (NULL == resourcePtr->read)))
         {
-            LOG("resource NULL");
-            if (isMalloc)
+            bool isEmpty;
+            lwm2mcore_Value_t value;
+
+            /* Read and encode the instance of the resource */
+            (instancesPtr + i)->id = uriPtr->riid;
+            if (NULL != resourcePtr->readValue)
             {
-                lwm2m_free(dataArrayPtr);
+                result = ReadValue(uriPtr, resourcePtr, bufPtr, bufSize, instancesPtr + i,
+                                   &isEmpty, &value);
+                if (COAP_205_CONTENT == result)
+                {
+                    *bufUsedPtr = (LWM2MCORE_VALUE_BUFFER == value.type) ?
+                                  ReadBufferUsed(value.value.asBuffer.len, bufSize) : 0;
+                }
             }
-            return COAP_404_NOT_FOUND;
-        }
-
-        if (!(resourcePtr->write))
-        {
-            LOG("WRITE callback NULL");
-             if (isMalloc)
+            else
             {
-                lwm2m_free(dataArrayPtr);
+                *bufUsedPtr = 0;
+                result = ReadChunks(uriPtr, resourcePtr, instancesPtr + i, &isEmpty);
+                if ((isEmpty) && (0 == uriPtr->riid))
+                {
+                    /* No instance, return an error */
+                    result = COAP_404_NOT_FOUND;
+                }
             }
-            return COAP_405_METHOD_NOT_ALLOWED;
-        }
-
-        LOG_ARG("data type %d resourcePtr->ptr %d", dataArrayPtr[i].type, resourcePtr->type);
-        if (LWM2M_TYPE_MULTIPLE_RESOURCE != dataArrayPtr[i].type)
-        {
-            if (FormatDataWriteExecute(resourcePtr->type,
-                                       dataArrayPtr[i],
-                                       asyncBuf,
-                                       &asyncBufLen))
+            if ((isEmpty) && (0 != uriPtr->riid))
             {
-                LOG_ARG("WRITE / %d / %d / %d", uri.oid, uri.oiid, uri.rid);
-                sid = resourcePtr->write(&uri, asyncBuf, asyncBufLen);
-                LOG_ARG("WRITE sID %d", sid);
-                /* Define the CoAP result */
-                result = SetCoapError(sid, LWM2MCORE_OP_WRITE);
+                /* No more instance, stop processing without throwing an error */
+                i = resourcePtr->maxInstCount;
+                result = COAP_205_CONTENT;
             }
-            else
+            else if (COAP_205_CONTENT == result)
             {
-                result = COAP_400_BAD_REQUEST;
+                count = i + 1;
             }
+            i++;
+            continue;
         }
-        else
+
+        /* Read the instance of the resource */
+        sid  = resourcePtr->read(uriPtr, bufPtr, &readSize, NULL);
+        LOG_ARG("Result of reading instance %d: %d", uriPtr->oiid, sid);
+
+        /* Define the CoAP result */
+        result = SetCoapError(sid, LWM2MCORE_OP_READ);
+
+        if (COAP_205_CONTENT == result)
         {
-            uint32_t count = (uint32_t)dataArrayPtr[i].value.asChildren.count;
-            uint32_t loop;
+            *bufUsedPtr = ReadBufferUsed(readSize, bufSize);
 
-            for (loop = 0; loop < count; loop++)
+            /* Check if some data was returned */
+            if (readSize)
             {
-                if (FormatDataWriteExecute(resourcePtr->type,
-                                           dataArrayPtr[i].value.asChildren.array[loop],
-                                           asyncBuf,
-                                           &asyncBufLen))
+                /* Set resource id and encode as LWM2M data */
+                (instancesPtr + i)->id = uriPtr->riid;
+                result = EncodeData(resourcePtr->type,
+                                    bufPtr,
+                                    readSize,
+                                    instancesPtr + i);
+                count = i + 1;
+            }
+            else
+            {
+                if (0 == uriPtr->riid)
                 {
-                    uri.riid = dataArrayPtr[i].value.asChildren.array[loop].id;
-                    LOG_ARG("WRITE / %d / %d / %d / %d", uri.oid, uri.oiid, uri.rid, uri.riid);
-                    sid = resourcePtr->write(&uri, asyncBuf, asyncBufLen);
-                    LOG_ARG("WRITE sID %d", sid);
-                    /* Define the CoAP result */
-                    result = SetCoapError(sid, LWM2MCORE_OP_WRITE);
+                    /* No instance, return an error */
+                    result = COAP_404_NOT_FOUND;
                 }
                 else
                 {
-                    result = COAP_400_BAD_REQUEST;
+                    /* No more instance, stop processing without throwing an error */
+                    i = resourcePtr->maxInstCount;
                 }
             }
         }
         i++;
-    } while ((i < numData) && ((COAP_204_CHANGED == result) || (COAP_NO_ERROR == result)));
+    }
+    while ((i < instanceNumber) && (COAP_205_CONTENT == result));
 
-    LOG_ARG("WriteCb result %d", result);
+    if (LWM2MCORE_ACL_OID == uriPtr->oid)
+    {
+        count = instanceNumber;
+    }
 
-    if (isMalloc)
+    encodedPtr = NULL;
+    if ((COAP_205_CONTENT == result) && (count))
+    {
+        /* The array is returned to Wakaama which frees it: copy the instances on the heap */
+        encodedPtr = (lwm2m_data_t*)lwm2m_malloc(count * sizeof(lwm2m_data_t));
+        if (NULL == encodedPtr)
+        {
+            result = COAP_500_INTERNAL_SERVER_ERROR;
+        }
+    }
+
+    if (COAP_205_CONTENT == result)
     {
-        lwm2m_free(dataArrayPtr);
+        /* No error, encode the resources in a single LWM2M data */
+        if (NULL != encodedPtr)
+        {
+            memcpy(encodedPtr, instancesPtr, count * sizeof(lwm2m_data_t));
+        }
+        lwm2m_data_encode_instances(encodedPtr, count, dataPtr);
+    }
+    else
+    {
+        /* Error, free the already encoded instances */
+        FreeRequestData(instancesPtr, instanceNumber);
     }
+
+    RequestFree(instancesPtr);
     return result;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Delete an object instance in the Wakaama format
+ * Validate the operational state to see if it's allowed to proceed with the given object instance.
+ * So far all objects are allowed to proceed, except object 33405 when it's in the process of and
+ * not done with a system time update. Then this function will return false to advise the caller
+ * to not proceed.
  *
  * @return
- *      - COAP_404_NOT_FOUND if the object instance does not exist
- *      - COAP_500_INTERNAL_SERVER_ERROR in case of error
- *      - COAP_202_DELETED if the request is well treated
+ *      - true if it's good to proceed; false otherwise.
  */
 //--------------------------------------------------------------------------------------------------
-static uint8_t DeleteObjInstance
+static bool ValidStateForOperation
 (
-    uint16_t id,                    ///< [IN] Object instance ID
-    lwm2m_object_t* objectPtr       ///< [IN] Pointer on object
+    lwm2mcore_Uri_t* uri
 )
 {
-    lwm2m_list_t* instancePtr;
-
-    if (NULL == objectPtr)
+    if (!uri)
     {
-        return COAP_500_INTERNAL_SERVER_ERROR;
+        return false;
     }
 
-    objectPtr->instanceList = lwm2m_list_remove(objectPtr->instanceList,
-                                                id,
-                                                (lwm2m_list_t **)&instancePtr);
-    if (NULL == instancePtr)
+    if (LWM2MCORE_CLOCK_TIME_CONFIG_OID != uri->oid)
     {
-        return COAP_404_NOT_FOUND;
+        return true;
     }
 
-    lwm2m_free(instancePtr);
-
-    return COAP_202_DELETED;
+    // Check if the current state of Clock Service allows this operation
+    if (lwm2mcore_UpdateSystemClockInProgress())
+    {
+        LOG("Operation disallowed when system clock time update is in progress");
+        return false;
+    }
+    return true;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Generic function when a CREATE command is treated for a specific object (Wakaama)
+ * Generic function when a READ command is treated for a specific object (Wakaama)
  *
  * @return
- *      - COAP_400_BAD_REQUEST if the object instance already exists
+ *      - COAP_404_NOT_FOUND if the object instance or read callback is not registered
  *      - COAP_500_INTERNAL_SERVER_ERROR in case of error
- *      - COAP_201_CREATED if the request is well treated
+ *      - COAP_205_CONTENT if the request is well treated
  */
 //--------------------------------------------------------------------------------------------------
-static uint8_t CreateCb
+static uint8_t ReadCb
 (
     uint16_t instanceId,            ///< [IN] Object ID
-    int numData,                    ///< [IN] Number of resources to be written
-    lwm2m_data_t* dataArrayPtr,     ///< [IN] Array of requested resources to be written
+    int* numDataPtr,                ///< [IN] Number of resources to be read
+    lwm2m_data_t** dataArrayPtr,    ///< [IN] Array of requested resources to be read
     lwm2m_object_t* objectPtr       ///< [IN] Pointer on object
 )
 {
     uint8_t result;
+    int i = 0;
+    int sid = 0;
+    lwm2mcore_Uri_t uri;
+    lwm2mcore_internalObject_t* objPtr;
+    lwm2mcore_internalResource_t* resourcePtr = NULL;
+    lwm2mcore_resourceState_t* statePtr;
+    char asyncBuf[LWM2MCORE_BUFFER_MAX_LEN];
+    size_t asyncBufLen = LWM2MCORE_BUFFER_MAX_LEN;
+    size_t asyncBufUsed = LWM2MCORE_BUFFER_MAX_LEN;
+    bool isSnapshot = false;
 
     if ((NULL == objectPtr) || (NULL == dataArrayPtr))
     {
         return COAP_500_INTERNAL_SERVER_ERROR;
     }
 
-    LOG_ARG("CreateCb oid %d oiid %d", objectPtr->objID, instanceId);
+    LOG_ARG("ReadCb oid %d oiid %d", objectPtr->objID, instanceId);
 
-    if (LWM2MCORE_SOFTWARE_UPDATE_OID == objectPtr->objID)
+    /* Search if the object was registered */
+    if (!LWM2M_LIST_FIND(objectPtr->instanceList, instanceId))
     {
-        if (LWM2MCORE_ERR_COMPLETED_OK != lwm2mcore_SoftwareUpdateInstance(true, instanceId))
+        LOG_ARG("Object %d not found", objectPtr->objID);
+        return COAP_404_NOT_FOUND;
+    }
+    LOG("object instance Id was registered");
+
+    objPtr = FindObject(Lwm2mcoreCtxPtr, objectPtr->objID);
+    if (NULL == objPtr)
+    {
+        LOG_ARG("Object %d is NOT registered", objectPtr->objID);
+        return COAP_404_NOT_FOUND;
+    }
+
+    memset(&uri, 0, sizeof(uri));
+    uri.op = LWM2MCORE_OP_READ;
+    uri.oid = objectPtr->objID;
+    uri.oiid = instanceId;
+
+    // Validate the operational state early here, as the code to follow may block
+    if (!ValidStateForOperation(&uri))
+    {
+        LOG("Operation disallowed due to the present state");
+        return COAP_500_INTERNAL_SERVER_ERROR;
+    }
+
+    LOG_ARG("numDataP %d", *numDataPtr);
+
+    /* *numDataPtr set to 0 means that the server is asking for the full object.
+     * Otherwise *numDataPtr is set to 1 to read only one resource,
+     * dataArrayPtr is already allocated by Wakaama
+     * and its id is set to the resource to read. */
+    if (0 == *numDataPtr)
+    {
+        int nbRes = 0;
+
+        /* Count the supported resources for the required object */
+        for (resourcePtr = DLIST_FIRST(&(objPtr->resource_list));
+             resourcePtr;
+             resourcePtr = DLIST_NEXT(resourcePtr, list))
+        {
+            if (   (NULL != resourcePtr->read)
+                || (NULL != resourcePtr->readValue)
+                || (NULL != resourcePtr->readChunk))
+            {
+                nbRes++;
+            }
+        }
+        LOG_ARG("nbRes %d", nbRes);
+
+        /* The array is returned to Wakaama which frees it: allocate it on the heap */
+        *dataArrayPtr = lwm2m_data_new(nbRes);
+        if (NULL == *dataArrayPtr)
         {
-            LOG("Error from client to create object instance");
             return COAP_500_INTERNAL_SERVER_ERROR;
         }
-    }
+        *numDataPtr = nbRes;
 
-    if (NULL == objectPtr->instanceList)
-    {
-        LOG("objectPtr->instanceList == NULL");
-        objectPtr->instanceList = (lwm2m_list_t *)lwm2m_malloc(sizeof(lwm2m_list_t));
-        if (NULL != objectPtr->instanceList)
+        i = 0;
+        for (resourcePtr = DLIST_FIRST(&(objPtr->resource_list));
+             resourcePtr;
+             resourcePtr = DLIST_NEXT(resourcePtr, list))
         {
-            memset(objectPtr->instanceList, 0, sizeof(lwm2m_list_t));
+            if (   (NULL != resourcePtr->read)
+                || (NULL != resourcePtr->readValue)
+                || (NULL != resourcePtr->readChunk))
+            {
+                (*dataArrayPtr)[i].id = resourcePtr->id;
+                i++;
+            }
         }
     }
-    /* Search if the object was registered */
-    else if (LWM2M_LIST_FIND(objectPtr->instanceList, instanceId) == NULL)
+
+    /* Several resources (e.g. full object instance) are read:
+     * let the object retrieve all its values at once */
+    if (   (1 < *numDataPtr)
+        && (NULL != objPtr->snapshot)
+        && (LWM2MCORE_ERR_COMPLETED_OK == objPtr->snapshot(&uri, true)))
     {
-        lwm2m_list_t* instancePtr;
-        /* Add the object instance in the Wakaama format */
-        instancePtr = (lwm2m_list_t *)lwm2m_malloc(sizeof(lwm2m_list_t));
-        if (!instancePtr)
+        isSnapshot = true;
+    }
+
+    i = 0;
+    do
+    {
+        uri.rid = (*dataArrayPtr)[i].id;
+
+        /* Search the resource handler */
+        resourcePtr = FindResource(Lwm2mcoreCtxPtr, objPtr, uri.rid);
+        if (NULL != resourcePtr)
         {
-           LOG("instancePtr is NULL");
-           return COAP_500_INTERNAL_SERVER_ERROR;
+            if (   (NULL != resourcePtr->read)
+                || (NULL != resourcePtr->readValue)
+                || (NULL != resourcePtr->readChunk))
+            {
+                LOG_ARG("READ /%d/%d/%d", uri.oid, uri.oiid, uri.rid);
+                asyncBufLen = LWM2MCORE_BUFFER_MAX_LEN;
+
+                /* Only clear what the previous READ handler may have written */
+                memset(asyncBuf, 0, asyncBufUsed);
+                asyncBufUsed = 0;
+
+                if (1 < resourcePtr->maxInstCount)
+                {
+                    result = ReadResourceInstances(&uri,
+                                                   resourcePtr,
+                                                   (*dataArrayPtr) + i,
+                                                   asyncBuf,
+                                                   asyncBufLen,
+                                                   &asyncBufUsed);
+                    LOG_ARG("Result of reading object: %d", objectPtr->objID, result);
+                }
+                else if (   (NULL == resourcePtr->readChunk)
+                         && (NULL != (statePtr = GetValidCache(resourcePtr, uri.oiid))))
+                {
+                    LOG_ARG("READ /%d/%d/%d from cache", uri.oid, uri.oiid, uri.rid);
+                    result = EncodeCache(resourcePtr, statePtr, (*dataArrayPtr) + i);
+                }
+                else if (NULL != resourcePtr->readValue)
+                {
+                    bool isEmpty;
+                    lwm2mcore_Value_t value;
+                    asyncBufUsed = LWM2MCORE_BUFFER_MAX_LEN;
+                    result = ReadValue(&uri,
+                                       resourcePtr,
+                                       asyncBuf,
+                                       asyncBufLen,
+                                       (*dataArrayPtr) + i,
+                                       &isEmpty,
+                                       &value);
+                    if (COAP_205_CONTENT == result)
+                    {
+                        asyncBufUsed = (LWM2MCORE_VALUE_BUFFER == value.type) ?
+                                       ReadBufferUsed(value.value.asBuffer.len, asyncBufLen) : 0;
+                        StoreCache(resourcePtr, uri.oiid, &value);
+                    }
+                }
+                else if (NULL == resourcePtr->read)
+                {
+                    bool isEmpty;
+                    result = ReadChunks(&uri, resourcePtr, (*dataArrayPtr) + i, &isEmpty);
+                }
+                else
+                {
+                    sid = resourcePtr->read(&uri, asyncBuf, &asyncBufLen, NULL);
+                    LOG_ARG("Result of reading instance %d: %d", instanceId, sid);
+
+                    /* Define the CoAP result */
+                    result = SetCoapError(sid, LWM2MCORE_OP_READ);
+
+                    asyncBufUsed = LWM2MCORE_BUFFER_MAX_LEN;
+                    if (COAP_205_CONTENT == result)
+                    {
+                        asyncBufUsed = ReadBufferUsed(asyncBufLen, LWM2MCORE_BUFFER_MAX_LEN);
+                        result = EncodeData(resourcePtr->type,
+                                            asyncBuf,
+                                            asyncBufLen,
+                                            (*dataArrayPtr) + i);
+                    }
+
+                    if (COAP_205_CONTENT == result)
+                    {
+                        lwm2mcore_Value_t value;
+                        value.type = LWM2MCORE_VALUE_BUFFER;
+                        value.value.asBuffer.bufferPtr = asyncBuf;
+                        value.value.asBuffer.len = asyncBufLen;
+                        StoreCache(resourcePtr, uri.oiid, &value);
+                    }
+                }
+
+                if (COAP_404_NOT_FOUND == result)
+                {
+                    /* Read resource is not implemented, check the number of resources */
+                    if (1 == *numDataPtr)
+                    {
+                        /* This was the only resource to read, return an error.
+                         * No need to free the memory as it will be done by
+                         * the calling function. */
+                        result = COAP_404_NOT_FOUND;
+                        i++;
+                    }
+                    else
+                    {
+                        /* Remove the corresponding data in place: shift the next ones.
+                         * The array keeps its allocated size, Wakaama only handles the
+                         * first *numDataPtr entries. */
+                        memmove((*dataArrayPtr) + i,
+                                (*dataArrayPtr) + (i+1),
+                                ((*numDataPtr)-(i+1)) * sizeof(lwm2m_data_t));
+                        (*numDataPtr)--;
+                        memset((*dataArrayPtr) + (*numDataPtr), 0, sizeof(lwm2m_data_t));
+                        result = COAP_205_CONTENT;
+                    }
+                }
+                else
+                {
+                    i++;
+                }
+            }
+            else
+            {
+                LOG("READ callback NULL");
+                result = COAP_405_METHOD_NOT_ALLOWED;
+                i++;
+            }
         }
-        instancePtr->id = instanceId;
-        objectPtr->instanceList = LWM2M_LIST_ADD(objectPtr->instanceList, instancePtr);
-        /* instancePtr is released by omanager_ObjectsFree API */
+        else
+        {
+            LOG("resource NULL");
+            result = COAP_404_NOT_FOUND;
+            i++;
+        }
+    } while (   (i < *numDataPtr)
+             && (   (COAP_205_CONTENT == result)
+                 || (COAP_NO_ERROR == result)
+                )
+            );
+
+    if (isSnapshot)
+    {
+        objPtr->snapshot(&uri, false);
     }
-    else
+
+    LOG_ARG("ReadCb result %d", result);
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Revert a character from base 64
+ *
+ * @return
+ *      - character value
+ *      - 0 on error
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t prv_b64Revert
+(
+    uint8_t value       ///< [IN] Character to decode
+)
+{
+    if (value >= 'A' && value <= 'Z')
     {
-        LOG("Object instance already exists");
-        return COAP_400_BAD_REQUEST;
+        return (value - 'A');
+    }
+
+    if (value >= 'a' && value <= 'z')
+    {
+        return (26 + value - 'a');
+    }
+
+    if (value >= '0' && value <= '9')
+    {
+        return (52 + value - '0');
+    }
+
+    switch (value)
+    {
+        case '+':
+            return 62;
+        case '/':
+            return 63;
+        default:
+            return 0;
     }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode a 4-bit base 64 encoded block
+ */
+//--------------------------------------------------------------------------------------------------
+static void prv_decodeBlock
+(
+    uint8_t input[4],       ///< [IN] Base 64 encoded bloc
+    uint8_t output[3]       ///< [OUT] Decoded block
+)
+{
+    uint8_t tmp[4];
+    int i;
+
+    memset(output, 0, 3);
+
+    for (i = 0; i < 4; i++)
+    {
+        tmp[i] = prv_b64Revert(input[i]);
+    }
+
+    output[0] = (tmp[0] << 2) | (tmp[1] >> 4);
+    output[1] = (tmp[1] << 4) | (tmp[2] >> 2);
+    output[2] = (tmp[2] << 6) | tmp[3];
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode a base 64 string
+ *
+ * @return
+ *      - decoded string length
+ *      - 0 on error
+ */
+//--------------------------------------------------------------------------------------------------
+size_t base64_decode
+(
+    uint8_t * dataP,    ///< [IN] Base 64 string
+    size_t    dataLen,  ///< [IN] Base 64 string length
+    uint8_t * bufferP   ///< [OUT] Buffer for decoded string
+)
+{
+    size_t data_index;
+    size_t result_index;
+    size_t result_len;
+
+    // Check if the number of bytes is a multiple of 4
+    if (dataLen % 4)
+    {
+        return 0;
+    }
+
+    result_len = (dataLen >> 2) * 3;
+
+    // remove padding
+    while (dataP[dataLen - 1] == B64_PADDING)
+    {
+        dataLen--;
+    }
+
+    data_index = 0;
+    result_index = 0;
+    while (data_index < dataLen)
+    {
+        prv_decodeBlock(dataP + data_index, bufferP + result_index);
+        data_index += 4;
+        result_index += 3;
+    }
+
+    switch (data_index - dataLen)
+    {
+        case 0:
+            break;
+
+        case 2:
+        {
+            uint8_t tmp[2];
+
+            tmp[0] = prv_b64Revert(dataP[dataLen - 2]);
+            tmp[1] = prv_b64Revert(dataP[dataLen - 1]);
+
+            bufferP[result_index - 3] = (tmp[0] << 2) | (tmp[1] >> 4);
+            bufferP[result_index - 2] = (tmp[1] << 4);
+            result_len -= 2;
+        }
+        break;
+
+        case 3:
+        {
+            uint8_t tmp[3];
+
+            tmp[0] = prv_b64Revert(dataP[dataLen - 3]);
+            tmp[1] = prv_b64Revert(dataP[dataLen - 2]);
+            tmp[2] = prv_b64Revert(dataP[dataLen - 1]);
+
+            bufferP[result_index - 3] = (tmp[0] << 2) | (tmp[1] >> 4);
+            bufferP[result_index - 2] = (tmp[1] << 4) | (tmp[2] >> 2);
+            bufferP[result_index - 1] = (tmp[2] << 6);
+            result_len -= 1;
+        }
+        break;
+
+        default:
+            bufferP = NULL;
+            result_len = 0;
+            break;
+    }
+
+    return result_len;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Generic function when a WRITE/EXECUTE command is treated to format the received data
+ *
+ * @return
+ *      - true on success
+ *      - false else
+ */
+//--------------------------------------------------------------------------------------------------
+static bool FormatDataWriteExecute
+(
+    lwm2mcore_ResourceType_t    resourceFormatType,     ///< [IN] Resource format type
+    lwm2m_data_t                dataArray,              ///< [IN] Array of requested resources to be
+                                                        ///< written
+    char*                       bufferPtr,              ///< [IN] Output buffer
+    size_t*                     bufferLenPtr            ///< [IN] Output buffer length
+)
+{
+    bool result = false;
+
+    if ( (NULL == bufferPtr) || (NULL == bufferLenPtr))
+    {
+        return false;
+    }
+
+    // This indicates in which format the server sent a data
+    // According to Wakaama source code (see lwm2m_data_parse API)):
+    // - when a WRITE/EXECUTE command is received on a specific resoure in TEXT format, the type is
+    //   set to LWM2M_TYPE_STRING
+    // - when a WRITE/EXECUTE command is received on a specific resoure in TLV format, the type is
+    //   set to LWM2M_TYPE_OPAQUE
+    // - when a WRITE command is received on a specific object in TLV format, the type is set to
+    //   LWM2M_TYPE_OPAQUE
+    switch (dataArray.type)
+    {
+        case LWM2M_TYPE_STRING:
+        {
+            if (dataArray.value.asBuffer.length <= (*bufferLenPtr))
+            {
+                // Check the resource format
+                switch (resourceFormatType)
+                {
+                    case LWM2MCORE_RESOURCE_TYPE_INT:
+                    case LWM2MCORE_RESOURCE_TYPE_BOOL:
+                    case LWM2MCORE_RESOURCE_TYPE_TIME:
+                    {
+                        // The received data is the integer/boolean value in text
+                        // Time is also a type represented in integer rather than string form
+                        // Example: value 123 is sent like 0x31 32 33
+                        // Change the string in value
+                        int64_t value = 0;
+
+                        // If the length is 0, immediately return the right length value
+                        // else Wakaama utils_textToInt will return an error
+                        if(!(dataArray.value.asBuffer.length))
+                        {
+                            *bufferLenPtr = 0;
+                            return true;
+                        }
+
+                        if (utils_textToInt(dataArray.value.asBuffer.buffer,
+                                            dataArray.value.asBuffer.length,
+                                            &value))
+                        {
+                            // Treat it in buffer for generic handlers treament
+                            *bufferLenPtr = omanager_FormatValueToBytes((uint8_t*) bufferPtr,
+                                                                        &value,
+                                                                        sizeof(value),
+                                                                        false);
+                            result = true;
+                        }
+                    }
+                    break;
+
+                    case LWM2MCORE_RESOURCE_TYPE_OPAQUE:
+                    {
+                        size_t len = 0;
+                        // decode b64
+                        len = base64_decode(dataArray.value.asBuffer.buffer,
+                                            dataArray.value.asBuffer.length,
+                                            (uint8_t*)bufferPtr);
+                        *bufferLenPtr = len;
+                        result = true;
+                    }
+                    break;
+
+                    case LWM2MCORE_RESOURCE_TYPE_FLOAT:
+                    case LWM2MCORE_RESOURCE_TYPE_UNKNOWN:
+                    default:
+                        memcpy(bufferPtr,
+                               dataArray.value.asBuffer.buffer,
+                               dataArray.value.asBuffer.length);
+                        *bufferLenPtr = dataArray.value.asBuffer.length;
+                        result = true;
+                    break;
+                }
+            }
+        }
+        break;
+
+        case LWM2M_TYPE_OPAQUE:
+        {
+            if (dataArray.value.asBuffer.length <= (*bufferLenPtr))
+            {
+                memcpy(bufferPtr, dataArray.value.asBuffer.buffer, dataArray.value.asBuffer.length);
+                *bufferLenPtr = dataArray.value.asBuffer.length;
+                result = true;
+            }
+        }
+        break;
+
+        case LWM2M_TYPE_INTEGER:
+            *bufferLenPtr = omanager_FormatValueToBytes((uint8_t*) bufferPtr,
+                                                        &(dataArray.value.asInteger),
+                                                        sizeof(dataArray.value.asInteger),
+                                                        false);
+            result = true;
+        break;
+
+        case LWM2M_TYPE_FLOAT:
+        case LWM2M_TYPE_BOOLEAN:
+        default:
+            LOG_ARG("Unmanaged type format for WRITE/EXECUTE %d", dataArray.type);
+            *bufferLenPtr = 0;
+        break;
+    }
+
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode a received LWM2M data as a typed value according to the resource type
+ *
+ * @return
+ *      - true on success
+ *      - false else
+ */
+//--------------------------------------------------------------------------------------------------
+static bool DecodeValue
+(
+    lwm2mcore_ResourceType_t    type,           ///< [IN] Resource type
+    lwm2m_data_t*               dataPtr,        ///< [IN] Received LWM2M data
+    char*                       bufPtr,         ///< [IN] Scratch buffer for base64 decoding
+    size_t                      bufSize,        ///< [IN] Scratch buffer size
+    lwm2mcore_Value_t*          valuePtr        ///< [OUT] Decoded value
+)
+{
+    memset(valuePtr, 0, sizeof(lwm2mcore_Value_t));
+
+    // Empty text payload: no value (Wakaama decoding functions would return an error)
+    if (   ((LWM2M_TYPE_STRING == dataPtr->type) || (LWM2M_TYPE_OPAQUE == dataPtr->type))
+        && (!(dataPtr->value.asBuffer.length)))
+    {
+        valuePtr->type = LWM2MCORE_VALUE_NONE;
+        return true;
+    }
+
+    switch (type)
+    {
+        case LWM2MCORE_RESOURCE_TYPE_INT:
+        case LWM2MCORE_RESOURCE_TYPE_TIME:
+            valuePtr->type = LWM2MCORE_VALUE_INT;
+            return (0 != lwm2m_data_decode_int(dataPtr, &(valuePtr->value.asInt)));
+
+        case LWM2MCORE_RESOURCE_TYPE_FLOAT:
+            valuePtr->type = LWM2MCORE_VALUE_FLOAT;
+            return (0 != lwm2m_data_decode_float(dataPtr, &(valuePtr->value.asFloat)));
+
+        case LWM2MCORE_RESOURCE_TYPE_BOOL:
+            valuePtr->type = LWM2MCORE_VALUE_BOOL;
+            return (0 != lwm2m_data_decode_bool(dataPtr, &(valuePtr->value.asBool)));
+
+        case LWM2MCORE_RESOURCE_TYPE_OPAQUE:
+            if (LWM2M_TYPE_STRING == dataPtr->type)
+            {
+                // Opaque data sent in text format is base64 encoded
+                if (dataPtr->value.asBuffer.length > bufSize)
+                {
+                    return false;
+                }
+                valuePtr->type = LWM2MCORE_VALUE_BUFFER;
+                valuePtr->value.asBuffer.bufferPtr = bufPtr;
+                valuePtr->value.asBuffer.len = base64_decode(dataPtr->value.asBuffer.buffer,
+                                                             dataPtr->value.asBuffer.length,
+                                                             (uint8_t*)bufPtr);
+                return true;
+            }
+            // Fall through
+
+        case LWM2MCORE_RESOURCE_TYPE_STRING:
+        case LWM2MCORE_RESOURCE_TYPE_UNKNOWN:
+        default:
+            if (   (LWM2M_TYPE_STRING != dataPtr->type)
+                && (LWM2M_TYPE_OPAQUE != dataPtr->type))
+            {
+                LOG_ARG("Unmanaged type format for WRITE %d", dataPtr->type);
+                return false;
+            }
+            // No copy: the handler gets a view on the received data
+            valuePtr->type = LWM2MCORE_VALUE_BUFFER;
+            valuePtr->value.asBuffer.bufferPtr = (char*)dataPtr->value.asBuffer.buffer;
+            valuePtr->value.asBuffer.len = dataPtr->value.asBuffer.length;
+            return true;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode a received LWM2M data and write it through the typed WRITE handler of a resource
+ *
+ * @return
+ *      - COAP_204_CHANGED if the request is well treated
+ *      - COAP_400_BAD_REQUEST if the data can not be decoded
+ *      - other CoAP error code returned by the handler
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t WriteValue
+(
+    lwm2mcore_Uri_t* uriPtr,                    ///< [IN] Requested operation and object/resource
+    lwm2mcore_internalResource_t* resourcePtr,  ///< [IN] LWM2M resource
+    lwm2m_data_t* dataPtr,                      ///< [IN] Received LWM2M data
+    char* bufPtr,                               ///< [IN] Scratch buffer
+    size_t bufSize                              ///< [IN] Scratch buffer size
+)
+{
+    int sid;
+    lwm2mcore_Value_t value;
+
+    if (!DecodeValue(resourcePtr->type, dataPtr, bufPtr, bufSize, &value))
+    {
+        return COAP_400_BAD_REQUEST;
+    }
+
+    LOG_ARG("WRITE / %d / %d / %d / %d", uriPtr->oid, uriPtr->oiid, uriPtr->rid, uriPtr->riid);
+    sid = resourcePtr->writeValue(uriPtr, &value);
+    LOG_ARG("WRITE sID %d", sid);
+
+    /* Define the CoAP result */
+    return SetCoapError(sid, LWM2MCORE_OP_WRITE);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Generic function when a WRITE command is treated for a specific object (Wakaama)
+ *
+ * @return
+ *      - COAP_404_NOT_FOUND if the object instance or write callback is not registered
+ *      - COAP_500_INTERNAL_SERVER_ERROR in case of error
+ *      - COAP_204_CHANGED if the request is well treated
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t WriteCb
+(
+    uint16_t instanceId,            ///< [IN] Object ID
+    int numData,                    ///< [IN] Number of resources to be written
+    lwm2m_data_t* dataArrayPtr,     ///< [IN] Array of requested resources to be written
+    lwm2m_object_t* objectPtr       ///< [IN] Pointer on object
+)
+{
+    uint8_t result = COAP_400_BAD_REQUEST;
+    int i;
+    bool isMalloc = false;
+    int sid = 0;
+    lwm2mcore_Uri_t uri;
+    lwm2mcore_internalResource_t* resourcePtr = NULL;
+    lwm2mcore_internalObject_t* objPtr;
+    char asyncBuf[LWM2MCORE_BUFFER_MAX_LEN];
+    size_t asyncBufLen = LWM2MCORE_BUFFER_MAX_LEN;
+
+    if ((NULL == objectPtr) || (NULL == dataArrayPtr))
+    {
+        return COAP_500_INTERNAL_SERVER_ERROR;
+    }
+
+    LOG_ARG("WriteCb oid %d oiid %d", objectPtr->objID, instanceId);
+
+    /* Search if the object was registered */
+    if (!LWM2M_LIST_FIND(objectPtr->instanceList, instanceId))
+    {
+        LOG_ARG("Object %d not found", objectPtr->objID);
+        return COAP_404_NOT_FOUND;
+    }
+
+    LOG("object instance Id was registered");
+
+    objPtr = FindObject(Lwm2mcoreCtxPtr, objectPtr->objID);
+    if (!objPtr)
+    {
+        LOG_ARG("Object %d is NOT registered", objectPtr->objID);
+        return COAP_404_NOT_FOUND;
+    }
+
+    memset(&uri, 0, sizeof (lwm2mcore_Uri_t));
+    uri.op = LWM2MCORE_OP_WRITE;
+    uri.oid = objectPtr->objID;
+    uri.oiid = instanceId;
+
+    // Validate the operational state early here, as the code to follow may block
+    if (!ValidStateForOperation(&uri))
+    {
+        LOG("Operation disallowed due to the present state");
+        return COAP_500_INTERNAL_SERVER_ERROR;
+    }
+
+    LOG_ARG("numData %d", numData);
+    // is the server asking for the full object ?
+    if (0 == numData)
+    {
+        int nbRes = 0;
+        isMalloc = true;
+        /* Count the supported resources for the required object */
+        for (resourcePtr = DLIST_FIRST(&(objPtr->resource_list));
+             resourcePtr;
+             resourcePtr = DLIST_NEXT(resourcePtr, list))
+        {
+            nbRes++;
+        }
+
+        /* Temporary array, only used while this request is treated */
+        dataArrayPtr = (lwm2m_data_t*)RequestAlloc(nbRes * sizeof(lwm2m_data_t));
+        if (NULL == dataArrayPtr)
+        {
+            return COAP_500_INTERNAL_SERVER_ERROR;
+        }
+        numData = nbRes;
+
+        i = 0;
+        for (resourcePtr = DLIST_FIRST(&(objPtr->resource_list));
+             resourcePtr;
+             resourcePtr = DLIST_NEXT(resourcePtr, list))
+        {
+            dataArrayPtr[i++].id = resourcePtr->id;
+        }
+    }
+
+    i = 0;
+    do
+    {
+        uri.rid = dataArrayPtr[i].id;
+        memset(asyncBuf, 0, LWM2MCORE_BUFFER_MAX_LEN);
+        asyncBufLen = LWM2MCORE_BUFFER_MAX_LEN;
+
+        /* Search the resource handler */
+        resourcePtr = FindResource(Lwm2mcoreCtxPtr, objPtr, uri.rid);
+        if (!resourcePtr)
+        {
+            LOG("resource NULL");
+            if (isMalloc)
+            {
+                RequestFree(dataArrayPtr);
+            }
+            return COAP_404_NOT_FOUND;
+        }
+
+        if ((!(resourcePtr->write)) && (!(resourcePtr->writeValue)))
+        {
+            LOG("WRITE callback NULL");
+             if (isMalloc)
+            {
+                RequestFree(dataArrayPtr);
+            }
+            return COAP_405_METHOD_NOT_ALLOWED;
+        }
+
+        /* The written value supersedes the cached one */
+        InvalidateCache(resourcePtr, uri.oiid);
+
+        LOG_ARG("data type %d resourcePtr->ptr %d", dataArrayPtr[i].type, resourcePtr->type);
+        if (   (LWM2M_TYPE_MULTIPLE_RESOURCE != dataArrayPtr[i].type)
+            && (NULL != resourcePtr->writeValue))
+        {
+            result = WriteValue(&uri, resourcePtr, &dataArrayPtr[i], asyncBuf, asyncBufLen);
+        }
+        else if (LWM2M_TYPE_MULTIPLE_RESOURCE != dataArrayPtr[i].type)
+        {
+            if (FormatDataWriteExecute(resourcePtr->type,
+                                       dataArrayPtr[i],
+                                       asyncBuf,
+                                       &asyncBufLen))
+            {
+                LOG_ARG("WRITE / %d / %d / %d", uri.oid, uri.oiid, uri.rid);
+                sid = resourcePtr->write(&uri, asyncBuf, asyncBufLen);
+                LOG_ARG("WRITE sID %d", sid);
+                /* Define the CoAP result */
+                result = SetCoapError(sid, LWM2MCORE_OP_WRITE);
+            }
+            else
+            {
+                result = COAP_400_BAD_REQUEST;
+            }
+        }
+        else
+        {
+            uint32_t count = (uint32_t)dataArrayPtr[i].value.asChildren.count;
+            uint32_t loop;
+
+            for (loop = 0; loop < count; loop++)
+            {
+                if (NULL != resourcePtr->writeValue)
+                {
+                    uri.riid = dataArrayPtr[i].value.asChildren.array[loop].id;
+                    result = WriteValue(&uri,
+                                        resourcePtr,
+                                        &(dataArrayPtr[i].value.asChildren.array[loop]),
+                                        asyncBuf,
+                                        asyncBufLen);
+                }
+                else if (FormatDataWriteExecute(resourcePtr->type,
+                                           dataArrayPtr[i].value.asChildren.array[loop],
+                                           asyncBuf,
+                                           &asyncBufLen))
+                {
+                    uri.riid = dataArrayPtr[i].value.asChildren.array[loop].id;
+                    LOG_ARG("WRITE / %d / %d / %d / %d", uri.oid, uri.oiid, uri.rid, uri.riid);
+                    sid = resourcePtr->write(&uri, asyncBuf, asyncBufLen);
+                    LOG_ARG("WRITE sID %d", sid);
+                    /* Define the CoAP result */
+                    result = SetCoapError(sid, LWM2MCORE_OP_WRITE);
+                }
+                else
+                {
+                    result = COAP_400_BAD_REQUEST;
+                }
+            }
+        }
+        i++;
+    } while ((i < numData) && ((COAP_204_CHANGED == result) || (COAP_NO_ERROR == result)));
+
+    LOG_ARG("WriteCb result %d", result);
+
+    if (isMalloc)
+    {
+        RequestFree(dataArrayPtr);
+    }
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete an object instance in the Wakaama format
+ *
+ * @return
+ *      - COAP_404_NOT_FOUND if the object instance does not exist
+ *      - COAP_500_INTERNAL_SERVER_ERROR in case of error
+ *      - COAP_202_DELETED if the request is well treated
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t DeleteObjInstance
+(
+    uint16_t id,                    ///< [IN] Object instance ID
+    lwm2m_object_t* objectPtr       ///< [IN] Pointer on object
+)
+{
+    lwm2m_list_t* instancePtr;
+
+    if (NULL == objectPtr)
+    {
+        return COAP_500_INTERNAL_SERVER_ERROR;
+    }
+
+    objectPtr->instanceList = lwm2m_list_remove(objectPtr->instanceList,
+                                                id,
+                                                (lwm2m_list_t **)&instancePtr);
+    if (NULL == instancePtr)
+    {
+        return COAP_404_NOT_FOUND;
+    }
+
+    lwm2m_free(instancePtr);
+
+    return COAP_202_DELETED;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Generic function when a CREATE command is treated for a specific object (Wakaama)
+ *
+ * @return
+ *      - COAP_400_BAD_REQUEST if the object instance already exists
+ *      - COAP_500_INTERNAL_SERVER_ERROR in case of error
+ *      - COAP_201_CREATED if the request is well treated
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t CreateCb
+(
+    uint16_t instanceId,            ///< [IN] Object ID
+    int numData,                    ///< [IN] Number of resources to be written
+    lwm2m_data_t* dataArrayPtr,     ///< [IN] Array of requested resources to be written
+    lwm2m_object_t* objectPtr       ///< [IN] Pointer on object
+)
+{
+    uint8_t result;
+
+    if ((NULL == objectPtr) || (NULL == dataArrayPtr))
+    {
+        return COAP_500_INTERNAL_SERVER_ERROR;
+    }
+
+    LOG_ARG("CreateCb oid %d oiid %d", objectPtr->objID, instanceId);
+
+    if (LWM2MCORE_SOFTWARE_UPDATE_OID == objectPtr->objID)
+    {
+        if (LWM2MCORE_ERR_COMPLETED_OK != lwm2mcore_SoftwareUpdateInstance(true, instanceId))
+        {
+            LOG("Error from client to create object instance");
+            return COAP_500_INTERNAL_SERVER_ERROR;
+        }
+    }
+
+    if (NULL == objectPtr->instanceList)
+    {
+        LOG("objectPtr->instanceList == NULL");
+        objectPtr->instanceList = (lwm2m_list_t *)lwm2m_malloc(sizeof(lwm2m_list_t));
+        if (NULL != objectPtr->instanceList)
+        {
+            memset(objectPtr->instanceList, 0, sizeof(lwm2m_list_t));
+        }
+    }
+    /* Search if the object was registered */
+    else if (LWM2M_LIST_FIND(objectPtr->instanceList, instanceId) == NULL)
+    {
+        lwm2m_list_t* instancePtr;
+        /* Add the object instance in the Wakaama format */
+        instancePtr = (lwm2m_list_t *)lwm2m_malloc(sizeof(lwm2m_list_t));
+        if (!instancePtr)
+        {
+           LOG("instancePtr is NULL");
+           return COAP_500_INTERNAL_SERVER_ERROR;
+        }
+        instancePtr->id = instanceId;
+        objectPtr->instanceList = LWM2M_LIST_ADD(objectPtr->instanceList, instancePtr);
+        /* instancePtr is released by omanager_ObjectsFree API */
+    }
+    else
+    {
+        LOG("Object instance already exists");
+        return COAP_400_BAD_REQUEST;
+    }
+
+    if (COAP_204_CHANGED != WriteCb(instanceId, numData, dataArrayPtr, objectPtr))
+    {
+        LOG_ARG("CreateCb --> delete oiid %d", instanceId);
+        DeleteObjInstance(instanceId, objectPtr);
+        result = COAP_500_INTERNAL_SERVER_ERROR;
+    }
+    else
+    {
+        result = COAP_201_CREATED;
+    }
+
+    LOG_ARG("CreateCb result %d", result);
+
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Generic function when a DELETE command is treated for a specific object (Wakaama)
+ *
+ * @return
+ *      - COAP_400_BAD_REQUEST if the object instance does not exist
+ *      - COAP_500_INTERNAL_SERVER_ERROR in case of error
+ *      - COAP_202_DELETED if the request is well treated
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t DeleteCb
+(
+    uint16_t instanceId,            ///< [IN] Object instance ID
+    lwm2m_object_t* objectPtr       ///< [IN] Pointer on object
+)
+{
+    uint8_t result;
+    bool isDeviceManagement = false;
+    lwm2m_list_t* instancePtr;
+
+    if ((NULL == objectPtr) || (NULL == objectPtr->userData))
+    {
+        return COAP_500_INTERNAL_SERVER_ERROR;
+    }
+
+    LOG_ARG("DeleteCb oid %d oiid %d", objectPtr->objID, instanceId);
+
+    /* Check the session
+     * If the device is connected to the bootstrap server, only accept DELETE command on
+     * Security object (object 0)
+     */
+    if (true == lwm2mcore_ConnectionGetType(objectPtr->userData, &isDeviceManagement))
+    {
+        if ((false == isDeviceManagement)
+        && (LWM2MCORE_SECURITY_OID != objectPtr->objID))
+        {
+            LOG("DeleteCb return COAP_405_METHOD_NOT_ALLOWED");
+            return COAP_405_METHOD_NOT_ALLOWED;
+        }
+    }
+    else
+    {
+        LOG("error on Get type");
+        return COAP_500_INTERNAL_SERVER_ERROR;
+    }
+
+    if (LWM2MCORE_SOFTWARE_UPDATE_OID == objectPtr->objID)
+    {
+        if (LWM2MCORE_ERR_COMPLETED_OK != lwm2mcore_SoftwareUpdateInstance(false, instanceId))
+        {
+            LOG("Error from client to delete object instance");
+            return COAP_500_INTERNAL_SERVER_ERROR;
+        }
+    }
+
+    /* Search if the object instance was registered */
+    instancePtr = LWM2M_LIST_FIND(objectPtr->instanceList, instanceId);
+
+    if (NULL != instancePtr)
+    {
+        if (LWM2MCORE_ACL_OID == (objectPtr->objID))
+        {
+            omanager_RemoveAclObjectInstance(instanceId);
+            lwm2m_acl_deleteObjectInstance(objectPtr, instanceId);
+            omanager_StoreAclConfiguration();
+            result = COAP_202_DELETED;
+        }
+        else
+        {
+            lwm2m_client_t* clientP;
+            /* Delete the object instance in the Wakaama format */
+            objectPtr->instanceList = LWM2M_LIST_RM(objectPtr->instanceList, instanceId, &clientP);
+            lwm2m_free(instancePtr);
+
+            if (LWM2MCORE_SOFTWARE_UPDATE_OID == objectPtr->objID)
+            {
+                LOG_ARG("Remove oiid %d from SwApplicationListPtr", instanceId);
+                instancePtr = (lwm2m_list_t*)LWM2M_LIST_FIND(SwApplicationListPtr, instanceId);
+
+                if (NULL != instancePtr)
+                {
+                    ObjectInstanceList_t* appPtr;
+                    SwApplicationListPtr = (ObjectInstanceList_t*)LWM2M_LIST_RM(SwApplicationListPtr,
+                                                                               instanceId,
+                                                                               &appPtr);
+                    lwm2m_free(instancePtr);
+                }
+                result = COAP_202_DELETED;
+            }
+#ifdef LWM2M_OBJECT_33406
+            else if (LWM2MCORE_FILE_LIST_OID == objectPtr->objID)
+            {
+                lwm2mcore_Sid_t sID;
+                sID = lwm2mcore_DeleteFileByInstance(instanceId);
+                switch (sID)
+                {
+                    case LWM2MCORE_ERR_COMPLETED_OK:
+                        result = COAP_202_DELETED;
+                        break;
+
+                    case LWM2MCORE_ERR_INVALID_ARG:
+                        result = COAP_404_NOT_FOUND;
+                        break;
+
+                    default:
+                        result = COAP_400_BAD_REQUEST;
+                        break;
+                }
+
+            }
+#endif
+            else
+            {
+                result = COAP_202_DELETED;
+            }
+        }
+    }
+    else
+    {
+        LOG("Object instance does not exist");
+        result = COAP_400_BAD_REQUEST;
+    }
+    LOG_ARG("DeleteCb result %d", result);
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Generic function when a DISCOVER command is treated for a specific object (Wakaama)
+ *
+ * @return
+ *      - 0
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t DiscoverCb
+(
+    uint16_t instanceId,            ///< [IN] Object ID
+    int* numDataPtr,                ///< [INOUT] Number of resources which were read
+    lwm2m_data_t ** dataArrayPtr,   ///< [IN] Array of requested resources to be discovered
+    lwm2m_object_t* objectPtr       ///< [IN] Pointer on object
+)
+{
+    (void)instanceId;
+    (void)numDataPtr;
+
+    if ((NULL == objectPtr) || (NULL == dataArrayPtr))
+    {
+        return COAP_500_INTERNAL_SERVER_ERROR;
+    }
+    return 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Generic function when a EXECUTE command is treated for a specific object (Wakaama)
+ *
+ * @return
+ *      - COAP_404_NOT_FOUND if the object / object instance / resource instance does not exist
+ *      - COAP_500_INTERNAL_SERVER_ERROR in case of error
+ *      - COAP_204_CHANGED if the request is well treated
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t ExecuteCb
+(
+    uint16_t instanceId,            ///< [IN] Object ID
+    uint16_t resourceId,            ///< [IN] Resource ID
+    uint8_t* bufferPtr,             ///< [IN] Data provided in the EXECUTE command
+    int length,                     ///< [IN] Data length
+    lwm2m_object_t* objectPtr       ///< [IN] Pointer on object
+)
+{
+    uint8_t result;
+
+    if ((NULL == objectPtr) || ((NULL == bufferPtr) && length))
+    {
+        return COAP_500_INTERNAL_SERVER_ERROR;
+    }
+
+    LOG_ARG("ExecuteCb oid %d oiid %d rid %d", objectPtr->objID, instanceId, resourceId);
+
+    /* Search if the object was registered */
+    if (LWM2M_LIST_FIND(objectPtr->instanceList, instanceId))
+    {
+        lwm2mcore_internalObject_t* objPtr;
+        LOG("object instance Id was registered");
+
+        objPtr = FindObject(Lwm2mcoreCtxPtr, objectPtr->objID);
+        if (NULL == objPtr)
+        {
+            LOG_ARG("Object %d is NOT registered", objectPtr->objID);
+            result = COAP_404_NOT_FOUND;
+        }
+        else
+        {
+            int sid = 0;
+            lwm2mcore_internalResource_t* resourcePtr = NULL;
+            char asyncBuf[LWM2MCORE_BUFFER_MAX_LEN];
+            size_t asyncBufLen = LWM2MCORE_BUFFER_MAX_LEN;
+            lwm2mcore_Uri_t uri;
+            memset(&uri, 0, sizeof (lwm2mcore_Uri_t));
+            uri.op = LWM2MCORE_OP_EXECUTE;
+            uri.oid = objectPtr->objID;
+            uri.oiid = instanceId;
+            uri.rid = resourceId;
+
+            // Validate the operational state early here, as the code to follow may block
+            if (!ValidStateForOperation(&uri))
+            {
+                LOG("Operation disallowed due to the present state");
+                return COAP_500_INTERNAL_SERVER_ERROR;
+            }
+
+            /* Search the resource handler */
+            resourcePtr = FindResource(Lwm2mcoreCtxPtr, objPtr, uri.rid);
+            if (NULL != resourcePtr)
+            {
+                if (NULL != resourcePtr->exec)
+                {
+                    lwm2m_data_t dataArray;
+                    dataArray.type = LWM2M_TYPE_STRING;
+                    dataArray.value.asBuffer.length = (size_t)length;
+                    dataArray.value.asBuffer.buffer = bufferPtr;
+                    memset(asyncBuf, 0, asyncBufLen);
+
+                    LOG_ARG("data type %d resourcePtr->type %d", dataArray.type, resourcePtr->type);
+                    if (FormatDataWriteExecute(resourcePtr->type,
+                                               dataArray,
+                                               asyncBuf,
+                                               &asyncBufLen))
+                    {
+                        LOG_ARG("EXECUTE / %d / %d / %d", uri.oid, uri.oiid, uri.rid);
+                        sid  = resourcePtr->exec(&uri, asyncBuf, asyncBufLen);
+                        LOG_ARG("EXECUTE sID %d", sid);
+                        /* Define the CoAP result */
+                        result = SetCoapError(sid, LWM2MCORE_OP_EXECUTE);
+                    }
+                    else
+                    {
+                        result = COAP_400_BAD_REQUEST;
+                    }
+                }
+                else
+                {
+                    LOG("EXECUTE callback NULL");
+                    result = COAP_405_METHOD_NOT_ALLOWED;
+                }
+            }
+            else
+            {
+                LOG("resource NULL");
+                result = COAP_404_NOT_FOUND;
+            }
+        }
+    }
+    else
+    {
+        LOG_ARG("Object %d not found", objectPtr->objID);
+        result = COAP_404_NOT_FOUND;
+    }
+    LOG_ARG("ExecuteCb result %d", result);
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if a CoAP result reports a success (no error or 2.xx code)
+ *
+ * @return
+ *      - true if the request succeeded
+ *      - false otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsCoapSuccess
+(
+    uint8_t result                  ///< [IN] CoAP result
+)
+{
+    return (COAP_400_BAD_REQUEST > result);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * READ callback registered in Wakaama: measure the latency of ReadCb
+ *
+ * @return
+ *      - see ReadCb
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t MeasuredReadCb
+(
+    uint16_t instanceId,            ///< [IN] Object ID
+    int* numDataPtr,                ///< [IN] Number of resources to be read
+    lwm2m_data_t** dataArrayPtr,    ///< [IN] Array of requested resources to be read
+    lwm2m_object_t* objectPtr       ///< [IN] Pointer on object
+)
+{
+    uint64_t startMs = lwm2mcore_TimerGetTimeMs();
+    uint8_t result = ReadCb(instanceId, numDataPtr, dataArrayPtr, objectPtr);
+
+    // The security object is only read by the DTLS layer, not by the servers
+    if ((NULL != objectPtr) && (LWM2MCORE_SECURITY_OID != objectPtr->objID))
+    {
+        perfMetrics_Record(LWM2MCORE_METRIC_READ, startMs, IsCoapSuccess(result));
+    }
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * WRITE callback registered in Wakaama: measure the latency of WriteCb
+ *
+ * @return
+ *      - see WriteCb
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t MeasuredWriteCb
+(
+    uint16_t instanceId,            ///< [IN] Object ID
+    int numData,                    ///< [IN] Number of resources to be written
+    lwm2m_data_t* dataArrayPtr,     ///< [IN] Array of requested resources to be written
+    lwm2m_object_t* objectPtr       ///< [IN] Pointer on object
+)
+{
+    uint64_t startMs = lwm2mcore_TimerGetTimeMs();
+    uint8_t result = WriteCb(instanceId, numData, dataArrayPtr, objectPtr);
+
+    perfMetrics_Record(LWM2MCORE_METRIC_WRITE, startMs, IsCoapSuccess(result));
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * DISCOVER callback registered in Wakaama: measure the latency of DiscoverCb
+ *
+ * @return
+ *      - see DiscoverCb
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t MeasuredDiscoverCb
+(
+    uint16_t instanceId,            ///< [IN] Object ID
+    int* numDataPtr,                ///< [INOUT] Number of resources which were read
+    lwm2m_data_t ** dataArrayPtr,   ///< [IN] Array of requested resources to be discovered
+    lwm2m_object_t* objectPtr       ///< [IN] Pointer on object
+)
+{
+    uint64_t startMs = lwm2mcore_TimerGetTimeMs();
+    uint8_t result = DiscoverCb(instanceId, numDataPtr, dataArrayPtr, objectPtr);
+
+    perfMetrics_Record(LWM2MCORE_METRIC_DISCOVER, startMs, IsCoapSuccess(result));
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * EXECUTE callback registered in Wakaama: measure the latency of ExecuteCb
+ *
+ * @return
+ *      - see ExecuteCb
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t MeasuredExecuteCb
+(
+    uint16_t instanceId,            ///< [IN] Object ID
+    uint16_t resourceId,            ///< [IN] Resource ID
+    uint8_t* bufferPtr,             ///< [IN] Data provided in the EXECUTE command
+    int length,                     ///< [IN] Data length
+    lwm2m_object_t* objectPtr       ///< [IN] Pointer on object
+)
+{
+    uint64_t startMs = lwm2mcore_TimerGetTimeMs();
+    uint8_t result = ExecuteCb(instanceId, resourceId, bufferPtr, length, objectPtr);
+
+    perfMetrics_Record(LWM2MCORE_METRIC_EXECUTE, startMs, IsCoapSuccess(result));
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the supported object list for LWM2M Core
+ *
+ * @return
+ *      - NULL in case of error
+ *      - object list else
+ */
+//--------------------------------------------------------------------------------------------------
+static struct _lwm2mcore_objectsList* GetObjectsList
+(
+    void
+)
+{
+    if (NULL != Lwm2mcoreCtxPtr)
+    {
+        return &(Lwm2mcoreCtxPtr->objects_list);
+    }
+    else
+    {
+        return NULL;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize LwM2M object
+ *
+ * @return
+ *      - object pointer
+ */
+//--------------------------------------------------------------------------------------------------
+static lwm2mcore_internalObject_t* InitObject
+(
+    lwm2mcore_Object_t* client_objPtr,  ///< [IN] pointer to object passed from client
+    uint16_t iid,                       ///< [IN] object instance ID
+    bool multiple                       ///< [IN] if this is single or multiple instance object
+)
+{
+    int j;
+    lwm2mcore_internalObject_t* objPtr = NULL;
+    lwm2mcore_internalResource_t* resourcePtr = NULL;
+    lwm2mcore_Resource_t *client_resourcePtr = NULL;
+
+    if (NULL == client_objPtr)
+    {
+        return NULL;
+    }
+
+    LOG_ARG("InitObject /%d/%d, multiple %d", client_objPtr->id, iid, multiple);
+
+    objPtr = (lwm2mcore_internalObject_t*)lwm2m_malloc(sizeof (lwm2mcore_internalObject_t));
+
+    LWM2MCORE_ASSERT(objPtr);
+
+    memset(objPtr, 0, sizeof (lwm2mcore_internalObject_t));
+
+    objPtr->multiple = multiple;
+    objPtr->id = client_objPtr->id;
+    objPtr->iid = iid;
+    objPtr->snapshot = client_objPtr->snapshot;
+    memset(&(objPtr->attr), 0, sizeof (lwm2m_attribute_t));
+
+    /* Object's create and delete handlers should be invoked by the LWM2M client
+     * itself. Once the operation is completed, the client shall call avcm_create_lwm2m_object
+     * or avcm_delete_lwm2m_object accordingly */
+    client_resourcePtr = client_objPtr->resources;
+
+    LOG_ARG("InitObject client_obj->resCnt %d", client_objPtr->resCnt);
+
+    DLIST_INIT(&(objPtr->resource_list));
+
+    if ((LWM2MCORE_SOFTWARE_UPDATE_OID == client_objPtr->id)
+     && (LWM2MCORE_ID_NONE == iid))
+    {
+        /* Object 9 without any object instance
+         * Get information from host
+         */
+        LOG("Object 9 without any object instance");
+
+    }
+
+    for (j = 0; j < client_objPtr->resCnt; j++)
+    {
+        resourcePtr =
+                (lwm2mcore_internalResource_t*)lwm2m_malloc(sizeof(lwm2mcore_internalResource_t));
+
+        LWM2MCORE_ASSERT(resourcePtr);
+        memset(resourcePtr, 0, sizeof(lwm2mcore_internalResource_t));
+
+        resourcePtr->id = (client_resourcePtr + j)->id;
+        resourcePtr->iid = 0;
+        resourcePtr->type = (client_resourcePtr + j)->type;
+        resourcePtr->maxInstCount = (client_resourcePtr + j)->maxResInstCnt;
+        memset(&resourcePtr->attr, 0, sizeof(lwm2m_attribute_t));
+        resourcePtr->read = (client_resourcePtr + j)->read;
+        resourcePtr->write = (client_resourcePtr + j)->write;
+        resourcePtr->exec = (client_resourcePtr + j)->exec;
+        resourcePtr->readValue = (client_resourcePtr + j)->readValue;
+        resourcePtr->writeValue = (client_resourcePtr + j)->writeValue;
+        resourcePtr->readChunk = (client_resourcePtr + j)->readChunk;
+        resourcePtr->cacheTtl = (client_resourcePtr + j)->cacheTtl;
+        resourcePtr->tableResourcePtr = client_resourcePtr + j;
+        DLIST_INSERT_TAIL(&(objPtr->resource_list), resourcePtr, list);
+    }
+
+    return objPtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize supported objects/resources based on handler data.
+ */
+//--------------------------------------------------------------------------------------------------
+static void InitObjectsList
+(
+    struct _lwm2mcore_objectsList* objects_list ,   ///< [IN] Object list
+    lwm2mcore_Handler_t* clientHandlerPtr           ///< [IN] Object and resource table which are
+                                                    ///<      supported by the client
+)
+{
+    int i, j;
+    lwm2mcore_internalObject_t* objPtr = NULL;
+
+    if ((NULL == objects_list) || (NULL == clientHandlerPtr))
+    {
+        return;
+    }
+
+    LOG_ARG("objCnt %d", clientHandlerPtr->objCnt);
+
+    for (i = 0; i < clientHandlerPtr->objCnt; i++)
+    {
+        if (LWM2MCORE_ID_NONE == (clientHandlerPtr->objects + i)->maxObjInstCnt)
+        {
+            /* Unknown object instance count is always assumed to be multiple */
+            objPtr = InitObject(clientHandlerPtr->objects + i, LWM2MCORE_ID_NONE, true);
+            if (!objPtr)
+            {
+               LOG("objPtr is NULL");
+               return;
+            }
+            DLIST_INSERT_TAIL(objects_list, objPtr, list);
+        }
+        else if ((clientHandlerPtr->objects + i)->maxObjInstCnt > 1)
+        {
+            for (j = 0; j < (clientHandlerPtr->objects + i)->maxObjInstCnt; j++)
+            {
+                objPtr = InitObject(clientHandlerPtr->objects + i, j, true);
+                if (!objPtr)
+                {
+                   LOG("objPtr is NULL");
+                   return;
+                }
+                DLIST_INSERT_TAIL(objects_list, objPtr, list);
+            }
+        }
+        else if (LWM2M_SERVER_OBJECT_ID == (clientHandlerPtr->objects + i)->id)
+        {
+            /* the maxObjInstCnt is 1 for this object, but this is actually multiple instance */
+            objPtr = InitObject(clientHandlerPtr->objects + i, 0, true);
+            if (!objPtr)
+            {
+               LOG("objPtr is NULL");
+               return;
+            }
+            DLIST_INSERT_TAIL(objects_list, objPtr, list);
+        }
+        else
+        {
+            objPtr = InitObject(clientHandlerPtr->objects + i, 0, false);
+            if (!objPtr)
+            {
+               LOG("objPtr is NULL");
+               return;
+            }
+            DLIST_INSERT_TAIL(objects_list, objPtr, list);
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Invalidate the cached read value of a resource
+ */
+//--------------------------------------------------------------------------------------------------
+void omanager_InvalidateResourceCache
+(
+    uint16_t oid,       ///< [IN] Object Id
+    uint16_t oiid,      ///< [IN] Object instance Id
+    uint16_t rid        ///< [IN] Resource Id
+)
+{
+    lwm2mcore_internalObject_t* objPtr;
+    lwm2mcore_internalResource_t* resourcePtr;
 
-    if (COAP_204_CHANGED != WriteCb(instanceId, numData, dataArrayPtr, objectPtr))
+    objPtr = FindObject(Lwm2mcoreCtxPtr, oid);
+    if (NULL == objPtr)
     {
-        LOG_ARG("CreateCb --> delete oiid %d", instanceId);
-        DeleteObjInstance(instanceId, objectPtr);
-        result = COAP_500_INTERNAL_SERVER_ERROR;
+        return;
     }
-    else
+
+    resourcePtr = FindResource(Lwm2mcoreCtxPtr, objPtr, rid);
+    if (NULL != resourcePtr)
     {
-        result = COAP_201_CREATED;
+        InvalidateCache(resourcePtr, oiid);
     }
+}
 
-    LOG_ARG("CreateCb result %d", result);
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute a hash (FNV-1a) of a string/opaque value
+ *
+ * @return
+ *      - Hash value
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t HashValue
+(
+    const char* bufPtr,     ///< [IN] Value
+    size_t len              ///< [IN] Value length
+)
+{
+    uint32_t hash = 2166136261u;
+    size_t i;
 
-    return result;
+    for (i = 0; i < len; i++)
+    {
+        hash ^= (uint8_t)bufPtr[i];
+        hash *= 16777619u;
+    }
+    return hash;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Generic function when a DELETE command is treated for a specific object (Wakaama)
+ * Read the current value of a resource in order to compare it to the last notified one
  *
  * @return
- *      - COAP_400_BAD_REQUEST if the object instance does not exist
- *      - COAP_500_INTERNAL_SERVER_ERROR in case of error
- *      - COAP_202_DELETED if the request is well treated
+ *      - true if the value was read
+ *      - false if the resource value can not be compared (multi-instance, chunked, read error)
  */
 //--------------------------------------------------------------------------------------------------
-static uint8_t DeleteCb
+static bool ReadNotifyValue
 (
-    uint16_t instanceId,            ///< [IN] Object instance ID
-    lwm2m_object_t* objectPtr       ///< [IN] Pointer on object
+    uint16_t oid,                               ///< [IN] Object Id
+    uint16_t oiid,                              ///< [IN] Object instance Id
+    lwm2mcore_internalResource_t* resourcePtr,  ///< [IN] LWM2M resource
+    bool* isNumericPtr,                         ///< [OUT] Set for a numeric value
+    double* valuePtr,                           ///< [OUT] Numeric value
+    uint32_t* hashPtr                           ///< [OUT] Hash of a string/opaque value
 )
 {
-    uint8_t result;
-    bool isDeviceManagement = false;
-    lwm2m_list_t* instancePtr;
+    lwm2mcore_Uri_t uri;
+    lwm2mcore_Value_t value;
+    char buf[LWM2MCORE_BUFFER_MAX_LEN];
+    size_t len = sizeof(buf);
+    const char* dataPtr = buf;
 
-    if ((NULL == objectPtr) || (NULL == objectPtr->userData))
+    if (   (1 < resourcePtr->maxInstCount)
+        || ((NULL == resourcePtr->read) && (NULL == resourcePtr->readValue)))
     {
-        return COAP_500_INTERNAL_SERVER_ERROR;
+        return false;
     }
 
-    LOG_ARG("DeleteCb oid %d oiid %d", objectPtr->objID, instanceId);
+    memset(&uri, 0, sizeof(uri));
+    uri.op = LWM2MCORE_OP_READ;
+    uri.oid = oid;
+    uri.oiid = oiid;
+    uri.rid = resourcePtr->id;
 
-    /* Check the session
-     * If the device is connected to the bootstrap server, only accept DELETE command on
-     * Security object (object 0)
-     */
-    if (true == lwm2mcore_ConnectionGetType(objectPtr->userData, &isDeviceManagement))
+    *isNumericPtr = true;
+
+    if (NULL != resourcePtr->readValue)
     {
-        if ((false == isDeviceManagement)
-        && (LWM2MCORE_SECURITY_OID != objectPtr->objID))
+        memset(&value, 0, sizeof(value));
+        value.type = LWM2MCORE_VALUE_NONE;
+        value.value.asBuffer.bufferPtr = buf;
+        value.value.asBuffer.len = len;
+
+        if (LWM2MCORE_ERR_COMPLETED_OK != resourcePtr->readValue(&uri, &value))
         {
-            LOG("DeleteCb return COAP_405_METHOD_NOT_ALLOWED");
-            return COAP_405_METHOD_NOT_ALLOWED;
+            return false;
         }
-    }
-    else
-    {
-        LOG("error on Get type");
-        return COAP_500_INTERNAL_SERVER_ERROR;
-    }
 
-    if (LWM2MCORE_SOFTWARE_UPDATE_OID == objectPtr->objID)
-    {
-        if (LWM2MCORE_ERR_COMPLETED_OK != lwm2mcore_SoftwareUpdateInstance(false, instanceId))
+        switch (value.type)
         {
-            LOG("Error from client to delete object instance");
-            return COAP_500_INTERNAL_SERVER_ERROR;
-        }
-    }
+            case LWM2MCORE_VALUE_INT:
+                *valuePtr = (double)value.value.asInt;
+                return true;
 
-    /* Search if the object instance was registered */
-    instancePtr = LWM2M_LIST_FIND(objectPtr->instanceList, instanceId);
+            case LWM2MCORE_VALUE_FLOAT:
+                *valuePtr = value.value.asFloat;
+                return true;
 
-    if (NULL != instancePtr)
+            case LWM2MCORE_VALUE_BOOL:
+                *valuePtr = value.value.asBool ? 1 : 0;
+                return true;
+
+            case LWM2MCORE_VALUE_BUFFER:
+                dataPtr = value.value.asBuffer.bufferPtr;
+                len = value.value.asBuffer.len;
+                break;
+
+            case LWM2MCORE_VALUE_NONE:
+            default:
+                return false;
+        }
+    }
+    else
     {
-        if (LWM2MCORE_ACL_OID == (objectPtr->objID))
+        if (LWM2MCORE_ERR_COMPLETED_OK != resourcePtr->read(&uri, buf, &len, NULL))
         {
-            omanager_RemoveAclObjectInstance(instanceId);
-            lwm2m_acl_deleteObjectInstance(objectPtr, instanceId);
-            omanager_StoreAclConfiguration();
-            result = COAP_202_DELETED;
+            return false;
         }
-        else
+
+        switch (resourcePtr->type)
         {
-            lwm2m_client_t* clientP;
-            /* Delete the object instance in the Wakaama format */
-            objectPtr->instanceList = LWM2M_LIST_RM(objectPtr->instanceList, instanceId, &clientP);
-            lwm2m_free(instancePtr);
+            case LWM2MCORE_RESOURCE_TYPE_INT:
+            case LWM2MCORE_RESOURCE_TYPE_TIME:
+                *valuePtr = (double)omanager_BytesToInt(buf, len);
+                return true;
 
-            if (LWM2MCORE_SOFTWARE_UPDATE_OID == objectPtr->objID)
-            {
-                LOG_ARG("Remove oiid %d from SwApplicationListPtr", instanceId);
-                instancePtr = (lwm2m_list_t*)LWM2M_LIST_FIND(SwApplicationListPtr, instanceId);
+            case LWM2MCORE_RESOURCE_TYPE_BOOL:
+                *valuePtr = buf[0] ? 1 : 0;
+                return true;
 
-                if (NULL != instancePtr)
+            case LWM2MCORE_RESOURCE_TYPE_FLOAT:
+                if (len < sizeof(buf))
                 {
-                    ObjectInstanceList_t* appPtr;
-                    SwApplicationListPtr = (ObjectInstanceList_t*)LWM2M_LIST_RM(SwApplicationListPtr,
-                                                                               instanceId,
-                                                                               &appPtr);
-                    lwm2m_free(instancePtr);
-                }
-                result = COAP_202_DELETED;
-            }
-#ifdef LWM2M_OBJECT_33406
-            else if (LWM2MCORE_FILE_LIST_OID == objectPtr->objID)
-            {
-                lwm2mcore_Sid_t sID;
-                sID = lwm2mcore_DeleteFileByInstance(instanceId);
-                switch (sID)
-                {
-                    case LWM2MCORE_ERR_COMPLETED_OK:
-                        result = COAP_202_DELETED;
-                        break;
-
-                    case LWM2MCORE_ERR_INVALID_ARG:
-                        result = COAP_404_NOT_FOUND;
-                        break;
-
-                    default:
-                        result = COAP_400_BAD_REQUEST;
-                        break;
+                    buf[len] = '\0';
+                    *valuePtr = atof(buf);
+                    return true;
                 }
+                break;
 
-            }
-#endif
-            else
-            {
-                result = COAP_202_DELETED;
-            }
+            default:
+                break;
         }
     }
-    else
-    {
-        LOG("Object instance does not exist");
-        result = COAP_400_BAD_REQUEST;
-    }
-    LOG_ARG("DeleteCb result %d", result);
-    return result;
+
+    *isNumericPtr = false;
+    *hashPtr = HashValue(dataPtr, len);
+    return true;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Generic function when a DISCOVER command is treated for a specific object (Wakaama)
+ * Check if a numeric value change reaches the threshold and step attributes
  *
  * @return
- *      - 0
+ *      - true if no threshold/step attribute is set or if one of them is reached
+ *      - false otherwise
  */
 //--------------------------------------------------------------------------------------------------
-static uint8_t DiscoverCb
+static bool IsThresholdReached
 (
-    uint16_t instanceId,            ///< [IN] Object ID
-    int* numDataPtr,                ///< [INOUT] Number of resources which were read
-    lwm2m_data_t ** dataArrayPtr,   ///< [IN] Array of requested resources to be discovered
-    lwm2m_object_t* objectPtr       ///< [IN] Pointer on object
+    const lwm2m_attribute_t* attrPtr,   ///< [IN] Observe attributes
+    double lastValue,                   ///< [IN] Last notified value
+    double value                        ///< [IN] Current value
 )
 {
-    (void)instanceId;
-    (void)numDataPtr;
+    double delta;
 
-    if ((NULL == objectPtr) || (NULL == dataArrayPtr))
+    if (0 == (attrPtr->mask & (  LWM2M_ATTR_FLAG_GREATER_THAN
+                               | LWM2M_ATTR_FLAG_LESS_THAN
+                               | LWM2M_ATTR_FLAG_STEP)))
     {
-        return COAP_500_INTERNAL_SERVER_ERROR;
+        return true;
     }
-    return 0;
+
+    /* A threshold is reached when the value crosses it in either direction */
+    if (   (attrPtr->mask & LWM2M_ATTR_FLAG_GREATER_THAN)
+        && ((lastValue > attrPtr->gt) != (value > attrPtr->gt)))
+    {
+        return true;
+    }
+
+    if (   (attrPtr->mask & LWM2M_ATTR_FLAG_LESS_THAN)
+        && ((lastValue < attrPtr->lt) != (value < attrPtr->lt)))
+    {
+        return true;
+    }
+
+    if (attrPtr->mask & LWM2M_ATTR_FLAG_STEP)
+    {
+        delta = (value > lastValue) ? (value - lastValue) : (lastValue - value);
+        if (delta >= attrPtr->st)
+        {
+            return true;
+        }
+    }
+
+    return false;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Generic function when a EXECUTE command is treated for a specific object (Wakaama)
+ * Get the notification state of a resource for an observation, the state is created if it does not
+ * exist
  *
  * @return
- *      - COAP_404_NOT_FOUND if the object / object instance / resource instance does not exist
- *      - COAP_500_INTERNAL_SERVER_ERROR in case of error
- *      - COAP_204_CHANGED if the request is well treated
+ *      - notification state
+ *      - NULL on allocation failure
  */
 //--------------------------------------------------------------------------------------------------
-static uint8_t ExecuteCb
+static lwm2mcore_notifyState_t* GetNotifyState
 (
-    uint16_t instanceId,            ///< [IN] Object ID
-    uint16_t resourceId,            ///< [IN] Resource ID
-    uint8_t* bufferPtr,             ///< [IN] Data provided in the EXECUTE command
-    int length,                     ///< [IN] Data length
-    lwm2m_object_t* objectPtr       ///< [IN] Pointer on object
+    lwm2mcore_resourceState_t* statePtr,        ///< [IN] Resource state of the object instance
+    uint16_t shortServerId,                     ///< [IN] Short server Id of the observer
+    omanager_ObserveLevel_t level               ///< [IN] Observed level
 )
 {
-    uint8_t result;
-
-    if ((NULL == objectPtr) || ((NULL == bufferPtr) && length))
-    {
-        return COAP_500_INTERNAL_SERVER_ERROR;
-    }
-
-    LOG_ARG("ExecuteCb oid %d oiid %d rid %d", objectPtr->objID, instanceId, resourceId);
-
-    /* Search if the object was registered */
-    if (LWM2M_LIST_FIND(objectPtr->instanceList, instanceId))
-    {
-        lwm2mcore_internalObject_t* objPtr;
-        LOG("object instance Id was registered");
-
-        objPtr = FindObject(Lwm2mcoreCtxPtr, objectPtr->objID);
-        if (NULL == objPtr)
-        {
-            LOG_ARG("Object %d is NOT registered", objectPtr->objID);
-            result = COAP_404_NOT_FOUND;
-        }
-        else
-        {
-            int sid = 0;
-            lwm2mcore_internalResource_t* resourcePtr = NULL;
-            char asyncBuf[LWM2MCORE_BUFFER_MAX_LEN];
-            size_t asyncBufLen = LWM2MCORE_BUFFER_MAX_LEN;
-            lwm2mcore_Uri_t uri;
-            memset(&uri, 0, sizeof (lwm2mcore_Uri_t));
-            uri.op = LWM2MCORE_OP_EXECUTE;
-            uri.oid = objectPtr->objID;
-            uri.oiid = instanceId;
-            uri.rid = resourceId;
-
-            // Validate the operational state early here, as the code to follow may block
-            if (!ValidStateForOperation(&uri))
-            {
-                LOG("Operation disallowed due to the present state");
-                return COAP_500_INTERNAL_SERVER_ERROR;
-            }
-
-            /* Search the resource handler */
-            resourcePtr = FindResource(objPtr, uri.rid);
-            if (NULL != resourcePtr)
-            {
-                if (NULL != resourcePtr->exec)
-                {
-                    lwm2m_data_t dataArray;
-                    dataArray.type = LWM2M_TYPE_STRING;
-                    dataArray.value.asBuffer.length = (size_t)length;
-                    dataArray.value.asBuffer.buffer = bufferPtr;
-                    memset(asyncBuf, 0, asyncBufLen);
+    lwm2mcore_notifyState_t* notifyPtr;
 
-                    LOG_ARG("data type %d resourcePtr->type %d", dataArray.type, resourcePtr->type);
-                    if (FormatDataWriteExecute(resourcePtr->type,
-                                               dataArray,
-                                               asyncBuf,
-                                               &asyncBufLen))
-                    {
-                        LOG_ARG("EXECUTE / %d / %d / %d", uri.oid, uri.oiid, uri.rid);
-                        sid  = resourcePtr->exec(&uri, asyncBuf, asyncBufLen);
-                        LOG_ARG("EXECUTE sID %d", sid);
-                        /* Define the CoAP result */
-                        result = SetCoapError(sid, LWM2MCORE_OP_EXECUTE);
-                    }
-                    else
-                    {
-                        result = COAP_400_BAD_REQUEST;
-                    }
-                }
-                else
-                {
-                    LOG("EXECUTE callback NULL");
-                    result = COAP_405_METHOD_NOT_ALLOWED;
-                }
-            }
-            else
-            {
-                LOG("resource NULL");
-                result = COAP_404_NOT_FOUND;
-            }
+    for (notifyPtr = statePtr->notifyPtr; notifyPtr; notifyPtr = notifyPtr->nextPtr)
+    {
+        if ((shortServerId == notifyPtr->shortServerId) && ((uint8_t)level == notifyPtr->level))
+        {
+            return notifyPtr;
         }
     }
-    else
+
+    notifyPtr = (lwm2mcore_notifyState_t*)lwm2m_malloc(sizeof(lwm2mcore_notifyState_t));
+    if (NULL == notifyPtr)
     {
-        LOG_ARG("Object %d not found", objectPtr->objID);
-        result = COAP_404_NOT_FOUND;
+        return NULL;
     }
-    LOG_ARG("ExecuteCb result %d", result);
-    return result;
+    memset(notifyPtr, 0, sizeof(lwm2mcore_notifyState_t));
+    notifyPtr->shortServerId = shortServerId;
+    notifyPtr->level = (uint8_t)level;
+    notifyPtr->nextPtr = statePtr->notifyPtr;
+    statePtr->notifyPtr = notifyPtr;
+    return notifyPtr;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Get the supported object list for LWM2M Core
- *
- * @return
- *      - NULL in case of error
- *      - object list else
+ * Record a notified value of a resource for an observation
  */
 //--------------------------------------------------------------------------------------------------
-static struct _lwm2mcore_objectsList* GetObjectsList
+static void RecordNotification
 (
-    void
+    lwm2mcore_notifyState_t* statePtr,          ///< [IN] Notification state of the observation
+    uint64_t nowMs,                             ///< [IN] Current time
+    bool isNumeric,                             ///< [IN] Set for a numeric value
+    double value,                               ///< [IN] Numeric value
+    uint32_t hash                               ///< [IN] Hash of a string/opaque value
 )
 {
-    if (NULL != Lwm2mcoreCtxPtr)
-    {
-        return &(Lwm2mcoreCtxPtr->objects_list);
-    }
-    else
+    if (statePtr->notifyDeadlineMs)
     {
-        return NULL;
+        statePtr->notifyDeadlineMs = 0;
+        Lwm2mcoreCtxPtr->deferredNotificationCount--;
     }
+
+    statePtr->isNotified = true;
+    statePtr->notifyTimeMs = nowMs;
+    statePtr->notifyValue = isNumeric ? value : 0;
+    statePtr->notifyHash = isNumeric ? 0 : hash;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Initialize LwM2M object
+ * Evaluate a resource change against the observe attributes (pmin, pmax, gt, lt, st) of one
+ * observation. The last notified value is kept for each object instance of the resource and each
+ * observation (server and observed level).
  *
  * @return
- *      - object pointer
+ *  - OMANAGER_NOTIFY_SEND if the change has to be notified now
+ *  - OMANAGER_NOTIFY_DEFER if the change is deferred
+ *  - OMANAGER_NOTIFY_SUPPRESS if the change does not need to be notified
  */
 //--------------------------------------------------------------------------------------------------
-static lwm2mcore_internalObject_t* InitObject
+omanager_NotifyDecision_t omanager_CheckNotification
 (
-    lwm2mcore_Object_t* client_objPtr,  ///< [IN] pointer to object passed from client
-    uint16_t iid,                       ///< [IN] object instance ID
-    bool multiple                       ///< [IN] if this is single or multiple instance object
+    uint16_t oid,                       ///< [IN] Object Id
+    uint16_t oiid,                      ///< [IN] Object instance Id
+    uint16_t rid,                       ///< [IN] Resource Id
+    uint16_t shortServerId,             ///< [IN] Short server Id of the observer
+    omanager_ObserveLevel_t level,      ///< [IN] Observed level
+    const lwm2m_attribute_t* attrPtr    ///< [IN] Observe attributes of the observation
 )
 {
-    int j;
-    lwm2mcore_internalObject_t* objPtr = NULL;
+    lwm2mcore_internalObject_t* objPtr;
     lwm2mcore_internalResource_t* resourcePtr = NULL;
-    lwm2mcore_Resource_t *client_resourcePtr = NULL;
-
-    if (NULL == client_objPtr)
+    lwm2mcore_resourceState_t* resourceStatePtr;
+    lwm2mcore_notifyState_t* statePtr = NULL;
+    bool isNumeric = false;
+    bool isChanged;
+    double value = 0;
+    uint32_t hash = 0;
+    uint64_t nowMs;
+    uint64_t elapsedMs;
+
+    objPtr = FindObject(Lwm2mcoreCtxPtr, oid);
+    if (NULL != objPtr)
     {
-        return NULL;
+        resourcePtr = FindResource(Lwm2mcoreCtxPtr, objPtr, rid);
     }
 
-    LOG_ARG("InitObject /%d/%d, multiple %d", client_objPtr->id, iid, multiple);
-
-    objPtr = (lwm2mcore_internalObject_t*)lwm2m_malloc(sizeof (lwm2mcore_internalObject_t));
-
-    LWM2MCORE_ASSERT(objPtr);
-
-    memset(objPtr, 0, sizeof (lwm2mcore_internalObject_t));
-
-    objPtr->multiple = multiple;
-    objPtr->id = client_objPtr->id;
-    objPtr->iid = iid;
-    memset(&(objPtr->attr), 0, sizeof (lwm2m_attribute_t));
-
-    /* Object's create and delete handlers should be invoked by the LWM2M client
-     * itself. Once the operation is completed, the client shall call avcm_create_lwm2m_object
-     * or avcm_delete_lwm2m_object accordingly */
-    client_resourcePtr = client_objPtr->resources;
+    /* Values which can not be compared are always notified */
+    if (   (NULL == resourcePtr)
+        || (NULL == attrPtr)
+        || (!ReadNotifyValue(oid, oiid, resourcePtr, &isNumeric, &value, &hash)))
+    {
+        return OMANAGER_NOTIFY_SEND;
+    }
 
-    LOG_ARG("InitObject client_obj->resCnt %d", client_objPtr->resCnt);
+    resourceStatePtr = GetResourceState(resourcePtr, oiid, true);
+    if (NULL != resourceStatePtr)
+    {
+        statePtr = GetNotifyState(resourceStatePtr, shortServerId, level);
+    }
+    if (NULL == statePtr)
+    {
+        return OMANAGER_NOTIFY_SEND;
+    }
 
-    DLIST_INIT(&(objPtr->resource_list));
+    nowMs = lwm2mcore_TimerGetTimeMs();
 
-    if ((LWM2MCORE_SOFTWARE_UPDATE_OID == client_objPtr->id)
-     && (LWM2MCORE_ID_NONE == iid))
+    if (!statePtr->isNotified)
     {
-        /* Object 9 without any object instance
-         * Get information from host
-         */
-        LOG("Object 9 without any object instance");
+        RecordNotification(statePtr, nowMs, isNumeric, value, hash);
+        return OMANAGER_NOTIFY_SEND;
+    }
 
+    elapsedMs = nowMs - statePtr->notifyTimeMs;
+    if (isNumeric)
+    {
+        isChanged = (value < statePtr->notifyValue) || (value > statePtr->notifyValue);
+    }
+    else
+    {
+        isChanged = (hash != statePtr->notifyHash);
     }
 
-    for (j = 0; j < client_objPtr->resCnt; j++)
+    if (!isChanged)
     {
-        resourcePtr =
-                (lwm2mcore_internalResource_t*)lwm2m_malloc(sizeof(lwm2mcore_internalResource_t));
+        if (   (attrPtr->mask & LWM2M_ATTR_FLAG_MAX_PERIOD)
+            && (elapsedMs >= (uint64_t)attrPtr->pmax * 1000))
+        {
+            RecordNotification(statePtr, nowMs, isNumeric, value, hash);
+            return OMANAGER_NOTIFY_SEND;
+        }
+        LOG_ARG("/%d/%d/%d unchanged", oid, oiid, rid);
+        return OMANAGER_NOTIFY_SUPPRESS;
+    }
 
-        LWM2MCORE_ASSERT(resourcePtr);
-        memset(resourcePtr, 0, sizeof(lwm2mcore_internalResource_t));
+    if (isNumeric && (!IsThresholdReached(attrPtr, statePtr->notifyValue, value)))
+    {
+        LOG_ARG("/%d/%d/%d below threshold", oid, oiid, rid);
+        return OMANAGER_NOTIFY_SUPPRESS;
+    }
 
-        resourcePtr->id = (client_resourcePtr + j)->id;
-        resourcePtr->iid = 0;
-        resourcePtr->type = (client_resourcePtr + j)->type;
-        resourcePtr->maxInstCount = (client_resourcePtr + j)->maxResInstCnt;
-        memset(&resourcePtr->attr, 0, sizeof(lwm2m_attribute_t));
-        resourcePtr->read = (client_resourcePtr + j)->read;
-        resourcePtr->write = (client_resourcePtr + j)->write;
-        resourcePtr->exec = (client_resourcePtr + j)->exec;
-        DLIST_INSERT_TAIL(&(objPtr->resource_list), resourcePtr, list);
+    if (   (attrPtr->mask & LWM2M_ATTR_FLAG_MIN_PERIOD)
+        && (elapsedMs < (uint64_t)attrPtr->pmin * 1000))
+    {
+        if (0 == statePtr->notifyDeadlineMs)
+        {
+            statePtr->notifyDeadlineMs = statePtr->notifyTimeMs + ((uint64_t)attrPtr->pmin * 1000);
+            Lwm2mcoreCtxPtr->deferredNotificationCount++;
+        }
+        LOG_ARG("/%d/%d/%d deferred", oid, oiid, rid);
+        return OMANAGER_NOTIFY_DEFER;
     }
 
-    return objPtr;
+    RecordNotification(statePtr, nowMs, isNumeric, value, hash);
+    return OMANAGER_NOTIFY_SEND;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Initialize supported objects/resources based on handler data.
+ * Release the request arena: called once before each CoAP request or notification is treated
  */
 //--------------------------------------------------------------------------------------------------
-static void InitObjectsList
+void omanager_ReleaseRequestMemory
 (
-    struct _lwm2mcore_objectsList* objects_list ,   ///< [IN] Object list
-    lwm2mcore_Handler_t* clientHandlerPtr           ///< [IN] Object and resource table which are
-                                                    ///<      supported by the client
+    void
 )
 {
-    int i, j;
-    lwm2mcore_internalObject_t* objPtr = NULL;
+    RequestArena.used = 0;
+}
 
-    if ((NULL == objects_list) || (NULL == clientHandlerPtr))
+//--------------------------------------------------------------------------------------------------
+/**
+ * Report the deferred notifications whose minimum period elapsed
+ *
+ * @return
+ *  - Delay in ms until the next deferred notification
+ *  - UINT32_MAX if no notification is deferred
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t omanager_ProcessDeferredNotifications
+(
+    omanager_NotifyCallback_t notifyCb  ///< [IN] Callback to notify a resource change
+)
+{
+    struct _lwm2mcore_objectsList* objectsListPtr = GetObjectsList();
+    lwm2mcore_internalObject_t* objPtr;
+    lwm2mcore_internalResource_t* resourcePtr;
+    lwm2mcore_resourceState_t* resourceStatePtr;
+    lwm2mcore_notifyState_t* statePtr;
+    uint64_t nowMs;
+    uint64_t nextMs = UINT32_MAX;
+    bool isNumeric = false;
+    bool isRead;
+    bool isDue;
+    double value = 0;
+    uint32_t hash = 0;
+
+    if (   (NULL == objectsListPtr)
+        || (0 == Lwm2mcoreCtxPtr->deferredNotificationCount)
+        || (NULL == notifyCb))
     {
-        return;
+        return UINT32_MAX;
     }
 
-    LOG_ARG("objCnt %d", clientHandlerPtr->objCnt);
+    nowMs = lwm2mcore_TimerGetTimeMs();
 
-    for (i = 0; i < clientHandlerPtr->objCnt; i++)
+    for (objPtr = DLIST_FIRST(objectsListPtr); objPtr; objPtr = DLIST_NEXT(objPtr, list))
     {
-        if (LWM2MCORE_ID_NONE == (clientHandlerPtr->objects + i)->maxObjInstCnt)
-        {
-            /* Unknown object instance count is always assumed to be multiple */
-            objPtr = InitObject(clientHandlerPtr->objects + i, LWM2MCORE_ID_NONE, true);
-            if (!objPtr)
-            {
-               LOG("objPtr is NULL");
-               return;
-            }
-            DLIST_INSERT_TAIL(objects_list, objPtr, list);
-        }
-        else if ((clientHandlerPtr->objects + i)->maxObjInstCnt > 1)
+        for (resourcePtr = DLIST_FIRST(&(objPtr->resource_list));
+             resourcePtr;
+             resourcePtr = DLIST_NEXT(resourcePtr, list))
         {
-            for (j = 0; j < (clientHandlerPtr->objects + i)->maxObjInstCnt; j++)
+            for (resourceStatePtr = resourcePtr->statePtr;
+                 resourceStatePtr;
+                 resourceStatePtr = resourceStatePtr->nextPtr)
             {
-                objPtr = InitObject(clientHandlerPtr->objects + i, j, true);
-                if (!objPtr)
+                /* The value is read once for all the observations due */
+                isRead = false;
+                isDue = false;
+
+                for (statePtr = resourceStatePtr->notifyPtr; statePtr; statePtr = statePtr->nextPtr)
                 {
-                   LOG("objPtr is NULL");
-                   return;
+                    if (0 == statePtr->notifyDeadlineMs)
+                    {
+                        continue;
+                    }
+
+                    if (statePtr->notifyDeadlineMs > nowMs)
+                    {
+                        if ((statePtr->notifyDeadlineMs - nowMs) < nextMs)
+                        {
+                            nextMs = statePtr->notifyDeadlineMs - nowMs;
+                        }
+                        continue;
+                    }
+
+                    /* The reference value is the one notified now */
+                    if (!isDue)
+                    {
+                        isDue = true;
+                        isRead = ReadNotifyValue(objPtr->id,
+                                                 resourceStatePtr->oiid,
+                                                 resourcePtr,
+                                                 &isNumeric,
+                                                 &value,
+                                                 &hash);
+                    }
+                    if (isRead)
+                    {
+                        RecordNotification(statePtr, nowMs, isNumeric, value, hash);
+                    }
+                    else
+                    {
+                        statePtr->notifyDeadlineMs = 0;
+                        statePtr->notifyTimeMs = nowMs;
+                        Lwm2mcoreCtxPtr->deferredNotificationCount--;
+                    }
+                }
+
+                if (isDue)
+                {
+                    notifyCb(objPtr->id, resourceStatePtr->oiid, resourcePtr->id);
                 }
-                DLIST_INSERT_TAIL(objects_list, objPtr, list);
-            }
-        }
-        else if (LWM2M_SERVER_OBJECT_ID == (clientHandlerPtr->objects + i)->id)
-        {
-            /* the maxObjInstCnt is 1 for this object, but this is actually multiple instance */
-            objPtr = InitObject(clientHandlerPtr->objects + i, 0, true);
-            if (!objPtr)
-            {
-               LOG("objPtr is NULL");
-               return;
-            }
-            DLIST_INSERT_TAIL(objects_list, objPtr, list);
-        }
-        else
-        {
-            objPtr = InitObject(clientHandlerPtr->objects + i, 0, false);
-            if (!objPtr)
-            {
-               LOG("objPtr is NULL");
-               return;
             }
-            DLIST_INSERT_TAIL(objects_list, objPtr, list);
         }
     }
+
+    return (uint32_t)nextMs;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1701,6 +3434,7 @@ void omanager_ObjectsFree
 )
 {
     struct _lwm2mcore_objectsList* objectsListPtr = GetObjectsList();
+    lwm2mcore_context_t* ctxPtr = Lwm2mcoreCtxPtr;
     lwm2mcore_internalObject_t* objPtr = NULL;
     lwm2mcore_internalResource_t* resPtr = NULL;
     uint32_t i = 0;
@@ -1710,12 +3444,17 @@ void omanager_ObjectsFree
        return;
     }
 
+    /* The index references the objects and resources which are released below */
+    FreeObjectsIndex(ctxPtr);
+    ctxPtr->deferredNotificationCount = 0;
+
     /* Free memory for objects and resources for LwM2MCore */
     while ((objPtr = DLIST_FIRST(objectsListPtr)) != NULL)
     {
         while ((resPtr = DLIST_FIRST(&(objPtr->resource_list))) != NULL)
         {
             DLIST_REMOVE_HEAD(&(objPtr->resource_list), list);
+            FreeResourceStates(resPtr);
             lwm2m_free(resPtr);
         }
         DLIST_REMOVE_HEAD(objectsListPtr, list);
@@ -1723,20 +3462,20 @@ void omanager_ObjectsFree
     }
 
     /* Free memory for objects and resources for Wakaama */
-    LOG_ARG("Wakaama RegisteredObjNb %d", RegisteredObjNb);
-    for (i = 0; i < RegisteredObjNb; i++)
+    LOG_ARG("Wakaama RegisteredObjNb %d", ctxPtr->registeredObjNb);
+    for (i = 0; i < ctxPtr->registeredObjNb; i++)
     {
-        if (ObjectArray[i])
+        if (ctxPtr->objectArray[i])
         {
-            while (ObjectArray[i]->instanceList != NULL)
+            while (ctxPtr->objectArray[i]->instanceList != NULL)
             {
-                lwm2m_list_t *listPtr = ObjectArray[i]->instanceList;
-                ObjectArray[i]->instanceList = ObjectArray[i]->instanceList->next;
+                lwm2m_list_t *listPtr = ctxPtr->objectArray[i]->instanceList;
+                ctxPtr->objectArray[i]->instanceList = ctxPtr->objectArray[i]->instanceList->next;
                 lwm2m_free(listPtr);
             }
 
-            lwm2m_free(ObjectArray[i]);
-            ObjectArray[i] = NULL;
+            lwm2m_free(ctxPtr->objectArray[i]);
+            ctxPtr->objectArray[i] = NULL;
         }
     }
 }
@@ -1751,17 +3490,23 @@ void omanager_FreeObjectById
     uint16_t    objectId        ///< [IN] Object Id to remove
 )
 {
+    lwm2mcore_context_t* ctxPtr = Lwm2mcoreCtxPtr;
     uint32_t i = 0;
 
+    if (NULL == ctxPtr)
+    {
+        return;
+    }
+
     /* Free memory for objects and resources for Wakaama */
-    for (i = 0; i < RegisteredObjNb; i++)
+    for (i = 0; i < ctxPtr->registeredObjNb; i++)
     {
-        if (ObjectArray[i] && (ObjectArray[i]->objID == objectId))
+        if (ctxPtr->objectArray[i] && (ctxPtr->objectArray[i]->objID == objectId))
         {
-            while (ObjectArray[i]->instanceList != NULL)
+            while (ctxPtr->objectArray[i]->instanceList != NULL)
             {
-                lwm2m_list_t *listPtr = ObjectArray[i]->instanceList;
-                ObjectArray[i]->instanceList = ObjectArray[i]->instanceList->next;
+                lwm2m_list_t *listPtr = ctxPtr->objectArray[i]->instanceList;
+                ctxPtr->objectArray[i]->instanceList = ctxPtr->objectArray[i]->instanceList->next;
                 lwm2m_free(listPtr);
             }
         }
@@ -1780,17 +3525,24 @@ void omanager_FreeObjectByInstanceId
     uint16_t    objectInstanceId    ///< [IN] Object instance Id to remove
 )
 {
+    lwm2mcore_context_t* ctxPtr = Lwm2mcoreCtxPtr;
     uint32_t i = 0;
 
+    if (NULL == ctxPtr)
+    {
+        return;
+    }
+
     /* Free memory for objects and resources for Wakaama */
-    for (i = 0; i < RegisteredObjNb; i++)
+    for (i = 0; i < ctxPtr->registeredObjNb; i++)
     {
-        if (ObjectArray[i] && (ObjectArray[i]->objID == objectId))
+        if (ctxPtr->objectArray[i] && (ctxPtr->objectArray[i]->objID == objectId))
         {
             lwm2m_list_t* instancePtr;
-            ObjectArray[i]->instanceList = lwm2m_list_remove(ObjectArray[i]->instanceList,
-                                                             objectInstanceId,
-                                                             (lwm2m_list_t **)&instancePtr);
+            lwm2m_object_t* objectPtr = ctxPtr->objectArray[i];
+            objectPtr->instanceList = lwm2m_list_remove(objectPtr->instanceList,
+                                                        objectInstanceId,
+                                                        (lwm2m_list_t **)&instancePtr);
             lwm2m_free(instancePtr);
         }
     }
@@ -1812,14 +3564,20 @@ uint16_t omanager_ObjectInstanceCount
     uint16_t oid                            ///< [IN] object ID to find
 )
 {
+    lwm2mcore_context_t* ctxPtr = Lwm2mcoreCtxPtr;
     uint32_t i = 0;
     uint16_t count = 0;
 
-    for (i = 0; i < RegisteredObjNb; i++)
+    if (NULL == ctxPtr)
+    {
+        return 0;
+    }
+
+    for (i = 0; i < ctxPtr->registeredObjNb; i++)
     {
-        if (ObjectArray[i] && (ObjectArray[i]->objID == oid))
+        if (ctxPtr->objectArray[i] && (ctxPtr->objectArray[i]->objID == oid))
         {
-            lwm2m_list_t *listPtr = ObjectArray[i]->instanceList;
+            lwm2m_list_t *listPtr = ctxPtr->objectArray[i]->instanceList;
             while (listPtr != NULL)
             {
                 listPtr = listPtr->next;
@@ -1852,12 +3610,15 @@ static bool RegisterObjTable
     uint16_t securityObjectNumber;
     uint16_t serverObjectNumber;
     struct _lwm2mcore_objectsList *objectsListPtr = NULL;
+    lwm2m_object_t** objectArray;
 
-    if ((NULL == handlerPtr) || (NULL == registeredObjNbPtr))
+    if ((NULL == instanceRef) || (NULL == handlerPtr) || (NULL == registeredObjNbPtr))
     {
         return false;
     }
 
+    objectArray = ((smanager_ClientData_t*)instanceRef)->lwm2mcoreCtxPtr->objectArray;
+
     ObjNb = *registeredObjNbPtr;
 
     /* Check if a DM server was provided: only for static LwM2MCore case */
@@ -1872,7 +3633,7 @@ static bool RegisterObjTable
 
     LOG_ARG("dmServerPresence %d", dmServerPresence);
 
-    /* Check if ObjectArray is large enough for all the objects */
+    /* Check if objectArray is large enough for all the objects */
     if (OBJ_COUNT < handlerPtr->objCnt + ObjNb)
     {
         return false;
@@ -1882,23 +3643,23 @@ static bool RegisterObjTable
     for (i = 0; i < (handlerPtr->objCnt); i++)
     {
         /* Memory allocation for one object */
-        ObjectArray[ObjNb]  = (lwm2m_object_t *)lwm2m_malloc(sizeof(lwm2m_object_t));
-        if (NULL != ObjectArray[ObjNb])
+        objectArray[ObjNb]  = (lwm2m_object_t *)lwm2m_malloc(sizeof(lwm2m_object_t));
+        if (NULL != objectArray[ObjNb])
         {
-            memset(ObjectArray[ObjNb], 0, sizeof(lwm2m_object_t));
+            memset(objectArray[ObjNb], 0, sizeof(lwm2m_object_t));
 
             /* Assign the object ID */
-            ObjectArray[ObjNb]->objID = (handlerPtr->objects + i)->id;
+            objectArray[ObjNb]->objID = (handlerPtr->objects + i)->id;
             objInstanceNb = (handlerPtr->objects + i)->maxObjInstCnt;
 
             /* Object 0: security */
-            if (LWM2M_SECURITY_OBJECT_ID == ObjectArray[ObjNb]->objID)
+            if (LWM2M_SECURITY_OBJECT_ID == objectArray[ObjNb]->objID)
             {
                 objInstanceNb = securityObjectNumber;
             }
 
             /* Object 1: server */
-            if (LWM2M_SERVER_OBJECT_ID == ObjectArray[ObjNb]->objID)
+            if (LWM2M_SERVER_OBJECT_ID == objectArray[ObjNb]->objID)
             {
                 if (false == dmServerPresence)
                 {
@@ -1914,7 +3675,7 @@ static bool RegisterObjTable
             }
 
             /* Object 2 case: check stored ACL configuration */
-            if (LWM2M_ACL_OBJECT_ID == ObjectArray[ObjNb]->objID)
+            if (LWM2M_ACL_OBJECT_ID == objectArray[ObjNb]->objID)
             {
                 uint16_t object2InstanceNumber = omanager_GetObject2InstanceNumber();
                 if (object2InstanceNumber >= 1)
@@ -1928,20 +3689,20 @@ static bool RegisterObjTable
                 }
             }
 
-            LOG_ARG("Object Id %d, objInstanceNb %d", ObjectArray[ObjNb]->objID, objInstanceNb);
+            LOG_ARG("Object Id %d, objInstanceNb %d", objectArray[ObjNb]->objID, objInstanceNb);
 
             if (LWM2MCORE_ID_NONE == objInstanceNb)
             {
                 /* Unknown object instance count is always assumed to be multiple */
-                LOG_ARG("Object with multiple instances oid %d", ObjectArray[ObjNb]->objID);
+                LOG_ARG("Object with multiple instances oid %d", objectArray[ObjNb]->objID);
             }
             else if (1 < objInstanceNb)
             {
                 lwm2m_list_t* instancePtr;
-                ObjectArray[ObjNb]->instanceList =
+                objectArray[ObjNb]->instanceList =
                         (lwm2m_list_t *)lwm2m_malloc(sizeof(lwm2m_list_t));
-                memset(ObjectArray[ObjNb]->instanceList, 0, sizeof(lwm2m_list_t));
-                // Since ObjectArray[0] is already malloced, the following loop starts with 1
+                memset(objectArray[ObjNb]->instanceList, 0, sizeof(lwm2m_list_t));
+                // Since objectArray[0] is already malloced, the following loop starts with 1
                 for (j = 1; j < objInstanceNb; j++)
                 {
                     /* Add the object instance in the Wakaama format */
@@ -1952,52 +3713,52 @@ static bool RegisterObjTable
                        return false;
                     }
                     instancePtr->id = j;
-                    ObjectArray[ObjNb]->instanceList =
-                        LWM2M_LIST_ADD (ObjectArray[ObjNb]->instanceList,
+                    objectArray[ObjNb]->instanceList =
+                        LWM2M_LIST_ADD (objectArray[ObjNb]->instanceList,
                                         instancePtr);
                     /* instancePtr is released by omanager_ObjectsFree API */
                 }
 
                 for (j = 0; j < objInstanceNb; j++)
                 {
-                    if (NULL == lwm2m_list_find(ObjectArray[ObjNb]->instanceList, j))
+                    if (NULL == lwm2m_list_find(objectArray[ObjNb]->instanceList, j))
                     {
-                        LOG_ARG("Oid %d / oiid %d NOT present", ObjectArray[ObjNb]->objID, j);
+                        LOG_ARG("Oid %d / oiid %d NOT present", objectArray[ObjNb]->objID, j);
                     }
                     else
                     {
-                        LOG_ARG("Oid %d / oiid %d present", ObjectArray[ObjNb]->objID, j);
+                        LOG_ARG("Oid %d / oiid %d present", objectArray[ObjNb]->objID, j);
                     }
                 }
             }
             else if (1 == objInstanceNb)
             {
                 /* Allocate the unique object instance */
-                ObjectArray[ObjNb]->instanceList =
+                objectArray[ObjNb]->instanceList =
                                             (lwm2m_list_t *)lwm2m_malloc(sizeof(lwm2m_list_t));
-                if (ObjectArray[ObjNb]->instanceList != NULL)
+                if (objectArray[ObjNb]->instanceList != NULL)
                 {
-                    memset(ObjectArray[ObjNb]->instanceList, 0, sizeof(lwm2m_list_t));
+                    memset(objectArray[ObjNb]->instanceList, 0, sizeof(lwm2m_list_t));
                 }
                 else
                 {
-                    lwm2m_free(ObjectArray[ObjNb]);
+                    lwm2m_free(objectArray[ObjNb]);
                     return false;
                 }
 
-                if (NULL == lwm2m_list_find(ObjectArray[ObjNb]->instanceList, 0))
+                if (NULL == lwm2m_list_find(objectArray[ObjNb]->instanceList, 0))
                 {
-                    LOG_ARG("oid %d / oiid %d NOT present", ObjectArray[ObjNb]->objID, 0);
+                    LOG_ARG("oid %d / oiid %d NOT present", objectArray[ObjNb]->objID, 0);
                 }
                 else
                 {
-                    LOG_ARG("oid %d / oiid %d present", ObjectArray[ObjNb]->objID, 0);
+                    LOG_ARG("oid %d / oiid %d present", objectArray[ObjNb]->objID, 0);
                 }
             }
             else
             {
                 LOG_ARG("No instance to create in Wakaama for object %d",
-                        ObjectArray[ObjNb]->objID);
+                        objectArray[ObjNb]->objID);
             }
 
             if (objInstanceNb)
@@ -2008,15 +3769,15 @@ static bool RegisterObjTable
                  * server. In fact the library doesn't need to know the resources of the object,
                  * only the server does.
                  */
-                ObjectArray[ObjNb]->readFunc     = ReadCb;
-                ObjectArray[ObjNb]->discoverFunc = DiscoverCb;
-                ObjectArray[ObjNb]->writeFunc    = WriteCb;
-                ObjectArray[ObjNb]->executeFunc  = ExecuteCb;
-                ObjectArray[ObjNb]->createFunc   = CreateCb;
-                ObjectArray[ObjNb]->deleteFunc   = DeleteCb;
+                objectArray[ObjNb]->readFunc     = MeasuredReadCb;
+                objectArray[ObjNb]->discoverFunc = MeasuredDiscoverCb;
+                objectArray[ObjNb]->writeFunc    = MeasuredWriteCb;
+                objectArray[ObjNb]->executeFunc  = MeasuredExecuteCb;
+                objectArray[ObjNb]->createFunc   = CreateCb;
+                objectArray[ObjNb]->deleteFunc   = DeleteCb;
 
                 /* Store the context */
-                ObjectArray[ObjNb]->userData = instanceRef;
+                objectArray[ObjNb]->userData = instanceRef;
                 ObjNb++;
             }
         }
@@ -2028,6 +3789,12 @@ static bool RegisterObjTable
      */
     objectsListPtr = GetObjectsList();
     InitObjectsList(objectsListPtr, handlerPtr);
+
+    /* Refresh the lookup index used by the READ/WRITE/EXECUTE handlers */
+    if (false == BuildObjectsIndex(Lwm2mcoreCtxPtr))
+    {
+        LOG("Object lookup index not available, fall back to the object list");
+    }
     *registeredObjNbPtr = ObjNb;
     return true;
 }
@@ -2343,6 +4110,20 @@ static lwm2mcore_Resource_t* SearchResource
     int i, j;
     lwm2mcore_Handler_t* lwm2mHandlersPtr = NULL;
     lwm2mcore_Resource_t* resourcePtr = NULL ;
+    lwm2mcore_internalObject_t* objPtr;
+    lwm2mcore_internalResource_t* internalResourcePtr;
+
+    // Use the lookup index when the objects are registered
+    objPtr = FindObject(Lwm2mcoreCtxPtr, objectId);
+    if (objPtr)
+    {
+        internalResourcePtr = FindResource(Lwm2mcoreCtxPtr, objPtr, resourceId);
+        if (internalResourcePtr && internalResourcePtr->tableResourcePtr)
+        {
+            return internalResourcePtr->tableResourcePtr;
+        }
+    }
+
     lwm2mHandlersPtr = omanager_GetHandlers();
 
     if (!lwm2mHandlersPtr)
@@ -2422,6 +4203,103 @@ bool lwm2mcore_ResourceRead
         return false;
     }
 
+    // The typed read function is used instead of the read function when both are set
+    if (resourcePtr->readValue)
+    {
+        lwm2mcore_Value_t value;
+
+        memset(&value, 0, sizeof(value));
+        value.type = LWM2MCORE_VALUE_NONE;
+        value.value.asBuffer.bufferPtr = asyncBuf;
+        value.value.asBuffer.len = sizeof(asyncBuf);
+
+        // Execute the typed read function
+        if (LWM2MCORE_ERR_COMPLETED_OK != resourcePtr->readValue(&uri, &value))
+        {
+            return false;
+        }
+
+        // Format result and store it in dataPtr
+        switch (value.type)
+        {
+            case LWM2MCORE_VALUE_INT:
+                *dataSizePtr = snprintf(dataPtr, dataBufferSize - 1, "%lld",
+                                        (long long)value.value.asInt);
+                break;
+
+            case LWM2MCORE_VALUE_BOOL:
+                *dataSizePtr = snprintf(dataPtr, dataBufferSize - 1, "%d", value.value.asBool);
+                break;
+
+            case LWM2MCORE_VALUE_FLOAT:
+                *dataSizePtr = snprintf(dataPtr, dataBufferSize - 1, "%lf", value.value.asFloat);
+                break;
+
+            case LWM2MCORE_VALUE_BUFFER:
+                if (value.value.asBuffer.len > dataBufferSize)
+                {
+                    return false;
+                }
+                memcpy(dataPtr, value.value.asBuffer.bufferPtr, value.value.asBuffer.len);
+                *dataSizePtr = value.value.asBuffer.len;
+                break;
+
+            case LWM2MCORE_VALUE_NONE:
+            default:
+                return false;
+        }
+
+        return true;
+    }
+
+    if (resourcePtr->readChunk && (!resourcePtr->read))
+    {
+        size_t offset = 0;
+        size_t requestedLen;
+        size_t chunkLen;
+
+        // Read the value chunk by chunk directly in the output buffer
+        do
+        {
+            requestedLen = dataBufferSize - offset;
+            if (LWM2MCORE_READ_CHUNK_LEN < requestedLen)
+            {
+                requestedLen = LWM2MCORE_READ_CHUNK_LEN;
+            }
+            chunkLen = requestedLen;
+
+            if (   (LWM2MCORE_ERR_COMPLETED_OK != resourcePtr->readChunk(&uri,
+                                                                         offset,
+                                                                         dataPtr + offset,
+                                                                         &chunkLen))
+                || (requestedLen < chunkLen))
+            {
+                return false;
+            }
+            offset += chunkLen;
+        }
+        while ((requestedLen == chunkLen) && (offset < dataBufferSize));
+
+        if (requestedLen == chunkLen)
+        {
+            // Output buffer is full: check that the whole value was read
+            char probe;
+            chunkLen = sizeof(probe);
+            if (   (LWM2MCORE_ERR_COMPLETED_OK != resourcePtr->readChunk(&uri,
+                                                                         offset,
+                                                                         &probe,
+                                                                         &chunkLen))
+                || (chunkLen))
+            {
+                LOG("Requested resource does not fit in the buffer");
+                return false;
+            }
+        }
+
+        *dataSizePtr = offset;
+        return true;
+    }
+
     if (!resourcePtr->read)
     {
         LOG("Requested resource cannot be read");
@@ -2605,25 +4483,28 @@ uint16_t lwm2mcore_ObjectRegister
 {
     bool result;
     lwm2mcore_Handler_t* lwm2mcoreHandlersPtr;
-
-    RegisteredObjNb = 0;
+    lwm2mcore_context_t* ctxPtr;
 
     if (!instanceRef)
     {
         LOG("Null instance reference");
-        return RegisteredObjNb;
+        return 0;
     }
 
+    smanager_ClientData_t* dataPtr = (smanager_ClientData_t*)instanceRef;
+    smanager_SelectInstance(instanceRef);
+    ctxPtr = dataPtr->lwm2mcoreCtxPtr;
+    ctxPtr->registeredObjNb = 0;
+
     /* For the moment, servicePtr can be NULL */
     (void)servicePtr;
     if (!endpointPtr)
     {
         LOG("param error");
-        return RegisteredObjNb;
+        return ctxPtr->registeredObjNb;
     }
 
-    smanager_ClientData_t* dataPtr = (smanager_ClientData_t*)instanceRef;
-    LOG_ARG("lwm2mcore_ObjectRegister RegisteredObjNb %d", RegisteredObjNb);
+    LOG_ARG("lwm2mcore_ObjectRegister RegisteredObjNb %d", ctxPtr->registeredObjNb);
 
     /* Read the bootstrap configuration file */
     if (false == omanager_LoadBootstrapConfigurationFile())
@@ -2644,24 +4525,24 @@ uint16_t lwm2mcore_ObjectRegister
     lwm2mcoreHandlersPtr = omanager_GetHandlers();
 
     /* Register static object tables managed by LwM2MCore */
-    result = RegisterObjTable(instanceRef, lwm2mcoreHandlersPtr, &RegisteredObjNb, false);
+    result = RegisterObjTable(instanceRef, lwm2mcoreHandlersPtr, &ctxPtr->registeredObjNb, false);
     if (false == result)
     {
-        RegisteredObjNb = 0;
+        ctxPtr->registeredObjNb = 0;
         LOG("ERROR on registering LwM2MCore object table");
-        return RegisteredObjNb;
+        return ctxPtr->registeredObjNb;
     }
 
     if (NULL != handlerPtr)
     {
         LOG("Register client object list");
         /* Register object tables filled by the client */
-        result = RegisterObjTable(instanceRef, handlerPtr, &RegisteredObjNb, true);
+        result = RegisterObjTable(instanceRef, handlerPtr, &ctxPtr->registeredObjNb, true);
         if (result == false)
         {
-            RegisteredObjNb = 0;
+            ctxPtr->registeredObjNb = 0;
             LOG("ERROR on registering client object table");
-            return RegisteredObjNb;
+            return ctxPtr->registeredObjNb;
         }
     }
     else
@@ -2673,20 +4554,20 @@ uint16_t lwm2mcore_ObjectRegister
     {
         int test = 0;
         /* Save the security object list in the context (used for connection) */
-        dataPtr->securityObjPtr = ObjectArray[LWM2M_SECURITY_OBJECT_ID];
+        dataPtr->securityObjPtr = ctxPtr->objectArray[LWM2M_SECURITY_OBJECT_ID];
 
         /* Wakaama configuration and the object registration */
-        LOG_ARG("RegisteredObjNb %d", RegisteredObjNb);
+        LOG_ARG("RegisteredObjNb %d", ctxPtr->registeredObjNb);
         test = lwm2m_configure(dataPtr->lwm2mHPtr,
                                endpointPtr,
                                NULL,
                                NULL,
-                               RegisteredObjNb,
-                               ObjectArray);
+                               ctxPtr->registeredObjNb,
+                               ctxPtr->objectArray);
         if (test != COAP_NO_ERROR)
         {
             LOG_ARG("Failed to configure LwM2M client: test %d", test);
-            RegisteredObjNb = 0;
+            ctxPtr->registeredObjNb = 0;
         }
         else
         {
@@ -2699,9 +4580,9 @@ uint16_t lwm2mcore_ObjectRegister
         UpdateObjectInstanceListWakaama(instanceRef, LWM2MCORE_FILE_LIST_OID);
 #endif /* LWM2M_OBJECT_33406 */
     }
-    LOG_ARG("Number of registered objects: %u", RegisteredObjNb);
+    LOG_ARG("Number of registered objects: %u", ctxPtr->registeredObjNb);
 
-    return RegisteredObjNb;
+    return ctxPtr->registeredObjNb;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -140,9 +140,45 @@
 //--------------------------------------------------------------------------------------------------
 /**
  * @brief Maximum buffer length from CoAP
+ *
+ * Resources which can exceed this length should use a chunked READ handler. The value can be
+ * reduced at build time on constrained targets.
  */
 //--------------------------------------------------------------------------------------------------
+#ifndef LWM2MCORE_BUFFER_MAX_LEN
 #define LWM2MCORE_BUFFER_MAX_LEN 4096
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Chunk length used to read a resource with a chunked READ handler
+ */
+//--------------------------------------------------------------------------------------------------
+#define LWM2MCORE_READ_CHUNK_LEN 512
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Maximum length of a resource value read with a chunked READ handler
+ */
+//--------------------------------------------------------------------------------------------------
+#define LWM2MCORE_READ_CHUNK_MAX_TOTAL_LEN (64 * 1024)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Maximum number of objects which can be registered in Wakaama
+ */
+//--------------------------------------------------------------------------------------------------
+#ifdef LWM2M_OBJECT_33406
+#define OBJ_COUNT_33406 2
+#else
+#define OBJ_COUNT_33406 0
+#endif
+#ifdef LWM2M_OBJECT_33409
+#define OBJ_COUNT_33409 1
+#else
+#define OBJ_COUNT_33409 0
+#endif
+#define OBJ_COUNT (15 + OBJ_COUNT_33406 + OBJ_COUNT_33409)
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -167,7 +203,8 @@ typedef enum
     LWM2MCORE_CLOCK_TIME_CONFIG_OID = 33405,    ///< Sierra Wireless proprietary object Id: Clock time config
     LWM2MCORE_FILE_TRANSFER_OID     = 33406,    ///< Sierra Wireless proprietary object Id: File transfer
     LWM2MCORE_FILE_LIST_OID         = 33407,    ///< Sierra Wireless proprietary object Id: File list
-    LWM2MCORE_SIM_APDU_CONFIG_OID   = 33408     ///< Sierra Wireless proprietary object Id: SIM APDU config
+    LWM2MCORE_SIM_APDU_CONFIG_OID   = 33408,    ///< Sierra Wireless proprietary object Id: SIM APDU config
+    LWM2MCORE_PERF_METRICS_OID      = 33409     ///< Sierra Wireless proprietary object Id: Performance metrics
 } lwm2mcore_objectEnum_t;
 
 //--------------------------------------------------------------------------------------------------
@@ -510,6 +547,30 @@ typedef enum
     LWM2MCORE_SIM_APDU_CONFIG_RESPONSE_RID = 2  ///< SIM APDU response
 } lwm2mcore_simApduConfigurationResource_t;
 
+#ifdef LWM2M_OBJECT_33409
+//--------------------------------------------------------------------------------------------------
+/**
+* @brief Enumeration for LwM2M object 33409 (performance metrics) resources
+*
+* The resources 0 to 4 have one instance per measured operation (lwm2mcore_Metric_t). The latency
+* histograms have LWM2MCORE_METRIC_BUCKETS instances per operation: the instance Id is
+* operation * LWM2MCORE_METRIC_BUCKETS + bucket. The counters have one instance per counter
+* (lwm2mcore_Counter_t).
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    LWM2MCORE_PERF_METRICS_NAME_RID = 0,        ///< Operation names
+    LWM2MCORE_PERF_METRICS_COUNT_RID,           ///< Number of measured operations
+    LWM2MCORE_PERF_METRICS_ERROR_COUNT_RID,     ///< Number of failed operations
+    LWM2MCORE_PERF_METRICS_TOTAL_TIME_RID,      ///< Cumulated duration of the operations in ms
+    LWM2MCORE_PERF_METRICS_MAX_TIME_RID,        ///< Longest operation in ms
+    LWM2MCORE_PERF_METRICS_HISTOGRAM_RID,       ///< Latency histograms
+    LWM2MCORE_PERF_METRICS_COUNTERS_RID,        ///< Counters
+    LWM2MCORE_PERF_METRICS_RESET_RID            ///< Reset the metrics
+} lwm2mcore_perfMetricsResource_t;
+#endif
+
 //--------------------------------------------------------------------------------------------------
 /**
  * @brief data structure represent the attribute.
@@ -519,13 +580,83 @@ typedef struct
 {
     int pmin;       ///< min value
     int pmax;       ///< max value
-    int gt;         ///< greater than
-    int lt;         ///< less than
-    int st;         ///< step
+    double gt;      ///< greater than
+    double lt;      ///< less than
+    double st;      ///< step
     int cancel;     ///< cancel observe
-    int mask;       ///< bitmask indicates what attributes are set
+    int mask;       ///< bitmask indicates what attributes are set (LWM2M_ATTR_FLAG_xxx)
 }lwm2m_attribute_t;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Result of the evaluation of a resource change against the observe attributes
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    OMANAGER_NOTIFY_SEND,       ///< The change has to be notified now
+    OMANAGER_NOTIFY_DEFER,      ///< The change will be notified when the minimum period elapses
+    OMANAGER_NOTIFY_SUPPRESS    ///< The change does not need to be notified
+}omanager_NotifyDecision_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Level of an observation covering a resource
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    OMANAGER_OBSERVE_OBJECT = 0,        ///< The object is observed
+    OMANAGER_OBSERVE_OBJECT_INSTANCE,   ///< The object instance is observed
+    OMANAGER_OBSERVE_RESOURCE           ///< The resource is observed
+}omanager_ObserveLevel_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Callback to notify a deferred resource change
+ */
+//--------------------------------------------------------------------------------------------------
+typedef void (*omanager_NotifyCallback_t)
+(
+    uint16_t oid,       ///< [IN] Object Id
+    uint16_t oiid,      ///< [IN] Object instance Id
+    uint16_t rid        ///< [IN] Resource Id
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Notification state of a resource for one observation of a server
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct _lwm2mcore_notifyState               /// See lwm2mcore_notifyState_t
+{
+    struct _lwm2mcore_notifyState* nextPtr;         ///< state of the next observation
+    uint16_t shortServerId;                         ///< short server Id of the observer
+    uint8_t level;                                  ///< observed level (omanager_ObserveLevel_t)
+    bool isNotified;                                ///< set if a value change was notified
+    uint64_t notifyTimeMs;                          ///< time of the last notification
+    double notifyValue;                             ///< last notified numeric value
+    uint32_t notifyHash;                            ///< hash of the last notified string/opaque
+                                                    ///< value
+    uint64_t notifyDeadlineMs;                      ///< time of a deferred notification, 0 if none
+}lwm2mcore_notifyState_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief State of a resource for one object instance
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct _lwm2mcore_resourceState             /// See lwm2mcore_resourceState_t
+{
+    struct _lwm2mcore_resourceState* nextPtr;       ///< state of the next object instance
+    uint16_t oiid;                                  ///< object instance id
+    bool isCacheValid;                              ///< set if cacheValue holds a read value
+    uint64_t cacheTimeMs;                           ///< time when the value was cached
+    lwm2mcore_Value_t cacheValue;                   ///< cached read value
+    char *cache;                                    ///< storage of a cached string/opaque value
+    lwm2mcore_notifyState_t* notifyPtr;             ///< notification state of each observation
+}lwm2mcore_resourceState_t;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * @brief data structure represents a LwM2M resource.
@@ -543,8 +674,12 @@ typedef struct _lwm2mcore_internalResource          /// See lwm2mcore_internalRe
     lwm2mcore_ReadCallback_t read;                  ///< operation handler: read handler
     lwm2mcore_WriteCallback_t write;                ///< operation handler: write handler
     lwm2mcore_ExecuteCallback_t exec;               ///< operation handler: execute handler
-    char *cache;                                    ///< cache value for observer (asynchronous
-                                                    ///< notification)
+    lwm2mcore_ReadValueCallback_t readValue;        ///< operation handler: typed read handler
+    lwm2mcore_WriteValueCallback_t writeValue;      ///< operation handler: typed write handler
+    lwm2mcore_ReadChunkCallback_t readChunk;        ///< operation handler: chunked read handler
+    uint32_t cacheTtl;                              ///< cache policy of the read value (ms)
+    lwm2mcore_resourceState_t* statePtr;            ///< state of each object instance
+    lwm2mcore_Resource_t* tableResourcePtr;         ///< resource entry in the registered table
 }lwm2mcore_internalResource_t;
 
 //--------------------------------------------------------------------------------------------------
@@ -568,6 +703,7 @@ typedef struct _lwm2mcore_internalObject            /// See lwm2mcore_internalOb
                                                     ///< instances
     lwm2m_attribute_t attr;                         ///< object attributes
     struct _lwm2m_resource_list resource_list;      ///< resource linked list
+    lwm2mcore_SnapshotCallback_t snapshot;          ///< snapshot handler for full object read
 }lwm2mcore_internalObject_t;
 
 //--------------------------------------------------------------------------------------------------
@@ -577,6 +713,45 @@ typedef struct _lwm2mcore_internalObject            /// See lwm2mcore_internalOb
 //--------------------------------------------------------------------------------------------------
 DLIST_HEAD(_lwm2mcore_objectsList, _lwm2mcore_internalObject);
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Entry of the object lookup index (sorted by object Id)
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint16_t oid;                                   ///< object id
+    uint32_t order;                                 ///< position in the object list
+    lwm2mcore_internalObject_t* objPtr;             ///< first registered object with this id
+}lwm2mcore_objectIndex_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Entry of the resource lookup index (sorted by object Id and resource Id)
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t key;                                   ///< (object id << 16) | resource id
+    uint32_t order;                                 ///< position in the resource list
+    lwm2mcore_internalObject_t* objPtr;             ///< object owning the resource
+    lwm2mcore_internalResource_t* resourcePtr;      ///< resource
+}lwm2mcore_resourceIndex_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Lookup index built on top of the object list, in order to avoid walking the linked lists
+ * on each request
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    lwm2mcore_objectIndex_t*   objectsPtr;          ///< object entries
+    uint16_t                   objectCount;         ///< number of object entries
+    lwm2mcore_resourceIndex_t* resourcesPtr;        ///< resource entries
+    uint32_t                   resourceCount;       ///< number of resource entries
+}lwm2mcore_objectsIndex_t;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * @brief Free the registered objects and resources (LwM2MCore and Wakaama)
@@ -609,6 +784,73 @@ void omanager_FreeObjectByInstanceId
     uint16_t    objectInstanceId    ///< [IN] Object instance Id to remove
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Invalidate the cached read value of a resource
+ */
+//--------------------------------------------------------------------------------------------------
+void omanager_InvalidateResourceCache
+(
+    uint16_t oid,       ///< [IN] Object Id
+    uint16_t oiid,      ///< [IN] Object instance Id
+    uint16_t rid        ///< [IN] Resource Id
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Evaluate a resource change against the observe attributes (pmin, pmax, gt, lt, st) of one
+ * observation.
+ *
+ * The current value is read and compared to the last value notified for this observation:
+ * unchanged values, and numeric values which neither cross a threshold nor move by the step, are
+ * suppressed. A change occurring before the minimum period is deferred and later reported by
+ * omanager_ProcessDeferredNotifications(). Each server observation keeps its own notified value,
+ * so that the attributes of a server never gate the notifications of another one.
+ *
+ * @return
+ *  - OMANAGER_NOTIFY_SEND if the change has to be notified now
+ *  - OMANAGER_NOTIFY_DEFER if the change is deferred
+ *  - OMANAGER_NOTIFY_SUPPRESS if the change does not need to be notified
+ */
+//--------------------------------------------------------------------------------------------------
+omanager_NotifyDecision_t omanager_CheckNotification
+(
+    uint16_t oid,                       ///< [IN] Object Id
+    uint16_t oiid,                      ///< [IN] Object instance Id
+    uint16_t rid,                       ///< [IN] Resource Id
+    uint16_t shortServerId,             ///< [IN] Short server Id of the observer
+    omanager_ObserveLevel_t level,      ///< [IN] Observed level
+    const lwm2m_attribute_t* attrPtr    ///< [IN] Observe attributes of the observation
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Release the request arena: called once before each CoAP request or notification is
+ * treated.
+ *
+ * The temporary data allocated in the arena while a request is treated stay valid until the next
+ * release.
+ */
+//--------------------------------------------------------------------------------------------------
+void omanager_ReleaseRequestMemory
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Report the deferred notifications whose minimum period elapsed
+ *
+ * @return
+ *  - Delay in ms until the next deferred notification
+ *  - UINT32_MAX if no notification is deferred
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t omanager_ProcessDeferredNotifications
+(
+    omanager_NotifyCallback_t notifyCb  ///< [IN] Callback to notify a resource change
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * @brief Private function to send an update message to the Device Management server
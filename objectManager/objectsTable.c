@@ -12,6 +12,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <lwm2mcore/lwm2mcore.h>
+#include <lwm2mcore/metrics.h>
 #include "objects.h"
 #include "handlers.h"
 #include "clientConfig.h"
@@ -46,6 +47,10 @@ static lwm2mcore_Resource_t SecurityResources[] =
         omanager_ReadSecurityObj,                   //.read
         omanager_WriteSecurityObj,                  //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_SECURITY_BOOTSTRAP_SERVER_RID,    //.id
@@ -54,6 +59,10 @@ static lwm2mcore_Resource_t SecurityResources[] =
         omanager_ReadSecurityObj,                   //.read
         omanager_WriteSecurityObj,                  //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_SECURITY_MODE_RID,                //.id
@@ -62,6 +71,10 @@ static lwm2mcore_Resource_t SecurityResources[] =
         omanager_ReadSecurityObj,                   //.read
         omanager_WriteSecurityObj,                  //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_SECURITY_PKID_RID,                //.id
@@ -70,6 +83,10 @@ static lwm2mcore_Resource_t SecurityResources[] =
         omanager_ReadSecurityObj,                   //.read
         omanager_WriteSecurityObj,                  //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_SECURITY_SERVER_KEY_RID,          //.id
@@ -78,6 +95,10 @@ static lwm2mcore_Resource_t SecurityResources[] =
         omanager_ReadSecurityObj,                   //.read
         omanager_WriteSecurityObj,                  //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_SECURITY_SECRET_KEY_RID,          //.id
@@ -86,6 +107,10 @@ static lwm2mcore_Resource_t SecurityResources[] =
         omanager_ReadSecurityObj,                   //.read
         omanager_WriteSecurityObj,                  //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_SECURITY_SMS_SECURITY_MODE_RID,   //.id
@@ -94,6 +119,10 @@ static lwm2mcore_Resource_t SecurityResources[] =
         NULL,                                       //.read
         omanager_SmsDummy,                          //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_SECURITY_SMS_BINDING_KEY_PAR_RID, //.id
@@ -102,6 +131,10 @@ static lwm2mcore_Resource_t SecurityResources[] =
         NULL,                                       //.read
         omanager_SmsDummy,                          //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_SECURITY_SMS_BINDING_SEC_KEY_RID, //.id
@@ -110,6 +143,10 @@ static lwm2mcore_Resource_t SecurityResources[] =
         NULL,                                       //.read
         omanager_SmsDummy,                          //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_SECURITY_SERVER_SMS_NUMBER_RID,   //.id
@@ -118,6 +155,10 @@ static lwm2mcore_Resource_t SecurityResources[] =
         NULL,                                       //.read
         omanager_SmsDummy,                          //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_SECURITY_SERVER_ID_RID,           //.id
@@ -126,6 +167,10 @@ static lwm2mcore_Resource_t SecurityResources[] =
         omanager_ReadSecurityObj,                   //.read
         omanager_WriteSecurityObj,                  //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_SECURITY_CLIENT_HOLD_OFF_TIME_RID, //.id
@@ -134,6 +179,10 @@ static lwm2mcore_Resource_t SecurityResources[] =
         omanager_ReadSecurityObj,                    //.read
         omanager_WriteSecurityObj,                   //.write
         NULL,                                        //.exec
+        NULL,                                        //.readValue
+        NULL,                                        //.writeValue
+        NULL,                                        //.readChunk
+        LWM2MCORE_CACHE_NEVER,                       //.cacheTtl
     },
     {
         LWM2MCORE_SECURITY_BS_ACCOUNT_TIMEOUT_RID,   //.id
@@ -142,6 +191,10 @@ static lwm2mcore_Resource_t SecurityResources[] =
         omanager_ReadSecurityObj,                    //.read
         omanager_WriteSecurityObj,                   //.write
         NULL,                                        //.exec
+        NULL,                                        //.readValue
+        NULL,                                        //.writeValue
+        NULL,                                        //.readChunk
+        LWM2MCORE_CACHE_NEVER,                       //.cacheTtl
     }
 };
 
@@ -161,6 +214,10 @@ static lwm2mcore_Resource_t ServerResources[] =
         omanager_ReadServerObj,                     //.read
         omanager_WriteServerObj,                    //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_SERVER_LIFETIME_RID,              //.id
@@ -169,6 +226,10 @@ static lwm2mcore_Resource_t ServerResources[] =
         omanager_ReadServerObj,                     //.read
         omanager_WriteServerObj,                    //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_SERVER_DEFAULT_MIN_PERIOD_RID,    //.id
@@ -177,6 +238,10 @@ static lwm2mcore_Resource_t ServerResources[] =
         omanager_ReadServerObj,                     //.read
         omanager_WriteServerObj,                    //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_SERVER_DEFAULT_MAX_PERIOD_RID,    //.id
@@ -185,6 +250,10 @@ static lwm2mcore_Resource_t ServerResources[] =
         omanager_ReadServerObj,                     //.read
         omanager_WriteServerObj,                    //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_SERVER_DISABLE_TIMEOUT_RID,       //.id
@@ -193,6 +262,10 @@ static lwm2mcore_Resource_t ServerResources[] =
         omanager_ReadServerObj,                     //.read
         omanager_WriteServerObj,                    //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_SERVER_STORE_NOTIF_WHEN_OFFLINE_RID,  //.id
@@ -201,6 +274,10 @@ static lwm2mcore_Resource_t ServerResources[] =
         omanager_ReadServerObj,                         //.read
         omanager_WriteServerObj,                        //.write
         NULL,                                           //.exec
+        NULL,                                           //.readValue
+        NULL,                                           //.writeValue
+        NULL,                                           //.readChunk
+        LWM2MCORE_CACHE_NEVER,                          //.cacheTtl
     },
     {
         LWM2MCORE_SERVER_BINDING_MODE_RID,          //.id
@@ -209,6 +286,10 @@ static lwm2mcore_Resource_t ServerResources[] =
         omanager_ReadServerObj,                     //.read
         omanager_WriteServerObj,                    //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     }
 };
 
@@ -228,6 +309,10 @@ static lwm2mcore_Resource_t AclResources[] =
         omanager_ReadAclObj,                    //.read
         omanager_WriteAclObj,                   //.write
         NULL,                                   //.exec
+        NULL,                                   //.readValue
+        NULL,                                   //.writeValue
+        NULL,                                   //.readChunk
+        LWM2MCORE_CACHE_NEVER,                  //.cacheTtl
     },
     {
         LWM2MCORE_ACL_OBJECT_INSTANCE_ID_RID,   //.id
@@ -236,6 +321,10 @@ static lwm2mcore_Resource_t AclResources[] =
         omanager_ReadAclObj,                    //.read
         omanager_WriteAclObj,                   //.write
         NULL,                                   //.exec
+        NULL,                                   //.readValue
+        NULL,                                   //.writeValue
+        NULL,                                   //.readChunk
+        LWM2MCORE_CACHE_NEVER,                  //.cacheTtl
     },
     {
         LWM2MCORE_ACL_ACCESS_CONTROL_ID,        //.id
@@ -244,6 +333,10 @@ static lwm2mcore_Resource_t AclResources[] =
         omanager_ReadAclObj,                    //.read
         omanager_WriteAclObj,                   //.write
         NULL,                                   //.exec
+        NULL,                                   //.readValue
+        NULL,                                   //.writeValue
+        NULL,                                   //.readChunk
+        LWM2MCORE_CACHE_NEVER,                  //.cacheTtl
     },
     {
         LWM2MCORE_ACL_OWNER_RID,                //.id
@@ -252,6 +345,10 @@ static lwm2mcore_Resource_t AclResources[] =
         omanager_ReadAclObj,                    //.read
         omanager_WriteAclObj,                   //.write
         NULL,                                   //.exec
+        NULL,                                   //.readValue
+        NULL,                                   //.writeValue
+        NULL,                                   //.readChunk
+        LWM2MCORE_CACHE_NEVER,                  //.cacheTtl
     }
 };
 
@@ -271,6 +368,10 @@ static lwm2mcore_Resource_t DeviceResources[] =
         omanager_ReadDeviceObj,                     //.read
         NULL,                                       //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_STATIC,                     //.cacheTtl
     },
     {
         LWM2MCORE_DEVICE_MODEL_NUMBER_RID,          //.id
@@ -279,6 +380,10 @@ static lwm2mcore_Resource_t DeviceResources[] =
         omanager_ReadDeviceObj,                     //.read
         NULL,                                       //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_STATIC,                     //.cacheTtl
     },
     {
         LWM2MCORE_DEVICE_SERIAL_NUMBER_RID,         //.id
@@ -287,6 +392,10 @@ static lwm2mcore_Resource_t DeviceResources[] =
         omanager_ReadDeviceObj,                     //.read
         NULL,                                       //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_STATIC,                     //.cacheTtl
     },
     {
         LWM2MCORE_DEVICE_FIRMWARE_VERSION_RID,      //.id
@@ -295,6 +404,10 @@ static lwm2mcore_Resource_t DeviceResources[] =
         omanager_ReadDeviceObj,                     //.read
         NULL,                                       //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_DEVICE_REBOOT_RID,                //.id
@@ -303,6 +416,10 @@ static lwm2mcore_Resource_t DeviceResources[] =
         NULL,                                       //.read
         NULL,                                       //.write
         omanager_ExecDeviceObj,                     //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_DEVICE_AVAIL_POWER_SOURCES_RID,   //.id
@@ -311,6 +428,10 @@ static lwm2mcore_Resource_t DeviceResources[] =
         omanager_ReadDeviceObj,                     //.read
         NULL,                                       //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_DEVICE_AVAIL_POWER_VOLTAGES_RID,  //.id
@@ -319,6 +440,10 @@ static lwm2mcore_Resource_t DeviceResources[] =
         omanager_ReadDeviceObj,                     //.read
         NULL,                                       //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_DEVICE_AVAIL_POWER_CURRENTS_RID,  //.id
@@ -327,6 +452,10 @@ static lwm2mcore_Resource_t DeviceResources[] =
         omanager_ReadDeviceObj,                     //.read
         NULL,                                       //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_DEVICE_BATTERY_LEVEL_RID,         //.id
@@ -335,6 +464,10 @@ static lwm2mcore_Resource_t DeviceResources[] =
         omanager_ReadDeviceObj,                     //.read
         NULL,                                       //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_DEVICE_CURRENT_TIME_RID,          //.id
@@ -343,6 +476,10 @@ static lwm2mcore_Resource_t DeviceResources[] =
         omanager_ReadDeviceObj,                     //.read
         omanager_WriteDeviceObj,                    //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_DEVICE_SUPPORTED_BINDING_MODE_RID, //.id
@@ -351,6 +488,10 @@ static lwm2mcore_Resource_t DeviceResources[] =
         omanager_ReadDeviceObj,                     //.read
         omanager_WriteDeviceObj,                    //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_DEVICE_BATTERY_STATUS_RID,        //.id
@@ -359,6 +500,10 @@ static lwm2mcore_Resource_t DeviceResources[] =
         omanager_ReadDeviceObj,                     //.read
         NULL,                                       //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     }
 };
 
@@ -375,9 +520,13 @@ static lwm2mcore_Resource_t ConnectivityMonitoringResources[] =
         LWM2MCORE_CONN_MONITOR_NETWORK_BEARER_RID,          //.id
         LWM2MCORE_RESOURCE_TYPE_INT,                        //.type
         1,                                                  //.maxResInstCnt
-        omanager_ReadConnectivityMonitoringObj,             //.read
+        NULL,                                               //.read
         NULL,                                               //.write
         NULL,                                               //.exec
+        omanager_ReadConnectivityMonitoringValue,           //.readValue
+        NULL,                                               //.writeValue
+        NULL,                                               //.readChunk
+        LWM2MCORE_CACHE_NEVER,                              //.cacheTtl
     },
     {
         LWM2MCORE_CONN_MONITOR_AVAIL_NETWORK_BEARER_RID,    //.id
@@ -386,22 +535,34 @@ static lwm2mcore_Resource_t ConnectivityMonitoringResources[] =
         omanager_ReadConnectivityMonitoringObj,                      //.read
         NULL,                                               //.write
         NULL,                                               //.exec
+        NULL,                                               //.readValue
+        NULL,                                               //.writeValue
+        NULL,                                               //.readChunk
+        LWM2MCORE_CACHE_NEVER,                              //.cacheTtl
     },
     {
         LWM2MCORE_CONN_MONITOR_RADIO_SIGNAL_STRENGTH_RID,   //.id
         LWM2MCORE_RESOURCE_TYPE_INT,                        //.type
         1,                                                  //.maxResInstCnt
-        omanager_ReadConnectivityMonitoringObj,             //.read
+        NULL,                                               //.read
         NULL,                                               //.write
         NULL,                                               //.exec
+        omanager_ReadConnectivityMonitoringValue,           //.readValue
+        NULL,                                               //.writeValue
+        NULL,                                               //.readChunk
+        5000,                                               //.cacheTtl
     },
     {
         LWM2MCORE_CONN_MONITOR_LINK_QUALITY_RID,            //.id
         LWM2MCORE_RESOURCE_TYPE_INT,                        //.type
         1,                                                  //.maxResInstCnt
-        omanager_ReadConnectivityMonitoringObj,             //.read
+        NULL,                                               //.read
         NULL,                                               //.write
         NULL,                                               //.exec
+        omanager_ReadConnectivityMonitoringValue,           //.readValue
+        NULL,                                               //.writeValue
+        NULL,                                               //.readChunk
+        5000,                                               //.cacheTtl
     },
     {
         LWM2MCORE_CONN_MONITOR_IP_ADDRESSES_RID,            //.id
@@ -410,6 +571,10 @@ static lwm2mcore_Resource_t ConnectivityMonitoringResources[] =
         omanager_ReadConnectivityMonitoringObj,             //.read
         NULL,                                               //.write
         NULL,                                               //.exec
+        NULL,                                               //.readValue
+        NULL,                                               //.writeValue
+        NULL,                                               //.readChunk
+        LWM2MCORE_CACHE_NEVER,                              //.cacheTtl
     },
     {
         LWM2MCORE_CONN_MONITOR_ROUTER_IP_ADDRESSES_RID,     //.id
@@ -418,14 +583,22 @@ static lwm2mcore_Resource_t ConnectivityMonitoringResources[] =
         omanager_ReadConnectivityMonitoringObj,             //.read
         NULL,                                               //.write
         NULL,                                               //.exec
+        NULL,                                               //.readValue
+        NULL,                                               //.writeValue
+        NULL,                                               //.readChunk
+        LWM2MCORE_CACHE_NEVER,                              //.cacheTtl
     },
     {
         LWM2MCORE_CONN_MONITOR_LINK_UTILIZATION_RID,        //.id
         LWM2MCORE_RESOURCE_TYPE_INT,                        //.type
         1,                                                  //.maxResInstCnt
-        omanager_ReadConnectivityMonitoringObj,             //.read
+        NULL,                                               //.read
         NULL,                                               //.write
         NULL,                                               //.exec
+        omanager_ReadConnectivityMonitoringValue,           //.readValue
+        NULL,                                               //.writeValue
+        NULL,                                               //.readChunk
+        LWM2MCORE_CACHE_NEVER,                              //.cacheTtl
     },
     {
         LWM2MCORE_CONN_MONITOR_APN_RID,                     //.id
@@ -434,30 +607,46 @@ static lwm2mcore_Resource_t ConnectivityMonitoringResources[] =
         omanager_ReadConnectivityMonitoringObj,             //.read
         NULL,                                               //.write
         NULL,                                               //.exec
+        NULL,                                               //.readValue
+        NULL,                                               //.writeValue
+        NULL,                                               //.readChunk
+        LWM2MCORE_CACHE_NEVER,                              //.cacheTtl
     },
     {
         LWM2MCORE_CONN_MONITOR_CELL_ID_RID,                 //.id
         LWM2MCORE_RESOURCE_TYPE_INT,                        //.type
         1,                                                  //.maxResInstCnt
-        omanager_ReadConnectivityMonitoringObj,             //.read
+        NULL,                                               //.read
         NULL,                                               //.write
         NULL,                                               //.exec
+        omanager_ReadConnectivityMonitoringValue,           //.readValue
+        NULL,                                               //.writeValue
+        NULL,                                               //.readChunk
+        LWM2MCORE_CACHE_NEVER,                              //.cacheTtl
     },
     {
         LWM2MCORE_CONN_MONITOR_SMNC_RID,                    //.id
         LWM2MCORE_RESOURCE_TYPE_INT,                        //.type
         1,                                                  //.maxResInstCnt
-        omanager_ReadConnectivityMonitoringObj,             //.read
+        NULL,                                               //.read
         NULL,                                               //.write
         NULL,                                               //.exec
+        omanager_ReadConnectivityMonitoringValue,           //.readValue
+        NULL,                                               //.writeValue
+        NULL,                                               //.readChunk
+        LWM2MCORE_CACHE_NEVER,                              //.cacheTtl
     },
     {
         LWM2MCORE_CONN_MONITOR_SMCC_RID,                    //.id
         LWM2MCORE_RESOURCE_TYPE_INT,                        //.type
         1,                                                  //.maxResInstCnt
-        omanager_ReadConnectivityMonitoringObj,             //.read
+        NULL,                                               //.read
         NULL,                                               //.write
         NULL,                                               //.exec
+        omanager_ReadConnectivityMonitoringValue,           //.readValue
+        NULL,                                               //.writeValue
+        NULL,                                               //.readChunk
+        LWM2MCORE_CACHE_NEVER,                              //.cacheTtl
     }
 };
 
@@ -476,7 +665,11 @@ static lwm2mcore_Resource_t FirmwareUpdateResources[] =
         1,                                          //.maxResInstCnt
         NULL,                                       //.read
         omanager_WriteFwUpdateObj,                  //.write
-        NULL                                        //.exec
+        NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_FW_UPDATE_PACKAGE_URI_RID,        //.id
@@ -484,7 +677,11 @@ static lwm2mcore_Resource_t FirmwareUpdateResources[] =
         1,                                          //.maxResInstCnt
         omanager_ReadFwUpdateObj,                   //.read
         omanager_WriteFwUpdateObj,                  //.write
-        NULL                                        //.exec
+        NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_FW_UPDATE_UPDATE_RID,             //.id
@@ -493,6 +690,10 @@ static lwm2mcore_Resource_t FirmwareUpdateResources[] =
         NULL,                                       //.read
         NULL,                                       //.write
         omanager_ExecFwUpdate,                      //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_FW_UPDATE_UPDATE_STATE_RID,       //.id
@@ -500,7 +701,11 @@ static lwm2mcore_Resource_t FirmwareUpdateResources[] =
         1,                                          //.maxResInstCnt
         omanager_ReadFwUpdateObj,                   //.read
         NULL,                                       //.write
-        NULL                                        //.exec
+        NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_FW_UPDATE_UPDATE_RESULT_RID,      //.id
@@ -508,7 +713,11 @@ static lwm2mcore_Resource_t FirmwareUpdateResources[] =
         1,                                          //.maxResInstCnt
         omanager_ReadFwUpdateObj,                   //.read
         NULL,                                       //.write
-        NULL                                        //.exec
+        NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_FW_UPDATE_PROTO_SUPPORT_RID,      //.id
@@ -516,7 +725,11 @@ static lwm2mcore_Resource_t FirmwareUpdateResources[] =
         2,                                          //.maxResInstCnt
         omanager_ReadFwUpdateObj,                   //.read
         NULL,                                       //.write
-        NULL                                        //.exec
+        NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_FW_UPDATE_DELIVERY_METHOD_RID,    //.id
@@ -524,7 +737,11 @@ static lwm2mcore_Resource_t FirmwareUpdateResources[] =
         1,                                          //.maxResInstCnt
         omanager_ReadFwUpdateObj,                   //.read
         NULL,                                       //.write
-        NULL                                        //.exec
+        NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     }
 };
 
@@ -548,6 +765,10 @@ static lwm2mcore_Resource_t LocationResources[] =
         omanager_ReadLocationObj,                   //.read
         NULL,                                       //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_LOCATION_LONGITUDE_RID,           //.id
@@ -560,6 +781,10 @@ static lwm2mcore_Resource_t LocationResources[] =
         omanager_ReadLocationObj,                   //.read
         NULL,                                       //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_LOCATION_ALTITUDE_RID,            //.id
@@ -572,6 +797,10 @@ static lwm2mcore_Resource_t LocationResources[] =
         omanager_ReadLocationObj,                   //.read
         NULL,                                       //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_LOCATION_VELOCITY_RID,            //.id
@@ -580,6 +809,10 @@ static lwm2mcore_Resource_t LocationResources[] =
         omanager_ReadLocationObj,                   //.read
         NULL,                                       //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_LOCATION_TIMESTAMP_RID,           //.id
@@ -588,6 +821,10 @@ static lwm2mcore_Resource_t LocationResources[] =
         omanager_ReadLocationObj,                   //.read
         NULL,                                       //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     }
 };
 
@@ -607,6 +844,10 @@ static lwm2mcore_Resource_t ConnectivityStatisticsResources[] =
         omanager_ReadConnectivityStatisticsObj,     //.read
         NULL,                                       //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_CONN_STATS_RX_SMS_COUNT_RID,      //.id
@@ -615,6 +856,10 @@ static lwm2mcore_Resource_t ConnectivityStatisticsResources[] =
         omanager_ReadConnectivityStatisticsObj,     //.read
         NULL,                                       //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_CONN_STATS_TX_DATA_COUNT_RID,     //.id
@@ -623,6 +868,10 @@ static lwm2mcore_Resource_t ConnectivityStatisticsResources[] =
         omanager_ReadConnectivityStatisticsObj,     //.read
         NULL,                                       //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_CONN_STATS_RX_DATA_COUNT_RID,     //.id
@@ -631,6 +880,10 @@ static lwm2mcore_Resource_t ConnectivityStatisticsResources[] =
         omanager_ReadConnectivityStatisticsObj,     //.read
         NULL,                                       //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_CONN_STATS_START_RID,             //.id
@@ -639,6 +892,10 @@ static lwm2mcore_Resource_t ConnectivityStatisticsResources[] =
         NULL,                                       //.read
         NULL,                                       //.write
         omanager_ExecConnectivityStatistics,        //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_CONN_STATS_STOP_RID,              //.id
@@ -647,6 +904,10 @@ static lwm2mcore_Resource_t ConnectivityStatisticsResources[] =
         NULL,                                       //.read
         NULL,                                       //.write
         omanager_ExecConnectivityStatistics,        //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     }
 };
 
@@ -666,6 +927,10 @@ static lwm2mcore_Resource_t SoftwareUpdateResources[] =
         omanager_ReadSwUpdateObj,                   //.read
         NULL,                                       //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_SW_UPDATE_PACKAGE_VERSION_RID,    //.id
@@ -674,6 +939,10 @@ static lwm2mcore_Resource_t SoftwareUpdateResources[] =
         omanager_ReadSwUpdateObj,                   //.read
         NULL,                                       //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_SW_UPDATE_PACKAGE_URI_RID,        //.id
@@ -682,6 +951,10 @@ static lwm2mcore_Resource_t SoftwareUpdateResources[] =
         NULL,                                       //.read
         omanager_WriteSwUpdateObj,                  //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_SW_UPDATE_INSTALL_RID,            //.id
@@ -690,6 +963,10 @@ static lwm2mcore_Resource_t SoftwareUpdateResources[] =
         NULL,                                       //.read
         NULL,                                       //.write
         omanager_ExecSwUpdate,                      //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_SW_UPDATE_UNINSTALL_RID,          //.id
@@ -698,6 +975,10 @@ static lwm2mcore_Resource_t SoftwareUpdateResources[] =
         NULL,                                       //.read
         NULL,                                       //.write
         omanager_ExecSwUpdate,                      //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_SW_UPDATE_UPDATE_STATE_RID,       //.id
@@ -706,6 +987,10 @@ static lwm2mcore_Resource_t SoftwareUpdateResources[] =
         omanager_ReadSwUpdateObj,                   //.read
         NULL,                                       //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_SW_UPDATE_UPDATE_SUPPORTED_OBJ_RID, //.id
@@ -714,6 +999,10 @@ static lwm2mcore_Resource_t SoftwareUpdateResources[] =
         omanager_ReadSwUpdateObj,                   //.read
         omanager_WriteSwUpdateObj,                  //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_SW_UPDATE_UPDATE_RESULT_RID,      //.id
@@ -722,6 +1011,10 @@ static lwm2mcore_Resource_t SoftwareUpdateResources[] =
         omanager_ReadSwUpdateObj,                   //.read
         NULL,                                       //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_SW_UPDATE_ACTIVATE_RID,           //.id
@@ -730,6 +1023,10 @@ static lwm2mcore_Resource_t SoftwareUpdateResources[] =
         NULL,                                       //.read
         NULL,                                       //.write
         omanager_ExecSwUpdate,                      //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_SW_UPDATE_DEACTIVATE_RID,         //.id
@@ -738,6 +1035,10 @@ static lwm2mcore_Resource_t SoftwareUpdateResources[] =
         NULL,                                       //.read
         NULL,                                       //.write
         omanager_ExecSwUpdate,                      //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_SW_UPDATE_ACTIVATION_STATE_RID,   //.id
@@ -746,6 +1047,10 @@ static lwm2mcore_Resource_t SoftwareUpdateResources[] =
         omanager_ReadSwUpdateObj,                   //.read
         NULL,                                       //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     }
 };
 
@@ -765,6 +1070,10 @@ static lwm2mcore_Resource_t CellularConnectivityResources[] =
         omanager_ReadCellularConnectivityObj,       //.read
         omanager_WriteCellularConnectivityObj,      //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_CELL_CONN_DISABLE_RADIO_PERIOD_RID, //.id
@@ -773,6 +1082,10 @@ static lwm2mcore_Resource_t CellularConnectivityResources[] =
         omanager_ReadCellularConnectivityObj,       //.read
         omanager_WriteCellularConnectivityObj,      //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_CELL_CONN_MOD_ACTIVATION_CODE_RID,  //.id
@@ -781,6 +1094,10 @@ static lwm2mcore_Resource_t CellularConnectivityResources[] =
         omanager_ReadCellularConnectivityObj,       //.read
         omanager_WriteCellularConnectivityObj,      //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_CELL_CONN_PSM_TIMER_RID,          //.id
@@ -789,6 +1106,10 @@ static lwm2mcore_Resource_t CellularConnectivityResources[] =
         omanager_ReadCellularConnectivityObj,       //.read
         omanager_WriteCellularConnectivityObj,      //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_CELL_CONN_ACTIVE_TIMER_RID,       //.id
@@ -797,6 +1118,10 @@ static lwm2mcore_Resource_t CellularConnectivityResources[] =
         omanager_ReadCellularConnectivityObj,       //.read
         omanager_WriteCellularConnectivityObj,      //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_CELL_CONN_SERV_PLMN_RATE_CTRL_RID,  //.id
@@ -805,6 +1130,10 @@ static lwm2mcore_Resource_t CellularConnectivityResources[] =
         omanager_ReadCellularConnectivityObj,       //.read
         NULL,                                       //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_CELL_CONN_EDRX_PARAM_IU_MODE_RID,   //.id
@@ -813,6 +1142,10 @@ static lwm2mcore_Resource_t CellularConnectivityResources[] =
         omanager_ReadCellularConnectivityObj,       //.read
         omanager_WriteCellularConnectivityObj,      //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_CELL_CONN_EDRX_PARAM_WB_S1_MODE_RID, //.id
@@ -821,6 +1154,10 @@ static lwm2mcore_Resource_t CellularConnectivityResources[] =
         omanager_ReadCellularConnectivityObj,       //.read
         omanager_WriteCellularConnectivityObj,      //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_CELL_CONN_EDRX_PARAM_NB_S1_MODE_RID, //.id
@@ -829,6 +1166,10 @@ static lwm2mcore_Resource_t CellularConnectivityResources[] =
         omanager_ReadCellularConnectivityObj,       //.read
         omanager_WriteCellularConnectivityObj,      //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_CELL_CONN_EDRX_PARAM_AGB_MODE_RID,  //.id
@@ -837,6 +1178,10 @@ static lwm2mcore_Resource_t CellularConnectivityResources[] =
         omanager_ReadCellularConnectivityObj,       //.read
         omanager_WriteCellularConnectivityObj,      //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_CELL_CONN_ACTIVATED_PROFILE_NAME_RID, //.id
@@ -845,6 +1190,10 @@ static lwm2mcore_Resource_t CellularConnectivityResources[] =
         omanager_ReadCellularConnectivityObj,       //.read
         NULL,                                       //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     }
 };
 
@@ -864,6 +1213,10 @@ static lwm2mcore_Resource_t SubscriptionResources[] =
         omanager_ReadSubscriptionObj,               //.read
         NULL,                                       //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_STATIC,                     //.cacheTtl
     },
     {
         LWM2MCORE_SUBSCRIPTION_ICCID_RID,           //.id
@@ -872,6 +1225,10 @@ static lwm2mcore_Resource_t SubscriptionResources[] =
         omanager_ReadSubscriptionObj,               //.read
         NULL,                                       //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_SUBSCRIPTION_IDENTITY_RID,        //.id
@@ -880,6 +1237,10 @@ static lwm2mcore_Resource_t SubscriptionResources[] =
         omanager_ReadSubscriptionObj,               //.read
         NULL,                                       //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_SUBSCRIPTION_MSISDN_RID,          //.id
@@ -888,6 +1249,10 @@ static lwm2mcore_Resource_t SubscriptionResources[] =
         omanager_ReadSubscriptionObj,               //.read
         NULL,                                       //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_SUBSCRIPTION_SIM_MODE_RID,        //.id
@@ -896,6 +1261,10 @@ static lwm2mcore_Resource_t SubscriptionResources[] =
         NULL,                                       //.read
         NULL,                                       //.write
         omanager_ExecSubscriptionObj,               //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_SUBSCRIPTION_CURRENT_SIM_RID,     //.id
@@ -904,6 +1273,10 @@ static lwm2mcore_Resource_t SubscriptionResources[] =
         omanager_ReadSubscriptionObj,               //.read
         NULL,                                       //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_SUBSCRIPTION_CURRENT_SIM_MODE_RID,//.id
@@ -912,6 +1285,10 @@ static lwm2mcore_Resource_t SubscriptionResources[] =
         omanager_ReadSubscriptionObj,               //.read
         NULL,                                       //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     },
     {
         LWM2MCORE_SUBSCRIPTION_SIM_SWITCH_STATUS_RID,//.id
@@ -920,6 +1297,10 @@ static lwm2mcore_Resource_t SubscriptionResources[] =
         omanager_ReadSubscriptionObj,               //.read
         NULL,                                       //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     }
 };
 
@@ -940,6 +1321,10 @@ static lwm2mcore_Resource_t ExtConnectivityStatsResources[] =
         omanager_ReadExtConnectivityStatsObj,           //.read
         NULL,                                           //.write
         NULL,                                           //.exec
+        NULL,                                           //.readValue
+        NULL,                                           //.writeValue
+        NULL,                                           //.readChunk
+        5000,                                           //.cacheTtl
     },
     {
         LWM2MCORE_EXT_CONN_STATS_CELLULAR_TECH_RID,     //.id
@@ -948,6 +1333,10 @@ static lwm2mcore_Resource_t ExtConnectivityStatsResources[] =
         omanager_ReadExtConnectivityStatsObj,           //.read
         NULL,                                           //.write
         NULL,                                           //.exec
+        NULL,                                           //.readValue
+        NULL,                                           //.writeValue
+        NULL,                                           //.readChunk
+        LWM2MCORE_CACHE_NEVER,                          //.cacheTtl
     },
     {
         LWM2MCORE_EXT_CONN_STATS_ROAMING_RID,           //.id
@@ -956,6 +1345,10 @@ static lwm2mcore_Resource_t ExtConnectivityStatsResources[] =
         omanager_ReadExtConnectivityStatsObj,           //.read
         NULL,                                           //.write
         NULL,                                           //.exec
+        NULL,                                           //.readValue
+        NULL,                                           //.writeValue
+        NULL,                                           //.readChunk
+        LWM2MCORE_CACHE_NEVER,                          //.cacheTtl
     },
     {
         LWM2MCORE_EXT_CONN_STATS_ECIO_RID,              //.id
@@ -964,6 +1357,10 @@ static lwm2mcore_Resource_t ExtConnectivityStatsResources[] =
         omanager_ReadExtConnectivityStatsObj,           //.read
         NULL,                                           //.write
         NULL,                                           //.exec
+        NULL,                                           //.readValue
+        NULL,                                           //.writeValue
+        NULL,                                           //.readChunk
+        LWM2MCORE_CACHE_NEVER,                          //.cacheTtl
     },
     {
         LWM2MCORE_EXT_CONN_STATS_RSRP_RID,              //.id
@@ -972,6 +1369,10 @@ static lwm2mcore_Resource_t ExtConnectivityStatsResources[] =
         omanager_ReadExtConnectivityStatsObj,           //.read
         NULL,                                           //.write
         NULL,                                           //.exec
+        NULL,                                           //.readValue
+        NULL,                                           //.writeValue
+        NULL,                                           //.readChunk
+        5000,                                           //.cacheTtl
     },
     {
         LWM2MCORE_EXT_CONN_STATS_RSRQ_RID,              //.id
@@ -980,6 +1381,10 @@ static lwm2mcore_Resource_t ExtConnectivityStatsResources[] =
         omanager_ReadExtConnectivityStatsObj,           //.read
         NULL,                                           //.write
         NULL,                                           //.exec
+        NULL,                                           //.readValue
+        NULL,                                           //.writeValue
+        NULL,                                           //.readChunk
+        5000,                                           //.cacheTtl
     },
     {
         LWM2MCORE_EXT_CONN_STATS_RSCP_RID,              //.id
@@ -988,6 +1393,10 @@ static lwm2mcore_Resource_t ExtConnectivityStatsResources[] =
         omanager_ReadExtConnectivityStatsObj,           //.read
         NULL,                                           //.write
         NULL,                                           //.exec
+        NULL,                                           //.readValue
+        NULL,                                           //.writeValue
+        NULL,                                           //.readChunk
+        LWM2MCORE_CACHE_NEVER,                          //.cacheTtl
     },
     {
         LWM2MCORE_EXT_CONN_STATS_TEMPERATURE_RID,       //.id
@@ -996,6 +1405,10 @@ static lwm2mcore_Resource_t ExtConnectivityStatsResources[] =
         omanager_ReadExtConnectivityStatsObj,           //.read
         NULL,                                           //.write
         NULL,                                           //.exec
+        NULL,                                           //.readValue
+        NULL,                                           //.writeValue
+        NULL,                                           //.readChunk
+        10000,                                          //.cacheTtl
     },
     {
         LWM2MCORE_EXT_CONN_STATS_UNEXPECTED_RESETS_RID, //.id
@@ -1004,6 +1417,10 @@ static lwm2mcore_Resource_t ExtConnectivityStatsResources[] =
         omanager_ReadExtConnectivityStatsObj,           //.read
         NULL,                                           //.write
         NULL,                                           //.exec
+        NULL,                                           //.readValue
+        NULL,                                           //.writeValue
+        NULL,                                           //.readChunk
+        LWM2MCORE_CACHE_NEVER,                          //.cacheTtl
     },
     {
         LWM2MCORE_EXT_CONN_STATS_TOTAL_RESETS_RID,      //.id
@@ -1012,6 +1429,10 @@ static lwm2mcore_Resource_t ExtConnectivityStatsResources[] =
         omanager_ReadExtConnectivityStatsObj,           //.read
         NULL,                                           //.write
         NULL,                                           //.exec
+        NULL,                                           //.readValue
+        NULL,                                           //.writeValue
+        NULL,                                           //.readChunk
+        LWM2MCORE_CACHE_NEVER,                          //.cacheTtl
     },
     {
         LWM2MCORE_EXT_CONN_STATS_LAC_RID,               //.id
@@ -1020,6 +1441,10 @@ static lwm2mcore_Resource_t ExtConnectivityStatsResources[] =
         omanager_ReadExtConnectivityStatsObj,           //.read
         NULL,                                           //.write
         NULL,                                           //.exec
+        NULL,                                           //.readValue
+        NULL,                                           //.writeValue
+        NULL,                                           //.readChunk
+        LWM2MCORE_CACHE_NEVER,                          //.cacheTtl
     },
     {
         LWM2MCORE_EXT_CONN_STATS_TAC_RID,               //.id
@@ -1028,6 +1453,10 @@ static lwm2mcore_Resource_t ExtConnectivityStatsResources[] =
         omanager_ReadExtConnectivityStatsObj,           //.read
         NULL,                                           //.write
         NULL,                                           //.exec
+        NULL,                                           //.readValue
+        NULL,                                           //.writeValue
+        NULL,                                           //.readChunk
+        LWM2MCORE_CACHE_NEVER,                          //.cacheTtl
     }
 };
 
@@ -1049,6 +1478,10 @@ static lwm2mcore_Resource_t FileTransferResources[] =
         NULL,                                           //.read
         omanager_WriteFileTransferObj,                  //.write
         NULL,                                           //.exec
+        NULL,                                           //.readValue
+        NULL,                                           //.writeValue
+        NULL,                                           //.readChunk
+        LWM2MCORE_CACHE_NEVER,                          //.cacheTtl
     },
     {
         LWM2MCORE_FILE_TRANSFER_CLASS_RID,              //.id
@@ -1057,6 +1490,10 @@ static lwm2mcore_Resource_t FileTransferResources[] =
         NULL                        ,                   //.read
         omanager_WriteFileTransferObj,                  //.write
         NULL,                                           //.exec
+        NULL,                                           //.readValue
+        NULL,                                           //.writeValue
+        NULL,                                           //.readChunk
+        LWM2MCORE_CACHE_NEVER,                          //.cacheTtl
     },
     {
         LWM2MCORE_FILE_TRANSFER_URI_RID,                //.id
@@ -1065,6 +1502,10 @@ static lwm2mcore_Resource_t FileTransferResources[] =
         NULL,                                           //.read
         omanager_WriteFileTransferObj,                  //.write
         NULL,                                           //.exec
+        NULL,                                           //.readValue
+        NULL,                                           //.writeValue
+        NULL,                                           //.readChunk
+        LWM2MCORE_CACHE_NEVER,                          //.cacheTtl
     },
     {
         LWM2MCORE_FILE_TRANSFER_CHECKSUM_RID,             //.id
@@ -1073,6 +1514,10 @@ static lwm2mcore_Resource_t FileTransferResources[] =
         omanager_ReadFileTransferObj,                   //.read
         omanager_WriteFileTransferObj,                  //.write
         NULL,                                           //.exec
+        NULL,                                           //.readValue
+        NULL,                                           //.writeValue
+        NULL,                                           //.readChunk
+        LWM2MCORE_CACHE_NEVER,                          //.cacheTtl
     },
     {
         LWM2MCORE_FILE_TRANSFER_DIRECTION_RID,          //.id
@@ -1081,6 +1526,10 @@ static lwm2mcore_Resource_t FileTransferResources[] =
         NULL,                                           //.read
         omanager_WriteFileTransferObj,                    //.write
         NULL,                                           //.exec
+        NULL,                                           //.readValue
+        NULL,                                           //.writeValue
+        NULL,                                           //.readChunk
+        LWM2MCORE_CACHE_NEVER,                          //.cacheTtl
     },
     {
         LWM2MCORE_FILE_TRANSFER_STATE_RID,              //.id
@@ -1089,6 +1538,10 @@ static lwm2mcore_Resource_t FileTransferResources[] =
         omanager_ReadFileTransferObj,                   //.read
         NULL,                                           //.write
         NULL,                                           //.exec
+        NULL,                                           //.readValue
+        NULL,                                           //.writeValue
+        NULL,                                           //.readChunk
+        LWM2MCORE_CACHE_NEVER,                          //.cacheTtl
     },
     {
         LWM2MCORE_FILE_TRANSFER_RESULT_RID,             //.id
@@ -1097,6 +1550,10 @@ static lwm2mcore_Resource_t FileTransferResources[] =
         omanager_ReadFileTransferObj,                   //.read
         NULL,                                           //.write
         NULL,                                           //.exec
+        NULL,                                           //.readValue
+        NULL,                                           //.writeValue
+        NULL,                                           //.readChunk
+        LWM2MCORE_CACHE_NEVER,                          //.cacheTtl
     },
     {
         LWM2MCORE_FILE_TRANSFER_PROGRESS_RID,           //.id
@@ -1105,6 +1562,10 @@ static lwm2mcore_Resource_t FileTransferResources[] =
         omanager_ReadFileTransferObj,                   //.read
         NULL,                                           //.write
         NULL,                                           //.exec
+        NULL,                                           //.readValue
+        NULL,                                           //.writeValue
+        NULL,                                           //.readChunk
+        LWM2MCORE_CACHE_NEVER,                          //.cacheTtl
     },
     {
         LWM2MCORE_FILE_TRANSFER_FAILURE_REASON_RID,     //.id
@@ -1113,6 +1574,10 @@ static lwm2mcore_Resource_t FileTransferResources[] =
         omanager_ReadFileTransferObj,                   //.read
         NULL,                                           //.write
         NULL,                                           //.exec
+        NULL,                                           //.readValue
+        NULL,                                           //.writeValue
+        NULL,                                           //.readChunk
+        LWM2MCORE_CACHE_NEVER,                          //.cacheTtl
     }
 };
 
@@ -1132,6 +1597,10 @@ static lwm2mcore_Resource_t FileListResources[] =
         omanager_ReadFileListObj,                       //.read
         NULL,                                           //.write
         NULL,                                           //.exec
+        NULL,                                           //.readValue
+        NULL,                                           //.writeValue
+        NULL,                                           //.readChunk
+        LWM2MCORE_CACHE_NEVER,                          //.cacheTtl
     },
     {
         LWM2MCORE_FILE_LIST_CLASS_RID,                  //.id
@@ -1140,6 +1609,10 @@ static lwm2mcore_Resource_t FileListResources[] =
         omanager_ReadFileListObj,                       //.read
         NULL,                                           //.write
         NULL,                                           //.exec
+        NULL,                                           //.readValue
+        NULL,                                           //.writeValue
+        NULL,                                           //.readChunk
+        LWM2MCORE_CACHE_NEVER,                          //.cacheTtl
     },
     {
         LWM2MCORE_FILE_LIST_CHECKSUM_RID,               //.id
@@ -1148,6 +1621,10 @@ static lwm2mcore_Resource_t FileListResources[] =
         omanager_ReadFileListObj,                       //.read
         NULL,                                           //.write
         NULL,                                           //.exec
+        NULL,                                           //.readValue
+        NULL,                                           //.writeValue
+        NULL,                                           //.readChunk
+        LWM2MCORE_CACHE_NEVER,                          //.cacheTtl
     },
     {
         LWM2MCORE_FILE_LIST_DIRECTION_RID,              //.id
@@ -1156,6 +1633,10 @@ static lwm2mcore_Resource_t FileListResources[] =
         omanager_ReadFileListObj,                       //.read
         NULL,                                           //.write
         NULL,                                           //.exec
+        NULL,                                           //.readValue
+        NULL,                                           //.writeValue
+        NULL,                                           //.readChunk
+        LWM2MCORE_CACHE_NEVER,                          //.cacheTtl
     }
 };
 #endif
@@ -1176,6 +1657,10 @@ static lwm2mcore_Resource_t SslCertificateResources[] =
         NULL,                                       //.read
         omanager_WriteSslCertif,                    //.write
         NULL,                                       //.exec
+        NULL,                                       //.readValue
+        NULL,                                       //.writeValue
+        NULL,                                       //.readChunk
+        LWM2MCORE_CACHE_NEVER,                      //.cacheTtl
     }
 };
 
@@ -1195,6 +1680,10 @@ static lwm2mcore_Resource_t ClockTimeConfigResources[] =
         omanager_ReadClockTimeConfigObj,                    //.read
         omanager_WriteClockTimeConfigObj,                   //.write
         NULL,                                               //.exec
+        NULL,                                               //.readValue
+        NULL,                                               //.writeValue
+        NULL,                                               //.readChunk
+        LWM2MCORE_CACHE_NEVER,                              //.cacheTtl
     },
     {
         LWM2MCORE_CLOCK_TIME_CONFIG_SOURCE_CONFIG_RID,      //.id
@@ -1203,6 +1692,10 @@ static lwm2mcore_Resource_t ClockTimeConfigResources[] =
         omanager_ReadClockTimeConfigObj,                    //.read
         omanager_WriteClockTimeConfigObj,                   //.write
         NULL,                                               //.exec
+        NULL,                                               //.readValue
+        NULL,                                               //.writeValue
+        NULL,                                               //.readChunk
+        LWM2MCORE_CACHE_NEVER,                              //.cacheTtl
     },
     {
         LWM2MCORE_CLOCK_TIME_CONFIG_UPDATE_RID,             //.id
@@ -1211,6 +1704,10 @@ static lwm2mcore_Resource_t ClockTimeConfigResources[] =
         NULL,                                               //.read
         NULL,                                               //.write
         omanager_ExecClockTimeConfigObj,                    //.exec
+        NULL,                                               //.readValue
+        NULL,                                               //.writeValue
+        NULL,                                               //.readChunk
+        LWM2MCORE_CACHE_NEVER,                              //.cacheTtl
     },
     {
         LWM2MCORE_CLOCK_TIME_CONFIG_STATUS_RID,             //.id
@@ -1219,6 +1716,10 @@ static lwm2mcore_Resource_t ClockTimeConfigResources[] =
         omanager_ReadClockTimeConfigObj,                    //.read
         NULL,                                               //.write
         NULL,                                               //.exec
+        NULL,                                               //.readValue
+        NULL,                                               //.writeValue
+        NULL,                                               //.readChunk
+        LWM2MCORE_CACHE_NEVER,                              //.cacheTtl
     }
 };
 
@@ -1238,6 +1739,10 @@ static lwm2mcore_Resource_t SimApduConfigResources[] =
         NULL,                                               //.read
         omanager_WriteSimApduConfigObj,                     //.write
         NULL,                                               //.exec
+        NULL,                                               //.readValue
+        NULL,                                               //.writeValue
+        NULL,                                               //.readChunk
+        LWM2MCORE_CACHE_NEVER,                              //.cacheTtl
     },
     {
         LWM2MCORE_SIM_APDU_CONFIG_EXEC_RID,                 //.id
@@ -1246,6 +1751,10 @@ static lwm2mcore_Resource_t SimApduConfigResources[] =
         NULL,                                               //.read
         NULL,                                               //.write
         omanager_ExecSimApduConfigObj,                      //.exec
+        NULL,                                               //.readValue
+        NULL,                                               //.writeValue
+        NULL,                                               //.readChunk
+        LWM2MCORE_CACHE_NEVER,                              //.cacheTtl
     },
     {
         LWM2MCORE_SIM_APDU_CONFIG_RESPONSE_RID,             //.id
@@ -1254,9 +1763,122 @@ static lwm2mcore_Resource_t SimApduConfigResources[] =
         omanager_ReadSimApduConfigObj,                      //.read
         NULL,                                               //.write
         NULL,                                               //.exec
+        NULL,                                               //.readValue
+        NULL,                                               //.writeValue
+        NULL,                                               //.readChunk
+        LWM2MCORE_CACHE_NEVER,                              //.cacheTtl
     }
 };
 
+#ifdef LWM2M_OBJECT_33409
+//--------------------------------------------------------------------------------------------------
+/**
+ * Performance metrics resources (33409)
+ * For each resource, the resource Id, the resource type, the resource instance number,
+ * a READ, WRITE, EXEC callback can be defined.
+ */
+//--------------------------------------------------------------------------------------------------
+static lwm2mcore_Resource_t PerfMetricsResources[] =
+{
+    {
+        LWM2MCORE_PERF_METRICS_NAME_RID,                    //.id
+        LWM2MCORE_RESOURCE_TYPE_STRING,                     //.type
+        LWM2MCORE_METRIC_MAX,                               //.maxResInstCnt
+        omanager_ReadPerfMetricsObj,                        //.read
+        NULL,                                               //.write
+        NULL,                                               //.exec
+        NULL,                                               //.readValue
+        NULL,                                               //.writeValue
+        NULL,                                               //.readChunk
+        LWM2MCORE_CACHE_NEVER,                              //.cacheTtl
+    },
+    {
+        LWM2MCORE_PERF_METRICS_COUNT_RID,                   //.id
+        LWM2MCORE_RESOURCE_TYPE_INT,                        //.type
+        LWM2MCORE_METRIC_MAX,                               //.maxResInstCnt
+        omanager_ReadPerfMetricsObj,                        //.read
+        NULL,                                               //.write
+        NULL,                                               //.exec
+        NULL,                                               //.readValue
+        NULL,                                               //.writeValue
+        NULL,                                               //.readChunk
+        LWM2MCORE_CACHE_NEVER,                              //.cacheTtl
+    },
+    {
+        LWM2MCORE_PERF_METRICS_ERROR_COUNT_RID,             //.id
+        LWM2MCORE_RESOURCE_TYPE_INT,                        //.type
+        LWM2MCORE_METRIC_MAX,                               //.maxResInstCnt
+        omanager_ReadPerfMetricsObj,                        //.read
+        NULL,                                               //.write
+        NULL,                                               //.exec
+        NULL,                                               //.readValue
+        NULL,                                               //.writeValue
+        NULL,                                               //.readChunk
+        LWM2MCORE_CACHE_NEVER,                              //.cacheTtl
+    },
+    {
+        LWM2MCORE_PERF_METRICS_TOTAL_TIME_RID,              //.id
+        LWM2MCORE_RESOURCE_TYPE_INT,                        //.type
+        LWM2MCORE_METRIC_MAX,                               //.maxResInstCnt
+        omanager_ReadPerfMetricsObj,                        //.read
+        NULL,                                               //.write
+        NULL,                                               //.exec
+        NULL,                                               //.readValue
+        NULL,                                               //.writeValue
+        NULL,                                               //.readChunk
+        LWM2MCORE_CACHE_NEVER,                              //.cacheTtl
+    },
+    {
+        LWM2MCORE_PERF_METRICS_MAX_TIME_RID,                //.id
+        LWM2MCORE_RESOURCE_TYPE_INT,                        //.type
+        LWM2MCORE_METRIC_MAX,                               //.maxResInstCnt
+        omanager_ReadPerfMetricsObj,                        //.read
+        NULL,                                               //.write
+        NULL,                                               //.exec
+        NULL,                                               //.readValue
+        NULL,                                               //.writeValue
+        NULL,                                               //.readChunk
+        LWM2MCORE_CACHE_NEVER,                              //.cacheTtl
+    },
+    {
+        LWM2MCORE_PERF_METRICS_HISTOGRAM_RID,               //.id
+        LWM2MCORE_RESOURCE_TYPE_INT,                        //.type
+        LWM2MCORE_METRIC_MAX * LWM2MCORE_METRIC_BUCKETS,    //.maxResInstCnt
+        omanager_ReadPerfMetricsObj,                        //.read
+        NULL,                                               //.write
+        NULL,                                               //.exec
+        NULL,                                               //.readValue
+        NULL,                                               //.writeValue
+        NULL,                                               //.readChunk
+        LWM2MCORE_CACHE_NEVER,                              //.cacheTtl
+    },
+    {
+        LWM2MCORE_PERF_METRICS_COUNTERS_RID,                //.id
+        LWM2MCORE_RESOURCE_TYPE_INT,                        //.type
+        LWM2MCORE_COUNTER_MAX,                              //.maxResInstCnt
+        omanager_ReadPerfMetricsObj,                        //.read
+        NULL,                                               //.write
+        NULL,                                               //.exec
+        NULL,                                               //.readValue
+        NULL,                                               //.writeValue
+        NULL,                                               //.readChunk
+        LWM2MCORE_CACHE_NEVER,                              //.cacheTtl
+    },
+    {
+        LWM2MCORE_PERF_METRICS_RESET_RID,                   //.id
+        LWM2MCORE_RESOURCE_TYPE_UNKNOWN,                    //.type
+        1,                                                  //.maxResInstCnt
+        NULL,                                               //.read
+        NULL,                                               //.write
+        omanager_ExecPerfMetricsObj,                        //.exec
+        NULL,                                               //.readValue
+        NULL,                                               //.writeValue
+        NULL,                                               //.readChunk
+        LWM2MCORE_CACHE_NEVER,                              //.cacheTtl
+    }
+};
+#endif
+
 //--------------------------------------------------------------------------------------------------
 /**
  * List of objects which are supported by the client
@@ -1275,98 +1897,112 @@ static lwm2mcore_Object_t ObjArray[] =
         LWM2MCORE_SECURITY_OID,                                                 //.id
         LWM2MCORE_ID_NONE,                                                      //.maxObjInstCnt
         ARRAYSIZE(SecurityResources),                                           //.resCnt
-        SecurityResources                                                       //.resources
+        SecurityResources,                                                      //.resources
+        NULL                                                                    //.snapshot
     },
     /* Object 1: LWM2M DM server */
     {
         LWM2MCORE_SERVER_OID,                                                   //.id
         LWM2MCORE_ID_NONE,                                                      //.maxObjInstCnt
         ARRAYSIZE(ServerResources),                                             //.resCnt
-        ServerResources                                                         //.resources
+        ServerResources,                                                        //.resources
+        NULL                                                                    //.snapshot
     },
     /* Object 2: ACL */
     {
         LWM2MCORE_ACL_OID,                                                      //.id
         LWM2MCORE_ID_NONE,                                                      //.maxObjInstCnt
         ARRAYSIZE(AclResources),                                                //.resCnt
-        AclResources                                                            //.resources
+        AclResources,                                                           //.resources
+        NULL                                                                    //.snapshot
     },
     /* Object 3: device */
     {
         LWM2MCORE_DEVICE_OID,                                                   //.id
         1,                                                                      //.maxObjInstCnt
         ARRAYSIZE(DeviceResources),                                             //.resCnt
-        DeviceResources                                                         //.resources
+        DeviceResources,                                                        //.resources
+        NULL                                                                    //.snapshot
     },
     /* Object 4: connectivity monitoring */
     {
         LWM2MCORE_CONN_MONITOR_OID,                                             //.id
         1,                                                                      //.maxObjInstCnt
         ARRAYSIZE(ConnectivityMonitoringResources),                             //.resCnt
-        ConnectivityMonitoringResources                                         //.resources
+        ConnectivityMonitoringResources,                                        //.resources
+        omanager_SnapshotConnectivityMonitoringObj                              //.snapshot
     },
     /* Object 5: firmware update */
     {
         LWM2MCORE_FIRMWARE_UPDATE_OID,                                          //.id
         1,                                                                      //.maxObjInstCnt
         ARRAYSIZE(FirmwareUpdateResources),                                     //.resCnt
-        FirmwareUpdateResources                                                 //.resources
+        FirmwareUpdateResources,                                                //.resources
+        NULL                                                                    //.snapshot
     },
     /* Object 6: location */
     {
         LWM2MCORE_LOCATION_OID,                                                 //.id
         1,                                                                      //.maxObjInstCnt
         ARRAYSIZE(LocationResources),                                           //.resCnt
-        LocationResources                                                       //.resources
+        LocationResources,                                                      //.resources
+        NULL                                                                    //.snapshot
     },
     /* Object 7: connectivity statistics */
     {
         LWM2MCORE_CONN_STATS_OID,                                               //.id
         1,                                                                      //.maxObjInstCnt
         ARRAYSIZE(ConnectivityStatisticsResources),                             //.resCnt
-        ConnectivityStatisticsResources                                         //.resources
+        ConnectivityStatisticsResources,                                        //.resources
+        NULL                                                                    //.snapshot
     },
     /* Object 9: software update */
     {
         LWM2MCORE_SOFTWARE_UPDATE_OID,                                          //.id
         LWM2MCORE_ID_NONE,                                                      //.maxObjInstCnt
         ARRAYSIZE(SoftwareUpdateResources),                                     //.resCnt
-        SoftwareUpdateResources                                                 //.resources
+        SoftwareUpdateResources,                                                //.resources
+        NULL                                                                    //.snapshot
     },
     /* Object 10: cellular connectivity */
     {
         LWM2MCORE_CELL_CONN_OID,                                                //.id
         1,                                                                      //.maxObjInstCnt
         ARRAYSIZE(CellularConnectivityResources),                               //.resCnt
-        CellularConnectivityResources                                           //.resources
+        CellularConnectivityResources,                                          //.resources
+        NULL                                                                    //.snapshot
     },
     /* Object 10241: subscription */
     {
         LWM2MCORE_SUBSCRIPTION_OID,                                             //.id
         1,                                                                      //.maxObjInstCnt
         ARRAYSIZE(SubscriptionResources),                                       //.resCnt
-        SubscriptionResources                                                   //.resources
+        SubscriptionResources,                                                  //.resources
+        NULL                                                                    //.snapshot
     },
     /* Object 10242: extended connectivity statistics */
     {
         LWM2MCORE_EXT_CONN_STATS_OID,                                           //.id
         1,                                                                      //.maxObjInstCnt
         ARRAYSIZE(ExtConnectivityStatsResources),                               //.resCnt
-        ExtConnectivityStatsResources                                           //.resources
+        ExtConnectivityStatsResources,                                          //.resources
+        NULL                                                                    //.snapshot
     },
     /* Object 10243: SSL certificate */
     {
         LWM2MCORE_SSL_CERTIFS_OID,                                              //.id
         1,                                                                      //.maxObjInstCnt
         ARRAYSIZE(SslCertificateResources),                                     //.resCnt
-        SslCertificateResources                                                 //.resources
+        SslCertificateResources,                                                //.resources
+        NULL                                                                    //.snapshot
     },
     /* Object 33405: Clock Time configuration */
     {
         LWM2MCORE_CLOCK_TIME_CONFIG_OID,                                        //.id
         CLOCK_TIME_CONFIG_SOURCE_MAX,                                           //.maxObjInstCnt
         ARRAYSIZE(ClockTimeConfigResources),                                    //.resCnt
-        ClockTimeConfigResources                                                //.resources
+        ClockTimeConfigResources,                                               //.resources
+        NULL                                                                    //.snapshot
     },
 #ifdef LWM2M_OBJECT_33406
     /* Object 33406: File transfer */
@@ -1374,14 +2010,16 @@ static lwm2mcore_Object_t ObjArray[] =
         LWM2MCORE_FILE_TRANSFER_OID,                                            //.id
         1,                                                                      //.maxObjInstCnt
         ARRAYSIZE(FileTransferResources),                                       //.resCnt
-        FileTransferResources                                                   //.resources
+        FileTransferResources,                                                  //.resources
+        NULL                                                                    //.snapshot
     },
     /* Object 33407: File list */
     {
         LWM2MCORE_FILE_LIST_OID,                                                //.id
         LWM2MCORE_ID_NONE,                                                      //.maxObjInstCnt
         ARRAYSIZE(FileListResources),                                           //.resCnt
-        FileListResources                                                       //.resources
+        FileListResources,                                                      //.resources
+        NULL                                                                    //.snapshot
     },
 #endif
     /* Object 33408: SIM APDU config */
@@ -1389,8 +2027,19 @@ static lwm2mcore_Object_t ObjArray[] =
         LWM2MCORE_SIM_APDU_CONFIG_OID,                                          //.id
         1,                                                                      //.maxObjInstCnt
         ARRAYSIZE(SimApduConfigResources),                                      //.resCnt
-        SimApduConfigResources                                                  //.resources
+        SimApduConfigResources,                                                 //.resources
+        NULL                                                                    //.snapshot
+    },
+#ifdef LWM2M_OBJECT_33409
+    /* Object 33409: Performance metrics */
+    {
+        LWM2MCORE_PERF_METRICS_OID,                                             //.id
+        1,                                                                      //.maxObjInstCnt
+        ARRAYSIZE(PerfMetricsResources),                                        //.resCnt
+        PerfMetricsResources,                                                   //.resources
+        NULL                                                                    //.snapshot
     }
+#endif
 };
 
 //--------------------------------------------------------------------------------------------------
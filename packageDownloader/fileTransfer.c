@@ -22,6 +22,9 @@
 #include "objects.h"
 #include <lwm2mcore/lwm2mcorePackageDownloader.h>
 
+#define LOG_MODULE_LEVEL LWM2MCORE_LOG_PACKAGE
+#include "coreLog.h"
+
 //--------------------------------------------------------------------------------------------------
 // Symbol and Enum definitions
 //--------------------------------------------------------------------------------------------------
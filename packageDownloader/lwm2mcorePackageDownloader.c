@@ -66,6 +66,9 @@
 
 #include <endian.h>
 
+#define LOG_MODULE_LEVEL LWM2MCORE_LOG_PACKAGE
+#include "coreLog.h"
+
 #ifndef LWM2M_EXTERNAL_DOWNLOADER
 
 //--------------------------------------------------------------------------------------------------
@@ -252,6 +255,8 @@ typedef struct
     uint64_t                    updateGap;           ///< Gap between update and downloader offsets
     bool                        certifiedPackage;    ///< True if downloaded package presents a
                                                      ///< correct CRC and signature
+    uint64_t                    downloadStartMs;     ///< Start time of the download request,
+                                                     ///< 0 if no download is measured
 }
 PackageDownloaderObj_t;
 
@@ -2313,6 +2318,31 @@ static lwm2mcore_DwlResult_t LoadResumeData
     return DWL_OK;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add the duration of the current download to the download time counter
+ */
+//--------------------------------------------------------------------------------------------------
+static void AccountDownloadTime
+(
+    void
+)
+{
+    uint64_t nowMs;
+
+    if (0 == PkgDwlObj.downloadStartMs)
+    {
+        return;
+    }
+
+    nowMs = lwm2mcore_TimerGetTimeMs();
+    if (nowMs > PkgDwlObj.downloadStartMs)
+    {
+        perfMetrics_Add(LWM2MCORE_COUNTER_DOWNLOAD_TIME_MS, nowMs - PkgDwlObj.downloadStartMs);
+    }
+    PkgDwlObj.downloadStartMs = 0;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Download the package
@@ -2336,6 +2366,12 @@ static void PkgDwlDownload
     }
     LOG_ARG("Treat download retry %d", PkgDwlObj.retry);
 
+    // The download time counter covers the download requests and the data reception
+    if (0 == PkgDwlObj.downloadStartMs)
+    {
+        PkgDwlObj.downloadStartMs = lwm2mcore_TimerGetTimeMs();
+    }
+
     // If first time requesting download from remote server, initialize download state
     if (!PkgDwlObj.retry)
     {
@@ -2702,6 +2738,8 @@ static void PkgDwlEnd
 {
     lwm2mcore_Sid_t result = LWM2MCORE_ERR_COMPLETED_OK;
 
+    AccountDownloadTime();
+
     // Check if an error was detected during the package download or parsing
     if (PKG_DWL_NO_ERROR != GetPackageDownloaderError())
     {
@@ -2818,6 +2856,8 @@ static void PkgDwlSuspend
     LOG("Suspend package download");
     (void)pkgDwlPtr;
 
+    AccountDownloadTime();
+
     // End of download
     downloader_SuspendDownload();
 
@@ -3090,6 +3130,8 @@ lwm2mcore_DwlResult_t lwm2mcore_PackageDownloaderReceiveData
 {
     (void)opaquePtr;
 
+    perfMetrics_Add(LWM2MCORE_COUNTER_DOWNLOAD_BYTES, bufSize);
+
     PkgDwlObj.dwlDataPtr = bufPtr;
     PkgDwlObj.downloadedLen = bufSize;
 
@@ -20,6 +20,9 @@
 #include "workspace.h"
 #include "updateAgent.h"
 
+#define LOG_MODULE_LEVEL LWM2MCORE_LOG_PACKAGE
+#include "coreLog.h"
+
 //--------------------------------------------------------------------------------------------------
 // Symbol and Enum definitions
 //--------------------------------------------------------------------------------------------------
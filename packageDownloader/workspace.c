@@ -17,6 +17,9 @@
 #include <lwm2mcore/update.h>
 #include "workspace.h"
 
+#define LOG_MODULE_LEVEL LWM2MCORE_LOG_PACKAGE
+#include "coreLog.h"
+
 //--------------------------------------------------------------------------------------------------
 // Symbol and Enum definitions
 //--------------------------------------------------------------------------------------------------
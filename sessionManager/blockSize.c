@@ -0,0 +1,116 @@
+/**
+ * @file blockSize.c
+ *
+ * Adaptive CoAP block size: the block size of the block-wise transfers follows the losses
+ *
+ * A transfer starts with the largest block size, which needs the fewest round trips. A block
+ * which has to be retransmitted halves the block size, so that a link which loses large datagrams
+ * (fragmentation, radio conditions) stops losing whole oversized blocks. The double size is probed
+ * again after a series of blocks acknowledged without retransmission.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+/* include files */
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <lwm2mcore/lwm2mcore.h>
+#include "blockSize.h"
+
+#define LOG_MODULE_LEVEL LWM2MCORE_LOG_SESSION
+#include "coreLog.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of successes before a larger block size is probed, after lost probes
+ */
+//--------------------------------------------------------------------------------------------------
+#define PROBE_AFTER_MAX         (LWM2MCORE_BLOCK_SIZE_PROBE * 16)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize a block size selection with the maximum block size
+ */
+//--------------------------------------------------------------------------------------------------
+void blockSize_Init
+(
+    blockSize_Estimator_t* estimatorPtr     ///< [IN] Block size selection
+)
+{
+    memset(estimatorPtr, 0, sizeof(blockSize_Estimator_t));
+    estimatorPtr->size = LWM2MCORE_BLOCK_SIZE_MAX;
+    estimatorPtr->probeAfter = LWM2MCORE_BLOCK_SIZE_PROBE;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Report a block acknowledged without retransmission
+ *
+ * @return
+ *  - true if the block size is increased
+ *  - false else
+ */
+//--------------------------------------------------------------------------------------------------
+bool blockSize_ReportSuccess
+(
+    blockSize_Estimator_t* estimatorPtr     ///< [IN] Block size selection
+)
+{
+    // The probed size goes through
+    if (estimatorPtr->isProbing)
+    {
+        estimatorPtr->isProbing = false;
+        estimatorPtr->probeAfter = LWM2MCORE_BLOCK_SIZE_PROBE;
+    }
+
+    if (LWM2MCORE_BLOCK_SIZE_MAX <= estimatorPtr->size)
+    {
+        return false;
+    }
+
+    estimatorPtr->successes++;
+    if (estimatorPtr->successes < estimatorPtr->probeAfter)
+    {
+        return false;
+    }
+
+    estimatorPtr->size *= 2;
+    estimatorPtr->successes = 0;
+    estimatorPtr->isProbing = true;
+    LOG_DBG("Probe block size %u", estimatorPtr->size);
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Report a block which had to be retransmitted or which was not acknowledged
+ *
+ * @return
+ *  - true if the block size is decreased
+ *  - false else
+ */
+//--------------------------------------------------------------------------------------------------
+bool blockSize_ReportLoss
+(
+    blockSize_Estimator_t* estimatorPtr     ///< [IN] Block size selection
+)
+{
+    // A lost probe delays the next one
+    if ((estimatorPtr->isProbing) && (PROBE_AFTER_MAX > estimatorPtr->probeAfter))
+    {
+        estimatorPtr->probeAfter *= 2;
+    }
+    estimatorPtr->isProbing = false;
+    estimatorPtr->successes = 0;
+
+    if (LWM2MCORE_BLOCK_SIZE_MIN >= estimatorPtr->size)
+    {
+        return false;
+    }
+
+    estimatorPtr->size /= 2;
+    LOG_DBG("Block size lowered to %u", estimatorPtr->size);
+    return true;
+}
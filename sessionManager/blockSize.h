@@ -0,0 +1,121 @@
+/**
+ * @file blockSize.h
+ *
+ * Adaptive CoAP block size header file
+ *
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+#ifndef __BLOCK_SIZE_H__
+#define __BLOCK_SIZE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+  * @addtogroup lwm2mcore_blockSize_int
+  * @{
+  */
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Maximum block size of the block-wise transfers, used until a block is lost: power of 2
+ * from 16 to 1024
+ */
+//--------------------------------------------------------------------------------------------------
+#ifndef LWM2MCORE_BLOCK_SIZE_MAX
+#define LWM2MCORE_BLOCK_SIZE_MAX        1024
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Minimum block size of the block-wise transfers: power of 2 from 16 to
+ * LWM2MCORE_BLOCK_SIZE_MAX
+ */
+//--------------------------------------------------------------------------------------------------
+#ifndef LWM2MCORE_BLOCK_SIZE_MIN
+#define LWM2MCORE_BLOCK_SIZE_MIN        64
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Number of blocks acknowledged without retransmission before a larger block size is probed
+ */
+//--------------------------------------------------------------------------------------------------
+#ifndef LWM2MCORE_BLOCK_SIZE_PROBE
+#define LWM2MCORE_BLOCK_SIZE_PROBE      8
+#endif
+
+#if (LWM2MCORE_BLOCK_SIZE_MAX < 16) || (LWM2MCORE_BLOCK_SIZE_MAX > 1024) \
+ || (LWM2MCORE_BLOCK_SIZE_MAX & (LWM2MCORE_BLOCK_SIZE_MAX - 1))
+#error "LWM2MCORE_BLOCK_SIZE_MAX has to be a power of 2 from 16 to 1024"
+#endif
+
+#if (LWM2MCORE_BLOCK_SIZE_MIN < 16) || (LWM2MCORE_BLOCK_SIZE_MIN > LWM2MCORE_BLOCK_SIZE_MAX) \
+ || (LWM2MCORE_BLOCK_SIZE_MIN & (LWM2MCORE_BLOCK_SIZE_MIN - 1))
+#error "LWM2MCORE_BLOCK_SIZE_MIN has to be a power of 2 from 16 to LWM2MCORE_BLOCK_SIZE_MAX"
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Block size selection of a connection.
+ *
+ * The path MTU is discovered by the transfers themselves (packetization layer, RFC 4821): a block
+ * which has to be retransmitted, e.g. because its datagram is fragmented and a fragment is lost,
+ * halves the block size. After LWM2MCORE_BLOCK_SIZE_PROBE blocks acknowledged without
+ * retransmission, the double size is probed. A lost probe delays the next one twice as long.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint16_t size;          ///< Block size of the next blocks
+    uint16_t successes;     ///< Blocks acknowledged without retransmission since the last change
+    uint16_t probeAfter;    ///< Number of successes before a larger block size is probed
+    bool     isProbing;     ///< Set while the block size is a probe
+}blockSize_Estimator_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Initialize a block size selection with the maximum block size
+ */
+//--------------------------------------------------------------------------------------------------
+void blockSize_Init
+(
+    blockSize_Estimator_t* estimatorPtr     ///< [IN] Block size selection
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Report a block acknowledged without retransmission
+ *
+ * @return
+ *  - true if the block size is increased
+ *  - false else
+ */
+//--------------------------------------------------------------------------------------------------
+bool blockSize_ReportSuccess
+(
+    blockSize_Estimator_t* estimatorPtr     ///< [IN] Block size selection
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Report a block which had to be retransmitted or which was not acknowledged
+ *
+ * @return
+ *  - true if the block size is decreased
+ *  - false else
+ */
+//--------------------------------------------------------------------------------------------------
+bool blockSize_ReportLoss
+(
+    blockSize_Estimator_t* estimatorPtr     ///< [IN] Block size selection
+);
+
+/**
+  * @}
+  */
+
+#endif /* __BLOCK_SIZE_H__ */
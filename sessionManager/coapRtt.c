@@ -0,0 +1,369 @@
+/**
+ * @file coapRtt.c
+ *
+ * CoAP round-trip time estimation: adaptive retransmission timeouts (CoCoA)
+ *
+ * The round-trip time of the confirmable exchanges is measured on each connection. A message
+ * acknowledged after one transmission gives a strong sample, a message acknowledged after two or
+ * three transmissions gives a weak sample measured from the first transmission. The retransmission
+ * timeout of the next exchanges follows these samples instead of the fixed CoAP default, and ages
+ * back to the initial value when no sample is received.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+/* include files */
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <lwm2mcore/lwm2mcore.h>
+#include "coapRtt.h"
+
+#define LOG_MODULE_LEVEL LWM2MCORE_LOG_SESSION
+#include "coreLog.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of transmissions of a message giving a weak sample
+ */
+//--------------------------------------------------------------------------------------------------
+#define WEAK_TRANSMISSIONS_MAX  3
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Apply the variable backoff factor of an exchange: 3 for a short initial timeout, 1.5 for a long
+ * one, 2 else
+ *
+ * @return
+ *  - Retransmission timeout in ms
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t Backoff
+(
+    uint64_t timeoutMs,                     ///< [IN] Retransmission timeout in ms
+    uint32_t rtoMs                          ///< [IN] Timeout of the first transmission in ms
+)
+{
+    if (1000 > rtoMs)
+    {
+        return timeoutMs * 3;
+    }
+    if (3000 < rtoMs)
+    {
+        return (timeoutMs * 3) / 2;
+    }
+    return timeoutMs * 2;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Update an estimator with a round-trip time sample (RFC 6298)
+ *
+ * @return
+ *  - Retransmission timeout given by the estimator in ms
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t UpdateEstimator
+(
+    uint32_t* srttMsPtr,                    ///< [INOUT] Smoothed round-trip time in ms
+    uint32_t* varMsPtr,                     ///< [INOUT] Round-trip time variation in ms
+    uint32_t rttMs,                         ///< [IN] Round-trip time sample in ms
+    uint32_t factor                         ///< [IN] Variation factor
+)
+{
+    uint32_t var;
+
+    if (0 == *srttMsPtr)
+    {
+        *srttMsPtr = rttMs;
+        *varMsPtr = rttMs / 2;
+    }
+    else
+    {
+        uint32_t delta = (*srttMsPtr > rttMs) ? (*srttMsPtr - rttMs) : (rttMs - *srttMsPtr);
+        *varMsPtr = ((3 * (*varMsPtr)) + delta) / 4;
+        *srttMsPtr = ((7 * (*srttMsPtr)) + rttMs) / 8;
+    }
+
+    // Clock granularity of 1 ms
+    var = factor * (*varMsPtr);
+    return *srttMsPtr + ((0 != var) ? var : 1);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Age the overall retransmission timeout when no sample updated it for a while: a short timeout
+ * is doubled, a long one is brought back towards the initial value
+ */
+//--------------------------------------------------------------------------------------------------
+static void Age
+(
+    coapRtt_Estimator_t* estimatorPtr,      ///< [IN] Round-trip time estimation
+    uint64_t nowMs                          ///< [IN] Current time
+)
+{
+    uint64_t elapsedMs = nowMs - estimatorPtr->updateMs;
+
+    if ((1000 > estimatorPtr->rtoMs) && (elapsedMs > (16 * (uint64_t)estimatorPtr->rtoMs)))
+    {
+        estimatorPtr->rtoMs *= 2;
+        estimatorPtr->updateMs = nowMs;
+    }
+    else if ((3000 < estimatorPtr->rtoMs) && (elapsedMs > (4 * (uint64_t)estimatorPtr->rtoMs)))
+    {
+        estimatorPtr->rtoMs = (estimatorPtr->rtoMs + LWM2MCORE_COAP_RTO_INIT_MS) / 2;
+        estimatorPtr->updateMs = nowMs;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Search a followed exchange
+ *
+ * @return
+ *  - Exchange
+ *  - NULL if the message is not followed
+ */
+//--------------------------------------------------------------------------------------------------
+static coapRtt_Exchange_t* FindExchange
+(
+    const coapRtt_Estimator_t* estimatorPtr,///< [IN] Round-trip time estimation
+    uint16_t mid                            ///< [IN] Message Id
+)
+{
+    size_t i;
+
+    for (i = 0; i < COAP_RTT_EXCHANGES; i++)
+    {
+        if ((estimatorPtr->exchanges[i].isUsed) && (mid == estimatorPtr->exchanges[i].mid))
+        {
+            return (coapRtt_Exchange_t*)&(estimatorPtr->exchanges[i]);
+        }
+    }
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize a round-trip time estimation
+ */
+//--------------------------------------------------------------------------------------------------
+void coapRtt_Init
+(
+    coapRtt_Estimator_t* estimatorPtr       ///< [IN] Round-trip time estimation
+)
+{
+    memset(estimatorPtr, 0, sizeof(coapRtt_Estimator_t));
+    estimatorPtr->rtoMs = LWM2MCORE_COAP_RTO_INIT_MS;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record the transmission of a confirmable message
+ *
+ * @return
+ *  - true if the message is a retransmission: its exchange is already followed
+ *  - false for the first transmission of the message
+ */
+//--------------------------------------------------------------------------------------------------
+bool coapRtt_Sent
+(
+    coapRtt_Estimator_t* estimatorPtr,      ///< [IN] Round-trip time estimation
+    uint16_t mid,                           ///< [IN] Message Id of the confirmable message
+    uint64_t nowMs                          ///< [IN] Current time (lwm2mcore_TimerGetTimeMs)
+)
+{
+    coapRtt_Exchange_t* exchangePtr = FindExchange(estimatorPtr, mid);
+    size_t i;
+
+    if (NULL != exchangePtr)
+    {
+        if (UINT8_MAX > exchangePtr->transmissions)
+        {
+            exchangePtr->transmissions++;
+        }
+        exchangePtr->lastSentMs = nowMs;
+        return true;
+    }
+
+    // New exchange: a free entry, else the oldest exchange is no longer followed
+    exchangePtr = &(estimatorPtr->exchanges[0]);
+    for (i = 0; i < COAP_RTT_EXCHANGES; i++)
+    {
+        if (!estimatorPtr->exchanges[i].isUsed)
+        {
+            exchangePtr = &(estimatorPtr->exchanges[i]);
+            break;
+        }
+        if (estimatorPtr->exchanges[i].firstSentMs < exchangePtr->firstSentMs)
+        {
+            exchangePtr = &(estimatorPtr->exchanges[i]);
+        }
+    }
+
+    if (0 == estimatorPtr->updateMs)
+    {
+        estimatorPtr->updateMs = nowMs;
+    }
+    Age(estimatorPtr, nowMs);
+
+    exchangePtr->isUsed = true;
+    exchangePtr->mid = mid;
+    exchangePtr->transmissions = 1;
+    exchangePtr->rtoMs = estimatorPtr->rtoMs;
+    exchangePtr->firstSentMs = nowMs;
+    exchangePtr->lastSentMs = nowMs;
+    exchangePtr->isFullBlock = false;
+    return false;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record the acknowledgement or reset of a confirmable message
+ *
+ * @return
+ *  - true if the overall retransmission timeout is updated
+ *  - false else
+ */
+//--------------------------------------------------------------------------------------------------
+bool coapRtt_Acknowledged
+(
+    coapRtt_Estimator_t* estimatorPtr,      ///< [IN] Round-trip time estimation
+    uint16_t mid,                           ///< [IN] Message Id of the acknowledgement or reset
+    uint64_t nowMs                          ///< [IN] Current time (lwm2mcore_TimerGetTimeMs)
+)
+{
+    coapRtt_Exchange_t* exchangePtr = FindExchange(estimatorPtr, mid);
+    uint64_t rttMs;
+    uint32_t rto;
+
+    if (NULL == exchangePtr)
+    {
+        return false;
+    }
+    exchangePtr->isUsed = false;
+
+    rttMs = (nowMs > exchangePtr->firstSentMs) ? (nowMs - exchangePtr->firstSentMs) : 0;
+    if (LWM2MCORE_COAP_RTO_MAX_MS < rttMs)
+    {
+        rttMs = LWM2MCORE_COAP_RTO_MAX_MS;
+    }
+
+    if (1 == exchangePtr->transmissions)
+    {
+        rto = UpdateEstimator(&(estimatorPtr->strongSrttMs),
+                              &(estimatorPtr->strongVarMs),
+                              (uint32_t)rttMs,
+                              4);
+        estimatorPtr->rtoMs = (rto / 2) + (estimatorPtr->rtoMs / 2);
+    }
+    else if (WEAK_TRANSMISSIONS_MAX >= exchangePtr->transmissions)
+    {
+        rto = UpdateEstimator(&(estimatorPtr->weakSrttMs),
+                              &(estimatorPtr->weakVarMs),
+                              (uint32_t)rttMs,
+                              1);
+        estimatorPtr->rtoMs = (rto / 4) + ((3 * estimatorPtr->rtoMs) / 4);
+    }
+    else
+    {
+        // The transmission which is acknowledged is unknown
+        return false;
+    }
+
+    if (LWM2MCORE_COAP_RTO_MAX_MS < estimatorPtr->rtoMs)
+    {
+        estimatorPtr->rtoMs = LWM2MCORE_COAP_RTO_MAX_MS;
+    }
+    estimatorPtr->updateMs = nowMs;
+
+    LOG_DBG("RTT %u ms after %u transmissions: RTO %u ms",
+            (uint32_t)rttMs, exchangePtr->transmissions, estimatorPtr->rtoMs);
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the retransmission deadline of a confirmable message
+ *
+ * @return
+ *  - true if the message is followed: the deadline is set
+ *  - false else
+ */
+//--------------------------------------------------------------------------------------------------
+bool coapRtt_GetDeadline
+(
+    const coapRtt_Estimator_t* estimatorPtr,///< [IN] Round-trip time estimation
+    uint16_t mid,                           ///< [IN] Message Id of the confirmable message
+    uint64_t* deadlineMsPtr                 ///< [OUT] Retransmission deadline
+                                            ///< (lwm2mcore_TimerGetTimeMs)
+)
+{
+    const coapRtt_Exchange_t* exchangePtr = FindExchange(estimatorPtr, mid);
+    uint64_t timeoutMs;
+    uint8_t i;
+
+    if (NULL == exchangePtr)
+    {
+        return false;
+    }
+
+    timeoutMs = exchangePtr->rtoMs;
+    for (i = 1; (i < exchangePtr->transmissions) && (LWM2MCORE_COAP_RTO_MAX_MS > timeoutMs); i++)
+    {
+        timeoutMs = Backoff(timeoutMs, exchangePtr->rtoMs);
+    }
+    if (LWM2MCORE_COAP_RTO_MAX_MS < timeoutMs)
+    {
+        timeoutMs = LWM2MCORE_COAP_RTO_MAX_MS;
+    }
+
+    *deadlineMsPtr = exchangePtr->lastSentMs + timeoutMs;
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mark a confirmable message as a full block of a block-wise transfer
+ */
+//--------------------------------------------------------------------------------------------------
+void coapRtt_SetFullBlock
+(
+    coapRtt_Estimator_t* estimatorPtr,      ///< [IN] Round-trip time estimation
+    uint16_t mid                            ///< [IN] Message Id of the confirmable message
+)
+{
+    coapRtt_Exchange_t* exchangePtr = FindExchange(estimatorPtr, mid);
+
+    if (NULL != exchangePtr)
+    {
+        exchangePtr->isFullBlock = true;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Take the outcome of a full block: the block is no longer marked, so that its outcome is reported
+ * once
+ *
+ * @return
+ *  - true if the message is a full block whose outcome was not taken yet
+ *  - false else
+ */
+//--------------------------------------------------------------------------------------------------
+bool coapRtt_TakeFullBlock
+(
+    coapRtt_Estimator_t* estimatorPtr,      ///< [IN] Round-trip time estimation
+    uint16_t mid                            ///< [IN] Message Id of the confirmable message
+)
+{
+    coapRtt_Exchange_t* exchangePtr = FindExchange(estimatorPtr, mid);
+
+    if ((NULL == exchangePtr) || (!exchangePtr->isFullBlock))
+    {
+        return false;
+    }
+    exchangePtr->isFullBlock = false;
+    return true;
+}
@@ -0,0 +1,176 @@
+/**
+ * @file coapRtt.h
+ *
+ * CoAP round-trip time estimation header file
+ *
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+#ifndef __COAP_RTT_H__
+#define __COAP_RTT_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+  * @addtogroup lwm2mcore_coapRtt_int
+  * @{
+  */
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Initial retransmission timeout in ms, until a round-trip time is measured
+ */
+//--------------------------------------------------------------------------------------------------
+#ifndef LWM2MCORE_COAP_RTO_INIT_MS
+#define LWM2MCORE_COAP_RTO_INIT_MS      2000
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Maximum retransmission timeout in ms
+ */
+//--------------------------------------------------------------------------------------------------
+#ifndef LWM2MCORE_COAP_RTO_MAX_MS
+#define LWM2MCORE_COAP_RTO_MAX_MS       60000
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Number of confirmable exchanges followed at the same time on a connection
+ */
+//--------------------------------------------------------------------------------------------------
+#define COAP_RTT_EXCHANGES              4
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Confirmable exchange waiting for its acknowledgement
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    bool        isUsed;             ///< Set if the entry follows an exchange
+    uint16_t    mid;                ///< Message Id of the confirmable message
+    uint8_t     transmissions;      ///< Number of transmissions of the message
+    uint32_t    rtoMs;              ///< Retransmission timeout of the first transmission in ms
+    uint64_t    firstSentMs;        ///< Time of the first transmission (lwm2mcore_TimerGetTimeMs)
+    uint64_t    lastSentMs;         ///< Time of the last transmission (lwm2mcore_TimerGetTimeMs)
+    bool        isFullBlock;        ///< Set for a full block of a block-wise transfer whose
+                                    ///< outcome is not reported yet (block size selection)
+}coapRtt_Exchange_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Round-trip time estimation of a connection (CoCoA)
+ *
+ * The strong estimator uses the acknowledgements of the messages sent once, the weak estimator
+ * the ones of the messages sent two or three times, measured from the first transmission. Both
+ * follow RFC 6298, with a variance factor of 4 and 1. Each new estimation is blended into the
+ * overall retransmission timeout, which gives the timeout of the next exchanges. The timeout of
+ * an exchange is multiplied on each retransmission by a variable backoff factor.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t    strongSrttMs;       ///< Smoothed round-trip time of the strong estimator in ms
+    uint32_t    strongVarMs;        ///< Round-trip time variation of the strong estimator in ms
+    uint32_t    weakSrttMs;         ///< Smoothed round-trip time of the weak estimator in ms
+    uint32_t    weakVarMs;          ///< Round-trip time variation of the weak estimator in ms
+    uint32_t    rtoMs;              ///< Overall retransmission timeout in ms
+    uint64_t    updateMs;           ///< Time of the last update of rtoMs (aging)
+    coapRtt_Exchange_t exchanges[COAP_RTT_EXCHANGES]; ///< Exchanges waiting for an acknowledgement
+}coapRtt_Estimator_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Initialize a round-trip time estimation
+ */
+//--------------------------------------------------------------------------------------------------
+void coapRtt_Init
+(
+    coapRtt_Estimator_t* estimatorPtr       ///< [IN] Round-trip time estimation
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Record the transmission of a confirmable message
+ *
+ * @return
+ *  - @c true if the message is a retransmission: its exchange is already followed
+ *  - @c false for the first transmission of the message
+ */
+//--------------------------------------------------------------------------------------------------
+bool coapRtt_Sent
+(
+    coapRtt_Estimator_t* estimatorPtr,      ///< [IN] Round-trip time estimation
+    uint16_t mid,                           ///< [IN] Message Id of the confirmable message
+    uint64_t nowMs                          ///< [IN] Current time (lwm2mcore_TimerGetTimeMs)
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Record the acknowledgement or reset of a confirmable message
+ *
+ * @return
+ *  - true if the overall retransmission timeout is updated
+ *  - false else
+ */
+//--------------------------------------------------------------------------------------------------
+bool coapRtt_Acknowledged
+(
+    coapRtt_Estimator_t* estimatorPtr,      ///< [IN] Round-trip time estimation
+    uint16_t mid,                           ///< [IN] Message Id of the acknowledgement or reset
+    uint64_t nowMs                          ///< [IN] Current time (lwm2mcore_TimerGetTimeMs)
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Get the retransmission deadline of a confirmable message
+ *
+ * @return
+ *  - true if the message is followed: the deadline is set
+ *  - false else
+ */
+//--------------------------------------------------------------------------------------------------
+bool coapRtt_GetDeadline
+(
+    const coapRtt_Estimator_t* estimatorPtr,///< [IN] Round-trip time estimation
+    uint16_t mid,                           ///< [IN] Message Id of the confirmable message
+    uint64_t* deadlineMsPtr                 ///< [OUT] Retransmission deadline
+                                            ///< (lwm2mcore_TimerGetTimeMs)
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Mark a confirmable message as a full block of a block-wise transfer
+ */
+//--------------------------------------------------------------------------------------------------
+void coapRtt_SetFullBlock
+(
+    coapRtt_Estimator_t* estimatorPtr,      ///< [IN] Round-trip time estimation
+    uint16_t mid                            ///< [IN] Message Id of the confirmable message
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Take the outcome of a full block: the block is no longer marked, so that its outcome is
+ * reported once
+ *
+ * @return
+ *  - true if the message is a full block whose outcome was not taken yet
+ *  - false else
+ */
+//--------------------------------------------------------------------------------------------------
+bool coapRtt_TakeFullBlock
+(
+    coapRtt_Estimator_t* estimatorPtr,      ///< [IN] Round-trip time estimation
+    uint16_t mid                            ///< [IN] Message Id of the confirmable message
+);
+
+/**
+  * @}
+  */
+
+#endif /* __COAP_RTT_H__ */
@@ -0,0 +1,764 @@
+/**
+ * @file coreLog.c
+ *
+ * LwM2MCore logs: rate limitation per call site, text sink and binary ring buffer sink
+ *
+ * The binary sink does not format the logs: the record stores the call site identifier and the raw
+ * format arguments, the format string is only read to know the argument types. The records are
+ * decoded offline with the call site strings of the @c lwm2mcore_log section of the image.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+/* include files */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <lwm2mcore/lwm2mcore.h>
+#include <lwm2mcore/timer.h>
+#include <lwm2mcore/log.h>
+#include "coreLog.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Length of a formatted text log
+ */
+//--------------------------------------------------------------------------------------------------
+#define LOG_TEXT_LEN                    256
+
+#ifdef LWM2MCORE_BINARY_LOGS
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the binary log ring buffer
+ */
+//--------------------------------------------------------------------------------------------------
+#ifndef LWM2MCORE_LOG_RING_SIZE
+#define LWM2MCORE_LOG_RING_SIZE         8192
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum length of a binary record
+ */
+//--------------------------------------------------------------------------------------------------
+#define LOG_RECORD_MAX_LEN              256
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of characters stored for a string argument
+ */
+//--------------------------------------------------------------------------------------------------
+#define LOG_STRING_MAX_LEN              64
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start of the call site strings section, provided by the linker
+ */
+//--------------------------------------------------------------------------------------------------
+extern const char __start_lwm2mcore_log[] __attribute__((weak));
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Binary log ring buffer
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t Ring[LWM2MCORE_LOG_RING_SIZE];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Index of the oldest record in the ring buffer
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t RingTail;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of bytes used in the ring buffer
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t RingUsed;
+
+#endif /* LWM2MCORE_BINARY_LOGS */
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Selected log sink
+ */
+//--------------------------------------------------------------------------------------------------
+static lwm2mcore_LogSink_t Sink = LWM2MCORE_LOG_SINK_TEXT;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Lock of the rate limitation states and of the ring buffer: the logs are also written by the
+ * package downloader thread
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsLogLocked = false;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Take the log lock. The lock is only held to update a few fields or to copy a record.
+ */
+//--------------------------------------------------------------------------------------------------
+static void LogLock
+(
+    void
+)
+{
+    while (__atomic_test_and_set(&IsLogLocked, __ATOMIC_ACQUIRE))
+    {
+        ;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release the log lock
+ */
+//--------------------------------------------------------------------------------------------------
+static void LogUnlock
+(
+    void
+)
+{
+    __atomic_clear(&IsLogLocked, __ATOMIC_RELEASE);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check the rate limitation of a call site. The log lock has to be held.
+ *
+ * @return
+ *  - true if the log can be written
+ *  - false if the log is suppressed
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsRateAllowed
+(
+    coreLog_RateLimit_t* ratePtr,       ///< [INOUT] Rate limitation state of the call site
+    uint32_t nowMs,                     ///< [IN] Current time
+    uint16_t* suppressedCountPtr        ///< [OUT] Logs suppressed in the previous period
+)
+{
+    *suppressedCountPtr = 0;
+
+    if ((0 == ratePtr->count) || ((uint32_t)(nowMs - ratePtr->periodStartMs)
+                                  >= LWM2MCORE_LOG_RATE_PERIOD_MS))
+    {
+        *suppressedCountPtr = ratePtr->suppressedCount;
+        ratePtr->periodStartMs = nowMs;
+        ratePtr->count = 0;
+        ratePtr->suppressedCount = 0;
+    }
+
+    if (LWM2MCORE_LOG_RATE_BURST <= ratePtr->count)
+    {
+        if (UINT16_MAX != ratePtr->suppressedCount)
+        {
+            ratePtr->suppressedCount++;
+        }
+        return false;
+    }
+
+    ratePtr->count++;
+    return true;
+}
+
+#ifdef LWM2MCORE_BINARY_LOGS
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copy data in the ring buffer, from a given index
+ */
+//--------------------------------------------------------------------------------------------------
+static void RingCopyIn
+(
+    size_t index,                       ///< [IN] Index in the ring buffer
+    const uint8_t* dataPtr,             ///< [IN] Data
+    size_t len                          ///< [IN] Data length
+)
+{
+    size_t firstLen = LWM2MCORE_LOG_RING_SIZE - index;
+
+    if (firstLen > len)
+    {
+        firstLen = len;
+    }
+    memcpy(&Ring[index], dataPtr, firstLen);
+    memcpy(Ring, dataPtr + firstLen, len - firstLen);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copy data from the ring buffer, from a given index
+ */
+//--------------------------------------------------------------------------------------------------
+static void RingCopyOut
+(
+    size_t index,                       ///< [IN] Index in the ring buffer
+    uint8_t* dataPtr,                   ///< [OUT] Data
+    size_t len                          ///< [IN] Data length
+)
+{
+    size_t firstLen = LWM2MCORE_LOG_RING_SIZE - index;
+
+    if (firstLen > len)
+    {
+        firstLen = len;
+    }
+    memcpy(dataPtr, &Ring[index], firstLen);
+    memcpy(dataPtr + firstLen, Ring, len - firstLen);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the length of the oldest record of the ring buffer
+ *
+ * @return
+ *  - Record length
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t RingTailRecordLen
+(
+    void
+)
+{
+    uint16_t len;
+
+    RingCopyOut(RingTail, (uint8_t*)&len, sizeof(len));
+    return len;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Store a record in the ring buffer, overwriting the oldest records if needed. The log lock has to
+ * be held.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RingPush
+(
+    const uint8_t* recordPtr,           ///< [IN] Record
+    size_t len                          ///< [IN] Record length
+)
+{
+    size_t recordLen;
+
+    while ((LWM2MCORE_LOG_RING_SIZE - RingUsed) < len)
+    {
+        recordLen = RingTailRecordLen();
+        RingTail = (RingTail + recordLen) % LWM2MCORE_LOG_RING_SIZE;
+        RingUsed -= recordLen;
+    }
+
+    RingCopyIn((RingTail + RingUsed) % LWM2MCORE_LOG_RING_SIZE, recordPtr, len);
+    RingUsed += len;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the header of a binary record
+ *
+ * @return
+ *  - Header length
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t SetRecordHeader
+(
+    uint8_t* recordPtr,                 ///< [OUT] Record
+    uint8_t type,                       ///< [IN] Record type
+    uint8_t level,                      ///< [IN] Log level
+    const char* sitePtr,                ///< [IN] Call site string
+    uint32_t nowMs                      ///< [IN] Current time
+)
+{
+    lwm2mcore_LogRecordHeader_t header;
+
+    header.len = 0;
+    header.type = type;
+    header.level = level;
+    header.siteId = (uint32_t)(sitePtr - __start_lwm2mcore_log);
+    header.timeMs = nowMs;
+    memcpy(recordPtr, &header, sizeof(header));
+
+    return sizeof(header);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the length of a binary record and store it in the ring buffer
+ */
+//--------------------------------------------------------------------------------------------------
+static void PushRecord
+(
+    uint8_t* recordPtr,                 ///< [INOUT] Record
+    size_t len                          ///< [IN] Record length
+)
+{
+    uint16_t recordLen = (uint16_t)len;
+
+    memcpy(recordPtr + offsetof(lwm2mcore_LogRecordHeader_t, len), &recordLen, sizeof(recordLen));
+    LogLock();
+    RingPush(recordPtr, len);
+    LogUnlock();
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Store the number of suppressed logs of a call site
+ */
+//--------------------------------------------------------------------------------------------------
+static void PushSuppressedRecord
+(
+    uint8_t level,                      ///< [IN] Log level
+    const char* sitePtr,                ///< [IN] Call site string
+    uint32_t nowMs,                     ///< [IN] Current time
+    uint16_t suppressedCount            ///< [IN] Number of suppressed logs
+)
+{
+    uint8_t record[sizeof(lwm2mcore_LogRecordHeader_t) + sizeof(uint32_t)];
+    uint32_t count = suppressedCount;
+    size_t len;
+
+    len = SetRecordHeader(record, LWM2MCORE_LOG_RECORD_SUPPRESSED, level, sitePtr, nowMs);
+    memcpy(&record[len], &count, sizeof(count));
+    PushRecord(record, sizeof(record));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a value to a binary record
+ *
+ * @return
+ *  - true if the value is appended
+ *  - false if the record is full
+ */
+//--------------------------------------------------------------------------------------------------
+static bool AppendValue
+(
+    uint8_t* recordPtr,                 ///< [INOUT] Record
+    size_t* lenPtr,                     ///< [INOUT] Record length
+    const void* valuePtr,               ///< [IN] Value
+    size_t valueLen                     ///< [IN] Value length
+)
+{
+    if ((*lenPtr + valueLen) > LOG_RECORD_MAX_LEN)
+    {
+        return false;
+    }
+    memcpy(recordPtr + *lenPtr, valuePtr, valueLen);
+    *lenPtr += valueLen;
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append the format arguments to a binary record, following the conversions of the format
+ *
+ * @return
+ *  - true if all the arguments are appended
+ *  - false if the record is full
+ */
+//--------------------------------------------------------------------------------------------------
+static bool AppendArguments
+(
+    uint8_t* recordPtr,                 ///< [INOUT] Record
+    size_t* lenPtr,                     ///< [INOUT] Record length
+    const char* formatPtr,              ///< [IN] Format
+    va_list ap                          ///< [IN] Format arguments
+)
+{
+    const char* fPtr = formatPtr;
+
+    while (*fPtr)
+    {
+        int lengthModifier = 0;
+        int longCount = 0;
+        bool isLongDouble = false;
+        int32_t value32;
+        uint64_t value64;
+        double valueDouble;
+        const char* stringPtr;
+        uint8_t stringLen;
+
+        if ('%' != *fPtr++)
+        {
+            continue;
+        }
+
+        // Flags, width and precision
+        while ((*fPtr) && (NULL != strchr("-+ #0'.123456789*", *fPtr)))
+        {
+            if ('*' == *fPtr)
+            {
+                value32 = va_arg(ap, int);
+                if (!AppendValue(recordPtr, lenPtr, &value32, sizeof(value32)))
+                {
+                    return false;
+                }
+            }
+            fPtr++;
+        }
+
+        // Length modifier
+        while ((*fPtr) && (NULL != strchr("hlLjztq", *fPtr)))
+        {
+            if ('l' == *fPtr)
+            {
+                longCount++;
+            }
+            if ('h' != *fPtr)
+            {
+                lengthModifier = *fPtr;
+            }
+            isLongDouble = ('L' == *fPtr);
+            fPtr++;
+        }
+
+        switch (*fPtr)
+        {
+            case 'd':
+            case 'i':
+            case 'u':
+            case 'o':
+            case 'x':
+            case 'X':
+            case 'c':
+                switch (lengthModifier)
+                {
+                    case 0:
+                        value32 = va_arg(ap, int);
+                        if (!AppendValue(recordPtr, lenPtr, &value32, sizeof(value32)))
+                        {
+                            return false;
+                        }
+                        break;
+
+                    case 'j':
+                        value64 = (uint64_t)va_arg(ap, intmax_t);
+                        break;
+
+                    case 'z':
+                        value64 = (uint64_t)va_arg(ap, size_t);
+                        break;
+
+                    case 't':
+                        value64 = (uint64_t)va_arg(ap, ptrdiff_t);
+                        break;
+
+                    default:
+                        // "l", "ll", "q" (and "L", used by some platforms for long long)
+                        if (1 == longCount)
+                        {
+                            value64 = (uint64_t)(int64_t)va_arg(ap, long);
+                        }
+                        else
+                        {
+                            value64 = (uint64_t)va_arg(ap, long long);
+                        }
+                        break;
+                }
+                if ((0 != lengthModifier)
+                 && (!AppendValue(recordPtr, lenPtr, &value64, sizeof(value64))))
+                {
+                    return false;
+                }
+                break;
+
+            case 'p':
+                value64 = (uint64_t)(uintptr_t)va_arg(ap, void*);
+                if (!AppendValue(recordPtr, lenPtr, &value64, sizeof(value64)))
+                {
+                    return false;
+                }
+                break;
+
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A':
+                valueDouble = isLongDouble ? (double)va_arg(ap, long double) : va_arg(ap, double);
+                if (!AppendValue(recordPtr, lenPtr, &valueDouble, sizeof(valueDouble)))
+                {
+                    return false;
+                }
+                break;
+
+            case 's':
+                stringPtr = va_arg(ap, const char*);
+                if (!stringPtr)
+                {
+                    stringPtr = "(null)";
+                }
+                stringLen = (uint8_t)strnlen(stringPtr, LOG_STRING_MAX_LEN);
+                if ((!AppendValue(recordPtr, lenPtr, &stringLen, sizeof(stringLen)))
+                 || (!AppendValue(recordPtr, lenPtr, stringPtr, stringLen)))
+                {
+                    return false;
+                }
+                break;
+
+            case 'n':
+                (void)va_arg(ap, void*);
+                break;
+
+            case '\0':
+                return true;
+
+            default:
+                // "%%" or unknown conversion: no argument
+                break;
+        }
+        fPtr++;
+    }
+
+    return true;
+}
+
+#endif /* LWM2MCORE_BINARY_LOGS */
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write a log to the selected sink (use the LOG macros)
+ */
+//--------------------------------------------------------------------------------------------------
+void coreLog_Write
+(
+    uint8_t level,                      ///< [IN] Log level
+    coreLog_RateLimit_t* ratePtr,       ///< [INOUT] Rate limitation state of the call site
+    const char* sitePtr,                ///< [IN] Call site string
+    const char* formatPtr,              ///< [IN] Format, in the call site string
+    const char* functionPtr,            ///< [IN] Function name
+    int line,                           ///< [IN] Line
+    ...                                 ///< [IN] Format arguments
+)
+{
+    uint32_t nowMs;
+    uint16_t suppressedCount;
+    bool isAllowed;
+
+    if (LWM2MCORE_LOG_SINK_NONE == Sink)
+    {
+        return;
+    }
+
+    nowMs = (uint32_t)lwm2mcore_TimerGetTimeMs();
+    LogLock();
+    isAllowed = IsRateAllowed(ratePtr, nowMs, &suppressedCount);
+    LogUnlock();
+    if (!isAllowed)
+    {
+        return;
+    }
+
+#ifdef LWM2MCORE_BINARY_LOGS
+    if (LWM2MCORE_LOG_SINK_BINARY == Sink)
+    {
+        uint8_t record[LOG_RECORD_MAX_LEN];
+        size_t len;
+        va_list ap;
+
+        if (suppressedCount)
+        {
+            PushSuppressedRecord(level, sitePtr, nowMs, suppressedCount);
+        }
+
+        len = SetRecordHeader(record, LWM2MCORE_LOG_RECORD_MESSAGE, level, sitePtr, nowMs);
+        va_start(ap, line);
+        if (!AppendArguments(record, &len, formatPtr, ap))
+        {
+            record[offsetof(lwm2mcore_LogRecordHeader_t, type)] |= LWM2MCORE_LOG_RECORD_TRUNCATED;
+        }
+        va_end(ap);
+        PushRecord(record, len);
+        return;
+    }
+#else
+    (void)sitePtr;
+    (void)level;
+#endif
+
+#ifdef LWM2M_WITH_LOGS
+    {
+        char text[LOG_TEXT_LEN];
+        va_list ap;
+
+        if (suppressedCount)
+        {
+            lwm2m_printf("[%s:%d] %u logs suppressed\r\n", functionPtr, line, suppressedCount);
+        }
+
+        va_start(ap, line);
+        vsnprintf(text, sizeof(text), formatPtr, ap);
+        va_end(ap);
+        lwm2m_printf("[%s:%d] %s\r\n", functionPtr, line, text);
+    }
+#else
+    (void)formatPtr;
+    (void)functionPtr;
+    (void)line;
+#endif
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Dump data to the selected sink (use LOG_DUMP)
+ */
+//--------------------------------------------------------------------------------------------------
+void coreLog_Dump
+(
+    uint8_t level,                      ///< [IN] Log level
+    coreLog_RateLimit_t* ratePtr,       ///< [INOUT] Rate limitation state of the call site
+    const char* sitePtr,                ///< [IN] Call site string
+    const char* descPtr,                ///< [IN] Data description, in the call site string
+    const void* addrPtr,                ///< [IN] Data address
+    int len                             ///< [IN] Data length
+)
+{
+    uint32_t nowMs;
+    uint16_t suppressedCount;
+    bool isAllowed;
+
+    if ((LWM2MCORE_LOG_SINK_NONE == Sink) || (!addrPtr) || (0 > len))
+    {
+        return;
+    }
+
+    nowMs = (uint32_t)lwm2mcore_TimerGetTimeMs();
+    LogLock();
+    isAllowed = IsRateAllowed(ratePtr, nowMs, &suppressedCount);
+    LogUnlock();
+    if (!isAllowed)
+    {
+        return;
+    }
+
+#ifdef LWM2MCORE_BINARY_LOGS
+    if (LWM2MCORE_LOG_SINK_BINARY == Sink)
+    {
+        uint8_t record[LOG_RECORD_MAX_LEN];
+        size_t recordLen;
+        size_t dumpLen = (size_t)len;
+
+        if (suppressedCount)
+        {
+            PushSuppressedRecord(level, sitePtr, nowMs, suppressedCount);
+        }
+
+        recordLen = SetRecordHeader(record, LWM2MCORE_LOG_RECORD_DUMP, level, sitePtr, nowMs);
+        if (dumpLen > (LOG_RECORD_MAX_LEN - recordLen))
+        {
+            dumpLen = LOG_RECORD_MAX_LEN - recordLen;
+            record[offsetof(lwm2mcore_LogRecordHeader_t, type)] |= LWM2MCORE_LOG_RECORD_TRUNCATED;
+        }
+        memcpy(&record[recordLen], addrPtr, dumpLen);
+        PushRecord(record, recordLen + dumpLen);
+        return;
+    }
+#else
+    (void)sitePtr;
+    (void)level;
+#endif
+
+#ifdef LWM2M_WITH_LOGS
+    if (suppressedCount)
+    {
+        lwm2m_printf("[%s] %u dumps suppressed\r\n", descPtr, suppressedCount);
+    }
+#endif
+    lwm2mcore_DataDump(descPtr, (void*)addrPtr, len);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Select the log sink
+ *
+ * @return
+ *  - @ref LWM2MCORE_ERR_COMPLETED_OK on success
+ *  - @ref LWM2MCORE_ERR_INVALID_ARG if the sink is unknown
+ *  - @ref LWM2MCORE_ERR_OP_NOT_SUPPORTED if LwM2MCore is compiled without
+ *    @c LWM2MCORE_BINARY_LOGS and the binary sink is selected
+ */
+//--------------------------------------------------------------------------------------------------
+lwm2mcore_Sid_t lwm2mcore_SetLogSink
+(
+    lwm2mcore_LogSink_t sink            ///< [IN] Log sink
+)
+{
+    switch (sink)
+    {
+        case LWM2MCORE_LOG_SINK_TEXT:
+        case LWM2MCORE_LOG_SINK_NONE:
+            break;
+
+        case LWM2MCORE_LOG_SINK_BINARY:
+#ifdef LWM2MCORE_BINARY_LOGS
+            if (!__start_lwm2mcore_log)
+            {
+                return LWM2MCORE_ERR_OP_NOT_SUPPORTED;
+            }
+            break;
+#else
+            return LWM2MCORE_ERR_OP_NOT_SUPPORTED;
+#endif
+
+        default:
+            return LWM2MCORE_ERR_INVALID_ARG;
+    }
+
+    Sink = sink;
+    return LWM2MCORE_ERR_COMPLETED_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read and remove the oldest records of the log ring buffer
+ *
+ * @return
+ *  - Number of bytes copied in the buffer
+ */
+//--------------------------------------------------------------------------------------------------
+size_t lwm2mcore_ReadLogRing
+(
+    uint8_t* bufferPtr,                 ///< [OUT] Buffer
+    size_t len                          ///< [IN] Buffer length
+)
+{
+    size_t copiedLen = 0;
+
+    if (!bufferPtr)
+    {
+        return 0;
+    }
+
+#ifdef LWM2MCORE_BINARY_LOGS
+    LogLock();
+    while (RingUsed)
+    {
+        size_t recordLen = RingTailRecordLen();
+
+        if ((copiedLen + recordLen) > len)
+        {
+            break;
+        }
+
+        RingCopyOut(RingTail, bufferPtr + copiedLen, recordLen);
+        copiedLen += recordLen;
+        RingTail = (RingTail + recordLen) % LWM2MCORE_LOG_RING_SIZE;
+        RingUsed -= recordLen;
+    }
+    LogUnlock();
+#else
+    (void)len;
+#endif
+
+    return copiedLen;
+}
@@ -0,0 +1,281 @@
+/**
+ * @file coreLog.h
+ *
+ * LwM2MCore logs header file
+ *
+ * This file replaces the Wakaama LOG() and LOG_ARG() macros in the LwM2MCore sources. The log
+ * level of each LwM2MCore module is fixed at compile time: the logs above the level of the module
+ * are compiled out, their arguments are not evaluated. The enabled logs are rate-limited per call
+ * site and written to the log sink selected at run time (see lwm2mcore_SetLogSink).
+ *
+ * A source file selects its module level before including this file:
+ * @code
+ * #define LOG_MODULE_LEVEL LWM2MCORE_LOG_DTLS
+ * #include "coreLog.h"
+ * @endcode
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+#ifndef __CORE_LOG_H__
+#define __CORE_LOG_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <lwm2mcore/log.h>
+#include "internals.h"
+
+/**
+  * @addtogroup lwm2mcore_coreLog_int
+  * @{
+  */
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Log levels
+ */
+//--------------------------------------------------------------------------------------------------
+#define LWM2MCORE_LOG_LEVEL_NONE        0   ///< No log
+#define LWM2MCORE_LOG_LEVEL_ERROR       1   ///< Errors
+#define LWM2MCORE_LOG_LEVEL_INFO        2   ///< Main events (LOG and LOG_ARG)
+#define LWM2MCORE_LOG_LEVEL_DEBUG       3   ///< Per packet logs and data dumps
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Default log level of the modules
+ */
+//--------------------------------------------------------------------------------------------------
+#ifndef LWM2MCORE_LOG_DEFAULT
+#ifdef LWM2M_WITH_LOGS
+#define LWM2MCORE_LOG_DEFAULT           LWM2MCORE_LOG_LEVEL_INFO
+#else
+#define LWM2MCORE_LOG_DEFAULT           LWM2MCORE_LOG_LEVEL_NONE
+#endif
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Log levels of the modules, which can be set by compilation flags
+ */
+//--------------------------------------------------------------------------------------------------
+#ifndef LWM2MCORE_LOG_SESSION
+#define LWM2MCORE_LOG_SESSION           LWM2MCORE_LOG_DEFAULT   ///< Session manager
+#endif
+#ifndef LWM2MCORE_LOG_DTLS
+#define LWM2MCORE_LOG_DTLS              LWM2MCORE_LOG_DEFAULT   ///< DTLS connections
+#endif
+#ifndef LWM2MCORE_LOG_OBJECTS
+#define LWM2MCORE_LOG_OBJECTS           LWM2MCORE_LOG_DEFAULT   ///< Object manager
+#endif
+#ifndef LWM2MCORE_LOG_PACKAGE
+#define LWM2MCORE_LOG_PACKAGE           LWM2MCORE_LOG_DEFAULT   ///< Package downloader
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Log level of the current source file
+ */
+//--------------------------------------------------------------------------------------------------
+#ifndef LOG_MODULE_LEVEL
+#define LOG_MODULE_LEVEL                LWM2MCORE_LOG_DEFAULT
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Maximum number of logs per call site and per rate limitation period
+ */
+//--------------------------------------------------------------------------------------------------
+#ifndef LWM2MCORE_LOG_RATE_BURST
+#define LWM2MCORE_LOG_RATE_BURST        20
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Rate limitation period in ms
+ */
+//--------------------------------------------------------------------------------------------------
+#ifndef LWM2MCORE_LOG_RATE_PERIOD_MS
+#define LWM2MCORE_LOG_RATE_PERIOD_MS    1000
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Section of the call site strings, used to identify the call sites in binary records
+ */
+//--------------------------------------------------------------------------------------------------
+#ifdef LWM2MCORE_BINARY_LOGS
+#define LOG_SITE_SECTION                __attribute__((section("lwm2mcore_log")))
+#else
+#define LOG_SITE_SECTION
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Check at compile time if a log level is enabled in the current source file
+ */
+//--------------------------------------------------------------------------------------------------
+#define LOG_IS_ENABLED(LEVEL)           ((LEVEL) <= LOG_MODULE_LEVEL)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Call site location, as stored in the call site string
+ */
+//--------------------------------------------------------------------------------------------------
+#define LOG_STRINGIFY(X)                #X
+#define LOG_TOSTRING(X)                 LOG_STRINGIFY(X)
+#define LOG_SITE_LOCATION               __FILE__ ":" LOG_TOSTRING(__LINE__)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Rate limitation state of a call site
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t periodStartMs;             ///< Start of the current rate limitation period
+    uint16_t count;                     ///< Number of logs in the current period
+    uint16_t suppressedCount;           ///< Number of suppressed logs in the current period
+}
+coreLog_RateLimit_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Log a message on a call site
+ *
+ * The call site string is the call site location followed by a null character and by the format.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LOG_LEVEL_ARG(LEVEL, FMT, ...)                                                             \
+    do                                                                                             \
+    {                                                                                              \
+        if (LOG_IS_ENABLED(LEVEL))                                                                 \
+        {                                                                                          \
+            static const char coreLogSite[] LOG_SITE_SECTION = LOG_SITE_LOCATION "\0" FMT;         \
+            static coreLog_RateLimit_t coreLogRate;                                                \
+            coreLog_Write((LEVEL), &coreLogRate, coreLogSite,                                      \
+                          coreLogSite + sizeof(LOG_SITE_LOCATION), __func__, __LINE__,             \
+                          ##__VA_ARGS__);                                                          \
+        }                                                                                          \
+    }                                                                                              \
+    while (0)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Dump data on a call site
+ */
+//--------------------------------------------------------------------------------------------------
+#define LOG_LEVEL_DUMP(LEVEL, DESC, ADDR, LEN)                                                     \
+    do                                                                                             \
+    {                                                                                              \
+        if (LOG_IS_ENABLED(LEVEL))                                                                 \
+        {                                                                                          \
+            static const char coreLogSite[] LOG_SITE_SECTION = LOG_SITE_LOCATION "\0" DESC;        \
+            static coreLog_RateLimit_t coreLogRate;                                                \
+            coreLog_Dump((LEVEL), &coreLogRate, coreLogSite,                                       \
+                         coreLogSite + sizeof(LOG_SITE_LOCATION), (const void*)(ADDR), (LEN));     \
+        }                                                                                          \
+    }                                                                                              \
+    while (0)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Disabled log: the arguments are checked by the compiler but neither evaluated nor stored
+ */
+//--------------------------------------------------------------------------------------------------
+#define LOG_DISCARD(...)                                                                           \
+    do                                                                                             \
+    {                                                                                              \
+        if (0)                                                                                     \
+        {                                                                                          \
+            coreLog_Discard(0, __VA_ARGS__);                                                       \
+        }                                                                                          \
+    }                                                                                              \
+    while (0)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Log macros of LwM2MCore, replacing the Wakaama ones
+ *
+ * - LOG_ERR(): errors
+ * - LOG() and LOG_ARG(): main events
+ * - LOG_DBG() and LOG_DUMP(): per packet logs and data dumps
+ */
+//--------------------------------------------------------------------------------------------------
+#undef LOG
+#undef LOG_ARG
+
+#if LOG_IS_ENABLED(LWM2MCORE_LOG_LEVEL_ERROR)
+#define LOG_ERR(FMT, ...)       LOG_LEVEL_ARG(LWM2MCORE_LOG_LEVEL_ERROR, FMT, ##__VA_ARGS__)
+#else
+#define LOG_ERR(FMT, ...)       LOG_DISCARD(FMT, ##__VA_ARGS__)
+#endif
+
+#if LOG_IS_ENABLED(LWM2MCORE_LOG_LEVEL_INFO)
+#define LOG(STR)                LOG_LEVEL_ARG(LWM2MCORE_LOG_LEVEL_INFO, STR)
+#define LOG_ARG(FMT, ...)       LOG_LEVEL_ARG(LWM2MCORE_LOG_LEVEL_INFO, FMT, __VA_ARGS__)
+#else
+#define LOG(STR)                LOG_DISCARD(STR)
+#define LOG_ARG(FMT, ...)       LOG_DISCARD(FMT, __VA_ARGS__)
+#endif
+
+#if LOG_IS_ENABLED(LWM2MCORE_LOG_LEVEL_DEBUG)
+#define LOG_DBG(FMT, ...)       LOG_LEVEL_ARG(LWM2MCORE_LOG_LEVEL_DEBUG, FMT, ##__VA_ARGS__)
+#define LOG_DUMP(DESC, ADDR, LEN)                                                                  \
+                                LOG_LEVEL_DUMP(LWM2MCORE_LOG_LEVEL_DEBUG, DESC, ADDR, LEN)
+#else
+#define LOG_DBG(FMT, ...)       LOG_DISCARD(FMT, ##__VA_ARGS__)
+#define LOG_DUMP(DESC, ADDR, LEN)                                                                  \
+                                LOG_DISCARD(DESC, ADDR, LEN)
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Write a log to the selected sink (use the LOG macros)
+ */
+//--------------------------------------------------------------------------------------------------
+void coreLog_Write
+(
+    uint8_t level,                      ///< [IN] Log level
+    coreLog_RateLimit_t* ratePtr,       ///< [INOUT] Rate limitation state of the call site
+    const char* sitePtr,                ///< [IN] Call site string
+    const char* formatPtr,              ///< [IN] Format, in the call site string
+    const char* functionPtr,            ///< [IN] Function name
+    int line,                           ///< [IN] Line
+    ...                                 ///< [IN] Format arguments
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Dump data to the selected sink (use LOG_DUMP)
+ */
+//--------------------------------------------------------------------------------------------------
+void coreLog_Dump
+(
+    uint8_t level,                      ///< [IN] Log level
+    coreLog_RateLimit_t* ratePtr,       ///< [INOUT] Rate limitation state of the call site
+    const char* sitePtr,                ///< [IN] Call site string
+    const char* descPtr,                ///< [IN] Data description, in the call site string
+    const void* addrPtr,                ///< [IN] Data address
+    int len                             ///< [IN] Data length
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Reference the arguments of a disabled log (never called)
+ */
+//--------------------------------------------------------------------------------------------------
+static inline void coreLog_Discard
+(
+    int unused,                         ///< [IN] Unused
+    ...                                 ///< [IN] Log arguments
+)
+{
+    (void)unused;
+}
+
+/**
+  * @}
+  */
+
+#endif /* __CORE_LOG_H__ */
@@ -23,12 +23,17 @@
 #include <lwm2mcore/lwm2mcore.h>
 #include <lwm2mcore/socket.h>
 #include <lwm2mcore/udp.h>
+#include <lwm2mcore/timer.h>
 #include "objects.h"
 #include "dtlsConnection.h"
 #include "sessionManager.h"
 #include "internals.h"
 #include "liblwm2m.h"
 #include "alert.h"
+#include "udpBatch.h"
+
+#define LOG_MODULE_LEVEL LWM2MCORE_LOG_DTLS
+#include "coreLog.h"
 
 #define COAP_PORT "5683"
 #define COAPS_PORT "5684"
@@ -36,34 +41,51 @@
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Global for DTLS context
+ * CoAP header: minimum length, message type mask and shift, message types
  */
 //--------------------------------------------------------------------------------------------------
-dtls_context_t* DtlsContextPtr;
+#define COAP_HEADER_LEN         4
+#define COAP_TYPE_MASK          0x30
+#define COAP_TYPE_SHIFT         4
+#define COAP_TYPE_CON           0
+#define COAP_TYPE_ACK           2
+#define COAP_TYPE_RST           3
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Global for DTLS connection list
+ * CoAP options: token length mask, payload marker, extended option delta/length, Block2 and Block1
+ * option numbers, more flag of a block option
  */
 //--------------------------------------------------------------------------------------------------
-#ifdef LWM2M_RETAIN_SERVER_LIST
-dtls_Connection_t* DtlsConnectionListPtr = NULL;
-#endif
+#define COAP_TOKEN_LEN_MASK     0x0F
+#define COAP_PAYLOAD_MARKER     0xFF
+#define COAP_OPTION_EXT_1       13
+#define COAP_OPTION_EXT_2       14
+#define COAP_OPTION_BLOCK2_NUM  23
+#define COAP_OPTION_BLOCK1_NUM  27
+#define COAP_BLOCK_MORE         0x08
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Global for DTLS rehandshake
+ * Set when tinyDTLS is initialized (the library is shared by all the client instances)
  */
 //--------------------------------------------------------------------------------------------------
-static bool IsRehandshake = false;
+static bool IsDtlsInitialized = false;
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Global for DTLS NAT TIMEOUT
+ * DTLS NAT timeout of the client instances initialized later
  */
 //--------------------------------------------------------------------------------------------------
 static uint32_t DtlsNatTimeout = DTLS_NAT_TIMEOUT;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * NAT timeout learning of the client instances initialized later
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsDtlsNatAdaptive = false;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Function to search the server URI (resource 0 of object 0)
@@ -276,9 +298,11 @@ static int SendData
 {
     int nbSent = 0;
     size_t offset;
-    LOG("SendData");
+    size_t coalesceMaxLen = 0;
+    udpBatch_Status_t status;
+    LOG_DBG("SendData");
 
-#ifdef WITH_LOGS
+#if LOG_IS_ENABLED(LWM2MCORE_LOG_LEVEL_DEBUG)
     char s[INET6_ADDRSTRLEN];
     in_port_t port = 0;
 
@@ -297,15 +321,36 @@ static int SendData
         port = saddrPtr->sin6_port;
     }
 
-    LOG_ARG("Sending %d bytes to [%s]:%hu", length, s, ntohs(port));
+    LOG_DBG("Sending %zu bytes to [%s]:%hu", length, s, ntohs(port));
 
 #endif
     if (NULL == connPtr->dtlsSessionPtr)
     {
-        lwm2mcore_DataDump("Sent bytes in no sec", bufferPtr, length);
+        LOG_DUMP("Sent bytes in no sec", bufferPtr, length);
     }
 
     offset = 0;
+
+#ifdef LWM2MCORE_DTLS_COALESCE
+    // DTLS records can share a datagram, CoAP messages without security cannot
+    if (NULL != connPtr->dtlsSessionPtr)
+    {
+        coalesceMaxLen = LWM2MCORE_DTLS_COALESCE_MAX_LEN;
+    }
+#endif
+
+    // In a batch, the datagram is sent with the other datagrams of the step
+    status = udpBatch_Queue(connPtr->sock,
+                            bufferPtr,
+                            length,
+                            (struct sockaddr *)&(connPtr->addr),
+                            (socklen_t)connPtr->addrLen,
+                            coalesceMaxLen);
+    if (UDP_BATCH_NOT_QUEUED != status)
+    {
+        offset = length;
+    }
+
     while (offset != length)
     {
         nbSent = lwm2mcore_UdpSend(connPtr->sock,
@@ -321,6 +366,15 @@ static int SendData
         }
         offset += nbSent;
     }
+    perfMetrics_Add(LWM2MCORE_COUNTER_UDP_TX_BYTES, offset);
+    if (UDP_BATCH_COALESCED == status)
+    {
+        perfMetrics_Add(LWM2MCORE_COUNTER_DTLS_RECORDS_COALESCED, 1);
+    }
+    else
+    {
+        perfMetrics_Add(LWM2MCORE_COUNTER_UDP_TX_DATAGRAMS, 1);
+    }
     connPtr->lastSend = lwm2m_gettime();
     return (int)offset;
 }
@@ -355,7 +409,7 @@ static int GetPskInfo
 
     LOG_ARG("GetPskInfo type %d", type);
     // find connection
-    cnxPtr = dtls_FindConnection((dtls_Connection_t*) ctxPtr->app,
+    cnxPtr = dtls_FindConnection((dtls_Instance_t*)ctxPtr->app,
                                  &(sessionPtr->addr.st),
                                  sessionPtr->size);
     if (NULL == cnxPtr)
@@ -451,7 +505,7 @@ static int SendToPeer
     }
 
     // find connection
-    cnxPtr = dtls_FindConnection((dtls_Connection_t*) ctxPtr->app,
+    cnxPtr = dtls_FindConnection((dtls_Instance_t*)ctxPtr->app,
                                  &(sessionPtr->addr.st),
                                  sessionPtr->size);
     if (NULL != cnxPtr)
@@ -462,6 +516,117 @@ static int SendToPeer
     return -1;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function to report a change of the learned NAT timeout to the application
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReportNatTimeout
+(
+    const dtls_Instance_t* instancePtr  ///< [IN] DTLS state of the client instance
+)
+{
+    lwm2mcore_Status_t status;
+
+    memset(&status, 0, sizeof(status));
+    status.event = LWM2MCORE_EVENT_NAT_TIMEOUT;
+    status.u.nat.timeout = instancePtr->natEstimator.timeout;
+    smanager_SendStatusEvent(status);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function to learn the NAT binding lifetime from a message received from the server: the binding
+ * survived the inactivity which preceded it, and the probe in progress is answered
+ */
+//--------------------------------------------------------------------------------------------------
+static void LearnNatBinding
+(
+    dtls_Connection_t* connPtr          ///< [IN] DTLS connection
+)
+{
+    natTimeout_Estimator_t* estimatorPtr = &(connPtr->instancePtr->natEstimator);
+    time_t lastActivity = (connPtr->lastSend > connPtr->lastReceived) ? connPtr->lastSend :
+                                                                        connPtr->lastReceived;
+    time_t idle = lwm2m_gettime() - lastActivity;
+    bool isChanged = false;
+
+    if (natTimeout_IsProbing(estimatorPtr))
+    {
+        isChanged = natTimeout_ReportProbe(estimatorPtr, true);
+    }
+    else if (0 < idle)
+    {
+        isChanged = natTimeout_ReportAlive(estimatorPtr, (uint32_t)idle);
+    }
+
+    if (isChanged)
+    {
+        ReportNatTimeout(connPtr->instancePtr);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function to measure the round-trip time of a confirmable message from its acknowledgement or
+ * reset received from the server. A change of the retransmission timeout by more than 1/8 is
+ * reported to the application. The acknowledgement of a full block sent once is reported to the
+ * block size selection of the connection.
+ */
+//--------------------------------------------------------------------------------------------------
+static void LearnCoapRtt
+(
+    dtls_Connection_t* connPtr,         ///< [IN] DTLS connection
+    const uint8_t* bufferPtr,           ///< [IN] CoAP message
+    size_t length                       ///< [IN] CoAP message length
+)
+{
+    lwm2mcore_Status_t status;
+    uint32_t rtoMs;
+    uint32_t deltaMs;
+    uint16_t mid;
+    uint8_t type;
+
+    if (COAP_HEADER_LEN > length)
+    {
+        return;
+    }
+
+    type = (bufferPtr[0] & COAP_TYPE_MASK) >> COAP_TYPE_SHIFT;
+    if ((COAP_TYPE_ACK != type) && (COAP_TYPE_RST != type))
+    {
+        return;
+    }
+
+    // The outcome of a retransmitted block was already taken
+    mid = (uint16_t)((bufferPtr[2] << 8) | bufferPtr[3]);
+    if ((COAP_TYPE_ACK == type) && (coapRtt_TakeFullBlock(&(connPtr->rtt), mid)))
+    {
+        blockSize_ReportSuccess(&(connPtr->blockSize));
+    }
+
+    if (!coapRtt_Acknowledged(&(connPtr->rtt), mid, lwm2mcore_TimerGetTimeMs()))
+    {
+        return;
+    }
+
+    rtoMs = connPtr->rtt.rtoMs;
+    deltaMs = (rtoMs > connPtr->reportedRtoMs) ? (rtoMs - connPtr->reportedRtoMs) :
+                                                 (connPtr->reportedRtoMs - rtoMs);
+    if ((connPtr->reportedRtoMs / 8) >= deltaMs)
+    {
+        return;
+    }
+    connPtr->reportedRtoMs = rtoMs;
+
+    memset(&status, 0, sizeof(status));
+    status.event = LWM2MCORE_EVENT_COAP_RTT;
+    status.u.rtt.rtoMs = rtoMs;
+    status.u.rtt.strongRttMs = connPtr->rtt.strongSrttMs;
+    status.u.rtt.weakRttMs = connPtr->rtt.weakSrttMs;
+    smanager_SendStatusEvent(status);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * TinyDTLS Callbacks
@@ -481,12 +646,18 @@ static int ReadFromPeer
 )
 {
     // find connection
-    dtls_Connection_t* cnxPtr = dtls_FindConnection((dtls_Connection_t*) ctxPtr->app,
-                                                &(sessionPtr->addr.st),
-                                                sessionPtr->size);
+    dtls_Connection_t* cnxPtr = dtls_FindConnection((dtls_Instance_t*)ctxPtr->app,
+                                                    &(sessionPtr->addr.st),
+                                                    sessionPtr->size);
     if (NULL != cnxPtr)
     {
+        if (cnxPtr->instancePtr->isNatAdaptive)
+        {
+            LearnNatBinding(cnxPtr);
+        }
         cnxPtr->lastReceived = lwm2m_gettime();
+        LearnCoapRtt(cnxPtr, dataPtr, len);
+        omanager_ReleaseRequestMemory();
         lwm2m_handle_packet(cnxPtr->lwm2mHPtr, dataPtr, len, (void*)cnxPtr);
         return 0;
     }
@@ -512,9 +683,10 @@ static int dtlsEventCb
                                     ///< greater indicate internal DTLS session changes.
 )
 {
+    dtls_Instance_t* instancePtr = (dtls_Instance_t*)ctxPtr->app;
+
     (void)level;
     (void)sessionPtr;
-    (void)ctxPtr;
 
     switch (code)
     {
@@ -522,12 +694,12 @@ static int dtlsEventCb
         case DTLS_EVENT_RENEGOTIATE:
         {
             // Do not notify in case of rehandshake
-            if (false == IsRehandshake)
+            if (false == instancePtr->isRehandshake)
             {
                 /* Notify that the device starts an authentication */
                 smanager_SendSessionEvent(EVENT_TYPE_AUTHENTICATION, EVENT_STATUS_STARTED, NULL);
             }
-            IsRehandshake = false;
+            instancePtr->isRehandshake = false;
         }
         break;
 
@@ -556,24 +728,77 @@ static int dtlsEventCb
     return 0;
 }
 
+#ifdef LWM2MCORE_DTLS_CID
+// The Connection ID is supported by tinyDTLS when it is built with a non-null DTLS_MAX_CID_LENGTH
+#if (!defined(DTLS_MAX_CID_LENGTH)) || (0 == DTLS_MAX_CID_LENGTH)
+#error "LWM2MCORE_DTLS_CID requires a tinyDTLS version supporting the Connection ID (RFC 9146)"
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * TinyDTLS Callbacks
+ * This function is called by tinyDTLS before a handshake to get the handshake parameters. The
+ * Connection ID extension (RFC 9146) is requested: the server keeps the session of the client
+ * when its address or port is changed by a NAT.
+ */
+//--------------------------------------------------------------------------------------------------
+static void GetUserParameters
+(
+    struct dtls_context_t* ctxPtr,                  ///< [IN] DTLS context
+    session_t* sessionPtr,                          ///< [IN] DTLS session
+    dtls_user_parameters_t* userParametersPtr       ///< [INOUT] Handshake parameters
+)
+{
+    (void)ctxPtr;
+    (void)sessionPtr;
+
+    userParametersPtr->support_cid = true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function to check if the server gave a Connection ID for the DTLS session of a connection
+ *
+ * @return
+ *  - true if the records sent to the server carry a Connection ID
+ *  - false else
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsCidUsed
+(
+    dtls_Connection_t* connPtr          ///< [IN] DTLS connection
+)
+{
+    dtls_peer_t* peerPtr = dtls_get_peer(connPtr->dtlsContextPtr, connPtr->dtlsSessionPtr);
+
+    return ((NULL != peerPtr)
+         && (DTLS_STATE_CONNECTED == peerPtr->state)
+         && (NULL != dtls_security_params(peerPtr))
+         && (0 < dtls_security_params(peerPtr)->write_cid_length));
+}
+#endif
+
 //--------------------------------------------------------------------------------------------------
 /**
  * TinyDTLS Callbacks
  */
 //--------------------------------------------------------------------------------------------------
 static dtls_handler_t cb = {
-  SendToPeer,                   //.write
-  ReadFromPeer,                 //.read
-  dtlsEventCb,                  //.event
-  GetPskInfo,                   //.get_psk_info
-  NULL,                         //.get_ecdsa_key
-  NULL                          //.verify_ecdsa_key
+  .write = SendToPeer,
+  .read = ReadFromPeer,
+  .event = dtlsEventCb,
+  .get_psk_info = GetPskInfo,
+  .get_ecdsa_key = NULL,
+  .verify_ecdsa_key = NULL,
+#ifdef LWM2MCORE_DTLS_CID
+  .get_user_parameters = GetUserParameters,
+#endif
 };
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * This function returns a DTLS context from DTLS connection list
+ * This function returns the DTLS context of a client instance and updates its connection list
  *
  * @return
  *  - dtls_context_t pointer
@@ -582,139 +807,204 @@ static dtls_handler_t cb = {
 //--------------------------------------------------------------------------------------------------
 static dtls_context_t* GetDtlsContext
 (
+    dtls_Instance_t* instancePtr,     ///< [IN] DTLS state of the client instance
     dtls_Connection_t* connListPtr    ///< [IN] DTLS connection
 )
 {
-    if (NULL == DtlsContextPtr)
+    instancePtr->connListPtr = connListPtr;
+
+    if (NULL == instancePtr->dtlsContextPtr)
     {
-        dtls_init();
-        DtlsContextPtr = dtls_new_context(connListPtr);
-        if (NULL == DtlsContextPtr)
+        if (!IsDtlsInitialized)
+        {
+            dtls_init();
+            IsDtlsInitialized = true;
+        }
+        instancePtr->dtlsContextPtr = dtls_new_context(instancePtr);
+        if (NULL == instancePtr->dtlsContextPtr)
         {
             LOG("Failed to create the DTLS context");
             return NULL;
         }
-        dtls_set_handler(DtlsContextPtr, &cb);
-    }
-    else
-    {
-        DtlsContextPtr->app = connListPtr;
+        dtls_set_handler(instancePtr->dtlsContextPtr, &cb);
     }
-    return DtlsContextPtr;
+    return instancePtr->dtlsContextPtr;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * This function returns the port associated to sockaddr
+ * This function computes the normalized peer address of a socket address: IPv4 addresses are
+ * stored as IPv4-mapped IPv6 addresses
  *
  * @return
- *  - port number
- *  - -1 in case of failure
+ *  - true on success
+ *  - false if the address is neither IPv4 nor IPv6
  */
 //--------------------------------------------------------------------------------------------------
-static int GetPort
+static bool GetConnectionKey
 (
-    struct sockaddr* x      ///< [IN] Socket information
+    const struct sockaddr* addrPtr,     ///< [IN] Socket address structure
+    dtls_ConnectionKey_t* keyPtr        ///< [OUT] Normalized peer address
 )
 {
-    if (!x)
-    {
-        LOG("Invalid parameter");
-        return -1;
-    }
+    memset(keyPtr, 0, sizeof(dtls_ConnectionKey_t));
 
-    if (x->sa_family == AF_INET)
+    if (AF_INET == addrPtr->sa_family)
     {
-        return ((struct sockaddr_in *)(void*)x)->sin_port;
+        const struct sockaddr_in* addr4Ptr = (const struct sockaddr_in*)(const void*)addrPtr;
+        keyPtr->addr[10] = 0xFF;
+        keyPtr->addr[11] = 0xFF;
+        memcpy(&(keyPtr->addr[12]), &(addr4Ptr->sin_addr.s_addr), 4);
+        keyPtr->port = addr4Ptr->sin_port;
+        return true;
     }
-    else if (x->sa_family == AF_INET6)
+    if (AF_INET6 == addrPtr->sa_family)
     {
-        return ((struct sockaddr_in6 *)(void*)x)->sin6_port;
+        const struct sockaddr_in6* addr6Ptr = (const struct sockaddr_in6*)(const void*)addrPtr;
+        memcpy(keyPtr->addr, addr6Ptr->sin6_addr.s6_addr, sizeof(keyPtr->addr));
+        keyPtr->port = addr6Ptr->sin6_port;
+        return true;
     }
-    else
+
+    LOG("Non IPV4 or IPV6 address");
+    return false;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function returns the bucket of a peer address in the DTLS connection index (FNV-1a hash)
+ *
+ * @return
+ *  - bucket number
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t GetConnectionBucket
+(
+    const dtls_ConnectionKey_t* keyPtr  ///< [IN] Normalized peer address
+)
+{
+    uint32_t hash = 2166136261u;
+    size_t i;
+
+    for (i = 0; i < sizeof(keyPtr->addr); i++)
     {
-        LOG("non IPV4 or IPV6 address");
-        return  -1;
+        hash = (hash ^ keyPtr->addr[i]) * 16777619u;
     }
+    hash = (hash ^ (keyPtr->port & 0xFF)) * 16777619u;
+    hash = (hash ^ (keyPtr->port >> 8)) * 16777619u;
+
+    return hash & (LWM2MCORE_DTLS_CONNECTION_HASH_SIZE - 1);
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * This function compares 2 socket information
+ * This function compares 2 normalized peer addresses
  *
  * @return
- *  - port number
- *  - -1 in case of failure
+ *  - true if the peer addresses are the same
+ *  - false else
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsSameConnectionKey
+(
+    const dtls_ConnectionKey_t* key1Ptr,    ///< [IN] Normalized peer address 1
+    const dtls_ConnectionKey_t* key2Ptr     ///< [IN] Normalized peer address 2
+)
+{
+    return ((key1Ptr->port == key2Ptr->port)
+         && (0 == memcmp(key1Ptr->addr, key2Ptr->addr, sizeof(key1Ptr->addr))));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function adds a connection of the connection list to the index of the client instance
  */
 //--------------------------------------------------------------------------------------------------
-static int SockaddrCmp
+static void IndexConnection
 (
-    struct sockaddr *x,     ///< [IN] Socket information 1
-    struct sockaddr *y      ///< [IN] Socket information 2
+    dtls_Instance_t* instancePtr,       ///< [IN] DTLS state of the client instance
+    dtls_Connection_t* connPtr          ///< [IN] DTLS connection
 )
 {
-    int portX;
-    int portY;
+    uint32_t bucket;
 
-    if ((!x) || (!y))
+    if (!connPtr->isKeyValid)
     {
-        LOG("Invalid parameter");
-        return -1;
+        return;
     }
 
-    portX = GetPort(x);
-    portY = GetPort(y);
+    bucket = GetConnectionBucket(&(connPtr->key));
+    connPtr->hashNextPtr = instancePtr->connHash[bucket];
+    instancePtr->connHash[bucket] = connPtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function removes a connection from the index of the client instance
+ */
+//--------------------------------------------------------------------------------------------------
+static void UnindexConnection
+(
+    dtls_Instance_t* instancePtr,       ///< [IN] DTLS state of the client instance
+    dtls_Connection_t* connPtr          ///< [IN] DTLS connection
+)
+{
+    dtls_Connection_t** entryPtr;
 
-    // if the port is invalid of different
-    if ((-1 == portX) || (portX != portY))
+    if (!connPtr->isKeyValid)
     {
-        return 0;
+        return;
     }
 
-    // IPV4?
-    if (AF_INET == x->sa_family)
+    entryPtr = &(instancePtr->connHash[GetConnectionBucket(&(connPtr->key))]);
+    while (NULL != *entryPtr)
     {
-        // is V4?
-        if (AF_INET == y->sa_family)
-        {
-            // compare V4 with V4
-            return ((struct sockaddr_in *)(void*)x)->sin_addr.s_addr == \
-                                            ((struct sockaddr_in *)(void*)y)->sin_addr.s_addr;
-            // is V6 mapped V4?
-        }
-        else if (IN6_IS_ADDR_V4MAPPED(&((struct sockaddr_in6 *)(void*)y)->sin6_addr))
-        {
-            struct in6_addr* addr6 = &((struct sockaddr_in6 *)(void*)y)->sin6_addr;
-            uint32_t y6to4 = addr6->s6_addr[15] << 24 | \
-                             addr6->s6_addr[14] << 16 | \
-                             addr6->s6_addr[13] << 8 | \
-                             addr6->s6_addr[12];
-            return y6to4 == ((struct sockaddr_in *)(void*)x)->sin_addr.s_addr;
-        }
-        else
+        if (connPtr == *entryPtr)
         {
-            return 0;
+            *entryPtr = connPtr->hashNextPtr;
+            connPtr->hashNextPtr = NULL;
+            return;
         }
+        entryPtr = &((*entryPtr)->hashNextPtr);
     }
-    else if (x->sa_family == AF_INET6 && y->sa_family == AF_INET6)
-    {
-        // IPV6 with IPV6 compare
-        return memcmp(((struct sockaddr_in6 *)(void*)x)->sin6_addr.s6_addr,
-                      ((struct sockaddr_in6 *)(void*)y)->sin6_addr.s6_addr,
-                      16) == 0;
-    }
-    else
+}
+
+#ifdef LWM2M_RETAIN_SERVER_LIST
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function to search a retained DTLS connection. The retained list is only searched when a
+ * connection is created, so it is not indexed.
+ *
+ * @return
+ *  - dtls_Connection_t pointer if the DTLS connection is retained
+ *  - NULL else
+ */
+//--------------------------------------------------------------------------------------------------
+static dtls_Connection_t* FindRetainedConnection
+(
+    dtls_Connection_t* retainedListPtr,     ///< [IN] Retained DTLS connection list
+    const dtls_ConnectionKey_t* keyPtr      ///< [IN] Normalized peer address
+)
+{
+    while ((NULL != retainedListPtr)
+        && ((!retainedListPtr->isKeyValid) || (!IsSameConnectionKey(&(retainedListPtr->key),
+                                                                   keyPtr))))
     {
-        // unknown address type
-        LOG("Non IPV4 or IPV6 address");
-        return 0;
+        retainedListPtr = retainedListPtr->nextPtr;
     }
+    return retainedListPtr;
 }
+#endif
 
 //--------------------------------------------------------------------------------------------------
 /**
  * Function to search if a DTLS connection is available
  *
+ * The connection list of the client instance is indexed by peer address, so that the connection
+ * of a received datagram is found without walking the list. Only the connections with a DTLS
+ * context are indexed: lwm2m_connect_server() frees the other ones (NoSec mode, or tinyDTLS context
+ * creation failure), so there is no connection to fall back on and NULL is returned for their peer.
+ *
  * @return
  *  - dtls_Connection_t pointer if the DTLS connection is available
  *  - NULL if the DTLS connection is not available in the indicated socket
@@ -722,30 +1012,30 @@ static int SockaddrCmp
 //--------------------------------------------------------------------------------------------------
 dtls_Connection_t* dtls_FindConnection
 (
-    dtls_Connection_t* connListPtr,         ///< [IN] DTLS connection list
+    dtls_Instance_t* instancePtr,           ///< [IN] DTLS state of the client instance
     const struct sockaddr_storage* addrPtr, ///< [IN] Socket address structure
     size_t addrLen                          ///< [IN] Socket address structure length
 )
 {
+    dtls_ConnectionKey_t key;
     dtls_Connection_t* connPtr;
 
-    if (!addrPtr)
+    if ((!instancePtr) || (!addrPtr))
     {
         return NULL;
     }
 
     (void)addrLen;
 
-    connPtr = connListPtr;
-
-    while (NULL != connPtr)
+    if (!GetConnectionKey((const struct sockaddr*)addrPtr, &key))
     {
-       if (SockaddrCmp((struct sockaddr*) (&connPtr->addr), (struct sockaddr*) addrPtr))
-       {
-            return connPtr;
-       }
+        return NULL;
+    }
 
-       connPtr = connPtr->nextPtr;
+    connPtr = instancePtr->connHash[GetConnectionBucket(&key)];
+    while ((NULL != connPtr) && (!IsSameConnectionKey(&(connPtr->key), &key)))
+    {
+        connPtr = connPtr->hashNextPtr;
     }
 
     return connPtr;
@@ -776,6 +1066,7 @@ dtls_Connection_t* dtls_HandleNewIncoming
         memcpy(&(connPtr->addr), addrPtr, addrLen);
         connPtr->addrLen = addrLen;
         connPtr->nextPtr = connListPtr;
+        connPtr->isKeyValid = GetConnectionKey(addrPtr, &(connPtr->key));
 
         connPtr->dtlsSessionPtr = (session_t*)lwm2m_malloc(sizeof(session_t));
         if (!(connPtr->dtlsSessionPtr))
@@ -790,6 +1081,9 @@ dtls_Connection_t* dtls_HandleNewIncoming
         connPtr->lastSend = lwm2m_gettime();
         connPtr->postRequestHandler = NULL;
         connPtr->cmdEndHandler = NULL;
+        coapRtt_Init(&(connPtr->rtt));
+        connPtr->reportedRtoMs = connPtr->rtt.rtoMs;
+        blockSize_Init(&(connPtr->blockSize));
     }
     return connPtr;
 }
@@ -805,6 +1099,7 @@ dtls_Connection_t* dtls_HandleNewIncoming
 //--------------------------------------------------------------------------------------------------
 dtls_Connection_t* dtls_CreateConnection
 (
+    dtls_Instance_t* instancePtr,       ///< [IN] DTLS state of the client instance
     dtls_Connection_t* connListPtr,     ///< [IN] DTLS connection structure
     int sock,                           ///< [IN] Socket Id
     lwm2m_object_t* securityObjPtr,     ///< [IN] Security object pointer
@@ -889,11 +1184,17 @@ dtls_Connection_t* dtls_CreateConnection
             connPtr->securityObjPtr = securityObjPtr;
             connPtr->securityInstId = instanceId;
             connPtr->lwm2mHPtr = lwm2mHPtr;
+            connPtr->instancePtr = instancePtr;
 
             if (LWM2M_SECURITY_MODE_NONE != SecurityGetMode(connPtr->securityObjPtr,
                                                             connPtr->securityInstId))
             {
-                connPtr->dtlsContextPtr = GetDtlsContext(connPtr);
+                connPtr->dtlsContextPtr = GetDtlsContext(instancePtr, connPtr);
+                // Only the connections with a DTLS context are kept in the list by the caller
+                if (NULL != connPtr->dtlsContextPtr)
+                {
+                    IndexConnection(instancePtr, connPtr);
+                }
             }
             else
             {
@@ -906,9 +1207,7 @@ dtls_Connection_t* dtls_CreateConnection
             }
 #ifdef LWM2M_RETAIN_SERVER_LIST
             dtls_Connection_t* globalConnPtr = NULL;
-            globalConnPtr = dtls_FindConnection(DtlsConnectionListPtr,
-                                                (const struct sockaddr_storage *)&saPtr,
-                                                sl);
+            globalConnPtr = FindRetainedConnection(instancePtr->retainedListPtr, &(connPtr->key));
             if (globalConnPtr)
             {
                 LOG("Re-using existing dtls connection");
@@ -925,8 +1224,11 @@ dtls_Connection_t* dtls_CreateConnection
             else
             {
                 LOG("Create a new DTLS connection");
-                globalConnPtr = dtls_HandleNewIncoming(DtlsConnectionListPtr, sock, &saPtr, sl);
-                DtlsConnectionListPtr = globalConnPtr;
+                globalConnPtr = dtls_HandleNewIncoming(instancePtr->retainedListPtr,
+                                                       sock,
+                                                       &saPtr,
+                                                       sl);
+                instancePtr->retainedListPtr = globalConnPtr;
             }
 #endif
         }
@@ -944,13 +1246,19 @@ dtls_Connection_t* dtls_CreateConnection
 //--------------------------------------------------------------------------------------------------
 void dtls_FreeConnection
 (
-    dtls_Connection_t* connListPtr
+    dtls_Instance_t* instancePtr,       ///< [IN] DTLS state of the client instance
+    dtls_Connection_t* connListPtr      ///< [IN] DTLS connection structure
 )
 {
 #ifndef LWM2M_RETAIN_SERVER_LIST
-    dtls_free_context(DtlsContextPtr);
-    DtlsContextPtr = NULL;
+    if (NULL != instancePtr->dtlsContextPtr)
+    {
+        dtls_free_context(instancePtr->dtlsContextPtr);
+        instancePtr->dtlsContextPtr = NULL;
+    }
 #endif
+    instancePtr->connListPtr = NULL;
+    memset(instancePtr->connHash, 0, sizeof(instancePtr->connHash));
 
     while (NULL != connListPtr)
     {
@@ -971,13 +1279,109 @@ void dtls_FreeConnection
 //--------------------------------------------------------------------------------------------------
 void dtls_UpdateDtlsList
 (
+    dtls_Instance_t* instancePtr,       ///< [IN] DTLS state of the client instance
     dtls_Connection_t* connListPtr      ///< [IN] DTLS connection structure
 )
 {
-    if (DtlsContextPtr)
+    instancePtr->connListPtr = connListPtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the DTLS state of a client instance
+ */
+//--------------------------------------------------------------------------------------------------
+void dtls_InitInstance
+(
+    dtls_Instance_t* instancePtr        ///< [IN] DTLS state of the client instance
+)
+{
+    memset(instancePtr, 0, sizeof(dtls_Instance_t));
+    instancePtr->natTimeout = DtlsNatTimeout;
+    instancePtr->isNatAdaptive = IsDtlsNatAdaptive;
+    natTimeout_Init(&(instancePtr->natEstimator), DtlsNatTimeout);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release the DTLS state of a client instance: tinyDTLS context and retained connections
+ */
+//--------------------------------------------------------------------------------------------------
+void dtls_FreeInstance
+(
+    dtls_Instance_t* instancePtr        ///< [IN] DTLS state of the client instance
+)
+{
+    while (NULL != instancePtr->retainedListPtr)
+    {
+        dtls_Connection_t* nextPtr = instancePtr->retainedListPtr->nextPtr;
+        lwm2m_free(instancePtr->retainedListPtr->dtlsSessionPtr);
+        lwm2m_free(instancePtr->retainedListPtr);
+        instancePtr->retainedListPtr = nextPtr;
+    }
+
+    if (NULL != instancePtr->dtlsContextPtr)
+    {
+        dtls_free_context(instancePtr->dtlsContextPtr);
+        instancePtr->dtlsContextPtr = NULL;
+    }
+    instancePtr->connListPtr = NULL;
+    memset(instancePtr->connHash, 0, sizeof(instancePtr->connHash));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function to check if a CoAP message is confirmable
+ *
+ * @return
+ *  - true if the message is confirmable
+ *  - false else
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsCoapConfirmable
+(
+    const uint8_t* bufferPtr,           ///< [IN] CoAP message
+    size_t length                       ///< [IN] CoAP message length
+)
+{
+    return ((COAP_HEADER_LEN <= length)
+         && (COAP_TYPE_CON == ((bufferPtr[0] & COAP_TYPE_MASK) >> COAP_TYPE_SHIFT)));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function to check if the NAT binding may have expired since the last data exchanged with the
+ * server, so that a DTLS resume is needed.
+ *
+ * When the NAT timeout is learned, a confirmable message sent without resume probes the binding:
+ * the answer of the server, or the retransmission of the message, tells if the binding survived.
+ *
+ * @return
+ *  - true if a DTLS resume is needed
+ *  - false else
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsNatResumeNeeded
+(
+    dtls_Connection_t* connPtr,         ///< [IN] DTLS connection structure
+    const uint8_t* bufferPtr,           ///< [IN] CoAP message
+    size_t length,                      ///< [IN] CoAP message length
+    time_t timeFromLastSentData,        ///< [IN] Time since the last data sent to the server
+    time_t timeFromLastReceivedData     ///< [IN] Time since the last data received from the server
+)
+{
+    time_t idle = (timeFromLastSentData < timeFromLastReceivedData) ? timeFromLastSentData :
+                                                                      timeFromLastReceivedData;
+
+    if (!connPtr->instancePtr->isNatAdaptive)
+    {
+        return (connPtr->instancePtr->natTimeout < idle);
+    }
+    if (!IsCoapConfirmable(bufferPtr, length))
     {
-        DtlsContextPtr->app = connListPtr;
+        return (connPtr->instancePtr->natEstimator.timeout < idle);
     }
+    return natTimeout_IsResumeNeeded(&(connPtr->instancePtr->natEstimator), (uint32_t)idle);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -995,16 +1399,17 @@ static int ConnectionSend
     dtls_Connection_t* connPtr,         ///< [IN] DTLS connection structure
     uint8_t* bufferPtr,                 ///< [IN] Buffer to be sent
     size_t length,                      ///< [IN] Buffer length
-    bool firstBlock                     ///< [IN] First data block
+    bool firstBlock,                    ///< [IN] First data block
+    bool isRetransmission               ///< [IN] Confirmable CoAP message sent again
 )
 {
     if (NULL == connPtr->dtlsSessionPtr)
     {
-        LOG("ConnectionSend NO SEC");
+        LOG_DBG("ConnectionSend NO SEC");
         // no security
         if ( 0 > SendData(connPtr, bufferPtr, length))
         {
-            LOG("ConnectionSend SendData != 0");
+            LOG_ERR("ConnectionSend SendData != 0");
             return -1;
         }
     }
@@ -1012,10 +1417,39 @@ static int ConnectionSend
     {
         time_t timeFromLastSentData = lwm2m_gettime() - connPtr->lastSend;
         time_t timeFromLastReceivedData = lwm2m_gettime() - connPtr->lastReceived;
-        LOG_ARG("now - connP->lastSend %d", timeFromLastSentData);
-        LOG_ARG("now - connP->lastReceived %d", timeFromLastReceivedData);
-        LOG_ARG("DtlsNatTimeout %d", DtlsNatTimeout);
+        LOG_DBG("now - connP->lastSend %d", (int)timeFromLastSentData);
+        LOG_DBG("now - connP->lastReceived %d", (int)timeFromLastReceivedData);
+        uint32_t natTimeout = dtls_GetNatTimeout(connPtr->instancePtr);
+        LOG_DBG("natTimeout %d", (int)natTimeout);
 
+        if ((isRetransmission) && (natTimeout_IsProbing(&(connPtr->instancePtr->natEstimator))))
+        {
+            // The server did not answer the probe: the NAT binding was lost
+            if (natTimeout_ReportProbe(&(connPtr->instancePtr->natEstimator), false))
+            {
+                ReportNatTimeout(connPtr->instancePtr);
+            }
+            if (0 > dtls_ResumeSession(connPtr))
+            {
+                LOG("Unable to resume. Fall-back to a rehandshake");
+                if (0 > dtls_Rehandshake(connPtr, false))
+                {
+                    LOG("Unable to perform rehandshake");
+                    return -1;
+                }
+            }
+        }
+        else
+#ifdef LWM2MCORE_DTLS_CID
+        // With a Connection ID, the server finds the session even if the NAT changed the address
+        // or port of the client: no resume is needed after an inactivity
+        if ((firstBlock) && (IsCidUsed(connPtr)))
+        {
+            LOG_DBG("DTLS Connection ID used: no resume");
+            perfMetrics_Add(LWM2MCORE_COUNTER_DTLS_RESUMES_AVOIDED, 1);
+        }
+        else
+#endif
         if (firstBlock)
         {
             // If difference is negative, a time update could have been made on platform side.
@@ -1029,9 +1463,12 @@ static int ConnectionSend
                     return -1;
                 }
             }
-            else if ((0 < DtlsNatTimeout)
-                  && (DtlsNatTimeout < timeFromLastSentData)
-                  && (DtlsNatTimeout < timeFromLastReceivedData))
+            else if ((0 < natTimeout)
+                  && (IsNatResumeNeeded(connPtr,
+                                        bufferPtr,
+                                        length,
+                                        timeFromLastSentData,
+                                        timeFromLastReceivedData)))
             {
                 if (0 > dtls_ResumeSession(connPtr))
                 {
@@ -1045,13 +1482,13 @@ static int ConnectionSend
             }
         }
 
-        LOG_ARG("ConnectionSend SEC length %d", length);
+        LOG_DBG("ConnectionSend SEC length %zu", length);
         if (-1 == dtls_write(connPtr->dtlsContextPtr,
                              connPtr->dtlsSessionPtr,
                              bufferPtr,
                              length))
         {
-            LOG("ConnectionSend dtls_write -1");
+            LOG_ERR("ConnectionSend dtls_write -1");
             return -1;
         }
     }
@@ -1095,14 +1532,16 @@ int dtls_HandlePacket
 
         if (0 != result)
         {
-            LOG_ARG("Error DTLS handling message %d",result);
+            LOG_ERR("Error DTLS handling message %d",result);
         }
         return result;
     }
     else
     {
         // no security, just give the plaintext buffer to Wakaama
-        lwm2mcore_DataDump("Received bytes in no sec", bufferPtr, numBytes);
+        LOG_DUMP("Received bytes in no sec", bufferPtr, numBytes);
+        LearnCoapRtt(connPtr, bufferPtr, numBytes);
+        omanager_ReleaseRequestMemory();
         lwm2m_handle_packet(connPtr->lwm2mHPtr, bufferPtr, numBytes, (void*)connPtr);
     }
 
@@ -1136,6 +1575,9 @@ int dtls_Rehandshake
         return 0;
     }
 
+    // The start of a rehandshake is not notified: measure it from here
+    smanager_StartMetric(LWM2MCORE_METRIC_DTLS_HANDSHAKE);
+
     // reset current session
     peer = dtls_get_peer(connPtr->dtlsContextPtr, connPtr->dtlsSessionPtr);
     if (peer != NULL)
@@ -1147,13 +1589,13 @@ int dtls_Rehandshake
         dtls_reset_peer(connPtr->dtlsContextPtr, peer);
     }
 
-    IsRehandshake = true;
+    connPtr->instancePtr->isRehandshake = true;
     // start a fresh handshake
     result = dtls_connect(connPtr->dtlsContextPtr, connPtr->dtlsSessionPtr);
     if (0 > result)
     {
          LOG_ARG("Error DTLS reconnection %d", result);
-         IsRehandshake = false;
+         connPtr->instancePtr->isRehandshake = false;
     }
     return result;
 }
@@ -1182,6 +1624,8 @@ int dtls_ResumeSession
         return 0;
     }
 
+    smanager_StartMetric(LWM2MCORE_METRIC_DTLS_RESUME);
+
     // start a resume
     result = dtls_resume(connPtr->dtlsContextPtr, connPtr->dtlsSessionPtr);
     if (0 > result)
@@ -1191,6 +1635,156 @@ int dtls_ResumeSession
     return result;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function to read an extended option delta or length of a CoAP option
+ *
+ * @return
+ *  - true if the value is read
+ *  - false if the message is truncated or the value is reserved
+ */
+//--------------------------------------------------------------------------------------------------
+static bool ReadCoapOptionValue
+(
+    const uint8_t* bufferPtr,           ///< [IN] CoAP message
+    size_t length,                      ///< [IN] CoAP message length
+    size_t* posPtr,                     ///< [INOUT] Position of the extended bytes
+    uint32_t* valuePtr                  ///< [INOUT] 4-bit value, extended value
+)
+{
+    if (COAP_OPTION_EXT_1 == *valuePtr)
+    {
+        if (*posPtr + 1 > length)
+        {
+            return false;
+        }
+        *valuePtr = bufferPtr[*posPtr] + 13;
+        *posPtr += 1;
+    }
+    else if (COAP_OPTION_EXT_2 == *valuePtr)
+    {
+        if (*posPtr + 2 > length)
+        {
+            return false;
+        }
+        *valuePtr = (uint32_t)((bufferPtr[*posPtr] << 8) | bufferPtr[*posPtr + 1]) + 269;
+        *posPtr += 2;
+    }
+    else if (COAP_OPTION_EXT_2 < *valuePtr)
+    {
+        return false;
+    }
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function to check if a CoAP message carries a full block of a block-wise transfer: the Block1
+ * option of a request or the Block2 option of a response, with more blocks to follow. The last
+ * block is shorter than the block size and does not tell whether the size goes through.
+ *
+ * @return
+ *  - true if the message is a full block
+ *  - false else
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsCoapFullBlock
+(
+    const uint8_t* bufferPtr,           ///< [IN] CoAP message
+    size_t length                       ///< [IN] CoAP message length
+)
+{
+    uint32_t blockNumber;
+    uint32_t number = 0;
+    uint32_t delta;
+    uint32_t len;
+    size_t pos;
+
+    if (COAP_HEADER_LEN > length)
+    {
+        return false;
+    }
+
+    // The code class is 0 for a request
+    blockNumber = (0 == (bufferPtr[1] >> 5)) ? COAP_OPTION_BLOCK1_NUM : COAP_OPTION_BLOCK2_NUM;
+    pos = COAP_HEADER_LEN + (bufferPtr[0] & COAP_TOKEN_LEN_MASK);
+
+    while ((pos < length) && (COAP_PAYLOAD_MARKER != bufferPtr[pos]))
+    {
+        delta = bufferPtr[pos] >> 4;
+        len = bufferPtr[pos] & 0x0F;
+        pos++;
+        if (   (!ReadCoapOptionValue(bufferPtr, length, &pos, &delta))
+            || (!ReadCoapOptionValue(bufferPtr, length, &pos, &len))
+            || (pos + len > length))
+        {
+            return false;
+        }
+
+        number += delta;
+        if (blockNumber == number)
+        {
+            // The more flag is in the last byte of the option value
+            return ((0 < len) && (bufferPtr[pos + len - 1] & COAP_BLOCK_MORE));
+        }
+        if (blockNumber < number)
+        {
+            return false;
+        }
+        pos += len;
+    }
+    return false;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function to count the CoAP retransmissions
+ *
+ * Wakaama sends a confirmable message again with the same message Id when no acknowledgement is
+ * received: a confirmable message whose exchange is still followed by the round-trip time
+ * estimation of the connection is a retransmission, whatever the number of messages in flight.
+ *
+ * The full blocks of the block-wise transfers feed the block size selection of the connection: the
+ * first retransmission of a block reports a loss, the acknowledgement of a block sent once a
+ * success (see LearnCoapRtt()).
+ *
+ * @return
+ *  - true if the message is a retransmission
+ *  - false else
+ */
+//--------------------------------------------------------------------------------------------------
+static bool CountCoapRetransmission
+(
+    dtls_Connection_t* connPtr,         ///< [IN] DTLS connection structure
+    const uint8_t* bufferPtr,           ///< [IN] CoAP message
+    size_t length                       ///< [IN] CoAP message length
+)
+{
+    uint16_t mid;
+    bool isRetransmission;
+
+    if (!IsCoapConfirmable(bufferPtr, length))
+    {
+        return false;
+    }
+
+    mid = (uint16_t)((bufferPtr[2] << 8) | bufferPtr[3]);
+    isRetransmission = coapRtt_Sent(&(connPtr->rtt), mid, lwm2mcore_TimerGetTimeMs());
+    if (isRetransmission)
+    {
+        perfMetrics_Add(LWM2MCORE_COUNTER_COAP_RETRANSMISSIONS, 1);
+        if (coapRtt_TakeFullBlock(&(connPtr->rtt), mid))
+        {
+            blockSize_ReportLoss(&(connPtr->blockSize));
+        }
+    }
+    else if (IsCoapFullBlock(bufferPtr, length))
+    {
+        coapRtt_SetFullBlock(&(connPtr->rtt), mid);
+    }
+    return isRetransmission;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Function to send data on a specific peer
@@ -1210,18 +1804,21 @@ uint8_t lwm2m_buffer_send
 )
 {
     dtls_Connection_t* connPtr = (dtls_Connection_t*) sessionHPtr;
+    bool isRetransmission;
 
     (void)userDataPtr;
 
     if (NULL == connPtr)
     {
-        LOG_ARG("#> Failed sending %lu bytes, missing connection", length);
+        LOG_ERR("#> Failed sending %lu bytes, missing connection", length);
         return COAP_500_INTERNAL_SERVER_ERROR ;
     }
 
-    if (-1 == ConnectionSend(connPtr, bufferPtr, length, firstBlock))
+    isRetransmission = CountCoapRetransmission(connPtr, bufferPtr, length);
+
+    if (-1 == ConnectionSend(connPtr, bufferPtr, length, firstBlock, isRetransmission))
     {
-        LOG_ARG("#> Failed sending %lu bytes", length);
+        LOG_ERR("#> Failed sending %lu bytes", length);
         return COAP_500_INTERNAL_SERVER_ERROR ;
     }
 
@@ -1256,7 +1853,7 @@ bool lwm2m_session_is_equal
 void dtls_HandshakeRetransmission
 (
     dtls_Connection_t*  connListPtr,        ///< [IN] DTLS connection list
-    dtls_tick_t*        timerValue,         ///< [INOUT] Timer value for retransmission
+    dtls_tick_t*        timerValue,         ///< [INOUT] Timer value for retransmission in ms
     bool*               isMaxReached        ///< [INOUT] Is maximum retransmission reached ?
 )
 {
@@ -1288,20 +1885,19 @@ void dtls_HandshakeRetransmission
     {
         dtls_tick_t now;
         dtls_ticks(&now);
-        if (now > *timerValue)
+        if (now >= *timerValue)
         {
-            // This should not happen
+            // The retransmission is already due
             *timerValue = 1;
         }
         else
         {
-            // In order to be sure that DTLS is retransmitted at next call to dtls_check_retransmit,
-            // add 1 second (because of division by 1000)
-            *timerValue = (((*timerValue) - now) / 1000) + 1;
+            // DTLS ticks are in ms: no rounding to the second is needed
+            *timerValue = (*timerValue) - now;
         }
     }
 
-    LOG_ARG("DTLS retransmission %d sec, isMaxReached %d", *timerValue, *isMaxReached);
+    LOG_DBG("DTLS retransmission %d ms, isMaxReached %d", *timerValue, *isMaxReached);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1321,6 +1917,11 @@ void dtls_CloseAndFreePeer
         return;
     }
 
+    if (NULL != targetPtr->instancePtr)
+    {
+        UnindexConnection(targetPtr->instancePtr, targetPtr);
+    }
+
     peer = dtls_get_peer(targetPtr->dtlsContextPtr, targetPtr->dtlsSessionPtr);
     if (peer != NULL)
     {
@@ -1329,14 +1930,14 @@ void dtls_CloseAndFreePeer
     }
 
 #ifdef LWM2M_RETAIN_SERVER_LIST
-    // Remove from global DTLS connection list since we are resetting the peer
-    if (DtlsConnectionListPtr)
+    // Remove from the retained DTLS connection list since we are resetting the peer
+    if (targetPtr->instancePtr->retainedListPtr)
     {
-        dtls_Connection_t* tmp = DtlsConnectionListPtr;
+        dtls_Connection_t* tmp = targetPtr->instancePtr->retainedListPtr;
         dtls_Connection_t* prev = NULL;
 
-        while (tmp && !SockaddrCmp((struct sockaddr*) (&tmp->addr),
-                                   (struct sockaddr*) (&targetPtr->addr)))
+        while (tmp && ((!tmp->isKeyValid) || (!IsSameConnectionKey(&(tmp->key),
+                                                                   &(targetPtr->key)))))
         {
             prev = tmp;
             tmp = tmp->nextPtr;
@@ -1346,7 +1947,7 @@ void dtls_CloseAndFreePeer
         {
             if (!prev)
             {
-                DtlsConnectionListPtr = tmp->nextPtr;
+                targetPtr->instancePtr->retainedListPtr = tmp->nextPtr;
             }
             else
             {
@@ -1405,12 +2006,111 @@ void dtls_ForceDtlsHandshake
  * If one of these times is greater than the NAT timeout, a DTLS resume is initiated.
  * Default value if this function is not called: 40 seconds.
  * Value 0 will deactivate any DTLS resume.
+ * If instancePtr is NULL, the timeout is the default one of the instances initialized later.
  */
 //--------------------------------------------------------------------------------------------------
 void dtls_SetNatTimeout
 (
+    dtls_Instance_t* instancePtr,  ///< [IN] DTLS state of the client instance
     uint32_t        timeout        ///< [IN] Timeout (unit: seconds)
 )
 {
-    DtlsNatTimeout = timeout;
+    if (NULL == instancePtr)
+    {
+        DtlsNatTimeout = timeout;
+        return;
+    }
+    instancePtr->natTimeout = timeout;
+    natTimeout_Init(&(instancePtr->natEstimator), timeout);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Enable or disable the learning of the DTLS NAT timeout
+ *
+ * The NAT timeout set by dtls_SetNatTimeout() is the initial value of the learning.
+ * If instancePtr is NULL, the setting is the default one of the instances initialized later.
+ */
+//--------------------------------------------------------------------------------------------------
+void dtls_SetAdaptiveNatTimeout
+(
+    dtls_Instance_t* instancePtr,  ///< [IN] DTLS state of the client instance
+    bool            isAdaptive     ///< [IN] Learn the NAT timeout
+)
+{
+    if (NULL == instancePtr)
+    {
+        IsDtlsNatAdaptive = isAdaptive;
+        return;
+    }
+    if (isAdaptive != instancePtr->isNatAdaptive)
+    {
+        natTimeout_Init(&(instancePtr->natEstimator), instancePtr->natTimeout);
+    }
+    instancePtr->isNatAdaptive = isAdaptive;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the DTLS NAT timeout in use, learned or configured
+ *
+ * @return
+ *  - NAT timeout in seconds
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t dtls_GetNatTimeout
+(
+    const dtls_Instance_t* instancePtr  ///< [IN] DTLS state of the client instance
+)
+{
+    // A null NAT timeout deactivates the DTLS resume, it is not learned
+    if ((instancePtr->isNatAdaptive) && (0 != instancePtr->natTimeout))
+    {
+        return instancePtr->natEstimator.timeout;
+    }
+    return instancePtr->natTimeout;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Apply the retransmission timeouts estimated on the connections to the pending CoAP transactions
+ *
+ * Wakaama schedules the retransmissions with the fixed CoAP timeouts, in seconds. The
+ * retransmission time of each transaction waiting for its acknowledgement is replaced by the
+ * deadline given by the round-trip time estimation of its connection.
+ */
+//--------------------------------------------------------------------------------------------------
+void dtls_AdaptRetransmissions
+(
+    lwm2m_transaction_t* transactionListPtr,///< [IN] Transaction list
+    uint32_t* timerValueMsPtr               ///< [INOUT] Delay before the next step in ms, lowered
+                                            ///< to the next retransmission
+)
+{
+    lwm2m_transaction_t* transacPtr;
+    uint64_t nowMs = lwm2mcore_TimerGetTimeMs();
+    time_t now = lwm2m_gettime();
+
+    for (transacPtr = transactionListPtr; NULL != transacPtr; transacPtr = transacPtr->next)
+    {
+        dtls_Connection_t* connPtr = (dtls_Connection_t*)transacPtr->peerH;
+        uint64_t deadlineMs;
+        uint64_t remainingMs;
+
+        if ((transacPtr->ack_received) || (NULL == connPtr) || (0 == transacPtr->retrans_counter))
+        {
+            continue;
+        }
+        if (!coapRtt_GetDeadline(&(connPtr->rtt), transacPtr->mID, &deadlineMs))
+        {
+            continue;
+        }
+
+        remainingMs = (deadlineMs > nowMs) ? (deadlineMs - nowMs) : 0;
+        transacPtr->retrans_time = now + (time_t)((remainingMs + 999) / 1000);
+        if (remainingMs < *timerValueMsPtr)
+        {
+            *timerValueMsPtr = (uint32_t)remainingMs;
+        }
+    }
 }
@@ -36,6 +36,9 @@
 #include "tinydtls.h"
 #include "dtls.h"
 #include "liblwm2m.h"
+#include "natTimeout.h"
+#include "coapRtt.h"
+#include "blockSize.h"
 
 /**
   * @addtogroup lwm2mcore_dtlsconnection_int
@@ -56,6 +59,27 @@
 //--------------------------------------------------------------------------------------------------
 #define DTLS_SHORT_NAT_TIMEOUT 5
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Number of buckets of the DTLS connection index of a client instance (power of 2)
+ */
+//--------------------------------------------------------------------------------------------------
+#ifndef LWM2MCORE_DTLS_CONNECTION_HASH_SIZE
+#define LWM2MCORE_DTLS_CONNECTION_HASH_SIZE 16
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Normalized peer address of a DTLS connection: IPv4 addresses are stored as IPv4-mapped
+ * IPv6 addresses, so that both forms of the same peer match
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint8_t                     addr[16];       ///< IPv6 or IPv4-mapped IPv6 address
+    uint16_t                    port;           ///< Port in network byte order
+}dtls_ConnectionKey_t;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * @brief Structure for DTLS connection
@@ -64,6 +88,9 @@
 typedef struct _dtls_Connection_t
 {
     struct _dtls_Connection_t*  nextPtr;        ///< Next entry in the list
+    struct _dtls_Connection_t*  hashNextPtr;    ///< Next entry in the index bucket
+    dtls_ConnectionKey_t        key;            ///< Normalized peer address
+    bool                        isKeyValid;     ///< Set if the peer address is IPv4 or IPv6
     int                         sock;           ///< Socket Id used for the DTLS connection
     struct sockaddr_in6         addr;           ///< Socket addess structure
     size_t                      addrLen;        ///< Socket addess structure length
@@ -80,8 +107,34 @@ typedef struct _dtls_Connection_t
                                                 ///< session handler to invoke if present
     lwm2mcore_Sid_t (*cmdEndHandler)(struct _dtls_Connection_t*, bool isSuccess); ///< Command end
                                                 ///< session handler to invoke if present
+    struct _dtls_Instance*      instancePtr;    ///< DTLS state of the client instance
+    coapRtt_Estimator_t         rtt;            ///< Round-trip time estimation of the server
+    uint32_t                    reportedRtoMs;  ///< Retransmission timeout reported to the
+                                                ///< application
+    blockSize_Estimator_t       blockSize;      ///< Block size of the block-wise transfers
 }dtls_Connection_t;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief DTLS state of a client instance
+ *
+ * It is embedded in the client data, so that each client instance has its own tinyDTLS context.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct _dtls_Instance
+{
+    dtls_context_t*             dtlsContextPtr; ///< tinyDTLS context of the client connections
+    dtls_Connection_t*          connListPtr;    ///< Connection list given to the tinyDTLS callbacks
+    dtls_Connection_t*          connHash[LWM2MCORE_DTLS_CONNECTION_HASH_SIZE];
+                                                ///< Index of the connection list by peer address
+    dtls_Connection_t*          retainedListPtr;///< Connections kept across sessions
+                                                ///< (LWM2M_RETAIN_SERVER_LIST)
+    bool                        isRehandshake;  ///< Set when a rehandshake is initiated
+    uint32_t                    natTimeout;     ///< NAT timeout in seconds
+    bool                        isNatAdaptive;  ///< Set if the NAT timeout is learned
+    natTimeout_Estimator_t      natEstimator;   ///< Learning state of the NAT timeout
+}dtls_Instance_t;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * @brief  Post LWM2M request handler that will be invoked to run after the processing of
@@ -110,6 +163,9 @@ typedef lwm2mcore_Sid_t (*cmdEndHandlerCb)
 /**
  * @brief Function to search if a DTLS connection is available
  *
+ * @remark Only the connections with a DTLS context are indexed by peer address: @c NULL is
+ * returned for a connection created without DTLS context (NoSec mode).
+ *
  * @return
  *  - @c dtls_Connection_t pointer if the DTLS connection is available
  *  - @c NULL if the DTLS connection is not available in the indicated socket
@@ -117,7 +173,7 @@ typedef lwm2mcore_Sid_t (*cmdEndHandlerCb)
 //--------------------------------------------------------------------------------------------------
 dtls_Connection_t* dtls_FindConnection
 (
-    dtls_Connection_t* connListPtr,         ///< [IN] DTLS connection list
+    dtls_Instance_t* instancePtr,           ///< [IN] DTLS state of the client instance
     const struct sockaddr_storage* addrPtr, ///< [IN] Socket address structure
     size_t addrLen                          ///< [IN] Socket address structure length
 );
@@ -150,6 +206,7 @@ dtls_Connection_t* dtls_HandleNewIncoming
 //--------------------------------------------------------------------------------------------------
 dtls_Connection_t* dtls_CreateConnection
 (
+    dtls_Instance_t* instancePtr,       ///< [IN] DTLS state of the client instance
     dtls_Connection_t* connListPtr,     ///< [IN] DTLS connection structure
     int sock,                           ///< [IN] Socket Id
     lwm2m_object_t* securityObjPtr,     ///< [IN] Security object pointer
@@ -158,6 +215,26 @@ dtls_Connection_t* dtls_CreateConnection
     int addressFamily                   ///< [IN] Address familly
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Initialize the DTLS state of a client instance
+ */
+//--------------------------------------------------------------------------------------------------
+void dtls_InitInstance
+(
+    dtls_Instance_t* instancePtr        ///< [IN] DTLS state of the client instance
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Release the DTLS state of a client instance: tinyDTLS context and retained connections
+ */
+//--------------------------------------------------------------------------------------------------
+void dtls_FreeInstance
+(
+    dtls_Instance_t* instancePtr        ///< [IN] DTLS state of the client instance
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * @brief Function to free the DTLS connection list
@@ -165,6 +242,7 @@ dtls_Connection_t* dtls_CreateConnection
 //--------------------------------------------------------------------------------------------------
 void dtls_FreeConnection
 (
+    dtls_Instance_t* instancePtr,       ///< [IN] DTLS state of the client instance
     dtls_Connection_t* connListPtr      ///< [IN] DTLS connection structure
 );
 
@@ -175,6 +253,7 @@ void dtls_FreeConnection
 //--------------------------------------------------------------------------------------------------
 void dtls_UpdateDtlsList
 (
+    dtls_Instance_t* instancePtr,       ///< [IN] DTLS state of the client instance
     dtls_Connection_t* connListPtr      ///< [IN] DTLS connection structure
 );
 
@@ -250,7 +329,7 @@ int dtls_ResumeSession
 void dtls_HandshakeRetransmission
 (
     dtls_Connection_t*  connListPtr,        ///< [IN] DTLS connection list
-    dtls_tick_t*        timerValue,         ///< [INOUT] Timer value for retransmission
+    dtls_tick_t*        timerValue,         ///< [INOUT] Timer value for retransmission in ms
     bool*               isMaxReached        ///< [INOUT] Is maximum retransmission reached ?
 );
 
@@ -284,13 +363,55 @@ void dtls_ForceDtlsHandshake
  * If one of these times is greater than the NAT timeout, a DTLS resume is initiated.
  * Default value if this function is not called: 40 seconds.
  * Value 0 will deactivate any DTLS resume.
+ * If instancePtr is NULL, the timeout is the default one of the instances initialized later.
  */
 //--------------------------------------------------------------------------------------------------
 void dtls_SetNatTimeout
 (
+    dtls_Instance_t* instancePtr,  ///< [IN] DTLS state of the client instance
     uint32_t        timeout        ///< [IN] Timeout (unit: seconds)
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Enable or disable the learning of the DTLS NAT timeout
+ *
+ * The NAT timeout set by dtls_SetNatTimeout() is the initial value of the learning.
+ * If instancePtr is NULL, the setting is the default one of the instances initialized later.
+ */
+//--------------------------------------------------------------------------------------------------
+void dtls_SetAdaptiveNatTimeout
+(
+    dtls_Instance_t* instancePtr,  ///< [IN] DTLS state of the client instance
+    bool            isAdaptive     ///< [IN] Learn the NAT timeout
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Get the DTLS NAT timeout in use, learned or configured
+ *
+ * @return
+ *  - NAT timeout in seconds
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t dtls_GetNatTimeout
+(
+    const dtls_Instance_t* instancePtr  ///< [IN] DTLS state of the client instance
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Apply the retransmission timeouts estimated on the connections to the pending CoAP
+ * transactions
+ */
+//--------------------------------------------------------------------------------------------------
+void dtls_AdaptRetransmissions
+(
+    lwm2m_transaction_t* transactionListPtr,///< [IN] Transaction list
+    uint32_t* timerValueMsPtr               ///< [INOUT] Delay before the next step in ms, lowered
+                                            ///< to the next retransmission
+);
+
 /**
   * @}
   */
@@ -20,6 +20,7 @@
 #include "internals.h"
 #include "objects.h"
 #include "dtlsConnection.h"
+#include "udpBatch.h"
 #include "sessionManager.h"
 #include "handlers.h"
 #include "aclConfiguration.h"
@@ -28,31 +29,35 @@
 #include <updateAgent.h>
 #include <lwm2mcore/lwm2mcorePackageDownloader.h>
 
+#define LOG_MODULE_LEVEL LWM2MCORE_LOG_SESSION
+#include "coreLog.h"
 
 //--------------------------------------------------------------------------------------------------
 /**
- *  Context
+ *  Object manager context of the selected client instance
  */
 //--------------------------------------------------------------------------------------------------
 lwm2mcore_context_t* Lwm2mcoreCtxPtr = NULL;
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Socket configuration variable
+ *  Selected client instance (see smanager_SelectInstance): all the session state is stored in
+ *  the client instance, this is only the instance on which the functions without instance
+ *  reference apply.
  */
 //--------------------------------------------------------------------------------------------------
-static  lwm2mcore_SocketConfig_t SocketConfig;
+static smanager_ClientData_t* DataCtxPtr;
 
 //--------------------------------------------------------------------------------------------------
 /**
- *  Context
+ *  Number of client instances
  */
 //--------------------------------------------------------------------------------------------------
-static smanager_ClientData_t* DataCtxPtr;
+static uint32_t InstanceCount = 0;
 
 //--------------------------------------------------------------------------------------------------
 /**
- *  Callback for events
+ *  Callback for events which are not linked to a client instance
  */
 //--------------------------------------------------------------------------------------------------
 static lwm2mcore_StatusCb_t StatusCb = NULL;
@@ -66,17 +71,18 @@ static lwm2mcore_PushAckCallback_t PushCb = NULL;
 
 //--------------------------------------------------------------------------------------------------
 /**
- *  Static boolean for bootstrap notification
+ *  Inactivity timeout after which a notification will be sent.
  */
 //--------------------------------------------------------------------------------------------------
-static bool BootstrapSession = false;
+#define INACTIVE_TIMEOUT_SECONDS    20
 
 //--------------------------------------------------------------------------------------------------
 /**
- *  Inactivity timeout after which a notification will be sent.
+ *  Class of the CoAP success response codes (2.xx), in the 3 most significant bits of the code
  */
 //--------------------------------------------------------------------------------------------------
-#define INACTIVE_TIMEOUT_SECONDS    20
+#define COAP_CLASS_MASK             0xE0
+#define COAP_CLASS_SUCCESS          0x40
 
 #if SIERRA
 //--------------------------------------------------------------------------------------------------
@@ -87,15 +93,6 @@ static bool BootstrapSession = false;
 #define INACTIVE_TIMEOUT_SECONDS_ALT 8
 #endif // SIERRA
 
-//--------------------------------------------------------------------------------------------------
-/**
- *  Client state bootstrapping / registered etc.,
- */
-//--------------------------------------------------------------------------------------------------
-#ifdef LWM2M_BOOTSTRAP
-static lwm2m_client_state_t PreviousState;
-#endif
-
 //--------------------------------------------------------------------------------------------------
 /**
  *                      PRIVATE FUNCTIONS
@@ -121,6 +118,351 @@ static lwm2mcore_context_t* InitContext
     return dataPtr->lwm2mcoreCtxPtr;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the client instance of an API call: the instance reference, or the selected instance if
+ * the reference is NULL
+ *
+ * @return
+ *  - client instance
+ *  - NULL if no instance is available
+ */
+//--------------------------------------------------------------------------------------------------
+static smanager_ClientData_t* GetInstance
+(
+    lwm2mcore_Ref_t instanceRef     ///< [IN] instance reference
+)
+{
+    if (NULL != instanceRef)
+    {
+        smanager_SelectInstance(instanceRef);
+    }
+    return DataCtxPtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Launch the step timer of a client instance
+ */
+//--------------------------------------------------------------------------------------------------
+static void StartStepTimer
+(
+    smanager_ClientData_t* dataPtr, ///< [IN] Client instance
+    uint32_t delayMs                ///< [IN] Delay before the step in ms
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Launch the inactivity timer of a client instance
+ */
+//--------------------------------------------------------------------------------------------------
+static void StartInactivityTimer
+(
+    smanager_ClientData_t* dataPtr  ///< [IN] Client instance
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert a push content type to the Wakaama media type
+ *
+ * @return
+ *  - true on success
+ *  - false if the content type is not supported
+ */
+//--------------------------------------------------------------------------------------------------
+static bool GetPushMediaType
+(
+    lwm2mcore_PushContent_t content,        ///< [IN] Content type
+    lwm2m_media_type_t* mediaTypePtr        ///< [OUT] Media type
+)
+{
+    switch (content)
+    {
+        case LWM2MCORE_PUSH_CONTENT_CBOR:
+            *mediaTypePtr = LWM2M_CONTENT_CBOR;
+            return true;
+        case LWM2MCORE_PUSH_CONTENT_ZCBOR:
+            *mediaTypePtr = LWM2M_CONTENT_ZCBOR;
+            return true;
+        default:
+            return false;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Report the result of pushes to the push callback
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReportPushes
+(
+    lwm2mcore_AckResult_t ack,    ///< [IN] Acknowledge result
+    uint16_t mid,                 ///< [IN] Message Identifier
+    uint32_t pushCount            ///< [IN] Number of pushes
+)
+{
+    while ((PushCb) && (pushCount--))
+    {
+        PushCb(ack, mid);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copy a push in the push queue of a client instance
+ *
+ * @return
+ *  - LWM2MCORE_PUSH_QUEUED if the push is queued
+ *  - LWM2MCORE_PUSH_BUSY if the queue is disabled or the push does not fit in the queue budget
+ *  - LWM2MCORE_PUSH_FAILED on memory allocation failure
+ */
+//--------------------------------------------------------------------------------------------------
+static lwm2mcore_PushResult_t QueuePush
+(
+    smanager_ClientData_t* dataPtr,         ///< [IN] Client instance
+    const uint8_t* payloadPtr,              ///< [IN] payload
+    size_t payloadLength,                   ///< [IN] payload length
+    lwm2mcore_PushContent_t content,        ///< [IN] content type
+    uint16_t* midPtr                        ///< [OUT] message id
+)
+{
+    lwm2mcore_PushResult_t result;
+    uint32_t droppedCount = 0;
+
+    if (!pushQueue_IsEnabled(&(dataPtr->pushQueue)))
+    {
+        return LWM2MCORE_PUSH_BUSY;
+    }
+
+    result = pushQueue_Add(&(dataPtr->pushQueue), payloadPtr, payloadLength, content,
+                           &droppedCount);
+    ReportPushes(LWM2MCORE_ACK_DROPPED, 0, droppedCount);
+
+    if ((LWM2MCORE_PUSH_QUEUED == result) && (NULL != midPtr))
+    {
+        *midPtr = 0;
+    }
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send the next queued push of a client instance, if no push is in flight
+ *
+ * @return
+ *  - true if a push is sent
+ *  - false else
+ */
+//--------------------------------------------------------------------------------------------------
+static bool SendQueuedPush
+(
+    smanager_ClientData_t* dataPtr          ///< [IN] Client instance
+)
+{
+    pushQueue_Entry_t* entryPtr;
+    lwm2m_server_t* targetPtr;
+    bool registered = false;
+
+    if ((NULL == dataPtr->pushQueue.headPtr) || (NULL != dataPtr->pushQueue.inFlightPtr))
+    {
+        return false;
+    }
+
+    /* The queued pushes are kept until the device is registered to DM server */
+    if (   (!lwm2mcore_ConnectionGetType((lwm2mcore_Ref_t)dataPtr, &registered))
+        || (!registered)
+        || (NULL == dataPtr->lwm2mHPtr->serverList))
+    {
+        return false;
+    }
+    targetPtr = dataPtr->lwm2mHPtr->serverList;
+
+    while (NULL != (entryPtr = pushQueue_GetNext(&(dataPtr->pushQueue))))
+    {
+        lwm2m_media_type_t contentType;
+        uint16_t mid = 0;
+        int rc = COAP_500_INTERNAL_SERVER_ERROR;
+
+        if (GetPushMediaType(entryPtr->content, &contentType))
+        {
+            rc = lwm2m_data_push(dataPtr->lwm2mHPtr,
+                                 targetPtr->shortID,
+                                 entryPtr->payload,
+                                 entryPtr->len,
+                                 contentType,
+                                 &mid);
+        }
+
+        if (COAP_NO_ERROR == rc)
+        {
+            /* The payload is kept until the push is acknowledged */
+            pushQueue_SetInFlight(&(dataPtr->pushQueue), mid);
+            return true;
+        }
+
+        if (COAP_412_PRECONDITION_FAILED == rc)
+        {
+            /* Another transfer is in progress: retry on the next step */
+            return false;
+        }
+
+        LOG_ERR("Queued push failed: 0x%X", rc);
+        ReportPushes(LWM2MCORE_ACK_FAILURE, 0, pushQueue_DropHead(&(dataPtr->pushQueue)));
+    }
+
+    return false;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Callback function called when a block of a streamed push is acknowledged or timed out
+ */
+//--------------------------------------------------------------------------------------------------
+static void PushBlockCallback
+(
+    lwm2m_transaction_t* transacPtr,        ///< [IN] Transaction of the block
+    void* messagePtr                        ///< [IN] Response, NULL on timeout
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send the next block of the streamed push of a client instance
+ *
+ * @return
+ *  - true if the block is sent
+ *  - false else
+ */
+//--------------------------------------------------------------------------------------------------
+static bool SendPushBlock
+(
+    smanager_ClientData_t* dataPtr          ///< [IN] Client instance
+)
+{
+    pushStream_Stream_t* streamPtr = &(dataPtr->pushStream);
+    lwm2m_server_t* targetPtr = dataPtr->lwm2mHPtr->serverList;
+    lwm2m_transaction_t* transacPtr;
+    lwm2m_media_type_t contentType;
+    dtls_Connection_t* connPtr;
+    size_t len;
+
+    streamPtr->isBlockPending = false;
+
+    if (   (NULL == targetPtr)
+        || (!GetPushMediaType(streamPtr->content, &contentType)))
+    {
+        return false;
+    }
+
+    /* Follow the block size selected on the connection */
+    connPtr = (dtls_Connection_t*)targetPtr->sessionH;
+    if (NULL != connPtr)
+    {
+        pushStream_SetBlockSize(streamPtr, connPtr->blockSize.size);
+    }
+
+    if (!pushStream_ReadBlock(streamPtr, &len))
+    {
+        return false;
+    }
+
+    transacPtr = transaction_new(targetPtr->sessionH, COAP_POST, NULL, NULL,
+                                 dataPtr->lwm2mHPtr->nextMID++, 4, NULL);
+    if (NULL == transacPtr)
+    {
+        LOG_ERR("Unable to allocate the push block transaction");
+        return false;
+    }
+
+    coap_set_header_uri_path(transacPtr->message, LWM2MCORE_PUSH_STREAM_URI);
+    coap_set_header_content_type(transacPtr->message, contentType);
+    /* A payload which fits in one block is sent without Block1 option */
+    if ((streamPtr->isMore) || (0 != streamPtr->blockNum))
+    {
+        coap_set_header_block1(transacPtr->message,
+                               streamPtr->blockNum,
+                               streamPtr->isMore ? 1 : 0,
+                               streamPtr->blockSize);
+    }
+    coap_set_payload(transacPtr->message, streamPtr->blockPtr, len);
+
+    transacPtr->callback = PushBlockCallback;
+    transacPtr->userData = (void*)dataPtr;
+
+    if (0 == streamPtr->blockNum)
+    {
+        streamPtr->mid = transacPtr->mID;
+    }
+
+    LOG_DBG("Push block %u, %zu bytes, more %d", streamPtr->blockNum, len, streamPtr->isMore);
+
+    /* The transaction is released by Wakaama once acknowledged or timed out */
+    dataPtr->lwm2mHPtr->transactionList = (lwm2m_transaction_t*)
+                            LWM2M_LIST_ADD(dataPtr->lwm2mHPtr->transactionList, transacPtr);
+    transaction_send(dataPtr->lwm2mHPtr, transacPtr);
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * End the streamed push of a client instance and report its result to the push callback
+ */
+//--------------------------------------------------------------------------------------------------
+static void EndPushStream
+(
+    smanager_ClientData_t* dataPtr,         ///< [IN] Client instance
+    lwm2mcore_AckResult_t ack               ///< [IN] Acknowledge result
+)
+{
+    uint16_t mid = dataPtr->pushStream.mid;
+
+    LOG_ARG("Streamed push %d ended: %d", mid, ack);
+    pushStream_Stop(&(dataPtr->pushStream));
+    ReportPushes(ack, mid, 1);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Callback function called when a block of a streamed push is acknowledged or timed out
+ */
+//--------------------------------------------------------------------------------------------------
+static void PushBlockCallback
+(
+    lwm2m_transaction_t* transacPtr,        ///< [IN] Transaction of the block
+    void* messagePtr                        ///< [IN] Response, NULL on timeout
+)
+{
+    smanager_ClientData_t* dataPtr = (smanager_ClientData_t*)transacPtr->userData;
+    coap_packet_t* packetPtr = (coap_packet_t*)messagePtr;
+
+    if ((NULL == dataPtr) || (!dataPtr->pushStream.isActive))
+    {
+        return;
+    }
+    smanager_SelectInstance((lwm2mcore_Ref_t)dataPtr);
+
+    /* The blocks feed the block size selection of the connection when they are sent and
+     * acknowledged, as the blocks of the other block-wise transfers */
+    if (NULL == packetPtr)
+    {
+        EndPushStream(dataPtr, LWM2MCORE_ACK_TIMEOUT);
+    }
+    else if (COAP_CLASS_SUCCESS != (packetPtr->code & COAP_CLASS_MASK))
+    {
+        LOG_ARG("Push block %u rejected: 0x%X", dataPtr->pushStream.blockNum, packetPtr->code);
+        EndPushStream(dataPtr, LWM2MCORE_ACK_FAILURE);
+    }
+    else if (dataPtr->pushStream.isMore)
+    {
+        /* The next block is sent by the step, out of the Wakaama transaction handling */
+        dataPtr->pushStream.isBlockPending = true;
+        StartStepTimer(dataPtr, 0);
+    }
+    else
+    {
+        EndPushStream(dataPtr, LWM2MCORE_ACK_RECEIVED);
+    }
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Callback function called when CoAP data push is acknowledged or timed out
@@ -133,6 +475,8 @@ static void PushCallbackHandler
 )
 {
     lwm2mcore_AckResult_t ack;
+    uint16_t pushCount = 0;
+
     switch (result)
     {
         case LWM2M_ACK_RECEIVED:
@@ -146,9 +490,18 @@ static void PushCallbackHandler
             return;
     }
 
-    if (PushCb)
+    if (NULL != DataCtxPtr)
     {
-        PushCb(ack, mid);
+        pushCount = pushQueue_Acknowledge(&(DataCtxPtr->pushQueue), mid);
+    }
+
+    /* A push which was not queued is reported once */
+    ReportPushes(ack, mid, pushCount ? pushCount : 1);
+
+    /* The next queued push is sent by the step, out of the Wakaama transaction handling */
+    if ((NULL != DataCtxPtr) && (pushQueue_IsBusy(&(DataCtxPtr->pushQueue))))
+    {
+        StartStepTimer(DataCtxPtr, 0);
     }
 }
 
@@ -173,33 +526,27 @@ static bool CloseConnection
     }
 
     /* Stop the current timers */
-    if (!lwm2mcore_TimerStop(LWM2MCORE_TIMER_STEP))
-    {
-        LOG("Failed to stop the step timer");
-    }
-
-    if (!lwm2mcore_TimerStop(LWM2MCORE_TIMER_INACTIVITY))
-    {
-        LOG("Failed to stop the inactivity timer");
-    }
+    timerWheel_Stop(&(dataPtr->stepTimer));
+    timerWheel_Stop(&(dataPtr->inactivityTimer));
 
     if (!lwm2mcore_TimerStop(LWM2MCORE_TIMER_DOWNLOAD))
     {
         LOG("Failed to stop the download timer");
     }
 
-    dtls_FreeConnection(dataPtr->connListPtr);
+    dtls_FreeConnection(&(dataPtr->dtls), dataPtr->connListPtr);
     dataPtr->connListPtr = NULL;
 
-    /* Close the socket */
-    if (!lwm2mcore_UdpClose(SocketConfig))
+    /* Send the queued datagrams and close the socket */
+    udpBatch_Flush();
+    if (!lwm2mcore_UdpClose(dataPtr->socketConfig))
     {
         LOG("Failed to close UDP connection");
         lwm2mcore_ReportUdpErrorCode(LWM2MCORE_UDP_CLOSE_ERR);
     }
 
     /* Zero-init the socket structure */
-    memset(&SocketConfig, 0, sizeof(lwm2mcore_SocketConfig_t));
+    memset(&(dataPtr->socketConfig), 0, sizeof(lwm2mcore_SocketConfig_t));
 
     return true;
 }
@@ -229,13 +576,16 @@ void* lwm2m_connect_server
     {
         lwm2m_object_t* securityObjPtr = dataPtr->securityObjPtr;
 
+        smanager_SelectInstance((lwm2mcore_Ref_t)dataPtr);
+
         instancePtr = LWM2M_LIST_FIND(dataPtr->securityObjPtr->instanceList, secObjInstID);
         if (!instancePtr)
         {
             return NULL;
         }
 
-        newConnPtr = dtls_CreateConnection(dataPtr->connListPtr,
+        newConnPtr = dtls_CreateConnection(&(dataPtr->dtls),
+                                           dataPtr->connListPtr,
                                            dataPtr->sock,
                                            securityObjPtr,
                                            instancePtr->id,
@@ -295,7 +645,7 @@ void lwm2m_close_connection
                 dtls_CloseAndFreePeer(targetPtr);
             }
         }
-        dtls_UpdateDtlsList(appDataPtr->connListPtr);
+        dtls_UpdateDtlsList(&(appDataPtr->dtls), appDataPtr->connListPtr);
     }
 }
 
@@ -407,21 +757,314 @@ static int GetInactiveTimeout
 //--------------------------------------------------------------------------------------------------
 static void Lwm2mClientInactivityHandler
 (
-    void
+    void* contextPtr                ///< [IN] Client instance
 )
 {
+    smanager_ClientData_t* dataPtr = (smanager_ClientData_t*)contextPtr;
+
+    smanager_SelectInstance((lwm2mcore_Ref_t)dataPtr);
+
     LOG_ARG("client inactive for %d seconds", GetInactiveTimeout());
 
-    /* Restart the timer for monitoring next period */
-    if (false == lwm2mcore_TimerSet(LWM2MCORE_TIMER_INACTIVITY,
-                                    GetInactiveTimeout(),
-                                    Lwm2mClientInactivityHandler))
-    {
-        LOG("Error re-launching inactivity timer");
+    /* Restart the timer for monitoring next period */
+    StartInactivityTimer(dataPtr);
+
+    /* Notify that the session is inactive */
+    smanager_SendSessionEvent(EVENT_TYPE_REGISTRATION, EVENT_STATUS_INACTIVE, NULL);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Notify the observers of a resource change which was deferred by its minimum period
+ */
+//--------------------------------------------------------------------------------------------------
+static void NotifyDeferredChange
+(
+    uint16_t oid,       ///< [IN] Object Id
+    uint16_t oiid,      ///< [IN] Object instance Id
+    uint16_t rid        ///< [IN] Resource Id
+)
+{
+    lwm2m_uri_t uri;
+
+    if ((NULL == DataCtxPtr) || (NULL == DataCtxPtr->lwm2mHPtr))
+    {
+        return;
+    }
+
+    memset(&uri, 0, sizeof(uri));
+    uri.flag = LWM2M_URI_FLAG_OBJECT_ID | LWM2M_URI_FLAG_INSTANCE_ID | LWM2M_URI_FLAG_RESOURCE_ID;
+    uri.objectId = oid;
+    uri.instanceId = oiid;
+    uri.resourceId = rid;
+
+    LOG_ARG("Deferred notification /%d/%d/%d", oid, oiid, rid);
+    lwm2m_resource_value_changed(DataCtxPtr->lwm2mHPtr, &uri);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Flag the batched resource changes to Wakaama, which notifies them on its next step
+ */
+//--------------------------------------------------------------------------------------------------
+static void FlushNotifications
+(
+    smanager_ClientData_t* dataPtr  ///< [IN] Client data
+)
+{
+    uint16_t i;
+
+    for (i = 0; i < dataPtr->notifyBatchCount; i++)
+    {
+        lwm2m_resource_value_changed(dataPtr->lwm2mHPtr, &(dataPtr->notifyBatch[i]));
+    }
+    dataPtr->notifyBatchCount = 0;
+    dataPtr->isNotifyFlushScheduled = false;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Add a resource change to the notification batch. A change already present in the batch is
+ *  not added twice.
+ *
+ * @return
+ *  - @c true if the batch is full
+ *  - @c false otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+static bool BatchNotification
+(
+    smanager_ClientData_t* dataPtr, ///< [IN] Client data
+    uint16_t oid,                   ///< [IN] Object Id
+    uint16_t oiid,                  ///< [IN] Object instance Id
+    uint16_t rid                    ///< [IN] Resource Id
+)
+{
+    lwm2m_uri_t* uriPtr;
+    uint16_t i;
+
+    for (i = 0; i < dataPtr->notifyBatchCount; i++)
+    {
+        uriPtr = &(dataPtr->notifyBatch[i]);
+        if ((oid == uriPtr->objectId) && (oiid == uriPtr->instanceId) && (rid == uriPtr->resourceId))
+        {
+            return false;
+        }
+    }
+
+    uriPtr = &(dataPtr->notifyBatch[dataPtr->notifyBatchCount]);
+    memset(uriPtr, 0, sizeof(lwm2m_uri_t));
+    uriPtr->flag = LWM2M_URI_FLAG_OBJECT_ID | LWM2M_URI_FLAG_INSTANCE_ID
+                   | LWM2M_URI_FLAG_RESOURCE_ID;
+    uriPtr->objectId = oid;
+    uriPtr->instanceId = oiid;
+    uriPtr->resourceId = rid;
+    dataPtr->notifyBatchCount++;
+
+    return (SMANAGER_NOTIFY_BATCH_MAX <= dataPtr->notifyBatchCount);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Get the level of an observation covering a resource.
+ *
+ * @return
+ *  - Observed level
+ *  - -1 if the observation does not cover the resource
+ */
+//--------------------------------------------------------------------------------------------------
+static int GetObservedLevel
+(
+    const lwm2m_observed_t* observedPtr,    ///< [IN] Observation
+    uint16_t oid,                           ///< [IN] Object Id
+    uint16_t oiid,                          ///< [IN] Object instance Id
+    uint16_t rid                            ///< [IN] Resource Id
+)
+{
+    int level = OMANAGER_OBSERVE_OBJECT;
+
+    if (oid != observedPtr->uri.objectId)
+    {
+        return -1;
+    }
+
+    if (observedPtr->uri.flag & LWM2M_URI_FLAG_INSTANCE_ID)
+    {
+        if (oiid != observedPtr->uri.instanceId)
+        {
+            return -1;
+        }
+        level++;
+    }
+    if (observedPtr->uri.flag & LWM2M_URI_FLAG_RESOURCE_ID)
+    {
+        if (rid != observedPtr->uri.resourceId)
+        {
+            return -1;
+        }
+        level++;
+    }
+
+    return level;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Get the observe attributes which apply to an observation of a resource by a server.
+ *
+ *  Attributes set by the server on the object or object instance are inherited, attributes set on
+ *  a more specific level override them. The attributes of the other servers, and of the levels
+ *  more specific than the observed one, do not apply.
+ */
+//--------------------------------------------------------------------------------------------------
+static void GetObserveAttributes
+(
+    lwm2m_context_t* contextPtr,    ///< [IN] Wakaama context
+    lwm2m_server_t* serverPtr,      ///< [IN] Observing server
+    int observedLevel,              ///< [IN] Observed level
+    uint16_t oid,                   ///< [IN] Object Id
+    uint16_t oiid,                  ///< [IN] Object instance Id
+    uint16_t rid,                   ///< [IN] Resource Id
+    lwm2m_attribute_t* attrPtr      ///< [OUT] Observe attributes
+)
+{
+    lwm2m_observed_t* observedPtr;
+    lwm2m_watcher_t* watcherPtr;
+    lwm2m_attributes_t* paramPtr;
+    int level;
+    int levelMin = -1;
+    int levelMax = -1;
+    int levelGt = -1;
+    int levelLt = -1;
+    int levelSt = -1;
+
+    memset(attrPtr, 0, sizeof(lwm2m_attribute_t));
+
+    for (observedPtr = contextPtr->observedList; observedPtr; observedPtr = observedPtr->next)
+    {
+        level = GetObservedLevel(observedPtr, oid, oiid, rid);
+        if ((0 > level) || (level > observedLevel))
+        {
+            continue;
+        }
+
+        for (watcherPtr = observedPtr->watcherList; watcherPtr; watcherPtr = watcherPtr->next)
+        {
+            paramPtr = watcherPtr->parameters;
+            if ((!watcherPtr->active) || (serverPtr != watcherPtr->server) || (NULL == paramPtr))
+            {
+                continue;
+            }
+
+            if ((paramPtr->toSet & LWM2M_ATTR_FLAG_MIN_PERIOD) && (level >= levelMin))
+            {
+                levelMin = level;
+                attrPtr->pmin = paramPtr->minPeriod;
+                attrPtr->mask |= LWM2M_ATTR_FLAG_MIN_PERIOD;
+            }
+            if ((paramPtr->toSet & LWM2M_ATTR_FLAG_MAX_PERIOD) && (level >= levelMax))
+            {
+                levelMax = level;
+                attrPtr->pmax = paramPtr->maxPeriod;
+                attrPtr->mask |= LWM2M_ATTR_FLAG_MAX_PERIOD;
+            }
+            if ((paramPtr->toSet & LWM2M_ATTR_FLAG_GREATER_THAN) && (level >= levelGt))
+            {
+                levelGt = level;
+                attrPtr->gt = paramPtr->greaterThan;
+                attrPtr->mask |= LWM2M_ATTR_FLAG_GREATER_THAN;
+            }
+            if ((paramPtr->toSet & LWM2M_ATTR_FLAG_LESS_THAN) && (level >= levelLt))
+            {
+                levelLt = level;
+                attrPtr->lt = paramPtr->lessThan;
+                attrPtr->mask |= LWM2M_ATTR_FLAG_LESS_THAN;
+            }
+            if ((paramPtr->toSet & LWM2M_ATTR_FLAG_STEP) && (level >= levelSt))
+            {
+                levelSt = level;
+                attrPtr->st = paramPtr->step;
+                attrPtr->mask |= LWM2M_ATTR_FLAG_STEP;
+            }
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Evaluate a resource change against the observe attributes of each active observation.
+ *
+ *  Each observation is gated by the attributes of its own server, with its own notified value: the
+ *  change is notified as soon as one observation needs it. Wakaama then applies the attributes of
+ *  each watcher when the notifications are sent.
+ *
+ * @return
+ *  - OMANAGER_NOTIFY_SEND if one observation has to be notified now
+ *  - OMANAGER_NOTIFY_DEFER if one observation is deferred and none is notified now
+ *  - OMANAGER_NOTIFY_SUPPRESS if no observation needs the change
+ */
+//--------------------------------------------------------------------------------------------------
+static omanager_NotifyDecision_t CheckObservations
+(
+    lwm2m_context_t* contextPtr,    ///< [IN] Wakaama context
+    uint16_t oid,                   ///< [IN] Object Id
+    uint16_t oiid,                  ///< [IN] Object instance Id
+    uint16_t rid,                   ///< [IN] Resource Id
+    bool* isObservedPtr             ///< [OUT] Set if the resource is observed
+)
+{
+    lwm2m_observed_t* observedPtr;
+    lwm2m_watcher_t* watcherPtr;
+    lwm2m_attribute_t attr;
+    omanager_NotifyDecision_t decision = OMANAGER_NOTIFY_SUPPRESS;
+    int level;
+
+    *isObservedPtr = false;
+
+    for (observedPtr = contextPtr->observedList; observedPtr; observedPtr = observedPtr->next)
+    {
+        level = GetObservedLevel(observedPtr, oid, oiid, rid);
+        if (0 > level)
+        {
+            continue;
+        }
+
+        for (watcherPtr = observedPtr->watcherList; watcherPtr; watcherPtr = watcherPtr->next)
+        {
+            if (!watcherPtr->active)
+            {
+                continue;
+            }
+            *isObservedPtr = true;
+
+            /* Every observation is evaluated so that its notified value stays up to date */
+            GetObserveAttributes(contextPtr, watcherPtr->server, level, oid, oiid, rid, &attr);
+            switch (omanager_CheckNotification(oid,
+                                               oiid,
+                                               rid,
+                                               watcherPtr->server ? watcherPtr->server->shortID : 0,
+                                               (omanager_ObserveLevel_t)level,
+                                               &attr))
+            {
+                case OMANAGER_NOTIFY_SEND:
+                    decision = OMANAGER_NOTIFY_SEND;
+                    break;
+
+                case OMANAGER_NOTIFY_DEFER:
+                    if (OMANAGER_NOTIFY_SEND != decision)
+                    {
+                        decision = OMANAGER_NOTIFY_DEFER;
+                    }
+                    break;
+
+                case OMANAGER_NOTIFY_SUPPRESS:
+                default:
+                    break;
+            }
+        }
     }
 
-    /* Notify that the session is inactive */
-    smanager_SendSessionEvent(EVENT_TYPE_REGISTRATION, EVENT_STATUS_INACTIVE, NULL);
+    return decision;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -429,19 +1072,22 @@ static void Lwm2mClientInactivityHandler
  *  LwM2M client step that handles data transmit.
  */
 //--------------------------------------------------------------------------------------------------
-static void Lwm2mClientStepHandler
+static void ClientStep
 (
-    void
+    smanager_ClientData_t* dataPtr  ///< [IN] Client instance
 )
 {
     int result = 0;
-    uint32_t timerValue = 0;
+    uint32_t timerValueMs = 0;
+    uint32_t deferredMs;
 
-    static struct timeval tv;
+    struct timeval tv;
     tv.tv_sec = 60;
     tv.tv_usec = 0;
 
-    LOG("Entering");
+    smanager_SelectInstance((lwm2mcore_Ref_t)dataPtr);
+
+    LOG_DBG("Entering");
 
     /* This function does two things:
      * - first it does the work needed by Wakaama (eg. (re)sending some packets).
@@ -450,25 +1096,28 @@ static void Lwm2mClientStepHandler
      *   (eg. retransmission) and the time between the next operation
      */
 
-    if (DataCtxPtr->connListPtr)
+    /* Batched resource changes are notified by this step */
+    FlushNotifications(dataPtr);
+
+    if (dataPtr->connListPtr)
     {
         bool isMaxRetransmissionReached = false;
 
         // Manage DTLS handshake retransmission
-        dtls_HandshakeRetransmission(DataCtxPtr->connListPtr,
-                                     &timerValue,
+        dtls_HandshakeRetransmission(dataPtr->connListPtr,
+                                     &timerValueMs,
                                      &isMaxRetransmissionReached);
 
-        if(timerValue)
+        if(timerValueMs)
         {
-            LOG_ARG("DTLS retransmission to be planned: %d sec", timerValue);
+            LOG_ARG("DTLS retransmission to be planned: %d ms", timerValueMs);
         }
         else if (isMaxRetransmissionReached)
         {
             LOG("All retransmission attempts failed");
             // All retransmission attempts failed
             // On tinyDTLS side, bufferized message are deleted
-            switch (DataCtxPtr->lwm2mHPtr->state)
+            switch (dataPtr->lwm2mHPtr->state)
             {
                 case STATE_REGISTERING:
                     // Notify the authentication failure to DM
@@ -476,29 +1125,29 @@ static void Lwm2mClientStepHandler
                                               EVENT_STATUS_DONE_FAIL,
                                               NULL);
 
-                    DataCtxPtr->lwm2mHPtr->state = STATE_INITIAL;
+                    dataPtr->lwm2mHPtr->state = STATE_INITIAL;
                     // While the device tries to register to the server, all DTLS retransmissions
                     // failed
                     // The common use case is that DM credentials were updated on server side
                     // (key-rotation) which requires a connection to the bootstrap server in order
                     // to retrieve new DM credentials
                     ForceInitialConnection(true,
-                                           DataCtxPtr->lwm2mHPtr->serverList,
-                                           DataCtxPtr->lwm2mHPtr->transactionList);
+                                           dataPtr->lwm2mHPtr->serverList,
+                                           dataPtr->lwm2mHPtr->transactionList);
                     break;
 
                 case STATE_READY:
                     // This means that a DTLS resume fails on REG UPDATE
                     // Do not notify the authentication failure in this case
                     // Try a full DTLS handshake
-                    DataCtxPtr->lwm2mHPtr->state = STATE_INITIAL;
+                    dataPtr->lwm2mHPtr->state = STATE_INITIAL;
                     LOG("Perform rehandshake");
 
                     // If dtls_Rehandshake function immediatly returns an error, 2 solutions:
                     // 1) connects to the bootstrap server
                     // 2) indicates the connection as failed.
                     // Option 1 is kept
-                    if (0 != dtls_Rehandshake(DataCtxPtr->connListPtr, false))
+                    if (0 != dtls_Rehandshake(dataPtr->connListPtr, false))
                     {
                         LOG("Unable to perform rehandshake");
                         // If dtls_Rehandshake function immediatly returns an error, 2 solutions:
@@ -506,8 +1155,8 @@ static void Lwm2mClientStepHandler
                         // 2) indicates the connection as failed.
                         // Option 1 is kept
                         ForceInitialConnection(true,
-                                               DataCtxPtr->lwm2mHPtr->serverList,
-                                               DataCtxPtr->lwm2mHPtr->transactionList);
+                                               dataPtr->lwm2mHPtr->serverList,
+                                               dataPtr->lwm2mHPtr->transactionList);
                     }
                     break;
 
@@ -522,36 +1171,125 @@ static void Lwm2mClientStepHandler
                 default:
                     // Close the connection
                     smanager_SendSessionEvent(EVENT_SESSION, EVENT_STATUS_DONE_FAIL, NULL);
-                    lwm2mcore_Disconnect((lwm2mcore_Ref_t)DataCtxPtr);
+                    lwm2mcore_Disconnect((lwm2mcore_Ref_t)dataPtr);
                     return;
             }
         }
     }
 
-    if (!timerValue)
+    if (!timerValueMs)
     {
-        result = lwm2m_step(DataCtxPtr->lwm2mHPtr, &(tv.tv_sec));
+        /* The notifications read the observed resources */
+        omanager_ReleaseRequestMemory();
+
+        /* Flag the deferred resource changes before Wakaama builds the notifications */
+        deferredMs = omanager_ProcessDeferredNotifications(NotifyDeferredChange);
+
+        result = lwm2m_step(dataPtr->lwm2mHPtr, &(tv.tv_sec));
         if (result != 0)
         {
             LOG_ARG("lwm2m_step() failed: 0x%X.", result);
 #ifdef LWM2M_BOOTSTRAP
-            if (STATE_BOOTSTRAPPING == PreviousState)
+            if (STATE_BOOTSTRAPPING == dataPtr->previousState)
             {
 #ifdef WITH_LOGS
                 LOG("[BOOTSTRAP] restore security and server objects.");
 #endif
-                DataCtxPtr->lwm2mHPtr->state = STATE_INITIAL;
+                dataPtr->lwm2mHPtr->state = STATE_INITIAL;
             }
 #endif
         }
-        timerValue = tv.tv_sec;
+        /* Keep a 1 second minimum when Wakaama has nothing scheduled sooner */
+        timerValueMs = tv.tv_sec ? (uint32_t)tv.tv_sec * 1000 : 1000;
+
+        /* Retransmit the pending messages on the timeouts estimated on their connection */
+        dtls_AdaptRetransmissions(dataPtr->lwm2mHPtr->transactionList, &timerValueMs);
+
+        /* Wake up for the next deferred notification */
+        if (deferredMs < timerValueMs)
+        {
+            timerValueMs = deferredMs;
+        }
+
+        /* Send the next queued push or streamed push block: the next step schedules its
+         * retransmission */
+        if (SendQueuedPush(dataPtr))
+        {
+            timerValueMs = 0;
+        }
+        if (dataPtr->pushStream.isBlockPending)
+        {
+            if (SendPushBlock(dataPtr))
+            {
+                timerValueMs = 0;
+            }
+            else
+            {
+                EndPushStream(dataPtr, LWM2MCORE_ACK_FAILURE);
+            }
+        }
     }
 
     /* Launch timer step */
-    if (false == lwm2mcore_TimerSet(LWM2MCORE_TIMER_STEP, timerValue, Lwm2mClientStepHandler))
-    {
-        LOG("ERROR to launch the step timer");
-    }
+    StartStepTimer(dataPtr, timerValueMs);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Step timer expiry: the datagrams sent by the step are sent together
+ */
+//--------------------------------------------------------------------------------------------------
+static void Lwm2mClientStepHandler
+(
+    void* contextPtr                ///< [IN] Client instance
+)
+{
+    udpBatch_Begin();
+    ClientStep((smanager_ClientData_t*)contextPtr);
+    udpBatch_End();
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Launch the step timer of a client instance
+ */
+//--------------------------------------------------------------------------------------------------
+static void StartStepTimer
+(
+    smanager_ClientData_t* dataPtr, ///< [IN] Client instance
+    uint32_t delayMs                ///< [IN] Delay before the step in ms
+)
+{
+    timerWheel_Start(&(dataPtr->stepTimer), delayMs, Lwm2mClientStepHandler, dataPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Launch the inactivity timer of a client instance
+ */
+//--------------------------------------------------------------------------------------------------
+static void StartInactivityTimer
+(
+    smanager_ClientData_t* dataPtr  ///< [IN] Client instance
+)
+{
+    timerWheel_Start(&(dataPtr->inactivityTimer),
+                     (uint32_t)GetInactiveTimeout() * 1000,
+                     Lwm2mClientInactivityHandler,
+                     dataPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  End of the notification batching window: launch the step which flushes the batch
+ */
+//--------------------------------------------------------------------------------------------------
+static void NotifyWindowHandler
+(
+    void* contextPtr                ///< [IN] Client data
+)
+{
+    StartStepTimer((smanager_ClientData_t*)contextPtr, 0);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -651,11 +1389,130 @@ static void ManageRegistration
 #endif
 
     /* Launch inactivity timer to monitor inactivity during registered state */
-    if (false == lwm2mcore_TimerSet(LWM2MCORE_TIMER_INACTIVITY,
-                                    GetInactiveTimeout(),
-                                    Lwm2mClientInactivityHandler))
+    if (NULL != DataCtxPtr)
+    {
+        StartInactivityTimer(DataCtxPtr);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set or clear the bootstrap session flag of the selected client instance
+ */
+//--------------------------------------------------------------------------------------------------
+static void SetBootstrapSession
+(
+    bool isBootstrapSession         ///< [IN] Bootstrap session flag
+)
+{
+    if (NULL != DataCtxPtr)
+    {
+        DataCtxPtr->isBootstrapSession = isBootstrapSession;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the measured operation matching a session event
+ *
+ * @return
+ *  - Measured operation
+ *  - LWM2MCORE_METRIC_MAX if the event is not measured
+ */
+//--------------------------------------------------------------------------------------------------
+static lwm2mcore_Metric_t GetSessionEventMetric
+(
+    smanager_ClientData_t* dataPtr,         ///< [IN] Client instance
+    smanager_EventType_t eventId,           ///< [IN] Event Id
+    smanager_EventStatus_t eventStatus      ///< [IN] Event status
+)
+{
+    switch (eventId)
+    {
+        case EVENT_TYPE_REGISTRATION:
+            return LWM2MCORE_METRIC_REGISTRATION;
+
+        case EVENT_TYPE_REG_UPDATE:
+            return LWM2MCORE_METRIC_REG_UPDATE;
+
+        case EVENT_TYPE_RESUMING:
+            return LWM2MCORE_METRIC_DTLS_RESUME;
+
+        case EVENT_TYPE_AUTHENTICATION:
+            // tinyDTLS reports the end of an abbreviated handshake as the end of an authentication:
+            // the most recent of the resume and of the handshake is completed
+            if ((EVENT_STATUS_STARTED != eventStatus)
+             && (0 != dataPtr->metricStartMs[LWM2MCORE_METRIC_DTLS_RESUME])
+             && (dataPtr->metricStartMs[LWM2MCORE_METRIC_DTLS_RESUME]
+                 >= dataPtr->metricStartMs[LWM2MCORE_METRIC_DTLS_HANDSHAKE]))
+            {
+                return LWM2MCORE_METRIC_DTLS_RESUME;
+            }
+            return LWM2MCORE_METRIC_DTLS_HANDSHAKE;
+
+        default:
+            return LWM2MCORE_METRIC_MAX;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record the start or the end of the operation measured by a session event
+ */
+//--------------------------------------------------------------------------------------------------
+static void RecordSessionEventMetric
+(
+    smanager_EventType_t eventId,           ///< [IN] Event Id
+    smanager_EventStatus_t eventStatus      ///< [IN] Event status
+)
+{
+    lwm2mcore_Metric_t metric;
+
+    if (NULL == DataCtxPtr)
+    {
+        return;
+    }
+
+    metric = GetSessionEventMetric(DataCtxPtr, eventId, eventStatus);
+    if (LWM2MCORE_METRIC_MAX == metric)
+    {
+        return;
+    }
+
+    switch (eventStatus)
     {
-        LOG("Error launching client inactivity timer");
+        case EVENT_STATUS_STARTED:
+            DataCtxPtr->metricStartMs[metric] = lwm2mcore_TimerGetTimeMs();
+            break;
+
+        case EVENT_STATUS_DONE_SUCCESS:
+        case EVENT_STATUS_DONE_FAIL:
+            perfMetrics_Record(metric,
+                               DataCtxPtr->metricStartMs[metric],
+                               (EVENT_STATUS_DONE_SUCCESS == eventStatus));
+            DataCtxPtr->metricStartMs[metric] = 0;
+            break;
+
+        default:
+            break;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function to record the start of a measured operation of the selected instance
+ *
+ * The duration is recorded when the matching session event reports the end of the operation.
+ */
+//--------------------------------------------------------------------------------------------------
+void smanager_StartMetric
+(
+    lwm2mcore_Metric_t metric       ///< [IN] Measured operation
+)
+{
+    if ((NULL != DataCtxPtr) && (LWM2MCORE_METRIC_MAX > metric))
+    {
+        DataCtxPtr->metricStartMs[metric] = lwm2mcore_TimerGetTimeMs();
     }
 }
 
@@ -670,15 +1527,23 @@ void smanager_SendStatusEvent
     lwm2mcore_Status_t status    ///< [IN] Event status
 )
 {
+    lwm2mcore_StatusCb_t statusCb = StatusCb;
+
+    // Use the callback of the selected client instance if any
+    if ((NULL != DataCtxPtr) && (NULL != DataCtxPtr->statusCb))
+    {
+        statusCb = DataCtxPtr->statusCb;
+    }
+
     // Check if a status callback is available
-    if (!StatusCb)
+    if (!statusCb)
     {
         LOG("No StatusCb to send status events");
         return;
     }
 
     // Send the status event notification
-    StatusCb(status);
+    statusCb(status);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -700,6 +1565,8 @@ void smanager_SendSessionEvent
 #endif
 
     LOG_ARG("Session event: ID %u status %u", eventId, eventstatus);
+    RecordSessionEventMetric(eventId, eventstatus);
+
     switch (eventId)
     {
         case EVENT_TYPE_BOOTSTRAP:
@@ -709,14 +1576,14 @@ void smanager_SendSessionEvent
                 case EVENT_STATUS_STARTED:
                 {
                     LOG("BOOTSTRAP START");
-                    BootstrapSession = true;
+                    SetBootstrapSession(true);
                 }
                 break;
 
                 case EVENT_STATUS_DONE_SUCCESS:
                 {
                     LOG("BOOTSTRAP DONE");
-                    BootstrapSession = false;
+                    SetBootstrapSession(false);
                     omanager_StoreCredentials();
                     omanager_StoreAclConfiguration();
                 }
@@ -732,20 +1599,10 @@ void smanager_SendSessionEvent
 
                 case EVENT_STATUS_FINISHING:
                 {
-                    /* Stop the timer and launch it */
-                    if (false == lwm2mcore_TimerStop(LWM2MCORE_TIMER_STEP))
-                    {
-                        LOG("Error to stop the step timer");
-                    }
-
-                    /* Launch the LWM2MCORE_TIMER_STEP timer with 1 second to treat the update
-                     * request
-                     */
-                    if (false == lwm2mcore_TimerSet(LWM2MCORE_TIMER_STEP,
-                                                    1,
-                                                    Lwm2mClientStepHandler))
+                    /* Launch the step timer with 1 second to treat the update request */
+                    if (NULL != DataCtxPtr)
                     {
-                        LOG("ERROR to launch the step timer for registration update");
+                        StartStepTimer(DataCtxPtr, 1000);
                     }
                 }
                 break;
@@ -874,7 +1731,7 @@ void smanager_SendSessionEvent
                 {
                     LOG ("AUTHENTICATION START");
                     status.event = LWM2MCORE_EVENT_AUTHENTICATION_STARTED;
-                    if (BootstrapSession)
+                    if (smanager_IsBootstrapConnection())
                     {
                         status.u.session.type = LWM2MCORE_SESSION_BOOTSTRAP;
                     }
@@ -889,7 +1746,7 @@ void smanager_SendSessionEvent
                 case EVENT_STATUS_DONE_SUCCESS:
                 {
                     LOG("AUTHENTICATION DONE");
-                    if (BootstrapSession)
+                    if (smanager_IsBootstrapConnection())
                     {
                         status.event = LWM2MCORE_EVENT_SESSION_STARTED;
                         smanager_SendStatusEvent(status);
@@ -900,20 +1757,10 @@ void smanager_SendSessionEvent
                     }
                     else
                     {
-                        /* Stop the timer and launch it */
-                        if (false == lwm2mcore_TimerStop(LWM2MCORE_TIMER_STEP))
-                        {
-                            LOG("Error to stop the step timer");
-                        }
-
-                        /* Launch the LWM2MCORE_TIMER_STEP timer with 1 second to treat the update
-                         * request
-                         */
-                        if (false == lwm2mcore_TimerSet(LWM2MCORE_TIMER_STEP,
-                                                        1,
-                                                        Lwm2mClientStepHandler))
+                        /* Launch the step timer with 1 second to treat the update request */
+                        if (NULL != DataCtxPtr)
                         {
-                            LOG("ERROR to launch the step timer for registration update");
+                            StartStepTimer(DataCtxPtr, 1000);
                         }
                     }
                 }
@@ -923,7 +1770,7 @@ void smanager_SendSessionEvent
                 {
                     LOG("AUTHENTICATION FAILURE");
                     status.event = LWM2MCORE_EVENT_AUTHENTICATION_FAILED;
-                    if (BootstrapSession)
+                    if (smanager_IsBootstrapConnection())
                     {
                         status.u.session.type = LWM2MCORE_SESSION_BOOTSTRAP;
                     }
@@ -986,36 +1833,30 @@ void smanager_SendSessionEvent
                     lwm2m_context_t* lwm2mContextPtr;
 #endif
                     LOG("SESSION DONE");
-                    BootstrapSession = false;
+                    SetBootstrapSession(false);
 
 #ifdef LWM2M_DEREGISTER
                     if (contextPtr)
                     {
                         lwm2mContextPtr = (lwm2m_context_t*)contextPtr;
                         dataPtr = (smanager_ClientData_t*)(lwm2mContextPtr->userData);
-                        dtls_FreeConnection(dataPtr->connListPtr);
+                        dtls_FreeConnection(&(dataPtr->dtls), dataPtr->connListPtr);
                         dataPtr->lwm2mHPtr = NULL;
                         dataPtr->connListPtr = NULL;
 
-                        /* Close the socket */
-                        if (!lwm2mcore_UdpClose(SocketConfig))
+                        /* Send the queued datagrams and close the socket */
+                        udpBatch_Flush();
+                        if (!lwm2mcore_UdpClose(dataPtr->socketConfig))
                         {
                             LOG("Failed to close UDP connection");
                             lwm2mcore_ReportUdpErrorCode(LWM2MCORE_UDP_CLOSE_ERR);
                         }
 
                         /* Zero-init the socket structure */
-                        memset(&SocketConfig, 0, sizeof(lwm2mcore_SocketConfig_t));
-
-                        if (!lwm2mcore_TimerStop(LWM2MCORE_TIMER_STEP))
-                        {
-                            LOG("Failed to stop the step timer");
-                        }
+                        memset(&(dataPtr->socketConfig), 0, sizeof(lwm2mcore_SocketConfig_t));
 
-                        if (!lwm2mcore_TimerStop(LWM2MCORE_TIMER_INACTIVITY))
-                        {
-                            LOG("Failed to stop the inactivity timer");
-                        }
+                        timerWheel_Stop(&(dataPtr->stepTimer));
+                        timerWheel_Stop(&(dataPtr->inactivityTimer));
 
                         if (!lwm2mcore_TimerStop(LWM2MCORE_TIMER_DOWNLOAD))
                         {
@@ -1031,7 +1872,7 @@ void smanager_SendSessionEvent
                 case EVENT_STATUS_DONE_FAIL:
                 {
                     LOG("SESSION FAILURE");
-                    BootstrapSession = false;
+                    SetBootstrapSession(false);
                     status.event = LWM2MCORE_EVENT_SESSION_FAILED;
                     smanager_SendStatusEvent(status);
                 }
@@ -1082,54 +1923,121 @@ static lwm2m_server_t* GetTargetServer
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Callback called when the socked is opened
+ * Treat a datagram received on the socket of a client instance
+ *
+ * @return
+ *  - true if the datagram is handled
+ *  - false else
  */
 //--------------------------------------------------------------------------------------------------
-void lwm2mcore_UdpReceiveCb
+static bool HandleDatagram
 (
+    smanager_ClientData_t* dataPtr,     ///< [IN] Client instance
     uint8_t* bufferPtr,                 ///< [IN] Received data
     uint32_t len,                       ///< [IN] Received data length
-    struct sockaddr_storage *addrPtr,   ///< [INOUT] source address
-    socklen_t addrLen,                  ///< [IN] addrPtr parameter length
-    lwm2mcore_SocketConfig_t config     ///< [IN] Socket config
+    struct sockaddr_storage *addrPtr,   ///< [IN] source address
+    socklen_t addrLen                   ///< [IN] addrPtr parameter length
 )
 {
-    smanager_ClientData_t* dataPtr;
     dtls_Connection_t* connPtr;
     int rc;
 
-    LOG("avc UDP receive data callback");
-
-    dataPtr = (smanager_ClientData_t*)config.instanceRef;
+    perfMetrics_Add(LWM2MCORE_COUNTER_UDP_RX_BYTES, len);
+    perfMetrics_Add(LWM2MCORE_COUNTER_UDP_RX_DATAGRAMS, 1);
 
-    connPtr = dtls_FindConnection(dataPtr->connListPtr, addrPtr, addrLen);
+    connPtr = dtls_FindConnection(&(dataPtr->dtls), addrPtr, addrLen);
     if (!connPtr)
     {
-        LOG("Failed to find an available DTLS connection");
+        LOG_ERR("Failed to find an available DTLS connection");
         lwm2mcore_ReportUdpErrorCode(LWM2MCORE_UDP_RECV_ERR);
-        return;
+        return false;
     }
 
     // Let Wakaama respond to the query depending on the context
-    LOG("Handling packet");
+    LOG_DBG("Handling packet");
     rc = dtls_HandlePacket(connPtr, bufferPtr, (size_t)len);
     if (rc)
     {
-        LOG_ARG("Failed to handle DTLS packet %d.", rc);
+        LOG_ERR("Failed to handle DTLS packet %d.", rc);
         lwm2mcore_ReportUdpErrorCode(LWM2MCORE_UDP_RECV_ERR);
-        return;
+        return false;
     }
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Callback called when the socked is opened
+ */
+//--------------------------------------------------------------------------------------------------
+void lwm2mcore_UdpReceiveCb
+(
+    uint8_t* bufferPtr,                 ///< [IN] Received data
+    uint32_t len,                       ///< [IN] Received data length
+    struct sockaddr_storage *addrPtr,   ///< [INOUT] source address
+    socklen_t addrLen,                  ///< [IN] addrPtr parameter length
+    lwm2mcore_SocketConfig_t config     ///< [IN] Socket config
+)
+{
+    smanager_ClientData_t* dataPtr;
+    bool isHandled;
+
+    LOG_DBG("avc UDP receive data callback");
+
+    dataPtr = (smanager_ClientData_t*)config.instanceRef;
+    smanager_SelectInstance(config.instanceRef);
+
+    udpBatch_Begin();
+    isHandled = HandleDatagram(dataPtr, bufferPtr, len, addrPtr, addrLen);
+    udpBatch_End();
 
     /* Re-launch inactivity timer */
-    if (lwm2mcore_TimerIsRunning(LWM2MCORE_TIMER_INACTIVITY))
+    if ((isHandled) && (timerWheel_IsRunning(&(dataPtr->inactivityTimer))))
+    {
+        StartInactivityTimer(dataPtr);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Callback for the receipt of several datagrams, e.g. read by a single recvmmsg() call
+ */
+//--------------------------------------------------------------------------------------------------
+void lwm2mcore_UdpReceiveBatchCb
+(
+    lwm2mcore_UdpDatagram_t* datagramsPtr,  ///< [IN] Received datagrams
+    size_t count,                           ///< [IN] Number of received datagrams
+    lwm2mcore_SocketConfig_t config         ///< [IN] Socket config
+)
+{
+    smanager_ClientData_t* dataPtr;
+    bool isHandled = false;
+    size_t i;
+
+    LOG_DBG("avc UDP receive %zu datagrams callback", count);
+
+    dataPtr = (smanager_ClientData_t*)config.instanceRef;
+    smanager_SelectInstance(config.instanceRef);
+
+    udpBatch_Begin();
+    for (i = 0; i < count; i++)
     {
-        if (false == lwm2mcore_TimerSet(LWM2MCORE_TIMER_INACTIVITY,
-                                        GetInactiveTimeout(),
-                                        Lwm2mClientInactivityHandler))
+        if (HandleDatagram(dataPtr,
+                           datagramsPtr[i].bufferPtr,
+                           datagramsPtr[i].len,
+                           &(datagramsPtr[i].addr),
+                           datagramsPtr[i].addrLen))
         {
-            LOG("Error launching client inactivity timer");
+            isHandled = true;
         }
     }
+    udpBatch_End();
+
+    /* Re-launch inactivity timer */
+    if ((isHandled) && (timerWheel_IsRunning(&(dataPtr->inactivityTimer))))
+    {
+        StartInactivityTimer(dataPtr);
+    }
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1156,6 +2064,7 @@ bool omanager_UpdateRequest
     {
         return false;
     }
+    smanager_SelectInstance(instanceRef);
 
     /* Check that the device is registered to DM server */
     if ((true == lwm2mcore_ConnectionGetType(instanceRef, &registered) && registered))
@@ -1186,21 +2095,9 @@ bool omanager_UpdateRequest
 
         if (schedule)
         {
-            /* Stop the timer and launch it */
-            if (false == lwm2mcore_TimerStop(LWM2MCORE_TIMER_STEP))
-            {
-                LOG("Error to stop the step timer");
-            }
-
-            /* Launch the LWM2MCORE_TIMER_STEP timer with 1 second to treat the update request */
-            if (false == lwm2mcore_TimerSet(LWM2MCORE_TIMER_STEP, 1, Lwm2mClientStepHandler))
-            {
-                LOG("ERROR to launch the step timer for registration update");
-            }
-            else
-            {
-                result = true;
-            }
+            /* Launch the step timer with 1 second to treat the update request */
+            StartStepTimer(dataPtr, 1000);
+            result = true;
         }
     }
     else
@@ -1267,18 +2164,24 @@ lwm2mcore_Ref_t lwm2mcore_Init
     dataPtr = (smanager_ClientData_t*)lwm2m_malloc(sizeof(smanager_ClientData_t));
     LWM2MCORE_ASSERT(dataPtr);
     memset(dataPtr, 0, sizeof(smanager_ClientData_t));
+    dataPtr->statusCb = eventCb;
 
      /* Initialize LWM2M agent */
     dataPtr->lwm2mHPtr = lwm2m_init(dataPtr);
     LWM2MCORE_ASSERT(dataPtr->lwm2mHPtr);
 
     dataPtr->lwm2mcoreCtxPtr = InitContext(dataPtr);
-    Lwm2mcoreCtxPtr = dataPtr->lwm2mcoreCtxPtr;
     LWM2MCORE_ASSERT(dataPtr->lwm2mcoreCtxPtr);
     dataPtr->serverId = LWM2MCORE_ALL_SERVERS;
     dataPtr->isEdmEnabled = false;
+    dtls_InitInstance(&(dataPtr->dtls));
+    pushQueue_Configure(&(dataPtr->pushQueue),
+                        LWM2MCORE_PUSH_QUEUE_BUDGET,
+                        LWM2MCORE_PUSH_QUEUE_DROP_NEW,
+                        false);
+    InstanceCount++;
 
-    DataCtxPtr = dataPtr;
+    smanager_SelectInstance((lwm2mcore_Ref_t)dataPtr);
 
     LOG_ARG("Init done -> context %p", dataPtr);
     return (lwm2mcore_Ref_t)dataPtr;
@@ -1299,16 +2202,8 @@ void lwm2mcore_SetServer
     uint16_t        serverId        ///< [IN] server ID. Can be ALL_SERVERS (0xFFFF)
 )
 {
-    smanager_ClientData_t* dataPtr;
-    if (instanceRef)
-    {
-        dataPtr = (smanager_ClientData_t*)instanceRef;
-    }
-    else if (DataCtxPtr)
-    {
-        dataPtr = (smanager_ClientData_t*)DataCtxPtr;
-    }
-    else
+    smanager_ClientData_t* dataPtr = GetInstance(instanceRef);
+    if (NULL == dataPtr)
     {
         LOG("Error: no data context");
         return;
@@ -1328,16 +2223,8 @@ void lwm2mcore_SetEdmEnabled
     bool isEdmEnabled               ///< [IN] Whether EDM is enabled
 )
 {
-    smanager_ClientData_t* dataPtr;
-    if (instanceRef)
-    {
-        dataPtr = (smanager_ClientData_t*)instanceRef;
-    }
-    else if (DataCtxPtr)
-    {
-        dataPtr = (smanager_ClientData_t*)DataCtxPtr;
-    }
-    else
+    smanager_ClientData_t* dataPtr = GetInstance(instanceRef);
+    if (NULL == dataPtr)
     {
         LOG("Error: no data context");
         return;
@@ -1432,6 +2319,8 @@ bool lwm2mcore_IsEdmEnabled
 /**
  * Free the LWM2M core
  *
+ * The instance which was selected before the call stays selected, unless it is the freed one:
+ * no instance is selected then.
  */
 //--------------------------------------------------------------------------------------------------
 void lwm2mcore_Free
@@ -1440,13 +2329,34 @@ void lwm2mcore_Free
 )
 {
     smanager_ClientData_t* dataPtr = (smanager_ClientData_t*)instanceRef;
+    smanager_ClientData_t* selectedPtr = DataCtxPtr;
 
     if (NULL != dataPtr)
     {
+        // The object manager frees the objects of the selected instance
+        smanager_SelectInstance(instanceRef);
+
+        timerWheel_Stop(&(dataPtr->notifyTimer));
+        timerWheel_Stop(&(dataPtr->stepTimer));
+        timerWheel_Stop(&(dataPtr->inactivityTimer));
+
         /* Free objects */
         omanager_ObjectsFree();
-        omanager_FreeBootstrapInformation();
-        omanager_FreeAclConfiguration();
+
+        // The bootstrap and ACL configurations are shared by the instances of the process
+        if (InstanceCount)
+        {
+            InstanceCount--;
+        }
+        if (0 == InstanceCount)
+        {
+            omanager_FreeBootstrapInformation();
+            omanager_FreeAclConfiguration();
+        }
+
+        dtls_FreeInstance(&(dataPtr->dtls));
+        pushQueue_Flush(&(dataPtr->pushQueue));
+        pushStream_Stop(&(dataPtr->pushStream));
 
         if (NULL != dataPtr->lwm2mcoreCtxPtr)
         {
@@ -1459,7 +2369,9 @@ void lwm2mcore_Free
         }
 
         lwm2m_free(dataPtr);
-        DataCtxPtr = NULL;
+
+        // Keep the selection of another instance, never leave a freed instance selected
+        smanager_SelectInstance((selectedPtr != dataPtr) ? (lwm2mcore_Ref_t)selectedPtr : NULL);
     }
 }
 
@@ -1484,27 +2396,25 @@ bool lwm2mcore_Connect
         return false;
     }
 
+    dataPtr = (smanager_ClientData_t*)instanceRef;
+    smanager_SelectInstance(instanceRef);
+
     /* Create the socket */
-    memset(&SocketConfig, 0, sizeof (lwm2mcore_SocketConfig_t));
-    if (!lwm2mcore_UdpOpen(instanceRef, lwm2mcore_UdpReceiveCb, &SocketConfig))
+    memset(&(dataPtr->socketConfig), 0, sizeof (lwm2mcore_SocketConfig_t));
+    if (!lwm2mcore_UdpOpen(instanceRef, lwm2mcore_UdpReceiveCb, &(dataPtr->socketConfig)))
     {
         LOG("Failed to open UDP connection");
         lwm2mcore_ReportUdpErrorCode(LWM2MCORE_UDP_OPEN_ERR);
         return false;
     }
 
-    LOG_ARG("lwm2mcore_connect -> socket %d opened ", SocketConfig.sock);
+    LOG_ARG("lwm2mcore_connect -> socket %d opened ", dataPtr->socketConfig.sock);
 
-    dataPtr = (smanager_ClientData_t*)instanceRef;
-    dataPtr->sock = SocketConfig.sock;
-    dataPtr->addressFamily = SocketConfig.af;
+    dataPtr->sock = dataPtr->socketConfig.sock;
+    dataPtr->addressFamily = dataPtr->socketConfig.af;
 
     /* Initialize the lwm2m client step timer */
-    DataCtxPtr = dataPtr;
-    if (!lwm2mcore_TimerSet(LWM2MCORE_TIMER_STEP, 1, Lwm2mClientStepHandler))
-    {
-        LOG("Failed to launch the 1st step timer");
-    }
+    StartStepTimer(dataPtr, 1000);
 
     LOG("LWM2M Client started");
 
@@ -1561,6 +2471,10 @@ bool lwm2mcore_NotifyResourceChange
     }
 
     smanager_ClientData_t* dataPtr = (smanager_ClientData_t*)instanceRef;
+    smanager_SelectInstance(instanceRef);
+
+    /* The next read of the resource has to retrieve the new value */
+    omanager_InvalidateResourceCache(objectId, objectInstanceId, resourceId);
 
     /* Check that the device is registered to DM server */
     bool registered = false;
@@ -1573,29 +2487,81 @@ bool lwm2mcore_NotifyResourceChange
             return false;
         }
 
-        lwm2m_uri_t uriP;
-        uriP.flag = LWM2M_URI_FLAG_OBJECT_ID | LWM2M_URI_FLAG_INSTANCE_ID |
-                    LWM2M_URI_FLAG_RESOURCE_ID;
-        uriP.objectId = objectId;
-        uriP.instanceId = objectInstanceId;
-        uriP.resourceId = resourceId;
+        /* Only changes which pass the observe attributes of one observation are notified */
+        bool isObserved;
+        omanager_NotifyDecision_t decision = CheckObservations(dataPtr->lwm2mHPtr,
+                                                               objectId,
+                                                               objectInstanceId,
+                                                               resourceId,
+                                                               &isObserved);
+        if (!isObserved)
+        {
+            LOG("Resource not observed");
+            return true;
+        }
 
-        /* Notify observers */
-        while (targetPtr)
+        switch (decision)
         {
-            LOG_ARG("shortServerId %d", targetPtr->shortID);
-            lwm2m_resource_value_changed(dataPtr->lwm2mHPtr, &uriP);
-            targetPtr = targetPtr->next;
+            case OMANAGER_NOTIFY_SUPPRESS:
+                return true;
+
+            case OMANAGER_NOTIFY_DEFER:
+                /* Let the step timer be rescheduled on the deferred notification */
+                break;
+
+            case OMANAGER_NOTIFY_SEND:
+            default:
+                /* Notify observers: the batch is flushed by the next step */
+                if (BatchNotification(dataPtr, objectId, objectInstanceId, resourceId))
+                {
+                    LOG("Notification batch full");
+                    FlushNotifications(dataPtr);
+                }
+                break;
         }
     }
 
-    /* Do step */
-    if (false == lwm2mcore_TimerSet(LWM2MCORE_TIMER_STEP, 0, Lwm2mClientStepHandler))
+    /* The batching window or the step which flushes the batch is already armed */
+    if (   (dataPtr->isNotifyFlushScheduled)
+        && (   (timerWheel_IsRunning(&(dataPtr->notifyTimer)))
+            || (timerWheel_IsRunning(&(dataPtr->stepTimer)))))
+    {
+        return true;
+    }
+
+    /* Do step at the end of the batching window */
+    timerWheel_Start(&(dataPtr->notifyTimer),
+                     dataPtr->notifyWindowMs,
+                     NotifyWindowHandler,
+                     dataPtr);
+    dataPtr->isNotifyFlushScheduled = true;
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Function to set the batching window of resource change notifications.
+ *
+ * @return
+ *      - @c true if the window was set
+ *      - else @c false
+ */
+//--------------------------------------------------------------------------------------------------
+bool lwm2mcore_SetNotificationWindow
+(
+    lwm2mcore_Ref_t instanceRef,       ///< [IN] instance reference
+    uint32_t windowMs                  ///< [IN] batching window in ms
+)
+{
+    if (!instanceRef)
     {
-        LOG("ERROR to launch the step timer");
+        LOG("Null instance reference");
         return false;
     }
 
+    LOG_ARG("Notification window %d ms", windowMs);
+    ((smanager_ClientData_t*)instanceRef)->notifyWindowMs = windowMs;
     return true;
 }
 
@@ -1634,6 +2600,7 @@ bool lwm2mcore_DisconnectWithDeregister
         LOG("Null instance reference");
         return false;
     }
+    smanager_SelectInstance(instanceRef);
 
     /* If a download is on-going, better to not send the DEREGISTER message */
     infoResult = lwm2mcore_GetDownloadInfo (&updateType, &packageSize);
@@ -1674,18 +2641,8 @@ bool lwm2mcore_DisconnectWithDeregister
     if (true == lwm2m_close(dataPtr->lwm2mHPtr))
     {
 #ifdef LWM2M_DEREGISTER
-        /* Stop the current timers */
-        if (!lwm2mcore_TimerStop(LWM2MCORE_TIMER_STEP))
-        {
-            LOG("Failed to stop the step timer");
-        }
-        /* Launch the LWM2MCORE_TIMER_STEP timer with 1 second to treat the deregister msg */
-        if (false == lwm2mcore_TimerSet(LWM2MCORE_TIMER_STEP,
-                                        1,
-                                        Lwm2mClientStepHandler))
-        {
-            LOG("ERROR to launch the step timer for registration update");
-        }
+        /* Launch the step timer with 1 second to treat the deregister msg */
+        StartStepTimer(dataPtr, 1000);
 #else /* !LWM2M_DEREGISTER */
         CloseConnection(dataPtr);
         /* Notify that the connection is stopped */
@@ -1736,6 +2693,7 @@ bool lwm2mcore_Disconnect
     //     Receiving install command etc) are in jeopardy.
 
     dataPtr = (smanager_ClientData_t*)instanceRef;
+    smanager_SelectInstance(instanceRef);
 
     /* Stop the agent */
     dataPtr->lwm2mHPtr->userData = dataPtr;
@@ -1807,7 +2765,9 @@ void lwm2mcore_SetPushCallback
  *
  * @return
  *      - LWM2MCORE_PUSH_INITIATED if data push transaction is initiated
- *      - LWM2MCORE_PUSH_BUSY if state machine is busy doing a block transfer
+ *      - LWM2MCORE_PUSH_QUEUED if the push is queued behind the one in flight
+ *      - LWM2MCORE_PUSH_BUSY if state machine is busy doing a block transfer and the push is not
+ *        queued
  *      - LWM2MCORE_PUSH_FAILED if data push transaction failed
  */
 //--------------------------------------------------------------------------------------------------
@@ -1830,18 +2790,12 @@ lwm2mcore_PushResult_t lwm2mcore_Push
     {
         return result;
     }
+    smanager_SelectInstance(instanceRef);
 
-    switch (content)
+    if (!GetPushMediaType(content, &contentType))
     {
-        case LWM2MCORE_PUSH_CONTENT_CBOR:
-            contentType = LWM2M_CONTENT_CBOR;
-            break;
-        case LWM2MCORE_PUSH_CONTENT_ZCBOR:
-            contentType = LWM2M_CONTENT_ZCBOR;
-            break;
-        default:
-            LOG_ARG("Invalid content type %d", content);
-            return LWM2MCORE_PUSH_FAILED;
+        LOG_ARG("Invalid content type %d", content);
+        return LWM2MCORE_PUSH_FAILED;
     }
 
     /* Check that the device is registered to DM server */
@@ -1856,12 +2810,21 @@ lwm2mcore_PushResult_t lwm2mcore_Push
         else
         {
             LOG_ARG("shortServerId %d", targetPtr->shortID);
-            rc = lwm2m_data_push(dataPtr->lwm2mHPtr,
-                                 targetPtr->shortID,
-                                 payloadPtr,
-                                 payloadLength,
-                                 contentType,
-                                 midPtr);
+            if (   (pushQueue_IsEnabled(&(dataPtr->pushQueue)))
+                && (pushQueue_IsBusy(&(dataPtr->pushQueue))))
+            {
+                /* Keep the order of the pushes: queue behind the pending ones */
+                rc = COAP_412_PRECONDITION_FAILED;
+            }
+            else
+            {
+                rc = lwm2m_data_push(dataPtr->lwm2mHPtr,
+                                     targetPtr->shortID,
+                                     payloadPtr,
+                                     payloadLength,
+                                     contentType,
+                                     midPtr);
+            }
 
             if (rc == COAP_NO_ERROR)
             {
@@ -1869,7 +2832,7 @@ lwm2mcore_PushResult_t lwm2mcore_Push
             }
             else if (rc == COAP_412_PRECONDITION_FAILED)
             {
-                result = LWM2MCORE_PUSH_BUSY;
+                result = QueuePush(dataPtr, payloadPtr, payloadLength, content, midPtr);
             }
             else
             {
@@ -1881,6 +2844,208 @@ lwm2mcore_PushResult_t lwm2mcore_Push
     return result;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function to configure the queue of the pushes initiated while another one is in flight
+ *
+ * @return
+ *      - true if the queue was configured
+ *      - else false
+ */
+//--------------------------------------------------------------------------------------------------
+bool lwm2mcore_SetPushQueue
+(
+    lwm2mcore_Ref_t instanceRef,            ///< [IN] instance reference
+    size_t budget,                          ///< [IN] memory budget in bytes, 0 to disable the queue
+    lwm2mcore_PushQueuePolicy_t policy,     ///< [IN] policy when the budget is exceeded
+    bool isAggregated                       ///< [IN] aggregate the queued CBOR payloads
+)
+{
+    if (!instanceRef)
+    {
+        LOG("Null instance reference");
+        return false;
+    }
+
+    switch (policy)
+    {
+        case LWM2MCORE_PUSH_QUEUE_DROP_NEW:
+        case LWM2MCORE_PUSH_QUEUE_DROP_OLDEST:
+        case LWM2MCORE_PUSH_QUEUE_OVERWRITE:
+            break;
+        default:
+            LOG_ARG("Invalid push queue policy %d", policy);
+            return false;
+    }
+
+    LOG_ARG("Push queue budget %zu bytes, policy %d, aggregation %d", budget, policy, isAggregated);
+    pushQueue_Configure(&(((smanager_ClientData_t*)instanceRef)->pushQueue),
+                        budget,
+                        policy,
+                        isAggregated);
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send the first block of the streamed push of a client instance
+ *
+ * @return
+ *      - LWM2MCORE_PUSH_INITIATED if the first block is sent
+ *      - LWM2MCORE_PUSH_FAILED else
+ */
+//--------------------------------------------------------------------------------------------------
+static lwm2mcore_PushResult_t StartPushStream
+(
+    smanager_ClientData_t* dataPtr,         ///< [IN] Client instance
+    uint16_t* midPtr                        ///< [OUT] message id of the first block
+)
+{
+    if (!SendPushBlock(dataPtr))
+    {
+        pushStream_Stop(&(dataPtr->pushStream));
+        return LWM2MCORE_PUSH_FAILED;
+    }
+
+    if (NULL != midPtr)
+    {
+        *midPtr = dataPtr->pushStream.mid;
+    }
+
+    /* To check for retransmission, launch the step now: the step schedules the next one on the
+     * retransmission deadline */
+    StartStepTimer(dataPtr, 0);
+    return LWM2MCORE_PUSH_INITIATED;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if a streamed push can be started on a client instance
+ *
+ * @return
+ *      - LWM2MCORE_PUSH_INITIATED if the streamed push can be started
+ *      - LWM2MCORE_PUSH_BUSY if a streamed push is in progress
+ *      - LWM2MCORE_PUSH_FAILED else
+ */
+//--------------------------------------------------------------------------------------------------
+static lwm2mcore_PushResult_t CheckPushStream
+(
+    lwm2mcore_Ref_t instanceRef,            ///< [IN] instance reference
+    lwm2mcore_PushContent_t content         ///< [IN] content type
+)
+{
+    smanager_ClientData_t* dataPtr = (smanager_ClientData_t*)instanceRef;
+    lwm2m_media_type_t contentType;
+    bool registered = false;
+
+    if (NULL == instanceRef)
+    {
+        return LWM2MCORE_PUSH_FAILED;
+    }
+    smanager_SelectInstance(instanceRef);
+
+    if (!GetPushMediaType(content, &contentType))
+    {
+        LOG_ARG("Invalid content type %d", content);
+        return LWM2MCORE_PUSH_FAILED;
+    }
+
+    /* Check that the device is registered to DM server */
+    if (   (!lwm2mcore_ConnectionGetType(instanceRef, &registered))
+        || (!registered)
+        || (NULL == dataPtr->lwm2mHPtr->serverList))
+    {
+        LOG("Not registered");
+        return LWM2MCORE_PUSH_FAILED;
+    }
+
+    if (dataPtr->pushStream.isActive)
+    {
+        return LWM2MCORE_PUSH_BUSY;
+    }
+    return LWM2MCORE_PUSH_INITIATED;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function to push data read from a callback, block-wise
+ *
+ * @return
+ *      - LWM2MCORE_PUSH_INITIATED if the first block is sent
+ *      - LWM2MCORE_PUSH_BUSY if a streamed push is in progress
+ *      - LWM2MCORE_PUSH_FAILED if data push transaction failed
+ */
+//--------------------------------------------------------------------------------------------------
+lwm2mcore_PushResult_t lwm2mcore_PushStream
+(
+    lwm2mcore_Ref_t instanceRef,            ///< [IN] instance reference
+    lwm2mcore_PushReader_t readerCb,        ///< [IN] payload reader
+    void* contextPtr,                       ///< [IN] context given to the reader
+    lwm2mcore_PushContent_t content,        ///< [IN] content type
+    uint16_t* midPtr                        ///< [OUT] message id of the first block
+)
+{
+    smanager_ClientData_t* dataPtr = (smanager_ClientData_t*)instanceRef;
+    lwm2mcore_PushResult_t result;
+
+    if (NULL == readerCb)
+    {
+        return LWM2MCORE_PUSH_FAILED;
+    }
+
+    result = CheckPushStream(instanceRef, content);
+    if (LWM2MCORE_PUSH_INITIATED != result)
+    {
+        return result;
+    }
+
+    if (!pushStream_Start(&(dataPtr->pushStream), readerCb, contextPtr, content))
+    {
+        return LWM2MCORE_PUSH_FAILED;
+    }
+    return StartPushStream(dataPtr, midPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function to push data scattered in several buffers, block-wise
+ *
+ * @return
+ *      - LWM2MCORE_PUSH_INITIATED if the first block is sent
+ *      - LWM2MCORE_PUSH_BUSY if a streamed push is in progress
+ *      - LWM2MCORE_PUSH_FAILED if data push transaction failed
+ */
+//--------------------------------------------------------------------------------------------------
+lwm2mcore_PushResult_t lwm2mcore_PushIovec
+(
+    lwm2mcore_Ref_t instanceRef,            ///< [IN] instance reference
+    const lwm2mcore_PushIovec_t* iovPtr,    ///< [IN] payload parts
+    size_t iovCount,                        ///< [IN] number of payload parts
+    lwm2mcore_PushContent_t content,        ///< [IN] content type
+    uint16_t* midPtr                        ///< [OUT] message id of the first block
+)
+{
+    smanager_ClientData_t* dataPtr = (smanager_ClientData_t*)instanceRef;
+    lwm2mcore_PushResult_t result;
+
+    if ((NULL == iovPtr) && (0 != iovCount))
+    {
+        return LWM2MCORE_PUSH_FAILED;
+    }
+
+    result = CheckPushStream(instanceRef, content);
+    if (LWM2MCORE_PUSH_INITIATED != result)
+    {
+        return result;
+    }
+
+    if (!pushStream_StartIovec(&(dataPtr->pushStream), iovPtr, iovCount, content))
+    {
+        return LWM2MCORE_PUSH_FAILED;
+    }
+    return StartPushStream(dataPtr, midPtr);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Function to send an unsolicited message to server (Push)
@@ -1911,19 +3076,9 @@ bool lwm2mcore_SendNotification
                                          notificationPtr->streamStatus);
         if (result)
         {
-            /* To check for retransmission, need to relaunch LWM2MCORE_TIMER_STEP */
-            if (false == lwm2mcore_TimerStop(LWM2MCORE_TIMER_STEP))
-            {
-                LOG("Error to stop the step timer");
-            }
-
-            /* Launch the LWM2MCORE_TIMER_STEP timer with 1 second to check retransmission needs */
-            if (false == lwm2mcore_TimerSet(LWM2MCORE_TIMER_STEP,
-                                            1,
-                                            Lwm2mClientStepHandler))
-            {
-                LOG("ERROR to launch the step timer for retransmission check");
-            }
+            /* To check for retransmission, launch the step now: the step schedules the next
+             * one on the retransmission deadline */
+            StartStepTimer(DataCtxPtr, 0);
         }
         return result;
     }
@@ -1934,6 +3089,35 @@ bool lwm2mcore_SendNotification
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function to get the block size selected on the connection to the server.
+ *
+ * @return
+ *  - block size: power of 2 from 16 to 1024
+ */
+//--------------------------------------------------------------------------------------------------
+uint16_t lwm2mcore_GetBlockSize
+(
+    lwm2mcore_Ref_t instanceRef                 ///< [IN] instance reference
+)
+{
+    smanager_ClientData_t* dataPtr = (smanager_ClientData_t*) instanceRef;
+    lwm2m_server_t* targetPtr;
+
+    if ((NULL == dataPtr) || (NULL == dataPtr->lwm2mHPtr))
+    {
+        return LWM2MCORE_BLOCK_SIZE_MAX;
+    }
+
+    targetPtr = dataPtr->lwm2mHPtr->serverList;
+    if ((NULL == targetPtr) || (NULL == targetPtr->sessionH))
+    {
+        return LWM2MCORE_BLOCK_SIZE_MAX;
+    }
+    return ((dtls_Connection_t*)targetPtr->sessionH)->blockSize.size;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Function to send a CoAP response to server.
@@ -1956,6 +3140,7 @@ bool lwm2mcore_SendResponse
     {
         return false;
     }
+    smanager_SelectInstance(instanceRef);
 
     /* Check that the device is registered to DM server */
     if ((true == lwm2mcore_ConnectionGetType(instanceRef, &registered) && registered))
@@ -1969,6 +3154,14 @@ bool lwm2mcore_SendResponse
         }
         else
         {
+            uint16_t blockSize = responsePtr->blockSize;
+
+            /* Without a block size chosen by the client, follow the connection */
+            if (0 == blockSize)
+            {
+                blockSize = lwm2mcore_GetBlockSize(instanceRef);
+            }
+
             return lwm2m_send_response(dataPtr->lwm2mHPtr,
                                        targetPtr->shortID,
                                        responsePtr->messageId,
@@ -1979,7 +3172,7 @@ bool lwm2mcore_SendResponse
                                        responsePtr->payloadPtr,
                                        responsePtr->payloadLength,
                                        responsePtr->streamStatus,
-                                       responsePtr->blockSize);
+                                       blockSize);
         }
     }
 
@@ -2009,6 +3202,7 @@ bool lwm2mcore_SendAsyncResponse
     {
         return false;
     }
+    smanager_SelectInstance(instanceRef);
 
     /* Check that the device is registered to DM server */
     if ((true == lwm2mcore_ConnectionGetType(instanceRef, &registered) && registered))
@@ -2163,7 +3357,7 @@ bool smanager_IsBootstrapConnection
     void
 )
 {
-    if (BootstrapSession)
+    if ((NULL != DataCtxPtr) && (DataCtxPtr->isBootstrapSession))
     {
         return true;
     }
@@ -2369,6 +3563,8 @@ void smanager_ForceDtlsHandshake
 /**
  * @brief Set the DTLS NAT timeout
  * @note Storage: volatile memory
+ * @note The timeout applies to the selected client instance and to the instances initialized
+ * afterwards
  */
 //--------------------------------------------------------------------------------------------------
 void lwm2mcore_SetNatTimeout
@@ -2376,7 +3572,52 @@ void lwm2mcore_SetNatTimeout
     uint32_t        timeout        ///< [IN] Timeout
 )
 {
-    dtls_SetNatTimeout(timeout);
+    dtls_SetNatTimeout(NULL, timeout);
+    if (NULL != DataCtxPtr)
+    {
+        dtls_SetNatTimeout(&(DataCtxPtr->dtls), timeout);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Enable or disable the learning of the NAT timeout
+ * @note Storage: volatile memory
+ * @note The setting applies to the selected client instance and to the instances initialized
+ * afterwards
+ */
+//--------------------------------------------------------------------------------------------------
+void lwm2mcore_SetAdaptiveNatTimeout
+(
+    bool            isAdaptive     ///< [IN] Learn the NAT timeout
+)
+{
+    dtls_SetAdaptiveNatTimeout(NULL, isAdaptive);
+    if (NULL != DataCtxPtr)
+    {
+        dtls_SetAdaptiveNatTimeout(&(DataCtxPtr->dtls), isAdaptive);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Get the NAT timeout in use by the selected client instance, learned or configured
+ *
+ * @return
+ *  - NAT timeout in seconds
+ *  - 0 if no client instance is selected
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t lwm2mcore_GetNatTimeout
+(
+    void
+)
+{
+    if (NULL == DataCtxPtr)
+    {
+        return 0;
+    }
+    return dtls_GetNatTimeout(&(DataCtxPtr->dtls));
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -2395,21 +3636,8 @@ void smanager_ForceBootstrap
                            DataCtxPtr->lwm2mHPtr->serverList,
                            removeTransaction ? DataCtxPtr->lwm2mHPtr->transactionList : NULL);
 
-    /* Stop the timer and launch it */
-    if (false == lwm2mcore_TimerStop(LWM2MCORE_TIMER_STEP))
-    {
-        LOG("Error to stop the step timer");
-    }
-
-    /* Launch the LWM2MCORE_TIMER_STEP timer with 1 second to treat the update
-     * request
-     */
-    if (false == lwm2mcore_TimerSet(LWM2MCORE_TIMER_STEP,
-                                    1,
-                                    Lwm2mClientStepHandler))
-    {
-        LOG("ERROR to launch the step timer for registration update");
-    }
+    /* Launch the step timer with 1 second to treat the update request */
+    StartStepTimer(DataCtxPtr, 1000);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -2428,19 +3656,25 @@ void smanager_Registration
                            DataCtxPtr->lwm2mHPtr->serverList,
                            NULL);
 
-    /* Stop the timer and launch it */
-    if (false == lwm2mcore_TimerStop(LWM2MCORE_TIMER_STEP))
-    {
-        LOG("Error to stop the step timer");
-    }
+    /* Launch the step timer with 1 second to treat the update request */
+    StartStepTimer(DataCtxPtr, 1000);
+}
 
-    /* Launch the LWM2MCORE_TIMER_STEP timer with 1 second to treat the update
-     * request
-     */
-    if (false == lwm2mcore_TimerSet(LWM2MCORE_TIMER_STEP,
-                                    1,
-                                    Lwm2mClientStepHandler))
-    {
-        LOG("ERROR to launch the step timer for registration update");
-    }
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Select the client instance on which the session and object managers work.
+ *
+ * The porting callbacks (timers, sockets, storage) do not all carry an instance reference: the
+ * entry points of LwM2MCore select the instance they work on before calling the managers.
+ */
+//--------------------------------------------------------------------------------------------------
+void smanager_SelectInstance
+(
+    lwm2mcore_Ref_t instanceRef     ///< [IN] instance reference, NULL to clear the selection
+)
+{
+    smanager_ClientData_t* dataPtr = (smanager_ClientData_t*)instanceRef;
+
+    DataCtxPtr = dataPtr;
+    Lwm2mcoreCtxPtr = (NULL != dataPtr) ? dataPtr->lwm2mcoreCtxPtr : NULL;
 }
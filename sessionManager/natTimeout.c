@@ -0,0 +1,210 @@
+/**
+ * @file natTimeout.c
+ *
+ * NAT binding lifetime learning: DTLS resume threshold tuned from the server reachability
+ *
+ * A message received from the server after an inactivity shows that the NAT binding survived it.
+ * A message sent without DTLS resume after an inactivity probes the binding: it is answered if
+ * the binding survived, and sent again by the CoAP layer if it did not. Inactivities a bit longer
+ * than the current timeout are probed to learn a longer lifetime. The timeout grows up to the
+ * longest inactivity known to be safe and stays below the shortest one which lost the binding.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+/* include files */
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <lwm2mcore/lwm2mcore.h>
+#include "natTimeout.h"
+
+#define LOG_MODULE_LEVEL LWM2MCORE_LOG_DTLS
+#include "coreLog.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute the NAT timeout from the learned bounds of the binding lifetime
+ *
+ * @return
+ *  - true if the NAT timeout changed
+ *  - false else
+ */
+//--------------------------------------------------------------------------------------------------
+static bool UpdateTimeout
+(
+    natTimeout_Estimator_t* estimatorPtr    ///< [IN] Learning state
+)
+{
+    uint32_t timeout = estimatorPtr->initial;
+    bool isChanged;
+
+    if (estimatorPtr->aliveSec > timeout)
+    {
+        timeout = estimatorPtr->aliveSec;
+    }
+
+    // Stay below an inactivity which lost the binding
+    if ((0 != estimatorPtr->deadSec) && (timeout >= estimatorPtr->deadSec))
+    {
+        timeout = (0 != estimatorPtr->aliveSec) ? estimatorPtr->aliveSec :
+                                                  estimatorPtr->deadSec / 2;
+    }
+
+    if (LWM2MCORE_NAT_TIMEOUT_MIN > timeout)
+    {
+        timeout = LWM2MCORE_NAT_TIMEOUT_MIN;
+    }
+    else if (LWM2MCORE_NAT_TIMEOUT_MAX < timeout)
+    {
+        timeout = LWM2MCORE_NAT_TIMEOUT_MAX;
+    }
+
+    isChanged = (timeout != estimatorPtr->timeout);
+    if (isChanged)
+    {
+        LOG_ARG("NAT timeout %u s (alive %u s, lost %u s)",
+                timeout, estimatorPtr->aliveSec, estimatorPtr->deadSec);
+    }
+    estimatorPtr->timeout = timeout;
+    return isChanged;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the learning state with the configured NAT timeout. The learned values are cleared.
+ */
+//--------------------------------------------------------------------------------------------------
+void natTimeout_Init
+(
+    natTimeout_Estimator_t* estimatorPtr,   ///< [IN] Learning state
+    uint32_t initial                        ///< [IN] Configured NAT timeout in seconds
+)
+{
+    memset(estimatorPtr, 0, sizeof(natTimeout_Estimator_t));
+    estimatorPtr->initial = initial;
+    UpdateTimeout(estimatorPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if a DTLS resume is needed before a message sent after an inactivity.
+ *
+ * A message sent without resume is a probe of the binding. Inactivities longer than the timeout
+ * are probed up to twice the timeout, unless they already lost the binding.
+ *
+ * @return
+ *  - true if a DTLS resume is needed
+ *  - false if the message is sent without DTLS resume
+ */
+//--------------------------------------------------------------------------------------------------
+bool natTimeout_IsResumeNeeded
+(
+    natTimeout_Estimator_t* estimatorPtr,   ///< [IN] Learning state
+    uint32_t idleSec                        ///< [IN] Inactivity in seconds
+)
+{
+    if (idleSec > estimatorPtr->timeout)
+    {
+        if ((0 != estimatorPtr->probeSec)
+         || ((idleSec / 2) > estimatorPtr->timeout)
+         || (LWM2MCORE_NAT_TIMEOUT_MAX < idleSec)
+         || ((0 != estimatorPtr->deadSec) && (idleSec >= estimatorPtr->deadSec)))
+        {
+            return true;
+        }
+        LOG_ARG("Probe the NAT binding after %u s", idleSec);
+    }
+
+    // Short inactivities do not tell anything about the binding
+    if ((0 == estimatorPtr->probeSec) && (LWM2MCORE_NAT_TIMEOUT_MIN <= idleSec))
+    {
+        estimatorPtr->probeSec = idleSec;
+    }
+    return false;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if a probe is in progress
+ *
+ * @return
+ *  - true if a probe waits for its result
+ *  - false else
+ */
+//--------------------------------------------------------------------------------------------------
+bool natTimeout_IsProbing
+(
+    const natTimeout_Estimator_t* estimatorPtr  ///< [IN] Learning state
+)
+{
+    return (0 != estimatorPtr->probeSec);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Report the result of the probe in progress
+ *
+ * @return
+ *  - true if the NAT timeout changed
+ *  - false else
+ */
+//--------------------------------------------------------------------------------------------------
+bool natTimeout_ReportProbe
+(
+    natTimeout_Estimator_t* estimatorPtr,   ///< [IN] Learning state
+    bool isAlive                            ///< [IN] Set if the server answered the probe
+)
+{
+    uint32_t idleSec = estimatorPtr->probeSec;
+
+    if (0 == idleSec)
+    {
+        return false;
+    }
+    estimatorPtr->probeSec = 0;
+
+    if (isAlive)
+    {
+        return natTimeout_ReportAlive(estimatorPtr, idleSec);
+    }
+
+    if ((0 == estimatorPtr->deadSec) || (idleSec < estimatorPtr->deadSec))
+    {
+        estimatorPtr->deadSec = idleSec;
+    }
+    // The network does not keep the bindings as long as before
+    if (estimatorPtr->aliveSec >= estimatorPtr->deadSec)
+    {
+        estimatorPtr->aliveSec = 0;
+    }
+    return UpdateTimeout(estimatorPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Report a message received from the server after an inactivity: the binding was alive
+ *
+ * @return
+ *  - true if the NAT timeout changed
+ *  - false else
+ */
+//--------------------------------------------------------------------------------------------------
+bool natTimeout_ReportAlive
+(
+    natTimeout_Estimator_t* estimatorPtr,   ///< [IN] Learning state
+    uint32_t idleSec                        ///< [IN] Inactivity in seconds
+)
+{
+    if (idleSec > estimatorPtr->aliveSec)
+    {
+        estimatorPtr->aliveSec = idleSec;
+    }
+    // The network keeps the bindings longer than before
+    if ((0 != estimatorPtr->deadSec) && (estimatorPtr->deadSec <= estimatorPtr->aliveSec))
+    {
+        estimatorPtr->deadSec = 0;
+    }
+    return UpdateTimeout(estimatorPtr);
+}
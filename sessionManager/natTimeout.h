@@ -0,0 +1,143 @@
+/**
+ * @file natTimeout.h
+ *
+ * NAT binding lifetime learning header file
+ *
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+#ifndef __NAT_TIMEOUT_H__
+#define __NAT_TIMEOUT_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+  * @addtogroup lwm2mcore_natTimeout_int
+  * @{
+  */
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Minimum learned NAT timeout in seconds
+ */
+//--------------------------------------------------------------------------------------------------
+#ifndef LWM2MCORE_NAT_TIMEOUT_MIN
+#define LWM2MCORE_NAT_TIMEOUT_MIN       5
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Maximum learned NAT timeout in seconds
+ */
+//--------------------------------------------------------------------------------------------------
+#ifndef LWM2MCORE_NAT_TIMEOUT_MAX
+#define LWM2MCORE_NAT_TIMEOUT_MAX       1800
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Learning state of the NAT binding lifetime of a client instance.
+ *
+ * The lifetime is bounded by the longest inactivity after which the server could still reach the
+ * client and by the shortest inactivity after which it could not. The timeout is the configured
+ * one until a longer inactivity is known to be safe, and it is kept below the shortest inactivity
+ * which lost the binding.
+ *
+ * A probe is a message sent without DTLS resume after an inactivity: the binding is alive if a
+ * message of the server is received, and lost if the message has to be sent again. Inactivities
+ * a bit longer than the timeout are probed to learn a longer lifetime.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t initial;       ///< Configured NAT timeout in seconds, used until a longer inactivity
+                            ///< is known to be safe
+    uint32_t aliveSec;      ///< Longest inactivity in seconds after which the binding was alive
+    uint32_t deadSec;       ///< Shortest inactivity in seconds after which the binding was lost,
+                            ///< 0 if unknown
+    uint32_t probeSec;      ///< Inactivity in seconds of the probe in progress, 0 if none
+    uint32_t timeout;       ///< NAT timeout in seconds
+}natTimeout_Estimator_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Initialize the learning state with the configured NAT timeout. The learned values are
+ * cleared.
+ */
+//--------------------------------------------------------------------------------------------------
+void natTimeout_Init
+(
+    natTimeout_Estimator_t* estimatorPtr,   ///< [IN] Learning state
+    uint32_t initial                        ///< [IN] Configured NAT timeout in seconds
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Check if a DTLS resume is needed before a message sent after an inactivity.
+ *
+ * A message sent without resume is a probe of the binding. Inactivities longer than the timeout
+ * are probed up to twice the timeout, unless they already lost the binding.
+ *
+ * @return
+ *  - true if a DTLS resume is needed
+ *  - false if the message is sent without DTLS resume
+ */
+//--------------------------------------------------------------------------------------------------
+bool natTimeout_IsResumeNeeded
+(
+    natTimeout_Estimator_t* estimatorPtr,   ///< [IN] Learning state
+    uint32_t idleSec                        ///< [IN] Inactivity in seconds
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Check if a probe is in progress
+ *
+ * @return
+ *  - true if a probe waits for its result
+ *  - false else
+ */
+//--------------------------------------------------------------------------------------------------
+bool natTimeout_IsProbing
+(
+    const natTimeout_Estimator_t* estimatorPtr  ///< [IN] Learning state
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Report the result of the probe in progress
+ *
+ * @return
+ *  - true if the NAT timeout changed
+ *  - false else
+ */
+//--------------------------------------------------------------------------------------------------
+bool natTimeout_ReportProbe
+(
+    natTimeout_Estimator_t* estimatorPtr,   ///< [IN] Learning state
+    bool isAlive                            ///< [IN] Set if the server answered the probe
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Report a message received from the server after an inactivity: the binding was alive
+ *
+ * @return
+ *  - true if the NAT timeout changed
+ *  - false else
+ */
+//--------------------------------------------------------------------------------------------------
+bool natTimeout_ReportAlive
+(
+    natTimeout_Estimator_t* estimatorPtr,   ///< [IN] Learning state
+    uint32_t idleSec                        ///< [IN] Inactivity in seconds
+);
+
+/**
+  * @}
+  */
+
+#endif /* __NAT_TIMEOUT_H__ */
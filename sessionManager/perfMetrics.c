@@ -0,0 +1,260 @@
+/**
+ * @file perfMetrics.c
+ *
+ * Performance metrics: latency histograms and counters
+ *
+ * The metrics are updated from the LwM2MCore thread and can be read from any thread: all the
+ * fields are accessed with relaxed atomic operations, no lock is taken. The durations are measured
+ * with lwm2mcore_TimerGetTimeMs(), so that no new platform adaptor function is needed.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+/* include files */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <lwm2mcore/lwm2mcore.h>
+#include <lwm2mcore/timer.h>
+#include <lwm2mcore/metrics.h>
+#include "perfMetrics.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Latency histograms
+ */
+//--------------------------------------------------------------------------------------------------
+static lwm2mcore_Histogram_t Histograms[LWM2MCORE_METRIC_MAX];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Counters
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t Counters[LWM2MCORE_COUNTER_MAX];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Names of the measured operations
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* MetricNames[LWM2MCORE_METRIC_MAX] =
+{
+    "read",                         // LWM2MCORE_METRIC_READ
+    "write",                        // LWM2MCORE_METRIC_WRITE
+    "execute",                      // LWM2MCORE_METRIC_EXECUTE
+    "discover",                     // LWM2MCORE_METRIC_DISCOVER
+    "dtls_handshake",               // LWM2MCORE_METRIC_DTLS_HANDSHAKE
+    "dtls_resume",                  // LWM2MCORE_METRIC_DTLS_RESUME
+    "registration",                 // LWM2MCORE_METRIC_REGISTRATION
+    "reg_update"                    // LWM2MCORE_METRIC_REG_UPDATE
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the histogram bucket of a duration
+ *
+ * @return
+ *  - Bucket index
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t GetBucket
+(
+    uint64_t durationMs             ///< [IN] Duration in ms
+)
+{
+    uint32_t bucket;
+
+    if (0 == durationMs)
+    {
+        return 0;
+    }
+
+    // Position of the most significant bit, starting at 1
+    bucket = 64 - (uint32_t)__builtin_clzll(durationMs);
+    if (LWM2MCORE_METRIC_BUCKETS <= bucket)
+    {
+        bucket = LWM2MCORE_METRIC_BUCKETS - 1;
+    }
+    return bucket;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record the duration of an operation in its latency histogram
+ *
+ * A null start time means that the start of the operation was not seen: nothing is recorded.
+ */
+//--------------------------------------------------------------------------------------------------
+void perfMetrics_Record
+(
+    lwm2mcore_Metric_t metric,      ///< [IN] Measured operation
+    uint64_t startMs,               ///< [IN] Start time of the operation
+                                    ///< (see lwm2mcore_TimerGetTimeMs)
+    bool isSuccess                  ///< [IN] Set if the operation succeeded
+)
+{
+    lwm2mcore_Histogram_t* histogramPtr;
+    uint64_t nowMs;
+    uint64_t durationMs = 0;
+    uint64_t maxMs;
+
+    if ((LWM2MCORE_METRIC_MAX <= metric) || (0 == startMs))
+    {
+        return;
+    }
+
+    nowMs = lwm2mcore_TimerGetTimeMs();
+    if (nowMs > startMs)
+    {
+        durationMs = nowMs - startMs;
+    }
+
+    histogramPtr = &Histograms[metric];
+    __atomic_fetch_add(&histogramPtr->count, 1, __ATOMIC_RELAXED);
+    if (!isSuccess)
+    {
+        __atomic_fetch_add(&histogramPtr->errorCount, 1, __ATOMIC_RELAXED);
+    }
+    __atomic_fetch_add(&histogramPtr->totalMs, durationMs, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&histogramPtr->buckets[GetBucket(durationMs)], 1, __ATOMIC_RELAXED);
+
+    maxMs = __atomic_load_n(&histogramPtr->maxMs, __ATOMIC_RELAXED);
+    while ((durationMs > maxMs)
+        && (!__atomic_compare_exchange_n(&histogramPtr->maxMs, &maxMs, durationMs, true,
+                                         __ATOMIC_RELAXED, __ATOMIC_RELAXED)))
+    {
+        // maxMs was updated with the current value: try again
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a value to a counter
+ */
+//--------------------------------------------------------------------------------------------------
+void perfMetrics_Add
+(
+    lwm2mcore_Counter_t counter,    ///< [IN] Counter
+    uint64_t value                  ///< [IN] Value to add
+)
+{
+    if (LWM2MCORE_COUNTER_MAX <= counter)
+    {
+        return;
+    }
+
+    __atomic_fetch_add(&Counters[counter], value, __ATOMIC_RELAXED);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the latency histogram of an operation
+ *
+ * @return
+ *  - @ref LWM2MCORE_ERR_COMPLETED_OK on success
+ *  - @ref LWM2MCORE_ERR_INVALID_ARG if a parameter is invalid
+ */
+//--------------------------------------------------------------------------------------------------
+lwm2mcore_Sid_t lwm2mcore_GetHistogram
+(
+    lwm2mcore_Metric_t metric,              ///< [IN] Measured operation
+    lwm2mcore_Histogram_t* histogramPtr     ///< [OUT] Latency histogram
+)
+{
+    uint32_t i;
+
+    if ((LWM2MCORE_METRIC_MAX <= metric) || (!histogramPtr))
+    {
+        return LWM2MCORE_ERR_INVALID_ARG;
+    }
+
+    histogramPtr->count = __atomic_load_n(&Histograms[metric].count, __ATOMIC_RELAXED);
+    histogramPtr->errorCount = __atomic_load_n(&Histograms[metric].errorCount, __ATOMIC_RELAXED);
+    histogramPtr->totalMs = __atomic_load_n(&Histograms[metric].totalMs, __ATOMIC_RELAXED);
+    histogramPtr->maxMs = __atomic_load_n(&Histograms[metric].maxMs, __ATOMIC_RELAXED);
+    for (i = 0; i < LWM2MCORE_METRIC_BUCKETS; i++)
+    {
+        histogramPtr->buckets[i] = __atomic_load_n(&Histograms[metric].buckets[i],
+                                                   __ATOMIC_RELAXED);
+    }
+
+    return LWM2MCORE_ERR_COMPLETED_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the value of a counter
+ *
+ * @return
+ *  - @ref LWM2MCORE_ERR_COMPLETED_OK on success
+ *  - @ref LWM2MCORE_ERR_INVALID_ARG if a parameter is invalid
+ */
+//--------------------------------------------------------------------------------------------------
+lwm2mcore_Sid_t lwm2mcore_GetCounter
+(
+    lwm2mcore_Counter_t counter,            ///< [IN] Counter
+    uint64_t* valuePtr                      ///< [OUT] Counter value
+)
+{
+    if ((LWM2MCORE_COUNTER_MAX <= counter) || (!valuePtr))
+    {
+        return LWM2MCORE_ERR_INVALID_ARG;
+    }
+
+    *valuePtr = __atomic_load_n(&Counters[counter], __ATOMIC_RELAXED);
+    return LWM2MCORE_ERR_COMPLETED_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the name of a measured operation (used in logs and by the diagnostics object)
+ *
+ * @return
+ *  - Operation name
+ *  - @c NULL if the operation is unknown
+ */
+//--------------------------------------------------------------------------------------------------
+const char* lwm2mcore_GetMetricName
+(
+    lwm2mcore_Metric_t metric               ///< [IN] Measured operation
+)
+{
+    if (LWM2MCORE_METRIC_MAX <= metric)
+    {
+        return NULL;
+    }
+    return MetricNames[metric];
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reset all the histograms and counters
+ */
+//--------------------------------------------------------------------------------------------------
+void lwm2mcore_ResetMetrics
+(
+    void
+)
+{
+    uint32_t i;
+    uint32_t j;
+
+    for (i = 0; i < LWM2MCORE_METRIC_MAX; i++)
+    {
+        __atomic_store_n(&Histograms[i].count, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&Histograms[i].errorCount, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&Histograms[i].totalMs, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&Histograms[i].maxMs, 0, __ATOMIC_RELAXED);
+        for (j = 0; j < LWM2MCORE_METRIC_BUCKETS; j++)
+        {
+            __atomic_store_n(&Histograms[i].buckets[j], 0, __ATOMIC_RELAXED);
+        }
+    }
+
+    for (i = 0; i < LWM2MCORE_COUNTER_MAX; i++)
+    {
+        __atomic_store_n(&Counters[i], 0, __ATOMIC_RELAXED);
+    }
+}
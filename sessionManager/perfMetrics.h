@@ -0,0 +1,53 @@
+/**
+ * @file perfMetrics.h
+ *
+ * Performance metrics header file
+ *
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+#ifndef __PERF_METRICS_H__
+#define __PERF_METRICS_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <lwm2mcore/metrics.h>
+
+/**
+  * @addtogroup lwm2mcore_perfMetrics_int
+  * @{
+  */
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Record the duration of an operation in its latency histogram
+ *
+ * A null start time means that the start of the operation was not seen: nothing is recorded.
+ */
+//--------------------------------------------------------------------------------------------------
+void perfMetrics_Record
+(
+    lwm2mcore_Metric_t metric,      ///< [IN] Measured operation
+    uint64_t startMs,               ///< [IN] Start time of the operation
+                                    ///< (see lwm2mcore_TimerGetTimeMs)
+    bool isSuccess                  ///< [IN] Set if the operation succeeded
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Add a value to a counter
+ */
+//--------------------------------------------------------------------------------------------------
+void perfMetrics_Add
+(
+    lwm2mcore_Counter_t counter,    ///< [IN] Counter
+    uint64_t value                  ///< [IN] Value to add
+);
+
+/**
+  * @}
+  */
+
+#endif /* __PERF_METRICS_H__ */
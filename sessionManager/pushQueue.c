@@ -0,0 +1,505 @@
+/**
+ * @file pushQueue.c
+ *
+ * Push queue: pushes waiting for the acknowledgement of the previous one
+ *
+ * Wakaama handles one push at a time. The pushes which are initiated while another one is in
+ * flight are copied in the queue of the client instance, within a memory budget, and sent in
+ * order as the previous pushes are acknowledged. When the budget is exceeded, the queue policy
+ * selects the push which is dropped.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+/* include files */
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <lwm2mcore/lwm2mcore.h>
+#include "pushQueue.h"
+#include "internals.h"
+
+#define LOG_MODULE_LEVEL LWM2MCORE_LOG_SESSION
+#include "coreLog.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * CBOR major type of arrays (RFC 8949), in the initial byte of a data item
+ */
+//--------------------------------------------------------------------------------------------------
+#define CBOR_ARRAY              0x80
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * CBOR additional information: the length is in the next byte
+ */
+//--------------------------------------------------------------------------------------------------
+#define CBOR_LENGTH_UINT8       24
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of payloads in an aggregated CBOR payload (one byte length)
+ */
+//--------------------------------------------------------------------------------------------------
+#define AGGREGATE_MAX_COUNT     UINT8_MAX
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Memory used by a queued push
+ *
+ * @return
+ *  - Size of the entry in bytes
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t EntrySize
+(
+    const pushQueue_Entry_t* entryPtr       ///< [IN] Queued push
+)
+{
+    return sizeof(pushQueue_Entry_t) + entryPtr->len;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allocate a queued push
+ *
+ * @return
+ *  - Queued push, not linked to the queue
+ *  - NULL on memory allocation failure
+ */
+//--------------------------------------------------------------------------------------------------
+static pushQueue_Entry_t* AllocateEntry
+(
+    size_t len,                             ///< [IN] Payload length
+    lwm2mcore_PushContent_t content,        ///< [IN] Content type
+    uint16_t pushCount                      ///< [IN] Number of pushes
+)
+{
+    pushQueue_Entry_t* entryPtr;
+
+    entryPtr = (pushQueue_Entry_t*)lwm2m_malloc(sizeof(pushQueue_Entry_t) + len);
+    if (NULL == entryPtr)
+    {
+        return NULL;
+    }
+
+    entryPtr->nextPtr = NULL;
+    entryPtr->content = content;
+    entryPtr->pushCount = pushCount;
+    entryPtr->mid = 0;
+    entryPtr->len = len;
+    return entryPtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove the newest queued push
+ *
+ * @return
+ *  - Number of removed pushes
+ */
+//--------------------------------------------------------------------------------------------------
+static uint16_t DropTail
+(
+    pushQueue_Queue_t* queuePtr             ///< [IN] Push queue
+)
+{
+    pushQueue_Entry_t* entryPtr = queuePtr->tailPtr;
+    pushQueue_Entry_t* prevPtr = NULL;
+    pushQueue_Entry_t* currentPtr;
+    uint16_t pushCount;
+
+    if (NULL == entryPtr)
+    {
+        return 0;
+    }
+
+    for (currentPtr = queuePtr->headPtr; currentPtr != entryPtr; currentPtr = currentPtr->nextPtr)
+    {
+        prevPtr = currentPtr;
+    }
+
+    if (NULL == prevPtr)
+    {
+        queuePtr->headPtr = NULL;
+    }
+    else
+    {
+        prevPtr->nextPtr = NULL;
+    }
+    queuePtr->tailPtr = prevPtr;
+
+    pushCount = entryPtr->pushCount;
+    queuePtr->usedBytes -= EntrySize(entryPtr);
+    lwm2m_free(entryPtr);
+    return pushCount;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Aggregate the consecutive CBOR payloads at the head of the queue in a CBOR array
+ */
+//--------------------------------------------------------------------------------------------------
+static void AggregateHead
+(
+    pushQueue_Queue_t* queuePtr             ///< [IN] Push queue
+)
+{
+    pushQueue_Entry_t* entryPtr;
+    pushQueue_Entry_t* aggregatePtr;
+    size_t headerLen;
+    size_t len = 0;
+    size_t offset;
+    uint16_t count = 0;
+
+    // Only single pushes are aggregated: an aggregate kept at the head is not nested
+    for (entryPtr = queuePtr->headPtr;
+         (NULL != entryPtr) && (count < AGGREGATE_MAX_COUNT);
+         entryPtr = entryPtr->nextPtr)
+    {
+        if ((LWM2MCORE_PUSH_CONTENT_CBOR != entryPtr->content) || (1 != entryPtr->pushCount)
+         || ((len + entryPtr->len + 2) > LWM2MCORE_PUSH_AGGREGATE_MAX_LEN))
+        {
+            break;
+        }
+        len += entryPtr->len;
+        count++;
+    }
+
+    if (count < 2)
+    {
+        return;
+    }
+
+    headerLen = (count < CBOR_LENGTH_UINT8) ? 1 : 2;
+    aggregatePtr = AllocateEntry(headerLen + len, LWM2MCORE_PUSH_CONTENT_CBOR, count);
+    if (NULL == aggregatePtr)
+    {
+        // The payloads are sent one by one
+        return;
+    }
+
+    if (1 == headerLen)
+    {
+        aggregatePtr->payload[0] = (uint8_t)(CBOR_ARRAY | count);
+    }
+    else
+    {
+        aggregatePtr->payload[0] = CBOR_ARRAY | CBOR_LENGTH_UINT8;
+        aggregatePtr->payload[1] = (uint8_t)count;
+    }
+
+    offset = headerLen;
+    entryPtr = queuePtr->headPtr;
+    while (count--)
+    {
+        pushQueue_Entry_t* nextPtr = entryPtr->nextPtr;
+
+        memcpy(aggregatePtr->payload + offset, entryPtr->payload, entryPtr->len);
+        offset += entryPtr->len;
+        queuePtr->usedBytes -= EntrySize(entryPtr);
+        lwm2m_free(entryPtr);
+        entryPtr = nextPtr;
+    }
+
+    aggregatePtr->nextPtr = entryPtr;
+    queuePtr->headPtr = aggregatePtr;
+    if (NULL == entryPtr)
+    {
+        queuePtr->tailPtr = aggregatePtr;
+    }
+    queuePtr->usedBytes += EntrySize(aggregatePtr);
+
+    LOG_ARG("%u pushes aggregated in %zu bytes", aggregatePtr->pushCount, aggregatePtr->len);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Configure a push queue. The pushes already queued are kept.
+ */
+//--------------------------------------------------------------------------------------------------
+void pushQueue_Configure
+(
+    pushQueue_Queue_t* queuePtr,            ///< [IN] Push queue
+    size_t budget,                          ///< [IN] Memory budget in bytes, 0 to disable
+    lwm2mcore_PushQueuePolicy_t policy,     ///< [IN] Policy when the budget is exceeded
+    bool isAggregated                       ///< [IN] Aggregate the queued CBOR payloads
+)
+{
+    queuePtr->budget = budget;
+    queuePtr->policy = policy;
+    queuePtr->isAggregated = isAggregated;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if a push queue is enabled
+ *
+ * @return
+ *  - true if the queue has a memory budget
+ *  - false else
+ */
+//--------------------------------------------------------------------------------------------------
+bool pushQueue_IsEnabled
+(
+    const pushQueue_Queue_t* queuePtr       ///< [IN] Push queue
+)
+{
+    return (0 != queuePtr->budget);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if a push queue has pushes to send or waiting for their acknowledgement
+ *
+ * @return
+ *  - true if a push is queued or in flight
+ *  - false else
+ */
+//--------------------------------------------------------------------------------------------------
+bool pushQueue_IsBusy
+(
+    const pushQueue_Queue_t* queuePtr       ///< [IN] Push queue
+)
+{
+    return ((NULL != queuePtr->headPtr) || (NULL != queuePtr->inFlightPtr));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copy a push in the queue, applying the queue policy if the budget is exceeded
+ *
+ * @return
+ *  - LWM2MCORE_PUSH_QUEUED if the push is queued
+ *  - LWM2MCORE_PUSH_BUSY if the push does not fit in the budget
+ *  - LWM2MCORE_PUSH_FAILED on memory allocation failure
+ */
+//--------------------------------------------------------------------------------------------------
+lwm2mcore_PushResult_t pushQueue_Add
+(
+    pushQueue_Queue_t* queuePtr,            ///< [IN] Push queue
+    const uint8_t* payloadPtr,              ///< [IN] Payload
+    size_t len,                             ///< [IN] Payload length
+    lwm2mcore_PushContent_t content,        ///< [IN] Content type
+    uint32_t* droppedCountPtr               ///< [OUT] Number of queued pushes dropped to make
+                                            ///<       room for this one
+)
+{
+    pushQueue_Entry_t* entryPtr;
+    size_t size = sizeof(pushQueue_Entry_t) + len;
+    size_t freeable = 0;
+
+    *droppedCountPtr = 0;
+
+    if (queuePtr->usedBytes + size > queuePtr->budget)
+    {
+        // Memory which the policy can release: the push in flight is never dropped
+        switch (queuePtr->policy)
+        {
+            case LWM2MCORE_PUSH_QUEUE_DROP_OLDEST:
+                freeable = queuePtr->usedBytes;
+                if (NULL != queuePtr->inFlightPtr)
+                {
+                    freeable -= EntrySize(queuePtr->inFlightPtr);
+                }
+                break;
+
+            case LWM2MCORE_PUSH_QUEUE_OVERWRITE:
+                if (NULL != queuePtr->tailPtr)
+                {
+                    freeable = EntrySize(queuePtr->tailPtr);
+                }
+                break;
+
+            case LWM2MCORE_PUSH_QUEUE_DROP_NEW:
+            default:
+                break;
+        }
+
+        if ((queuePtr->usedBytes - freeable + size) > queuePtr->budget)
+        {
+            LOG_ARG("Push of %zu bytes exceeds the queue budget", len);
+            return LWM2MCORE_PUSH_BUSY;
+        }
+
+        while ((queuePtr->usedBytes + size) > queuePtr->budget)
+        {
+            if (LWM2MCORE_PUSH_QUEUE_OVERWRITE == queuePtr->policy)
+            {
+                *droppedCountPtr += DropTail(queuePtr);
+            }
+            else
+            {
+                *droppedCountPtr += pushQueue_DropHead(queuePtr);
+            }
+        }
+        LOG_ARG("%u queued pushes dropped", *droppedCountPtr);
+    }
+
+    entryPtr = AllocateEntry(len, content, 1);
+    if (NULL == entryPtr)
+    {
+        LOG_ERR("Unable to allocate a queued push");
+        return LWM2MCORE_PUSH_FAILED;
+    }
+    memcpy(entryPtr->payload, payloadPtr, len);
+
+    if (NULL == queuePtr->tailPtr)
+    {
+        queuePtr->headPtr = entryPtr;
+    }
+    else
+    {
+        queuePtr->tailPtr->nextPtr = entryPtr;
+    }
+    queuePtr->tailPtr = entryPtr;
+    queuePtr->usedBytes += size;
+
+    return LWM2MCORE_PUSH_QUEUED;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the next push to send.
+ *
+ * When the aggregation is enabled, the consecutive CBOR payloads at the head of the queue are
+ * replaced by a single CBOR array of these payloads.
+ *
+ * @return
+ *  - next push to send, kept at the head of the queue
+ *  - NULL if the queue is empty or if a push is in flight
+ */
+//--------------------------------------------------------------------------------------------------
+pushQueue_Entry_t* pushQueue_GetNext
+(
+    pushQueue_Queue_t* queuePtr             ///< [IN] Push queue
+)
+{
+    if (NULL != queuePtr->inFlightPtr)
+    {
+        return NULL;
+    }
+
+    if (queuePtr->isAggregated)
+    {
+        AggregateHead(queuePtr);
+    }
+
+    return queuePtr->headPtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Flag the head of the queue as sent: it waits for its acknowledgement
+ */
+//--------------------------------------------------------------------------------------------------
+void pushQueue_SetInFlight
+(
+    pushQueue_Queue_t* queuePtr,            ///< [IN] Push queue
+    uint16_t mid                            ///< [IN] Message id of the push
+)
+{
+    pushQueue_Entry_t* entryPtr = queuePtr->headPtr;
+
+    if (NULL == entryPtr)
+    {
+        return;
+    }
+
+    queuePtr->headPtr = entryPtr->nextPtr;
+    if (queuePtr->tailPtr == entryPtr)
+    {
+        queuePtr->tailPtr = NULL;
+    }
+
+    entryPtr->nextPtr = NULL;
+    entryPtr->mid = mid;
+    queuePtr->inFlightPtr = entryPtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove the head of the queue, which can not be sent
+ *
+ * @return
+ *  - Number of removed pushes
+ */
+//--------------------------------------------------------------------------------------------------
+uint16_t pushQueue_DropHead
+(
+    pushQueue_Queue_t* queuePtr             ///< [IN] Push queue
+)
+{
+    pushQueue_Entry_t* entryPtr = queuePtr->headPtr;
+    uint16_t pushCount;
+
+    if (NULL == entryPtr)
+    {
+        return 0;
+    }
+
+    queuePtr->headPtr = entryPtr->nextPtr;
+    if (queuePtr->tailPtr == entryPtr)
+    {
+        queuePtr->tailPtr = NULL;
+    }
+
+    pushCount = entryPtr->pushCount;
+    queuePtr->usedBytes -= EntrySize(entryPtr);
+    lwm2m_free(entryPtr);
+    return pushCount;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release the push in flight when its acknowledgement (or timeout) is received
+ *
+ * @return
+ *  - Number of acknowledged pushes
+ *  - 0 if the message id is not the one of the push sent from the queue
+ */
+//--------------------------------------------------------------------------------------------------
+uint16_t pushQueue_Acknowledge
+(
+    pushQueue_Queue_t* queuePtr,            ///< [IN] Push queue
+    uint16_t mid                            ///< [IN] Message id of the acknowledged push
+)
+{
+    pushQueue_Entry_t* entryPtr = queuePtr->inFlightPtr;
+    uint16_t pushCount;
+
+    if ((NULL == entryPtr) || (mid != entryPtr->mid))
+    {
+        return 0;
+    }
+
+    pushCount = entryPtr->pushCount;
+    queuePtr->usedBytes -= EntrySize(entryPtr);
+    queuePtr->inFlightPtr = NULL;
+    lwm2m_free(entryPtr);
+    return pushCount;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove all the pushes of the queue
+ */
+//--------------------------------------------------------------------------------------------------
+void pushQueue_Flush
+(
+    pushQueue_Queue_t* queuePtr             ///< [IN] Push queue
+)
+{
+    while (NULL != queuePtr->headPtr)
+    {
+        pushQueue_DropHead(queuePtr);
+    }
+
+    if (NULL != queuePtr->inFlightPtr)
+    {
+        lwm2m_free(queuePtr->inFlightPtr);
+        queuePtr->inFlightPtr = NULL;
+    }
+    queuePtr->usedBytes = 0;
+}
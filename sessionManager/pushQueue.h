@@ -0,0 +1,210 @@
+/**
+ * @file pushQueue.h
+ *
+ * Push queue header file
+ *
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+#ifndef __PUSH_QUEUE_H__
+#define __PUSH_QUEUE_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <lwm2mcore/lwm2mcore.h>
+
+/**
+  * @addtogroup lwm2mcore_pushQueue_int
+  * @{
+  */
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Default memory budget of the push queue in bytes, 0 to disable the queue
+ */
+//--------------------------------------------------------------------------------------------------
+#ifndef LWM2MCORE_PUSH_QUEUE_BUDGET
+#define LWM2MCORE_PUSH_QUEUE_BUDGET         0
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Maximum length of an aggregated CBOR payload.
+ *
+ * The default value fits in a single CoAP block, so that an aggregated push does not start a
+ * block transfer.
+ */
+//--------------------------------------------------------------------------------------------------
+#ifndef LWM2MCORE_PUSH_AGGREGATE_MAX_LEN
+#define LWM2MCORE_PUSH_AGGREGATE_MAX_LEN    1024
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Queued push
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct _pushQueue_Entry
+{
+    struct _pushQueue_Entry* nextPtr;   ///< Next queued push
+    lwm2mcore_PushContent_t content;    ///< Content type
+    uint16_t pushCount;                 ///< Number of pushes, more than 1 for aggregated payloads
+    uint16_t mid;                       ///< Message id, once sent
+    size_t len;                         ///< Payload length
+    uint8_t payload[];                  ///< Payload
+}pushQueue_Entry_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Push queue of a client instance.
+ *
+ * The structure is embedded in the client instance. It has to be zeroed and configured before
+ * its first use.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    pushQueue_Entry_t* headPtr;         ///< Oldest queued push, next one to send
+    pushQueue_Entry_t* tailPtr;         ///< Newest queued push
+    pushQueue_Entry_t* inFlightPtr;     ///< Push sent from the queue and not yet acknowledged
+    size_t usedBytes;                   ///< Memory used by the queued and in flight pushes
+    size_t budget;                      ///< Memory budget, 0 if the queue is disabled
+    lwm2mcore_PushQueuePolicy_t policy; ///< Policy when the budget is exceeded
+    bool isAggregated;                  ///< Set if the queued CBOR payloads are aggregated
+}pushQueue_Queue_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Configure a push queue. The pushes already queued are kept.
+ */
+//--------------------------------------------------------------------------------------------------
+void pushQueue_Configure
+(
+    pushQueue_Queue_t* queuePtr,            ///< [IN] Push queue
+    size_t budget,                          ///< [IN] Memory budget in bytes, 0 to disable
+    lwm2mcore_PushQueuePolicy_t policy,     ///< [IN] Policy when the budget is exceeded
+    bool isAggregated                       ///< [IN] Aggregate the queued CBOR payloads
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Check if a push queue is enabled
+ *
+ * @return
+ *  - true if the queue has a memory budget
+ *  - false else
+ */
+//--------------------------------------------------------------------------------------------------
+bool pushQueue_IsEnabled
+(
+    const pushQueue_Queue_t* queuePtr       ///< [IN] Push queue
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Check if a push queue has pushes to send or waiting for their acknowledgement
+ *
+ * @return
+ *  - true if a push is queued or in flight
+ *  - false else
+ */
+//--------------------------------------------------------------------------------------------------
+bool pushQueue_IsBusy
+(
+    const pushQueue_Queue_t* queuePtr       ///< [IN] Push queue
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Copy a push in the queue, applying the queue policy if the budget is exceeded
+ *
+ * @return
+ *  - LWM2MCORE_PUSH_QUEUED if the push is queued
+ *  - LWM2MCORE_PUSH_BUSY if the push does not fit in the budget
+ *  - LWM2MCORE_PUSH_FAILED on memory allocation failure
+ */
+//--------------------------------------------------------------------------------------------------
+lwm2mcore_PushResult_t pushQueue_Add
+(
+    pushQueue_Queue_t* queuePtr,            ///< [IN] Push queue
+    const uint8_t* payloadPtr,              ///< [IN] Payload
+    size_t len,                             ///< [IN] Payload length
+    lwm2mcore_PushContent_t content,        ///< [IN] Content type
+    uint32_t* droppedCountPtr               ///< [OUT] Number of queued pushes dropped to make
+                                            ///<       room for this one
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Get the next push to send.
+ *
+ * When the aggregation is enabled, the consecutive CBOR payloads at the head of the queue are
+ * replaced by a single CBOR array of these payloads.
+ *
+ * @return
+ *  - next push to send, kept at the head of the queue
+ *  - NULL if the queue is empty or if a push is in flight
+ */
+//--------------------------------------------------------------------------------------------------
+pushQueue_Entry_t* pushQueue_GetNext
+(
+    pushQueue_Queue_t* queuePtr             ///< [IN] Push queue
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Flag the head of the queue as sent: it waits for its acknowledgement
+ */
+//--------------------------------------------------------------------------------------------------
+void pushQueue_SetInFlight
+(
+    pushQueue_Queue_t* queuePtr,            ///< [IN] Push queue
+    uint16_t mid                            ///< [IN] Message id of the push
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Remove the head of the queue, which can not be sent
+ *
+ * @return
+ *  - Number of removed pushes
+ */
+//--------------------------------------------------------------------------------------------------
+uint16_t pushQueue_DropHead
+(
+    pushQueue_Queue_t* queuePtr             ///< [IN] Push queue
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Release the push in flight when its acknowledgement (or timeout) is received
+ *
+ * @return
+ *  - Number of acknowledged pushes
+ *  - 0 if the message id is not the one of the push sent from the queue
+ */
+//--------------------------------------------------------------------------------------------------
+uint16_t pushQueue_Acknowledge
+(
+    pushQueue_Queue_t* queuePtr,            ///< [IN] Push queue
+    uint16_t mid                            ///< [IN] Message id of the acknowledged push
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Remove all the pushes of the queue
+ */
+//--------------------------------------------------------------------------------------------------
+void pushQueue_Flush
+(
+    pushQueue_Queue_t* queuePtr             ///< [IN] Push queue
+);
+
+/**
+  * @}
+  */
+
+#endif /* __PUSH_QUEUE_H__ */
@@ -0,0 +1,257 @@
+/**
+ * @file pushStream.c
+ *
+ * Streamed push: payload read block by block from a callback or from scattered buffers
+ *
+ * Only one block of the payload is in memory. One more byte is read ahead, so that the last block
+ * is known when it is sent (CoAP Block1 "more" flag) without knowing the payload length.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+/* include files */
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <lwm2mcore/lwm2mcore.h>
+#include "pushStream.h"
+#include "internals.h"
+
+#define LOG_MODULE_LEVEL LWM2MCORE_LOG_SESSION
+#include "coreLog.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Payload reader of the scattered payloads
+ *
+ * @return
+ *  - LWM2MCORE_ERR_COMPLETED_OK
+ */
+//--------------------------------------------------------------------------------------------------
+static lwm2mcore_Sid_t IovecReader
+(
+    void* contextPtr,                       ///< [IN] Streamed push
+    uint8_t* bufferPtr,                     ///< [OUT] Buffer
+    size_t* lenPtr                          ///< [INOUT] Buffer length, number of copied bytes
+)
+{
+    pushStream_Stream_t* streamPtr = (pushStream_Stream_t*)contextPtr;
+    size_t len = 0;
+
+    while ((len < *lenPtr) && (streamPtr->iovIndex < streamPtr->iovCount))
+    {
+        const lwm2mcore_PushIovec_t* iovPtr = &(streamPtr->iovPtr[streamPtr->iovIndex]);
+        size_t partLen = iovPtr->len - streamPtr->iovOffset;
+
+        if (partLen > (*lenPtr - len))
+        {
+            partLen = *lenPtr - len;
+        }
+        // An empty part may have no buffer
+        if (0 != partLen)
+        {
+            memcpy(bufferPtr + len, iovPtr->basePtr + streamPtr->iovOffset, partLen);
+            len += partLen;
+            streamPtr->iovOffset += partLen;
+        }
+
+        if (streamPtr->iovOffset >= iovPtr->len)
+        {
+            streamPtr->iovIndex++;
+            streamPtr->iovOffset = 0;
+        }
+    }
+
+    *lenPtr = len;
+    return LWM2MCORE_ERR_COMPLETED_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start a streamed push read from a callback
+ *
+ * @return
+ *  - true on success
+ *  - false if a streamed push is in progress or on memory allocation failure
+ */
+//--------------------------------------------------------------------------------------------------
+bool pushStream_Start
+(
+    pushStream_Stream_t* streamPtr,         ///< [IN] Streamed push
+    lwm2mcore_PushReader_t readerCb,        ///< [IN] Payload reader
+    void* contextPtr,                       ///< [IN] Context given to the payload reader
+    lwm2mcore_PushContent_t content         ///< [IN] Content type
+)
+{
+    if (streamPtr->isActive)
+    {
+        return false;
+    }
+
+    streamPtr->blockPtr = (uint8_t*)lwm2m_malloc(LWM2MCORE_PUSH_BLOCK_SIZE + 1);
+    if (NULL == streamPtr->blockPtr)
+    {
+        LOG_ERR("Unable to allocate the push block");
+        return false;
+    }
+
+    streamPtr->isActive = true;
+    streamPtr->isMore = false;
+    streamPtr->isBlockPending = false;
+    streamPtr->content = content;
+    streamPtr->readerCb = readerCb;
+    streamPtr->readerContextPtr = contextPtr;
+    streamPtr->blockNum = 0;
+    streamPtr->blockSize = LWM2MCORE_PUSH_BLOCK_SIZE;
+    streamPtr->mid = 0;
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start a streamed push of a scattered payload
+ *
+ * @return
+ *  - true on success
+ *  - false if a streamed push is in progress or on memory allocation failure
+ */
+//--------------------------------------------------------------------------------------------------
+bool pushStream_StartIovec
+(
+    pushStream_Stream_t* streamPtr,         ///< [IN] Streamed push
+    const lwm2mcore_PushIovec_t* iovPtr,    ///< [IN] Payload parts
+    size_t iovCount,                        ///< [IN] Number of payload parts
+    lwm2mcore_PushContent_t content         ///< [IN] Content type
+)
+{
+    if (!pushStream_Start(streamPtr, IovecReader, streamPtr, content))
+    {
+        return false;
+    }
+
+    streamPtr->iovPtr = iovPtr;
+    streamPtr->iovCount = iovCount;
+    streamPtr->iovIndex = 0;
+    streamPtr->iovOffset = 0;
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the next block of a streamed push in the block buffer
+ *
+ * The number of the block is set in blockNum and the isMore flag is set if other blocks follow.
+ *
+ * @return
+ *  - true on success
+ *  - false if the payload reader failed
+ */
+//--------------------------------------------------------------------------------------------------
+bool pushStream_ReadBlock
+(
+    pushStream_Stream_t* streamPtr,         ///< [IN] Streamed push
+    size_t* lenPtr                          ///< [OUT] Block length
+)
+{
+    size_t len = 0;
+
+    if ((!streamPtr->isActive) || (NULL == streamPtr->blockPtr))
+    {
+        return false;
+    }
+
+    // The byte read ahead starts the next block
+    if (streamPtr->isMore)
+    {
+        streamPtr->blockPtr[0] = streamPtr->blockPtr[streamPtr->blockSize];
+        streamPtr->blockNum++;
+        len = 1;
+    }
+
+    while (len < ((size_t)streamPtr->blockSize + 1))
+    {
+        size_t readLen = (size_t)streamPtr->blockSize + 1 - len;
+
+        if (LWM2MCORE_ERR_COMPLETED_OK != streamPtr->readerCb(streamPtr->readerContextPtr,
+                                                              streamPtr->blockPtr + len,
+                                                              &readLen))
+        {
+            LOG_ERR("Push payload reader failed");
+            return false;
+        }
+
+        if (0 == readLen)
+        {
+            break;
+        }
+        len += readLen;
+    }
+
+    streamPtr->isMore = (len > streamPtr->blockSize);
+    *lenPtr = streamPtr->isMore ? streamPtr->blockSize : len;
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Change the block size of the next read blocks
+ *
+ * The number of the next block is computed again from its offset (RFC 7959, section 2.2). A
+ * larger block size is only applied when the offset of the next block is one of its multiples.
+ *
+ * @return
+ *  - true if the block size is applied
+ *  - false else
+ */
+//--------------------------------------------------------------------------------------------------
+bool pushStream_SetBlockSize
+(
+    pushStream_Stream_t* streamPtr,         ///< [IN] Streamed push
+    uint16_t blockSize                      ///< [IN] Block size, power of 2 from 16, capped to
+                                            ///< LWM2MCORE_PUSH_BLOCK_SIZE
+)
+{
+    uint32_t offset;
+
+    if (16 > blockSize)
+    {
+        return false;
+    }
+    if (LWM2MCORE_PUSH_BLOCK_SIZE < blockSize)
+    {
+        blockSize = LWM2MCORE_PUSH_BLOCK_SIZE;
+    }
+
+    if ((streamPtr->isMore) && (blockSize != streamPtr->blockSize))
+    {
+        // Offset of the next block, which starts with the byte read ahead
+        offset = (streamPtr->blockNum + 1) * streamPtr->blockSize;
+        if (0 != (offset % blockSize))
+        {
+            return false;
+        }
+        streamPtr->blockPtr[blockSize] = streamPtr->blockPtr[streamPtr->blockSize];
+        streamPtr->blockNum = (offset / blockSize) - 1;
+    }
+
+    streamPtr->blockSize = blockSize;
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * End a streamed push and release its block buffer
+ */
+//--------------------------------------------------------------------------------------------------
+void pushStream_Stop
+(
+    pushStream_Stream_t* streamPtr          ///< [IN] Streamed push
+)
+{
+    if (NULL != streamPtr->blockPtr)
+    {
+        lwm2m_free(streamPtr->blockPtr);
+    }
+    memset(streamPtr, 0, sizeof(pushStream_Stream_t));
+}
@@ -0,0 +1,158 @@
+/**
+ * @file pushStream.h
+ *
+ * Streamed push header file
+ *
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+#ifndef __PUSH_STREAM_H__
+#define __PUSH_STREAM_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <lwm2mcore/lwm2mcore.h>
+
+/**
+  * @addtogroup lwm2mcore_pushStream_int
+  * @{
+  */
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Maximum block size of the streamed pushes: power of 2 from 16 to 1024 (CoAP Block1
+ * option)
+ */
+//--------------------------------------------------------------------------------------------------
+#ifndef LWM2MCORE_PUSH_BLOCK_SIZE
+#define LWM2MCORE_PUSH_BLOCK_SIZE       1024
+#endif
+
+#if (LWM2MCORE_PUSH_BLOCK_SIZE < 16) || (LWM2MCORE_PUSH_BLOCK_SIZE > 1024) \
+ || (LWM2MCORE_PUSH_BLOCK_SIZE & (LWM2MCORE_PUSH_BLOCK_SIZE - 1))
+#error "LWM2MCORE_PUSH_BLOCK_SIZE has to be a power of 2 from 16 to 1024"
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief URI path of the streamed pushes
+ */
+//--------------------------------------------------------------------------------------------------
+#ifndef LWM2MCORE_PUSH_STREAM_URI
+#define LWM2MCORE_PUSH_STREAM_URI       "/push"
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Streamed push of a client instance.
+ *
+ * The structure is embedded in the client instance. It has to be zeroed before its first use.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    bool isActive;                          ///< Set if a streamed push is in progress
+    bool isMore;                            ///< Set if the last read block is not the last one
+    bool isBlockPending;                    ///< Set if the next block waits for the step
+    lwm2mcore_PushContent_t content;        ///< Content type
+    lwm2mcore_PushReader_t readerCb;        ///< Payload reader
+    void* readerContextPtr;                 ///< Context given to the payload reader
+    const lwm2mcore_PushIovec_t* iovPtr;    ///< Payload parts, for lwm2mcore_PushIovec()
+    size_t iovCount;                        ///< Number of payload parts
+    size_t iovIndex;                        ///< Current payload part
+    size_t iovOffset;                       ///< Offset in the current payload part
+    uint8_t* blockPtr;                      ///< Block buffer, followed by one byte read ahead to
+                                            ///< detect the last block
+    uint32_t blockNum;                      ///< Number of the last read block
+    uint16_t blockSize;                     ///< Block size of the next read blocks
+    uint16_t mid;                           ///< Message id of the first block
+}pushStream_Stream_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Start a streamed push read from a callback
+ *
+ * @return
+ *  - true on success
+ *  - false if a streamed push is in progress or on memory allocation failure
+ */
+//--------------------------------------------------------------------------------------------------
+bool pushStream_Start
+(
+    pushStream_Stream_t* streamPtr,         ///< [IN] Streamed push
+    lwm2mcore_PushReader_t readerCb,        ///< [IN] Payload reader
+    void* contextPtr,                       ///< [IN] Context given to the payload reader
+    lwm2mcore_PushContent_t content         ///< [IN] Content type
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Start a streamed push of a scattered payload
+ *
+ * @return
+ *  - true on success
+ *  - false if a streamed push is in progress or on memory allocation failure
+ */
+//--------------------------------------------------------------------------------------------------
+bool pushStream_StartIovec
+(
+    pushStream_Stream_t* streamPtr,         ///< [IN] Streamed push
+    const lwm2mcore_PushIovec_t* iovPtr,    ///< [IN] Payload parts
+    size_t iovCount,                        ///< [IN] Number of payload parts
+    lwm2mcore_PushContent_t content         ///< [IN] Content type
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Read the next block of a streamed push in the block buffer
+ *
+ * The number of the block is set in blockNum and the isMore flag is set if other blocks follow.
+ *
+ * @return
+ *  - true on success
+ *  - false if the payload reader failed
+ */
+//--------------------------------------------------------------------------------------------------
+bool pushStream_ReadBlock
+(
+    pushStream_Stream_t* streamPtr,         ///< [IN] Streamed push
+    size_t* lenPtr                          ///< [OUT] Block length
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Change the block size of the next read blocks
+ *
+ * The number of the next block is computed again from its offset (RFC 7959, section 2.2). A
+ * larger block size is only applied when the offset of the next block is one of its multiples.
+ *
+ * @return
+ *  - true if the block size is applied
+ *  - false else
+ */
+//--------------------------------------------------------------------------------------------------
+bool pushStream_SetBlockSize
+(
+    pushStream_Stream_t* streamPtr,         ///< [IN] Streamed push
+    uint16_t blockSize                      ///< [IN] Block size, power of 2 from 16, capped to
+                                            ///< LWM2MCORE_PUSH_BLOCK_SIZE
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief End a streamed push and release its block buffer
+ */
+//--------------------------------------------------------------------------------------------------
+void pushStream_Stop
+(
+    pushStream_Stream_t* streamPtr          ///< [IN] Streamed push
+);
+
+/**
+  * @}
+  */
+
+#endif /* __PUSH_STREAM_H__ */
@@ -13,8 +13,13 @@
 
 #include <lwm2mcore/lwm2mcore.h>
 #include <lwm2mcore/coapHandlers.h>
+#include <lwm2mcore/socket.h>
 #include "objects.h"
 #include "dtlsConnection.h"
+#include "timerWheel.h"
+#include "perfMetrics.h"
+#include "pushQueue.h"
+#include "pushStream.h"
 
 /**
   * @addtogroup lwm2mcore_sessionManager_int
@@ -23,15 +28,27 @@
 
 //--------------------------------------------------------------------------------------------------
 /**
- * @brief Structure for LWM2M core context
+ * @brief Structure for LWM2M core context: object manager state of a client instance
  */
 //--------------------------------------------------------------------------------------------------
 typedef struct
 {
     struct _lwm2mcore_objectsList objects_list;     ///< list of supported objects
+    lwm2mcore_objectsIndex_t      objects_index;    ///< lookup index on objects_list
+    lwm2m_object_t*               objectArray[OBJ_COUNT]; ///< Objects registered in Wakaama
+    uint16_t                      registeredObjNb;  ///< Number of objects registered in Wakaama
+    uint32_t                      deferredNotificationCount; ///< Number of resource changes
+                                                    ///< deferred by their minimum period
 }lwm2mcore_context_t;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Maximum number of distinct resource changes batched before a notification flush
+ */
+//--------------------------------------------------------------------------------------------------
+#define SMANAGER_NOTIFY_BATCH_MAX   32
+
 //--------------------------------------------------------------------------------------------------
 /**
  * @brief Structure to be used by the client
@@ -49,6 +66,24 @@ typedef struct
     uint16_t serverId;                      ///< Server ID (MAX_UINT16 for all servers)
     bool isEdmEnabled;                      ///< Flag specifying whether Extended Device
                                             ///<   Management (EDM) is enabled
+    lwm2mcore_SocketConfig_t socketConfig;  ///< LwM2M socket configuration
+    lwm2mcore_StatusCb_t statusCb;          ///< Event callback
+    bool isBootstrapSession;                ///< Set if connected to a bootstrap server
+#ifdef LWM2M_BOOTSTRAP
+    lwm2m_client_state_t previousState;     ///< Client state bootstrapping / registered etc.
+#endif
+    dtls_Instance_t dtls;                   ///< DTLS state
+    timerWheel_Timer_t stepTimer;           ///< Timer of the LwM2M client step
+    timerWheel_Timer_t inactivityTimer;     ///< Session inactivity timer
+    uint32_t notifyWindowMs;                ///< Batching window of resource change notifications
+    bool isNotifyFlushScheduled;            ///< Set if the step which flushes the batch is armed
+    timerWheel_Timer_t notifyTimer;         ///< Timer of the batching window
+    uint16_t notifyBatchCount;              ///< Number of batched resource changes
+    lwm2m_uri_t notifyBatch[SMANAGER_NOTIFY_BATCH_MAX]; ///< Batched resource changes
+    uint64_t metricStartMs[LWM2MCORE_METRIC_MAX];   ///< Start time of the measured operations in
+                                                    ///< progress, 0 if none
+    pushQueue_Queue_t pushQueue;            ///< Pushes waiting for the previous ones
+    pushStream_Stream_t pushStream;         ///< Streamed push in progress
 }smanager_ClientData_t;
 
 //--------------------------------------------------------------------------------------------------
@@ -84,6 +119,20 @@ typedef enum
     EVENT_TYPE_MAX = 0xFF,      ///< Internal usage
 }smanager_EventType_t;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Select the client instance on which the functions without instance reference apply
+ *
+ * The session manager selects the instance on each entry point (API call with an instance
+ * reference, timer expiry, received datagram). The platform adaptor functions without instance
+ * reference are therefore called in the context of the right instance.
+ */
+//--------------------------------------------------------------------------------------------------
+void smanager_SelectInstance
+(
+    lwm2mcore_Ref_t instanceRef     ///< [IN] Instance reference, NULL to unselect
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * @brief Function to send status event to the application, using the callback stored in the
@@ -107,6 +156,18 @@ void smanager_SendSessionEvent
     void*                   contextPtr      ///< [IN] Context
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Function to record the start of a measured operation of the selected instance
+ *
+ * The duration is recorded when the matching session event reports the end of the operation.
+ */
+//--------------------------------------------------------------------------------------------------
+void smanager_StartMetric
+(
+    lwm2mcore_Metric_t metric       ///< [IN] Measured operation
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * @brief Function to check if the client is connected to a bootstrap server
@@ -0,0 +1,523 @@
+/**
+ * @file timerWheel.c
+ *
+ * Timer wheel: any number of ms deadlines driven by a single platform timer
+ *
+ * The timers are hashed in TIMER_WHEEL_SLOTS slots of TIMER_WHEEL_TICK_MS according to their
+ * deadline. A deadline beyond one revolution of the wheel stays in its slot until the wheel
+ * reaches it again. The LWM2MCORE_TIMER_WHEEL platform timer is armed on the nearest deadline.
+ *
+ * With LWM2MCORE_TIMER_EVENT_LOOP, the timer adaptor functions are implemented on the wheel and
+ * the client event loop drives it through lwm2mcore_GetNextDeadline() and
+ * lwm2mcore_ProcessTimers().
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+/* include files */
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <lwm2mcore/lwm2mcore.h>
+#include <lwm2mcore/timer.h>
+#include "timerWheel.h"
+#include "internals.h"
+
+#define LOG_MODULE_LEVEL LWM2MCORE_LOG_SESSION
+#include "coreLog.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Slots of the timer wheel
+ */
+//--------------------------------------------------------------------------------------------------
+static timerWheel_Timer_t* WheelSlots[TIMER_WHEEL_SLOTS];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of running timers
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t RunningCount = 0;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Last tick processed by timerWheel_Process()
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t ProcessedTick = 0;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of timerWheel_Process() passes
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t ProcessPass = 0;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Insert a timer in its wheel slot
+ */
+//--------------------------------------------------------------------------------------------------
+static void InsertTimer
+(
+    timerWheel_Timer_t* timerPtr    ///< [IN] Timer
+)
+{
+    uint32_t slot = (uint32_t)((timerPtr->deadlineMs / TIMER_WHEEL_TICK_MS) % TIMER_WHEEL_SLOTS);
+
+    timerPtr->prevPtr = NULL;
+    timerPtr->nextPtr = WheelSlots[slot];
+    if (NULL != WheelSlots[slot])
+    {
+        WheelSlots[slot]->prevPtr = timerPtr;
+    }
+    WheelSlots[slot] = timerPtr;
+    timerPtr->isRunning = true;
+    RunningCount++;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove a timer from its wheel slot
+ */
+//--------------------------------------------------------------------------------------------------
+static void RemoveTimer
+(
+    timerWheel_Timer_t* timerPtr    ///< [IN] Timer
+)
+{
+    uint32_t slot = (uint32_t)((timerPtr->deadlineMs / TIMER_WHEEL_TICK_MS) % TIMER_WHEEL_SLOTS);
+
+    if (NULL != timerPtr->prevPtr)
+    {
+        timerPtr->prevPtr->nextPtr = timerPtr->nextPtr;
+    }
+    else
+    {
+        WheelSlots[slot] = timerPtr->nextPtr;
+    }
+    if (NULL != timerPtr->nextPtr)
+    {
+        timerPtr->nextPtr->prevPtr = timerPtr->prevPtr;
+    }
+    timerPtr->nextPtr = NULL;
+    timerPtr->prevPtr = NULL;
+    timerPtr->isRunning = false;
+    RunningCount--;
+}
+
+#ifndef LWM2MCORE_TIMER_EVENT_LOOP
+//--------------------------------------------------------------------------------------------------
+/**
+ * Deadline on which the platform timer is armed, UINT64_MAX if it is not armed
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t ArmedDeadlineMs = UINT64_MAX;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Platform timer expiry: process the wheel and arm the platform timer on the next deadline
+ */
+//--------------------------------------------------------------------------------------------------
+static void WheelTimerHandler
+(
+    void
+)
+{
+    ArmedDeadlineMs = UINT64_MAX;
+    timerWheel_Process();
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Arm the platform timer if a deadline is nearer than the armed one
+ */
+//--------------------------------------------------------------------------------------------------
+static void ArmPlatformTimer
+(
+    uint64_t nowMs,         ///< [IN] Current time
+    uint32_t delayMs        ///< [IN] Delay until the next deadline
+)
+{
+    if ((UINT32_MAX == delayMs) || ((nowMs + delayMs) >= ArmedDeadlineMs))
+    {
+        return;
+    }
+
+    if (!lwm2mcore_TimerSetMs(LWM2MCORE_TIMER_WHEEL, delayMs, WheelTimerHandler))
+    {
+        LOG("ERROR to launch the timer wheel");
+        return;
+    }
+    ArmedDeadlineMs = nowMs + delayMs;
+}
+#else
+//--------------------------------------------------------------------------------------------------
+/**
+ * The client event loop waits for the next deadline: no platform timer is armed
+ */
+//--------------------------------------------------------------------------------------------------
+static void ArmPlatformTimer
+(
+    uint64_t nowMs,         ///< [IN] Current time
+    uint32_t delayMs        ///< [IN] Delay until the next deadline
+)
+{
+    (void)nowMs;
+    (void)delayMs;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Timers used in place of the platform timers
+ */
+//--------------------------------------------------------------------------------------------------
+static timerWheel_Timer_t PlatformTimers[LWM2MCORE_TIMER_MAX];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Callbacks of the timers used in place of the platform timers
+ */
+//--------------------------------------------------------------------------------------------------
+static lwm2mcore_TimerCallback_t PlatformTimerCbs[LWM2MCORE_TIMER_MAX];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Expiry of a timer used in place of a platform timer
+ */
+//--------------------------------------------------------------------------------------------------
+static void PlatformTimerHandler
+(
+    void* contextPtr                ///< [IN] Timer Id
+)
+{
+    lwm2mcore_TimerType_t timer = (lwm2mcore_TimerType_t)(intptr_t)contextPtr;
+
+    if (NULL != PlatformTimerCbs[timer])
+    {
+        PlatformTimerCbs[timer]();
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Timer start, implemented on the timer wheel
+ *
+ * @return
+ *  - true  on success
+ *  - false on failure
+ */
+//--------------------------------------------------------------------------------------------------
+bool lwm2mcore_TimerSet
+(
+    lwm2mcore_TimerType_t timer,    ///< [IN] Timer Id
+    uint32_t time,                  ///< [IN] Timer value in seconds
+    lwm2mcore_TimerCallback_t cb    ///< [IN] Timer callback
+)
+{
+    return lwm2mcore_TimerSetMs(timer, time * 1000, cb);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Timer start with a ms resolution, implemented on the timer wheel
+ *
+ * @return
+ *  - true  on success
+ *  - false on failure
+ */
+//--------------------------------------------------------------------------------------------------
+bool lwm2mcore_TimerSetMs
+(
+    lwm2mcore_TimerType_t timer,    ///< [IN] Timer Id
+    uint32_t timeMs,                ///< [IN] Timer value in ms
+    lwm2mcore_TimerCallback_t cb    ///< [IN] Timer callback
+)
+{
+    if ((LWM2MCORE_TIMER_MAX <= timer) || (NULL == cb))
+    {
+        return false;
+    }
+
+    PlatformTimerCbs[timer] = cb;
+    timerWheel_Start(&PlatformTimers[timer], timeMs, PlatformTimerHandler, (void*)(intptr_t)timer);
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Timer stop, implemented on the timer wheel
+ *
+ * @return
+ *  - true  on success
+ *  - false on failure
+ */
+//--------------------------------------------------------------------------------------------------
+bool lwm2mcore_TimerStop
+(
+    lwm2mcore_TimerType_t timer     ///< [IN] Timer Id
+)
+{
+    if (LWM2MCORE_TIMER_MAX <= timer)
+    {
+        return false;
+    }
+
+    timerWheel_Stop(&PlatformTimers[timer]);
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Timer state, implemented on the timer wheel
+ *
+ * @return
+ *  - true  if the timer is running
+ *  - false if the timer is stopped
+ */
+//--------------------------------------------------------------------------------------------------
+bool lwm2mcore_TimerIsRunning
+(
+    lwm2mcore_TimerType_t timer     ///< [IN] Timer Id
+)
+{
+    if (LWM2MCORE_TIMER_MAX <= timer)
+    {
+        return false;
+    }
+
+    return timerWheel_IsRunning(&PlatformTimers[timer]);
+}
+#endif /* LWM2MCORE_TIMER_EVENT_LOOP */
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start (or restart) a timer of the wheel
+ */
+//--------------------------------------------------------------------------------------------------
+void timerWheel_Start
+(
+    timerWheel_Timer_t* timerPtr,   ///< [IN] Timer
+    uint32_t delayMs,               ///< [IN] Delay before the expiry in ms
+    timerWheel_Callback_t cb,       ///< [IN] Expiry callback
+    void* contextPtr                ///< [IN] Context given to the expiry callback
+)
+{
+    uint64_t nowMs;
+
+    if ((NULL == timerPtr) || (NULL == cb))
+    {
+        return;
+    }
+
+    if (timerPtr->isRunning)
+    {
+        RemoveTimer(timerPtr);
+    }
+
+    nowMs = lwm2mcore_TimerGetTimeMs();
+    if (0 == RunningCount)
+    {
+        ProcessedTick = nowMs / TIMER_WHEEL_TICK_MS;
+    }
+
+    timerPtr->deadlineMs = nowMs + delayMs;
+    timerPtr->cb = cb;
+    timerPtr->contextPtr = contextPtr;
+    timerPtr->startPass = ProcessPass;
+    InsertTimer(timerPtr);
+
+    ArmPlatformTimer(nowMs, delayMs);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stop a timer of the wheel.
+ *
+ * The platform timer is not stopped: its expiry only processes the wheel.
+ */
+//--------------------------------------------------------------------------------------------------
+void timerWheel_Stop
+(
+    timerWheel_Timer_t* timerPtr    ///< [IN] Timer
+)
+{
+    if ((NULL != timerPtr) && (timerPtr->isRunning))
+    {
+        RemoveTimer(timerPtr);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if a timer of the wheel is running
+ *
+ * @return
+ *  - @c true if the timer is running
+ *  - @c false otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+bool timerWheel_IsRunning
+(
+    const timerWheel_Timer_t* timerPtr  ///< [IN] Timer
+)
+{
+    return ((NULL != timerPtr) && (timerPtr->isRunning));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the delay until the next expiry of a timer of the wheel
+ *
+ * @return
+ *  - Delay in ms (0 if a timer already expired)
+ *  - UINT32_MAX if no timer is running
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t timerWheel_GetNextDelay
+(
+    void
+)
+{
+    timerWheel_Timer_t* timerPtr;
+    uint64_t nowMs;
+    uint64_t nextMs = UINT64_MAX;
+    uint32_t i;
+
+    if (0 == RunningCount)
+    {
+        return UINT32_MAX;
+    }
+
+    nowMs = lwm2mcore_TimerGetTimeMs();
+
+    /* Walk one revolution from the last processed slot, so that the expired timers which are not
+     * processed yet are found: the first slot holding a deadline of this revolution holds the
+     * nearest one */
+    for (i = 0; (i < TIMER_WHEEL_SLOTS) && (UINT64_MAX == nextMs); i++)
+    {
+        for (timerPtr = WheelSlots[(ProcessedTick + i) % TIMER_WHEEL_SLOTS];
+             timerPtr;
+             timerPtr = timerPtr->nextPtr)
+        {
+            if (   ((timerPtr->deadlineMs / TIMER_WHEEL_TICK_MS) <= (ProcessedTick + i))
+                && (timerPtr->deadlineMs < nextMs))
+            {
+                nextMs = timerPtr->deadlineMs;
+            }
+        }
+    }
+
+    /* All the deadlines are beyond one revolution */
+    if (UINT64_MAX == nextMs)
+    {
+        for (i = 0; i < TIMER_WHEEL_SLOTS; i++)
+        {
+            for (timerPtr = WheelSlots[i]; timerPtr; timerPtr = timerPtr->nextPtr)
+            {
+                if (timerPtr->deadlineMs < nextMs)
+                {
+                    nextMs = timerPtr->deadlineMs;
+                }
+            }
+        }
+    }
+
+    if (nextMs <= nowMs)
+    {
+        return 0;
+    }
+    if ((nextMs - nowMs) >= UINT32_MAX)
+    {
+        return UINT32_MAX - 1;
+    }
+    return (uint32_t)(nextMs - nowMs);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Call the callbacks of the expired timers of the wheel
+ */
+//--------------------------------------------------------------------------------------------------
+void timerWheel_Process
+(
+    void
+)
+{
+    timerWheel_Timer_t* timerPtr;
+    uint64_t nowMs;
+    uint64_t nowTick;
+    uint64_t tick;
+    uint32_t pass;
+
+    if (0 == RunningCount)
+    {
+        return;
+    }
+
+    nowMs = lwm2mcore_TimerGetTimeMs();
+    nowTick = nowMs / TIMER_WHEEL_TICK_MS;
+    pass = ++ProcessPass;
+
+    /* Visit the slots since the last processed tick, at most one revolution */
+    tick = ProcessedTick;
+    if ((nowTick - tick) >= TIMER_WHEEL_SLOTS)
+    {
+        tick = nowTick - (TIMER_WHEEL_SLOTS - 1);
+    }
+
+    for (; tick <= nowTick; tick++)
+    {
+        timerPtr = WheelSlots[tick % TIMER_WHEEL_SLOTS];
+        while (NULL != timerPtr)
+        {
+            /* The timers started by the callbacks of this pass expire at the next one */
+            if ((timerPtr->deadlineMs > nowMs) || (pass == timerPtr->startPass))
+            {
+                timerPtr = timerPtr->nextPtr;
+                continue;
+            }
+
+            /* One timer at a time: the callback may start or stop any timer, the slot is
+             * scanned again once it returns */
+            RemoveTimer(timerPtr);
+            timerPtr->cb(timerPtr->contextPtr);
+            timerPtr = WheelSlots[tick % TIMER_WHEEL_SLOTS];
+        }
+    }
+    ProcessedTick = nowTick;
+
+    ArmPlatformTimer(lwm2mcore_TimerGetTimeMs(), timerWheel_GetNextDelay());
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function to get the delay until the next LwM2MCore timer expiry
+ *
+ * @return
+ *  - Delay in ms (0 if a timer already expired)
+ *  - UINT32_MAX if no timer is running
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t lwm2mcore_GetNextDeadline
+(
+    void
+)
+{
+    return timerWheel_GetNextDelay();
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function to treat the expired LwM2MCore timers
+ */
+//--------------------------------------------------------------------------------------------------
+void lwm2mcore_ProcessTimers
+(
+    void
+)
+{
+    timerWheel_Process();
+}
@@ -0,0 +1,132 @@
+/**
+ * @file timerWheel.h
+ *
+ * Timer wheel header file
+ *
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+#ifndef __TIMER_WHEEL_H__
+#define __TIMER_WHEEL_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+  * @addtogroup lwm2mcore_timerwheel_int
+  * @{
+  */
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Number of slots of the timer wheel
+ */
+//--------------------------------------------------------------------------------------------------
+#define TIMER_WHEEL_SLOTS       64
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Duration of a timer wheel slot in ms
+ */
+//--------------------------------------------------------------------------------------------------
+#define TIMER_WHEEL_TICK_MS     10
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Callback when a timer of the wheel expires
+ */
+//--------------------------------------------------------------------------------------------------
+typedef void (*timerWheel_Callback_t)
+(
+    void* contextPtr                ///< [IN] Context given when the timer was started
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Timer of the wheel.
+ *
+ * The structure is owned by the caller (it is usually embedded in the structure of the module
+ * which needs a deadline), so that the number of timers is not bounded. It has to be zeroed before
+ * its first use.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct _timerWheel_Timer
+{
+    struct _timerWheel_Timer* nextPtr;  ///< Next timer in the wheel slot
+    struct _timerWheel_Timer* prevPtr;  ///< Previous timer in the wheel slot
+    uint64_t deadlineMs;                ///< Expiry time (see lwm2mcore_TimerGetTimeMs)
+    timerWheel_Callback_t cb;           ///< Expiry callback
+    void* contextPtr;                   ///< Context given to the expiry callback
+    uint32_t startPass;                 ///< timerWheel_Process() pass in which the timer was
+                                        ///< started
+    bool isRunning;                     ///< Set if the timer is in the wheel
+}timerWheel_Timer_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Start (or restart) a timer of the wheel
+ */
+//--------------------------------------------------------------------------------------------------
+void timerWheel_Start
+(
+    timerWheel_Timer_t* timerPtr,   ///< [IN] Timer
+    uint32_t delayMs,               ///< [IN] Delay before the expiry in ms
+    timerWheel_Callback_t cb,       ///< [IN] Expiry callback
+    void* contextPtr                ///< [IN] Context given to the expiry callback
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Stop a timer of the wheel
+ */
+//--------------------------------------------------------------------------------------------------
+void timerWheel_Stop
+(
+    timerWheel_Timer_t* timerPtr    ///< [IN] Timer
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Check if a timer of the wheel is running
+ *
+ * @return
+ *  - @c true if the timer is running
+ *  - @c false otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+bool timerWheel_IsRunning
+(
+    const timerWheel_Timer_t* timerPtr  ///< [IN] Timer
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Get the delay until the next expiry of a timer of the wheel
+ *
+ * @return
+ *  - Delay in ms (0 if a timer already expired)
+ *  - UINT32_MAX if no timer is running
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t timerWheel_GetNextDelay
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Call the callbacks of the expired timers of the wheel
+ */
+//--------------------------------------------------------------------------------------------------
+void timerWheel_Process
+(
+    void
+);
+
+/**
+  * @}
+  */
+
+#endif /* __TIMER_WHEEL_H__ */
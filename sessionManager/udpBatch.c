@@ -0,0 +1,270 @@
+/**
+ * @file udpBatch.c
+ *
+ * Batched UDP send: the datagrams produced by one step are queued and sent together
+ *
+ * A batch covers the handling of received datagrams and the client step. The datagrams sent
+ * during a batch (CoAP messages, DTLS flight fragments) are copied in the queue and sent when the
+ * batch ends, the queue is full or the socket changes. The send order is kept.
+ *
+ * With LWM2MCORE_UDP_BATCH, the queue is given to lwm2mcore_UdpSendBatch(). With
+ * LWM2MCORE_DTLS_COALESCE, the DTLS records sent to the same server are packed in the same
+ * datagram up to LWM2MCORE_DTLS_COALESCE_MAX_LEN bytes.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+/* include files */
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <lwm2mcore/lwm2mcore.h>
+#include <lwm2mcore/udp.h>
+#include "udpBatch.h"
+
+#define LOG_MODULE_LEVEL LWM2MCORE_LOG_SESSION
+#include "coreLog.h"
+
+#if (LWM2MCORE_DTLS_COALESCE_MAX_LEN > LWM2MCORE_UDP_MAX_PACKET_SIZE)
+#error "LWM2MCORE_DTLS_COALESCE_MAX_LEN has to be lower than LWM2MCORE_UDP_MAX_PACKET_SIZE"
+#endif
+
+#ifdef UDP_BATCH_QUEUE
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queued datagrams
+ */
+//--------------------------------------------------------------------------------------------------
+static lwm2mcore_UdpDatagram_t Datagrams[LWM2MCORE_UDP_BATCH_SIZE];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Data of the queued datagrams: 24 KB with the default sizes
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t DatagramData[LWM2MCORE_UDP_BATCH_SIZE][LWM2MCORE_UDP_MAX_PACKET_SIZE];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set if the last queued datagram is made of DTLS records: other records can be appended
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsLastCoalescible = false;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of queued datagrams
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t DatagramCount = 0;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Socket of the queued datagrams
+ */
+//--------------------------------------------------------------------------------------------------
+static int DatagramSock = -1;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Nesting level of the batches in progress
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t BatchDepth = 0;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send queued datagrams
+ *
+ * @return
+ *  - Number of sent datagrams, which can be lower than count
+ *  - -1 on error
+ */
+//--------------------------------------------------------------------------------------------------
+static int SendDatagrams
+(
+    const lwm2mcore_UdpDatagram_t* datagramsPtr,    ///< [IN] Datagrams to be sent
+    size_t count                                    ///< [IN] Number of datagrams
+)
+{
+#ifdef LWM2MCORE_UDP_BATCH
+    return lwm2mcore_UdpSendBatch(DatagramSock, datagramsPtr, count);
+#else
+    (void)count;
+    if (0 > lwm2mcore_UdpSend(DatagramSock,
+                              datagramsPtr->bufferPtr,
+                              datagramsPtr->len,
+                              0,
+                              (const struct sockaddr*)&(datagramsPtr->addr),
+                              datagramsPtr->addrLen))
+    {
+        return -1;
+    }
+    return 1;
+#endif
+}
+
+#endif /* UDP_BATCH_QUEUE */
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send the queued datagrams
+ */
+//--------------------------------------------------------------------------------------------------
+void udpBatch_Flush
+(
+    void
+)
+{
+#ifdef UDP_BATCH_QUEUE
+    size_t offset = 0;
+
+    while (offset < DatagramCount)
+    {
+        int nbSent = SendDatagrams(&Datagrams[offset], DatagramCount - offset);
+        if (0 >= nbSent)
+        {
+            LOG_ARG("Failed to send %zu datagrams", DatagramCount - offset);
+            lwm2mcore_ReportUdpErrorCode(LWM2MCORE_UDP_SEND_ERR);
+            break;
+        }
+        offset += (size_t)nbSent;
+    }
+
+    DatagramCount = 0;
+    DatagramSock = -1;
+    IsLastCoalescible = false;
+#endif
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start a batch: the datagrams sent until the matching udpBatch_End() are queued and sent
+ * together. Batches can be nested.
+ */
+//--------------------------------------------------------------------------------------------------
+void udpBatch_Begin
+(
+    void
+)
+{
+#ifdef UDP_BATCH_QUEUE
+    BatchDepth++;
+#endif
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * End a batch: the queued datagrams are sent when the outermost batch ends
+ */
+//--------------------------------------------------------------------------------------------------
+void udpBatch_End
+(
+    void
+)
+{
+#ifdef UDP_BATCH_QUEUE
+    if (0 == BatchDepth)
+    {
+        return;
+    }
+
+    BatchDepth--;
+    if (0 == BatchDepth)
+    {
+        udpBatch_Flush();
+    }
+#endif
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queue a datagram in the current batch
+ *
+ * A datagram made of DTLS records can be appended to the previous queued datagram if it has the
+ * same destination and if it is also made of DTLS records (RFC 6347, section 4.1.1).
+ *
+ * @return
+ *  - UDP_BATCH_QUEUED or UDP_BATCH_COALESCED if the datagram is queued
+ *  - UDP_BATCH_NOT_QUEUED if no batch is in progress or if the datagram is too long: it has to be
+ *    sent directly
+ */
+//--------------------------------------------------------------------------------------------------
+udpBatch_Status_t udpBatch_Queue
+(
+    int sock,                               ///< [IN] Socket Id
+    const uint8_t* bufferPtr,               ///< [IN] Datagram
+    size_t length,                          ///< [IN] Datagram length
+    const struct sockaddr* addrPtr,         ///< [IN] Destination address
+    socklen_t addrLen,                      ///< [IN] Destination address length
+    size_t coalesceMaxLen                   ///< [IN] Maximum length of the datagram carrying the
+                                            ///< DTLS records, 0 if the datagram is not made of
+                                            ///< DTLS records
+)
+{
+#ifdef UDP_BATCH_QUEUE
+    lwm2mcore_UdpDatagram_t* datagramPtr;
+
+    if (0 == BatchDepth)
+    {
+        return UDP_BATCH_NOT_QUEUED;
+    }
+
+    // Keep the send order: the queued datagrams are sent before the ones which are not queued
+    if ((LWM2MCORE_UDP_MAX_PACKET_SIZE < length) || (sizeof(struct sockaddr_storage) < addrLen))
+    {
+        udpBatch_Flush();
+        return UDP_BATCH_NOT_QUEUED;
+    }
+
+    if ((0 != DatagramCount) && (sock != DatagramSock))
+    {
+        udpBatch_Flush();
+    }
+
+#ifdef LWM2MCORE_DTLS_COALESCE
+    // Append the DTLS records to the last datagram sent to the same server
+    if ((0 != DatagramCount) && (0 != coalesceMaxLen) && (IsLastCoalescible))
+    {
+        datagramPtr = &Datagrams[DatagramCount - 1];
+
+        if (((datagramPtr->len + length) <= coalesceMaxLen)
+         && (addrLen == datagramPtr->addrLen)
+         && (0 == memcmp(&(datagramPtr->addr), addrPtr, addrLen)))
+        {
+            memcpy(datagramPtr->bufferPtr + datagramPtr->len, bufferPtr, length);
+            datagramPtr->len += (uint32_t)length;
+            return UDP_BATCH_COALESCED;
+        }
+    }
+#endif
+
+    if (LWM2MCORE_UDP_BATCH_SIZE == DatagramCount)
+    {
+        udpBatch_Flush();
+    }
+
+    datagramPtr = &Datagrams[DatagramCount];
+    memcpy(DatagramData[DatagramCount], bufferPtr, length);
+    datagramPtr->bufferPtr = DatagramData[DatagramCount];
+    datagramPtr->len = (uint32_t)length;
+    memset(&(datagramPtr->addr), 0, sizeof(datagramPtr->addr));
+    memcpy(&(datagramPtr->addr), addrPtr, addrLen);
+    datagramPtr->addrLen = addrLen;
+
+    DatagramSock = sock;
+    DatagramCount++;
+    IsLastCoalescible = ((0 != coalesceMaxLen) && (length < coalesceMaxLen));
+    return UDP_BATCH_QUEUED;
+#else
+    (void)sock;
+    (void)bufferPtr;
+    (void)length;
+    (void)addrPtr;
+    (void)addrLen;
+    (void)coalesceMaxLen;
+    return UDP_BATCH_NOT_QUEUED;
+#endif
+}
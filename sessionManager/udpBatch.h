@@ -0,0 +1,128 @@
+/**
+ * @file udpBatch.h
+ *
+ * Batched UDP send header file
+ *
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+#ifndef __UDP_BATCH_H__
+#define __UDP_BATCH_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <platform/types.h>
+#include <platform/inet.h>
+
+/**
+  * @addtogroup lwm2mcore_udpBatch_int
+  * @{
+  */
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Maximum number of datagrams queued before they are sent
+ *
+ * @remark The queue is static: LWM2MCORE_UDP_BATCH_SIZE * LWM2MCORE_UDP_MAX_PACKET_SIZE bytes of
+ * data, i.e. 16 * 1500 = 24 KB by default.
+ */
+//--------------------------------------------------------------------------------------------------
+#ifndef LWM2MCORE_UDP_BATCH_SIZE
+#define LWM2MCORE_UDP_BATCH_SIZE        16
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Maximum length of a datagram carrying several DTLS records: the IPv6 minimum MTU (1280)
+ * minus the IPv6 and UDP headers by default
+ */
+//--------------------------------------------------------------------------------------------------
+#ifndef LWM2MCORE_DTLS_COALESCE_MAX_LEN
+#define LWM2MCORE_DTLS_COALESCE_MAX_LEN 1232
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Set when the datagrams of a batch are queued: to be sent together or to be coalesced
+ */
+//--------------------------------------------------------------------------------------------------
+#if defined(LWM2MCORE_UDP_BATCH) || defined(LWM2MCORE_DTLS_COALESCE)
+#define UDP_BATCH_QUEUE
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Result of the queuing of a datagram
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    UDP_BATCH_NOT_QUEUED,       ///< The datagram has to be sent directly
+    UDP_BATCH_QUEUED,           ///< The datagram is queued
+    UDP_BATCH_COALESCED         ///< The datagram is appended to the previous queued datagram
+}udpBatch_Status_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Start a batch: the datagrams sent until the matching udpBatch_End() are queued and sent
+ * together. Batches can be nested.
+ */
+//--------------------------------------------------------------------------------------------------
+void udpBatch_Begin
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief End a batch: the queued datagrams are sent when the outermost batch ends
+ */
+//--------------------------------------------------------------------------------------------------
+void udpBatch_End
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Send the queued datagrams, e.g. before their socket is closed
+ */
+//--------------------------------------------------------------------------------------------------
+void udpBatch_Flush
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * @brief Queue a datagram in the current batch
+ *
+ * A datagram made of DTLS records can be appended to the previous queued datagram if it has the
+ * same destination and if it is also made of DTLS records (RFC 6347, section 4.1.1).
+ *
+ * @return
+ *  - UDP_BATCH_QUEUED or UDP_BATCH_COALESCED if the datagram is queued
+ *  - UDP_BATCH_NOT_QUEUED if no batch is in progress or if the datagram is too long: it has to be
+ *    sent directly
+ */
+//--------------------------------------------------------------------------------------------------
+udpBatch_Status_t udpBatch_Queue
+(
+    int sock,                               ///< [IN] Socket Id
+    const uint8_t* bufferPtr,               ///< [IN] Datagram
+    size_t length,                          ///< [IN] Datagram length
+    const struct sockaddr* addrPtr,         ///< [IN] Destination address
+    socklen_t addrLen,                      ///< [IN] Destination address length
+    size_t coalesceMaxLen                   ///< [IN] Maximum length of the datagram carrying the
+                                            ///< DTLS records, 0 if the datagram is not made of
+                                            ///< DTLS records
+);
+
+/**
+  * @}
+  */
+
+#endif /* __UDP_BATCH_H__ */
@@ -0,0 +1,550 @@
+/**
+ * @file bench.c
+ *
+ * Micro-benchmarks of LwM2MCore hot paths: harness, entry point and benchmarks of the public
+ * conversion (utils.c) and integrity check (packageCheck.c) functions
+ *
+ * Results are printed on the standard output, one JSON object per line and per benchmark. The logs
+ * of LwM2MCore are discarded unless the verbose option is set.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <lwm2mcore/lwm2mcore.h>
+#include <lwm2mcore/security.h>
+#include <objectManager/utils.h>
+#include "bench.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Default number of repetitions of a benchmark
+ */
+//--------------------------------------------------------------------------------------------------
+#define BENCH_DEFAULT_REPEATS       5
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of repetitions of a benchmark
+ */
+//--------------------------------------------------------------------------------------------------
+#define BENCH_MAX_REPEATS           31
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Default DWL package, relative to the build directory as the unit tests data
+ */
+//--------------------------------------------------------------------------------------------------
+#define BENCH_DEFAULT_PACKAGE       "../data/valid_package.bin"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the data chunks hashed by the integrity check benchmarks
+ */
+//--------------------------------------------------------------------------------------------------
+#define BENCH_CHUNK_LEN             4096
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Nanoseconds in a second
+ */
+//--------------------------------------------------------------------------------------------------
+#define NS_PER_S                    1000000000ULL
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Context of the integer conversion benchmarks
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    char        bytes[8];           ///< Bytes in network order
+    size_t      len;                ///< Number of bytes to convert
+    int64_t     value;              ///< Converted value
+}
+BytesToIntCtx_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Context of the value formatting benchmarks
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint8_t     bytes[8];           ///< Formatted bytes
+    union
+    {
+        uint32_t    u32;            ///< Unsigned 32 bits value
+        int64_t     i64;            ///< Signed 64 bits value
+    } value;                        ///< Value to format
+    uint32_t    size;               ///< Value size
+    bool        isSigned;           ///< Is the value signed?
+    size_t      len;                ///< Formatted length
+}
+FormatValueCtx_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Context of the integrity check benchmarks
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint8_t     data[BENCH_CHUNK_LEN];  ///< Hashed chunk
+    uint32_t    crc;                    ///< Computed CRC32
+    void*       shaCtxPtr;              ///< SHA1 or SHA256 context
+}
+HashCtx_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stream of the results
+ */
+//--------------------------------------------------------------------------------------------------
+static FILE* ResultPtr = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of repetitions of a benchmark
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t Repeats = BENCH_DEFAULT_REPEATS;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Benchmark name filter, NULL to run all the benchmarks
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* FilterPtr = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of failed benchmarks
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t FailureCount = 0;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the monotonic time
+ *
+ * @return
+ *  - Time in ns
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t GetTimeNs
+(
+    void
+)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * NS_PER_S) + (uint64_t)ts.tv_nsec;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compare two durations (qsort)
+ *
+ * @return
+ *  - negative, zero or positive value as strcmp
+ */
+//--------------------------------------------------------------------------------------------------
+static int CompareDuration
+(
+    const void* aPtr,               ///< [IN] First duration
+    const void* bPtr                ///< [IN] Second duration
+)
+{
+    uint64_t a = *(const uint64_t*)aPtr;
+    uint64_t b = *(const uint64_t*)bPtr;
+
+    return (a > b) - (a < b);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Run a benchmark and print its result
+ */
+//--------------------------------------------------------------------------------------------------
+void bench_Run
+(
+    const char* namePtr,            ///< [IN] Benchmark name: <module>.<function>.<case>
+    bench_Op_t op,                  ///< [IN] Measured operation
+    void* ctxPtr,                   ///< [IN] Context given to the operation
+    uint32_t iterations,            ///< [IN] Number of operations of one repetition
+    size_t bytesPerOp               ///< [IN] Data processed by one operation, 0 if not relevant
+)
+{
+    uint64_t durations[BENCH_MAX_REPEATS];
+    double bestNs;
+    double medianNs;
+    uint32_t repeat;
+    uint32_t i;
+
+    if ((!bench_IsSelected(namePtr)) || (!op) || (!iterations))
+    {
+        return;
+    }
+
+    // Warm up the caches and the lazily initialized states
+    for (i = 0; i < (iterations / 10) + 1; i++)
+    {
+        if (!op(ctxPtr))
+        {
+            bench_Fail(namePtr, "unexpected result");
+            return;
+        }
+    }
+
+    for (repeat = 0; repeat < Repeats; repeat++)
+    {
+        uint64_t startNs = GetTimeNs();
+
+        for (i = 0; i < iterations; i++)
+        {
+            if (!op(ctxPtr))
+            {
+                bench_Fail(namePtr, "unexpected result");
+                return;
+            }
+        }
+        durations[repeat] = GetTimeNs() - startNs;
+    }
+
+    qsort(durations, Repeats, sizeof(durations[0]), CompareDuration);
+    bestNs = (double)durations[0] / iterations;
+    medianNs = (double)durations[Repeats / 2] / iterations;
+
+    fprintf(ResultPtr,
+            "{\"bench\":\"%s\",\"iterations\":%u,\"repeats\":%u,"
+            "\"ns_per_op\":%.1f,\"ns_per_op_median\":%.1f",
+            namePtr, iterations, Repeats, bestNs, medianNs);
+    if (bytesPerOp && (durations[0]))
+    {
+        // Bytes per ns * 1000 = MB per s
+        fprintf(ResultPtr, ",\"mb_per_s\":%.1f", ((double)bytesPerOp * 1000) / bestNs);
+    }
+    fprintf(ResultPtr, "}\n");
+    fflush(ResultPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Report a benchmark which could not be prepared
+ */
+//--------------------------------------------------------------------------------------------------
+void bench_Fail
+(
+    const char* namePtr,            ///< [IN] Benchmark name
+    const char* reasonPtr           ///< [IN] Failure reason
+)
+{
+    FailureCount++;
+    fprintf(ResultPtr, "{\"bench\":\"%s\",\"error\":\"%s\"}\n", namePtr, reasonPtr);
+    fflush(ResultPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if a benchmark is selected by the name filter
+ *
+ * @return
+ *  - true if the benchmark has to be run
+ *  - false otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+bool bench_IsSelected
+(
+    const char* namePtr             ///< [IN] Benchmark name
+)
+{
+    return (!FilterPtr) || (NULL != strstr(namePtr, FilterPtr));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert bytes to an integer (bench_Op_t)
+ *
+ * @return
+ *  - true
+ */
+//--------------------------------------------------------------------------------------------------
+static bool OpBytesToInt
+(
+    void* ctxPtr                    ///< [IN] BytesToIntCtx_t
+)
+{
+    BytesToIntCtx_t* bCtxPtr = (BytesToIntCtx_t*)ctxPtr;
+
+    bCtxPtr->value = omanager_BytesToInt(bCtxPtr->bytes, bCtxPtr->len);
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Format a value in bytes (bench_Op_t)
+ *
+ * @return
+ *  - true if the value is formatted
+ *  - false otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+static bool OpFormatValueToBytes
+(
+    void* ctxPtr                    ///< [IN] FormatValueCtx_t
+)
+{
+    FormatValueCtx_t* fCtxPtr = (FormatValueCtx_t*)ctxPtr;
+
+    fCtxPtr->len = omanager_FormatValueToBytes(fCtxPtr->bytes,
+                                               &fCtxPtr->value,
+                                               fCtxPtr->size,
+                                               fCtxPtr->isSigned);
+    return (0 != fCtxPtr->len);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Update a CRC32 with a chunk (bench_Op_t)
+ *
+ * @return
+ *  - true
+ */
+//--------------------------------------------------------------------------------------------------
+static bool OpCrc32
+(
+    void* ctxPtr                    ///< [IN] HashCtx_t
+)
+{
+    HashCtx_t* hCtxPtr = (HashCtx_t*)ctxPtr;
+
+    hCtxPtr->crc = lwm2mcore_Crc32(hCtxPtr->crc, hCtxPtr->data, sizeof(hCtxPtr->data));
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Update a SHA1 digest with a chunk (bench_Op_t)
+ *
+ * @return
+ *  - true if the digest is updated
+ *  - false otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+static bool OpSha1
+(
+    void* ctxPtr                    ///< [IN] HashCtx_t
+)
+{
+    HashCtx_t* hCtxPtr = (HashCtx_t*)ctxPtr;
+
+    return (LWM2MCORE_ERR_COMPLETED_OK == lwm2mcore_ProcessSha1(hCtxPtr->shaCtxPtr,
+                                                                hCtxPtr->data,
+                                                                sizeof(hCtxPtr->data)));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Update a SHA256 digest with a chunk (bench_Op_t)
+ *
+ * @return
+ *  - true if the digest is updated
+ *  - false otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+static bool OpSha256
+(
+    void* ctxPtr                    ///< [IN] HashCtx_t
+)
+{
+    HashCtx_t* hCtxPtr = (HashCtx_t*)ctxPtr;
+
+    return (LWM2MCORE_ERR_COMPLETED_OK == lwm2mcore_ProcessSha256(hCtxPtr->shaCtxPtr,
+                                                                  hCtxPtr->data,
+                                                                  sizeof(hCtxPtr->data)));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Run the benchmarks of the integer conversion functions of utils.c
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunUtils
+(
+    void
+)
+{
+    static const size_t lens[] = { 1, 2, 4, 8 };
+    BytesToIntCtx_t bCtx;
+    FormatValueCtx_t fCtx;
+    char name[64];
+    size_t i;
+
+    memset(&bCtx, 0, sizeof(bCtx));
+    memcpy(bCtx.bytes, "\x80\x12\x34\x56\x78\x9a\xbc\xde", sizeof(bCtx.bytes));
+    for (i = 0; i < sizeof(lens) / sizeof(lens[0]); i++)
+    {
+        bCtx.len = lens[i];
+        snprintf(name, sizeof(name), "utils.omanager_BytesToInt.%zubytes", lens[i]);
+        bench_Run(name, OpBytesToInt, &bCtx, 10000000, 0);
+    }
+
+    memset(&fCtx, 0, sizeof(fCtx));
+    fCtx.value.u32 = 86400;
+    fCtx.size = sizeof(fCtx.value.u32);
+    fCtx.isSigned = false;
+    bench_Run("utils.omanager_FormatValueToBytes.uint32", OpFormatValueToBytes, &fCtx, 10000000, 0);
+
+    memset(&fCtx, 0, sizeof(fCtx));
+    fCtx.value.i64 = -1700000000LL;
+    fCtx.size = sizeof(fCtx.value.i64);
+    fCtx.isSigned = true;
+    bench_Run("utils.omanager_FormatValueToBytes.int64", OpFormatValueToBytes, &fCtx, 10000000, 0);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Run the benchmarks of the integrity check functions of the porting layer (packageCheck.c)
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunPackageCheck
+(
+    void
+)
+{
+    static HashCtx_t hCtx;
+    size_t i;
+
+    for (i = 0; i < sizeof(hCtx.data); i++)
+    {
+        hCtx.data[i] = (uint8_t)(i * 31);
+    }
+
+    hCtx.crc = lwm2mcore_Crc32(0L, NULL, 0);
+    bench_Run("packageCheck.lwm2mcore_Crc32.4k", OpCrc32, &hCtx, 20000, sizeof(hCtx.data));
+
+    if (bench_IsSelected("packageCheck.lwm2mcore_ProcessSha1.4k"))
+    {
+        hCtx.shaCtxPtr = NULL;
+        if (LWM2MCORE_ERR_COMPLETED_OK != lwm2mcore_StartSha1(&hCtx.shaCtxPtr))
+        {
+            bench_Fail("packageCheck.lwm2mcore_ProcessSha1.4k", "SHA1 initialization failed");
+        }
+        else
+        {
+            bench_Run("packageCheck.lwm2mcore_ProcessSha1.4k", OpSha1, &hCtx, 20000,
+                      sizeof(hCtx.data));
+            lwm2mcore_CancelSha1(&hCtx.shaCtxPtr);
+        }
+    }
+
+    if (bench_IsSelected("packageCheck.lwm2mcore_ProcessSha256.4k"))
+    {
+        hCtx.shaCtxPtr = NULL;
+        if (LWM2MCORE_ERR_COMPLETED_OK != lwm2mcore_StartSha256(&hCtx.shaCtxPtr))
+        {
+            bench_Fail("packageCheck.lwm2mcore_ProcessSha256.4k", "SHA256 initialization failed");
+        }
+        else
+        {
+            bench_Run("packageCheck.lwm2mcore_ProcessSha256.4k", OpSha256, &hCtx, 20000,
+                      sizeof(hCtx.data));
+            lwm2mcore_CancelSha256(&hCtx.shaCtxPtr);
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Print the usage
+ */
+//--------------------------------------------------------------------------------------------------
+static void PrintUsage
+(
+    void
+)
+{
+    fprintf(stderr, "Usage: lwm2mcore_bench [OPTION]\n");
+    fprintf(stderr, "Run the micro-benchmarks of LwM2MCore hot paths.\n");
+    fprintf(stderr, "Options:\n");
+    fprintf(stderr, "  -f <text>\tOnly run the benchmarks whose name contains the text\n");
+    fprintf(stderr, "  -p <file>\tDWL package to parse (default %s)\n", BENCH_DEFAULT_PACKAGE);
+    fprintf(stderr, "  -r <count>\tRepetitions of each benchmark, 1 to %d (default %d)\n",
+            BENCH_MAX_REPEATS, BENCH_DEFAULT_REPEATS);
+    fprintf(stderr, "  -v\t\tKeep the LwM2MCore logs\n");
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Benchmark entry point.
+ */
+//--------------------------------------------------------------------------------------------------
+int main
+(
+    int argc,           ///<[IN] argument count
+    char* argvPtr[]     ///<[IN] argument vector
+)
+{
+    const char* packagePathPtr = BENCH_DEFAULT_PACKAGE;
+    bool isVerbose = false;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argvPtr, "f:p:r:v")))
+    {
+        switch (opt)
+        {
+            case 'f':
+                FilterPtr = optarg;
+                break;
+
+            case 'p':
+                packagePathPtr = optarg;
+                break;
+
+            case 'r':
+                if ((0 >= atoi(optarg)) || (BENCH_MAX_REPEATS < atoi(optarg)))
+                {
+                    PrintUsage();
+                    return EXIT_FAILURE;
+                }
+                Repeats = (uint32_t)atoi(optarg);
+                break;
+
+            case 'v':
+                isVerbose = true;
+                break;
+
+            default:
+                PrintUsage();
+                return EXIT_FAILURE;
+        }
+    }
+
+    // The results are printed on the original standard output, the logs are discarded
+    ResultPtr = fdopen(dup(STDOUT_FILENO), "w");
+    if (!ResultPtr)
+    {
+        return EXIT_FAILURE;
+    }
+    if ((!isVerbose) && (!freopen("/dev/null", "w", stdout)))
+    {
+        return EXIT_FAILURE;
+    }
+
+    RunUtils();
+    RunPackageCheck();
+    bench_RunObjects();
+    bench_RunPackage(packagePathPtr);
+
+    fclose(ResultPtr);
+    return FailureCount ? EXIT_FAILURE : EXIT_SUCCESS;
+}
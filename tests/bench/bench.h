@@ -0,0 +1,95 @@
+/**
+ * @file bench.h
+ *
+ * Micro-benchmark harness of LwM2MCore hot paths
+ *
+ * Each benchmark runs a fixed number of operations, repeated several times. One JSON object is
+ * printed per benchmark, with the best and the median time per operation among the repetitions:
+ * the output of two releases can be compared line by line.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+#ifndef __TESTS_BENCH_H__
+#define __TESTS_BENCH_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Operation measured by a benchmark
+ *
+ * @return
+ *  - true if the operation produced the expected result
+ *  - false otherwise: the benchmark is stopped and reported as failed
+ */
+//--------------------------------------------------------------------------------------------------
+typedef bool (*bench_Op_t)
+(
+    void* ctxPtr                    ///< [IN] Benchmark context
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Run a benchmark and print its result
+ */
+//--------------------------------------------------------------------------------------------------
+void bench_Run
+(
+    const char* namePtr,            ///< [IN] Benchmark name: <module>.<function>.<case>
+    bench_Op_t op,                  ///< [IN] Measured operation
+    void* ctxPtr,                   ///< [IN] Context given to the operation
+    uint32_t iterations,            ///< [IN] Number of operations of one repetition
+    size_t bytesPerOp               ///< [IN] Data processed by one operation, 0 if not relevant
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Report a benchmark which could not be prepared
+ */
+//--------------------------------------------------------------------------------------------------
+void bench_Fail
+(
+    const char* namePtr,            ///< [IN] Benchmark name
+    const char* reasonPtr           ///< [IN] Failure reason
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if a benchmark is selected by the name filter
+ *
+ * @return
+ *  - true if the benchmark has to be run
+ *  - false otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+bool bench_IsSelected
+(
+    const char* namePtr             ///< [IN] Benchmark name
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Run the object manager benchmarks: ReadCb(), WriteCb(), EncodeData(), FormatDataWriteExecute()
+ * and the base64 decoder
+ */
+//--------------------------------------------------------------------------------------------------
+void bench_RunObjects
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Run the package downloader benchmarks: DwlParser() and HashData()
+ */
+//--------------------------------------------------------------------------------------------------
+void bench_RunPackage
+(
+    const char* packagePathPtr      ///< [IN] DWL package parsed by the benchmarks
+);
+
+#endif /* __TESTS_BENCH_H__ */
@@ -0,0 +1,542 @@
+/**
+ * @file benchObjects.c
+ *
+ * Micro-benchmarks of the object manager: READ/WRITE callbacks given to Wakaama, data encoding and
+ * decoding, base64 decoder
+ *
+ * The measured functions are internal to objects.c: the source file is included in this
+ * translation unit, which replaces objects.c in the benchmark build. The objects are registered
+ * from the default object table, as in the Linux client. Wakaama is replaced by the unit tests
+ * stubs: the figures only cover the LwM2MCore side.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+#include <objectManager/objects.c>
+#include "bench.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Length of the data decoded by the base64 benchmarks (encoded length: 4096 characters)
+ */
+//--------------------------------------------------------------------------------------------------
+#define BENCH_B64_DECODED_LEN       3072
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Length of the encoded data of the base64 benchmarks
+ */
+//--------------------------------------------------------------------------------------------------
+#define BENCH_B64_ENCODED_LEN       ((BENCH_B64_DECODED_LEN / 3) * 4)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Length of the opaque resource written by the WRITE benchmarks
+ */
+//--------------------------------------------------------------------------------------------------
+#define BENCH_OPAQUE_LEN            256
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Context of the READ callback benchmarks
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    lwm2m_object_t* objectPtr;      ///< Wakaama object
+    uint16_t        oiid;           ///< Object instance Id
+    uint16_t        rid;            ///< Resource Id, LWM2MCORE_ID_NONE to read the whole instance
+    uint8_t         result;         ///< CoAP result of the last read
+}
+ReadCtx_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Context of the WRITE callback benchmarks
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    lwm2m_object_t* objectPtr;      ///< Wakaama object
+    uint16_t        oiid;           ///< Object instance Id
+    lwm2m_data_t    data;           ///< Written data
+    uint8_t         result;         ///< CoAP result of the last write
+}
+WriteCtx_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Context of the EncodeData() benchmarks
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    lwm2mcore_ResourceType_t    type;                       ///< Resource type
+    char                        buf[BENCH_OPAQUE_LEN];      ///< Value read by a handler
+    size_t                      len;                        ///< Value length
+    lwm2m_data_t                data;                       ///< Encoded data
+}
+EncodeCtx_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Context of the FormatDataWriteExecute() benchmarks
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    lwm2mcore_ResourceType_t    type;                       ///< Resource type
+    lwm2m_data_t                data;                       ///< Received data
+    char                        buf[LWM2MCORE_BUFFER_MAX_LEN];  ///< Value given to a handler
+    size_t                      len;                        ///< Value length
+}
+FormatCtx_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Context of the base64 benchmarks
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint8_t     encoded[BENCH_B64_ENCODED_LEN];     ///< Base64 string
+    uint8_t     decoded[BENCH_B64_DECODED_LEN];     ///< Decoded data
+    size_t      len;                                ///< Decoded length
+}
+Base64Ctx_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Encode data in base64, to prepare the decoder benchmarks
+ *
+ * @return
+ *  - Encoded length
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t EncodeBase64
+(
+    const uint8_t* dataPtr,         ///< [IN] Data to encode
+    size_t len,                     ///< [IN] Data length, multiple of 3
+    uint8_t* encodedPtr             ///< [OUT] Base64 string
+)
+{
+    static const char table[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    size_t i;
+    size_t j = 0;
+
+    for (i = 0; (i + 2) < len; i += 3)
+    {
+        encodedPtr[j++] = table[dataPtr[i] >> 2];
+        encodedPtr[j++] = table[((dataPtr[i] & 0x03) << 4) | (dataPtr[i + 1] >> 4)];
+        encodedPtr[j++] = table[((dataPtr[i + 1] & 0x0F) << 2) | (dataPtr[i + 2] >> 6)];
+        encodedPtr[j++] = table[dataPtr[i + 2] & 0x3F];
+    }
+
+    return j;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Event handler of the benchmark client instance
+ *
+ * @return
+ *  - 0
+ */
+//--------------------------------------------------------------------------------------------------
+static int BenchEventHandler
+(
+    lwm2mcore_Status_t status       ///< [IN] Event status
+)
+{
+    (void)status;
+    return 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find a Wakaama object of the benchmark client instance
+ *
+ * @return
+ *  - Wakaama object
+ *  - NULL if the object is not registered
+ */
+//--------------------------------------------------------------------------------------------------
+static lwm2m_object_t* FindWakaamaObject
+(
+    lwm2mcore_Ref_t instanceRef,    ///< [IN] Instance reference
+    uint16_t oid                    ///< [IN] Object Id
+)
+{
+    smanager_ClientData_t* dataPtr = (smanager_ClientData_t*)instanceRef;
+
+    if ((!dataPtr) || (!dataPtr->lwm2mHPtr))
+    {
+        return NULL;
+    }
+
+    return (lwm2m_object_t*)LWM2M_LIST_FIND(dataPtr->lwm2mHPtr->objectList, oid);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a resource or an object instance through the READ callback (bench_Op_t)
+ *
+ * @return
+ *  - true if the read succeeded
+ *  - false otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+static bool OpReadCb
+(
+    void* ctxPtr                    ///< [IN] ReadCtx_t
+)
+{
+    ReadCtx_t* rCtxPtr = (ReadCtx_t*)ctxPtr;
+    lwm2m_data_t data;
+    lwm2m_data_t* dataArrayPtr = NULL;
+    int numData = 0;
+
+    if (LWM2MCORE_ID_NONE == rCtxPtr->rid)
+    {
+        // Whole object instance: the array is allocated by the callback, as for Wakaama
+        rCtxPtr->result = ReadCb(rCtxPtr->oiid, &numData, &dataArrayPtr, rCtxPtr->objectPtr);
+        lwm2m_data_free(numData, dataArrayPtr);
+    }
+    else
+    {
+        memset(&data, 0, sizeof(data));
+        data.id = rCtxPtr->rid;
+        dataArrayPtr = &data;
+        numData = 1;
+        rCtxPtr->result = ReadCb(rCtxPtr->oiid, &numData, &dataArrayPtr, rCtxPtr->objectPtr);
+    }
+
+    return (COAP_205_CONTENT == rCtxPtr->result);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write a resource through the WRITE callback (bench_Op_t)
+ *
+ * @return
+ *  - true if the write succeeded
+ *  - false otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+static bool OpWriteCb
+(
+    void* ctxPtr                    ///< [IN] WriteCtx_t
+)
+{
+    WriteCtx_t* wCtxPtr = (WriteCtx_t*)ctxPtr;
+
+    wCtxPtr->result = WriteCb(wCtxPtr->oiid, 1, &wCtxPtr->data, wCtxPtr->objectPtr);
+    return (COAP_204_CHANGED == wCtxPtr->result);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Encode a value read by a handler (bench_Op_t)
+ *
+ * @return
+ *  - true if the value is encoded
+ *  - false otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+static bool OpEncodeData
+(
+    void* ctxPtr                    ///< [IN] EncodeCtx_t
+)
+{
+    EncodeCtx_t* eCtxPtr = (EncodeCtx_t*)ctxPtr;
+
+    return (COAP_205_CONTENT == EncodeData(eCtxPtr->type, eCtxPtr->buf, eCtxPtr->len,
+                                           &eCtxPtr->data));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Format a received value for a handler (bench_Op_t)
+ *
+ * @return
+ *  - true if the value is formatted
+ *  - false otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+static bool OpFormatDataWriteExecute
+(
+    void* ctxPtr                    ///< [IN] FormatCtx_t
+)
+{
+    FormatCtx_t* fCtxPtr = (FormatCtx_t*)ctxPtr;
+
+    fCtxPtr->len = sizeof(fCtxPtr->buf);
+    return FormatDataWriteExecute(fCtxPtr->type, fCtxPtr->data, fCtxPtr->buf, &fCtxPtr->len);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode a base64 string block per block (bench_Op_t)
+ *
+ * @return
+ *  - true
+ */
+//--------------------------------------------------------------------------------------------------
+static bool OpDecodeBlock
+(
+    void* ctxPtr                    ///< [IN] Base64Ctx_t
+)
+{
+    Base64Ctx_t* bCtxPtr = (Base64Ctx_t*)ctxPtr;
+    size_t i;
+    size_t j;
+
+    for (i = 0, j = 0; i < sizeof(bCtxPtr->encoded); i += 4, j += 3)
+    {
+        prv_decodeBlock(bCtxPtr->encoded + i, bCtxPtr->decoded + j);
+    }
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode a base64 string (bench_Op_t)
+ *
+ * @return
+ *  - true if the whole string is decoded
+ *  - false otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+static bool OpBase64Decode
+(
+    void* ctxPtr                    ///< [IN] Base64Ctx_t
+)
+{
+    Base64Ctx_t* bCtxPtr = (Base64Ctx_t*)ctxPtr;
+
+    bCtxPtr->len = base64_decode(bCtxPtr->encoded, sizeof(bCtxPtr->encoded), bCtxPtr->decoded);
+    return (sizeof(bCtxPtr->decoded) == bCtxPtr->len);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Run the READ and WRITE callback benchmarks on the registered objects
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunCallbacks
+(
+    lwm2mcore_Ref_t instanceRef     ///< [IN] Instance reference
+)
+{
+    static const struct
+    {
+        const char* namePtr;        ///< Benchmark name
+        uint16_t    oid;            ///< Object Id
+        uint16_t    rid;            ///< Resource Id, LWM2MCORE_ID_NONE for the whole instance
+        uint32_t    iterations;     ///< Number of reads
+    }
+    reads[] =
+    {
+        { "objects.ReadCb.device_manufacturer", LWM2MCORE_DEVICE_OID,
+          LWM2MCORE_DEVICE_MANUFACTURER_RID, 200000 },
+        { "objects.ReadCb.ext_stats_temperature", LWM2MCORE_EXT_CONN_STATS_OID,
+          LWM2MCORE_EXT_CONN_STATS_TEMPERATURE_RID, 200000 },
+        { "objects.ReadCb.conn_monitor_instance", LWM2MCORE_CONN_MONITOR_OID,
+          LWM2MCORE_ID_NONE, 20000 },
+        { "objects.ReadCb.ext_stats_instance", LWM2MCORE_EXT_CONN_STATS_OID,
+          LWM2MCORE_ID_NONE, 20000 },
+    };
+    static const char currentTime[] = "1700000000";
+    ReadCtx_t rCtx;
+    WriteCtx_t wCtx;
+    size_t i;
+
+    for (i = 0; i < sizeof(reads) / sizeof(reads[0]); i++)
+    {
+        if (!bench_IsSelected(reads[i].namePtr))
+        {
+            continue;
+        }
+
+        memset(&rCtx, 0, sizeof(rCtx));
+        rCtx.objectPtr = FindWakaamaObject(instanceRef, reads[i].oid);
+        rCtx.rid = reads[i].rid;
+        if (!rCtx.objectPtr)
+        {
+            bench_Fail(reads[i].namePtr, "object not registered");
+            continue;
+        }
+        bench_Run(reads[i].namePtr, OpReadCb, &rCtx, reads[i].iterations, 0);
+    }
+
+    memset(&wCtx, 0, sizeof(wCtx));
+    wCtx.objectPtr = FindWakaamaObject(instanceRef, LWM2MCORE_DEVICE_OID);
+    wCtx.data.id = LWM2MCORE_DEVICE_CURRENT_TIME_RID;
+    if (!wCtx.objectPtr)
+    {
+        bench_Fail("objects.WriteCb", "object not registered");
+        return;
+    }
+
+    // Current time written in plain text
+    wCtx.data.type = LWM2M_TYPE_STRING;
+    wCtx.data.value.asBuffer.buffer = (uint8_t*)currentTime;
+    wCtx.data.value.asBuffer.length = strlen(currentTime);
+    bench_Run("objects.WriteCb.device_time_text", OpWriteCb, &wCtx, 200000, 0);
+
+    // Current time written in TLV
+    wCtx.data.type = LWM2M_TYPE_INTEGER;
+    wCtx.data.value.asInteger = 1700000000;
+    bench_Run("objects.WriteCb.device_time_tlv", OpWriteCb, &wCtx, 200000, 0);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Run the EncodeData() benchmarks
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunEncodeData
+(
+    void
+)
+{
+    static EncodeCtx_t eCtx;
+    static const char manufacturer[] = "Sierra Wireless";
+    static const char float64[] = "45.1234567";
+    static const uint8_t int64[] = { 0x00, 0x00, 0x00, 0x00, 0x65, 0x53, 0xF1, 0x00 };
+    size_t i;
+
+    memset(&eCtx, 0, sizeof(eCtx));
+    eCtx.type = LWM2MCORE_RESOURCE_TYPE_INT;
+    memcpy(eCtx.buf, int64, sizeof(int64));
+    eCtx.len = sizeof(int64);
+    bench_Run("objects.EncodeData.int", OpEncodeData, &eCtx, 1000000, 0);
+
+    memset(&eCtx, 0, sizeof(eCtx));
+    eCtx.type = LWM2MCORE_RESOURCE_TYPE_BOOL;
+    eCtx.buf[0] = 1;
+    eCtx.len = 1;
+    bench_Run("objects.EncodeData.bool", OpEncodeData, &eCtx, 1000000, 0);
+
+    memset(&eCtx, 0, sizeof(eCtx));
+    eCtx.type = LWM2MCORE_RESOURCE_TYPE_STRING;
+    memcpy(eCtx.buf, manufacturer, strlen(manufacturer));
+    eCtx.len = strlen(manufacturer);
+    bench_Run("objects.EncodeData.string", OpEncodeData, &eCtx, 1000000, 0);
+
+    memset(&eCtx, 0, sizeof(eCtx));
+    eCtx.type = LWM2MCORE_RESOURCE_TYPE_FLOAT;
+    memcpy(eCtx.buf, float64, strlen(float64));
+    eCtx.len = strlen(float64);
+    bench_Run("objects.EncodeData.float", OpEncodeData, &eCtx, 1000000, 0);
+
+    memset(&eCtx, 0, sizeof(eCtx));
+    eCtx.type = LWM2MCORE_RESOURCE_TYPE_OPAQUE;
+    for (i = 0; i < sizeof(eCtx.buf); i++)
+    {
+        eCtx.buf[i] = (char)i;
+    }
+    eCtx.len = sizeof(eCtx.buf);
+    bench_Run("objects.EncodeData.opaque", OpEncodeData, &eCtx, 1000000, 0);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Run the FormatDataWriteExecute() and base64 decoder benchmarks
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunDecoders
+(
+    void
+)
+{
+    static FormatCtx_t fCtx;
+    static Base64Ctx_t bCtx;
+    static uint8_t opaque[BENCH_OPAQUE_LEN];
+    static uint8_t opaqueB64[(BENCH_OPAQUE_LEN / 3 + 1) * 4];
+    static const char lifetime[] = "86400";
+    size_t opaqueB64Len;
+    size_t i;
+
+    for (i = 0; i < sizeof(opaque); i++)
+    {
+        opaque[i] = (uint8_t)(i * 7);
+    }
+    // Encode a multiple of 3 bytes: no padding
+    opaqueB64Len = EncodeBase64(opaque, (sizeof(opaque) / 3) * 3, opaqueB64);
+
+    memset(&fCtx, 0, sizeof(fCtx));
+    fCtx.type = LWM2MCORE_RESOURCE_TYPE_INT;
+    fCtx.data.type = LWM2M_TYPE_STRING;
+    fCtx.data.value.asBuffer.buffer = (uint8_t*)lifetime;
+    fCtx.data.value.asBuffer.length = strlen(lifetime);
+    bench_Run("objects.FormatDataWriteExecute.text_int", OpFormatDataWriteExecute, &fCtx,
+              1000000, 0);
+
+    fCtx.type = LWM2MCORE_RESOURCE_TYPE_OPAQUE;
+    fCtx.data.type = LWM2M_TYPE_STRING;
+    fCtx.data.value.asBuffer.buffer = opaqueB64;
+    fCtx.data.value.asBuffer.length = opaqueB64Len;
+    bench_Run("objects.FormatDataWriteExecute.text_opaque_b64", OpFormatDataWriteExecute, &fCtx,
+              200000, opaqueB64Len);
+
+    fCtx.type = LWM2MCORE_RESOURCE_TYPE_OPAQUE;
+    fCtx.data.type = LWM2M_TYPE_OPAQUE;
+    fCtx.data.value.asBuffer.buffer = opaque;
+    fCtx.data.value.asBuffer.length = sizeof(opaque);
+    bench_Run("objects.FormatDataWriteExecute.tlv_opaque", OpFormatDataWriteExecute, &fCtx,
+              1000000, sizeof(opaque));
+
+    fCtx.type = LWM2MCORE_RESOURCE_TYPE_INT;
+    fCtx.data.type = LWM2M_TYPE_INTEGER;
+    fCtx.data.value.asInteger = 86400;
+    bench_Run("objects.FormatDataWriteExecute.tlv_int", OpFormatDataWriteExecute, &fCtx,
+              1000000, 0);
+
+    for (i = 0; i < sizeof(bCtx.decoded); i++)
+    {
+        bCtx.decoded[i] = (uint8_t)(i * 13);
+    }
+    EncodeBase64(bCtx.decoded, sizeof(bCtx.decoded), bCtx.encoded);
+    bench_Run("objects.prv_decodeBlock.4k", OpDecodeBlock, &bCtx, 20000, sizeof(bCtx.encoded));
+    bench_Run("objects.base64_decode.4k", OpBase64Decode, &bCtx, 20000, sizeof(bCtx.encoded));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Run the object manager benchmarks: ReadCb(), WriteCb(), EncodeData(), FormatDataWriteExecute()
+ * and the base64 decoder
+ */
+//--------------------------------------------------------------------------------------------------
+void bench_RunObjects
+(
+    void
+)
+{
+    char endpoint[] = "BENCH";
+    lwm2mcore_Ref_t instanceRef;
+
+    RunEncodeData();
+    RunDecoders();
+
+    instanceRef = lwm2mcore_Init(BenchEventHandler);
+    if (!instanceRef)
+    {
+        bench_Fail("objects.ReadCb", "lwm2mcore_Init failed");
+        return;
+    }
+
+    if (!lwm2mcore_ObjectRegister(instanceRef, endpoint, NULL, NULL))
+    {
+        bench_Fail("objects.ReadCb", "lwm2mcore_ObjectRegister failed");
+    }
+    else
+    {
+        RunCallbacks(instanceRef);
+    }
+
+    lwm2mcore_Free(instanceRef);
+}
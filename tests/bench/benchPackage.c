@@ -0,0 +1,238 @@
+/**
+ * @file benchPackage.c
+ *
+ * Micro-benchmarks of the package downloader: DWL parser and package hashing
+ *
+ * The measured functions are internal to lwm2mcorePackageDownloader.c: the source file is included
+ * in this translation unit, which replaces lwm2mcorePackageDownloader.c in the benchmark build.
+ * The package is parsed from memory, as it would be received by chunks from the download
+ * connection. The signature verification depends on the provisioned keys and is not part of the
+ * measure: the parser is stopped before the signature and the computed CRC is checked instead.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+#include <packageDownloader/lwm2mcorePackageDownloader.c>
+#include "bench.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum size of the parsed package
+ */
+//--------------------------------------------------------------------------------------------------
+#define BENCH_PACKAGE_MAX_LEN       (1024 * 1024)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the binary data chunks given to the parser, as received from the download connection
+ */
+//--------------------------------------------------------------------------------------------------
+#define BENCH_DWL_CHUNK_LEN         4096
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Context of the package benchmarks
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint8_t*    dataPtr;            ///< Package data
+    size_t      len;                ///< Package length
+    size_t      parsedLen;          ///< Length parsed before the signature
+}
+PackageCtx_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reset the DWL parser for a new package
+ */
+//--------------------------------------------------------------------------------------------------
+static void ResetParser
+(
+    void
+)
+{
+    lwm2mcore_CancelSha1(&DwlParserObj.sha1CtxPtr);
+    memset(&DwlParserObj, 0, sizeof(DwlParserObj));
+    DwlParserObj.subsection = DWL_SUB_PROLOG;
+    DwlParserObj.lenToParse = sizeof(DwlProlog_t);
+
+    memset(&PkgDwlObj, 0, sizeof(PkgDwlObj));
+    PkgDwlObj.packageType = LWM2MCORE_FW_UPDATE_TYPE;
+    PkgDwlObj.state = PKG_DWL_PARSE;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse a firmware package up to its signature (bench_Op_t)
+ *
+ * The loop follows PkgDwlParse() and PkgDwlStore(), without the storage of the binary data.
+ *
+ * @return
+ *  - true if the package is parsed and its CRC is correct
+ *  - false otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+static bool OpDwlParser
+(
+    void* ctxPtr                    ///< [IN] PackageCtx_t
+)
+{
+    PackageCtx_t* pCtxPtr = (PackageCtx_t*)ctxPtr;
+    size_t offset = 0;
+    bool isValid;
+
+    ResetParser();
+
+    while (DWL_SUB_SIGNATURE != DwlParserObj.subsection)
+    {
+        if (   (DWL_SUB_BINARY == DwlParserObj.subsection)
+            && (DwlParserObj.remainingBinaryData > BENCH_DWL_CHUNK_LEN))
+        {
+            DwlParserObj.lenToParse = BENCH_DWL_CHUNK_LEN;
+        }
+        else if (DWL_SUB_BINARY == DwlParserObj.subsection)
+        {
+            DwlParserObj.lenToParse = DwlParserObj.remainingBinaryData;
+        }
+
+        if ((offset + DwlParserObj.lenToParse) > pCtxPtr->len)
+        {
+            ResetParser();
+            return false;
+        }
+
+        DwlParserObj.dataToParsePtr = pCtxPtr->dataPtr + offset;
+        PkgDwlObj.dwlDataPtr = DwlParserObj.dataToParsePtr;
+        PkgDwlObj.processedLen = 0;
+        if (DWL_OK != DwlParser(LWM2MCORE_FW_UPDATE_TYPE))
+        {
+            ResetParser();
+            return false;
+        }
+        offset += PkgDwlObj.processedLen;
+
+        // End of binary data: the padding follows
+        if ((PKG_DWL_STORE == PkgDwlObj.state) && (0 == DwlParserObj.remainingBinaryData))
+        {
+            DwlParserObj.subsection = DWL_SUB_PADDING;
+            DwlParserObj.lenToParse = DwlParserObj.paddingSize;
+        }
+        PkgDwlObj.state = PKG_DWL_PARSE;
+    }
+
+    isValid = (DwlParserObj.packageCRC == DwlParserObj.computedCRC);
+    pCtxPtr->parsedLen = offset;
+    ResetParser();
+    return isValid;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hash a chunk of binary data (bench_Op_t)
+ *
+ * @return
+ *  - true if the chunk is hashed
+ *  - false otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+static bool OpHashData
+(
+    void* ctxPtr                    ///< [IN] PackageCtx_t
+)
+{
+    PackageCtx_t* pCtxPtr = (PackageCtx_t*)ctxPtr;
+
+    DwlParserObj.dataToParsePtr = pCtxPtr->dataPtr;
+    PkgDwlObj.processedLen = BENCH_DWL_CHUNK_LEN;
+    return (DWL_OK == HashData(LWM2MCORE_FW_UPDATE_TYPE));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Load the package to parse
+ *
+ * @return
+ *  - true on success
+ *  - false on failure
+ */
+//--------------------------------------------------------------------------------------------------
+static bool LoadPackage
+(
+    const char* packagePathPtr,     ///< [IN] DWL package
+    PackageCtx_t* pCtxPtr           ///< [OUT] Package data
+)
+{
+    FILE* filePtr = fopen(packagePathPtr, "rb");
+
+    if (!filePtr)
+    {
+        return false;
+    }
+
+    // One more byte: the DWL comments are logged as a string
+    pCtxPtr->dataPtr = (uint8_t*)calloc(1, BENCH_PACKAGE_MAX_LEN + 1);
+    if (!pCtxPtr->dataPtr)
+    {
+        fclose(filePtr);
+        return false;
+    }
+
+    pCtxPtr->len = fread(pCtxPtr->dataPtr, 1, BENCH_PACKAGE_MAX_LEN, filePtr);
+    fclose(filePtr);
+
+    if (pCtxPtr->len < BENCH_DWL_CHUNK_LEN)
+    {
+        free(pCtxPtr->dataPtr);
+        pCtxPtr->dataPtr = NULL;
+        return false;
+    }
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Run the package downloader benchmarks: DwlParser() and HashData()
+ */
+//--------------------------------------------------------------------------------------------------
+void bench_RunPackage
+(
+    const char* packagePathPtr      ///< [IN] DWL package parsed by the benchmarks
+)
+{
+    PackageCtx_t pCtx;
+
+    if ((!bench_IsSelected("package.DwlParser.valid_package"))
+     && (!bench_IsSelected("package.HashData.bina_4k")))
+    {
+        return;
+    }
+
+    memset(&pCtx, 0, sizeof(pCtx));
+    if (!LoadPackage(packagePathPtr, &pCtx))
+    {
+        bench_Fail("package", "unable to load the package");
+        return;
+    }
+
+    // Parse the package once to get the parsed length
+    if (!OpDwlParser(&pCtx))
+    {
+        bench_Fail("package.DwlParser.valid_package", "invalid package");
+    }
+    else
+    {
+        bench_Run("package.DwlParser.valid_package", OpDwlParser, &pCtx, 2000, pCtx.parsedLen);
+    }
+
+    // CRC32 and SHA1 of the binary data of a firmware package
+    ResetParser();
+    DwlParserObj.section = DWL_TYPE_BINA;
+    DwlParserObj.subsection = DWL_SUB_BINARY;
+    bench_Run("package.HashData.bina_4k", OpHashData, &pCtx, 20000, BENCH_DWL_CHUNK_LEN);
+    ResetParser();
+
+    free(pCtx.dataPtr);
+}
@@ -0,0 +1,830 @@
+/**
+ * @file fleetSim.c
+ *
+ * Fleet simulator: registration and notification throughput benchmark of LwM2MCore
+ *
+ * N client instances are created in one process with the real session manager, DTLS and object
+ * manager code, and driven against the in-process server stand-in through the simulated network.
+ * For each fleet size, the simulator measures the bootstrap, registration, registration update,
+ * read, observe, notification and deregistration latencies, throughput and CPU cost.
+ *
+ * Results are printed on the standard output, one JSON object per line and per phase. The logs of
+ * LwM2MCore are discarded unless the verbose option is set.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <lwm2mcore/lwm2mcore.h>
+#include <lwm2mcore/paramStorage.h>
+#include <lwm2mcore/timer.h>
+#include "dtls_debug.h"
+#include "clientConfig.h"
+#include "simNetwork.h"
+#include "serverStandIn.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Default fleet sizes
+ */
+//--------------------------------------------------------------------------------------------------
+#define FLEETSIM_DEFAULT_SIZES      "10,100,1000"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of fleet sizes in one execution
+ */
+//--------------------------------------------------------------------------------------------------
+#define FLEETSIM_MAX_RUNS           16
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Default timeout of a phase in seconds
+ */
+//--------------------------------------------------------------------------------------------------
+#define FLEETSIM_DEFAULT_TIMEOUT    120
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Client configuration file read by examples/linux/clientConfig.c
+ */
+//--------------------------------------------------------------------------------------------------
+#define FLEETSIM_CLIENT_CONFIG      "clientConfig.txt"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of nanoseconds in a millisecond
+ */
+//--------------------------------------------------------------------------------------------------
+#define NS_PER_MS                   1000000ULL
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Measured phases
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    PHASE_BOOTSTRAP,                ///< Connect -> Bootstrap-Finish acknowledged
+    PHASE_REGISTER,                 ///< Bootstrap-Finish acknowledged -> registration received
+    PHASE_UPDATE,                   ///< lwm2mcore_Update -> registration update received
+    PHASE_READ,                     ///< Read request sent -> response received
+    PHASE_OBSERVE,                  ///< Observe request sent -> response received
+    PHASE_NOTIFY,                   ///< lwm2mcore_NotifyResourceChange -> notification received
+    PHASE_DEREGISTER,               ///< lwm2mcore_DisconnectWithDeregister -> deregistration
+    PHASE_MAX                       ///< Internal value
+}
+Phase_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Simulated client
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    lwm2mcore_Ref_t instanceRef;                ///< LwM2MCore instance
+    uint64_t        startNs[PHASE_MAX];         ///< Start time of each phase, 0 if not started
+    uint64_t        doneNs[PHASE_MAX];          ///< End time of each phase, 0 if not done
+    bool            isFailed;                   ///< Did the stand-in report a failure?
+}
+FleetClient_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Phase names
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* PhaseNames[PHASE_MAX] =
+{
+    "bootstrap",
+    "register",
+    "update",
+    "read",
+    "observe",
+    "notify",
+    "deregister"
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stand-in event ending each phase
+ */
+//--------------------------------------------------------------------------------------------------
+static const standIn_Event_t PhaseEvents[PHASE_MAX] =
+{
+    STANDIN_EVENT_BOOTSTRAP_FINISHED,
+    STANDIN_EVENT_REGISTERED,
+    STANDIN_EVENT_UPDATED,
+    STANDIN_EVENT_READ_DONE,
+    STANDIN_EVENT_OBSERVE_STARTED,
+    STANDIN_EVENT_NOTIFIED,
+    STANDIN_EVENT_DEREGISTERED
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Simulated clients
+ */
+//--------------------------------------------------------------------------------------------------
+static FleetClient_t* ClientsPtr = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of simulated clients
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t ClientCount = 0;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of clients which completed each phase
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t DoneCount[PHASE_MAX];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of clients for which the stand-in reported a failure
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t FailedCount = 0;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Timeout of a phase in ns
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t PhaseTimeoutNs = FLEETSIM_DEFAULT_TIMEOUT * 1000 * NS_PER_MS;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stream on which the results are printed
+ */
+//--------------------------------------------------------------------------------------------------
+static FILE* ResultPtr = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the monotonic time
+ *
+ * @return
+ *  - Time in ns
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t GetTimeNs
+(
+    void
+)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 * NS_PER_MS + (uint64_t)ts.tv_nsec;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the CPU time of the process
+ *
+ * @return
+ *  - CPU time in ns
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t GetProcessCpuNs
+(
+    void
+)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000 * NS_PER_MS + (uint64_t)ts.tv_nsec;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * LwM2MCore event handler: the measurements rely on the stand-in events only
+ *
+ * @return
+ *  - 0
+ */
+//--------------------------------------------------------------------------------------------------
+static int StatusHandler
+(
+    lwm2mcore_Status_t status       ///< [IN] Event status
+)
+{
+    (void)status;
+    return 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stand-in event handler: timestamp the end of the phases
+ */
+//--------------------------------------------------------------------------------------------------
+static void ServerEventHandler
+(
+    uint32_t clientIdx,             ///< [IN] Client index
+    standIn_Event_t event           ///< [IN] Event
+)
+{
+    FleetClient_t* clientPtr;
+    uint64_t nowNs = GetTimeNs();
+    int phase;
+
+    if (ClientCount <= clientIdx)
+    {
+        return;
+    }
+    clientPtr = &ClientsPtr[clientIdx];
+
+    if (STANDIN_EVENT_FAILED == event)
+    {
+        if (!clientPtr->isFailed)
+        {
+            clientPtr->isFailed = true;
+            FailedCount++;
+        }
+        return;
+    }
+
+    for (phase = 0; phase < PHASE_MAX; phase++)
+    {
+        // Events received before the phase started (e.g. spontaneous notifications) are ignored
+        if ((event == PhaseEvents[phase]) && (clientPtr->startNs[phase])
+         && (!clientPtr->doneNs[phase]))
+        {
+            clientPtr->doneNs[phase] = nowNs;
+            DoneCount[phase]++;
+        }
+    }
+
+    // The registration starts as soon as the bootstrap is finished
+    if (STANDIN_EVENT_BOOTSTRAP_FINISHED == event)
+    {
+        clientPtr->startNs[PHASE_REGISTER] = nowNs;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reset the client storage: only the bootstrap server account is provisioned
+ *
+ * @return
+ *  - true on success
+ *  - false on failure
+ */
+//--------------------------------------------------------------------------------------------------
+static bool ResetStorage
+(
+    void
+)
+{
+    clientConfig_t* configPtr = NULL;
+    FILE* filePtr;
+    int param;
+
+    for (param = 0; param < LWM2MCORE_MAX_PARAM; param++)
+    {
+        lwm2mcore_DeleteParam((lwm2mcore_Param_t)param);
+    }
+
+    filePtr = fopen(FLEETSIM_CLIENT_CONFIG, "w");
+    if (!filePtr)
+    {
+        return false;
+    }
+
+    fprintf(filePtr, "[GENERAL]\n");
+    fprintf(filePtr, "ENDPOINT = FLEETSIM\n");
+    fprintf(filePtr, "SN = FLEETSIM\n\n");
+    fprintf(filePtr, "[BOOTSTRAP SECURITY]\n");
+    fprintf(filePtr, "SERVER_URI = coaps://127.0.0.1:%u\n", STANDIN_BS_PORT);
+    fprintf(filePtr, "DEVICE_PKID = %s\n", STANDIN_PSK_IDENTITY);
+    fprintf(filePtr, "SECRET_KEY = %s\n\n", STANDIN_PSK_SECRET_HEX);
+    fprintf(filePtr, "[LWM2M SECURITY]\n");
+    fclose(filePtr);
+
+    ClientConfigFree();
+    return (0 == clientConfigRead(&configPtr)) && (configPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Let the clients and the stand-in run until all the clients completed a phase or failed
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunUntilDone
+(
+    Phase_t phase                   ///< [IN] Phase to complete
+)
+{
+    uint64_t deadlineNs = GetTimeNs() + PhaseTimeoutNs;
+    uint64_t nowNs;
+
+    while ((DoneCount[phase] + FailedCount < ClientCount) && ((nowNs = GetTimeNs()) < deadlineNs))
+    {
+        uint64_t delayMs;
+        struct timespec ts;
+
+        lwm2mcore_ProcessTimers();
+        if (simNetwork_Process())
+        {
+            continue;
+        }
+
+        // Nothing in flight: sleep until the next LwM2MCore timer
+        delayMs = lwm2mcore_GetNextDeadline();
+        if (delayMs > (deadlineNs - nowNs) / NS_PER_MS + 1)
+        {
+            delayMs = (deadlineNs - nowNs) / NS_PER_MS + 1;
+        }
+        if (delayMs)
+        {
+            ts.tv_sec = (time_t)(delayMs / 1000);
+            ts.tv_nsec = (long)((delayMs % 1000) * NS_PER_MS);
+            nanosleep(&ts, NULL);
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Deliver the datagrams still in flight, e.g. the answers to the deregistrations
+ */
+//--------------------------------------------------------------------------------------------------
+static void Drain
+(
+    void
+)
+{
+    lwm2mcore_ProcessTimers();
+    while (simNetwork_Process())
+    {
+        lwm2mcore_ProcessTimers();
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Launch a phase on a client
+ *
+ * @return
+ *  - true on success
+ *  - false on failure
+ */
+//--------------------------------------------------------------------------------------------------
+static bool TriggerPhase
+(
+    Phase_t phase,                  ///< [IN] Phase
+    uint32_t clientIdx              ///< [IN] Client index
+)
+{
+    lwm2mcore_Ref_t instanceRef = ClientsPtr[clientIdx].instanceRef;
+
+    switch (phase)
+    {
+        case PHASE_BOOTSTRAP:
+            return lwm2mcore_Connect(instanceRef);
+
+        case PHASE_UPDATE:
+            return lwm2mcore_Update(instanceRef);
+
+        case PHASE_READ:
+            return standIn_Read(clientIdx);
+
+        case PHASE_OBSERVE:
+            return standIn_Observe(clientIdx);
+
+        case PHASE_NOTIFY:
+            // Device current time
+            return lwm2mcore_NotifyResourceChange(instanceRef, 3, 0, 13);
+
+        case PHASE_DEREGISTER:
+            return lwm2mcore_DisconnectWithDeregister(instanceRef);
+
+        case PHASE_REGISTER:
+        case PHASE_MAX:
+        default:
+            return false;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compare two latencies (qsort callback)
+ *
+ * @return
+ *  - negative, 0 or positive value as for qsort
+ */
+//--------------------------------------------------------------------------------------------------
+static int CompareLatency
+(
+    const void* aPtr,               ///< [IN] First latency
+    const void* bPtr                ///< [IN] Second latency
+)
+{
+    uint64_t a = *(const uint64_t*)aPtr;
+    uint64_t b = *(const uint64_t*)bPtr;
+
+    return (a > b) - (a < b);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get a percentile of sorted latencies
+ *
+ * @return
+ *  - Latency in ms
+ */
+//--------------------------------------------------------------------------------------------------
+static double GetPercentileMs
+(
+    const uint64_t* latenciesPtr,   ///< [IN] Sorted latencies in ns
+    size_t count,                   ///< [IN] Number of latencies
+    unsigned int permille           ///< [IN] Percentile in per mille
+)
+{
+    size_t rank;
+
+    if (!count)
+    {
+        return 0;
+    }
+
+    // Nearest-rank method
+    rank = (permille * count + 999) / 1000;
+    if (!rank)
+    {
+        rank = 1;
+    }
+    return (double)latenciesPtr[rank - 1] / NS_PER_MS;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Print the result of a phase as a JSON object
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReportPhase
+(
+    const char* runPtr,             ///< [IN] Name of the measured run
+    Phase_t phase,                  ///< [IN] Phase
+    uint64_t clientCpuNs,           ///< [IN] CPU time spent by the clients during the run
+    uint64_t serverCpuNs,           ///< [IN] CPU time spent by the stand-in during the run
+    uint32_t cpuOps,                ///< [IN] Number of operations completed during the run
+    uint64_t datagrams,             ///< [IN] Datagrams exchanged during the run
+    uint64_t bytes                  ///< [IN] Bytes exchanged during the run
+)
+{
+    uint64_t* latenciesPtr = (uint64_t*)malloc(sizeof(uint64_t) * ClientCount);
+    uint64_t firstStartNs = UINT64_MAX;
+    uint64_t lastDoneNs = 0;
+    size_t count = 0;
+    double wallMs;
+    uint32_t i;
+
+    if (!latenciesPtr)
+    {
+        return;
+    }
+
+    for (i = 0; i < ClientCount; i++)
+    {
+        FleetClient_t* clientPtr = &ClientsPtr[i];
+
+        if ((!clientPtr->startNs[phase]) || (!clientPtr->doneNs[phase]))
+        {
+            continue;
+        }
+
+        latenciesPtr[count++] = clientPtr->doneNs[phase] - clientPtr->startNs[phase];
+        if (clientPtr->startNs[phase] < firstStartNs)
+        {
+            firstStartNs = clientPtr->startNs[phase];
+        }
+        if (clientPtr->doneNs[phase] > lastDoneNs)
+        {
+            lastDoneNs = clientPtr->doneNs[phase];
+        }
+    }
+
+    qsort(latenciesPtr, count, sizeof(uint64_t), CompareLatency);
+    wallMs = count ? (double)(lastDoneNs - firstStartNs) / NS_PER_MS : 0;
+
+    fprintf(ResultPtr,
+            "{\"clients\":%u,\"run\":\"%s\",\"phase\":\"%s\","
+            "\"completed\":%zu,\"missing\":%zu,\"wall_ms\":%.3f,\"ops_per_s\":%.1f,"
+            "\"p50_ms\":%.3f,\"p90_ms\":%.3f,\"p99_ms\":%.3f,\"max_ms\":%.3f,"
+            "\"client_cpu_us_per_op\":%.1f,\"server_cpu_us_per_op\":%.1f,"
+            "\"datagrams_per_op\":%.2f,\"bytes_per_op\":%.1f}\n",
+            ClientCount,
+            runPtr,
+            PhaseNames[phase],
+            count,
+            (size_t)ClientCount - count,
+            wallMs,
+            (wallMs > 0) ? (double)count * 1000 / wallMs : 0,
+            GetPercentileMs(latenciesPtr, count, 500),
+            GetPercentileMs(latenciesPtr, count, 900),
+            GetPercentileMs(latenciesPtr, count, 990),
+            GetPercentileMs(latenciesPtr, count, 1000),
+            cpuOps ? (double)clientCpuNs / 1000 / cpuOps : 0,
+            cpuOps ? (double)serverCpuNs / 1000 / cpuOps : 0,
+            cpuOps ? (double)datagrams / cpuOps : 0,
+            cpuOps ? (double)bytes / cpuOps : 0);
+    fflush(ResultPtr);
+
+    free(latenciesPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Run a measured phase on all the clients. The run ends with lastPhase, which is the same phase
+ * except for the connection (bootstrap followed by the registration).
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunPhase
+(
+    const char* runPtr,             ///< [IN] Name of the run
+    Phase_t firstPhase,             ///< [IN] Triggered phase
+    Phase_t lastPhase               ///< [IN] Phase ending the run
+)
+{
+    uint64_t cpuNs = GetProcessCpuNs();
+    uint64_t serverCpuNs = standIn_GetCpuTimeNs();
+    uint64_t datagrams;
+    uint64_t bytes;
+    uint64_t endDatagrams;
+    uint64_t endBytes;
+    uint32_t i;
+    int phase;
+
+    simNetwork_GetCounters(&datagrams, &bytes);
+
+    for (i = 0; i < ClientCount; i++)
+    {
+        FleetClient_t* clientPtr = &ClientsPtr[i];
+
+        if (clientPtr->isFailed)
+        {
+            continue;
+        }
+
+        clientPtr->startNs[firstPhase] = GetTimeNs();
+        if (!TriggerPhase(firstPhase, i))
+        {
+            clientPtr->isFailed = true;
+            FailedCount++;
+        }
+    }
+
+    RunUntilDone(lastPhase);
+
+    cpuNs = GetProcessCpuNs() - cpuNs;
+    serverCpuNs = standIn_GetCpuTimeNs() - serverCpuNs;
+    simNetwork_GetCounters(&endDatagrams, &endBytes);
+
+    for (phase = firstPhase; phase <= (int)lastPhase; phase++)
+    {
+        ReportPhase(runPtr,
+                    (Phase_t)phase,
+                    (cpuNs > serverCpuNs) ? cpuNs - serverCpuNs : 0,
+                    serverCpuNs,
+                    DoneCount[lastPhase],
+                    endDatagrams - datagrams,
+                    endBytes - bytes);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Simulate a fleet of clients
+ *
+ * @return
+ *  - true on success
+ *  - false on failure
+ */
+//--------------------------------------------------------------------------------------------------
+static bool SimulateFleet
+(
+    uint32_t clientCount            ///< [IN] Number of clients
+)
+{
+    bool result = false;
+    uint32_t i;
+
+    if (!ResetStorage())
+    {
+        fprintf(stderr, "Unable to reset the client configuration\n");
+        return false;
+    }
+
+    ClientsPtr = (FleetClient_t*)calloc(clientCount, sizeof(FleetClient_t));
+    if ((!ClientsPtr)
+     || (!simNetwork_Init(clientCount, standIn_Receive))
+     || (!standIn_Init(clientCount, ServerEventHandler)))
+    {
+        fprintf(stderr, "Unable to initialize the simulation of %u clients\n", clientCount);
+        goto end;
+    }
+    ClientCount = clientCount;
+    memset(DoneCount, 0, sizeof(DoneCount));
+    FailedCount = 0;
+
+    // All the instances are registered before the first connection: they all start from the same
+    // bootstrap configuration
+    for (i = 0; i < ClientCount; i++)
+    {
+        char endpoint[LWM2MCORE_ENDPOINT_LEN];
+
+        ClientsPtr[i].instanceRef = lwm2mcore_Init(StatusHandler);
+        if (!ClientsPtr[i].instanceRef)
+        {
+            fprintf(stderr, "Unable to create client %u\n", i);
+            goto end;
+        }
+
+        snprintf(endpoint, sizeof(endpoint), "SIM%08u", i);
+        if ((!lwm2mcore_ObjectRegister(ClientsPtr[i].instanceRef, endpoint, NULL, NULL))
+         || (!simNetwork_BindInstance(i, ClientsPtr[i].instanceRef)))
+        {
+            fprintf(stderr, "Unable to register the objects of client %u\n", i);
+            goto end;
+        }
+    }
+
+    RunPhase("connect", PHASE_BOOTSTRAP, PHASE_REGISTER);
+    if (DoneCount[PHASE_REGISTER] != ClientCount)
+    {
+        fprintf(stderr, "%u of %u clients registered\n", DoneCount[PHASE_REGISTER], ClientCount);
+        goto end;
+    }
+    RunPhase("update", PHASE_UPDATE, PHASE_UPDATE);
+    RunPhase("read", PHASE_READ, PHASE_READ);
+    RunPhase("observe", PHASE_OBSERVE, PHASE_OBSERVE);
+    RunPhase("notify", PHASE_NOTIFY, PHASE_NOTIFY);
+    RunPhase("deregister", PHASE_DEREGISTER, PHASE_DEREGISTER);
+    Drain();
+    result = true;
+
+end:
+    if (ClientsPtr)
+    {
+        for (i = 0; i < clientCount; i++)
+        {
+            if (ClientsPtr[i].instanceRef)
+            {
+                lwm2mcore_Free(ClientsPtr[i].instanceRef);
+            }
+        }
+    }
+    standIn_Free();
+    simNetwork_Free();
+    free(ClientsPtr);
+    ClientsPtr = NULL;
+    ClientCount = 0;
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function to display help
+ */
+//--------------------------------------------------------------------------------------------------
+static void PrintUsage
+(
+    void
+)
+{
+    fprintf(stderr, "Usage: lwm2mfleetsim [OPTION]\n");
+    fprintf(stderr, "Simulate fleets of LwM2M clients against an in-process server.\n");
+    fprintf(stderr, "Options:\n");
+    fprintf(stderr, "  -n <sizes>\tComma-separated fleet sizes (default %s)\n",
+            FLEETSIM_DEFAULT_SIZES);
+    fprintf(stderr, "  -t <sec>\tTimeout of a phase in seconds (default %d)\n",
+            FLEETSIM_DEFAULT_TIMEOUT);
+    fprintf(stderr, "  -v\t\tKeep the LwM2MCore logs\n");
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse the fleet sizes
+ *
+ * @return
+ *  - Number of fleet sizes
+ *  - 0 on failure
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t ParseSizes
+(
+    const char* listPtr,            ///< [IN] Comma-separated list
+    uint32_t* sizesPtr              ///< [OUT] Fleet sizes (FLEETSIM_MAX_RUNS entries)
+)
+{
+    size_t count = 0;
+
+    while (*listPtr)
+    {
+        char* endPtr;
+        unsigned long size = strtoul(listPtr, &endPtr, 10);
+
+        if ((endPtr == listPtr) || (!size) || (UINT32_MAX < size) || (FLEETSIM_MAX_RUNS <= count)
+         || ((',' != *endPtr) && ('\0' != *endPtr)))
+        {
+            return 0;
+        }
+
+        sizesPtr[count++] = (uint32_t)size;
+        listPtr = (',' == *endPtr) ? endPtr + 1 : endPtr;
+    }
+    return count;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fleet simulator main
+ *
+ * @return
+ *      - EXIT_FAILURE on failure
+ *      - EXIT_SUCCESS on success
+ */
+//--------------------------------------------------------------------------------------------------
+int main
+(
+    int argc,           ///<[IN] argument count
+    char* argvPtr[]     ///<[IN] argument vector
+)
+{
+    uint32_t sizes[FLEETSIM_MAX_RUNS];
+    size_t sizeCount = ParseSizes(FLEETSIM_DEFAULT_SIZES, sizes);
+    bool isVerbose = false;
+    size_t i;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argvPtr, "n:t:v")))
+    {
+        switch (opt)
+        {
+            case 'n':
+                sizeCount = ParseSizes(optarg, sizes);
+                if (!sizeCount)
+                {
+                    PrintUsage();
+                    return EXIT_FAILURE;
+                }
+                break;
+
+            case 't':
+                if (0 >= atoi(optarg))
+                {
+                    PrintUsage();
+                    return EXIT_FAILURE;
+                }
+                PhaseTimeoutNs = (uint64_t)atoi(optarg) * 1000 * NS_PER_MS;
+                break;
+
+            case 'v':
+                isVerbose = true;
+                break;
+
+            default:
+                PrintUsage();
+                return EXIT_FAILURE;
+        }
+    }
+
+    // The results are printed on the original standard output, the logs are discarded
+    ResultPtr = fdopen(dup(STDOUT_FILENO), "w");
+    if (!ResultPtr)
+    {
+        return EXIT_FAILURE;
+    }
+    if ((!isVerbose) && (!freopen("/dev/null", "w", stdout)))
+    {
+        return EXIT_FAILURE;
+    }
+    dtls_set_log_level(isVerbose ? DTLS_LOG_INFO : DTLS_LOG_WARN);
+
+    for (i = 0; i < sizeCount; i++)
+    {
+        if (!SimulateFleet(sizes[i]))
+        {
+            fclose(ResultPtr);
+            return EXIT_FAILURE;
+        }
+    }
+
+    ClientConfigFree();
+    fclose(ResultPtr);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,1540 @@
+/**
+ * @file serverStandIn.c
+ *
+ * Minimal in-process LwM2M bootstrap and device management server used by the fleet simulator
+ *
+ * The CoAP and TLV codecs below only cover the messages exchanged by the simulator: they are not a
+ * general purpose implementation. The DTLS server side relies on tinyDTLS, as the client side.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "tinydtls.h"
+#include "dtls.h"
+#include "alert.h"
+#include "simNetwork.h"
+#include "serverStandIn.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * CoAP message types
+ */
+//--------------------------------------------------------------------------------------------------
+#define COAP_TYPE_CON               0
+#define COAP_TYPE_NON               1
+#define COAP_TYPE_ACK               2
+#define COAP_TYPE_RST               3
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * CoAP method and response codes (class << 5 | detail)
+ */
+//--------------------------------------------------------------------------------------------------
+#define COAP_EMPTY                  0x00
+#define COAP_GET                    0x01
+#define COAP_POST                   0x02
+#define COAP_PUT                    0x03
+#define COAP_DELETE                 0x04
+#define COAP_201_CREATED            0x41
+#define COAP_202_DELETED            0x42
+#define COAP_204_CHANGED            0x44
+#define COAP_205_CONTENT            0x45
+#define COAP_400_BAD_REQUEST        0x80
+#define COAP_404_NOT_FOUND          0x84
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * CoAP options
+ */
+//--------------------------------------------------------------------------------------------------
+#define COAP_OPTION_OBSERVE         6
+#define COAP_OPTION_LOCATION_PATH   8
+#define COAP_OPTION_URI_PATH        11
+#define COAP_OPTION_CONTENT_FORMAT  12
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * LwM2M TLV content format
+ */
+//--------------------------------------------------------------------------------------------------
+#define LWM2M_CONTENT_TLV           11542
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum size of a CoAP message built by the stand-in
+ */
+//--------------------------------------------------------------------------------------------------
+#define STANDIN_MAX_MESSAGE         512
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum length of a decoded URI path
+ */
+//--------------------------------------------------------------------------------------------------
+#define STANDIN_MAX_PATH            64
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Length of the tokens of the stand-in requests
+ */
+//--------------------------------------------------------------------------------------------------
+#define STANDIN_TOKEN_LEN           4
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum CoAP token length
+ */
+//--------------------------------------------------------------------------------------------------
+#define COAP_MAX_TOKEN_LEN          8
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Short server Id of the device management server
+ */
+//--------------------------------------------------------------------------------------------------
+#define STANDIN_DM_SHORT_ID         123
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Registration lifetime given to the clients: no periodic update during a run
+ */
+//--------------------------------------------------------------------------------------------------
+#define STANDIN_LIFETIME            86400
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum PSK secret length
+ */
+//--------------------------------------------------------------------------------------------------
+#define STANDIN_PSK_MAX_LEN         32
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Request sent by the stand-in and waiting for the client response
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    REQUEST_NONE,                   ///< No request
+    REQUEST_BS_SECURITY,            ///< Bootstrap write of the security object
+    REQUEST_BS_SERVER,              ///< Bootstrap write of the server object
+    REQUEST_BS_FINISH,              ///< Bootstrap-Finish
+    REQUEST_READ,                   ///< Read /3/0/0
+    REQUEST_OBSERVE                 ///< Observe /3/0/13
+}
+StandInRequest_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Server state of a client
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    StandInRequest_t    pendingRequest;                     ///< Request waiting for a response
+    uint16_t            pendingMid;                         ///< Message Id of the request
+    uint8_t             pendingToken[STANDIN_TOKEN_LEN];    ///< Token of the request
+    uint8_t             observeToken[STANDIN_TOKEN_LEN];    ///< Token of the observation
+    bool                isObserved;                         ///< Is the observation established?
+    uint16_t            nextMid;                            ///< Next message Id
+    uint32_t            tokenCount;                         ///< Number of generated tokens
+}
+StandInClient_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Server of the stand-in, selected by its port
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint16_t            port;                               ///< Server port
+    dtls_context_t*     dtlsCtxPtr;                         ///< DTLS context
+}
+StandInServer_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decoded CoAP message
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint8_t             type;                               ///< Message type
+    uint8_t             code;                               ///< Method or response code
+    uint16_t            mid;                                ///< Message Id
+    uint8_t             tokenLen;                           ///< Token length
+    uint8_t             token[COAP_MAX_TOKEN_LEN];          ///< Token
+    char                path[STANDIN_MAX_PATH];             ///< URI path, segments joined by '/'
+    bool                hasObserve;                         ///< Is the observe option present?
+    const uint8_t*      payloadPtr;                         ///< Payload
+    size_t              payloadLen;                         ///< Payload length
+}
+CoapMessage_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * CoAP message under construction
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint8_t             buffer[STANDIN_MAX_MESSAGE];        ///< Encoded message
+    size_t              len;                                ///< Encoded length
+    uint16_t            lastOption;                         ///< Last added option number
+    bool                isValid;                            ///< False if the buffer overflowed
+}
+CoapBuilder_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * TLV payload under construction
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint8_t             buffer[STANDIN_MAX_MESSAGE / 2];    ///< Encoded resources
+    size_t              len;                                ///< Encoded length
+    bool                isValid;                            ///< False if the buffer overflowed
+}
+TlvBuilder_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Servers of the stand-in
+ */
+//--------------------------------------------------------------------------------------------------
+static StandInServer_t Servers[] =
+{
+    { STANDIN_BS_PORT,          NULL },
+    { STANDIN_DM_PORT,          NULL },
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Server state of the clients
+ */
+//--------------------------------------------------------------------------------------------------
+static StandInClient_t* ClientsPtr = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of clients
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t ClientCount = 0;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Event callback
+ */
+//--------------------------------------------------------------------------------------------------
+static standIn_EventCb_t EventCb = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * PSK secret
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t PskSecret[STANDIN_PSK_MAX_LEN];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * PSK secret length
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t PskSecretLen = 0;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * CPU time spent in the stand-in
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t CpuTimeNs = 0;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the CPU time of the calling thread
+ *
+ * @return
+ *  - CPU time in ns
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t GetThreadCpuNs
+(
+    void
+)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Report an event
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReportEvent
+(
+    uint32_t clientIdx,             ///< [IN] Client index
+    standIn_Event_t event           ///< [IN] Event
+)
+{
+    if (EventCb)
+    {
+        EventCb(clientIdx, event);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the server listening on a port
+ *
+ * @return
+ *  - Server
+ *  - NULL if no server listens on the port
+ */
+//--------------------------------------------------------------------------------------------------
+static StandInServer_t* GetServer
+(
+    uint16_t port                   ///< [IN] Server port
+)
+{
+    size_t i;
+
+    for (i = 0; i < sizeof(Servers) / sizeof(Servers[0]); i++)
+    {
+        if (port == Servers[i].port)
+        {
+            return &Servers[i];
+        }
+    }
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Build the DTLS session of a client
+ */
+//--------------------------------------------------------------------------------------------------
+static void GetSession
+(
+    uint32_t clientIdx,             ///< [IN] Client index
+    session_t* sessionPtr           ///< [OUT] DTLS session
+)
+{
+    memset(sessionPtr, 0, sizeof(session_t));
+    sessionPtr->size = sizeof(struct sockaddr_in);
+    simNetwork_GetClientAddress(clientIdx, &(sessionPtr->addr.sin));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert a hexadecimal string to binary
+ *
+ * @return
+ *  - Binary length
+ *  - 0 on failure
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t HexToBinary
+(
+    const char* hexPtr,             ///< [IN] Hexadecimal string
+    uint8_t* bufferPtr,             ///< [OUT] Binary buffer
+    size_t size                     ///< [IN] Binary buffer size
+)
+{
+    size_t len = strlen(hexPtr) / 2;
+    size_t i;
+
+    if ((len > size) || (strlen(hexPtr) % 2))
+    {
+        return 0;
+    }
+
+    for (i = 0; i < len; i++)
+    {
+        unsigned int byte;
+
+        if (1 != sscanf(hexPtr + 2 * i, "%2x", &byte))
+        {
+            return 0;
+        }
+        bufferPtr[i] = (uint8_t)byte;
+    }
+    return len;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read an extended option delta or length
+ *
+ * @return
+ *  - true on success
+ *  - false if the message is malformed
+ */
+//--------------------------------------------------------------------------------------------------
+static bool ReadOptionValue
+(
+    uint8_t nibble,                 ///< [IN] Option delta or length nibble
+    const uint8_t* dataPtr,         ///< [IN] Message
+    size_t len,                     ///< [IN] Message length
+    size_t* posPtr,                 ///< [INOUT] Read position
+    uint32_t* valuePtr              ///< [OUT] Decoded value
+)
+{
+    switch (nibble)
+    {
+        case 13:
+            if (*posPtr + 1 > len)
+            {
+                return false;
+            }
+            *valuePtr = 13 + dataPtr[*posPtr];
+            *posPtr += 1;
+            break;
+
+        case 14:
+            if (*posPtr + 2 > len)
+            {
+                return false;
+            }
+            *valuePtr = 269 + ((uint32_t)dataPtr[*posPtr] << 8) + dataPtr[*posPtr + 1];
+            *posPtr += 2;
+            break;
+
+        case 15:
+            return false;
+
+        default:
+            *valuePtr = nibble;
+            break;
+    }
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode a CoAP message
+ *
+ * @return
+ *  - true on success
+ *  - false if the message is malformed
+ */
+//--------------------------------------------------------------------------------------------------
+static bool CoapDecode
+(
+    const uint8_t* dataPtr,         ///< [IN] Message
+    size_t len,                     ///< [IN] Message length
+    CoapMessage_t* msgPtr           ///< [OUT] Decoded message
+)
+{
+    size_t pos = 4;
+    uint32_t option = 0;
+
+    memset(msgPtr, 0, sizeof(CoapMessage_t));
+
+    if ((4 > len) || (1 != (dataPtr[0] >> 6)) || (COAP_MAX_TOKEN_LEN < (dataPtr[0] & 0x0F)))
+    {
+        return false;
+    }
+
+    msgPtr->type = (dataPtr[0] >> 4) & 0x03;
+    msgPtr->tokenLen = dataPtr[0] & 0x0F;
+    msgPtr->code = dataPtr[1];
+    msgPtr->mid = (uint16_t)((dataPtr[2] << 8) | dataPtr[3]);
+
+    if (pos + msgPtr->tokenLen > len)
+    {
+        return false;
+    }
+    memcpy(msgPtr->token, dataPtr + pos, msgPtr->tokenLen);
+    pos += msgPtr->tokenLen;
+
+    while (pos < len)
+    {
+        uint32_t delta;
+        uint32_t optionLen;
+        uint8_t byte = dataPtr[pos++];
+
+        if (0xFF == byte)
+        {
+            if (pos == len)
+            {
+                return false;
+            }
+            msgPtr->payloadPtr = dataPtr + pos;
+            msgPtr->payloadLen = len - pos;
+            break;
+        }
+
+        if ((!ReadOptionValue(byte >> 4, dataPtr, len, &pos, &delta))
+         || (!ReadOptionValue(byte & 0x0F, dataPtr, len, &pos, &optionLen))
+         || (pos + optionLen > len))
+        {
+            return false;
+        }
+        option += delta;
+
+        switch (option)
+        {
+            case COAP_OPTION_OBSERVE:
+                msgPtr->hasObserve = true;
+                break;
+
+            case COAP_OPTION_URI_PATH:
+            {
+                size_t pathLen = strlen(msgPtr->path);
+
+                if (pathLen + optionLen + 2 > sizeof(msgPtr->path))
+                {
+                    return false;
+                }
+                if (pathLen)
+                {
+                    msgPtr->path[pathLen++] = '/';
+                }
+                memcpy(msgPtr->path + pathLen, dataPtr + pos, optionLen);
+                msgPtr->path[pathLen + optionLen] = '\0';
+            }
+            break;
+
+            default:
+                break;
+        }
+        pos += optionLen;
+    }
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start the encoding of a CoAP message
+ */
+//--------------------------------------------------------------------------------------------------
+static void CoapInit
+(
+    CoapBuilder_t* builderPtr,      ///< [OUT] Message under construction
+    uint8_t type,                   ///< [IN] Message type
+    uint8_t code,                   ///< [IN] Method or response code
+    uint16_t mid,                   ///< [IN] Message Id
+    const uint8_t* tokenPtr,        ///< [IN] Token
+    uint8_t tokenLen                ///< [IN] Token length
+)
+{
+    builderPtr->buffer[0] = (uint8_t)(0x40 | (type << 4) | tokenLen);
+    builderPtr->buffer[1] = code;
+    builderPtr->buffer[2] = (uint8_t)(mid >> 8);
+    builderPtr->buffer[3] = (uint8_t)mid;
+    if (tokenLen)
+    {
+        memcpy(builderPtr->buffer + 4, tokenPtr, tokenLen);
+    }
+    builderPtr->len = 4 + tokenLen;
+    builderPtr->lastOption = 0;
+    builderPtr->isValid = true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Encode an option delta or length nibble and return its extended bytes
+ *
+ * @return
+ *  - Nibble value
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t EncodeOptionValue
+(
+    uint32_t value,                 ///< [IN] Option delta or length
+    uint8_t* extPtr,                ///< [OUT] Extended bytes
+    size_t* extLenPtr               ///< [INOUT] Number of extended bytes
+)
+{
+    if (13 > value)
+    {
+        return (uint8_t)value;
+    }
+    if (269 > value)
+    {
+        extPtr[(*extLenPtr)++] = (uint8_t)(value - 13);
+        return 13;
+    }
+    extPtr[(*extLenPtr)++] = (uint8_t)((value - 269) >> 8);
+    extPtr[(*extLenPtr)++] = (uint8_t)(value - 269);
+    return 14;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add an option to a CoAP message. The options have to be added in increasing order.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CoapAddOption
+(
+    CoapBuilder_t* builderPtr,      ///< [INOUT] Message under construction
+    uint16_t option,                ///< [IN] Option number
+    const uint8_t* valuePtr,        ///< [IN] Option value
+    size_t valueLen                 ///< [IN] Option value length
+)
+{
+    uint8_t ext[4];
+    size_t extLen = 0;
+    uint8_t deltaNibble;
+    uint8_t lenNibble;
+
+    if ((!builderPtr->isValid) || (option < builderPtr->lastOption) || (UINT16_MAX < valueLen))
+    {
+        builderPtr->isValid = false;
+        return;
+    }
+
+    deltaNibble = EncodeOptionValue(option - builderPtr->lastOption, ext, &extLen);
+    lenNibble = EncodeOptionValue((uint32_t)valueLen, ext, &extLen);
+
+    if (builderPtr->len + 1 + extLen + valueLen > sizeof(builderPtr->buffer))
+    {
+        builderPtr->isValid = false;
+        return;
+    }
+
+    builderPtr->buffer[builderPtr->len++] = (uint8_t)((deltaNibble << 4) | lenNibble);
+    memcpy(builderPtr->buffer + builderPtr->len, ext, extLen);
+    builderPtr->len += extLen;
+    memcpy(builderPtr->buffer + builderPtr->len, valuePtr, valueLen);
+    builderPtr->len += valueLen;
+    builderPtr->lastOption = option;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add an unsigned integer option to a CoAP message
+ */
+//--------------------------------------------------------------------------------------------------
+static void CoapAddUintOption
+(
+    CoapBuilder_t* builderPtr,      ///< [INOUT] Message under construction
+    uint16_t option,                ///< [IN] Option number
+    uint32_t value                  ///< [IN] Option value
+)
+{
+    uint8_t bytes[4];
+    size_t len = 0;
+    int shift;
+
+    for (shift = 24; shift >= 0; shift -= 8)
+    {
+        if ((len) || (value >> shift))
+        {
+            bytes[len++] = (uint8_t)(value >> shift);
+        }
+    }
+    CoapAddOption(builderPtr, option, bytes, len);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add the segments of a path ("a/b/c") as options
+ */
+//--------------------------------------------------------------------------------------------------
+static void CoapAddPath
+(
+    CoapBuilder_t* builderPtr,      ///< [INOUT] Message under construction
+    uint16_t option,                ///< [IN] Uri-Path or Location-Path
+    const char* pathPtr             ///< [IN] Path
+)
+{
+    while (*pathPtr)
+    {
+        const char* endPtr = strchr(pathPtr, '/');
+        size_t len = endPtr ? (size_t)(endPtr - pathPtr) : strlen(pathPtr);
+
+        CoapAddOption(builderPtr, option, (const uint8_t*)pathPtr, len);
+        pathPtr += len;
+        if ('/' == *pathPtr)
+        {
+            pathPtr++;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add the payload to a CoAP message. No option can be added afterwards.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CoapSetPayload
+(
+    CoapBuilder_t* builderPtr,      ///< [INOUT] Message under construction
+    const uint8_t* payloadPtr,      ///< [IN] Payload
+    size_t payloadLen               ///< [IN] Payload length
+)
+{
+    if ((!builderPtr->isValid) || (!payloadLen))
+    {
+        return;
+    }
+
+    if (builderPtr->len + 1 + payloadLen > sizeof(builderPtr->buffer))
+    {
+        builderPtr->isValid = false;
+        return;
+    }
+
+    builderPtr->buffer[builderPtr->len++] = 0xFF;
+    memcpy(builderPtr->buffer + builderPtr->len, payloadPtr, payloadLen);
+    builderPtr->len += payloadLen;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a resource to a TLV payload
+ */
+//--------------------------------------------------------------------------------------------------
+static void TlvAddResource
+(
+    TlvBuilder_t* tlvPtr,           ///< [INOUT] TLV under construction
+    uint16_t resourceId,            ///< [IN] Resource Id
+    const uint8_t* valuePtr,        ///< [IN] Resource value
+    size_t valueLen                 ///< [IN] Resource value length
+)
+{
+    uint8_t header[6];
+    size_t headerLen = 1;
+
+    if ((!tlvPtr->isValid) || (UINT16_MAX < valueLen))
+    {
+        tlvPtr->isValid = false;
+        return;
+    }
+
+    // Resource with value, 8 or 16-bit identifier
+    header[0] = 0xC0;
+    if (UINT8_MAX < resourceId)
+    {
+        header[0] |= 0x20;
+        header[headerLen++] = (uint8_t)(resourceId >> 8);
+    }
+    header[headerLen++] = (uint8_t)resourceId;
+
+    if (8 > valueLen)
+    {
+        header[0] |= (uint8_t)valueLen;
+    }
+    else if (UINT8_MAX >= valueLen)
+    {
+        header[0] |= 0x08;
+        header[headerLen++] = (uint8_t)valueLen;
+    }
+    else
+    {
+        header[0] |= 0x10;
+        header[headerLen++] = (uint8_t)(valueLen >> 8);
+        header[headerLen++] = (uint8_t)valueLen;
+    }
+
+    if (tlvPtr->len + headerLen + valueLen > sizeof(tlvPtr->buffer))
+    {
+        tlvPtr->isValid = false;
+        return;
+    }
+
+    memcpy(tlvPtr->buffer + tlvPtr->len, header, headerLen);
+    tlvPtr->len += headerLen;
+    memcpy(tlvPtr->buffer + tlvPtr->len, valuePtr, valueLen);
+    tlvPtr->len += valueLen;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add an integer or boolean resource to a TLV payload
+ */
+//--------------------------------------------------------------------------------------------------
+static void TlvAddInt
+(
+    TlvBuilder_t* tlvPtr,           ///< [INOUT] TLV under construction
+    uint16_t resourceId,            ///< [IN] Resource Id
+    int64_t value                   ///< [IN] Resource value
+)
+{
+    uint8_t bytes[8];
+    size_t len;
+    size_t i;
+
+    if ((INT8_MIN <= value) && (INT8_MAX >= value))
+    {
+        len = 1;
+    }
+    else if ((INT16_MIN <= value) && (INT16_MAX >= value))
+    {
+        len = 2;
+    }
+    else if ((INT32_MIN <= value) && (INT32_MAX >= value))
+    {
+        len = 4;
+    }
+    else
+    {
+        len = 8;
+    }
+
+    for (i = 0; i < len; i++)
+    {
+        bytes[i] = (uint8_t)((uint64_t)value >> (8 * (len - 1 - i)));
+    }
+    TlvAddResource(tlvPtr, resourceId, bytes, len);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a string resource to a TLV payload
+ */
+//--------------------------------------------------------------------------------------------------
+static void TlvAddString
+(
+    TlvBuilder_t* tlvPtr,           ///< [INOUT] TLV under construction
+    uint16_t resourceId,            ///< [IN] Resource Id
+    const char* valuePtr            ///< [IN] Resource value
+)
+{
+    TlvAddResource(tlvPtr, resourceId, (const uint8_t*)valuePtr, strlen(valuePtr));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send a CoAP message to a client
+ *
+ * @return
+ *  - true on success
+ *  - false on failure
+ */
+//--------------------------------------------------------------------------------------------------
+static bool SendMessage
+(
+    uint32_t clientIdx,             ///< [IN] Client index
+    StandInServer_t* serverPtr,     ///< [IN] Sending server
+    CoapBuilder_t* builderPtr       ///< [IN] Message
+)
+{
+    session_t session;
+
+    if (!builderPtr->isValid)
+    {
+        return false;
+    }
+
+    GetSession(clientIdx, &session);
+    return (0 <= dtls_write(serverPtr->dtlsCtxPtr, &session, builderPtr->buffer, builderPtr->len));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Answer a client request, piggybacked in the ACK of a confirmable request
+ *
+ * @return
+ *  - true on success
+ *  - false on failure
+ */
+//--------------------------------------------------------------------------------------------------
+static bool SendResponse
+(
+    uint32_t clientIdx,             ///< [IN] Client index
+    StandInServer_t* serverPtr,     ///< [IN] Answering server
+    const CoapMessage_t* requestPtr,///< [IN] Client request
+    uint8_t code,                   ///< [IN] Response code
+    const char* locationPtr         ///< [IN] Location path, NULL if none
+)
+{
+    CoapBuilder_t builder;
+
+    if (COAP_TYPE_CON == requestPtr->type)
+    {
+        CoapInit(&builder, COAP_TYPE_ACK, code, requestPtr->mid, requestPtr->token,
+                 requestPtr->tokenLen);
+    }
+    else
+    {
+        CoapInit(&builder, COAP_TYPE_NON, code, ClientsPtr[clientIdx].nextMid++, requestPtr->token,
+                 requestPtr->tokenLen);
+    }
+
+    if (locationPtr)
+    {
+        CoapAddPath(&builder, COAP_OPTION_LOCATION_PATH, locationPtr);
+    }
+
+    return SendMessage(clientIdx, serverPtr, &builder);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Acknowledge or reset a confirmable message with an empty message
+ *
+ * @return
+ *  - true on success
+ *  - false on failure
+ */
+//--------------------------------------------------------------------------------------------------
+static bool SendEmpty
+(
+    uint32_t clientIdx,             ///< [IN] Client index
+    StandInServer_t* serverPtr,     ///< [IN] Answering server
+    uint8_t type,                   ///< [IN] COAP_TYPE_ACK or COAP_TYPE_RST
+    uint16_t mid                    ///< [IN] Message Id of the confirmable message
+)
+{
+    CoapBuilder_t builder;
+
+    CoapInit(&builder, type, COAP_EMPTY, mid, NULL, 0);
+    return SendMessage(clientIdx, serverPtr, &builder);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send a confirmable request to a client
+ *
+ * @return
+ *  - true on success
+ *  - false on failure
+ */
+//--------------------------------------------------------------------------------------------------
+static bool SendRequest
+(
+    uint32_t clientIdx,             ///< [IN] Client index
+    StandInServer_t* serverPtr,     ///< [IN] Requesting server
+    StandInRequest_t request,       ///< [IN] Request type
+    uint8_t method,                 ///< [IN] CoAP method
+    const char* pathPtr,            ///< [IN] URI path
+    const TlvBuilder_t* tlvPtr      ///< [IN] TLV payload, NULL if none
+)
+{
+    StandInClient_t* clientPtr = &ClientsPtr[clientIdx];
+    CoapBuilder_t builder;
+    uint32_t token = clientIdx ^ (++clientPtr->tokenCount << 20);
+
+    if ((tlvPtr) && (!tlvPtr->isValid))
+    {
+        return false;
+    }
+
+    clientPtr->pendingRequest = request;
+    clientPtr->pendingMid = clientPtr->nextMid++;
+    clientPtr->pendingToken[0] = (uint8_t)(token >> 24);
+    clientPtr->pendingToken[1] = (uint8_t)(token >> 16);
+    clientPtr->pendingToken[2] = (uint8_t)(token >> 8);
+    clientPtr->pendingToken[3] = (uint8_t)token;
+
+    CoapInit(&builder, COAP_TYPE_CON, method, clientPtr->pendingMid, clientPtr->pendingToken,
+             STANDIN_TOKEN_LEN);
+    if (REQUEST_OBSERVE == request)
+    {
+        CoapAddUintOption(&builder, COAP_OPTION_OBSERVE, 0);
+    }
+    CoapAddPath(&builder, COAP_OPTION_URI_PATH, pathPtr);
+    if (tlvPtr)
+    {
+        CoapAddUintOption(&builder, COAP_OPTION_CONTENT_FORMAT, LWM2M_CONTENT_TLV);
+        CoapSetPayload(&builder, tlvPtr->buffer, tlvPtr->len);
+    }
+
+    if (!SendMessage(clientIdx, serverPtr, &builder))
+    {
+        clientPtr->pendingRequest = REQUEST_NONE;
+        return false;
+    }
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Bootstrap write of the device management server account in the security object (/0/1)
+ *
+ * @return
+ *  - true on success
+ *  - false on failure
+ */
+//--------------------------------------------------------------------------------------------------
+static bool SendBootstrapSecurity
+(
+    uint32_t clientIdx,             ///< [IN] Client index
+    StandInServer_t* serverPtr      ///< [IN] Bootstrap server
+)
+{
+    TlvBuilder_t tlv;
+    char uri[32];
+
+    memset(&tlv, 0, sizeof(tlv));
+    tlv.isValid = true;
+
+    snprintf(uri, sizeof(uri), "coaps://127.0.0.1:%u", STANDIN_DM_PORT);
+
+    // Server URI, bootstrap server, security mode (0: PSK), PSK identity and secret
+    TlvAddString(&tlv, 0, uri);
+    TlvAddInt(&tlv, 1, 0);
+    TlvAddInt(&tlv, 2, 0);
+    TlvAddString(&tlv, 3, STANDIN_PSK_IDENTITY);
+    TlvAddResource(&tlv, 5, PskSecret, PskSecretLen);
+    // Short server Id
+    TlvAddInt(&tlv, 10, STANDIN_DM_SHORT_ID);
+
+    return SendRequest(clientIdx, serverPtr, REQUEST_BS_SECURITY, COAP_PUT, "0/1", &tlv);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Bootstrap write of the device management server object (/1/0)
+ *
+ * @return
+ *  - true on success
+ *  - false on failure
+ */
+//--------------------------------------------------------------------------------------------------
+static bool SendBootstrapServer
+(
+    uint32_t clientIdx,             ///< [IN] Client index
+    StandInServer_t* serverPtr      ///< [IN] Bootstrap server
+)
+{
+    TlvBuilder_t tlv;
+
+    memset(&tlv, 0, sizeof(tlv));
+    tlv.isValid = true;
+
+    // Short server Id, lifetime, binding
+    TlvAddInt(&tlv, 0, STANDIN_DM_SHORT_ID);
+    TlvAddInt(&tlv, 1, STANDIN_LIFETIME);
+    TlvAddString(&tlv, 7, "U");
+
+    return SendRequest(clientIdx, serverPtr, REQUEST_BS_SERVER, COAP_PUT, "1/0", &tlv);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Treat the response of a client to the pending stand-in request
+ */
+//--------------------------------------------------------------------------------------------------
+static void HandleClientResponse
+(
+    uint32_t clientIdx,             ///< [IN] Client index
+    StandInServer_t* serverPtr,     ///< [IN] Server which sent the request
+    const CoapMessage_t* msgPtr     ///< [IN] Client response
+)
+{
+    StandInClient_t* clientPtr = &ClientsPtr[clientIdx];
+    StandInRequest_t request = clientPtr->pendingRequest;
+    bool isSuccess = (2 == (msgPtr->code >> 5));
+
+    clientPtr->pendingRequest = REQUEST_NONE;
+    if (!isSuccess)
+    {
+        ReportEvent(clientIdx, STANDIN_EVENT_FAILED);
+        return;
+    }
+
+    switch (request)
+    {
+        case REQUEST_BS_SECURITY:
+            if (!SendBootstrapServer(clientIdx, serverPtr))
+            {
+                ReportEvent(clientIdx, STANDIN_EVENT_FAILED);
+            }
+            break;
+
+        case REQUEST_BS_SERVER:
+            if (!SendRequest(clientIdx, serverPtr, REQUEST_BS_FINISH, COAP_POST, "bs", NULL))
+            {
+                ReportEvent(clientIdx, STANDIN_EVENT_FAILED);
+            }
+            break;
+
+        case REQUEST_BS_FINISH:
+            ReportEvent(clientIdx, STANDIN_EVENT_BOOTSTRAP_FINISHED);
+            break;
+
+        case REQUEST_READ:
+            ReportEvent(clientIdx, STANDIN_EVENT_READ_DONE);
+            break;
+
+        case REQUEST_OBSERVE:
+            // A 2.05 without observe option means that the client did not accept the observation
+            if (msgPtr->hasObserve)
+            {
+                memcpy(clientPtr->observeToken, clientPtr->pendingToken, STANDIN_TOKEN_LEN);
+                clientPtr->isObserved = true;
+                ReportEvent(clientIdx, STANDIN_EVENT_OBSERVE_STARTED);
+            }
+            else
+            {
+                ReportEvent(clientIdx, STANDIN_EVENT_FAILED);
+            }
+            break;
+
+        case REQUEST_NONE:
+        default:
+            break;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Treat a request sent by a client: bootstrap request, registration, update and deregistration
+ */
+//--------------------------------------------------------------------------------------------------
+static void HandleClientRequest
+(
+    uint32_t clientIdx,             ///< [IN] Client index
+    StandInServer_t* serverPtr,     ///< [IN] Receiving server
+    const CoapMessage_t* msgPtr     ///< [IN] Client request
+)
+{
+    char location[16];
+    char registration[16];
+
+    if (STANDIN_BS_PORT == serverPtr->port)
+    {
+        if ((COAP_POST != msgPtr->code) || (strcmp(msgPtr->path, "bs")))
+        {
+            SendResponse(clientIdx, serverPtr, msgPtr, COAP_404_NOT_FOUND, NULL);
+            return;
+        }
+
+        // Accept the bootstrap request, then provision the device management server
+        SendResponse(clientIdx, serverPtr, msgPtr, COAP_204_CHANGED, NULL);
+        if (!SendBootstrapSecurity(clientIdx, serverPtr))
+        {
+            ReportEvent(clientIdx, STANDIN_EVENT_FAILED);
+        }
+        return;
+    }
+
+    // The registration Id is the client index
+    snprintf(location, sizeof(location), "rd/%x", clientIdx);
+    snprintf(registration, sizeof(registration), "%x", clientIdx);
+
+    if ((COAP_POST == msgPtr->code) && (0 == strcmp(msgPtr->path, "rd")))
+    {
+        SendResponse(clientIdx, serverPtr, msgPtr, COAP_201_CREATED, location);
+        ReportEvent(clientIdx, STANDIN_EVENT_REGISTERED);
+    }
+    else if ((COAP_POST == msgPtr->code) && (0 == strcmp(msgPtr->path, location)))
+    {
+        SendResponse(clientIdx, serverPtr, msgPtr, COAP_204_CHANGED, NULL);
+        ReportEvent(clientIdx, STANDIN_EVENT_UPDATED);
+    }
+    else if ((COAP_DELETE == msgPtr->code) && (0 == strcmp(msgPtr->path, location)))
+    {
+        ClientsPtr[clientIdx].isObserved = false;
+        SendResponse(clientIdx, serverPtr, msgPtr, COAP_202_DELETED, NULL);
+        ReportEvent(clientIdx, STANDIN_EVENT_DEREGISTERED);
+    }
+    else
+    {
+        SendResponse(clientIdx, serverPtr, msgPtr, COAP_400_BAD_REQUEST, NULL);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Treat a CoAP message received from a client
+ */
+//--------------------------------------------------------------------------------------------------
+static void HandleCoap
+(
+    uint32_t clientIdx,             ///< [IN] Client index
+    StandInServer_t* serverPtr,     ///< [IN] Receiving server
+    const uint8_t* dataPtr,         ///< [IN] Message
+    size_t len                      ///< [IN] Message length
+)
+{
+    StandInClient_t* clientPtr = &ClientsPtr[clientIdx];
+    CoapMessage_t msg;
+    bool isPendingToken;
+
+    if (!CoapDecode(dataPtr, len, &msg))
+    {
+        return;
+    }
+
+    // Empty message: separate response announced, reset or ping
+    if (COAP_EMPTY == msg.code)
+    {
+        if ((COAP_TYPE_RST == msg.type) && (REQUEST_NONE != clientPtr->pendingRequest)
+         && (msg.mid == clientPtr->pendingMid))
+        {
+            clientPtr->pendingRequest = REQUEST_NONE;
+            ReportEvent(clientIdx, STANDIN_EVENT_FAILED);
+        }
+        else if (COAP_TYPE_CON == msg.type)
+        {
+            SendEmpty(clientIdx, serverPtr, COAP_TYPE_RST, msg.mid);
+        }
+        return;
+    }
+
+    // Request from the client
+    if (0 == (msg.code >> 5))
+    {
+        HandleClientRequest(clientIdx, serverPtr, &msg);
+        return;
+    }
+
+    // Response from the client: piggybacked in an ACK or separate
+    if (COAP_TYPE_CON == msg.type)
+    {
+        SendEmpty(clientIdx, serverPtr, COAP_TYPE_ACK, msg.mid);
+    }
+
+    isPendingToken = (STANDIN_TOKEN_LEN == msg.tokenLen)
+                     && (0 == memcmp(msg.token, clientPtr->pendingToken, STANDIN_TOKEN_LEN));
+
+    if ((REQUEST_NONE != clientPtr->pendingRequest) && (isPendingToken)
+     && ((COAP_TYPE_ACK != msg.type) || (msg.mid == clientPtr->pendingMid)))
+    {
+        HandleClientResponse(clientIdx, serverPtr, &msg);
+    }
+    else if ((clientPtr->isObserved) && (msg.hasObserve) && (STANDIN_TOKEN_LEN == msg.tokenLen)
+          && (0 == memcmp(msg.token, clientPtr->observeToken, STANDIN_TOKEN_LEN)))
+    {
+        ReportEvent(clientIdx, STANDIN_EVENT_NOTIFIED);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * TinyDTLS callback: send encrypted data to a client
+ *
+ * @return
+ *  - number of bytes that were sent
+ *  - -1 in case of failure
+ */
+//--------------------------------------------------------------------------------------------------
+static int DtlsWrite
+(
+    struct dtls_context_t* ctxPtr,      ///< [IN] DTLS context
+    session_t* sessionPtr,              ///< [IN] DTLS session
+    uint8_t* dataPtr,                   ///< [IN] Buffer to be sent
+    size_t len                          ///< [IN] Buffer length
+)
+{
+    StandInServer_t* serverPtr = (StandInServer_t*)ctxPtr->app;
+    uint32_t clientIdx;
+
+    if (!simNetwork_GetClientIndex(&(sessionPtr->addr.sin), &clientIdx))
+    {
+        return -1;
+    }
+
+    if (!simNetwork_SendToClient(clientIdx, serverPtr->port, dataPtr, len))
+    {
+        return -1;
+    }
+    return (int)len;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * TinyDTLS callback: treat decrypted data received from a client
+ *
+ * @return
+ *  - 0 if data were well handled
+ *  - -1 in case of failure
+ */
+//--------------------------------------------------------------------------------------------------
+static int DtlsRead
+(
+    struct dtls_context_t* ctxPtr,      ///< [IN] DTLS context
+    session_t* sessionPtr,              ///< [IN] DTLS session
+    uint8_t* dataPtr,                   ///< [IN] Buffer
+    size_t len                          ///< [IN] Buffer length
+)
+{
+    uint32_t clientIdx;
+
+    if (!simNetwork_GetClientIndex(&(sessionPtr->addr.sin), &clientIdx))
+    {
+        return -1;
+    }
+
+    HandleCoap(clientIdx, (StandInServer_t*)ctxPtr->app, dataPtr, len);
+    return 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * TinyDTLS callback: DTLS events are not used by the stand-in
+ *
+ * @return
+ *  - ignored
+ */
+//--------------------------------------------------------------------------------------------------
+static int DtlsEvent
+(
+    struct dtls_context_t* ctxPtr,      ///< [IN] DTLS context
+    session_t* sessionPtr,              ///< [IN] DTLS session
+    dtls_alert_level_t level,           ///< [IN] Alert level
+    unsigned short code                 ///< [IN] Alert or event code
+)
+{
+    (void)ctxPtr;
+    (void)sessionPtr;
+    (void)level;
+    (void)code;
+    return 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * TinyDTLS callback: key store of the stand-in. All the clients share the same PSK.
+ *
+ * @return
+ *  - credential length
+ *  - negative value in case of failure (see dtls_alert_t)
+ */
+//--------------------------------------------------------------------------------------------------
+static int DtlsGetPskInfo
+(
+    struct dtls_context_t* ctxPtr,      ///< [IN] DTLS context
+    const session_t* sessionPtr,        ///< [IN] DTLS session
+    dtls_credentials_type_t type,       ///< [IN] Requested credential
+    const unsigned char* idPtr,         ///< [IN] PSK identity given by the client
+    size_t idLen,                       ///< [IN] PSK identity length
+    unsigned char* resultPtr,           ///< [OUT] Buffer in which the credential is written
+    size_t resultLength                 ///< [IN] Maximum credential length
+)
+{
+    (void)ctxPtr;
+    (void)sessionPtr;
+
+    switch (type)
+    {
+        case DTLS_PSK_KEY:
+            if ((strlen(STANDIN_PSK_IDENTITY) != idLen)
+             || (memcmp(idPtr, STANDIN_PSK_IDENTITY, idLen)))
+            {
+                return dtls_alert_fatal_create(DTLS_ALERT_HANDSHAKE_FAILURE);
+            }
+            if (resultLength < PskSecretLen)
+            {
+                return dtls_alert_fatal_create(DTLS_ALERT_INTERNAL_ERROR);
+            }
+            memcpy(resultPtr, PskSecret, PskSecretLen);
+            return (int)PskSecretLen;
+
+        case DTLS_PSK_HINT:
+        case DTLS_PSK_IDENTITY:
+        default:
+            // No identity hint
+            return 0;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * TinyDTLS callbacks of the stand-in
+ */
+//--------------------------------------------------------------------------------------------------
+static dtls_handler_t DtlsHandler =
+{
+    DtlsWrite,                      //.write
+    DtlsRead,                       //.read
+    DtlsEvent,                      //.event
+    DtlsGetPskInfo,                 //.get_psk_info
+    NULL,                           //.get_ecdsa_key
+    NULL                            //.verify_ecdsa_key
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the stand-in for a number of clients
+ *
+ * @return
+ *  - true on success
+ *  - false on failure
+ */
+//--------------------------------------------------------------------------------------------------
+bool standIn_Init
+(
+    uint32_t clientCount,           ///< [IN] Number of simulated clients
+    standIn_EventCb_t eventCb       ///< [IN] Event callback
+)
+{
+    size_t i;
+
+    if ((!clientCount) || (!eventCb))
+    {
+        return false;
+    }
+
+    standIn_Free();
+
+    PskSecretLen = HexToBinary(STANDIN_PSK_SECRET_HEX, PskSecret, sizeof(PskSecret));
+    ClientsPtr = (StandInClient_t*)calloc(clientCount, sizeof(StandInClient_t));
+    if ((!PskSecretLen) || (!ClientsPtr))
+    {
+        standIn_Free();
+        return false;
+    }
+
+    dtls_init();
+    for (i = 0; i < sizeof(Servers) / sizeof(Servers[0]); i++)
+    {
+        Servers[i].dtlsCtxPtr = dtls_new_context(&Servers[i]);
+        if (!Servers[i].dtlsCtxPtr)
+        {
+            standIn_Free();
+            return false;
+        }
+        dtls_set_handler(Servers[i].dtlsCtxPtr, &DtlsHandler);
+    }
+
+    ClientCount = clientCount;
+    EventCb = eventCb;
+    CpuTimeNs = 0;
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release the stand-in
+ */
+//--------------------------------------------------------------------------------------------------
+void standIn_Free
+(
+    void
+)
+{
+    size_t i;
+
+    for (i = 0; i < sizeof(Servers) / sizeof(Servers[0]); i++)
+    {
+        if (Servers[i].dtlsCtxPtr)
+        {
+            dtls_free_context(Servers[i].dtlsCtxPtr);
+            Servers[i].dtlsCtxPtr = NULL;
+        }
+    }
+
+    free(ClientsPtr);
+    ClientsPtr = NULL;
+    ClientCount = 0;
+    EventCb = NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Treat a datagram sent by a client (simNetwork_ServerCb_t)
+ */
+//--------------------------------------------------------------------------------------------------
+void standIn_Receive
+(
+    uint32_t clientIdx,             ///< [IN] Index of the sending client
+    uint16_t serverPort,            ///< [IN] Destination port (selects the server)
+    uint8_t* dataPtr,               ///< [IN] Datagram
+    size_t len                      ///< [IN] Datagram length
+)
+{
+    StandInServer_t* serverPtr = GetServer(serverPort);
+    session_t session;
+    uint64_t startNs;
+
+    if ((!serverPtr) || (ClientCount <= clientIdx))
+    {
+        return;
+    }
+
+    startNs = GetThreadCpuNs();
+    GetSession(clientIdx, &session);
+    dtls_handle_message(serverPtr->dtlsCtxPtr, &session, dataPtr, (int)len);
+
+    CpuTimeNs += GetThreadCpuNs() - startNs;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send a read request of the manufacturer resource (/3/0/0) to a registered client
+ *
+ * @return
+ *  - true if the request is sent
+ *  - false otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+bool standIn_Read
+(
+    uint32_t clientIdx              ///< [IN] Client index
+)
+{
+    uint64_t startNs;
+    bool result;
+
+    if ((ClientCount <= clientIdx) || (REQUEST_NONE != ClientsPtr[clientIdx].pendingRequest))
+    {
+        return false;
+    }
+
+    startNs = GetThreadCpuNs();
+    result = SendRequest(clientIdx,
+                         GetServer(STANDIN_DM_PORT),
+                         REQUEST_READ,
+                         COAP_GET,
+                         "3/0/0",
+                         NULL);
+
+    CpuTimeNs += GetThreadCpuNs() - startNs;
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send an observe request of the current time resource (/3/0/13) to a registered client
+ *
+ * @return
+ *  - true if the request is sent
+ *  - false otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+bool standIn_Observe
+(
+    uint32_t clientIdx              ///< [IN] Client index
+)
+{
+    uint64_t startNs;
+    bool result;
+
+    if ((ClientCount <= clientIdx) || (REQUEST_NONE != ClientsPtr[clientIdx].pendingRequest))
+    {
+        return false;
+    }
+
+    startNs = GetThreadCpuNs();
+    result = SendRequest(clientIdx,
+                         GetServer(STANDIN_DM_PORT),
+                         REQUEST_OBSERVE,
+                         COAP_GET,
+                         "3/0/13",
+                         NULL);
+
+    CpuTimeNs += GetThreadCpuNs() - startNs;
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the CPU time spent in the stand-in
+ *
+ * @return
+ *  - CPU time in ns
+ */
+//--------------------------------------------------------------------------------------------------
+uint64_t standIn_GetCpuTimeNs
+(
+    void
+)
+{
+    return CpuTimeNs;
+}
@@ -0,0 +1,159 @@
+/**
+ * @file serverStandIn.h
+ *
+ * Minimal in-process LwM2M bootstrap and device management server used by the fleet simulator
+ *
+ * The stand-in implements just enough of CoAP and LwM2M to drive the real client code: bootstrap
+ * (request, write of the security and server objects, finish), registration, registration update,
+ * deregistration, read and observe. The bootstrap and device management servers are reached
+ * through DTLS PSK: the session manager only connects to servers with a DTLS context.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+#ifndef __SERVER_STAND_IN_H__
+#define __SERVER_STAND_IN_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Port of the bootstrap server
+ */
+//--------------------------------------------------------------------------------------------------
+#define STANDIN_BS_PORT             5784
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Port of the device management server reached with DTLS
+ */
+//--------------------------------------------------------------------------------------------------
+#define STANDIN_DM_PORT             5684
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * PSK identity expected by the stand-in
+ */
+//--------------------------------------------------------------------------------------------------
+#define STANDIN_PSK_IDENTITY        "fleetsim"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * PSK secret expected by the stand-in, in hexadecimal as in clientConfig.txt
+ */
+//--------------------------------------------------------------------------------------------------
+#define STANDIN_PSK_SECRET_HEX      "466c65657453696d756c61746f72504b"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Events reported by the stand-in for a client
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    STANDIN_EVENT_BOOTSTRAP_FINISHED,       ///< Bootstrap-Finish acknowledged by the client
+    STANDIN_EVENT_REGISTERED,               ///< Registration received
+    STANDIN_EVENT_UPDATED,                  ///< Registration update received
+    STANDIN_EVENT_READ_DONE,                ///< Read response received
+    STANDIN_EVENT_OBSERVE_STARTED,          ///< Observe response received
+    STANDIN_EVENT_NOTIFIED,                 ///< Notification received
+    STANDIN_EVENT_DEREGISTERED,             ///< Deregistration received
+    STANDIN_EVENT_FAILED,                   ///< Error response to a stand-in request
+    STANDIN_EVENT_MAX                       ///< Internal value
+}
+standIn_Event_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Callback reporting the stand-in events
+ */
+//--------------------------------------------------------------------------------------------------
+typedef void (*standIn_EventCb_t)
+(
+    uint32_t clientIdx,             ///< [IN] Client index
+    standIn_Event_t event           ///< [IN] Event
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the stand-in for a number of clients
+ *
+ * @return
+ *  - true on success
+ *  - false on failure
+ */
+//--------------------------------------------------------------------------------------------------
+bool standIn_Init
+(
+    uint32_t clientCount,           ///< [IN] Number of simulated clients
+    standIn_EventCb_t eventCb       ///< [IN] Event callback
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release the stand-in
+ */
+//--------------------------------------------------------------------------------------------------
+void standIn_Free
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Treat a datagram sent by a client (simNetwork_ServerCb_t)
+ */
+//--------------------------------------------------------------------------------------------------
+void standIn_Receive
+(
+    uint32_t clientIdx,             ///< [IN] Index of the sending client
+    uint16_t serverPort,            ///< [IN] Destination port (selects the server)
+    uint8_t* dataPtr,               ///< [IN] Datagram
+    size_t len                      ///< [IN] Datagram length
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send a read request of the manufacturer resource (/3/0/0) to a registered client
+ *
+ * @return
+ *  - true if the request is sent
+ *  - false otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+bool standIn_Read
+(
+    uint32_t clientIdx              ///< [IN] Client index
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send an observe request of the current time resource (/3/0/13) to a registered client
+ *
+ * @return
+ *  - true if the request is sent
+ *  - false otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+bool standIn_Observe
+(
+    uint32_t clientIdx              ///< [IN] Client index
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the CPU time spent in the stand-in
+ *
+ * @return
+ *  - CPU time in ns
+ */
+//--------------------------------------------------------------------------------------------------
+uint64_t standIn_GetCpuTimeNs
+(
+    void
+);
+
+#endif /* __SERVER_STAND_IN_H__ */
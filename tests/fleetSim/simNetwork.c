@@ -0,0 +1,692 @@
+/**
+ * @file simNetwork.c
+ *
+ * In-process datagram network of the fleet simulator
+ *
+ * This file provides the UDP porting functions of LwM2MCore (lwm2mcore_UdpOpen, lwm2mcore_UdpSend,
+ * ...) in place of examples/linux/udp.c. Each simulated client owns a virtual socket and a virtual
+ * address 10.x.y.z:56830. The server stand-in listens on 127.0.0.1, its ports selecting the
+ * bootstrap or the device management server.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <arpa/inet.h>
+#include <platform/types.h>
+#include <lwm2mcore/lwm2mcore.h>
+#include <lwm2mcore/udp.h>
+#include "simNetwork.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * First virtual socket identifier: the socket of client n is SIM_SOCK_BASE + n
+ */
+//--------------------------------------------------------------------------------------------------
+#define SIM_SOCK_BASE           0x10000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Virtual socket returned by lwm2mcore_UdpConnect (only used to resolve the server address)
+ */
+//--------------------------------------------------------------------------------------------------
+#define SIM_CONNECT_SOCK        (SIM_SOCK_BASE - 1)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Local port of the simulated clients
+ */
+//--------------------------------------------------------------------------------------------------
+#define SIM_CLIENT_PORT         56830
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of simulated clients (10.0.0.1 to 10.255.255.254)
+ */
+//--------------------------------------------------------------------------------------------------
+#define SIM_MAX_CLIENTS         0xFFFFFE
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queued datagram
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct _SimDatagram_t
+{
+    struct _SimDatagram_t*  nextPtr;        ///< Next datagram in the queue
+    uint32_t                clientIdx;      ///< Client index
+    uint16_t                serverPort;     ///< Server port
+    size_t                  len;            ///< Datagram length
+    uint8_t                 data[];         ///< Datagram
+}
+SimDatagram_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Datagram queue
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    SimDatagram_t*  headPtr;                ///< First datagram
+    SimDatagram_t*  tailPtr;                ///< Last datagram
+}
+SimQueue_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Simulated client endpoint
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    lwm2mcore_Ref_t             instanceRef;    ///< LwM2MCore instance bound to the client
+    lwm2mcore_SocketConfig_t    socketConfig;   ///< Socket configuration given by LwM2MCore
+    bool                        isOpen;         ///< Is the socket opened?
+}
+SimClient_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Simulated clients
+ */
+//--------------------------------------------------------------------------------------------------
+static SimClient_t* ClientsPtr = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of simulated clients
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t ClientCount = 0;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Server stand-in reception callback
+ */
+//--------------------------------------------------------------------------------------------------
+static simNetwork_ServerCb_t ServerCb = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Datagrams sent by the clients to the server stand-in
+ */
+//--------------------------------------------------------------------------------------------------
+static SimQueue_t ToServerQueue;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Datagrams sent by the server stand-in to the clients
+ */
+//--------------------------------------------------------------------------------------------------
+static SimQueue_t ToClientQueue;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of delivered datagrams
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t DeliveredDatagrams = 0;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of delivered bytes
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t DeliveredBytes = 0;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a datagram to a queue
+ *
+ * @return
+ *  - true on success
+ *  - false on failure
+ */
+//--------------------------------------------------------------------------------------------------
+static bool QueueDatagram
+(
+    SimQueue_t* queuePtr,           ///< [IN] Queue
+    uint32_t clientIdx,             ///< [IN] Client index
+    uint16_t serverPort,            ///< [IN] Server port
+    const uint8_t* dataPtr,         ///< [IN] Datagram
+    size_t len                      ///< [IN] Datagram length
+)
+{
+    SimDatagram_t* datagramPtr;
+
+    if ((!dataPtr) || (!len) || (SIM_NETWORK_MAX_DATAGRAM < len))
+    {
+        return false;
+    }
+
+    datagramPtr = (SimDatagram_t*)malloc(sizeof(SimDatagram_t) + len);
+    if (!datagramPtr)
+    {
+        return false;
+    }
+
+    datagramPtr->nextPtr = NULL;
+    datagramPtr->clientIdx = clientIdx;
+    datagramPtr->serverPort = serverPort;
+    datagramPtr->len = len;
+    memcpy(datagramPtr->data, dataPtr, len);
+
+    if (queuePtr->tailPtr)
+    {
+        queuePtr->tailPtr->nextPtr = datagramPtr;
+    }
+    else
+    {
+        queuePtr->headPtr = datagramPtr;
+    }
+    queuePtr->tailPtr = datagramPtr;
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Detach all the datagrams of a queue
+ *
+ * @return
+ *  - First datagram of the detached list
+ */
+//--------------------------------------------------------------------------------------------------
+static SimDatagram_t* DetachQueue
+(
+    SimQueue_t* queuePtr            ///< [IN] Queue
+)
+{
+    SimDatagram_t* headPtr = queuePtr->headPtr;
+
+    queuePtr->headPtr = NULL;
+    queuePtr->tailPtr = NULL;
+    return headPtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Free a list of datagrams
+ */
+//--------------------------------------------------------------------------------------------------
+static void FreeDatagrams
+(
+    SimDatagram_t* datagramPtr      ///< [IN] First datagram of the list
+)
+{
+    while (datagramPtr)
+    {
+        SimDatagram_t* nextPtr = datagramPtr->nextPtr;
+        free(datagramPtr);
+        datagramPtr = nextPtr;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Build the address of the server stand-in for a port
+ */
+//--------------------------------------------------------------------------------------------------
+static void GetServerAddress
+(
+    uint16_t serverPort,            ///< [IN] Server port
+    struct sockaddr_in* addrPtr     ///< [OUT] Server address
+)
+{
+    memset(addrPtr, 0, sizeof(struct sockaddr_in));
+    addrPtr->sin_family = AF_INET;
+    addrPtr->sin_port = htons(serverPort);
+    addrPtr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the network for a number of clients
+ *
+ * @return
+ *  - true on success
+ *  - false on failure
+ */
+//--------------------------------------------------------------------------------------------------
+bool simNetwork_Init
+(
+    uint32_t clientCount,           ///< [IN] Number of simulated clients
+    simNetwork_ServerCb_t serverCb  ///< [IN] Server stand-in reception callback
+)
+{
+    if ((!clientCount) || (SIM_MAX_CLIENTS < clientCount) || (!serverCb))
+    {
+        return false;
+    }
+
+    simNetwork_Free();
+
+    ClientsPtr = (SimClient_t*)calloc(clientCount, sizeof(SimClient_t));
+    if (!ClientsPtr)
+    {
+        return false;
+    }
+
+    ClientCount = clientCount;
+    ServerCb = serverCb;
+    DeliveredDatagrams = 0;
+    DeliveredBytes = 0;
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release the network and drop the queued datagrams
+ */
+//--------------------------------------------------------------------------------------------------
+void simNetwork_Free
+(
+    void
+)
+{
+    FreeDatagrams(DetachQueue(&ToServerQueue));
+    FreeDatagrams(DetachQueue(&ToClientQueue));
+
+    free(ClientsPtr);
+    ClientsPtr = NULL;
+    ClientCount = 0;
+    ServerCb = NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Bind a LwM2MCore instance to a client
+ *
+ * @return
+ *  - true on success
+ *  - false on failure
+ */
+//--------------------------------------------------------------------------------------------------
+bool simNetwork_BindInstance
+(
+    uint32_t clientIdx,             ///< [IN] Client index
+    lwm2mcore_Ref_t instanceRef     ///< [IN] LwM2MCore instance reference
+)
+{
+    if ((ClientCount <= clientIdx) || (!instanceRef))
+    {
+        return false;
+    }
+
+    ClientsPtr[clientIdx].instanceRef = instanceRef;
+    ClientsPtr[clientIdx].isOpen = false;
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the simulated address of a client
+ */
+//--------------------------------------------------------------------------------------------------
+void simNetwork_GetClientAddress
+(
+    uint32_t clientIdx,             ///< [IN] Client index
+    struct sockaddr_in* addrPtr     ///< [OUT] Client address
+)
+{
+    memset(addrPtr, 0, sizeof(struct sockaddr_in));
+    addrPtr->sin_family = AF_INET;
+    addrPtr->sin_port = htons(SIM_CLIENT_PORT);
+    addrPtr->sin_addr.s_addr = htonl((10u << 24) | (clientIdx + 1));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the client index from a simulated address
+ *
+ * @return
+ *  - true if the address is the one of a client
+ *  - false otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+bool simNetwork_GetClientIndex
+(
+    const struct sockaddr_in* addrPtr,  ///< [IN] Client address
+    uint32_t* clientIdxPtr              ///< [OUT] Client index
+)
+{
+    uint32_t addr;
+
+    if ((!addrPtr) || (!clientIdxPtr) || (AF_INET != addrPtr->sin_family)
+     || (SIM_CLIENT_PORT != ntohs(addrPtr->sin_port)))
+    {
+        return false;
+    }
+
+    addr = ntohl(addrPtr->sin_addr.s_addr);
+    if ((10u != (addr >> 24)) || (!(addr & 0xFFFFFF)) || (ClientCount < (addr & 0xFFFFFF)))
+    {
+        return false;
+    }
+
+    *clientIdxPtr = (addr & 0xFFFFFF) - 1;
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queue a datagram from the server stand-in to a client
+ *
+ * @return
+ *  - true on success
+ *  - false on failure
+ */
+//--------------------------------------------------------------------------------------------------
+bool simNetwork_SendToClient
+(
+    uint32_t clientIdx,             ///< [IN] Destination client index
+    uint16_t serverPort,            ///< [IN] Source port (server which sends the datagram)
+    const uint8_t* dataPtr,         ///< [IN] Datagram
+    size_t len                      ///< [IN] Datagram length
+)
+{
+    if (ClientCount <= clientIdx)
+    {
+        return false;
+    }
+
+    return QueueDatagram(&ToClientQueue, clientIdx, serverPort, dataPtr, len);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Deliver the queued datagrams in both directions
+ *
+ * Only the datagrams queued before the call are delivered: the answers they trigger are delivered
+ * by the next call.
+ *
+ * @return
+ *  - Number of delivered datagrams
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t simNetwork_Process
+(
+    void
+)
+{
+    SimDatagram_t* toServerPtr = DetachQueue(&ToServerQueue);
+    SimDatagram_t* toClientPtr = DetachQueue(&ToClientQueue);
+    SimDatagram_t* datagramPtr;
+    uint32_t count = 0;
+
+    for (datagramPtr = toServerPtr; datagramPtr; datagramPtr = datagramPtr->nextPtr)
+    {
+        ServerCb(datagramPtr->clientIdx,
+                 datagramPtr->serverPort,
+                 datagramPtr->data,
+                 datagramPtr->len);
+        DeliveredBytes += datagramPtr->len;
+        count++;
+    }
+    FreeDatagrams(toServerPtr);
+
+    for (datagramPtr = toClientPtr; datagramPtr; datagramPtr = datagramPtr->nextPtr)
+    {
+        SimClient_t* clientPtr = &ClientsPtr[datagramPtr->clientIdx];
+        struct sockaddr_storage addr;
+
+        // The client closed its socket in the meantime: the datagram is lost
+        if (!clientPtr->isOpen)
+        {
+            continue;
+        }
+
+        memset(&addr, 0, sizeof(addr));
+        GetServerAddress(datagramPtr->serverPort, (struct sockaddr_in*)&addr);
+        lwm2mcore_UdpReceiveCb(datagramPtr->data,
+                               (uint32_t)datagramPtr->len,
+                               &addr,
+                               sizeof(struct sockaddr_in),
+                               clientPtr->socketConfig);
+        DeliveredBytes += datagramPtr->len;
+        count++;
+    }
+    FreeDatagrams(toClientPtr);
+
+    DeliveredDatagrams += count;
+    return count;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the traffic counters of the network
+ */
+//--------------------------------------------------------------------------------------------------
+void simNetwork_GetCounters
+(
+    uint64_t* datagramsPtr,         ///< [OUT] Number of delivered datagrams
+    uint64_t* bytesPtr              ///< [OUT] Number of delivered bytes
+)
+{
+    if (datagramsPtr)
+    {
+        *datagramsPtr = DeliveredDatagrams;
+    }
+    if (bytesPtr)
+    {
+        *bytesPtr = DeliveredBytes;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open a socket to the server
+ * This function is called by the LwM2MCore: the virtual socket of the client bound to the instance
+ * is returned
+ *
+ * @return
+ *  - true on success
+ *  - false on error
+ */
+//--------------------------------------------------------------------------------------------------
+bool lwm2mcore_UdpOpen
+(
+    lwm2mcore_Ref_t instanceRef,            ///< [IN] LWM2M instance reference
+    lwm2mcore_UdpCb_t callback,             ///< [IN] callback for data receipt
+    lwm2mcore_SocketConfig_t* configPtr     ///< [INOUT] socket configuration
+)
+{
+    uint32_t clientIdx;
+    (void)callback;
+
+    if (!configPtr)
+    {
+        return false;
+    }
+
+    for (clientIdx = 0; clientIdx < ClientCount; clientIdx++)
+    {
+        if (instanceRef == ClientsPtr[clientIdx].instanceRef)
+        {
+            // IP v4, as the Linux client
+            configPtr->instanceRef = instanceRef;
+            configPtr->af = AF_INET;
+            configPtr->type = LWM2MCORE_SOCK_DGRAM;
+            configPtr->proto = LWM2MCORE_SOCK_UDP;
+            configPtr->sock = SIM_SOCK_BASE + (int)clientIdx;
+
+            ClientsPtr[clientIdx].socketConfig = *configPtr;
+            ClientsPtr[clientIdx].isOpen = true;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close the socket
+ * This function is called by the LwM2MCore
+ *
+ * @return
+ *  - true on success
+ *  - false on error
+ */
+//--------------------------------------------------------------------------------------------------
+bool lwm2mcore_UdpClose
+(
+    lwm2mcore_SocketConfig_t config        ///< [INOUT] socket configuration
+)
+{
+    uint32_t clientIdx = (uint32_t)(config.sock - SIM_SOCK_BASE);
+
+    if ((SIM_SOCK_BASE > config.sock) || (ClientCount <= clientIdx))
+    {
+        return false;
+    }
+
+    ClientsPtr[clientIdx].isOpen = false;
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close the provided socket
+ * This function is called by the LWM2MCore: the sockets returned by lwm2mcore_UdpConnect are
+ * virtual, nothing to release.
+ */
+//--------------------------------------------------------------------------------------------------
+void lwm2mcore_UdpSocketClose
+(
+    int sockFd             ///< [IN] socket file descriptor
+)
+{
+    (void)sockFd;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send data on a socket
+ * This function is called by the LwM2MCore: the datagram is queued for the server stand-in
+ *
+ * @return
+ *  - Sent data length
+ *  - -1 on error
+ */
+//--------------------------------------------------------------------------------------------------
+ssize_t lwm2mcore_UdpSend
+(
+    int sockfd,                            ///< [IN] Socket Id
+    const void *bufferPtr,                 ///< [IN] Buffer to be sent
+    size_t length,                         ///< [IN] Buffer length to be sent
+    int flags,                             ///< [IN] Flags
+    const struct sockaddr *destAddrPtr,    ///< [IN] Destination address
+    socklen_t addrLen                      ///< [IN] destAddrPtr parameter length
+)
+{
+    uint32_t clientIdx = (uint32_t)(sockfd - SIM_SOCK_BASE);
+    const struct sockaddr_in* sinPtr = (const struct sockaddr_in*)destAddrPtr;
+    (void)flags;
+
+    if ((SIM_SOCK_BASE > sockfd) || (ClientCount <= clientIdx) || (!ClientsPtr[clientIdx].isOpen)
+     || (!sinPtr) || (sizeof(struct sockaddr_in) > addrLen) || (AF_INET != sinPtr->sin_family))
+    {
+        return -1;
+    }
+
+    if (!QueueDatagram(&ToServerQueue,
+                       clientIdx,
+                       ntohs(sinPtr->sin_port),
+                       (const uint8_t*)bufferPtr,
+                       length))
+    {
+        return -1;
+    }
+
+    return (ssize_t)length;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send several datagrams on a socket
+ * This function is called by the LwM2MCore when LWM2MCORE_UDP_BATCH is set: the datagrams are
+ * queued for the server stand-in
+ *
+ * @return
+ *  - Number of sent datagrams
+ *  - -1 on error
+ */
+//--------------------------------------------------------------------------------------------------
+int lwm2mcore_UdpSendBatch
+(
+    int sockfd,                                 ///< [IN] Socket Id
+    const lwm2mcore_UdpDatagram_t* datagramsPtr,///< [IN] Datagrams to be sent
+    size_t count                                ///< [IN] Number of datagrams
+)
+{
+    size_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        if (0 > lwm2mcore_UdpSend(sockfd,
+                                  datagramsPtr[i].bufferPtr,
+                                  datagramsPtr[i].len,
+                                  0,
+                                  (const struct sockaddr*)&(datagramsPtr[i].addr),
+                                  datagramsPtr[i].addrLen))
+        {
+            return (0 == i) ? -1 : (int)i;
+        }
+    }
+    return (int)count;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Connect a socket
+ * This function is called by the LwM2MCore: only numeric IPv4 server addresses are supported
+ *
+ * @return
+ *  - true  on success
+ *  - false on error
+ */
+//--------------------------------------------------------------------------------------------------
+bool lwm2mcore_UdpConnect
+(
+    char* serverAddressPtr,             ///< [IN] Server address URL
+    char* hostPtr,                      ///< [IN] Host
+    char* portPtr,                      ///< [IN] Port
+    int addressFamily,                  ///< [IN] Address family
+    struct sockaddr* saPtr,             ///< [IN] Socket address pointer
+    socklen_t* slPtr,                   ///< [IN] Socket address length
+    int* sockPtr                        ///< [IN] Socket file descriptor
+)
+{
+    struct sockaddr_in addr;
+    char* endPtr = NULL;
+    unsigned long port;
+    (void)serverAddressPtr;
+
+    if ((!hostPtr) || (!portPtr) || (!saPtr) || (!slPtr) || (!sockPtr)
+     || (AF_INET != addressFamily))
+    {
+        return false;
+    }
+
+    port = strtoul(portPtr, &endPtr, 10);
+    if ((endPtr == portPtr) || (*endPtr) || (!port) || (UINT16_MAX < port))
+    {
+        return false;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)port);
+    if (1 != inet_pton(AF_INET, hostPtr, &addr.sin_addr))
+    {
+        return false;
+    }
+
+    memcpy(saPtr, &addr, sizeof(addr));
+    *slPtr = sizeof(addr);
+    *sockPtr = SIM_CONNECT_SOCK;
+    return true;
+}
@@ -0,0 +1,153 @@
+/**
+ * @file simNetwork.h
+ *
+ * In-process datagram network of the fleet simulator
+ *
+ * The network replaces the UDP porting layer of the Linux client: the datagrams of the simulated
+ * clients are queued in memory and delivered to the server stand-in, and conversely. This keeps
+ * the kernel out of the measurements and lets a single process host thousands of clients.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+#ifndef __SIM_NETWORK_H__
+#define __SIM_NETWORK_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <netinet/in.h>
+#include <lwm2mcore/lwm2mcore.h>
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum size of a simulated datagram
+ */
+//--------------------------------------------------------------------------------------------------
+#define SIM_NETWORK_MAX_DATAGRAM    2048
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Callback receiving the datagrams sent by the clients to the server stand-in
+ */
+//--------------------------------------------------------------------------------------------------
+typedef void (*simNetwork_ServerCb_t)
+(
+    uint32_t clientIdx,             ///< [IN] Index of the sending client
+    uint16_t serverPort,            ///< [IN] Destination port (selects the server)
+    uint8_t* dataPtr,               ///< [IN] Datagram
+    size_t len                      ///< [IN] Datagram length
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the network for a number of clients
+ *
+ * @return
+ *  - true on success
+ *  - false on failure
+ */
+//--------------------------------------------------------------------------------------------------
+bool simNetwork_Init
+(
+    uint32_t clientCount,           ///< [IN] Number of simulated clients
+    simNetwork_ServerCb_t serverCb  ///< [IN] Server stand-in reception callback
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release the network and drop the queued datagrams
+ */
+//--------------------------------------------------------------------------------------------------
+void simNetwork_Free
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Bind a LwM2MCore instance to a client
+ *
+ * LwM2MCore opens the socket of a client instance in lwm2mcore_Connect(): the instance reference
+ * given to lwm2mcore_UdpOpen() selects the simulated client which owns the socket.
+ *
+ * @return
+ *  - true on success
+ *  - false on failure
+ */
+//--------------------------------------------------------------------------------------------------
+bool simNetwork_BindInstance
+(
+    uint32_t clientIdx,             ///< [IN] Client index
+    lwm2mcore_Ref_t instanceRef     ///< [IN] LwM2MCore instance reference
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the simulated address of a client
+ */
+//--------------------------------------------------------------------------------------------------
+void simNetwork_GetClientAddress
+(
+    uint32_t clientIdx,             ///< [IN] Client index
+    struct sockaddr_in* addrPtr     ///< [OUT] Client address
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the client index from a simulated address
+ *
+ * @return
+ *  - true if the address is the one of a client
+ *  - false otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+bool simNetwork_GetClientIndex
+(
+    const struct sockaddr_in* addrPtr,  ///< [IN] Client address
+    uint32_t* clientIdxPtr              ///< [OUT] Client index
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queue a datagram from the server stand-in to a client
+ *
+ * @return
+ *  - true on success
+ *  - false on failure
+ */
+//--------------------------------------------------------------------------------------------------
+bool simNetwork_SendToClient
+(
+    uint32_t clientIdx,             ///< [IN] Destination client index
+    uint16_t serverPort,            ///< [IN] Source port (server which sends the datagram)
+    const uint8_t* dataPtr,         ///< [IN] Datagram
+    size_t len                      ///< [IN] Datagram length
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Deliver the queued datagrams in both directions
+ *
+ * @return
+ *  - Number of delivered datagrams
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t simNetwork_Process
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the traffic counters of the network
+ */
+//--------------------------------------------------------------------------------------------------
+void simNetwork_GetCounters
+(
+    uint64_t* datagramsPtr,         ///< [OUT] Number of delivered datagrams
+    uint64_t* bytesPtr              ///< [OUT] Number of delivered bytes
+);
+
+#endif /* __SIM_NETWORK_H__ */
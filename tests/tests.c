@@ -12,21 +12,48 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <sys/stat.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <pthread.h>
 #include "internals.h"
 #include "liblwm2m.h"
 #include <lwm2mcore/lwm2mcore.h>
 #include <lwm2mcore/lwm2mcorePackageDownloader.h>
+#include <lwm2mcore/timer.h>
+#include <lwm2mcore/metrics.h>
+#include <lwm2mcore/log.h>
 #include <objectManager/objects.h>
 #include <sessionManager/sessionManager.h>
+#include <sessionManager/natTimeout.h>
+#include <sessionManager/coapRtt.h>
+#include <sessionManager/blockSize.h>
+#include <sessionManager/dtlsConnection.h>
+#include <sessionManager/udpBatch.h>
 #include <packageDownloader/downloader.h>
 #include <packageDownloader/workspace.h>
 #include <objectManager/objects.h>
 #include <packageDownloader/updateAgent.h>
 #include <lwm2mcore/coapHandlers.h>
+#include <objectManager/handlers.h>
 #include "sampleConfig.h"
 
 #include "download_stub.h"
 #include "download_test.h"
+#include "tinydtls_stub.h"
+#include "udp_stub.h"
+
+// The logs of the tests are all compiled in
+#define LOG_MODULE_LEVEL LWM2MCORE_LOG_LEVEL_DEBUG
+#include <sessionManager/coreLog.h>
+
+#ifdef LWM2MCORE_BINARY_LOGS
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start of the log call site strings section, provided by the linker
+ */
+//--------------------------------------------------------------------------------------------------
+extern const char __start_lwm2mcore_log[];
+#endif
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -415,6 +442,22 @@ static void test_lwm2mcore_Push
 
     TEST_ASSERT(lwm2mcore_Push(Lwm2mcoreRef, payload, strlen((const char*)payload),
                                LWM2MCORE_PUSH_CONTENT_CBOR, &midPtr) == LWM2MCORE_PUSH_INITIATED);
+
+    TEST_ASSERT(false == lwm2mcore_SetPushQueue(NULL, 1024, LWM2MCORE_PUSH_QUEUE_DROP_NEW, false));
+    TEST_ASSERT(false == lwm2mcore_SetPushQueue(Lwm2mcoreRef, 1024, 3, false));
+    TEST_ASSERT(true == lwm2mcore_SetPushQueue(Lwm2mcoreRef, 1024, LWM2MCORE_PUSH_QUEUE_DROP_OLDEST,
+                                               true));
+
+    TEST_ASSERT(lwm2mcore_PushStream(Lwm2mcoreRef, NULL, NULL, LWM2MCORE_PUSH_CONTENT_CBOR,
+                                     &midPtr) == LWM2MCORE_PUSH_FAILED);
+    TEST_ASSERT(lwm2mcore_PushIovec(Lwm2mcoreRef, NULL, 1, LWM2MCORE_PUSH_CONTENT_CBOR,
+                                    &midPtr) == LWM2MCORE_PUSH_FAILED);
+    // The block transaction can not be allocated: the streamed push is released
+    TEST_ASSERT(lwm2mcore_PushIovec(Lwm2mcoreRef, NULL, 0, LWM2MCORE_PUSH_CONTENT_CBOR,
+                                    &midPtr) == LWM2MCORE_PUSH_FAILED);
+    TEST_ASSERT(false == ((smanager_ClientData_t*)Lwm2mcoreRef)->pushStream.isActive);
+    TEST_ASSERT(lwm2mcore_Push(Lwm2mcoreRef, payload, strlen((const char*)payload),
+                               LWM2MCORE_PUSH_CONTENT_CBOR, &midPtr) == LWM2MCORE_PUSH_INITIATED);
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -551,200 +594,2870 @@ void test_smanager_SendSessionEvent
     // No generated event
     TEST_ASSERT(Lwm2mcoreEvent == LWM2MCORE_EVENT_LAST);
 
-    smanager_SendSessionEvent(EVENT_TYPE_RESUMING, EVENT_STATUS_DONE_SUCCESS, NULL);
-    // No generated event
-    TEST_ASSERT(Lwm2mcoreEvent == LWM2MCORE_EVENT_LAST);
+    smanager_SendSessionEvent(EVENT_TYPE_RESUMING, EVENT_STATUS_DONE_SUCCESS, NULL);
+    // No generated event
+    TEST_ASSERT(Lwm2mcoreEvent == LWM2MCORE_EVENT_LAST);
+
+    smanager_SendSessionEvent(EVENT_TYPE_RESUMING, EVENT_STATUS_DONE_FAIL, NULL);
+    // No generated event
+    TEST_ASSERT(Lwm2mcoreEvent == LWM2MCORE_EVENT_LAST);
+
+
+    // Session
+    smanager_SendSessionEvent(EVENT_SESSION, EVENT_STATUS_STARTED, NULL);
+    // No generated event
+    TEST_ASSERT(Lwm2mcoreEvent == LWM2MCORE_EVENT_LAST);
+
+    smanager_SendSessionEvent(EVENT_SESSION, EVENT_STATUS_DONE_SUCCESS, NULL);
+    TEST_ASSERT(Lwm2mcoreEvent == LWM2MCORE_EVENT_SESSION_FINISHED);
+    Lwm2mcoreEvent = LWM2MCORE_EVENT_LAST;
+
+    smanager_SendSessionEvent(EVENT_SESSION, EVENT_STATUS_DONE_FAIL, NULL);
+    TEST_ASSERT(Lwm2mcoreEvent == LWM2MCORE_EVENT_SESSION_FAILED);
+    Lwm2mcoreEvent = LWM2MCORE_EVENT_LAST;
+
+}
+
+//-------------------------------------------------------------------------------------------------
+/**
+ * Test function for lwm2mcore_SendAsyncResponse API
+ */
+//--------------------------------------------------------------------------------------------------
+void test_lwm2mcore_SendAsyncResponse
+(
+    void
+)
+{
+    RequestPtr = (lwm2mcore_CoapRequest_t*)lwm2m_malloc(sizeof(lwm2mcore_CoapRequest_t));
+    if (NULL == RequestPtr)
+    {
+        printf("RequestPtr is NULL!\n");
+        TEST_ASSERT(false);
+    }
+
+    size_t uriLength = strlen("www.sierrawireless.com");
+    RequestPtr->uri = (char*)lwm2m_malloc(uriLength+ 1);
+    strncpy(RequestPtr->uri, "www.sierrawireless.com", uriLength + 1);
+
+    RequestPtr->method = 1;
+
+    RequestPtr->bufferLength = strlen("123456789");
+    RequestPtr->buffer = (uint8_t*)lwm2m_malloc(RequestPtr->bufferLength + 1);
+    strncpy((char*)RequestPtr->buffer, "123456789", RequestPtr->bufferLength + 1);
+
+    RequestPtr->messageId = 100;
+    RequestPtr->tokenLength = 3;
+    memcpy(RequestPtr->token, "hi", 3);
+    RequestPtr->contentType = 1;
+
+    Lwm2mServerResponse.code = COAP_RESOURCE_CHANGED;
+
+    Lwm2mServerResponse.payloadLength = strlen("123456789");
+    Lwm2mServerResponse.payloadPtr = (uint8_t*)lwm2m_malloc(Lwm2mServerResponse.payloadLength + 1);
+    strncpy((char*)Lwm2mServerResponse.payloadPtr, "123456789",
+            Lwm2mServerResponse.payloadLength + 1);
+
+    TEST_ASSERT(lwm2mcore_SendAsyncResponse(Lwm2mcoreRef, RequestPtr, &Lwm2mServerResponse)
+                != false);
+
+    lwm2m_free(RequestPtr->uri);
+    lwm2m_free(RequestPtr->buffer);
+    lwm2m_free(RequestPtr);
+    lwm2m_free(Lwm2mServerResponse.payloadPtr);
+}
+
+//-------------------------------------------------------------------------------------------------
+/**
+ * Test function for lwm2mcore_SetLifetime API
+ */
+//--------------------------------------------------------------------------------------------------
+static void test_lwm2mcore_SetLifetime
+(
+    void
+)
+{
+    /* Invalid value */
+    TEST_ASSERT(lwm2mcore_SetLifetime(0) == LWM2MCORE_ERR_INCORRECT_RANGE);
+
+    /* No DM servers */
+    TEST_ASSERT(lwm2mcore_SetLifetime(8600) == LWM2MCORE_ERR_COMPLETED_OK);
+}
+
+//-------------------------------------------------------------------------------------------------
+/**
+ * Test function for lwm2mcore_UpdateSwList API
+ */
+//--------------------------------------------------------------------------------------------------
+static void test_lwm2mcore_UpdateSwList
+(
+    void
+)
+{
+    int i = 0;
+    char emptyList[] = "";
+    char objectsList[256] = {0};
+    int offset = 0;
+
+    for (i = 0; i < 10; i++)
+    {
+        // Add an object instance each loop
+        offset += snprintf(objectsList + offset, sizeof(objectsList) - offset, "</lwm2m/9/%d>", i);
+        TEST_ASSERT(offset>0);
+
+        // At this point, Lwm2mcoreRef is NULL
+        TEST_ASSERT(lwm2mcore_UpdateSwList(Lwm2mcoreRef, objectsList, strlen(objectsList)) == true);
+
+        test_lwm2mcore_Init();
+
+        TEST_ASSERT(lwm2mcore_UpdateSwList(Lwm2mcoreRef, emptyList, strlen(emptyList)) == true);
+
+        test_lwm2mcore_Free();
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+/**
+ * Test function for lwm2mcore_ResourceRead API
+ */
+//--------------------------------------------------------------------------------------------------
+static void test_lwm2mcore_ResourceRead
+(
+    void
+)
+{
+    bool result;
+    char buffer[256];
+    size_t len = sizeof(buffer);
+
+    memset(buffer, 0, 256);
+
+    // Invalid arguments
+    result = lwm2mcore_ResourceRead(LWM2MCORE_DEVICE_OID,
+                                    0,
+                                    LWM2MCORE_DEVICE_MANUFACTURER_RID,
+                                    0,
+                                    NULL,
+                                    &len);
+    TEST_ASSERT(false == result);
+
+    result = lwm2mcore_ResourceRead(LWM2MCORE_DEVICE_OID,
+                                    0,
+                                    LWM2MCORE_DEVICE_MANUFACTURER_RID,
+                                    0,
+                                    buffer,
+                                    NULL);
+    TEST_ASSERT(false == result);
+
+    // Read a resource which does not support read handler
+    result = lwm2mcore_ResourceRead(LWM2MCORE_DEVICE_OID,
+                                    0,
+                                    LWM2MCORE_DEVICE_REBOOT_RID,
+                                    0,
+                                    buffer,
+                                    &len);
+    TEST_ASSERT(false == result);
+
+    // Read a not supported resource
+    result = lwm2mcore_ResourceRead(LWM2MCORE_DEVICE_OID,
+                                    0,
+                                    255,
+                                    0,
+                                    buffer,
+                                    &len);
+    TEST_ASSERT(false == result);
+
+    // Read a valid resource (string)
+    result = lwm2mcore_ResourceRead(LWM2MCORE_DEVICE_OID,
+                                    0,
+                                    LWM2MCORE_DEVICE_MANUFACTURER_RID,
+                                    0,
+                                    buffer,
+                                    &len);
+    TEST_ASSERT(true == result);
+    TEST_ASSERT(!strcmp(buffer, "Sierra Wireless"));
+    TEST_ASSERT(len == strlen("Sierra Wireless"))  ;
+
+    // Read a valid resource (int)
+    len = sizeof(buffer);
+    result = lwm2mcore_ResourceRead(LWM2MCORE_EXT_CONN_STATS_OID,
+                                    0,
+                                    LWM2MCORE_EXT_CONN_STATS_TEMPERATURE_RID,
+                                    0,
+                                    buffer,
+                                    &len);
+    TEST_ASSERT(true == result);
+    TEST_ASSERT(!strcmp(buffer, "26"));
+    TEST_ASSERT(len == strlen("26"))  ;
+}
+
+//-------------------------------------------------------------------------------------------------
+/**
+ * Test function for lwm2mcore_ResourceRead API when the objects are registered (object and
+ * resource lookup through the registration index)
+ */
+//--------------------------------------------------------------------------------------------------
+static void test_lwm2mcore_ResourceReadRegistered
+(
+    void
+)
+{
+    char buffer[256];
+    size_t len;
+
+    test_lwm2mcore_Init();
+
+    // Read a valid resource (string)
+    memset(buffer, 0, sizeof(buffer));
+    len = sizeof(buffer);
+    TEST_ASSERT(true == lwm2mcore_ResourceRead(LWM2MCORE_DEVICE_OID,
+                                               0,
+                                               LWM2MCORE_DEVICE_MANUFACTURER_RID,
+                                               0,
+                                               buffer,
+                                               &len));
+    TEST_ASSERT(!strcmp(buffer, "Sierra Wireless"));
+
+    // Read a valid resource (int) on the last registered object
+    memset(buffer, 0, sizeof(buffer));
+    len = sizeof(buffer);
+    TEST_ASSERT(true == lwm2mcore_ResourceRead(LWM2MCORE_EXT_CONN_STATS_OID,
+                                               0,
+                                               LWM2MCORE_EXT_CONN_STATS_TEMPERATURE_RID,
+                                               0,
+                                               buffer,
+                                               &len));
+    TEST_ASSERT(!strcmp(buffer, "26"));
+
+    // Not supported resource and not registered object
+    len = sizeof(buffer);
+    TEST_ASSERT(false == lwm2mcore_ResourceRead(LWM2MCORE_DEVICE_OID, 0, 255, 0, buffer, &len));
+    len = sizeof(buffer);
+    TEST_ASSERT(false == lwm2mcore_ResourceRead(12345, 0, 0, 0, buffer, &len));
+
+    test_lwm2mcore_Free();
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test function to read resources served by a typed READ handler
+ */
+//--------------------------------------------------------------------------------------------------
+static void test_lwm2mcore_ResourceReadTypedValue
+(
+    void
+)
+{
+    char buffer[256];
+    size_t len;
+    lwm2mcore_Uri_t uri;
+
+    test_lwm2mcore_Init();
+
+    // Network bearer: enumeration value
+    memset(buffer, 0, sizeof(buffer));
+    len = sizeof(buffer);
+    TEST_ASSERT(true == lwm2mcore_ResourceRead(LWM2MCORE_CONN_MONITOR_OID,
+                                               0,
+                                               LWM2MCORE_CONN_MONITOR_NETWORK_BEARER_RID,
+                                               0,
+                                               buffer,
+                                               &len));
+    TEST_ASSERT(!strcmp(buffer, "2"));
+
+    // Radio signal strength: negative value is kept
+    memset(buffer, 0, sizeof(buffer));
+    len = sizeof(buffer);
+    TEST_ASSERT(true == lwm2mcore_ResourceRead(LWM2MCORE_CONN_MONITOR_OID,
+                                               0,
+                                               LWM2MCORE_CONN_MONITOR_RADIO_SIGNAL_STRENGTH_RID,
+                                               0,
+                                               buffer,
+                                               &len));
+    TEST_ASSERT(!strcmp(buffer, "-83"));
+    TEST_ASSERT(3 == len);
+
+    // Values served from an object snapshot
+    memset(&uri, 0, sizeof(uri));
+    uri.oid = LWM2MCORE_CONN_MONITOR_OID;
+    TEST_ASSERT(LWM2MCORE_ERR_COMPLETED_OK == omanager_SnapshotConnectivityMonitoringObj(&uri,
+                                                                                        true));
+    memset(buffer, 0, sizeof(buffer));
+    len = sizeof(buffer);
+    TEST_ASSERT(true == lwm2mcore_ResourceRead(LWM2MCORE_CONN_MONITOR_OID,
+                                               0,
+                                               LWM2MCORE_CONN_MONITOR_SMCC_RID,
+                                               0,
+                                               buffer,
+                                               &len));
+    TEST_ASSERT(!strcmp(buffer, "208"));
+    memset(buffer, 0, sizeof(buffer));
+    len = sizeof(buffer);
+    TEST_ASSERT(true == lwm2mcore_ResourceRead(LWM2MCORE_CONN_MONITOR_OID,
+                                               0,
+                                               LWM2MCORE_CONN_MONITOR_SMNC_RID,
+                                               0,
+                                               buffer,
+                                               &len));
+    TEST_ASSERT(!strcmp(buffer, "24"));
+    TEST_ASSERT(LWM2MCORE_ERR_COMPLETED_OK == omanager_SnapshotConnectivityMonitoringObj(&uri,
+                                                                                        false));
+    uri.oiid = 1;
+    TEST_ASSERT(LWM2MCORE_ERR_INCORRECT_RANGE ==
+                omanager_SnapshotConnectivityMonitoringObj(&uri, true));
+
+    // Typed handler does not serve other object instances
+    len = sizeof(buffer);
+    TEST_ASSERT(false == lwm2mcore_ResourceRead(LWM2MCORE_CONN_MONITOR_OID,
+                                                1,
+                                                LWM2MCORE_CONN_MONITOR_RADIO_SIGNAL_STRENGTH_RID,
+                                                0,
+                                                buffer,
+                                                &len));
+
+    test_lwm2mcore_Free();
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test function to evaluate resource changes against the observe attributes
+ */
+//--------------------------------------------------------------------------------------------------
+static void test_omanager_CheckNotification
+(
+    void
+)
+{
+    lwm2m_attribute_t attr;
+
+    test_lwm2mcore_Init();
+    memset(&attr, 0, sizeof(attr));
+
+    // First change is notified, an unchanged value is suppressed
+    TEST_ASSERT(OMANAGER_NOTIFY_SEND ==
+                omanager_CheckNotification(LWM2MCORE_CONN_MONITOR_OID,
+                                           0,
+                                           LWM2MCORE_CONN_MONITOR_RADIO_SIGNAL_STRENGTH_RID,
+                                           1,
+                                           OMANAGER_OBSERVE_RESOURCE,
+                                           &attr));
+    TEST_ASSERT(OMANAGER_NOTIFY_SUPPRESS ==
+                omanager_CheckNotification(LWM2MCORE_CONN_MONITOR_OID,
+                                           0,
+                                           LWM2MCORE_CONN_MONITOR_RADIO_SIGNAL_STRENGTH_RID,
+                                           1,
+                                           OMANAGER_OBSERVE_RESOURCE,
+                                           &attr));
+
+    // Unchanged value is notified when the maximum period elapsed
+    attr.mask = LWM2M_ATTR_FLAG_MAX_PERIOD;
+    attr.pmax = 0;
+    TEST_ASSERT(OMANAGER_NOTIFY_SEND ==
+                omanager_CheckNotification(LWM2MCORE_CONN_MONITOR_OID,
+                                           0,
+                                           LWM2MCORE_CONN_MONITOR_RADIO_SIGNAL_STRENGTH_RID,
+                                           1,
+                                           OMANAGER_OBSERVE_RESOURCE,
+                                           &attr));
+
+    // String value served by a legacy READ handler
+    memset(&attr, 0, sizeof(attr));
+    TEST_ASSERT(OMANAGER_NOTIFY_SEND ==
+                omanager_CheckNotification(LWM2MCORE_DEVICE_OID,
+                                           0,
+                                           LWM2MCORE_DEVICE_MANUFACTURER_RID,
+                                           1,
+                                           OMANAGER_OBSERVE_RESOURCE,
+                                           &attr));
+    TEST_ASSERT(OMANAGER_NOTIFY_SUPPRESS ==
+                omanager_CheckNotification(LWM2MCORE_DEVICE_OID,
+                                           0,
+                                           LWM2MCORE_DEVICE_MANUFACTURER_RID,
+                                           1,
+                                           OMANAGER_OBSERVE_RESOURCE,
+                                           &attr));
+
+    // Not registered resource can not be evaluated
+    TEST_ASSERT(OMANAGER_NOTIFY_SEND ==
+                omanager_CheckNotification(12345, 0, 0, 1, OMANAGER_OBSERVE_RESOURCE, &attr));
+
+    // No deferred notification
+    TEST_ASSERT(UINT32_MAX == omanager_ProcessDeferredNotifications(NULL));
+
+    test_lwm2mcore_Free();
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test function to set the batching window of resource change notifications
+ */
+//--------------------------------------------------------------------------------------------------
+static void test_lwm2mcore_SetNotificationWindow
+(
+    void
+)
+{
+    smanager_ClientData_t* dataPtr;
+
+    test_lwm2mcore_Init();
+    dataPtr = (smanager_ClientData_t*)Lwm2mcoreRef;
+
+    TEST_ASSERT(false == lwm2mcore_SetNotificationWindow(NULL, 100));
+    TEST_ASSERT(0 == dataPtr->notifyWindowMs);
+    TEST_ASSERT(true == lwm2mcore_SetNotificationWindow(Lwm2mcoreRef, 250));
+    TEST_ASSERT(250 == dataPtr->notifyWindowMs);
+    TEST_ASSERT(0 == dataPtr->notifyBatchCount);
+
+    test_lwm2mcore_Free();
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test function for several client instances hosted in the same process
+ */
+//--------------------------------------------------------------------------------------------------
+static void test_lwm2mcore_MultiInstance
+(
+    void
+)
+{
+    lwm2mcore_Ref_t firstRef;
+    lwm2mcore_Ref_t secondRef;
+    smanager_ClientData_t* firstPtr;
+    smanager_ClientData_t* secondPtr;
+    char buffer[256];
+    size_t len;
+
+    firstRef = lwm2mcore_Init(EventHandler);
+    secondRef = lwm2mcore_Init(EventHandler);
+    TEST_ASSERT((NULL != firstRef) && (NULL != secondRef) && (firstRef != secondRef));
+    firstPtr = (smanager_ClientData_t*)firstRef;
+    secondPtr = (smanager_ClientData_t*)secondRef;
+
+    strncpy(Endpoint, "SIERRAWIRELESS", sizeof(Endpoint));
+    TEST_ASSERT(lwm2mcore_ObjectRegister(firstRef, Endpoint, NULL, NULL) != 0);
+    TEST_ASSERT(lwm2mcore_ObjectRegister(secondRef, Endpoint, NULL, NULL) != 0);
+
+    // Each instance owns its objects
+    TEST_ASSERT(firstPtr->lwm2mcoreCtxPtr != secondPtr->lwm2mcoreCtxPtr);
+    TEST_ASSERT(firstPtr->lwm2mcoreCtxPtr->registeredObjNb
+                == secondPtr->lwm2mcoreCtxPtr->registeredObjNb);
+    TEST_ASSERT(firstPtr->lwm2mcoreCtxPtr->objectArray[0]
+                != secondPtr->lwm2mcoreCtxPtr->objectArray[0]);
+    TEST_ASSERT(firstPtr->securityObjPtr != secondPtr->securityObjPtr);
+
+    // The functions without instance reference work on the instance given to the last function
+    // with an instance reference
+    lwm2mcore_SetEdmEnabled(firstRef, true);
+    TEST_ASSERT(true == lwm2mcore_IsEdmEnabled());
+    lwm2mcore_SetEdmEnabled(secondRef, false);
+    TEST_ASSERT(false == lwm2mcore_IsEdmEnabled());
+    lwm2mcore_SetEdmEnabled(firstRef, false);
+    lwm2mcore_SetEdmEnabled(secondRef, true);
+    TEST_ASSERT(true == lwm2mcore_IsEdmEnabled());
+
+    // Freeing an instance keeps the selection and the objects of the other one
+    lwm2mcore_Free(firstRef);
+    TEST_ASSERT(true == lwm2mcore_IsEdmEnabled());
+    memset(buffer, 0, sizeof(buffer));
+    len = sizeof(buffer);
+    TEST_ASSERT(true == lwm2mcore_ResourceRead(LWM2MCORE_DEVICE_OID,
+                                               0,
+                                               LWM2MCORE_DEVICE_MANUFACTURER_RID,
+                                               0,
+                                               buffer,
+                                               &len));
+    TEST_ASSERT(!strcmp(buffer, "Sierra Wireless"));
+
+    // No instance is selected once the selected one is freed
+    lwm2mcore_Free(secondRef);
+    TEST_ASSERT(false == lwm2mcore_IsEdmEnabled());
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Search an object registered in Wakaama by the test client
+ *
+ * @return
+ *  - Wakaama object
+ *  - NULL if the object is not registered
+ */
+//--------------------------------------------------------------------------------------------------
+static lwm2m_object_t* FindRegisteredObject
+(
+    uint16_t oid                    ///< [IN] Object Id
+)
+{
+    smanager_ClientData_t* dataPtr = (smanager_ClientData_t*)Lwm2mcoreRef;
+    uint16_t i;
+
+    for (i = 0; i < dataPtr->lwm2mcoreCtxPtr->registeredObjNb; i++)
+    {
+        if (oid == dataPtr->lwm2mcoreCtxPtr->objectArray[i]->objID)
+        {
+            return dataPtr->lwm2mcoreCtxPtr->objectArray[i];
+        }
+    }
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Search the resource of an object registered in LwM2MCore by the test client
+ *
+ * @return
+ *  - Resource
+ *  - NULL if the resource is not registered
+ */
+//--------------------------------------------------------------------------------------------------
+static lwm2mcore_internalResource_t* FindInternalResource
+(
+    uint16_t oid,                   ///< [IN] Object Id
+    uint16_t rid                    ///< [IN] Resource Id
+)
+{
+    smanager_ClientData_t* dataPtr = (smanager_ClientData_t*)Lwm2mcoreRef;
+    lwm2mcore_internalObject_t* objPtr;
+    lwm2mcore_internalResource_t* resourcePtr;
+
+    for (objPtr = DLIST_FIRST(&(dataPtr->lwm2mcoreCtxPtr->objects_list));
+         (NULL != objPtr) && (oid != objPtr->id);
+         objPtr = DLIST_NEXT(objPtr, list));
+    if (NULL == objPtr)
+    {
+        return NULL;
+    }
+
+    for (resourcePtr = DLIST_FIRST(&(objPtr->resource_list));
+         (NULL != resourcePtr) && (rid != resourcePtr->id);
+         resourcePtr = DLIST_NEXT(resourcePtr, list));
+    return resourcePtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allocate the LWM2M data given by Wakaama to read one resource
+ *
+ * @return
+ *  - LWM2M data
+ */
+//--------------------------------------------------------------------------------------------------
+static lwm2m_data_t* NewReadData
+(
+    uint16_t rid                    ///< [IN] Resource Id
+)
+{
+    lwm2m_data_t* dataArrayPtr = lwm2m_data_new(1);
+
+    TEST_ASSERT(NULL != dataArrayPtr);
+    // Drop the value set by the stub
+    lwm2m_free(dataArrayPtr->value.asBuffer.buffer);
+    memset(dataArrayPtr, 0, sizeof(lwm2m_data_t));
+    dataArrayPtr->id = rid;
+    return dataArrayPtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test function to read a resource with multiple instances: the instances are read in the request
+ * arena, or on the heap when they do not fit in it, and handed to Wakaama on the heap
+ */
+//--------------------------------------------------------------------------------------------------
+static void test_omanager_ReadResourceInstances
+(
+    void
+)
+{
+#ifdef LWM2M_OBJECT_33409
+    lwm2m_object_t* objectPtr;
+    lwm2m_data_t* dataArrayPtr;
+    int numData;
+    int i;
+
+    test_lwm2mcore_Init();
+    objectPtr = FindRegisteredObject(LWM2MCORE_PERF_METRICS_OID);
+    TEST_ASSERT(NULL != objectPtr);
+
+    // The histogram instances exceed the arena: heap fallback. The counters fit in the arena.
+    // Read twice to check that the arena is released before each request.
+    for (i = 0; i < 2; i++)
+    {
+        omanager_ReleaseRequestMemory();
+        numData = 1;
+        dataArrayPtr = NewReadData(LWM2MCORE_PERF_METRICS_HISTOGRAM_RID);
+        TEST_ASSERT(COAP_205_CONTENT == objectPtr->readFunc(0, &numData, &dataArrayPtr, objectPtr));
+        TEST_ASSERT(LWM2M_TYPE_MULTIPLE_RESOURCE == dataArrayPtr->type);
+        TEST_ASSERT((LWM2MCORE_METRIC_MAX * LWM2MCORE_METRIC_BUCKETS)
+                    == dataArrayPtr->value.asChildren.count);
+        TEST_ASSERT((LWM2MCORE_METRIC_MAX * LWM2MCORE_METRIC_BUCKETS) - 1
+                    == dataArrayPtr->value.asChildren.array[
+                           dataArrayPtr->value.asChildren.count - 1].id);
+        lwm2m_data_free(numData, dataArrayPtr);
+
+        numData = 1;
+        dataArrayPtr = NewReadData(LWM2MCORE_PERF_METRICS_COUNTERS_RID);
+        TEST_ASSERT(COAP_205_CONTENT == objectPtr->readFunc(0, &numData, &dataArrayPtr, objectPtr));
+        TEST_ASSERT(LWM2M_TYPE_MULTIPLE_RESOURCE == dataArrayPtr->type);
+        TEST_ASSERT(LWM2MCORE_COUNTER_MAX == dataArrayPtr->value.asChildren.count);
+        // Freed by Wakaama: the array handed over must not be in the arena
+        lwm2m_data_free(numData, dataArrayPtr);
+    }
+
+    test_lwm2mcore_Free();
+#endif
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Length of the value served by ReadChunkHandler
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t ChunkValueLen;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Offsets requested to ReadChunkHandler
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t ChunkOffsets[8];
+static size_t ChunkOffsetNb;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Byte of the value served by ReadChunkHandler at an offset
+ */
+//--------------------------------------------------------------------------------------------------
+#define CHUNK_VALUE_BYTE(offset)    ((char)('a' + ((offset) % 26)))
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Chunked READ handler serving a value of ChunkValueLen bytes
+ *
+ * @return
+ *  - LWM2MCORE_ERR_COMPLETED_OK
+ */
+//--------------------------------------------------------------------------------------------------
+static int ReadChunkHandler
+(
+    lwm2mcore_Uri_t* uriPtr,        ///< [IN] Requested resource
+    size_t offset,                  ///< [IN] Offset of the chunk in the resource value
+    char* bufferPtr,                ///< [OUT] Chunk buffer
+    size_t* lenPtr                  ///< [INOUT] Chunk buffer length and returned chunk length
+)
+{
+    size_t i;
+
+    (void)uriPtr;
+    if (ChunkOffsetNb < (sizeof(ChunkOffsets) / sizeof(ChunkOffsets[0])))
+    {
+        ChunkOffsets[ChunkOffsetNb] = offset;
+    }
+    ChunkOffsetNb++;
+
+    if (offset >= ChunkValueLen)
+    {
+        *lenPtr = 0;
+        return LWM2MCORE_ERR_COMPLETED_OK;
+    }
+    if (*lenPtr > (ChunkValueLen - offset))
+    {
+        *lenPtr = ChunkValueLen - offset;
+    }
+    for (i = 0; i < *lenPtr; i++)
+    {
+        bufferPtr[i] = CHUNK_VALUE_BYTE(offset + i);
+    }
+    return LWM2MCORE_ERR_COMPLETED_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test function to read a resource value larger than one chunk
+ */
+//--------------------------------------------------------------------------------------------------
+static void test_omanager_ReadChunks
+(
+    void
+)
+{
+    lwm2m_object_t* objectPtr;
+    lwm2mcore_internalResource_t* resourcePtr;
+    lwm2mcore_internalResource_t savedResource;
+    lwm2m_data_t* dataArrayPtr;
+    int numData;
+    size_t i;
+
+    test_lwm2mcore_Init();
+    objectPtr = FindRegisteredObject(LWM2MCORE_DEVICE_OID);
+    resourcePtr = FindInternalResource(LWM2MCORE_DEVICE_OID, LWM2MCORE_DEVICE_MANUFACTURER_RID);
+    TEST_ASSERT((NULL != objectPtr) && (NULL != resourcePtr));
+
+    // Serve the resource by the chunked READ handler
+    savedResource = *resourcePtr;
+    resourcePtr->read = NULL;
+    resourcePtr->readValue = NULL;
+    resourcePtr->readChunk = ReadChunkHandler;
+
+    // Two full chunks and a partial one: the chunks are reassembled in order
+    ChunkValueLen = (2 * LWM2MCORE_READ_CHUNK_LEN) + 100;
+    ChunkOffsetNb = 0;
+    numData = 1;
+    dataArrayPtr = NewReadData(LWM2MCORE_DEVICE_MANUFACTURER_RID);
+    TEST_ASSERT(COAP_205_CONTENT == objectPtr->readFunc(0, &numData, &dataArrayPtr, objectPtr));
+    TEST_ASSERT(3 == ChunkOffsetNb);
+    TEST_ASSERT(0 == ChunkOffsets[0]);
+    TEST_ASSERT(LWM2MCORE_READ_CHUNK_LEN == ChunkOffsets[1]);
+    TEST_ASSERT((2 * LWM2MCORE_READ_CHUNK_LEN) == ChunkOffsets[2]);
+    TEST_ASSERT(LWM2M_TYPE_STRING == dataArrayPtr->type);
+    TEST_ASSERT(ChunkValueLen == dataArrayPtr->value.asBuffer.length);
+    for (i = 0; i < ChunkValueLen; i++)
+    {
+        TEST_ASSERT(CHUNK_VALUE_BYTE(i) == (char)dataArrayPtr->value.asBuffer.buffer[i]);
+    }
+    lwm2m_data_free(numData, dataArrayPtr);
+
+    // Value length multiple of the chunk length: ended by an empty chunk
+    ChunkValueLen = 2 * LWM2MCORE_READ_CHUNK_LEN;
+    ChunkOffsetNb = 0;
+    numData = 1;
+    dataArrayPtr = NewReadData(LWM2MCORE_DEVICE_MANUFACTURER_RID);
+    TEST_ASSERT(COAP_205_CONTENT == objectPtr->readFunc(0, &numData, &dataArrayPtr, objectPtr));
+    TEST_ASSERT(3 == ChunkOffsetNb);
+    TEST_ASSERT((2 * LWM2MCORE_READ_CHUNK_LEN) == ChunkOffsets[2]);
+    TEST_ASSERT(ChunkValueLen == dataArrayPtr->value.asBuffer.length);
+    TEST_ASSERT(CHUNK_VALUE_BYTE(ChunkValueLen - 1)
+                == (char)dataArrayPtr->value.asBuffer.buffer[ChunkValueLen - 1]);
+    lwm2m_data_free(numData, dataArrayPtr);
+
+    // Value larger than the maximum total length
+    ChunkValueLen = LWM2MCORE_READ_CHUNK_MAX_TOTAL_LEN + 1;
+    numData = 1;
+    dataArrayPtr = NewReadData(LWM2MCORE_DEVICE_MANUFACTURER_RID);
+    TEST_ASSERT(COAP_413_ENTITY_TOO_LARGE == objectPtr->readFunc(0,
+                                                                 &numData,
+                                                                 &dataArrayPtr,
+                                                                 objectPtr));
+    lwm2m_data_free(numData, dataArrayPtr);
+
+    *resourcePtr = savedResource;
+    test_lwm2mcore_Free();
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add an object instance in an object registered in Wakaama
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddObjectInstance
+(
+    lwm2m_object_t* objectPtr,      ///< [IN] Wakaama object
+    uint16_t oiid                   ///< [IN] Object instance Id
+)
+{
+    lwm2m_list_t* instancePtr = (lwm2m_list_t*)lwm2m_malloc(sizeof(lwm2m_list_t));
+
+    TEST_ASSERT(NULL != instancePtr);
+    memset(instancePtr, 0, sizeof(lwm2m_list_t));
+    instancePtr->id = oiid;
+    objectPtr->instanceList = LWM2M_LIST_ADD(objectPtr->instanceList, instancePtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read one resource of an object instance through the Wakaama READ callback
+ *
+ * @return
+ *  - CoAP result of the READ callback
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t ReadOneResource
+(
+    lwm2m_object_t* objectPtr,      ///< [IN] Wakaama object
+    uint16_t oiid,                  ///< [IN] Object instance Id
+    uint16_t rid                    ///< [IN] Resource Id
+)
+{
+    lwm2m_data_t* dataArrayPtr = NewReadData(rid);
+    int numData = 1;
+    uint8_t result = objectPtr->readFunc(oiid, &numData, &dataArrayPtr, objectPtr);
+
+    lwm2m_data_free(numData, dataArrayPtr);
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of calls of the typed READ handler for each object instance
+ */
+//--------------------------------------------------------------------------------------------------
+static int InstanceReadCount[2];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Value served by the typed READ handler for each object instance
+ */
+//--------------------------------------------------------------------------------------------------
+static int InstanceValues[2];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of calls of the typed WRITE handler
+ */
+//--------------------------------------------------------------------------------------------------
+static int InstanceWriteCount;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Typed READ handler serving a value which depends on the object instance
+ *
+ * @return
+ *  - LWM2MCORE_ERR_COMPLETED_OK on success
+ *  - LWM2MCORE_ERR_INCORRECT_RANGE if the object instance is not served
+ */
+//--------------------------------------------------------------------------------------------------
+static int InstanceReadValueHandler
+(
+    lwm2mcore_Uri_t* uriPtr,        ///< [IN] Requested resource
+    lwm2mcore_Value_t* valuePtr     ///< [INOUT] Read value
+)
+{
+    if (uriPtr->oiid >= (sizeof(InstanceReadCount) / sizeof(InstanceReadCount[0])))
+    {
+        return LWM2MCORE_ERR_INCORRECT_RANGE;
+    }
+    InstanceReadCount[uriPtr->oiid]++;
+
+    snprintf(valuePtr->value.asBuffer.bufferPtr,
+             valuePtr->value.asBuffer.len,
+             "instance %u: %d",
+             uriPtr->oiid,
+             InstanceValues[uriPtr->oiid]);
+    valuePtr->value.asBuffer.len = strlen(valuePtr->value.asBuffer.bufferPtr);
+    valuePtr->type = LWM2MCORE_VALUE_BUFFER;
+    return LWM2MCORE_ERR_COMPLETED_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Typed WRITE handler accepting any value
+ *
+ * @return
+ *  - LWM2MCORE_ERR_COMPLETED_OK
+ */
+//--------------------------------------------------------------------------------------------------
+static int InstanceWriteValueHandler
+(
+    lwm2mcore_Uri_t* uriPtr,        ///< [IN] Requested resource
+    const lwm2mcore_Value_t* valuePtr   ///< [IN] Written value
+)
+{
+    (void)uriPtr;
+    (void)valuePtr;
+    InstanceWriteCount++;
+    return LWM2MCORE_ERR_COMPLETED_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of calls of RawReadHandler and RawWriteHandler
+ */
+//--------------------------------------------------------------------------------------------------
+static int RawHandlerCount;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * READ handler serving a raw string value
+ *
+ * @return
+ *  - LWM2MCORE_ERR_COMPLETED_OK
+ */
+//--------------------------------------------------------------------------------------------------
+static int RawReadHandler
+(
+    lwm2mcore_Uri_t* uriPtr,            ///< [IN] Requested resource
+    char* bufferPtr,                    ///< [INOUT] Read value
+    size_t* lenPtr,                     ///< [INOUT] Buffer length, value length
+    valueChangedCallback_t changedCb    ///< [IN] Not used
+)
+{
+    (void)uriPtr;
+    (void)changedCb;
+    RawHandlerCount++;
+    *lenPtr = snprintf(bufferPtr, *lenPtr, "raw");
+    return LWM2MCORE_ERR_COMPLETED_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * WRITE handler accepting any raw value
+ *
+ * @return
+ *  - LWM2MCORE_ERR_COMPLETED_OK
+ */
+//--------------------------------------------------------------------------------------------------
+static int RawWriteHandler
+(
+    lwm2mcore_Uri_t* uriPtr,            ///< [IN] Requested resource
+    char* bufferPtr,                    ///< [IN] Written value
+    size_t len                          ///< [IN] Written value length
+)
+{
+    (void)uriPtr;
+    (void)bufferPtr;
+    (void)len;
+    RawHandlerCount++;
+    return LWM2MCORE_ERR_COMPLETED_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test function for a resource served by both a typed and a raw handler: the typed handlers are
+ * used by every READ and WRITE path
+ */
+//--------------------------------------------------------------------------------------------------
+static void test_omanager_TypedHandlerPrecedence
+(
+    void
+)
+{
+    lwm2m_object_t* objectPtr;
+    lwm2mcore_internalResource_t* resourcePtr;
+    lwm2mcore_internalResource_t savedResource;
+    lwm2mcore_Resource_t savedTableResource;
+    lwm2m_data_t writeData;
+    lwm2m_data_t childData;
+    lwm2m_attribute_t attr;
+    char writeValue[] = "written";
+    char buffer[64];
+    size_t len;
+
+    test_lwm2mcore_Init();
+    objectPtr = FindRegisteredObject(LWM2MCORE_DEVICE_OID);
+    resourcePtr = FindInternalResource(LWM2MCORE_DEVICE_OID, LWM2MCORE_DEVICE_MANUFACTURER_RID);
+    TEST_ASSERT((NULL != objectPtr) && (NULL != resourcePtr));
+    TEST_ASSERT(NULL != resourcePtr->tableResourcePtr);
+
+    // The client read uses the registered table
+    savedTableResource = *(resourcePtr->tableResourcePtr);
+    resourcePtr->tableResourcePtr->read = RawReadHandler;
+    resourcePtr->tableResourcePtr->readValue = InstanceReadValueHandler;
+    resourcePtr->tableResourcePtr->readChunk = NULL;
+
+    savedResource = *resourcePtr;
+    resourcePtr->read = RawReadHandler;
+    resourcePtr->write = RawWriteHandler;
+    resourcePtr->readValue = InstanceReadValueHandler;
+    resourcePtr->writeValue = InstanceWriteValueHandler;
+    resourcePtr->readChunk = NULL;
+    resourcePtr->cacheTtl = LWM2MCORE_CACHE_NEVER;
+    memset(InstanceReadCount, 0, sizeof(InstanceReadCount));
+    InstanceWriteCount = 0;
+    RawHandlerCount = 0;
+    InstanceValues[0] = 7;
+
+    // Server READ
+    TEST_ASSERT(COAP_205_CONTENT == ReadOneResource(objectPtr, 0, resourcePtr->id));
+    TEST_ASSERT(1 == InstanceReadCount[0]);
+
+    // Client read
+    memset(buffer, 0, sizeof(buffer));
+    len = sizeof(buffer);
+    TEST_ASSERT(true == lwm2mcore_ResourceRead(LWM2MCORE_DEVICE_OID,
+                                               0,
+                                               LWM2MCORE_DEVICE_MANUFACTURER_RID,
+                                               0,
+                                               buffer,
+                                               &len));
+    TEST_ASSERT(!strcmp(buffer, "instance 0: 7"));
+    TEST_ASSERT(2 == InstanceReadCount[0]);
+
+    // Read of the value to notify
+    memset(&attr, 0, sizeof(attr));
+    TEST_ASSERT(OMANAGER_NOTIFY_SEND ==
+                omanager_CheckNotification(LWM2MCORE_DEVICE_OID,
+                                           0,
+                                           LWM2MCORE_DEVICE_MANUFACTURER_RID,
+                                           1,
+                                           OMANAGER_OBSERVE_RESOURCE,
+                                           &attr));
+    TEST_ASSERT(3 == InstanceReadCount[0]);
+
+    // Server WRITE
+    memset(&writeData, 0, sizeof(writeData));
+    writeData.id = resourcePtr->id;
+    writeData.type = LWM2M_TYPE_STRING;
+    writeData.value.asBuffer.buffer = (uint8_t*)writeValue;
+    writeData.value.asBuffer.length = strlen(writeValue);
+    TEST_ASSERT(COAP_204_CHANGED == objectPtr->writeFunc(0, 1, &writeData, objectPtr));
+    TEST_ASSERT(1 == InstanceWriteCount);
+
+    // Server READ and WRITE of the instances of a multiple resource
+    resourcePtr->maxInstCount = 2;
+    TEST_ASSERT(COAP_205_CONTENT == ReadOneResource(objectPtr, 0, resourcePtr->id));
+    TEST_ASSERT(5 == InstanceReadCount[0]);
+    childData = writeData;
+    childData.id = 0;
+    memset(&writeData, 0, sizeof(writeData));
+    writeData.id = resourcePtr->id;
+    writeData.type = LWM2M_TYPE_MULTIPLE_RESOURCE;
+    writeData.value.asChildren.count = 1;
+    writeData.value.asChildren.array = &childData;
+    TEST_ASSERT(COAP_204_CHANGED == objectPtr->writeFunc(0, 1, &writeData, objectPtr));
+    TEST_ASSERT(2 == InstanceWriteCount);
+
+    TEST_ASSERT(0 == RawHandlerCount);
+
+    savedResource.statePtr = resourcePtr->statePtr;
+    *resourcePtr = savedResource;
+    *(resourcePtr->tableResourcePtr) = savedTableResource;
+    test_lwm2mcore_Free();
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test function for the cache of the resource read values: each object instance has its own
+ * cached value, invalidated by a WRITE on this instance or when its validity elapses
+ */
+//--------------------------------------------------------------------------------------------------
+static void test_omanager_ResourceCache
+(
+    void
+)
+{
+    lwm2m_object_t* objectPtr;
+    lwm2mcore_internalResource_t* resourcePtr;
+    lwm2mcore_internalResource_t savedResource;
+    lwm2m_data_t writeData;
+    char writeValue[] = "written";
+
+    test_lwm2mcore_Init();
+    objectPtr = FindRegisteredObject(LWM2MCORE_DEVICE_OID);
+    resourcePtr = FindInternalResource(LWM2MCORE_DEVICE_OID, LWM2MCORE_DEVICE_MANUFACTURER_RID);
+    TEST_ASSERT((NULL != objectPtr) && (NULL != resourcePtr));
+    AddObjectInstance(objectPtr, 1);
+
+    // Serve the resource by a typed handler, with a short cache validity
+    savedResource = *resourcePtr;
+    resourcePtr->read = NULL;
+    resourcePtr->write = NULL;
+    resourcePtr->readValue = InstanceReadValueHandler;
+    resourcePtr->writeValue = InstanceWriteValueHandler;
+    resourcePtr->readChunk = NULL;
+    resourcePtr->cacheTtl = 200;
+    memset(InstanceReadCount, 0, sizeof(InstanceReadCount));
+
+    // The second READ of an instance is served from the cache
+    TEST_ASSERT(COAP_205_CONTENT == ReadOneResource(objectPtr, 0, resourcePtr->id));
+    TEST_ASSERT(COAP_205_CONTENT == ReadOneResource(objectPtr, 0, resourcePtr->id));
+    TEST_ASSERT(1 == InstanceReadCount[0]);
+
+    // Reading another instance does not use nor evict the cached value of the first one
+    TEST_ASSERT(COAP_205_CONTENT == ReadOneResource(objectPtr, 1, resourcePtr->id));
+    TEST_ASSERT(1 == InstanceReadCount[1]);
+    TEST_ASSERT(COAP_205_CONTENT == ReadOneResource(objectPtr, 0, resourcePtr->id));
+    TEST_ASSERT(COAP_205_CONTENT == ReadOneResource(objectPtr, 1, resourcePtr->id));
+    TEST_ASSERT(1 == InstanceReadCount[0]);
+    TEST_ASSERT(1 == InstanceReadCount[1]);
+
+    // A WRITE invalidates the cached value of the written instance only
+    memset(&writeData, 0, sizeof(writeData));
+    writeData.id = resourcePtr->id;
+    writeData.type = LWM2M_TYPE_STRING;
+    writeData.value.asBuffer.buffer = (uint8_t*)writeValue;
+    writeData.value.asBuffer.length = strlen(writeValue);
+    TEST_ASSERT(COAP_204_CHANGED == objectPtr->writeFunc(1, 1, &writeData, objectPtr));
+    TEST_ASSERT(COAP_205_CONTENT == ReadOneResource(objectPtr, 1, resourcePtr->id));
+    TEST_ASSERT(COAP_205_CONTENT == ReadOneResource(objectPtr, 0, resourcePtr->id));
+    TEST_ASSERT(1 == InstanceReadCount[0]);
+    TEST_ASSERT(2 == InstanceReadCount[1]);
+
+    // The cached values expire after their validity
+    usleep((resourcePtr->cacheTtl + 50) * 1000);
+    TEST_ASSERT(COAP_205_CONTENT == ReadOneResource(objectPtr, 0, resourcePtr->id));
+    TEST_ASSERT(COAP_205_CONTENT == ReadOneResource(objectPtr, 1, resourcePtr->id));
+    TEST_ASSERT(2 == InstanceReadCount[0]);
+    TEST_ASSERT(3 == InstanceReadCount[1]);
+
+    // Explicit invalidation of one instance
+    omanager_InvalidateResourceCache(LWM2MCORE_DEVICE_OID, 0, resourcePtr->id);
+    TEST_ASSERT(COAP_205_CONTENT == ReadOneResource(objectPtr, 0, resourcePtr->id));
+    TEST_ASSERT(COAP_205_CONTENT == ReadOneResource(objectPtr, 1, resourcePtr->id));
+    TEST_ASSERT(3 == InstanceReadCount[0]);
+    TEST_ASSERT(3 == InstanceReadCount[1]);
+
+    // The cached values are released with the resource
+    savedResource.statePtr = resourcePtr->statePtr;
+    *resourcePtr = savedResource;
+    test_lwm2mcore_Free();
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Object instances reported by NotifyDeferredCb
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t NotifiedInstances;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Callback of the deferred notifications: record the notified object instances
+ */
+//--------------------------------------------------------------------------------------------------
+static void NotifyDeferredCb
+(
+    uint16_t oid,       ///< [IN] Object Id
+    uint16_t oiid,      ///< [IN] Object instance Id
+    uint16_t rid        ///< [IN] Resource Id
+)
+{
+    TEST_ASSERT(LWM2MCORE_DEVICE_OID == oid);
+    TEST_ASSERT(LWM2MCORE_DEVICE_MANUFACTURER_RID == rid);
+    TEST_ASSERT(32 > oiid);
+    NotifiedInstances |= (1u << oiid);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test function for the notification of a resource of two object instances: the last notified
+ * value and the deferred notification are kept for each instance
+ */
+//--------------------------------------------------------------------------------------------------
+static void test_omanager_CheckNotificationInstances
+(
+    void
+)
+{
+    smanager_ClientData_t* dataPtr;
+    lwm2mcore_internalResource_t* resourcePtr;
+    lwm2mcore_internalResource_t savedResource;
+    lwm2mcore_resourceState_t* statePtr;
+    lwm2mcore_notifyState_t* notifyPtr;
+    lwm2m_attribute_t attr;
+    uint16_t rid = LWM2MCORE_DEVICE_MANUFACTURER_RID;
+
+    test_lwm2mcore_Init();
+    dataPtr = (smanager_ClientData_t*)Lwm2mcoreRef;
+    resourcePtr = FindInternalResource(LWM2MCORE_DEVICE_OID, rid);
+    TEST_ASSERT(NULL != resourcePtr);
+
+    savedResource = *resourcePtr;
+    resourcePtr->read = NULL;
+    resourcePtr->readValue = InstanceReadValueHandler;
+    resourcePtr->readChunk = NULL;
+    InstanceValues[0] = 1;
+    InstanceValues[1] = 1;
+    memset(&attr, 0, sizeof(attr));
+
+    // First value of each instance is notified, then the unchanged values are suppressed
+    TEST_ASSERT(OMANAGER_NOTIFY_SEND ==
+                omanager_CheckNotification(LWM2MCORE_DEVICE_OID,
+                                           0,
+                                           rid,
+                                           1,
+                                           OMANAGER_OBSERVE_RESOURCE,
+                                           &attr));
+    TEST_ASSERT(OMANAGER_NOTIFY_SEND ==
+                omanager_CheckNotification(LWM2MCORE_DEVICE_OID,
+                                           1,
+                                           rid,
+                                           1,
+                                           OMANAGER_OBSERVE_RESOURCE,
+                                           &attr));
+    TEST_ASSERT(OMANAGER_NOTIFY_SUPPRESS ==
+                omanager_CheckNotification(LWM2MCORE_DEVICE_OID,
+                                           0,
+                                           rid,
+                                           1,
+                                           OMANAGER_OBSERVE_RESOURCE,
+                                           &attr));
+    TEST_ASSERT(OMANAGER_NOTIFY_SUPPRESS ==
+                omanager_CheckNotification(LWM2MCORE_DEVICE_OID,
+                                           1,
+                                           rid,
+                                           1,
+                                           OMANAGER_OBSERVE_RESOURCE,
+                                           &attr));
+
+    // A change of one instance is compared to the value notified for this instance
+    InstanceValues[1] = 2;
+    TEST_ASSERT(OMANAGER_NOTIFY_SEND ==
+                omanager_CheckNotification(LWM2MCORE_DEVICE_OID,
+                                           1,
+                                           rid,
+                                           1,
+                                           OMANAGER_OBSERVE_RESOURCE,
+                                           &attr));
+    TEST_ASSERT(OMANAGER_NOTIFY_SUPPRESS ==
+                omanager_CheckNotification(LWM2MCORE_DEVICE_OID,
+                                           0,
+                                           rid,
+                                           1,
+                                           OMANAGER_OBSERVE_RESOURCE,
+                                           &attr));
+
+    // Changes of both instances within the minimum period are deferred separately
+    attr.mask = LWM2M_ATTR_FLAG_MIN_PERIOD;
+    attr.pmin = 3600;
+    InstanceValues[0] = 3;
+    InstanceValues[1] = 4;
+    TEST_ASSERT(OMANAGER_NOTIFY_DEFER ==
+                omanager_CheckNotification(LWM2MCORE_DEVICE_OID,
+                                           0,
+                                           rid,
+                                           1,
+                                           OMANAGER_OBSERVE_RESOURCE,
+                                           &attr));
+    TEST_ASSERT(OMANAGER_NOTIFY_DEFER ==
+                omanager_CheckNotification(LWM2MCORE_DEVICE_OID,
+                                           1,
+                                           rid,
+                                           1,
+                                           OMANAGER_OBSERVE_RESOURCE,
+                                           &attr));
+    TEST_ASSERT(OMANAGER_NOTIFY_DEFER ==
+                omanager_CheckNotification(LWM2MCORE_DEVICE_OID,
+                                           1,
+                                           rid,
+                                           1,
+                                           OMANAGER_OBSERVE_RESOURCE,
+                                           &attr));
+    TEST_ASSERT(2 == dataPtr->lwm2mcoreCtxPtr->deferredNotificationCount);
+
+    // Not yet due
+    NotifiedInstances = 0;
+    TEST_ASSERT(UINT32_MAX > omanager_ProcessDeferredNotifications(NotifyDeferredCb));
+    TEST_ASSERT(0 == NotifiedInstances);
+
+    // Make the deferred notifications due: both instances are notified
+    for (statePtr = resourcePtr->statePtr; statePtr; statePtr = statePtr->nextPtr)
+    {
+        for (notifyPtr = statePtr->notifyPtr; notifyPtr; notifyPtr = notifyPtr->nextPtr)
+        {
+            if (notifyPtr->notifyDeadlineMs)
+            {
+                notifyPtr->notifyDeadlineMs = 1;
+            }
+        }
+    }
+    TEST_ASSERT(UINT32_MAX == omanager_ProcessDeferredNotifications(NotifyDeferredCb));
+    TEST_ASSERT(0x3 == NotifiedInstances);
+    TEST_ASSERT(0 == dataPtr->lwm2mcoreCtxPtr->deferredNotificationCount);
+
+    // The notified values are the reference of each instance
+    memset(&attr, 0, sizeof(attr));
+    TEST_ASSERT(OMANAGER_NOTIFY_SUPPRESS ==
+                omanager_CheckNotification(LWM2MCORE_DEVICE_OID,
+                                           0,
+                                           rid,
+                                           1,
+                                           OMANAGER_OBSERVE_RESOURCE,
+                                           &attr));
+    TEST_ASSERT(OMANAGER_NOTIFY_SUPPRESS ==
+                omanager_CheckNotification(LWM2MCORE_DEVICE_OID,
+                                           1,
+                                           rid,
+                                           1,
+                                           OMANAGER_OBSERVE_RESOURCE,
+                                           &attr));
+
+    // The states are released with the resource
+    savedResource.statePtr = resourcePtr->statePtr;
+    *resourcePtr = savedResource;
+    test_lwm2mcore_Free();
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test function for the notification of a resource observed by two servers: the attributes of a
+ * server do not gate the notifications of the other one, which keeps its own notified value
+ */
+//--------------------------------------------------------------------------------------------------
+static void test_lwm2mcore_NotifyTwoServers
+(
+    void
+)
+{
+    smanager_ClientData_t* dataPtr;
+    lwm2mcore_internalResource_t* resourcePtr;
+    lwm2mcore_internalResource_t savedResource;
+    lwm2mcore_resourceState_t* statePtr;
+    lwm2mcore_notifyState_t* notifyPtr;
+    lwm2m_server_t servers[2];
+    lwm2m_watcher_t watchers[2];
+    lwm2m_observed_t observed;
+    lwm2m_attributes_t params;
+    uint16_t rid = LWM2MCORE_DEVICE_MANUFACTURER_RID;
+
+    test_lwm2mcore_Init();
+    dataPtr = (smanager_ClientData_t*)Lwm2mcoreRef;
+    resourcePtr = FindInternalResource(LWM2MCORE_DEVICE_OID, rid);
+    TEST_ASSERT(NULL != resourcePtr);
+
+    savedResource = *resourcePtr;
+    resourcePtr->read = NULL;
+    resourcePtr->readValue = InstanceReadValueHandler;
+    resourcePtr->readChunk = NULL;
+    InstanceValues[0] = 1;
+
+    // Server 1 observes the resource with a minimum period, server 2 without attributes
+    memset(servers, 0, sizeof(servers));
+    servers[0].shortID = 1;
+    servers[0].next = &servers[1];
+    servers[1].shortID = 2;
+    memset(&params, 0, sizeof(params));
+    params.toSet = LWM2M_ATTR_FLAG_MIN_PERIOD;
+    params.minPeriod = 3600;
+    memset(watchers, 0, sizeof(watchers));
+    watchers[0].next = &watchers[1];
+    watchers[0].active = true;
+    watchers[0].server = &servers[0];
+    watchers[0].parameters = &params;
+    watchers[1].active = true;
+    watchers[1].server = &servers[1];
+    memset(&observed, 0, sizeof(observed));
+    observed.uri.flag = LWM2M_URI_FLAG_OBJECT_ID | LWM2M_URI_FLAG_INSTANCE_ID
+                        | LWM2M_URI_FLAG_RESOURCE_ID;
+    observed.uri.objectId = LWM2MCORE_DEVICE_OID;
+    observed.uri.instanceId = 0;
+    observed.uri.resourceId = rid;
+    observed.watcherList = watchers;
+    dataPtr->lwm2mHPtr->serverList = servers;
+    dataPtr->lwm2mHPtr->observedList = &observed;
+    dataPtr->lwm2mHPtr->state = STATE_READY;
+
+    // The batch is not flushed during the test
+    TEST_ASSERT(true == lwm2mcore_SetNotificationWindow(Lwm2mcoreRef, 60000));
+
+    // First value is notified
+    TEST_ASSERT(true == lwm2mcore_NotifyResourceChange(Lwm2mcoreRef, LWM2MCORE_DEVICE_OID, 0, rid));
+    TEST_ASSERT(1 == dataPtr->notifyBatchCount);
+    dataPtr->notifyBatchCount = 0;
+
+    // A change within the minimum period of server 1 is notified for server 2
+    InstanceValues[0] = 2;
+    TEST_ASSERT(true == lwm2mcore_NotifyResourceChange(Lwm2mcoreRef, LWM2MCORE_DEVICE_OID, 0, rid));
+    TEST_ASSERT(1 == dataPtr->notifyBatchCount);
+    TEST_ASSERT(1 == dataPtr->lwm2mcoreCtxPtr->deferredNotificationCount);
+    dataPtr->notifyBatchCount = 0;
+
+    // Unchanged for server 2, still deferred for server 1
+    TEST_ASSERT(true == lwm2mcore_NotifyResourceChange(Lwm2mcoreRef, LWM2MCORE_DEVICE_OID, 0, rid));
+    TEST_ASSERT(0 == dataPtr->notifyBatchCount);
+    TEST_ASSERT(1 == dataPtr->lwm2mcoreCtxPtr->deferredNotificationCount);
+
+    // Make the deferred notification of server 1 due
+    for (statePtr = resourcePtr->statePtr; statePtr; statePtr = statePtr->nextPtr)
+    {
+        for (notifyPtr = statePtr->notifyPtr; notifyPtr; notifyPtr = notifyPtr->nextPtr)
+        {
+            TEST_ASSERT((0 == notifyPtr->notifyDeadlineMs) || (1 == notifyPtr->shortServerId));
+            if (notifyPtr->notifyDeadlineMs)
+            {
+                notifyPtr->notifyDeadlineMs = 1;
+            }
+        }
+    }
+    NotifiedInstances = 0;
+    TEST_ASSERT(UINT32_MAX == omanager_ProcessDeferredNotifications(NotifyDeferredCb));
+    TEST_ASSERT(0x1 == NotifiedInstances);
+    TEST_ASSERT(0 == dataPtr->lwm2mcoreCtxPtr->deferredNotificationCount);
+
+    // Not observed by an active watcher
+    watchers[0].active = false;
+    watchers[1].active = false;
+    InstanceValues[0] = 3;
+    TEST_ASSERT(true == lwm2mcore_NotifyResourceChange(Lwm2mcoreRef, LWM2MCORE_DEVICE_OID, 0, rid));
+    TEST_ASSERT(0 == dataPtr->notifyBatchCount);
+
+    // The servers and observations are not allocated
+    dataPtr->lwm2mHPtr->observedList = NULL;
+    dataPtr->lwm2mHPtr->serverList = NULL;
+    dataPtr->lwm2mHPtr->state = STATE_INITIAL;
+    savedResource.statePtr = resourcePtr->statePtr;
+    *resourcePtr = savedResource;
+    test_lwm2mcore_Free();
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Timer wheel callback: count the expiries
+ */
+//--------------------------------------------------------------------------------------------------
+static void TimerWheelCb
+(
+    void* contextPtr                ///< [IN] Expiry counter
+)
+{
+    (*(int*)contextPtr)++;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Timers of the wheel changed by an expiry callback
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    timerWheel_Timer_t* restartPtr;     ///< Timer restarted by the callback
+    timerWheel_Timer_t* stopPtr;        ///< Timer stopped by the callback
+    int* restartCountPtr;               ///< Expiry counter of the restarted timer
+    int count;                          ///< Expiry counter
+}TimerWheelChange_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Timer wheel callback: restart a timer for 4 s and stop another one
+ */
+//--------------------------------------------------------------------------------------------------
+static void TimerWheelChangeCb
+(
+    void* contextPtr                ///< [IN] Timers to be changed
+)
+{
+    TimerWheelChange_t* changePtr = (TimerWheelChange_t*)contextPtr;
+
+    changePtr->count++;
+    timerWheel_Start(changePtr->restartPtr, 4000, TimerWheelCb, changePtr->restartCountPtr);
+    timerWheel_Stop(changePtr->stopPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test function for the timer wheel
+ */
+//--------------------------------------------------------------------------------------------------
+static void test_timerWheel
+(
+    void
+)
+{
+    timerWheel_Timer_t timers[3];
+    timerWheel_Timer_t unrelated;
+    TimerWheelChange_t change;
+    int count = 0;
+    uint32_t delayMs;
+
+    memset(timers, 0, sizeof(timers));
+    memset(&unrelated, 0, sizeof(unrelated));
+    TEST_ASSERT(UINT32_MAX == timerWheel_GetNextDelay());
+
+    // Deadlines within and beyond one revolution of the wheel
+    timerWheel_Start(&timers[0], 60000, TimerWheelCb, &count);
+    timerWheel_Start(&timers[1], 3600000, TimerWheelCb, &count);
+    TEST_ASSERT(true == timerWheel_IsRunning(&timers[0]));
+    delayMs = timerWheel_GetNextDelay();
+    TEST_ASSERT((59000 < delayMs) && (60000 >= delayMs));
+
+    // Expired timer, treated through the event loop API
+    timerWheel_Start(&timers[2], 0, TimerWheelCb, &count);
+    TEST_ASSERT(0 == lwm2mcore_GetNextDeadline());
+    lwm2mcore_ProcessTimers();
+    TEST_ASSERT(1 == count);
+    TEST_ASSERT(false == timerWheel_IsRunning(&timers[2]));
+    TEST_ASSERT(true == timerWheel_IsRunning(&timers[0]));
+
+    timerWheel_Stop(&timers[0]);
+    delayMs = timerWheel_GetNextDelay();
+    TEST_ASSERT((3599000 < delayMs) && (3600000 >= delayMs));
+    timerWheel_Stop(&timers[1]);
+    TEST_ASSERT(UINT32_MAX == timerWheel_GetNextDelay());
+    TEST_ASSERT(UINT32_MAX == lwm2mcore_GetNextDeadline());
+    TEST_ASSERT(1 == count);
+
+    // Expired timer which is not processed yet, in a slot before the current one
+    timerWheel_Start(&timers[2], 0, TimerWheelCb, &count);
+    usleep(15000);
+    timerWheel_Start(&timers[0], 300, TimerWheelCb, &count);
+    TEST_ASSERT(0 == timerWheel_GetNextDelay());
+    lwm2mcore_ProcessTimers();
+    TEST_ASSERT(2 == count);
+    delayMs = timerWheel_GetNextDelay();
+    TEST_ASSERT((0 < delayMs) && (300 >= delayMs));
+    timerWheel_Stop(&timers[0]);
+
+    // Callback restarting and stopping timers expiring in the same pass: timers[2] expires first,
+    // it is the last one started in the slot
+    memset(&change, 0, sizeof(change));
+    change.restartPtr = &timers[0];
+    change.stopPtr = &timers[1];
+    change.restartCountPtr = &count;
+    do
+    {
+        timerWheel_Start(&timers[0], 0, TimerWheelCb, &count);
+        timerWheel_Start(&timers[1], 0, TimerWheelCb, &count);
+        timerWheel_Start(&timers[2], 0, TimerWheelChangeCb, &change);
+    }
+    while (   ((timers[0].deadlineMs / TIMER_WHEEL_TICK_MS)
+               != (timers[2].deadlineMs / TIMER_WHEEL_TICK_MS))
+           || ((timers[1].deadlineMs / TIMER_WHEEL_TICK_MS)
+               != (timers[2].deadlineMs / TIMER_WHEEL_TICK_MS)));
+    timerWheel_Start(&unrelated, 5000, TimerWheelCb, &count);
+    lwm2mcore_ProcessTimers();
+    TEST_ASSERT(1 == change.count);
+    TEST_ASSERT(2 == count);
+    TEST_ASSERT(true == timerWheel_IsRunning(&timers[0]));
+    TEST_ASSERT(false == timerWheel_IsRunning(&timers[1]));
+    TEST_ASSERT(false == timerWheel_IsRunning(&timers[2]));
+    TEST_ASSERT(true == timerWheel_IsRunning(&unrelated));
+    delayMs = timerWheel_GetNextDelay();
+    TEST_ASSERT((3000 < delayMs) && (4000 >= delayMs));
+    lwm2mcore_ProcessTimers();
+    TEST_ASSERT(2 == count);
+
+    timerWheel_Stop(&timers[0]);
+    timerWheel_Stop(&unrelated);
+    TEST_ASSERT(UINT32_MAX == timerWheel_GetNextDelay());
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test function for the push queue
+ */
+//--------------------------------------------------------------------------------------------------
+static void test_pushQueue
+(
+    void
+)
+{
+    pushQueue_Queue_t queue;
+    pushQueue_Entry_t* entryPtr;
+    uint8_t payload[3] = { 0x01, 0x02, 0x03 };
+    size_t entrySize = sizeof(pushQueue_Entry_t) + sizeof(payload);
+    uint32_t droppedCount;
+
+    memset(&queue, 0, sizeof(queue));
+    pushQueue_Configure(&queue, 2 * entrySize, LWM2MCORE_PUSH_QUEUE_DROP_NEW, false);
+    TEST_ASSERT(true == pushQueue_IsEnabled(&queue));
+    TEST_ASSERT(false == pushQueue_IsBusy(&queue));
+    TEST_ASSERT(NULL == pushQueue_GetNext(&queue));
+
+    // Drop new: the third push exceeds the budget
+    TEST_ASSERT(LWM2MCORE_PUSH_QUEUED == pushQueue_Add(&queue, payload, 1,
+                                                       LWM2MCORE_PUSH_CONTENT_CBOR,
+                                                       &droppedCount));
+    TEST_ASSERT(LWM2MCORE_PUSH_QUEUED == pushQueue_Add(&queue, payload, 2,
+                                                       LWM2MCORE_PUSH_CONTENT_CBOR,
+                                                       &droppedCount));
+    TEST_ASSERT(LWM2MCORE_PUSH_BUSY == pushQueue_Add(&queue, payload, 3,
+                                                     LWM2MCORE_PUSH_CONTENT_CBOR,
+                                                     &droppedCount));
+    TEST_ASSERT(0 == droppedCount);
+
+    // In order delivery: the push in flight blocks the next one
+    entryPtr = pushQueue_GetNext(&queue);
+    TEST_ASSERT((NULL != entryPtr) && (1 == entryPtr->len));
+    pushQueue_SetInFlight(&queue, 10);
+    TEST_ASSERT(NULL == pushQueue_GetNext(&queue));
+    TEST_ASSERT(0 == pushQueue_Acknowledge(&queue, 11));
+    TEST_ASSERT(1 == pushQueue_Acknowledge(&queue, 10));
+    entryPtr = pushQueue_GetNext(&queue);
+    TEST_ASSERT((NULL != entryPtr) && (2 == entryPtr->len));
+
+    // Drop oldest: the push in flight is kept
+    pushQueue_Configure(&queue, 2 * entrySize, LWM2MCORE_PUSH_QUEUE_DROP_OLDEST, false);
+    pushQueue_SetInFlight(&queue, 12);
+    TEST_ASSERT(LWM2MCORE_PUSH_QUEUED == pushQueue_Add(&queue, payload, 1,
+                                                       LWM2MCORE_PUSH_CONTENT_ZCBOR,
+                                                       &droppedCount));
+    TEST_ASSERT(LWM2MCORE_PUSH_QUEUED == pushQueue_Add(&queue, payload, 2,
+                                                       LWM2MCORE_PUSH_CONTENT_ZCBOR,
+                                                       &droppedCount));
+    TEST_ASSERT(1 == droppedCount);
+    TEST_ASSERT(1 == pushQueue_Acknowledge(&queue, 12));
+    entryPtr = pushQueue_GetNext(&queue);
+    TEST_ASSERT((NULL != entryPtr) && (2 == entryPtr->len));
+
+    // Overwrite: the newest queued push is replaced
+    pushQueue_Configure(&queue, 2 * entrySize, LWM2MCORE_PUSH_QUEUE_OVERWRITE, true);
+    TEST_ASSERT(LWM2MCORE_PUSH_QUEUED == pushQueue_Add(&queue, payload, 1,
+                                                       LWM2MCORE_PUSH_CONTENT_CBOR,
+                                                       &droppedCount));
+    TEST_ASSERT(LWM2MCORE_PUSH_QUEUED == pushQueue_Add(&queue, payload, 3,
+                                                       LWM2MCORE_PUSH_CONTENT_CBOR,
+                                                       &droppedCount));
+    TEST_ASSERT(1 == droppedCount);
+    TEST_ASSERT(1 == pushQueue_DropHead(&queue));
+
+    // Aggregation of the consecutive CBOR payloads in a CBOR array
+    TEST_ASSERT(LWM2MCORE_PUSH_QUEUED == pushQueue_Add(&queue, payload, 2,
+                                                       LWM2MCORE_PUSH_CONTENT_CBOR,
+                                                       &droppedCount));
+    entryPtr = pushQueue_GetNext(&queue);
+    TEST_ASSERT((NULL != entryPtr) && (2 == entryPtr->pushCount) && (6 == entryPtr->len));
+    TEST_ASSERT(0x82 == entryPtr->payload[0]);
+    TEST_ASSERT(0 == memcmp(&entryPtr->payload[1], payload, 3));
+    TEST_ASSERT(0 == memcmp(&entryPtr->payload[4], payload, 2));
+    pushQueue_SetInFlight(&queue, 13);
+    TEST_ASSERT(NULL == pushQueue_GetNext(&queue));
+    TEST_ASSERT(2 == pushQueue_Acknowledge(&queue, 13));
+    TEST_ASSERT(false == pushQueue_IsBusy(&queue));
+    TEST_ASSERT(0 == queue.usedBytes);
+
+    pushQueue_Add(&queue, payload, 1, LWM2MCORE_PUSH_CONTENT_CBOR, &droppedCount);
+    pushQueue_Flush(&queue);
+    TEST_ASSERT(false == pushQueue_IsBusy(&queue));
+    TEST_ASSERT(0 == queue.usedBytes);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Push payload reader of the streamed push test: bytes of a counter, read by chunks of 100 bytes
+ */
+//--------------------------------------------------------------------------------------------------
+static lwm2mcore_Sid_t PushStreamReader
+(
+    void* contextPtr,
+    uint8_t* bufferPtr,
+    size_t* lenPtr
+)
+{
+    size_t* remainingPtr = (size_t*)contextPtr;
+    size_t i;
+
+    if (*lenPtr > 100)
+    {
+        *lenPtr = 100;
+    }
+    if (*lenPtr > *remainingPtr)
+    {
+        *lenPtr = *remainingPtr;
+    }
+    for (i = 0; i < *lenPtr; i++)
+    {
+        bufferPtr[i] = (uint8_t)(*remainingPtr - i);
+    }
+    *remainingPtr -= *lenPtr;
+    return LWM2MCORE_ERR_COMPLETED_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test function for the streamed push
+ */
+//--------------------------------------------------------------------------------------------------
+static void test_pushStream
+(
+    void
+)
+{
+    pushStream_Stream_t stream;
+    size_t remaining = (2 * LWM2MCORE_PUSH_BLOCK_SIZE) + 10;
+    uint8_t parts[LWM2MCORE_PUSH_BLOCK_SIZE];
+    lwm2mcore_PushIovec_t iov[3];
+    size_t len;
+
+    memset(&stream, 0, sizeof(stream));
+
+    // Payload read by chunks, the last block is detected without knowing the payload length
+    TEST_ASSERT(true == pushStream_Start(&stream, PushStreamReader, &remaining,
+                                         LWM2MCORE_PUSH_CONTENT_CBOR));
+    TEST_ASSERT(false == pushStream_Start(&stream, PushStreamReader, &remaining,
+                                          LWM2MCORE_PUSH_CONTENT_CBOR));
+    TEST_ASSERT(true == pushStream_ReadBlock(&stream, &len));
+    TEST_ASSERT((LWM2MCORE_PUSH_BLOCK_SIZE == len) && (0 == stream.blockNum) && stream.isMore);
+    TEST_ASSERT((uint8_t)((2 * LWM2MCORE_PUSH_BLOCK_SIZE) + 10) == stream.blockPtr[0]);
+    TEST_ASSERT(true == pushStream_ReadBlock(&stream, &len));
+    TEST_ASSERT((LWM2MCORE_PUSH_BLOCK_SIZE == len) && (1 == stream.blockNum) && stream.isMore);
+    TEST_ASSERT((uint8_t)(LWM2MCORE_PUSH_BLOCK_SIZE + 10) == stream.blockPtr[0]);
+    TEST_ASSERT(true == pushStream_ReadBlock(&stream, &len));
+    TEST_ASSERT((10 == len) && (2 == stream.blockNum) && (!stream.isMore));
+    TEST_ASSERT(10 == stream.blockPtr[0]);
+    pushStream_Stop(&stream);
+    TEST_ASSERT((false == stream.isActive) && (NULL == stream.blockPtr));
+
+    // Scattered payload of exactly one block, with an empty part
+    memset(parts, 0xA5, sizeof(parts));
+    iov[0].basePtr = parts;
+    iov[0].len = 10;
+    iov[1].basePtr = NULL;
+    iov[1].len = 0;
+    iov[2].basePtr = parts + 10;
+    iov[2].len = sizeof(parts) - 10;
+    TEST_ASSERT(true == pushStream_StartIovec(&stream, iov, 3, LWM2MCORE_PUSH_CONTENT_ZCBOR));
+    TEST_ASSERT(true == pushStream_ReadBlock(&stream, &len));
+    TEST_ASSERT((sizeof(parts) == len) && (0 == stream.blockNum) && (!stream.isMore));
+    TEST_ASSERT(0 == memcmp(stream.blockPtr, parts, sizeof(parts)));
+    pushStream_Stop(&stream);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test function for the NAT binding lifetime learning
+ */
+//--------------------------------------------------------------------------------------------------
+static void test_natTimeout
+(
+    void
+)
+{
+    natTimeout_Estimator_t estimator;
+
+    natTimeout_Init(&estimator, 40);
+    TEST_ASSERT(40 == estimator.timeout);
+
+    // Inactivities longer than twice the timeout are not probed
+    TEST_ASSERT(true == natTimeout_IsResumeNeeded(&estimator, 85));
+    TEST_ASSERT(false == natTimeout_IsProbing(&estimator));
+
+    // Answered probe: longer timeout, one probe at a time
+    TEST_ASSERT(false == natTimeout_IsResumeNeeded(&estimator, 70));
+    TEST_ASSERT(true == natTimeout_IsProbing(&estimator));
+    TEST_ASSERT(true == natTimeout_IsResumeNeeded(&estimator, 60));
+    TEST_ASSERT(true == natTimeout_ReportProbe(&estimator, true));
+    TEST_ASSERT((70 == estimator.timeout) && (false == natTimeout_IsProbing(&estimator)));
+
+    // Lost probe: the inactivity is not probed again
+    TEST_ASSERT(false == natTimeout_IsResumeNeeded(&estimator, 120));
+    TEST_ASSERT(false == natTimeout_ReportProbe(&estimator, false));
+    TEST_ASSERT((70 == estimator.timeout) && (120 == estimator.deadSec));
+    TEST_ASSERT(true == natTimeout_IsResumeNeeded(&estimator, 130));
+    TEST_ASSERT(false == natTimeout_IsResumeNeeded(&estimator, 110));
+    TEST_ASSERT(true == natTimeout_ReportProbe(&estimator, true));
+    TEST_ASSERT(110 == estimator.timeout);
+
+    // Server message after a longer inactivity: the network keeps the bindings longer
+    TEST_ASSERT(true == natTimeout_ReportAlive(&estimator, 150));
+    TEST_ASSERT((150 == estimator.timeout) && (0 == estimator.deadSec));
+
+    // Binding lost below the timeout: the timeout is lowered
+    TEST_ASSERT(false == natTimeout_IsResumeNeeded(&estimator, 30));
+    TEST_ASSERT(true == natTimeout_ReportProbe(&estimator, false));
+    TEST_ASSERT((15 == estimator.timeout) && (0 == estimator.aliveSec));
+
+    // Short inactivities are not probes
+    TEST_ASSERT(false == natTimeout_IsResumeNeeded(&estimator, LWM2MCORE_NAT_TIMEOUT_MIN - 1));
+    TEST_ASSERT(false == natTimeout_IsProbing(&estimator));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test function for the CoAP round-trip time estimation
+ */
+//--------------------------------------------------------------------------------------------------
+static void test_coapRtt
+(
+    void
+)
+{
+    coapRtt_Estimator_t estimator;
+    uint64_t deadlineMs;
+
+    coapRtt_Init(&estimator);
+    TEST_ASSERT(LWM2MCORE_COAP_RTO_INIT_MS == estimator.rtoMs);
+
+    // Strong sample: acknowledged after one transmission
+    TEST_ASSERT(false == coapRtt_Sent(&estimator, 1, 1000));
+    TEST_ASSERT(true == coapRtt_GetDeadline(&estimator, 1, &deadlineMs));
+    TEST_ASSERT(3000 == deadlineMs);
+    TEST_ASSERT(true == coapRtt_Acknowledged(&estimator, 1, 1100));
+    TEST_ASSERT((100 == estimator.strongSrttMs) && (50 == estimator.strongVarMs));
+    TEST_ASSERT(1150 == estimator.rtoMs);
+    TEST_ASSERT(false == coapRtt_GetDeadline(&estimator, 1, &deadlineMs));
+    TEST_ASSERT(false == coapRtt_Acknowledged(&estimator, 1, 1200));
+
+    // Weak sample: acknowledged after a retransmission, measured from the first transmission
+    TEST_ASSERT(false == coapRtt_Sent(&estimator, 2, 2000));
+    TEST_ASSERT(true == coapRtt_Sent(&estimator, 2, 3150));
+    TEST_ASSERT(true == coapRtt_GetDeadline(&estimator, 2, &deadlineMs));
+    TEST_ASSERT(5450 == deadlineMs);
+    TEST_ASSERT(true == coapRtt_Acknowledged(&estimator, 2, 3400));
+    TEST_ASSERT((1400 == estimator.weakSrttMs) && (700 == estimator.weakVarMs));
+    TEST_ASSERT(1387 == estimator.rtoMs);
+
+    // Short timeout: backoff factor of 3, doubled when no sample is received
+    estimator.rtoMs = 500;
+    TEST_ASSERT(false == coapRtt_Sent(&estimator, 3, 3500));
+    TEST_ASSERT(true == coapRtt_Sent(&estimator, 3, 4000));
+    TEST_ASSERT(true == coapRtt_GetDeadline(&estimator, 3, &deadlineMs));
+    TEST_ASSERT(5500 == deadlineMs);
+    TEST_ASSERT(false == coapRtt_Sent(&estimator, 4, 20000));
+    TEST_ASSERT(1000 == estimator.rtoMs);
+
+    // Two messages in flight: the retransmission of the first one is detected
+    TEST_ASSERT(false == coapRtt_Sent(&estimator, 5, 20100));
+    TEST_ASSERT(true == coapRtt_Sent(&estimator, 4, 22000));
+    TEST_ASSERT(true == coapRtt_Sent(&estimator, 5, 22100));
+
+    // An acknowledged message is no longer followed
+    TEST_ASSERT(true == coapRtt_Acknowledged(&estimator, 4, 22200));
+    TEST_ASSERT(false == coapRtt_Sent(&estimator, 4, 30000));
+}
+
+#ifdef LWM2MCORE_DTLS_CID
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test function for the DTLS Connection ID: no resume is started after an inactivity
+ */
+//--------------------------------------------------------------------------------------------------
+static void test_dtls_ConnectionId
+(
+    void
+)
+{
+    // Non-confirmable CoAP message
+    uint8_t message[] = { 0x50, 0x02, 0x12, 0x34 };
+    dtls_security_parameters_t securityParams;
+    dtls_Instance_t instance;
+    dtls_Connection_t conn;
+    dtls_peer_t peer;
+    session_t session;
+    uint64_t avoided;
+    uint64_t value;
+
+    memset(&securityParams, 0, sizeof(securityParams));
+    memset(&instance, 0, sizeof(instance));
+    memset(&conn, 0, sizeof(conn));
+    memset(&peer, 0, sizeof(peer));
+    memset(&session, 0, sizeof(session));
+
+    // Connection idle for longer than the NAT timeout
+    instance.natTimeout = 5;
+    conn.instancePtr = &instance;
+    conn.dtlsContextPtr = (dtls_context_t*)&instance;
+    conn.dtlsSessionPtr = &session;
+    conn.lastSend = lwm2m_gettime() - 60;
+    conn.lastReceived = conn.lastSend;
+
+    peer.state = DTLS_STATE_CONNECTED;
+    peer.security_params[0] = &securityParams;
+    securityParams.write_cid_length = 4;
+    TinydtlsStubPeerPtr = &peer;
+    TinydtlsStubResumeCount = 0;
+    TinydtlsStubWriteCount = 0;
+    TEST_ASSERT(LWM2MCORE_ERR_COMPLETED_OK ==
+                lwm2mcore_GetCounter(LWM2MCORE_COUNTER_DTLS_RESUMES_AVOIDED, &avoided));
+
+    // First block with a Connection ID: the record is written without a resume
+    lwm2m_buffer_send(&conn, message, sizeof(message), NULL, true);
+    TEST_ASSERT(0 == TinydtlsStubResumeCount);
+    TEST_ASSERT(1 == TinydtlsStubWriteCount);
+    TEST_ASSERT(LWM2MCORE_ERR_COMPLETED_OK ==
+                lwm2mcore_GetCounter(LWM2MCORE_COUNTER_DTLS_RESUMES_AVOIDED, &value));
+    TEST_ASSERT((avoided + 1) == value);
+
+    // Next blocks are not checked
+    lwm2m_buffer_send(&conn, message, sizeof(message), NULL, false);
+    TEST_ASSERT(0 == TinydtlsStubResumeCount);
+    TEST_ASSERT(2 == TinydtlsStubWriteCount);
+    TEST_ASSERT(LWM2MCORE_ERR_COMPLETED_OK ==
+                lwm2mcore_GetCounter(LWM2MCORE_COUNTER_DTLS_RESUMES_AVOIDED, &value));
+    TEST_ASSERT((avoided + 1) == value);
+
+    // Without a Connection ID, the session is resumed after the inactivity
+    securityParams.write_cid_length = 0;
+    lwm2m_buffer_send(&conn, message, sizeof(message), NULL, true);
+    TEST_ASSERT(1 == TinydtlsStubResumeCount);
+    TEST_ASSERT(LWM2MCORE_ERR_COMPLETED_OK ==
+                lwm2mcore_GetCounter(LWM2MCORE_COUNTER_DTLS_RESUMES_AVOIDED, &value));
+    TEST_ASSERT((avoided + 1) == value);
+
+    // Handshake in progress: the Connection ID is not known yet
+    securityParams.write_cid_length = 4;
+    peer.state = DTLS_STATE_INIT;
+    TinydtlsStubResumeCount = 0;
+    lwm2m_buffer_send(&conn, message, sizeof(message), NULL, true);
+    TEST_ASSERT(1 == TinydtlsStubResumeCount);
+
+    TinydtlsStubPeerPtr = NULL;
+}
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of connections of the DTLS connection index test: several connections per bucket
+ */
+//--------------------------------------------------------------------------------------------------
+#define INDEX_TEST_CONNECTIONS  (3 * LWM2MCORE_DTLS_CONNECTION_HASH_SIZE)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * First server port of the DTLS connection index test
+ */
+//--------------------------------------------------------------------------------------------------
+#define INDEX_TEST_PORT         5700
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Server URI read in the security object of the DTLS connection index test
+ */
+//--------------------------------------------------------------------------------------------------
+static char IndexTestUri[LWM2MCORE_SERVER_URI_MAX_LEN + 1];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Security mode read in the security object of the DTLS connection index test
+ */
+//--------------------------------------------------------------------------------------------------
+static int64_t IndexTestMode;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * READ callback of the security object of the DTLS connection index test: server URI and security
+ * mode
+ *
+ * @return
+ *  - COAP_205_CONTENT if the resource is read
+ *  - COAP_404_NOT_FOUND else
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t IndexTestSecurityRead
+(
+    uint16_t instanceId,            ///< [IN] Object instance Id
+    int* numDataPtr,                ///< [IN] Number of resources to be read
+    lwm2m_data_t** dataArrayPtr,    ///< [INOUT] Array of requested resources to be read
+    lwm2m_object_t* objectPtr       ///< [IN] Pointer on object
+)
+{
+    lwm2m_data_t* dataPtr = *dataArrayPtr;
+    size_t length;
+
+    (void)instanceId;
+    (void)numDataPtr;
+    (void)objectPtr;
+
+    // Drop the value set by lwm2m_data_new()
+    if (LWM2M_TYPE_STRING == dataPtr->type)
+    {
+        lwm2m_free(dataPtr->value.asBuffer.buffer);
+        dataPtr->value.asBuffer.buffer = NULL;
+        dataPtr->value.asBuffer.length = 0;
+    }
+
+    switch (dataPtr->id)
+    {
+        case LWM2M_SECURITY_URI_ID:
+            length = strlen(IndexTestUri);
+            dataPtr->type = LWM2M_TYPE_STRING;
+            dataPtr->value.asBuffer.buffer = (uint8_t*)lwm2m_malloc(length + 1);
+            if (NULL == dataPtr->value.asBuffer.buffer)
+            {
+                return COAP_500_INTERNAL_SERVER_ERROR;
+            }
+            memcpy(dataPtr->value.asBuffer.buffer, IndexTestUri, length + 1);
+            dataPtr->value.asBuffer.length = length;
+            return COAP_205_CONTENT;
+
+        case LWM2MCORE_SECURITY_MODE_RID:
+            dataPtr->type = LWM2M_TYPE_INTEGER;
+            dataPtr->value.asInteger = IndexTestMode;
+            return COAP_205_CONTENT;
+
+        default:
+            dataPtr->type = LWM2M_TYPE_UNDEFINED;
+            return COAP_404_NOT_FOUND;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Search the DTLS connection of an IPv4 server address
+ *
+ * @return
+ *  - DTLS connection
+ *  - NULL if the address is not indexed
+ */
+//--------------------------------------------------------------------------------------------------
+static dtls_Connection_t* IndexTestFindIpv4
+(
+    dtls_Instance_t* instancePtr,   ///< [IN] DTLS state of the client instance
+    uint16_t port                   ///< [IN] Server port
+)
+{
+    struct sockaddr_storage addr;
+    struct sockaddr_in* addrInPtr = (struct sockaddr_in*)&addr;
+
+    memset(&addr, 0, sizeof(addr));
+    addrInPtr->sin_family = AF_INET;
+    addrInPtr->sin_port = htons(port);
+    addrInPtr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return dtls_FindConnection(instancePtr, &addr, sizeof(struct sockaddr_in));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Search the DTLS connection of an IPv6 server address
+ *
+ * @return
+ *  - DTLS connection
+ *  - NULL if the address is not indexed
+ */
+//--------------------------------------------------------------------------------------------------
+static dtls_Connection_t* IndexTestFindIpv6
+(
+    dtls_Instance_t* instancePtr,   ///< [IN] DTLS state of the client instance
+    const char* addressPtr,         ///< [IN] IPv6 server address
+    uint16_t port                   ///< [IN] Server port
+)
+{
+    struct sockaddr_storage addr;
+    struct sockaddr_in6* addrIn6Ptr = (struct sockaddr_in6*)&addr;
+
+    memset(&addr, 0, sizeof(addr));
+    addrIn6Ptr->sin6_family = AF_INET6;
+    addrIn6Ptr->sin6_port = htons(port);
+    TEST_ASSERT(1 == inet_pton(AF_INET6, addressPtr, &(addrIn6Ptr->sin6_addr)));
+    return dtls_FindConnection(instancePtr, &addr, sizeof(struct sockaddr_in6));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test function for the DTLS connection index: lookup by peer address
+ */
+//--------------------------------------------------------------------------------------------------
+static void test_dtls_ConnectionIndex
+(
+    void
+)
+{
+    dtls_Connection_t* conns[INDEX_TEST_CONNECTIONS];
+    dtls_Connection_t* connListPtr = NULL;
+    dtls_Connection_t* connPtr;
+    lwm2m_object_t securityObj;
+    dtls_context_t context;
+    dtls_Instance_t instance;
+    bool isCollision = false;
+    int i;
+
+    memset(&securityObj, 0, sizeof(securityObj));
+    memset(&context, 0, sizeof(context));
+    securityObj.objID = LWM2MCORE_SECURITY_OID;
+    securityObj.readFunc = IndexTestSecurityRead;
+    TinydtlsStubContextPtr = &context;
+    dtls_InitInstance(&instance);
+
+    // Secured connections: all of them are indexed
+    IndexTestMode = LWM2M_SECURITY_MODE_PRE_SHARED_KEY;
+    for (i = 0; i < INDEX_TEST_CONNECTIONS; i++)
+    {
+        snprintf(IndexTestUri, sizeof(IndexTestUri), "coaps://127.0.0.1:%d", INDEX_TEST_PORT + i);
+        conns[i] = dtls_CreateConnection(&instance, connListPtr, 0, &securityObj, 0, NULL, AF_INET);
+        TEST_ASSERT(NULL != conns[i]);
+        TEST_ASSERT(&context == conns[i]->dtlsContextPtr);
+        connListPtr = conns[i];
+    }
+    dtls_UpdateDtlsList(&instance, connListPtr);
+
+    // Lookup after insertion
+    for (i = 0; i < INDEX_TEST_CONNECTIONS; i++)
+    {
+        TEST_ASSERT(conns[i] == IndexTestFindIpv4(&instance, INDEX_TEST_PORT + i));
+    }
+    TEST_ASSERT(NULL == IndexTestFindIpv4(&instance, INDEX_TEST_PORT + INDEX_TEST_CONNECTIONS));
+
+    // More connections than buckets: the collisions are chained
+    for (i = 0; i < LWM2MCORE_DTLS_CONNECTION_HASH_SIZE; i++)
+    {
+        if ((NULL != instance.connHash[i]) && (NULL != instance.connHash[i]->hashNextPtr))
+        {
+            isCollision = true;
+        }
+    }
+    TEST_ASSERT(isCollision);
+
+    // IPv4 and IPv4-mapped IPv6 addresses give the same key, not the other IPv6 addresses
+    TEST_ASSERT(conns[1] == IndexTestFindIpv6(&instance, "::ffff:127.0.0.1", INDEX_TEST_PORT + 1));
+    TEST_ASSERT(NULL == IndexTestFindIpv6(&instance, "::1", INDEX_TEST_PORT + 1));
+    TEST_ASSERT(NULL == IndexTestFindIpv6(&instance, "::7f00:1", INDEX_TEST_PORT + 1));
+
+    // Removal from a bucket: the other connections of the bucket are still found
+    dtls_CloseAndFreePeer(conns[0]);
+    TEST_ASSERT(NULL == IndexTestFindIpv4(&instance, INDEX_TEST_PORT));
+    for (i = 1; i < INDEX_TEST_CONNECTIONS; i++)
+    {
+        TEST_ASSERT(conns[i] == IndexTestFindIpv4(&instance, INDEX_TEST_PORT + i));
+    }
+
+    // NoSec connection: not indexed, lwm2m_connect_server() frees it
+    IndexTestMode = LWM2M_SECURITY_MODE_NONE;
+    snprintf(IndexTestUri, sizeof(IndexTestUri), "coap://127.0.0.1:%d", INDEX_TEST_PORT - 1);
+    connPtr = dtls_CreateConnection(&instance, connListPtr, 0, &securityObj, 0, NULL, AF_INET);
+    TEST_ASSERT(NULL != connPtr);
+    TEST_ASSERT(NULL == connPtr->dtlsContextPtr);
+    TEST_ASSERT(NULL == IndexTestFindIpv4(&instance, INDEX_TEST_PORT - 1));
+    lwm2m_free(connPtr);
+
+    // Nothing is found once the connection list is freed
+    dtls_FreeConnection(&instance, connListPtr);
+    for (i = 0; i < INDEX_TEST_CONNECTIONS; i++)
+    {
+        TEST_ASSERT(NULL == IndexTestFindIpv4(&instance, INDEX_TEST_PORT + i));
+    }
+
+    dtls_FreeInstance(&instance);
+    TinydtlsStubContextPtr = NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queue a test datagram in the current batch, the first byte of the datagram is its number
+ *
+ * @return
+ *  - see udpBatch_Queue
+ */
+//--------------------------------------------------------------------------------------------------
+static udpBatch_Status_t BatchTestQueue
+(
+    int sock,                               ///< [IN] Socket Id
+    uint8_t number,                         ///< [IN] Datagram number
+    size_t length,                          ///< [IN] Datagram length
+    const struct sockaddr_in* addrPtr,      ///< [IN] Destination address
+    size_t coalesceMaxLen                   ///< [IN] See udpBatch_Queue
+)
+{
+    static uint8_t datagram[LWM2MCORE_UDP_MAX_PACKET_SIZE];
+
+    memset(datagram, number, sizeof(datagram));
+    return udpBatch_Queue(sock,
+                          datagram,
+                          length,
+                          (const struct sockaddr*)addrPtr,
+                          sizeof(struct sockaddr_in),
+                          coalesceMaxLen);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Clear the datagrams recorded by the UDP stubs
+ */
+//--------------------------------------------------------------------------------------------------
+static void BatchTestReset
+(
+    void
+)
+{
+    UdpStubSentCount = 0;
+    UdpStubBatchCount = 0;
+    UdpStubBatchResult = 0;
+}
 
-    smanager_SendSessionEvent(EVENT_TYPE_RESUMING, EVENT_STATUS_DONE_FAIL, NULL);
-    // No generated event
-    TEST_ASSERT(Lwm2mcoreEvent == LWM2MCORE_EVENT_LAST);
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test function for the batched UDP send
+ */
+//--------------------------------------------------------------------------------------------------
+static void test_udpBatch
+(
+    void
+)
+{
+    struct sockaddr_in addr;
+    size_t i;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(INDEX_TEST_PORT);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    BatchTestReset();
+
+    // No batch in progress: the datagram is sent directly by the caller
+    TEST_ASSERT(UDP_BATCH_NOT_QUEUED == BatchTestQueue(UDP_STUB_SOCKET, 0, 10, &addr, 0));
+    TEST_ASSERT(0 == UdpStubSentCount);
+
+    // The datagrams are sent together in the send order when the outermost batch ends
+    udpBatch_Begin();
+    udpBatch_Begin();
+    for (i = 0; i < 3; i++)
+    {
+        TEST_ASSERT(UDP_BATCH_QUEUED == BatchTestQueue(UDP_STUB_SOCKET, i, 10 + i, &addr, 0));
+    }
+    udpBatch_End();
+    TEST_ASSERT(0 == UdpStubSentCount);
+    udpBatch_End();
+    TEST_ASSERT(1 == UdpStubBatchCount);
+    TEST_ASSERT(3 == UdpStubSentCount);
+    for (i = 0; i < 3; i++)
+    {
+        TEST_ASSERT(UDP_STUB_SOCKET == UdpStubSent[i].sock);
+        TEST_ASSERT(1 == UdpStubSent[i].batchId);
+        TEST_ASSERT((10 + i) == UdpStubSent[i].len);
+        TEST_ASSERT(i == UdpStubSent[i].data[0]);
+        TEST_ASSERT(sizeof(addr) == UdpStubSent[i].addrLen);
+        TEST_ASSERT(0 == memcmp(&(UdpStubSent[i].addr), &addr, sizeof(addr)));
+    }
 
+    // Unbalanced end: ignored
+    udpBatch_End();
+    TEST_ASSERT(1 == UdpStubBatchCount);
+
+    // Socket change: the datagrams of the previous socket are sent first
+    BatchTestReset();
+    udpBatch_Begin();
+    TEST_ASSERT(UDP_BATCH_QUEUED == BatchTestQueue(UDP_STUB_SOCKET, 0, 10, &addr, 0));
+    TEST_ASSERT(UDP_BATCH_QUEUED == BatchTestQueue(UDP_STUB_SOCKET + 1, 1, 10, &addr, 0));
+    TEST_ASSERT(1 == UdpStubSentCount);
+    TEST_ASSERT(UDP_STUB_SOCKET == UdpStubSent[0].sock);
+    TEST_ASSERT(0 == UdpStubSent[0].data[0]);
+
+    // Flush before a socket is closed, the batch goes on
+    udpBatch_Flush();
+    TEST_ASSERT(2 == UdpStubSentCount);
+    TEST_ASSERT((UDP_STUB_SOCKET + 1) == UdpStubSent[1].sock);
+    TEST_ASSERT(1 == UdpStubSent[1].data[0]);
+    TEST_ASSERT(UDP_BATCH_QUEUED == BatchTestQueue(UDP_STUB_SOCKET, 2, 10, &addr, 0));
+    udpBatch_End();
+    TEST_ASSERT(3 == UdpStubBatchCount);
+    TEST_ASSERT(3 == UdpStubSentCount);
+    TEST_ASSERT(2 == UdpStubSent[2].data[0]);
+
+    // Full queue: the queued datagrams are sent before the next one is queued
+    BatchTestReset();
+    udpBatch_Begin();
+    for (i = 0; i <= LWM2MCORE_UDP_BATCH_SIZE; i++)
+    {
+        TEST_ASSERT(UDP_BATCH_QUEUED == BatchTestQueue(UDP_STUB_SOCKET, i, 10, &addr, 0));
+    }
+    TEST_ASSERT(1 == UdpStubBatchCount);
+    TEST_ASSERT(LWM2MCORE_UDP_BATCH_SIZE == UdpStubSentCount);
+    udpBatch_End();
+    TEST_ASSERT(2 == UdpStubBatchCount);
+    TEST_ASSERT((LWM2MCORE_UDP_BATCH_SIZE + 1) == UdpStubSentCount);
+    for (i = 0; i <= LWM2MCORE_UDP_BATCH_SIZE; i++)
+    {
+        TEST_ASSERT(i == UdpStubSent[i].data[0]);
+    }
 
-    // Session
-    smanager_SendSessionEvent(EVENT_SESSION, EVENT_STATUS_STARTED, NULL);
-    // No generated event
-    TEST_ASSERT(Lwm2mcoreEvent == LWM2MCORE_EVENT_LAST);
+    // Too long datagram: the queued datagrams are sent before it is sent directly
+    BatchTestReset();
+    udpBatch_Begin();
+    TEST_ASSERT(UDP_BATCH_QUEUED == BatchTestQueue(UDP_STUB_SOCKET, 0, 10, &addr, 0));
+    TEST_ASSERT(UDP_BATCH_NOT_QUEUED == udpBatch_Queue(UDP_STUB_SOCKET,
+                                                       UdpStubSent[0].data,
+                                                       LWM2MCORE_UDP_MAX_PACKET_SIZE + 1,
+                                                       (const struct sockaddr*)&addr,
+                                                       sizeof(addr),
+                                                       0));
+    TEST_ASSERT(1 == UdpStubSentCount);
+    udpBatch_End();
+    TEST_ASSERT(1 == UdpStubBatchCount);
+
+    // Partial send: the remaining datagrams are sent by the next calls
+    BatchTestReset();
+    UdpStubBatchResult = 2;
+    udpBatch_Begin();
+    for (i = 0; i < 5; i++)
+    {
+        TEST_ASSERT(UDP_BATCH_QUEUED == BatchTestQueue(UDP_STUB_SOCKET, i, 10, &addr, 0));
+    }
+    udpBatch_End();
+    TEST_ASSERT(3 == UdpStubBatchCount);
+    TEST_ASSERT(5 == UdpStubSentCount);
+    for (i = 0; i < 5; i++)
+    {
+        TEST_ASSERT(i == UdpStubSent[i].data[0]);
+    }
 
-    smanager_SendSessionEvent(EVENT_SESSION, EVENT_STATUS_DONE_SUCCESS, NULL);
-    TEST_ASSERT(Lwm2mcoreEvent == LWM2MCORE_EVENT_SESSION_FINISHED);
-    Lwm2mcoreEvent = LWM2MCORE_EVENT_LAST;
+    // Send error: the queued datagrams are dropped, the next batch is sent
+    BatchTestReset();
+    UdpStubBatchResult = -1;
+    udpBatch_Begin();
+    for (i = 0; i < 3; i++)
+    {
+        TEST_ASSERT(UDP_BATCH_QUEUED == BatchTestQueue(UDP_STUB_SOCKET, i, 10, &addr, 0));
+    }
+    udpBatch_End();
+    TEST_ASSERT(1 == UdpStubBatchCount);
+    TEST_ASSERT(0 == UdpStubSentCount);
+    UdpStubBatchResult = 0;
+    udpBatch_Flush();
+    TEST_ASSERT(1 == UdpStubBatchCount);
+    udpBatch_Begin();
+    TEST_ASSERT(UDP_BATCH_QUEUED == BatchTestQueue(UDP_STUB_SOCKET, 3, 10, &addr, 0));
+    udpBatch_End();
+    TEST_ASSERT(2 == UdpStubBatchCount);
+    TEST_ASSERT(1 == UdpStubSentCount);
+    TEST_ASSERT(3 == UdpStubSent[0].data[0]);
+
+    BatchTestReset();
+}
 
-    smanager_SendSessionEvent(EVENT_SESSION, EVENT_STATUS_DONE_FAIL, NULL);
-    TEST_ASSERT(Lwm2mcoreEvent == LWM2MCORE_EVENT_SESSION_FAILED);
-    Lwm2mcoreEvent = LWM2MCORE_EVENT_LAST;
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test function for lwm2mcore_UdpReceiveBatchCb: the DTLS records sent in reply to the received
+ * datagrams are sent together
+ */
+//--------------------------------------------------------------------------------------------------
+static void test_lwm2mcore_UdpReceiveBatchCb
+(
+    void
+)
+{
+    // DTLS records: received handshake message and sent reply
+    uint8_t message[] = { 0x16, 0xfe, 0xfd, 0x00, 0x00 };
+    uint8_t reply[] = { 0x16, 0xfe, 0xfd, 0x00, 0x01 };
+    lwm2mcore_UdpDatagram_t datagrams[4];
+    lwm2mcore_SocketConfig_t config;
+    dtls_Connection_t* conns[2];
+    dtls_Connection_t* connListPtr = NULL;
+    smanager_ClientData_t* dataPtr;
+    lwm2mcore_Ref_t instanceRef;
+    lwm2m_object_t securityObj;
+    dtls_context_t context;
+    size_t i;
+
+    instanceRef = lwm2mcore_Init(EventHandler);
+    TEST_ASSERT(NULL != instanceRef);
+    dataPtr = (smanager_ClientData_t*)instanceRef;
+
+    memset(&securityObj, 0, sizeof(securityObj));
+    memset(&context, 0, sizeof(context));
+    securityObj.objID = LWM2MCORE_SECURITY_OID;
+    securityObj.readFunc = IndexTestSecurityRead;
+    TinydtlsStubContextPtr = &context;
+
+    IndexTestMode = LWM2M_SECURITY_MODE_PRE_SHARED_KEY;
+    for (i = 0; i < 2; i++)
+    {
+        snprintf(IndexTestUri, sizeof(IndexTestUri), "coaps://127.0.0.1:%d",
+                 INDEX_TEST_PORT + (int)i);
+        conns[i] = dtls_CreateConnection(&(dataPtr->dtls),
+                                         connListPtr,
+                                         UDP_STUB_SOCKET,
+                                         &securityObj,
+                                         0,
+                                         dataPtr->lwm2mHPtr,
+                                         AF_INET);
+        TEST_ASSERT(NULL != conns[i]);
+        connListPtr = conns[i];
+    }
+    dataPtr->connListPtr = connListPtr;
 
+    // Datagrams of both servers, of an unknown peer, then of the first server again
+    memset(datagrams, 0, sizeof(datagrams));
+    for (i = 0; i < 4; i++)
+    {
+        datagrams[i].bufferPtr = message;
+        datagrams[i].len = sizeof(message);
+        memcpy(&(datagrams[i].addr), &(conns[i % 2]->addr), sizeof(struct sockaddr_in));
+        datagrams[i].addrLen = sizeof(struct sockaddr_in);
+    }
+    ((struct sockaddr_in*)&(datagrams[2].addr))->sin_port = htons(INDEX_TEST_PORT + 2);
+
+    memset(&config, 0, sizeof(config));
+    config.instanceRef = instanceRef;
+    config.sock = UDP_STUB_SOCKET;
+    TinydtlsStubReplyPtr = reply;
+    TinydtlsStubReplyLen = sizeof(reply);
+    BatchTestReset();
+
+    // The replies are sent by a single call, in the receive order
+    lwm2mcore_UdpReceiveBatchCb(datagrams, 4, config);
+    TEST_ASSERT(1 == UdpStubBatchCount);
+    TEST_ASSERT(3 == UdpStubSentCount);
+    for (i = 0; i < 3; i++)
+    {
+        TEST_ASSERT(UDP_STUB_SOCKET == UdpStubSent[i].sock);
+        TEST_ASSERT(sizeof(reply) == UdpStubSent[i].len);
+        TEST_ASSERT(0 == memcmp(UdpStubSent[i].data, reply, sizeof(reply)));
+    }
+    TEST_ASSERT(0 == memcmp(&(UdpStubSent[0].addr), &(conns[0]->addr), sizeof(struct sockaddr_in)));
+    TEST_ASSERT(0 == memcmp(&(UdpStubSent[1].addr), &(conns[1]->addr), sizeof(struct sockaddr_in)));
+    TEST_ASSERT(0 == memcmp(&(UdpStubSent[2].addr), &(conns[0]->addr), sizeof(struct sockaddr_in)));
+
+    // In a batch of the caller, the reply waits for the socket to be closed
+    BatchTestReset();
+    udpBatch_Begin();
+    lwm2mcore_UdpReceiveCb(message,
+                           sizeof(message),
+                           &(datagrams[1].addr),
+                           datagrams[1].addrLen,
+                           config);
+    TEST_ASSERT(0 == UdpStubSentCount);
+#ifndef LWM2M_DEREGISTER
+    TEST_ASSERT(true == lwm2mcore_Disconnect(instanceRef));
+    TEST_ASSERT(NULL == dataPtr->connListPtr);
+#else
+    // The socket is closed when the deregistration is done
+    dtls_FreeConnection(&(dataPtr->dtls), dataPtr->connListPtr);
+    dataPtr->connListPtr = NULL;
+    udpBatch_Flush();
+#endif
+    TEST_ASSERT(1 == UdpStubSentCount);
+    TEST_ASSERT(0 == memcmp(&(UdpStubSent[0].addr),
+                            &(datagrams[1].addr),
+                            sizeof(struct sockaddr_in)));
+    udpBatch_End();
+    TEST_ASSERT(1 == UdpStubSentCount);
+
+    TinydtlsStubReplyPtr = NULL;
+    TinydtlsStubReplyLen = 0;
+    BatchTestReset();
+    lwm2mcore_Free(instanceRef);
+    TinydtlsStubContextPtr = NULL;
 }
 
-//-------------------------------------------------------------------------------------------------
+#ifdef LWM2MCORE_DTLS_COALESCE
+//--------------------------------------------------------------------------------------------------
 /**
- * Test function for lwm2mcore_SendAsyncResponse API
+ * Test function for the coalescing of the DTLS records sent to the same server
  */
 //--------------------------------------------------------------------------------------------------
-void test_lwm2mcore_SendAsyncResponse
+static void test_dtls_Coalesce
 (
     void
 )
 {
-    RequestPtr = (lwm2mcore_CoapRequest_t*)lwm2m_malloc(sizeof(lwm2mcore_CoapRequest_t));
-    if (NULL == RequestPtr)
+    // Non-confirmable CoAP messages, of any length up to LWM2MCORE_DTLS_COALESCE_MAX_LEN
+    uint8_t message[LWM2MCORE_DTLS_COALESCE_MAX_LEN] = { 0x50, 0x02, 0x12, 0x34 };
+    dtls_Connection_t* conns[2];
+    dtls_Connection_t* connListPtr = NULL;
+    dtls_Connection_t* noSecConnPtr;
+    lwm2m_object_t securityObj;
+    dtls_context_t context;
+    dtls_Instance_t instance;
+    struct sockaddr_in addr;
+    uint64_t coalesced;
+    uint64_t value;
+    int i;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(INDEX_TEST_PORT);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    BatchTestReset();
+
+    // Queue: only the DTLS records are appended to a previous DTLS record
+    udpBatch_Begin();
+    TEST_ASSERT(UDP_BATCH_QUEUED == BatchTestQueue(UDP_STUB_SOCKET, 0, 10, &addr,
+                                                   LWM2MCORE_DTLS_COALESCE_MAX_LEN));
+    TEST_ASSERT(UDP_BATCH_COALESCED == BatchTestQueue(UDP_STUB_SOCKET, 1, 10, &addr,
+                                                      LWM2MCORE_DTLS_COALESCE_MAX_LEN));
+    TEST_ASSERT(UDP_BATCH_QUEUED == BatchTestQueue(UDP_STUB_SOCKET, 2, 10, &addr, 0));
+    TEST_ASSERT(UDP_BATCH_QUEUED == BatchTestQueue(UDP_STUB_SOCKET, 3, 10, &addr,
+                                                   LWM2MCORE_DTLS_COALESCE_MAX_LEN));
+    udpBatch_End();
+    TEST_ASSERT(3 == UdpStubSentCount);
+    TEST_ASSERT(20 == UdpStubSent[0].len);
+    TEST_ASSERT((0 == UdpStubSent[0].data[0]) && (1 == UdpStubSent[0].data[10]));
+    TEST_ASSERT(2 == UdpStubSent[1].data[0]);
+    TEST_ASSERT(3 == UdpStubSent[2].data[0]);
+
+    // Connections: the DTLS records written by tinyDTLS are sent by SendToPeer()
+    memset(&securityObj, 0, sizeof(securityObj));
+    memset(&context, 0, sizeof(context));
+    securityObj.objID = LWM2MCORE_SECURITY_OID;
+    securityObj.readFunc = IndexTestSecurityRead;
+    TinydtlsStubContextPtr = &context;
+    TinydtlsStubIsWriteForwarded = true;
+    dtls_InitInstance(&instance);
+
+    IndexTestMode = LWM2M_SECURITY_MODE_PRE_SHARED_KEY;
+    for (i = 0; i < 2; i++)
     {
-        printf("RequestPtr is NULL!\n");
-        TEST_ASSERT(false);
+        snprintf(IndexTestUri, sizeof(IndexTestUri), "coaps://127.0.0.1:%d", INDEX_TEST_PORT + i);
+        conns[i] = dtls_CreateConnection(&instance, connListPtr, UDP_STUB_SOCKET, &securityObj, 0,
+                                         NULL, AF_INET);
+        TEST_ASSERT(NULL != conns[i]);
+        connListPtr = conns[i];
     }
 
-    size_t uriLength = strlen("www.sierrawireless.com");
-    RequestPtr->uri = (char*)lwm2m_malloc(uriLength+ 1);
-    strncpy(RequestPtr->uri, "www.sierrawireless.com", uriLength + 1);
-
-    RequestPtr->method = 1;
+    // NoSec connection to the same address as the first DTLS connection
+    IndexTestMode = LWM2M_SECURITY_MODE_NONE;
+    snprintf(IndexTestUri, sizeof(IndexTestUri), "coap://127.0.0.1:%d", INDEX_TEST_PORT);
+    noSecConnPtr = dtls_CreateConnection(&instance, connListPtr, UDP_STUB_SOCKET, &securityObj, 0,
+                                         NULL, AF_INET);
+    TEST_ASSERT(NULL != noSecConnPtr);
+    TEST_ASSERT(NULL == noSecConnPtr->dtlsSessionPtr);
+
+    TEST_ASSERT(LWM2MCORE_ERR_COMPLETED_OK ==
+                lwm2mcore_GetCounter(LWM2MCORE_COUNTER_DTLS_RECORDS_COALESCED, &coalesced));
+    BatchTestReset();
+
+    // Two records to the same server are packed in one datagram
+    udpBatch_Begin();
+    TEST_ASSERT(COAP_NO_ERROR == lwm2m_buffer_send(conns[0], message, 10, NULL, false));
+    TEST_ASSERT(COAP_NO_ERROR == lwm2m_buffer_send(conns[0], message, 20, NULL, false));
+    TEST_ASSERT(0 == UdpStubSentCount);
+    udpBatch_End();
+    TEST_ASSERT(1 == UdpStubSentCount);
+    TEST_ASSERT(30 == UdpStubSent[0].len);
+    TEST_ASSERT(0 == memcmp(UdpStubSent[0].data, message, 10));
+    TEST_ASSERT(0 == memcmp(UdpStubSent[0].data + 10, message, 20));
+    TEST_ASSERT(0 == memcmp(&(UdpStubSent[0].addr), &(conns[0]->addr), sizeof(addr)));
+    TEST_ASSERT(LWM2MCORE_ERR_COMPLETED_OK ==
+                lwm2mcore_GetCounter(LWM2MCORE_COUNTER_DTLS_RECORDS_COALESCED, &value));
+    TEST_ASSERT((coalesced + 1) == value);
+    coalesced = value;
+
+    // A record to another server starts a new datagram
+    BatchTestReset();
+    udpBatch_Begin();
+    TEST_ASSERT(COAP_NO_ERROR == lwm2m_buffer_send(conns[0], message, 10, NULL, false));
+    TEST_ASSERT(COAP_NO_ERROR == lwm2m_buffer_send(conns[1], message, 10, NULL, false));
+    TEST_ASSERT(COAP_NO_ERROR == lwm2m_buffer_send(conns[0], message, 10, NULL, false));
+    udpBatch_End();
+    TEST_ASSERT(3 == UdpStubSentCount);
+    TEST_ASSERT(0 == memcmp(&(UdpStubSent[0].addr), &(conns[0]->addr), sizeof(addr)));
+    TEST_ASSERT(0 == memcmp(&(UdpStubSent[1].addr), &(conns[1]->addr), sizeof(addr)));
+    TEST_ASSERT(0 == memcmp(&(UdpStubSent[2].addr), &(conns[0]->addr), sizeof(addr)));
+
+    // A datagram is not longer than LWM2MCORE_DTLS_COALESCE_MAX_LEN
+    BatchTestReset();
+    udpBatch_Begin();
+    TEST_ASSERT(COAP_NO_ERROR == lwm2m_buffer_send(conns[0], message, sizeof(message) - 10, NULL,
+                                                   false));
+    TEST_ASSERT(COAP_NO_ERROR == lwm2m_buffer_send(conns[0], message, 10, NULL, false));
+    TEST_ASSERT(COAP_NO_ERROR == lwm2m_buffer_send(conns[0], message, 1, NULL, false));
+    TEST_ASSERT(COAP_NO_ERROR == lwm2m_buffer_send(conns[1], message, sizeof(message), NULL,
+                                                   false));
+    TEST_ASSERT(COAP_NO_ERROR == lwm2m_buffer_send(conns[1], message, 1, NULL, false));
+    udpBatch_End();
+    TEST_ASSERT(4 == UdpStubSentCount);
+    TEST_ASSERT(LWM2MCORE_DTLS_COALESCE_MAX_LEN == UdpStubSent[0].len);
+    TEST_ASSERT(1 == UdpStubSent[1].len);
+    TEST_ASSERT(LWM2MCORE_DTLS_COALESCE_MAX_LEN == UdpStubSent[2].len);
+    TEST_ASSERT(1 == UdpStubSent[3].len);
+    TEST_ASSERT(LWM2MCORE_ERR_COMPLETED_OK ==
+                lwm2mcore_GetCounter(LWM2MCORE_COUNTER_DTLS_RECORDS_COALESCED, &value));
+    TEST_ASSERT((coalesced + 1) == value);
+    coalesced = value;
+
+    // The datagrams without security are never merged, even with a DTLS record
+    BatchTestReset();
+    udpBatch_Begin();
+    TEST_ASSERT(COAP_NO_ERROR == lwm2m_buffer_send(noSecConnPtr, message, 10, NULL, false));
+    TEST_ASSERT(COAP_NO_ERROR == lwm2m_buffer_send(noSecConnPtr, message, 10, NULL, false));
+    TEST_ASSERT(COAP_NO_ERROR == lwm2m_buffer_send(conns[0], message, 10, NULL, false));
+    TEST_ASSERT(COAP_NO_ERROR == lwm2m_buffer_send(noSecConnPtr, message, 10, NULL, false));
+    udpBatch_End();
+    TEST_ASSERT(4 == UdpStubSentCount);
+    for (i = 0; i < 4; i++)
+    {
+        TEST_ASSERT(10 == UdpStubSent[i].len);
+        TEST_ASSERT(0 == memcmp(&(UdpStubSent[i].addr), &addr, sizeof(addr)));
+    }
+    TEST_ASSERT(LWM2MCORE_ERR_COMPLETED_OK ==
+                lwm2mcore_GetCounter(LWM2MCORE_COUNTER_DTLS_RECORDS_COALESCED, &value));
+    TEST_ASSERT(coalesced == value);
+
+    // lwm2m_connect_server() frees the connections without DTLS context
+    lwm2m_free(noSecConnPtr);
+    dtls_FreeConnection(&instance, connListPtr);
+    dtls_FreeInstance(&instance);
+    TinydtlsStubIsWriteForwarded = false;
+    TinydtlsStubContextPtr = NULL;
+    BatchTestReset();
+}
+#endif
 
-    RequestPtr->bufferLength = strlen("123456789");
-    RequestPtr->buffer = (uint8_t*)lwm2m_malloc(RequestPtr->bufferLength + 1);
-    strncpy((char*)RequestPtr->buffer, "123456789", RequestPtr->bufferLength + 1);
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test function for the adaptive block size
+ */
+//--------------------------------------------------------------------------------------------------
+static void test_blockSize
+(
+    void
+)
+{
+    blockSize_Estimator_t estimator;
+    pushStream_Stream_t stream;
+    size_t remaining = 202;
+    size_t len;
+    int i;
+
+    blockSize_Init(&estimator);
+    TEST_ASSERT(LWM2MCORE_BLOCK_SIZE_MAX == estimator.size);
+    TEST_ASSERT(false == blockSize_ReportSuccess(&estimator));
+
+    // Losses halve the block size
+    TEST_ASSERT(true == blockSize_ReportLoss(&estimator));
+    TEST_ASSERT(true == blockSize_ReportLoss(&estimator));
+    TEST_ASSERT((LWM2MCORE_BLOCK_SIZE_MAX / 4) == estimator.size);
+
+    // The double size is probed after a series of successes, a lost probe delays the next one
+    for (i = 1; i < LWM2MCORE_BLOCK_SIZE_PROBE; i++)
+    {
+        TEST_ASSERT(false == blockSize_ReportSuccess(&estimator));
+    }
+    TEST_ASSERT(true == blockSize_ReportSuccess(&estimator));
+    TEST_ASSERT(((LWM2MCORE_BLOCK_SIZE_MAX / 2) == estimator.size) && estimator.isProbing);
+    TEST_ASSERT(true == blockSize_ReportLoss(&estimator));
+    TEST_ASSERT((2 * LWM2MCORE_BLOCK_SIZE_PROBE) == estimator.probeAfter);
+    for (i = 1; i < (2 * LWM2MCORE_BLOCK_SIZE_PROBE); i++)
+    {
+        TEST_ASSERT(false == blockSize_ReportSuccess(&estimator));
+    }
+    TEST_ASSERT(true == blockSize_ReportSuccess(&estimator));
+    TEST_ASSERT(false == blockSize_ReportSuccess(&estimator));
+    TEST_ASSERT((LWM2MCORE_BLOCK_SIZE_PROBE == estimator.probeAfter) && (!estimator.isProbing));
 
-    RequestPtr->messageId = 100;
-    RequestPtr->tokenLength = 3;
-    memcpy(RequestPtr->token, "hi", 3);
-    RequestPtr->contentType = 1;
+    // The block size is not lowered below the minimum
+    while (blockSize_ReportLoss(&estimator))
+    {
+    }
+    TEST_ASSERT(LWM2MCORE_BLOCK_SIZE_MIN == estimator.size);
+
+    // Streamed push: the block number follows the block size changes
+    memset(&stream, 0, sizeof(stream));
+    TEST_ASSERT(true == pushStream_Start(&stream, PushStreamReader, &remaining,
+                                         LWM2MCORE_PUSH_CONTENT_CBOR));
+    TEST_ASSERT(false == pushStream_SetBlockSize(&stream, 8));
+    TEST_ASSERT(true == pushStream_SetBlockSize(&stream, 64));
+    TEST_ASSERT(true == pushStream_ReadBlock(&stream, &len));
+    TEST_ASSERT((64 == len) && (0 == stream.blockNum) && stream.isMore);
+    TEST_ASSERT(false == pushStream_SetBlockSize(&stream, 128));
+    TEST_ASSERT(true == pushStream_ReadBlock(&stream, &len));
+    TEST_ASSERT((64 == len) && (1 == stream.blockNum) && stream.isMore);
+    TEST_ASSERT(true == pushStream_SetBlockSize(&stream, 128));
+    TEST_ASSERT(true == pushStream_ReadBlock(&stream, &len));
+    TEST_ASSERT((74 == len) && (1 == stream.blockNum) && (!stream.isMore));
+    TEST_ASSERT(74 == stream.blockPtr[0]);
+    TEST_ASSERT(true == pushStream_SetBlockSize(&stream, 2048));
+    TEST_ASSERT(LWM2MCORE_PUSH_BLOCK_SIZE == stream.blockSize);
+    pushStream_Stop(&stream);
+}
 
-    Lwm2mServerResponse.code = COAP_RESOURCE_CHANGED;
+static void test_dtls_BlockSize
+(
+    void
+)
+{
+    // Confirmable PUT requests with a Block1 option (block 0, size 1024), with and without more
+    // blocks to follow, and the acknowledgement of the server
+    uint8_t fullBlock[] = { 0x40, 0x03, 0x00, 0x01, 0xD1, 0x0E, 0x0E, 0xFF, 0x00 };
+    uint8_t lastBlock[] = { 0x40, 0x03, 0x00, 0x02, 0xD1, 0x0E, 0x06, 0xFF, 0x00 };
+    uint8_t ack[] = { 0x60, 0x44, 0x00, 0x01 };
+    dtls_Connection_t* connPtr;
+    lwm2m_object_t securityObj;
+    dtls_Instance_t instance;
+    uint16_t mid;
+    int i;
+
+    memset(&securityObj, 0, sizeof(securityObj));
+    securityObj.objID = LWM2MCORE_SECURITY_OID;
+    securityObj.readFunc = IndexTestSecurityRead;
+    dtls_InitInstance(&instance);
+    IndexTestMode = LWM2M_SECURITY_MODE_NONE;
+    snprintf(IndexTestUri, sizeof(IndexTestUri), "coap://127.0.0.1:%d", INDEX_TEST_PORT);
+    connPtr = dtls_CreateConnection(&instance, NULL, UDP_STUB_SOCKET, &securityObj, 0, NULL,
+                                    AF_INET);
+    TEST_ASSERT(NULL != connPtr);
+    TEST_ASSERT(LWM2MCORE_BLOCK_SIZE_MAX == connPtr->blockSize.size);
+    BatchTestReset();
+
+    // The first retransmission of a full block is a loss, the next ones and its late
+    // acknowledgement are not reported again
+    for (i = 0; i < 3; i++)
+    {
+        TEST_ASSERT(COAP_NO_ERROR == lwm2m_buffer_send(connPtr, fullBlock, sizeof(fullBlock), NULL,
+                                                       false));
+    }
+    TEST_ASSERT((LWM2MCORE_BLOCK_SIZE_MAX / 2) == connPtr->blockSize.size);
+    TEST_ASSERT(0 == dtls_HandlePacket(connPtr, ack, sizeof(ack)));
+    TEST_ASSERT(0 == connPtr->blockSize.successes);
 
-    Lwm2mServerResponse.payloadLength = strlen("123456789");
-    Lwm2mServerResponse.payloadPtr = (uint8_t*)lwm2m_malloc(Lwm2mServerResponse.payloadLength + 1);
-    strncpy((char*)Lwm2mServerResponse.payloadPtr, "123456789",
-            Lwm2mServerResponse.payloadLength + 1);
+    // The last block does not tell whether the block size goes through
+    for (i = 0; i < 2; i++)
+    {
+        TEST_ASSERT(COAP_NO_ERROR == lwm2m_buffer_send(connPtr, lastBlock, sizeof(lastBlock), NULL,
+                                                       false));
+    }
+    TEST_ASSERT((LWM2MCORE_BLOCK_SIZE_MAX / 2) == connPtr->blockSize.size);
+    ack[3] = 2;
+    TEST_ASSERT(0 == dtls_HandlePacket(connPtr, ack, sizeof(ack)));
+    TEST_ASSERT(0 == connPtr->blockSize.successes);
 
-    TEST_ASSERT(lwm2mcore_SendAsyncResponse(Lwm2mcoreRef, RequestPtr, &Lwm2mServerResponse)
-                != false);
+    // Full blocks acknowledged after a single transmission raise the block size again
+    for (mid = 3; mid < (3 + LWM2MCORE_BLOCK_SIZE_PROBE); mid++)
+    {
+        fullBlock[3] = (uint8_t)mid;
+        ack[3] = (uint8_t)mid;
+        TEST_ASSERT(COAP_NO_ERROR == lwm2m_buffer_send(connPtr, fullBlock, sizeof(fullBlock), NULL,
+                                                       false));
+        TEST_ASSERT(0 == dtls_HandlePacket(connPtr, ack, sizeof(ack)));
+    }
+    TEST_ASSERT(LWM2MCORE_BLOCK_SIZE_MAX == connPtr->blockSize.size);
 
-    lwm2m_free(RequestPtr->uri);
-    lwm2m_free(RequestPtr->buffer);
-    lwm2m_free(RequestPtr);
-    lwm2m_free(Lwm2mServerResponse.payloadPtr);
+    // lwm2m_connect_server() frees the connections without DTLS context
+    lwm2m_free(connPtr);
+    dtls_FreeInstance(&instance);
+    BatchTestReset();
 }
 
-//-------------------------------------------------------------------------------------------------
+//--------------------------------------------------------------------------------------------------
 /**
- * Test function for lwm2mcore_SetLifetime API
+ * Thread writing logs from a single call site, concurrently with the test thread
  */
 //--------------------------------------------------------------------------------------------------
-static void test_lwm2mcore_SetLifetime
+#ifdef LWM2MCORE_BINARY_LOGS
+static void* LogThread
 (
-    void
+    void* contextPtr                    ///< [IN] Unused
 )
 {
-    /* Invalid value */
-    TEST_ASSERT(lwm2mcore_SetLifetime(0) == LWM2MCORE_ERR_INCORRECT_RANGE);
+    int i;
 
-    /* No DM servers */
-    TEST_ASSERT(lwm2mcore_SetLifetime(8600) == LWM2MCORE_ERR_COMPLETED_OK);
+    (void)contextPtr;
+    for (i = 0; i < (2 * LWM2MCORE_LOG_RATE_BURST); i++)
+    {
+        LOG_LEVEL_ARG(LWM2MCORE_LOG_LEVEL_DEBUG, "Thread test %d", i);
+    }
+    return NULL;
 }
+#endif
 
-//-------------------------------------------------------------------------------------------------
+//--------------------------------------------------------------------------------------------------
 /**
- * Test function for lwm2mcore_UpdateSwList API
+ * Test function for the LwM2MCore log sinks
  */
 //--------------------------------------------------------------------------------------------------
-static void test_lwm2mcore_UpdateSwList
+static void test_lwm2mcore_Logs
 (
     void
 )
 {
-    int i = 0;
-    char emptyList[] = "";
-    char objectsList[256] = {0};
-    int offset = 0;
-
-    for (i = 0; i < 10; i++)
+#ifdef LWM2MCORE_BINARY_LOGS
+    uint8_t buffer[1024];
+    pthread_t threads[4];
+    lwm2mcore_LogRecordHeader_t header;
+    const char* sitePtr;
+    int32_t value;
+    size_t len;
+    size_t offset;
+    int count;
+    int i;
+#endif
+
+    TEST_ASSERT(LWM2MCORE_ERR_INVALID_ARG == lwm2mcore_SetLogSink((lwm2mcore_LogSink_t)99));
+
+#ifdef LWM2MCORE_BINARY_LOGS
+    TEST_ASSERT(LWM2MCORE_ERR_COMPLETED_OK == lwm2mcore_SetLogSink(LWM2MCORE_LOG_SINK_BINARY));
+    while (lwm2mcore_ReadLogRing(buffer, sizeof(buffer)))
     {
-        // Add an object instance each loop
-        offset += snprintf(objectsList + offset, sizeof(objectsList) - offset, "</lwm2m/9/%d>", i);
-        TEST_ASSERT(offset>0);
-
-        // At this point, Lwm2mcoreRef is NULL
-        TEST_ASSERT(lwm2mcore_UpdateSwList(Lwm2mcoreRef, objectsList, strlen(objectsList)) == true);
-
-        test_lwm2mcore_Init();
+        // Drop the records of the previous tests
+    }
 
-        TEST_ASSERT(lwm2mcore_UpdateSwList(Lwm2mcoreRef, emptyList, strlen(emptyList)) == true);
+    // The record stores the call site identifier and the raw arguments
+    LOG_LEVEL_ARG(LWM2MCORE_LOG_LEVEL_INFO, "Log test %d %s", 1234, "abc");
+    len = lwm2mcore_ReadLogRing(buffer, sizeof(buffer));
+    TEST_ASSERT((sizeof(header) + sizeof(value) + 1 + 3) == len);
+    memcpy(&header, buffer, sizeof(header));
+    TEST_ASSERT(len == header.len);
+    TEST_ASSERT(LWM2MCORE_LOG_RECORD_MESSAGE == header.type);
+    TEST_ASSERT(LWM2MCORE_LOG_LEVEL_INFO == header.level);
+    sitePtr = __start_lwm2mcore_log + header.siteId;
+    TEST_ASSERT(strstr(sitePtr, "tests.c:"));
+    TEST_ASSERT(!strcmp(sitePtr + strlen(sitePtr) + 1, "Log test %d %s"));
+    memcpy(&value, &buffer[sizeof(header)], sizeof(value));
+    TEST_ASSERT(1234 == value);
+    TEST_ASSERT(3 == buffer[sizeof(header) + sizeof(value)]);
+    TEST_ASSERT(!memcmp(&buffer[sizeof(header) + sizeof(value) + 1], "abc", 3));
+
+    // Only LWM2MCORE_LOG_RATE_BURST logs of a call site are stored per period
+    for (i = 0; i < (2 * LWM2MCORE_LOG_RATE_BURST); i++)
+    {
+        LOG_LEVEL_ARG(LWM2MCORE_LOG_LEVEL_DEBUG, "Rate test %d", i);
+    }
+    len = lwm2mcore_ReadLogRing(buffer, sizeof(buffer));
+    for (offset = 0, count = 0; offset < len; offset += header.len, count++)
+    {
+        memcpy(&header, &buffer[offset], sizeof(header));
+        TEST_ASSERT(LWM2MCORE_LOG_RECORD_MESSAGE == header.type);
+    }
+    TEST_ASSERT(LWM2MCORE_LOG_RATE_BURST == count);
 
-        test_lwm2mcore_Free();
+    // The rate limitation and the ring buffer are shared by the threads writing logs
+    for (i = 0; i < 4; i++)
+    {
+        TEST_ASSERT(0 == pthread_create(&threads[i], NULL, LogThread, NULL));
+    }
+    for (i = 0; i < 4; i++)
+    {
+        TEST_ASSERT(0 == pthread_join(threads[i], NULL));
     }
+    len = lwm2mcore_ReadLogRing(buffer, sizeof(buffer));
+    for (offset = 0, count = 0; offset < len; offset += header.len, count++)
+    {
+        memcpy(&header, &buffer[offset], sizeof(header));
+        TEST_ASSERT(LWM2MCORE_LOG_RECORD_MESSAGE == header.type);
+        TEST_ASSERT((sizeof(header) + sizeof(value)) == header.len);
+    }
+    TEST_ASSERT(len == offset);
+    TEST_ASSERT(LWM2MCORE_LOG_RATE_BURST == count);
+#else
+    TEST_ASSERT(LWM2MCORE_ERR_OP_NOT_SUPPORTED ==
+                lwm2mcore_SetLogSink(LWM2MCORE_LOG_SINK_BINARY));
+#endif
+
+    TEST_ASSERT(LWM2MCORE_ERR_COMPLETED_OK == lwm2mcore_SetLogSink(LWM2MCORE_LOG_SINK_TEXT));
 }
 
-//-------------------------------------------------------------------------------------------------
+//--------------------------------------------------------------------------------------------------
 /**
- * Test function for lwm2mcore_ResourceRead API
+ * Test function for the performance metrics and the object 33409
  */
 //--------------------------------------------------------------------------------------------------
-static void test_lwm2mcore_ResourceRead
+static void test_lwm2mcore_Metrics
 (
     void
 )
 {
-    bool result;
-    char buffer[256];
-    size_t len = sizeof(buffer);
+    lwm2mcore_Histogram_t histogram;
+    uint64_t value;
+    int i;
+#ifdef LWM2M_OBJECT_33409
+    char buffer[32];
+    size_t len;
+#endif
 
-    memset(buffer, 0, 256);
+    lwm2mcore_ResetMetrics();
 
     // Invalid arguments
-    result = lwm2mcore_ResourceRead(LWM2MCORE_DEVICE_OID,
-                                    0,
-                                    LWM2MCORE_DEVICE_MANUFACTURER_RID,
-                                    0,
-                                    NULL,
-                                    &len);
-    TEST_ASSERT(false == result);
-
-    result = lwm2mcore_ResourceRead(LWM2MCORE_DEVICE_OID,
-                                    0,
-                                    LWM2MCORE_DEVICE_MANUFACTURER_RID,
-                                    0,
-                                    buffer,
-                                    NULL);
-    TEST_ASSERT(false == result);
+    TEST_ASSERT(LWM2MCORE_ERR_INVALID_ARG == lwm2mcore_GetHistogram(LWM2MCORE_METRIC_MAX,
+                                                                    &histogram));
+    TEST_ASSERT(LWM2MCORE_ERR_INVALID_ARG == lwm2mcore_GetHistogram(LWM2MCORE_METRIC_READ, NULL));
+    TEST_ASSERT(LWM2MCORE_ERR_INVALID_ARG == lwm2mcore_GetCounter(LWM2MCORE_COUNTER_MAX, &value));
+    TEST_ASSERT(NULL == lwm2mcore_GetMetricName(LWM2MCORE_METRIC_MAX));
 
-    // Read a resource which does not support read handler
-    result = lwm2mcore_ResourceRead(LWM2MCORE_DEVICE_OID,
-                                    0,
-                                    LWM2MCORE_DEVICE_REBOOT_RID,
-                                    0,
-                                    buffer,
-                                    &len);
-    TEST_ASSERT(false == result);
+    // A registration update round trip is measured between its start and end events
+    smanager_SendSessionEvent(EVENT_TYPE_REG_UPDATE, EVENT_STATUS_STARTED, NULL);
+    smanager_SendSessionEvent(EVENT_TYPE_REG_UPDATE, EVENT_STATUS_DONE_FAIL, NULL);
+    TEST_ASSERT(LWM2MCORE_ERR_COMPLETED_OK == lwm2mcore_GetHistogram(LWM2MCORE_METRIC_REG_UPDATE,
+                                                                     &histogram));
+    TEST_ASSERT(1 == histogram.count);
+    TEST_ASSERT(1 == histogram.errorCount);
+    for (i = 0, value = 0; i < LWM2MCORE_METRIC_BUCKETS; i++)
+    {
+        value += histogram.buckets[i];
+    }
+    TEST_ASSERT(1 == value);
 
-    // Read a not supported resource
-    result = lwm2mcore_ResourceRead(LWM2MCORE_DEVICE_OID,
-                                    0,
-                                    255,
-                                    0,
-                                    buffer,
-                                    &len);
-    TEST_ASSERT(false == result);
+    // An end event without start is not measured
+    smanager_SendSessionEvent(EVENT_TYPE_REG_UPDATE, EVENT_STATUS_DONE_FAIL, NULL);
+    TEST_ASSERT(LWM2MCORE_ERR_COMPLETED_OK == lwm2mcore_GetHistogram(LWM2MCORE_METRIC_REG_UPDATE,
+                                                                     &histogram));
+    TEST_ASSERT(1 == histogram.count);
 
-    // Read a valid resource (string)
-    result = lwm2mcore_ResourceRead(LWM2MCORE_DEVICE_OID,
-                                    0,
-                                    LWM2MCORE_DEVICE_MANUFACTURER_RID,
-                                    0,
-                                    buffer,
-                                    &len);
-    TEST_ASSERT(true == result);
-    TEST_ASSERT(!strcmp(buffer, "Sierra Wireless"));
-    TEST_ASSERT(len == strlen("Sierra Wireless"))  ;
+#ifdef LWM2M_OBJECT_33409
+    // Diagnostics object
+    len = sizeof(buffer);
+    memset(buffer, 0, sizeof(buffer));
+    TEST_ASSERT(true == lwm2mcore_ResourceRead(LWM2MCORE_PERF_METRICS_OID,
+                                               0,
+                                               LWM2MCORE_PERF_METRICS_NAME_RID,
+                                               LWM2MCORE_METRIC_REG_UPDATE,
+                                               buffer,
+                                               &len));
+    TEST_ASSERT(!strcmp(buffer, "reg_update"));
 
-    // Read a valid resource (int)
     len = sizeof(buffer);
-    result = lwm2mcore_ResourceRead(LWM2MCORE_EXT_CONN_STATS_OID,
-                                    0,
-                                    LWM2MCORE_EXT_CONN_STATS_TEMPERATURE_RID,
-                                    0,
-                                    buffer,
-                                    &len);
-    TEST_ASSERT(true == result);
-    TEST_ASSERT(!strcmp(buffer, "26"));
-    TEST_ASSERT(len == strlen("26"))  ;
+    memset(buffer, 0, sizeof(buffer));
+    TEST_ASSERT(true == lwm2mcore_ResourceRead(LWM2MCORE_PERF_METRICS_OID,
+                                               0,
+                                               LWM2MCORE_PERF_METRICS_COUNT_RID,
+                                               LWM2MCORE_METRIC_REG_UPDATE,
+                                               buffer,
+                                               &len));
+    TEST_ASSERT(!strcmp(buffer, "1"));
+#endif
+
+    lwm2mcore_ResetMetrics();
+    TEST_ASSERT(LWM2MCORE_ERR_COMPLETED_OK == lwm2mcore_GetHistogram(LWM2MCORE_METRIC_REG_UPDATE,
+                                                                     &histogram));
+    TEST_ASSERT(0 == histogram.count);
+    TEST_ASSERT(LWM2MCORE_ERR_COMPLETED_OK == lwm2mcore_GetCounter(
+                                                            LWM2MCORE_COUNTER_COAP_RETRANSMISSIONS,
+                                                            &value));
+    TEST_ASSERT(0 == value);
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -1550,6 +4263,12 @@ int main
     printf("======== test of smanager_SendSessionEvent() ========\n");
     test_smanager_SendSessionEvent();
 
+    printf("======== test of performance metrics ========\n");
+    test_lwm2mcore_Metrics();
+
+    printf("======== test of log sinks ========\n");
+    test_lwm2mcore_Logs();
+
     printf("======== test of lwm2mcore_Disconnect() ========\n");
     test_lwm2mcore_Disconnect();
 
@@ -1565,6 +4284,79 @@ int main
     printf("======== test of lwm2mcore_ResourceRead() ========\n");
     test_lwm2mcore_ResourceRead();
 
+    printf("======== test of lwm2mcore_ResourceRead() with registered objects ========\n");
+    test_lwm2mcore_ResourceReadRegistered();
+
+    printf("======== test of lwm2mcore_ResourceRead() with typed handlers ========\n");
+    test_lwm2mcore_ResourceReadTypedValue();
+
+    printf("======== test of omanager_CheckNotification() ========\n");
+    test_omanager_CheckNotification();
+
+    printf("======== test of lwm2mcore_SetNotificationWindow() ========\n");
+    test_lwm2mcore_SetNotificationWindow();
+
+    printf("======== test of several client instances ========\n");
+    test_lwm2mcore_MultiInstance();
+
+    printf("======== test of multiple instance resource READ ========\n");
+    test_omanager_ReadResourceInstances();
+
+    printf("======== test of chunked resource READ ========\n");
+    test_omanager_ReadChunks();
+
+    printf("======== test of the resource read value cache ========\n");
+    test_omanager_ResourceCache();
+
+    printf("======== test of the precedence of the typed handlers ========\n");
+    test_omanager_TypedHandlerPrecedence();
+
+    printf("======== test of the notification of several object instances ========\n");
+    test_omanager_CheckNotificationInstances();
+
+    printf("======== test of the notification of two servers ========\n");
+    test_lwm2mcore_NotifyTwoServers();
+
+    printf("======== test of timerWheel ========\n");
+    test_timerWheel();
+
+    printf("======== test of push queue ========\n");
+    test_pushQueue();
+
+    printf("======== test of streamed push ========\n");
+    test_pushStream();
+
+    printf("======== test of NAT timeout learning ========\n");
+    test_natTimeout();
+
+    printf("======== test of CoAP round-trip time estimation ========\n");
+    test_coapRtt();
+
+    printf("======== test of adaptive block size ========\n");
+    test_blockSize();
+
+    printf("======== test of block size selection on a connection ========\n");
+    test_dtls_BlockSize();
+
+#ifdef LWM2MCORE_DTLS_CID
+    printf("======== test of DTLS Connection ID ========\n");
+    test_dtls_ConnectionId();
+#endif
+
+    printf("======== test of DTLS connection index ========\n");
+    test_dtls_ConnectionIndex();
+
+    printf("======== test of batched UDP send ========\n");
+    test_udpBatch();
+
+    printf("======== test of lwm2mcore_UdpReceiveBatchCb() ========\n");
+    test_lwm2mcore_UdpReceiveBatchCb();
+
+#ifdef LWM2MCORE_DTLS_COALESCE
+    printf("======== test of DTLS records coalescing ========\n");
+    test_dtls_Coalesce();
+#endif
+
     printf("======== test of downloader() ========\n");
     test_lwm2mcore_Downloader();
 
@@ -10,6 +10,56 @@
 
 #include "dtls.h"
 #include "liblwm2m.h"
+#include "tinydtls_stub.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Context returned by dtls_new_context()
+ */
+//--------------------------------------------------------------------------------------------------
+dtls_context_t* TinydtlsStubContextPtr = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Peer returned by dtls_get_peer()
+ */
+//--------------------------------------------------------------------------------------------------
+dtls_peer_t* TinydtlsStubPeerPtr = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of calls of dtls_resume()
+ */
+//--------------------------------------------------------------------------------------------------
+int TinydtlsStubResumeCount = 0;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of calls of dtls_write()
+ */
+//--------------------------------------------------------------------------------------------------
+int TinydtlsStubWriteCount = 0;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set if the data of dtls_write() are given to the write handler of the context as a record
+ */
+//--------------------------------------------------------------------------------------------------
+bool TinydtlsStubIsWriteForwarded = false;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record written by dtls_handle_message() in reply to a received message
+ */
+//--------------------------------------------------------------------------------------------------
+uint8_t* TinydtlsStubReplyPtr = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Length of the record written by dtls_handle_message()
+ */
+//--------------------------------------------------------------------------------------------------
+size_t TinydtlsStubReplyLen = 0;
 
 void dtls_init
 (
@@ -24,8 +74,11 @@ dtls_context_t* dtls_new_context
     void *app_data
 )
 {
-    (void)app_data;
-    return NULL;
+    if (TinydtlsStubContextPtr)
+    {
+        TinydtlsStubContextPtr->app = app_data;
+    }
+    return TinydtlsStubContextPtr;
 }
 
 void dtls_free_context
@@ -45,10 +98,11 @@ int dtls_write
     size_t len
 )
 {
-    (void)ctx;
-    (void)dst;
-    (void)buf;
-    (void)len;
+    TinydtlsStubWriteCount++;
+    if ((TinydtlsStubIsWriteForwarded) && (ctx) && (ctx->h) && (ctx->h->write))
+    {
+        return ctx->h->write(ctx, dst, buf, len);
+    }
     return -1;
 }
 
@@ -60,10 +114,16 @@ int dtls_handle_message
     int msglen
 )
 {
-    (void)ctx;
-    (void)session;
     (void)msg;
     (void)msglen;
+    if ((TinydtlsStubReplyPtr) && (ctx) && (ctx->h) && (ctx->h->write))
+    {
+        if (0 > ctx->h->write(ctx, session, TinydtlsStubReplyPtr, TinydtlsStubReplyLen))
+        {
+            return -1;
+        }
+        return 0;
+    }
     return -1;
 }
 
@@ -75,7 +135,7 @@ dtls_peer_t* dtls_get_peer
 {
     (void)ctx;
     (void)session;
-    return NULL;
+    return TinydtlsStubPeerPtr;
 }
 
 void dtls_reset_peer
@@ -119,6 +179,7 @@ int dtls_resume
 {
     (void)ctx;
     (void)dst;
+    TinydtlsStubResumeCount++;
     return -1;
 };
 
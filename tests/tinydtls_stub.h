@@ -0,0 +1,68 @@
+/**
+ * @file tinydtls_stub.h
+ *
+ * Control of the tinydtls stubs
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+#ifndef __TESTS_TINYDTLS_STUB_H__
+#define __TESTS_TINYDTLS_STUB_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "dtls.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Context returned by dtls_new_context() (NULL by default)
+ */
+//--------------------------------------------------------------------------------------------------
+extern dtls_context_t* TinydtlsStubContextPtr;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Peer returned by dtls_get_peer() (NULL by default)
+ */
+//--------------------------------------------------------------------------------------------------
+extern dtls_peer_t* TinydtlsStubPeerPtr;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of calls of dtls_resume()
+ */
+//--------------------------------------------------------------------------------------------------
+extern int TinydtlsStubResumeCount;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of calls of dtls_write()
+ */
+//--------------------------------------------------------------------------------------------------
+extern int TinydtlsStubWriteCount;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set if the data of dtls_write() are given to the write handler of the context as a record
+ * (false by default)
+ */
+//--------------------------------------------------------------------------------------------------
+extern bool TinydtlsStubIsWriteForwarded;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record written by dtls_handle_message() in reply to a received message (NULL by default: the
+ * message is rejected)
+ */
+//--------------------------------------------------------------------------------------------------
+extern uint8_t* TinydtlsStubReplyPtr;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Length of the record written by dtls_handle_message()
+ */
+//--------------------------------------------------------------------------------------------------
+extern size_t TinydtlsStubReplyLen;
+
+#endif /* __TESTS_TINYDTLS_STUB_H__ */
@@ -0,0 +1,198 @@
+//-------------------------------------------------------------------------------------------------
+/**
+ * @file udp_stub.c
+ *
+ * Stub code for the UDP adaptation layer: the sent datagrams are recorded instead of being sent.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//-------------------------------------------------------------------------------------------------
+
+#include <stdlib.h>
+#include <string.h>
+#include <arpa/inet.h>
+#include "udp_stub.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Datagrams sent, in the send order
+ */
+//--------------------------------------------------------------------------------------------------
+UdpStubDatagram_t UdpStubSent[UDP_STUB_SENT_MAX];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of datagrams sent
+ */
+//--------------------------------------------------------------------------------------------------
+size_t UdpStubSentCount = 0;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of calls of lwm2mcore_UdpSendBatch()
+ */
+//--------------------------------------------------------------------------------------------------
+int UdpStubBatchCount = 0;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of datagrams sent by a call of lwm2mcore_UdpSendBatch()
+ */
+//--------------------------------------------------------------------------------------------------
+int UdpStubBatchResult = 0;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record a sent datagram
+ *
+ * @return
+ *  - true if the datagram is recorded
+ *  - false else
+ */
+//--------------------------------------------------------------------------------------------------
+static bool RecordDatagram
+(
+    int sock,                           ///< [IN] Socket
+    int batchId,                        ///< [IN] Number of the lwm2mcore_UdpSendBatch() call
+    const void* bufferPtr,              ///< [IN] Datagram data
+    size_t length,                      ///< [IN] Datagram length
+    const struct sockaddr* addrPtr,     ///< [IN] Destination address
+    socklen_t addrLen                   ///< [IN] Destination address length
+)
+{
+    UdpStubDatagram_t* datagramPtr;
+
+    if ((UDP_STUB_SENT_MAX == UdpStubSentCount)
+     || (LWM2MCORE_UDP_MAX_PACKET_SIZE < length)
+     || (sizeof(struct sockaddr_storage) < addrLen))
+    {
+        return false;
+    }
+
+    datagramPtr = &UdpStubSent[UdpStubSentCount];
+    memset(datagramPtr, 0, sizeof(UdpStubDatagram_t));
+    datagramPtr->sock = sock;
+    datagramPtr->batchId = batchId;
+    memcpy(datagramPtr->data, bufferPtr, length);
+    datagramPtr->len = (uint32_t)length;
+    memcpy(&(datagramPtr->addr), addrPtr, addrLen);
+    datagramPtr->addrLen = addrLen;
+    UdpStubSentCount++;
+    return true;
+}
+
+bool lwm2mcore_UdpOpen
+(
+    lwm2mcore_Ref_t instanceRef,
+    lwm2mcore_UdpCb_t callback,
+    lwm2mcore_SocketConfig_t* configPtr
+)
+{
+    (void)callback;
+    configPtr->instanceRef = instanceRef;
+    configPtr->af = AF_INET;
+    configPtr->type = LWM2MCORE_SOCK_DGRAM;
+    configPtr->proto = LWM2MCORE_SOCK_UDP;
+    configPtr->sock = UDP_STUB_SOCKET;
+    return true;
+}
+
+bool lwm2mcore_UdpClose
+(
+    lwm2mcore_SocketConfig_t config
+)
+{
+    (void)config;
+    return true;
+}
+
+void lwm2mcore_UdpSocketClose
+(
+    int sockFd
+)
+{
+    (void)sockFd;
+}
+
+bool lwm2mcore_UdpConnect
+(
+    char* serverAddressPtr,
+    char* hostPtr,
+    char* portPtr,
+    int addressFamily,
+    struct sockaddr* saPtr,
+    socklen_t* slPtr,
+    int* sockPtr
+)
+{
+    struct sockaddr_in addr;
+
+    (void)serverAddressPtr;
+
+    // Only the numeric IPv4 addresses are resolved
+    memset(&addr, 0, sizeof(addr));
+    if ((AF_INET != addressFamily) || (1 != inet_pton(AF_INET, hostPtr, &(addr.sin_addr))))
+    {
+        return false;
+    }
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)atoi(portPtr));
+
+    memcpy(saPtr, &addr, sizeof(addr));
+    *slPtr = sizeof(addr);
+    *sockPtr = UDP_STUB_SOCKET;
+    return true;
+}
+
+ssize_t lwm2mcore_UdpSend
+(
+    int sockfd,
+    const void* bufferPtr,
+    size_t length,
+    int flags,
+    const struct sockaddr* dest_addrPtr,
+    socklen_t addrlen
+)
+{
+    (void)flags;
+
+    if (!RecordDatagram(sockfd, 0, bufferPtr, length, dest_addrPtr, addrlen))
+    {
+        return -1;
+    }
+    return (ssize_t)length;
+}
+
+int lwm2mcore_UdpSendBatch
+(
+    int sockfd,
+    const lwm2mcore_UdpDatagram_t* datagramsPtr,
+    size_t count
+)
+{
+    size_t i;
+
+    UdpStubBatchCount++;
+    if (0 > UdpStubBatchResult)
+    {
+        return -1;
+    }
+    if ((0 != UdpStubBatchResult) && ((size_t)UdpStubBatchResult < count))
+    {
+        count = (size_t)UdpStubBatchResult;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        if (!RecordDatagram(sockfd,
+                            UdpStubBatchCount,
+                            datagramsPtr[i].bufferPtr,
+                            datagramsPtr[i].len,
+                            (const struct sockaddr*)&(datagramsPtr[i].addr),
+                            datagramsPtr[i].addrLen))
+        {
+            return -1;
+        }
+    }
+    return (int)count;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file udp_stub.h
+ *
+ * Control of the UDP stubs
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+#ifndef __TESTS_UDP_STUB_H__
+#define __TESTS_UDP_STUB_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <platform/types.h>
+#include <platform/inet.h>
+#include <lwm2mcore/lwm2mcore.h>
+#include <lwm2mcore/udp.h>
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Socket returned by lwm2mcore_UdpOpen() and lwm2mcore_UdpConnect()
+ */
+//--------------------------------------------------------------------------------------------------
+#define UDP_STUB_SOCKET     3
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of recorded datagrams
+ */
+//--------------------------------------------------------------------------------------------------
+#define UDP_STUB_SENT_MAX   64
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Datagram sent by lwm2mcore_UdpSend() or lwm2mcore_UdpSendBatch()
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    int                     sock;                                   ///< Socket
+    int                     batchId;                                ///< Number of the
+                                                                    ///< lwm2mcore_UdpSendBatch()
+                                                                    ///< call, 0 if sent by
+                                                                    ///< lwm2mcore_UdpSend()
+    uint8_t                 data[LWM2MCORE_UDP_MAX_PACKET_SIZE];    ///< Datagram data
+    uint32_t                len;                                    ///< Datagram length
+    struct sockaddr_storage addr;                                   ///< Destination address
+    socklen_t               addrLen;                                ///< addr parameter length
+}UdpStubDatagram_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Datagrams sent, in the send order
+ */
+//--------------------------------------------------------------------------------------------------
+extern UdpStubDatagram_t UdpStubSent[UDP_STUB_SENT_MAX];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of datagrams sent
+ */
+//--------------------------------------------------------------------------------------------------
+extern size_t UdpStubSentCount;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of calls of lwm2mcore_UdpSendBatch()
+ */
+//--------------------------------------------------------------------------------------------------
+extern int UdpStubBatchCount;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of datagrams sent by a call of lwm2mcore_UdpSendBatch(): 0 for no limit, -1 for
+ * a send error (0 by default)
+ */
+//--------------------------------------------------------------------------------------------------
+extern int UdpStubBatchResult;
+
+#endif /* __TESTS_UDP_STUB_H__ */
@@ -131,9 +131,9 @@ void lwm2m_data_encode_instances
     lwm2m_data_t* dataP
 )
 {
-    (void)subDataP;
-    (void)count;
-    (void)dataP;
+    dataP->type = LWM2M_TYPE_MULTIPLE_RESOURCE;
+    dataP->value.asChildren.count = count;
+    dataP->value.asChildren.array = subDataP;
     return;
 }
 
@@ -268,6 +268,31 @@ int lwm2m_data_decode_int
     const lwm2m_data_t* dataP,
     int64_t* valueP
 )
+{
+    if (LWM2M_TYPE_INTEGER == dataP->type)
+    {
+        *valueP = dataP->value.asInteger;
+        return 1;
+    }
+    return -1;
+}
+
+int lwm2m_data_decode_float
+(
+    const lwm2m_data_t* dataP,
+    double* valueP
+)
+{
+    (void)dataP;
+    (void)valueP;
+    return -1;
+}
+
+int lwm2m_data_decode_bool
+(
+    const lwm2m_data_t* dataP,
+    bool* valueP
+)
 {
     (void)dataP;
     (void)valueP;
@@ -385,6 +410,87 @@ int lwm2m_data_push
     return COAP_NO_ERROR;
 }
 
+lwm2m_transaction_t* transaction_new
+(
+    void* sessionH,
+    coap_method_t method,
+    char* altPath,
+    lwm2m_uri_t* uriP,
+    uint16_t mID,
+    uint8_t token_len,
+    uint8_t* token
+)
+{
+    (void)sessionH;
+    (void)method;
+    (void)altPath;
+    (void)uriP;
+    (void)mID;
+    (void)token_len;
+    (void)token;
+    return NULL;
+}
+
+int transaction_send
+(
+    lwm2m_context_t* contextP,
+    lwm2m_transaction_t* transacP
+)
+{
+    (void)contextP;
+    (void)transacP;
+    return 0;
+}
+
+int coap_set_header_content_type
+(
+    void* packet,
+    unsigned int content_type
+)
+{
+    (void)packet;
+    (void)content_type;
+    return 1;
+}
+
+int coap_set_header_uri_path
+(
+    void* packet,
+    const char* path
+)
+{
+    (void)packet;
+    (void)path;
+    return 0;
+}
+
+int coap_set_header_block1
+(
+    void* packet,
+    uint32_t num,
+    uint8_t more,
+    uint16_t size
+)
+{
+    (void)packet;
+    (void)num;
+    (void)more;
+    (void)size;
+    return 1;
+}
+
+int coap_set_payload
+(
+    void* packet,
+    const void* payload,
+    size_t length
+)
+{
+    (void)packet;
+    (void)payload;
+    return (int)length;
+}
+
 void lwm2m_end_push
 (
     void